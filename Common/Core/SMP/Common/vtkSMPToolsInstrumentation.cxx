@@ -0,0 +1,101 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSMPToolsInstrumentation.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#include "SMP/Common/vtkSMPToolsInstrumentation.h"
+
+#include "vtkAllocationTracker.h"
+#include "vtkPerformanceCounters.h"
+
+#include <string>
+
+namespace vtk
+{
+namespace detail
+{
+namespace smp
+{
+
+// Constant initialized, so that the features enabled from the environment
+// while the other static objects are initialized are not lost.
+std::atomic<int> vtkSMPToolsInstrumentation::Features(0);
+
+struct vtkSMPToolsInstrumentation::vtkInternals
+{
+  // Name of the region counted by vtkPerformanceCounters, or empty.
+  std::string CountersRegion;
+  // Record of vtkAllocationTracker the allocations are attributed to, or nullptr.
+  vtkAllocationTracker::Record* AllocationRecord = nullptr;
+};
+
+struct vtkSMPToolsInstrumentation::Task::vtkInternals
+{
+  explicit vtkInternals(const vtkSMPToolsInstrumentation::vtkInternals& loop)
+    : Counters(loop.CountersRegion.c_str())
+    , Allocations(loop.AllocationRecord)
+  {
+  }
+
+  vtkPerformanceCounters::Scope Counters;
+  vtkAllocationTracker::RecordScope Allocations;
+};
+
+//------------------------------------------------------------------------------
+void vtkSMPToolsInstrumentation::SetFeatureEnabled(Feature feature, bool enabled)
+{
+  if (enabled)
+  {
+    Features.fetch_or(feature);
+  }
+  else
+  {
+    Features.fetch_and(~feature);
+  }
+}
+
+//------------------------------------------------------------------------------
+vtkSMPToolsInstrumentation::vtkSMPToolsInstrumentation()
+  : Internals(new vtkInternals)
+{
+  if (vtkPerformanceCounters::GetEnabled())
+  {
+    std::string current = vtkPerformanceCounters::GetCurrentRegion();
+    this->Internals->CountersRegion =
+      current.empty() ? "vtkSMPTools::For" : "vtkSMPTools::For in " + current;
+  }
+  this->Internals->AllocationRecord = vtkAllocationTracker::GetCurrentRecord();
+}
+
+//------------------------------------------------------------------------------
+vtkSMPToolsInstrumentation::~vtkSMPToolsInstrumentation()
+{
+  delete this->Internals;
+}
+
+//------------------------------------------------------------------------------
+vtkSMPToolsInstrumentation::Task::vtkInternals* vtkSMPToolsInstrumentation::Task::Begin(
+  const vtkSMPToolsInstrumentation& loop)
+{
+  return new vtkInternals(*loop.Internals);
+}
+
+//------------------------------------------------------------------------------
+void vtkSMPToolsInstrumentation::Task::End(vtkInternals* internals)
+{
+  delete internals;
+}
+
+} // namespace smp
+} // namespace detail
+} // namespace vtk
@@ -0,0 +1,117 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSMPToolsInstrumentation.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkSMPToolsInstrumentation
+ * @brief   instrumentation of the vtkSMPTools::For loops
+ *
+ * vtkSMPToolsInstrumentation lets the backends count the work of the threads
+ * of a vtkSMPTools::For() loop with vtkPerformanceCounters, and attribute
+ * their allocations to the vtkAllocationTracker scope of the thread calling
+ * vtkSMPTools::For(). When nothing is enabled, the only cost for a loop is
+ * the test of a global flag.
+ *
+ * A backend calls Capture() on the thread calling vtkSMPTools::For(), which
+ * returns nullptr when nothing is enabled, and opens a Task on each thread
+ * around all of the chunks of the loop that the thread executes.
+ *
+ * @sa
+ * vtkSMPTools vtkPerformanceCounters vtkAllocationTracker
+ */
+
+#ifndef vtkSMPToolsInstrumentation_h
+#define vtkSMPToolsInstrumentation_h
+
+#include "vtkCommonCoreModule.h" // For export macro
+
+#include <atomic> // For std::atomic
+#include <memory> // For std::unique_ptr
+
+namespace vtk
+{
+namespace detail
+{
+namespace smp
+{
+
+class VTKCOMMONCORE_EXPORT vtkSMPToolsInstrumentation
+{
+public:
+  // The features that instrument the loops.
+  enum Feature
+  {
+    PERFORMANCE_COUNTERS = 1,
+    ALLOCATION_TRACKING = 2
+  };
+
+  // Enable or disable a feature. Called by the classes providing them.
+  static void SetFeatureEnabled(Feature feature, bool enabled);
+
+  // Whether any feature is enabled.
+  static bool IsEnabled() { return Features.load(std::memory_order_relaxed) != 0; }
+
+  // The state of the calling thread that the tasks of a loop it starts take
+  // on, or nullptr when no feature is enabled.
+  static std::unique_ptr<vtkSMPToolsInstrumentation> Capture()
+  {
+    return std::unique_ptr<vtkSMPToolsInstrumentation>(
+      IsEnabled() ? new vtkSMPToolsInstrumentation : nullptr);
+  }
+
+  ~vtkSMPToolsInstrumentation();
+
+  // Instruments the work of the calling thread for a loop, from its
+  // construction to its destruction. Does nothing for a null loop.
+  class VTKCOMMONCORE_EXPORT Task
+  {
+  public:
+    explicit Task(const vtkSMPToolsInstrumentation* loop)
+      : Internals(loop ? Task::Begin(*loop) : nullptr)
+    {
+    }
+    ~Task()
+    {
+      if (this->Internals)
+      {
+        Task::End(this->Internals);
+      }
+    }
+
+  private:
+    Task(const Task&) = delete;
+    void operator=(const Task&) = delete;
+
+    struct vtkInternals;
+    static vtkInternals* Begin(const vtkSMPToolsInstrumentation& loop);
+    static void End(vtkInternals* internals);
+
+    vtkInternals* Internals;
+  };
+
+private:
+  vtkSMPToolsInstrumentation();
+  vtkSMPToolsInstrumentation(const vtkSMPToolsInstrumentation&) = delete;
+  void operator=(const vtkSMPToolsInstrumentation&) = delete;
+
+  static std::atomic<int> Features;
+
+  struct vtkInternals;
+  vtkInternals* Internals;
+};
+
+} // namespace smp
+} // namespace detail
+} // namespace vtk
+
+#endif
@@ -69,7 +69,8 @@ int vtkSMPToolsImpl<BackendType::OpenMP>::GetEstimatedNumberOfThreads()
 
 //------------------------------------------------------------------------------
 void vtkSMPToolsImplForOpenMP(vtkIdType first, vtkIdType last, vtkIdType grain,
-  ExecuteFunctorPtrType functorExecuter, void* functor, bool nestedActivated)
+  ExecuteFunctorPtrType functorExecuter, void* functor, bool nestedActivated,
+  const vtkSMPToolsInstrumentation* instrumentation)
 {
   if (grain <= 0)
   {
@@ -79,10 +80,15 @@ void vtkSMPToolsImplForOpenMP(vtkIdType first, vtkIdType last, vtkIdType grain,
 
   omp_set_nested(nestedActivated);
 
-#pragma omp parallel for schedule(runtime)
-  for (vtkIdType from = first; from < last; from += grain)
+#pragma omp parallel
   {
-    functorExecuter(functor, from, grain, last);
+    // the chunks that a thread executes make up a single task
+    vtkSMPToolsInstrumentation::Task task(instrumentation);
+#pragma omp for schedule(runtime)
+    for (vtkIdType from = first; from < last; from += grain)
+    {
+      functorExecuter(functor, from, grain, last);
+    }
   }
 }
 
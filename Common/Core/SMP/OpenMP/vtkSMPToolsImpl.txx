@@ -19,8 +19,9 @@
 #include <algorithm> // For std::sort
 
 #include "SMP/Common/vtkSMPToolsImpl.h"
-#include "SMP/Common/vtkSMPToolsInternal.h" // For common vtk smp class
-#include "vtkCommonCoreModule.h"            // For export macro
+#include "SMP/Common/vtkSMPToolsInstrumentation.h" // For vtkSMPToolsInstrumentation
+#include "SMP/Common/vtkSMPToolsInternal.h"        // For common vtk smp class
+#include "vtkCommonCoreModule.h"                   // For export macro
 
 namespace vtk
 {
@@ -31,7 +32,8 @@ namespace smp
 
 int VTKCOMMONCORE_EXPORT GetNumberOfThreadsOpenMP();
 void VTKCOMMONCORE_EXPORT vtkSMPToolsImplForOpenMP(vtkIdType first, vtkIdType last, vtkIdType grain,
-  ExecuteFunctorPtrType functorExecuter, void* functor, bool nestedActivated);
+  ExecuteFunctorPtrType functorExecuter, void* functor, bool nestedActivated,
+  const vtkSMPToolsInstrumentation* instrumentation);
 
 //--------------------------------------------------------------------------------
 template <typename FunctorInternal>
@@ -55,8 +57,10 @@ void vtkSMPToolsImpl<BackendType::OpenMP>::For(
     return;
   }
 
+  auto instrumentation = vtkSMPToolsInstrumentation::Capture();
   if (grain >= n)
   {
+    vtkSMPToolsInstrumentation::Task task(instrumentation.get());
     fi.Execute(first, last);
   }
   else
@@ -68,8 +72,8 @@ void vtkSMPToolsImpl<BackendType::OpenMP>::For(
     bool fromParallelCode = this->IsParallel;
     this->IsParallel = true;
 
-    vtkSMPToolsImplForOpenMP(
-      first, last, grain, ExecuteFunctorOpenMP<FunctorInternal>, &fi, this->NestedActivated);
+    vtkSMPToolsImplForOpenMP(first, last, grain, ExecuteFunctorOpenMP<FunctorInternal>, &fi,
+      this->NestedActivated, instrumentation.get());
 
     this->IsParallel &= fromParallelCode;
   }
@@ -15,7 +15,24 @@
 
 #include "SMP/STDThread/vtkSMPThreadPool.h"
 
+#include "SMP/Common/vtkSMPToolsInstrumentation.h"
+
+#include <algorithm>
 #include <iostream>
+#include <memory>
+
+namespace
+{
+// The part of the iterations of a For() left to one thread. The owner takes
+// chunks from the front, other threads steal from the back. Aligned to keep
+// the parts of different threads on different cache lines.
+struct alignas(64) WorkRange
+{
+  std::mutex Mutex;
+  vtkIdType Begin = 0;
+  vtkIdType End = 0;
+};
+}
 
 vtk::detail::smp::vtkSMPThreadPool::vtkSMPThreadPool(int threadNumber)
 {
@@ -72,3 +89,99 @@ void vtk::detail::smp::vtkSMPThreadPool::ThreadJob()
     job();
   }
 }
+
+void vtk::detail::smp::vtkSMPThreadPool::For(int threadNumber, vtkIdType first, vtkIdType last,
+  vtkIdType grain, const std::function<void(vtkIdType, vtkIdType)>& function,
+  const vtkSMPToolsInstrumentation* instrumentation)
+{
+  const vtkIdType n = last - first;
+  if (n <= 0)
+  {
+    return;
+  }
+  threadNumber = static_cast<int>(std::max<vtkIdType>(1, std::min<vtkIdType>(threadNumber, n)));
+
+  // Without a grain, chunks are a fraction of what is left to the thread,
+  // down to a size keeping the scheduling overhead negligible.
+  const bool adaptive = grain <= 0;
+  const vtkIdType minChunk = adaptive ? std::max<vtkIdType>(1, n / (threadNumber * 256)) : grain;
+
+  std::unique_ptr<WorkRange[]> ranges(new WorkRange[threadNumber]);
+  for (int i = 0; i < threadNumber; ++i)
+  {
+    ranges[i].Begin = first + n * i / threadNumber;
+    ranges[i].End = first + n * (i + 1) / threadNumber;
+  }
+
+  auto worker = [&](int self) {
+    vtkSMPToolsInstrumentation::Task task(instrumentation);
+    WorkRange& own = ranges[self];
+    while (true)
+    {
+      vtkIdType begin = 0;
+      vtkIdType end = 0;
+      {
+        std::lock_guard<std::mutex> lock(own.Mutex);
+        if (own.Begin < own.End)
+        {
+          const vtkIdType left = own.End - own.Begin;
+          const vtkIdType chunk =
+            adaptive ? std::max(minChunk, left / (2 * threadNumber)) : std::min(grain, left);
+          begin = own.Begin;
+          end = std::min(begin + chunk, own.End);
+          own.Begin = end;
+        }
+      }
+      if (begin < end)
+      {
+        function(begin, end);
+        continue;
+      }
+
+      // Out of work: steal from the thread with the most iterations left,
+      // half of them if that is more than a chunk, all of them otherwise.
+      // Work in the hands of a thread is not visible, so a thread may stop
+      // while another one is still busy, but no iteration is ever lost.
+      int victim = -1;
+      vtkIdType mostLeft = 0;
+      for (int i = 0; i < threadNumber; ++i)
+      {
+        if (i != self)
+        {
+          std::lock_guard<std::mutex> lock(ranges[i].Mutex);
+          if (ranges[i].End - ranges[i].Begin > mostLeft)
+          {
+            mostLeft = ranges[i].End - ranges[i].Begin;
+            victim = i;
+          }
+        }
+      }
+      if (victim < 0)
+      {
+        return;
+      }
+      {
+        std::lock_guard<std::mutex> lock(ranges[victim].Mutex);
+        const vtkIdType left = ranges[victim].End - ranges[victim].Begin;
+        if (left <= 0)
+        {
+          continue;
+        }
+        end = ranges[victim].End;
+        begin = left > minChunk ? end - left / 2 : ranges[victim].Begin;
+        ranges[victim].End = begin;
+      }
+      std::lock_guard<std::mutex> lock(own.Mutex);
+      own.Begin = begin;
+      own.End = end;
+    }
+  };
+
+  vtkSMPThreadPool pool(threadNumber - 1);
+  for (int i = 1; i < threadNumber; ++i)
+  {
+    pool.DoJob(std::bind(worker, i));
+  }
+  worker(0);
+  pool.Join();
+}
@@ -20,6 +20,13 @@
 // The DoJob() method is used attributes the job to a free thread, if all
 // threads are working, the job is kept in a queue. Note that vtkSMPThreadPool
 // destructor joins threads and finish the jobs in the queue.
+//
+// The static For() method runs a range of iterations on a pool with a work
+// stealing scheduler: the range is first split evenly between the threads,
+// each thread takes chunks from the front of its own part and, once done,
+// steals the back half of the largest part left to another thread. This
+// keeps all threads busy until the end when the cost of the iterations
+// varies.
 
 #ifndef vtkSMPThreadPool_h
 #define vtkSMPThreadPool_h
@@ -40,6 +47,8 @@ namespace detail
 namespace smp
 {
 
+class vtkSMPToolsInstrumentation;
+
 class VTKCOMMONCORE_EXPORT vtkSMPThreadPool
 {
 public:
@@ -48,6 +57,15 @@ public:
   void Join();
   void DoJob(std::function<void(void)> job);
 
+  // Call function(begin, end) over [first, last) on threadNumber threads,
+  // including the calling one, and return once all iterations are done.
+  // Chunks hold at most grain iterations; when grain is not positive, their
+  // size adapts to the iterations left, shrinking towards the end. The work
+  // of each thread is a task of the instrumentation, if any.
+  static void For(int threadNumber, vtkIdType first, vtkIdType last, vtkIdType grain,
+    const std::function<void(vtkIdType, vtkIdType)>& function,
+    const vtkSMPToolsInstrumentation* instrumentation = nullptr);
+
 private:
   void ThreadJob();
 
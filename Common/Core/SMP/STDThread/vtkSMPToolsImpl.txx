@@ -16,13 +16,13 @@
 #ifndef STDThreadvtkSMPToolsImpl_txx
 #define STDThreadvtkSMPToolsImpl_txx
 
-#include <algorithm>  // For std::sort
-#include <functional> // For std::bind
+#include <algorithm> // For std::sort
 
 #include "SMP/Common/vtkSMPToolsImpl.h"
-#include "SMP/Common/vtkSMPToolsInternal.h" // For common vtk smp class
-#include "SMP/STDThread/vtkSMPThreadPool.h" // For vtkSMPThreadPool
-#include "vtkCommonCoreModule.h"            // For export macro
+#include "SMP/Common/vtkSMPToolsInstrumentation.h" // For vtkSMPToolsInstrumentation
+#include "SMP/Common/vtkSMPToolsInternal.h"        // For common vtk smp class
+#include "SMP/STDThread/vtkSMPThreadPool.h"        // For vtkSMPThreadPool
+#include "vtkCommonCoreModule.h"                   // For export macro
 
 namespace vtk
 {
@@ -33,16 +33,6 @@ namespace smp
 
 int VTKCOMMONCORE_EXPORT GetNumberOfThreadsSTDThread();
 
-//--------------------------------------------------------------------------------
-template <typename FunctorInternal>
-void ExecuteFunctorSTDThread(void* functor, vtkIdType from, vtkIdType grain, vtkIdType last)
-{
-  const vtkIdType to = std::min(from + grain, last);
-
-  FunctorInternal& fi = *reinterpret_cast<FunctorInternal*>(functor);
-  fi.Execute(from, to);
-}
-
 //--------------------------------------------------------------------------------
 template <>
 template <typename FunctorInternal>
@@ -55,20 +45,16 @@ void vtkSMPToolsImpl<BackendType::STDThread>::For(
     return;
   }
 
+  auto instrumentation = vtkSMPToolsInstrumentation::Capture();
   if (grain >= n || (this->IsParallel && !this->NestedActivated))
   {
+    vtkSMPToolsInstrumentation::Task task(instrumentation.get());
     fi.Execute(first, last);
   }
   else
   {
     int threadNumber = GetNumberOfThreadsSTDThread();
 
-    if (grain <= 0)
-    {
-      vtkIdType estimateGrain = (last - first) / (threadNumber * 4);
-      grain = (estimateGrain > 0) ? estimateGrain : 1;
-    }
-
     // this->IsParallel may have threads conficts but it will be always between true and true,
     // it is set to false only in sequential code.
     // /!\ This behaviour should be changed if we want more control on nested
@@ -76,13 +62,8 @@ void vtkSMPToolsImpl<BackendType::STDThread>::For(
     bool fromParallelCode = this->IsParallel;
     this->IsParallel = true;
 
-    vtkSMPThreadPool pool(threadNumber);
-    for (vtkIdType from = first; from < last; from += grain)
-    {
-      auto job = std::bind(ExecuteFunctorSTDThread<FunctorInternal>, &fi, from, grain, last);
-      pool.DoJob(job);
-    }
-    pool.Join();
+    auto execute = [&fi](vtkIdType from, vtkIdType to) { fi.Execute(from, to); };
+    vtkSMPThreadPool::For(threadNumber, first, last, grain, execute, instrumentation.get());
 
     this->IsParallel &= fromParallelCode;
   }
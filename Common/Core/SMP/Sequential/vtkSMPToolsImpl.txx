@@ -19,7 +19,8 @@
 #include <algorithm> // For std::sort, std::transform, std::fill
 
 #include "SMP/Common/vtkSMPToolsImpl.h"
-#include "SMP/Common/vtkSMPToolsInternal.h" // For common vtk smp class
+#include "SMP/Common/vtkSMPToolsInstrumentation.h" // For vtkSMPToolsInstrumentation
+#include "SMP/Common/vtkSMPToolsInternal.h"        // For common vtk smp class
 
 namespace vtk
 {
@@ -40,6 +41,10 @@ void vtkSMPToolsImpl<BackendType::Sequential>::For(
     return;
   }
 
+  // the whole loop is a single task of the calling thread
+  auto instrumentation = vtkSMPToolsInstrumentation::Capture();
+  vtkSMPToolsInstrumentation::Task task(instrumentation.get());
+
   if (grain == 0 || grain >= n)
   {
     fi.Execute(first, last);
@@ -17,8 +17,9 @@
 #define TBBvtkSMPToolsImpl_txx
 
 #include "SMP/Common/vtkSMPToolsImpl.h"
-#include "SMP/Common/vtkSMPToolsInternal.h" // For common vtk smp class
-#include "vtkCommonCoreModule.h"            // For export macro
+#include "SMP/Common/vtkSMPToolsInstrumentation.h" // For vtkSMPToolsInstrumentation
+#include "SMP/Common/vtkSMPToolsInternal.h"        // For common vtk smp class
+#include "vtkCommonCoreModule.h"                   // For export macro
 
 #ifdef _MSC_VER
 #pragma push_macro("__TBB_NO_IMPLICIT_LINKAGE")
@@ -44,18 +45,26 @@ void VTKCOMMONCORE_EXPORT vtkSMPToolsImplForTBB(vtkIdType first, vtkIdType last,
   ExecuteFunctorPtrType functorExecuter, void* functor);
 
 //--------------------------------------------------------------------------------
+// TBB has no notion of the work of a thread for a loop, so each range is a
+// task of the instrumentation, if any.
 template <typename T>
 class FuncCall
 {
   T& o;
+  const vtkSMPToolsInstrumentation* Instrumentation;
 
   void operator=(const FuncCall&) = delete;
 
 public:
-  void operator()(const tbb::blocked_range<vtkIdType>& r) const { o.Execute(r.begin(), r.end()); }
+  void operator()(const tbb::blocked_range<vtkIdType>& r) const
+  {
+    vtkSMPToolsInstrumentation::Task task(this->Instrumentation);
+    o.Execute(r.begin(), r.end());
+  }
 
-  FuncCall(T& _o)
+  FuncCall(T& _o, const vtkSMPToolsInstrumentation* instrumentation)
     : o(_o)
+    , Instrumentation(instrumentation)
   {
   }
 };
@@ -64,7 +73,7 @@ public:
 template <typename FunctorInternal>
 void ExecuteFunctorTBB(void* functor, vtkIdType first, vtkIdType last, vtkIdType grain)
 {
-  FunctorInternal& fi = *reinterpret_cast<FunctorInternal*>(functor);
+  const FuncCall<FunctorInternal>& call = *reinterpret_cast<FuncCall<FunctorInternal>*>(functor);
 
   vtkIdType range = last - first;
   if (range <= 0)
@@ -73,8 +82,7 @@ void ExecuteFunctorTBB(void* functor, vtkIdType first, vtkIdType last, vtkIdType
   }
   if (grain > 0)
   {
-    tbb::parallel_for(
-      tbb::blocked_range<vtkIdType>(first, last, grain), FuncCall<FunctorInternal>(fi));
+    tbb::parallel_for(tbb::blocked_range<vtkIdType>(first, last, grain), call);
   }
   else
   {
@@ -91,14 +99,13 @@ void ExecuteFunctorTBB(void* functor, vtkIdType first, vtkIdType last, vtkIdType
     {
       // std::ceil round up for systems without cmath
       vtkIdType calculatedGrain = ((range - 1) / batches) + 1;
-      tbb::parallel_for(
-        tbb::blocked_range<vtkIdType>(first, last, calculatedGrain), FuncCall<FunctorInternal>(fi));
+      tbb::parallel_for(tbb::blocked_range<vtkIdType>(first, last, calculatedGrain), call);
     }
     else
     {
       // Data is too small to generate a reasonable grain. Fallback to default so data still runs
       // on as many threads as possible (Jan 2020: Default is one index per tbb task).
-      tbb::parallel_for(tbb::blocked_range<vtkIdType>(first, last), FuncCall<FunctorInternal>(fi));
+      tbb::parallel_for(tbb::blocked_range<vtkIdType>(first, last), call);
     }
   }
 }
@@ -109,8 +116,10 @@ template <typename FunctorInternal>
 void vtkSMPToolsImpl<BackendType::TBB>::For(
   vtkIdType first, vtkIdType last, vtkIdType grain, FunctorInternal& fi)
 {
+  auto instrumentation = vtkSMPToolsInstrumentation::Capture();
   if (this->IsParallel && !this->NestedActivated)
   {
+    vtkSMPToolsInstrumentation::Task task(instrumentation.get());
     fi.Execute(first, last);
   }
   else
@@ -121,7 +130,8 @@ void vtkSMPToolsImpl<BackendType::TBB>::For(
     // (e.g only the 2 first nested For are in parallel)
     bool fromParallelCode = this->IsParallel;
     this->IsParallel = true;
-    vtkSMPToolsImplForTBB(first, last, grain, ExecuteFunctorTBB<FunctorInternal>, &fi);
+    FuncCall<FunctorInternal> call(fi, instrumentation.get());
+    vtkSMPToolsImplForTBB(first, last, grain, ExecuteFunctorTBB<FunctorInternal>, &call);
     this->IsParallel &= fromParallelCode;
   }
 }
@@ -0,0 +1,154 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestInformationEntries.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Sets, removes, iterates over and copies many entries of a vtkInformation,
+// so that its table grows and holds removed entries, and checks that every
+// entry is found with the right value.
+
+#include "vtkInformation.h"
+#include "vtkInformationIntegerKey.h"
+#include "vtkInformationIterator.h"
+#include "vtkNew.h"
+
+#include <string>
+#include <vector>
+
+namespace
+{
+bool CheckEntries(vtkInformation* info, const std::vector<vtkInformationIntegerKey*>& keys,
+  const std::vector<bool>& present, int offset)
+{
+  int numberOfKeys = 0;
+  for (size_t i = 0; i < keys.size(); ++i)
+  {
+    if (keys[i]->Has(info) != present[i])
+    {
+      cerr << "Key " << i << (present[i] ? " missing\n" : " not removed\n");
+      return false;
+    }
+    if (present[i])
+    {
+      ++numberOfKeys;
+      if (keys[i]->Get(info) != static_cast<int>(i) + offset)
+      {
+        cerr << "Key " << i << " has value " << keys[i]->Get(info) << "\n";
+        return false;
+      }
+    }
+  }
+  if (info->GetNumberOfKeys() != numberOfKeys)
+  {
+    cerr << info->GetNumberOfKeys() << " keys instead of " << numberOfKeys << "\n";
+    return false;
+  }
+
+  vtkNew<vtkInformationIterator> iterator;
+  iterator->SetInformationWeak(info);
+  int iterated = 0;
+  for (iterator->InitTraversal(); !iterator->IsDoneWithTraversal(); iterator->GoToNextItem())
+  {
+    ++iterated;
+  }
+  if (iterated != numberOfKeys)
+  {
+    cerr << "Iterated over " << iterated << " keys instead of " << numberOfKeys << "\n";
+    return false;
+  }
+  return true;
+}
+}
+
+int TestInformationEntries(int, char*[])
+{
+  const int count = 200;
+  std::vector<vtkInformationIntegerKey*> keys;
+  for (int i = 0; i < count; ++i)
+  {
+    keys.push_back(
+      vtkInformationIntegerKey::MakeKey(("KEY_" + std::to_string(i)).c_str(), "TestEntries"));
+  }
+  std::vector<bool> present(count, false);
+
+  vtkNew<vtkInformation> info;
+  if (!CheckEntries(info, keys, present, 0))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // Fill, then remove every other key and set some again, several times so
+  // that removed entries are reused and the table is rebuilt.
+  for (int round = 0; round < 4; ++round)
+  {
+    for (int i = 0; i < count; ++i)
+    {
+      keys[i]->Set(info, i);
+      present[i] = true;
+    }
+    for (int i = round % 2; i < count; i += 2)
+    {
+      keys[i]->Set(info, -1);
+      info->Remove(keys[i]);
+      info->Remove(keys[i]);
+      present[i] = false;
+    }
+    for (int i = 0; i < count; i += 7)
+    {
+      keys[i]->Set(info, i);
+      present[i] = true;
+    }
+    if (!CheckEntries(info, keys, present, 0))
+    {
+      cerr << "In round " << round << "\n";
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Removing a missing key does not modify the information.
+  vtkMTimeType mtime = info->GetMTime();
+  info->Remove(keys[1]);
+  if (info->GetMTime() != mtime)
+  {
+    cerr << "Removing a missing key modified the information\n";
+    return EXIT_FAILURE;
+  }
+
+  vtkNew<vtkInformation> copy;
+  copy->Copy(info);
+  if (!CheckEntries(copy, keys, present, 0))
+  {
+    cerr << "In the copy\n";
+    return EXIT_FAILURE;
+  }
+
+  for (int i = 0; i < count; ++i)
+  {
+    keys[i]->Set(copy, i + 1);
+    present[i] = true;
+  }
+  info->Append(copy);
+  if (!CheckEntries(info, keys, present, 1))
+  {
+    cerr << "After appending\n";
+    return EXIT_FAILURE;
+  }
+
+  info->Clear();
+  present.assign(count, false);
+  if (!CheckEntries(info, keys, present, 0))
+  {
+    cerr << "After clearing\n";
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,134 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestLookupTableMapScalars.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Maps arrays that are large enough to be split into chunks through
+// vtkLookupTable, with linear, log and indexed lookup, and checks every
+// color against MapValue.
+
+#include "vtkLookupTable.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkSMPTools.h"
+#include "vtkVariant.h"
+
+#include <vector>
+
+namespace
+{
+const int NumberOfValues = 100000;
+
+template <class T>
+bool CheckMapping(vtkLookupTable* lut, int dataType, const char* name)
+{
+  std::vector<T> values(NumberOfValues);
+  unsigned int state = 13579;
+  for (int i = 0; i < NumberOfValues; ++i)
+  {
+    state = state * 1103515245u + 12345u;
+    values[i] = static_cast<T>(static_cast<int>((state >> 8) % 3000) - 1000);
+  }
+  if (dataType == VTK_FLOAT || dataType == VTK_DOUBLE)
+  {
+    values[7] = static_cast<T>(vtkMath::Nan());
+    values[11] = static_cast<T>(0.25);
+  }
+
+  for (int format = VTK_LUMINANCE; format <= VTK_RGBA; ++format)
+  {
+    std::vector<unsigned char> colors(format * NumberOfValues);
+    lut->MapScalarsThroughTable2(
+      values.data(), colors.data(), dataType, NumberOfValues, 1, format);
+    std::vector<unsigned char> strided(format * NumberOfValues / 2);
+    lut->MapScalarsThroughTable2(
+      values.data(), strided.data(), dataType, NumberOfValues / 2, 2, format);
+
+    for (int i = 0; i < NumberOfValues; ++i)
+    {
+      const unsigned char* rgba = lut->MapValue(static_cast<double>(values[i]));
+      unsigned char expected[4] = { rgba[0], rgba[1], rgba[2], rgba[3] };
+      if (format <= VTK_LUMINANCE_ALPHA)
+      {
+        expected[0] = static_cast<unsigned char>(
+          rgba[0] * 0.30 + rgba[1] * 0.59 + rgba[2] * 0.11 + 0.5);
+        expected[1] = rgba[3];
+      }
+      for (int c = 0; c < format; ++c)
+      {
+        if (colors[format * i + c] != expected[c] ||
+          (i % 2 == 0 && strided[format * (i / 2) + c] != expected[c]))
+        {
+          cerr << name << " format " << format << ": value " << values[i] << " component " << c
+               << " is " << static_cast<int>(colors[format * i + c]) << " instead of "
+               << static_cast<int>(expected[c]) << "\n";
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+bool CheckTypes(vtkLookupTable* lut, const char* name)
+{
+  return CheckMapping<short>(lut, VTK_SHORT, name) &&
+    CheckMapping<unsigned short>(lut, VTK_UNSIGNED_SHORT, name) &&
+    CheckMapping<signed char>(lut, VTK_SIGNED_CHAR, name) &&
+    CheckMapping<int>(lut, VTK_INT, name) && CheckMapping<float>(lut, VTK_FLOAT, name) &&
+    CheckMapping<double>(lut, VTK_DOUBLE, name);
+}
+}
+
+int TestLookupTableMapScalars(int, char*[])
+{
+  vtkSMPTools::Initialize(4);
+
+  vtkNew<vtkLookupTable> lut;
+  lut->SetNumberOfTableValues(200);
+  lut->SetHueRange(0.0, 0.8);
+  lut->SetAlphaRange(0.3, 1.0);
+  lut->SetRange(-200.0, 1500.0);
+  lut->SetBelowRangeColor(0.1, 0.2, 0.3, 0.4);
+  lut->UseBelowRangeColorOn();
+  lut->SetNanColor(0.9, 0.8, 0.7, 0.6);
+  lut->Build();
+  if (!CheckTypes(lut, "Linear"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  lut->SetRange(1.0, 1000.0);
+  lut->SetScaleToLog10();
+  lut->UseBelowRangeColorOff();
+  lut->SetAboveRangeColor(1.0, 1.0, 0.0, 1.0);
+  lut->UseAboveRangeColorOn();
+  lut->Build();
+  if (!CheckTypes(lut, "Log"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  lut->SetScaleToLinear();
+  lut->IndexedLookupOn();
+  for (int i = 0; i < 50; ++i)
+  {
+    lut->SetAnnotation(vtkVariant(-1000 + 37 * i), vtkVariant(i).ToString());
+  }
+  lut->Build();
+  if (!CheckTypes(lut, "Indexed"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,117 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestPerformanceCounters.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Counts a vtkLogger scope and a vtkSMPTools::For within it with
+// vtkPerformanceCounters, or checks that nothing is counted when the
+// counters are not available.
+
+#include "vtkLogger.h"
+#include "vtkPerformanceCounters.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+
+#include <cmath>
+#include <string>
+
+namespace
+{
+void LogHandler(void* userData, const vtkLogger::Message& message)
+{
+  auto lines = reinterpret_cast<std::string*>(userData);
+  (*lines) += message.message;
+  (*lines) += "\n";
+}
+
+double Work()
+{
+  vtkSMPThreadLocal<double> sums(0.0);
+  vtkSMPTools::For(0, 1000000, [&](vtkIdType begin, vtkIdType end) {
+    double& sum = sums.Local();
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      sum += std::sqrt(static_cast<double>(i));
+    }
+  });
+  double total = 0;
+  for (double sum : sums)
+  {
+    total += sum;
+  }
+  return total;
+}
+}
+
+int TestPerformanceCounters(int, char*[])
+{
+  vtkPerformanceCounters::SetEnabled(true);
+  vtkPerformanceCounters::ClearSummary();
+
+  if (!vtkPerformanceCounters::IsAvailable())
+  {
+    cout << "Performance counters are not available, checking that they are a no-op.\n";
+    if (vtkPerformanceCounters::GetEnabled())
+    {
+      cerr << "Counters enabled although not available\n";
+      return EXIT_FAILURE;
+    }
+    {
+      vtkLogScopeF(INFO, "not counted");
+      vtkPerformanceCounters::Scope scope("not counted either");
+      Work();
+    }
+    std::string summary = vtkPerformanceCounters::GetSummary();
+    if (summary.find("\"available\": false") == std::string::npos ||
+      summary.find("counted") != std::string::npos)
+    {
+      cerr << "Unexpected summary:\n" << summary;
+      return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+  }
+
+  std::string lines;
+  vtkLogger::AddCallback("counters-grabber", LogHandler, &lines, vtkLogger::VERBOSITY_INFO);
+  vtkPerformanceCounters::Sample start, end;
+  vtkPerformanceCounters::Read(start);
+  {
+    vtkLogScopeF(INFO, "counted scope");
+    Work();
+  }
+  vtkPerformanceCounters::Read(end);
+  vtkLogger::RemoveCallback("counters-grabber");
+  vtkPerformanceCounters::LogSummary();
+  std::string summary = vtkPerformanceCounters::GetSummary();
+  cout << summary;
+  vtkPerformanceCounters::SetEnabled(false);
+  vtkPerformanceCounters::ClearSummary();
+
+  if (end.Values[vtkPerformanceCounters::CYCLES] <= start.Values[vtkPerformanceCounters::CYCLES])
+  {
+    cerr << "Cycles were not counted\n";
+    return EXIT_FAILURE;
+  }
+  if (lines.find("counters: ") == std::string::npos)
+  {
+    cerr << "Counts not logged in the scope:\n" << lines;
+    return EXIT_FAILURE;
+  }
+  if (summary.find("\"name\": \"counted scope\"") == std::string::npos ||
+    summary.find("\"name\": \"vtkSMPTools::For in counted scope\"") == std::string::npos ||
+    summary.find("\"cycles\"") == std::string::npos)
+  {
+    cerr << "Regions missing from the summary\n";
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
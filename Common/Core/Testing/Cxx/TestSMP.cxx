@@ -19,6 +19,7 @@
 #include "vtkSMPThreadLocal.h"
 #include "vtkSMPThreadLocalObject.h"
 #include "vtkSMPTools.h"
+#include <atomic>
 #include <cstdlib>
 #include <deque>
 #include <functional>
@@ -237,6 +238,44 @@ int doTestSMP()
     }
   }
 
+  // Test that an imbalanced workload runs every iteration exactly once, in
+  // chunks no larger than the grain when one is given
+  for (const vtkIdType grain : { 0, 1, 7 })
+  {
+    const vtkIdType size = 10007;
+    std::vector<std::atomic<int>> visits(size);
+    std::atomic<bool> oversized(false);
+    vtkSMPTools::For(0, size, grain, [&](vtkIdType start, vtkIdType end) {
+      if (grain > 0 && end - start > grain)
+      {
+        oversized = true;
+      }
+      for (vtkIdType i = start; i < end; ++i)
+      {
+        volatile double work = 0;
+        for (int k = 0; k < (i < size / 16 ? 1000 : 1); ++k)
+        {
+          work = work + k;
+        }
+        ++visits[i];
+      }
+    });
+    for (vtkIdType i = 0; i < size; ++i)
+    {
+      if (visits[i] != 1)
+      {
+        cerr << "Error: iteration " << i << " ran " << visits[i] << " times with grain " << grain
+             << endl;
+        return EXIT_FAILURE;
+      }
+    }
+    if (oversized)
+    {
+      cerr << "Error: chunk larger than the grain " << grain << endl;
+      return EXIT_FAILURE;
+    }
+  }
+
   // Test nested parallelism
   for (const bool enabled : { true, false })
   {
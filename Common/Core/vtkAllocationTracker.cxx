@@ -0,0 +1,380 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkAllocationTracker.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkAllocationTracker.h"
+
+#include "SMP/Common/vtkSMPToolsInstrumentation.h"
+#include "vtkBuffer.h"
+#include "vtkObjectFactory.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <map>
+#include <mutex>
+#include <sstream>
+
+vtkStandardNewMacro(vtkAllocationTracker);
+
+struct vtkAllocationTracker::Record
+{
+  std::string Name;
+  // The enclosing record, which also counts the allocations of this one.
+  Record* Parent = nullptr;
+  std::atomic<vtkTypeInt64> AllocatedBytes{ 0 };
+  std::atomic<vtkTypeInt64> FreedBytes{ 0 };
+  std::atomic<vtkTypeInt64> HeldBytes{ 0 };
+  std::atomic<vtkTypeInt64> PeakBytes{ 0 };
+  std::atomic<vtkTypeInt64> ProcessPeakBytes{ 0 };
+  std::atomic<vtkTypeInt64> Allocations{ 0 };
+  std::atomic<vtkTypeInt64> Objects{ 0 };
+};
+
+namespace
+{
+// Initialized before Enabled, as a constant.
+std::atomic<int> LogVerbosity(vtkLogger::VERBOSITY_TRACE);
+
+bool InitializeFromEnvironment()
+{
+  const char* value = std::getenv("VTK_ALLOCATION_TRACKING");
+  if (!value)
+  {
+    return false;
+  }
+  vtkLogger::Verbosity verbosity = vtkLogger::ConvertToVerbosity(value);
+  if (verbosity != vtkLogger::VERBOSITY_INVALID)
+  {
+    LogVerbosity = verbosity;
+  }
+  vtk::detail::smp::vtkSMPToolsInstrumentation::SetFeatureEnabled(
+    vtk::detail::smp::vtkSMPToolsInstrumentation::ALLOCATION_TRACKING, true);
+  return true;
+}
+
+std::atomic<bool> Enabled(InitializeFromEnvironment());
+std::atomic<vtkTypeInt64> CurrentBytes(0);
+std::atomic<vtkTypeInt64> PeakBytes(0);
+
+thread_local vtkAllocationTracker::Record* CurrentRecord = nullptr;
+
+void UpdateMaximum(std::atomic<vtkTypeInt64>& maximum, vtkTypeInt64 value)
+{
+  vtkTypeInt64 previous = maximum.load(std::memory_order_relaxed);
+  while (previous < value &&
+    !maximum.compare_exchange_weak(previous, value, std::memory_order_relaxed))
+  {
+  }
+}
+
+struct Aggregate
+{
+  vtkIdType Executions = 0;
+  vtkAllocationTracker::Statistics Totals;
+};
+
+// Aggregates per scope name, never destroyed so that scopes ending after
+// the end of main() can still use them.
+struct Global
+{
+  std::mutex Mutex;
+  std::map<std::string, Aggregate> Scopes;
+
+  static Global& Get()
+  {
+    static Global* global = new Global;
+    return *global;
+  }
+};
+
+vtkAllocationTracker::Statistics GetRecordStatistics(const vtkAllocationTracker::Record* record)
+{
+  vtkAllocationTracker::Statistics statistics;
+  statistics.AllocatedBytes = record->AllocatedBytes;
+  statistics.FreedBytes = record->FreedBytes;
+  statistics.PeakBytes = record->PeakBytes;
+  statistics.ProcessPeakBytes = record->ProcessPeakBytes;
+  statistics.Allocations = record->Allocations;
+  statistics.Objects = record->Objects;
+  return statistics;
+}
+
+std::string FormatBytes(vtkTypeInt64 bytes)
+{
+  std::ostringstream os;
+  os.precision(3);
+  double value = static_cast<double>(bytes);
+  if (bytes >= (1 << 30) || bytes <= -(1 << 30))
+  {
+    os << value / (1 << 30) << " GiB";
+  }
+  else if (bytes >= (1 << 20) || bytes <= -(1 << 20))
+  {
+    os << value / (1 << 20) << " MiB";
+  }
+  else if (bytes >= (1 << 10) || bytes <= -(1 << 10))
+  {
+    os << value / (1 << 10) << " KiB";
+  }
+  else
+  {
+    os << bytes << " B";
+  }
+  return os.str();
+}
+
+std::string FormatStatistics(const vtkAllocationTracker::Statistics& statistics)
+{
+  std::ostringstream os;
+  os << "allocated " << FormatBytes(statistics.AllocatedBytes) << " in "
+     << statistics.Allocations << " allocations, freed " << FormatBytes(statistics.FreedBytes)
+     << ", peak " << FormatBytes(statistics.PeakBytes) << ", process peak "
+     << FormatBytes(statistics.ProcessPeakBytes) << ", " << statistics.Objects << " objects";
+  return os.str();
+}
+}
+
+//------------------------------------------------------------------------------
+void vtkAllocationTracker::SetEnabled(bool enabled)
+{
+  Enabled = enabled;
+  vtk::detail::smp::vtkSMPToolsInstrumentation::SetFeatureEnabled(
+    vtk::detail::smp::vtkSMPToolsInstrumentation::ALLOCATION_TRACKING, enabled);
+}
+
+//------------------------------------------------------------------------------
+bool vtkAllocationTracker::GetEnabled()
+{
+  return Enabled;
+}
+
+//------------------------------------------------------------------------------
+void vtkAllocationTracker::SetLogVerbosity(vtkLogger::Verbosity verbosity)
+{
+  LogVerbosity = verbosity;
+}
+
+//------------------------------------------------------------------------------
+vtkLogger::Verbosity vtkAllocationTracker::GetLogVerbosity()
+{
+  return static_cast<vtkLogger::Verbosity>(LogVerbosity.load());
+}
+
+//------------------------------------------------------------------------------
+vtkTypeInt64 vtkAllocationTracker::GetCurrentBytes()
+{
+  return CurrentBytes;
+}
+
+//------------------------------------------------------------------------------
+vtkTypeInt64 vtkAllocationTracker::GetPeakBytes()
+{
+  return PeakBytes;
+}
+
+//------------------------------------------------------------------------------
+void vtkAllocationTracker::ResetPeakBytes()
+{
+  PeakBytes = CurrentBytes.load();
+}
+
+//------------------------------------------------------------------------------
+vtkTypeInt64 vtkAllocationTracker::Allocated(vtkTypeInt64 bytes)
+{
+  if (bytes <= 0 || !Enabled.load(std::memory_order_relaxed))
+  {
+    return 0;
+  }
+  vtkTypeInt64 current = CurrentBytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+  UpdateMaximum(PeakBytes, current);
+  for (Record* record = CurrentRecord; record; record = record->Parent)
+  {
+    record->AllocatedBytes.fetch_add(bytes, std::memory_order_relaxed);
+    record->Allocations.fetch_add(1, std::memory_order_relaxed);
+    UpdateMaximum(
+      record->PeakBytes, record->HeldBytes.fetch_add(bytes, std::memory_order_relaxed) + bytes);
+    UpdateMaximum(record->ProcessPeakBytes, current);
+  }
+  return bytes;
+}
+
+//------------------------------------------------------------------------------
+void vtkAllocationTracker::Freed(vtkTypeInt64 bytes)
+{
+  if (bytes <= 0)
+  {
+    return;
+  }
+  CurrentBytes.fetch_sub(bytes, std::memory_order_relaxed);
+  for (Record* record = CurrentRecord; record; record = record->Parent)
+  {
+    record->FreedBytes.fetch_add(bytes, std::memory_order_relaxed);
+    record->HeldBytes.fetch_sub(bytes, std::memory_order_relaxed);
+  }
+}
+
+//------------------------------------------------------------------------------
+vtkTypeInt64 vtk::detail::vtkBufferAllocated(vtkTypeInt64 bytes)
+{
+  return vtkAllocationTracker::Allocated(bytes);
+}
+
+//------------------------------------------------------------------------------
+void vtk::detail::vtkBufferFreed(vtkTypeInt64 bytes)
+{
+  vtkAllocationTracker::Freed(bytes);
+}
+
+//------------------------------------------------------------------------------
+void vtkAllocationTracker::ObjectCreated()
+{
+  if (!Enabled.load(std::memory_order_relaxed))
+  {
+    return;
+  }
+  for (Record* record = CurrentRecord; record; record = record->Parent)
+  {
+    record->Objects.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+//------------------------------------------------------------------------------
+vtkAllocationTracker::Record* vtkAllocationTracker::GetCurrentRecord()
+{
+  return CurrentRecord;
+}
+
+//------------------------------------------------------------------------------
+vtkAllocationTracker::Record* vtkAllocationTracker::SetCurrentRecord(Record* record)
+{
+  Record* previous = CurrentRecord;
+  CurrentRecord = record;
+  return previous;
+}
+
+//------------------------------------------------------------------------------
+vtkAllocationTracker::Scope::Scope(const std::string& name)
+  : Current(nullptr)
+  , Previous(nullptr)
+{
+  if (!Enabled)
+  {
+    return;
+  }
+  this->Current = new Record;
+  this->Current->Name = name;
+  this->Current->Parent = CurrentRecord;
+  this->Current->ProcessPeakBytes = CurrentBytes.load();
+  this->Previous = vtkAllocationTracker::SetCurrentRecord(this->Current);
+}
+
+//------------------------------------------------------------------------------
+vtkAllocationTracker::Scope::~Scope()
+{
+  if (!this->Current)
+  {
+    return;
+  }
+  vtkAllocationTracker::SetCurrentRecord(this->Previous);
+  Statistics statistics = GetRecordStatistics(this->Current);
+  vtkVLogF(vtkAllocationTracker::GetLogVerbosity(), "%s: %s", this->Current->Name.c_str(),
+    FormatStatistics(statistics).c_str());
+  {
+    Global& global = Global::Get();
+    std::lock_guard<std::mutex> lock(global.Mutex);
+    Aggregate& aggregate = global.Scopes[this->Current->Name];
+    ++aggregate.Executions;
+    Statistics& totals = aggregate.Totals;
+    totals.AllocatedBytes += statistics.AllocatedBytes;
+    totals.FreedBytes += statistics.FreedBytes;
+    totals.Allocations += statistics.Allocations;
+    totals.Objects += statistics.Objects;
+    totals.PeakBytes = std::max(totals.PeakBytes, statistics.PeakBytes);
+    totals.ProcessPeakBytes = std::max(totals.ProcessPeakBytes, statistics.ProcessPeakBytes);
+  }
+  delete this->Current;
+}
+
+//------------------------------------------------------------------------------
+vtkAllocationTracker::Statistics vtkAllocationTracker::Scope::GetStatistics() const
+{
+  return this->Current ? GetRecordStatistics(this->Current) : Statistics();
+}
+
+//------------------------------------------------------------------------------
+std::string vtkAllocationTracker::GetSummary()
+{
+  std::ostringstream os;
+  os << "{ \"current_bytes\": " << CurrentBytes.load()
+     << ", \"peak_bytes\": " << PeakBytes.load() << ", \"scopes\": [";
+  Global& global = Global::Get();
+  std::lock_guard<std::mutex> lock(global.Mutex);
+  const char* separator = "\n";
+  for (const auto& scope : global.Scopes)
+  {
+    std::string name;
+    for (char c : scope.first)
+    {
+      if (c == '"' || c == '\\')
+      {
+        name += '\\';
+      }
+      name += static_cast<unsigned char>(c) < 0x20 ? ' ' : c;
+    }
+    const Statistics& totals = scope.second.Totals;
+    os << separator << "  { \"name\": \"" << name
+       << "\", \"executions\": " << scope.second.Executions
+       << ", \"allocated_bytes\": " << totals.AllocatedBytes
+       << ", \"freed_bytes\": " << totals.FreedBytes
+       << ", \"allocations\": " << totals.Allocations << ", \"objects\": " << totals.Objects
+       << ", \"peak_bytes\": " << totals.PeakBytes
+       << ", \"process_peak_bytes\": " << totals.ProcessPeakBytes << " }";
+    separator = ",\n";
+  }
+  os << (global.Scopes.empty() ? "] }\n" : "\n] }\n");
+  return os.str();
+}
+
+//------------------------------------------------------------------------------
+void vtkAllocationTracker::LogSummary(vtkLogger::Verbosity verbosity)
+{
+  vtkVLogF(verbosity, "tracked memory: %s, peak %s", FormatBytes(CurrentBytes).c_str(),
+    FormatBytes(PeakBytes).c_str());
+  Global& global = Global::Get();
+  std::lock_guard<std::mutex> lock(global.Mutex);
+  for (const auto& scope : global.Scopes)
+  {
+    vtkVLogF(verbosity, "%s: %lld executions, %s", scope.first.c_str(),
+      static_cast<long long>(scope.second.Executions),
+      FormatStatistics(scope.second.Totals).c_str());
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkAllocationTracker::ClearSummary()
+{
+  Global& global = Global::Get();
+  std::lock_guard<std::mutex> lock(global.Mutex);
+  global.Scopes.clear();
+}
+
+//------------------------------------------------------------------------------
+void vtkAllocationTracker::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Enabled: " << vtkAllocationTracker::GetEnabled() << "\n";
+  os << indent << "LogVerbosity: " << vtkAllocationTracker::GetLogVerbosity() << "\n";
+  os << indent << "CurrentBytes: " << vtkAllocationTracker::GetCurrentBytes() << "\n";
+  os << indent << "PeakBytes: " << vtkAllocationTracker::GetPeakBytes() << "\n";
+}
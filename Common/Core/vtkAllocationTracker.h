@@ -0,0 +1,241 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkAllocationTracker.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkAllocationTracker
+ * @brief   attribute memory allocations and peaks to executing code
+ *
+ * vtkAllocationTracker keeps count of the memory allocated by the data arrays
+ * (through vtkBuffer) and of the objects created, and attributes them to the
+ * code being executed: the regions delimited by a vtkAllocationTracker::Scope.
+ * The executives open such a scope around the REQUEST_DATA pass of every
+ * algorithm, so that each execution of an algorithm gets its bytes allocated
+ * and freed, its number of allocations and objects created, and its
+ * high-water mark: the largest number of bytes it held at once. The
+ * executives also store these in the output information of the algorithm,
+ * see vtkExecutive::ALLOCATED_BYTES().
+ *
+ * Allocations made by the threads of vtkSMPTools::For() are attributed to the
+ * scope of the thread calling vtkSMPTools::For(). Nested scopes also count
+ * toward the scopes enclosing them, so the counts of an algorithm include
+ * those of the upstream algorithms it updates while executing. Memory freed
+ * within a scope is subtracted from it even when it was allocated elsewhere,
+ * e.g. when an algorithm releases the data of its input.
+ *
+ * The executions are aggregated per scope name. GetSummary() returns the
+ * aggregates as JSON and LogSummary() logs them. Each execution is also
+ * logged when it ends, at the verbosity set with SetLogVerbosity().
+ *
+ * Tracking is disabled by default, in which case it costs a test per
+ * allocation. It is enabled with SetEnabled() or by setting the
+ * `VTK_ALLOCATION_TRACKING` environment variable; if the value of the
+ * variable is a vtkLogger verbosity, e.g. `INFO`, it also sets the log
+ * verbosity, which is useful to find the algorithm that was executing when a
+ * process ran out of memory.
+ *
+ * Only the memory of data arrays backed by a vtkBuffer is counted, which
+ * excludes vtkStringArray, vtkBitArray and the internal structures of the
+ * algorithms. Objects created are counted but their size is not.
+ *
+ * @sa
+ * vtkExecutive vtkBuffer vtkPerformanceCounters
+ */
+
+#ifndef vtkAllocationTracker_h
+#define vtkAllocationTracker_h
+
+#include "vtkCommonCoreModule.h" // For export macro
+#include "vtkLogger.h"           // For vtkLogger::Verbosity
+#include "vtkObject.h"
+
+#include <string> // For std::string
+
+class VTKCOMMONCORE_EXPORT vtkAllocationTracker : public vtkObject
+{
+public:
+  static vtkAllocationTracker* New();
+  vtkTypeMacro(vtkAllocationTracker, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  ///@{
+  /**
+   * Enable or disable the tracking. Disabled by default, unless the
+   * `VTK_ALLOCATION_TRACKING` environment variable is set.
+   */
+  static void SetEnabled(bool enabled);
+  static bool GetEnabled();
+  ///@}
+
+  ///@{
+  /**
+   * Verbosity at which every execution of a scope is logged when it ends.
+   * Defaults to vtkLogger::VERBOSITY_TRACE.
+   */
+  static void SetLogVerbosity(vtkLogger::Verbosity verbosity);
+  static vtkLogger::Verbosity GetLogVerbosity();
+  ///@}
+
+  ///@{
+  /**
+   * Bytes of the tracked allocations alive in the process, and the largest
+   * number reached since tracking started or ResetPeakBytes() was called.
+   */
+  static vtkTypeInt64 GetCurrentBytes();
+  static vtkTypeInt64 GetPeakBytes();
+  static void ResetPeakBytes();
+  ///@}
+
+  /**
+   * The aggregated counts of every scope name, as JSON:
+   *
+   * @code{json}
+   * { "current_bytes": 0, "peak_bytes": 3.2e8, "scopes": [ { "name": "...",
+   *   "executions": 2, "allocated_bytes": 1.6e8, "freed_bytes": 1.2e8,
+   *   "allocations": 42, "objects": 17, "peak_bytes": 8e7,
+   *   "process_peak_bytes": 3.2e8 } ] }
+   * @endcode
+   *
+   * The peaks of a scope are the largest over its executions, the other
+   * counts are summed.
+   */
+  static std::string GetSummary();
+
+  /**
+   * Log the aggregated counts, a line per scope name.
+   */
+  static void LogSummary(vtkLogger::Verbosity verbosity = vtkLogger::VERBOSITY_INFO);
+
+  /**
+   * Clear the aggregated counts.
+   */
+  static void ClearSummary();
+
+#if !defined(__WRAP__)
+  /**
+   * The counts of an execution of a scope. Bytes are held by the scope when
+   * they are allocated and not yet freed within it; PeakBytes is the largest
+   * number of bytes held at once. ProcessPeakBytes is the largest number of
+   * tracked bytes alive in the whole process during the execution.
+   */
+  struct Statistics
+  {
+    vtkTypeInt64 AllocatedBytes = 0;
+    vtkTypeInt64 FreedBytes = 0;
+    vtkTypeInt64 PeakBytes = 0;
+    vtkTypeInt64 ProcessPeakBytes = 0;
+    vtkTypeInt64 Allocations = 0;
+    vtkTypeInt64 Objects = 0;
+  };
+
+  ///@{
+  /**
+   * Report memory allocated and freed. Allocated() returns the number of
+   * bytes tracked, 0 when the tracking is disabled, which must be reported
+   * to Freed() when the memory is freed, even if the tracking has been
+   * disabled since.
+   */
+  static vtkTypeInt64 Allocated(vtkTypeInt64 bytes);
+  static void Freed(vtkTypeInt64 bytes);
+  ///@}
+
+  /**
+   * Report the creation of an object. Called by the vtkObjectBase constructor.
+   */
+  static void ObjectCreated();
+
+  /**
+   * Opaque counts of an execution of a scope.
+   */
+  struct Record;
+
+  ///@{
+  /**
+   * The record that the allocations of the calling thread are attributed
+   * to, or nullptr. SetCurrentRecord() returns the previous record. These
+   * let allocations made by worker threads be attributed to the scope that
+   * started the work, see RecordScope.
+   */
+  static Record* GetCurrentRecord();
+  static Record* SetCurrentRecord(Record* record);
+  ///@}
+
+  /**
+   * Attributes the allocations of the calling thread to a scope, in general
+   * one opened by another thread, for its lifetime. Does nothing for a null
+   * record.
+   */
+  class RecordScope
+  {
+  public:
+    explicit RecordScope(Record* record)
+      : Active(record != nullptr)
+      , Previous(record ? vtkAllocationTracker::SetCurrentRecord(record) : nullptr)
+    {
+    }
+    ~RecordScope()
+    {
+      if (this->Active)
+      {
+        vtkAllocationTracker::SetCurrentRecord(this->Previous);
+      }
+    }
+
+  private:
+    RecordScope(const RecordScope&) = delete;
+    void operator=(const RecordScope&) = delete;
+
+    bool Active;
+    Record* Previous;
+  };
+
+  /**
+   * Attributes the allocations of the calling thread to a named scope from
+   * its construction to its destruction, when the tracking is enabled.
+   */
+  class VTKCOMMONCORE_EXPORT Scope
+  {
+  public:
+    explicit Scope(const std::string& name);
+    ~Scope();
+
+    /**
+     * Whether the scope counts anything, i.e. the tracking was enabled when
+     * it was constructed.
+     */
+    bool IsActive() const { return this->Current != nullptr; }
+
+    /**
+     * The counts of the scope so far.
+     */
+    Statistics GetStatistics() const;
+
+  private:
+    Scope(const Scope&) = delete;
+    void operator=(const Scope&) = delete;
+
+    Record* Current;
+    Record* Previous;
+  };
+#endif
+
+protected:
+  vtkAllocationTracker() = default;
+  ~vtkAllocationTracker() override = default;
+
+private:
+  vtkAllocationTracker(const vtkAllocationTracker&) = delete;
+  void operator=(const vtkAllocationTracker&) = delete;
+};
+
+#endif
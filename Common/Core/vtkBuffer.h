@@ -30,6 +30,18 @@
 
 #include <algorithm> // for std::min and std::copy
 
+namespace vtk
+{
+namespace detail
+{
+// Report the memory of the buffers, see vtkAllocationTracker::Allocated()
+// and vtkAllocationTracker::Freed(). Declared here rather than including
+// vtkAllocationTracker.h in every user of the data arrays.
+VTKCOMMONCORE_EXPORT vtkTypeInt64 vtkBufferAllocated(vtkTypeInt64 bytes);
+VTKCOMMONCORE_EXPORT void vtkBufferFreed(vtkTypeInt64 bytes);
+} // namespace detail
+} // namespace vtk
+
 template <class ScalarTypeT>
 class vtkBuffer : public vtkObject
 {
@@ -91,6 +103,7 @@ protected:
   vtkBuffer()
     : Pointer(nullptr)
     , Size(0)
+    , TrackedBytes(0)
   {
     this->SetMallocFunction(vtkObjectBase::GetCurrentMallocFunction());
     this->SetReallocFunction(vtkObjectBase::GetCurrentReallocFunction());
@@ -104,6 +117,8 @@ protected:
   vtkMallocingFunction MallocFunction;
   vtkReallocingFunction ReallocFunction;
   vtkFreeingFunction DeleteFunction;
+  // Bytes of the buffer reported to vtkAllocationTracker.
+  vtkTypeInt64 TrackedBytes;
 
 private:
   vtkBuffer(const vtkBuffer&) = delete;
@@ -133,6 +148,8 @@ void vtkBuffer<ScalarT>::SetBuffer(typename vtkBuffer<ScalarT>::ScalarType* arra
     {
       this->DeleteFunction(this->Pointer);
     }
+    vtk::detail::vtkBufferFreed(this->TrackedBytes);
+    this->TrackedBytes = 0;
     this->Pointer = array;
   }
   this->Size = size;
@@ -184,6 +201,7 @@ bool vtkBuffer<ScalarT>::Allocate(vtkIdType size)
     if (newArray)
     {
       this->SetBuffer(newArray, size);
+      this->TrackedBytes = vtk::detail::vtkBufferAllocated(size * sizeof(ScalarType));
       if (!this->MallocFunction)
       {
         this->DeleteFunction = free;
@@ -231,8 +249,11 @@ bool vtkBuffer<ScalarT>::Reallocate(vtkIdType newsize)
       return false;
     }
     std::copy(this->Pointer, this->Pointer + std::min(this->Size, newsize), newArray);
+    // both arrays are alive until the old one is released.
+    vtkTypeInt64 trackedBytes = vtk::detail::vtkBufferAllocated(newsize * sizeof(ScalarType));
     // now save the new array and release the old one too.
     this->SetBuffer(newArray, newsize);
+    this->TrackedBytes = trackedBytes;
     if (!this->MallocFunction || forceFreeFunction)
     {
       this->DeleteFunction = free;
@@ -256,6 +277,11 @@ bool vtkBuffer<ScalarT>::Reallocate(vtkIdType newsize)
     {
       return false;
     }
+    // counted as an allocation of the new size followed by the release of
+    // the old buffer, the worst case of a realloc.
+    vtkTypeInt64 trackedBytes = vtk::detail::vtkBufferAllocated(newsize * sizeof(ScalarType));
+    vtk::detail::vtkBufferFreed(this->TrackedBytes);
+    this->TrackedBytes = trackedBytes;
     this->Pointer = newArray;
     this->Size = newsize;
   }
@@ -25,7 +25,6 @@
 #include "vtkInformationIntegerKey.h"
 #include "vtkInformationIntegerPointerKey.h"
 #include "vtkInformationIntegerVectorKey.h"
-#include "vtkInformationIterator.h"
 #include "vtkInformationKeyVectorKey.h"
 #include "vtkInformationObjectBaseKey.h"
 #include "vtkInformationObjectBaseVectorKey.h"
@@ -36,7 +35,6 @@
 #include "vtkInformationVariantKey.h"
 #include "vtkInformationVariantVectorKey.h"
 #include "vtkObjectFactory.h"
-#include "vtkSmartPointer.h"
 #include "vtkVariant.h"
 
 #include <algorithm>
@@ -110,20 +108,10 @@ void vtkInformation::Modified(vtkInformationKey* key)
 }
 
 //------------------------------------------------------------------------------
-// Return the number of keys as a result of iteration.
+// Return the number of keys.
 int vtkInformation::GetNumberOfKeys()
 {
-  vtkSmartPointer<vtkInformationIterator> infoIterator =
-    vtkSmartPointer<vtkInformationIterator>::New();
-  infoIterator->SetInformation(this);
-
-  int numberOfKeys = 0;
-  for (infoIterator->InitTraversal(); !infoIterator->IsDoneWithTraversal();
-       infoIterator->GoToNextItem())
-  {
-    numberOfKeys++;
-  }
-  return numberOfKeys;
+  return static_cast<int>(this->Internal->Map.size());
 }
 
 //------------------------------------------------------------------------------
@@ -155,6 +143,12 @@ void vtkInformation::SetAsObjectBase(vtkInformationKey* key, vtkObjectBase* newv
     this->Internal->Map.insert(entry);
     newvalue->Register(nullptr);
   }
+  else
+  {
+    // Removing a key that is not there, e.g. copying a missing entry,
+    // changes nothing.
+    return;
+  }
   this->Modified(key);
 }
 
@@ -201,6 +195,7 @@ void vtkInformation::Copy(vtkInformation* from, int deep)
   this->Internal = new vtkInformationInternals;
   if (from)
   {
+    this->Internal->Map.reserve(from->Internal->Map.size());
     typedef vtkInformationInternals::MapType MapType;
     for (MapType::const_iterator i = from->Internal->Map.begin(); i != from->Internal->Map.end();
          ++i)
@@ -27,12 +27,9 @@
 #include "vtkInformationKey.h"
 #include "vtkObjectBase.h"
 
-#define VTK_INFORMATION_USE_HASH_MAP
-#ifdef VTK_INFORMATION_USE_HASH_MAP
-#include <unordered_map>
-#else
-#include <map>
-#endif
+#include <cstdint>
+#include <utility>
+#include <vector>
 
 //----------------------------------------------------------------------------
 class vtkInformationInternals
@@ -40,23 +37,174 @@ class vtkInformationInternals
 public:
   typedef vtkInformationKey* KeyType;
   typedef vtkObjectBase* DataType;
-#ifdef VTK_INFORMATION_USE_HASH_MAP
-  struct HashFun
+
+  /**
+   * Hash table of the entries, with open addressing and linear probing so
+   * that a lookup touches a few contiguous slots and an empty information
+   * allocates nothing. Keys are singletons, compared and hashed by address.
+   * An erased entry leaves a tombstone, so that erasing does not move the
+   * other entries nor invalidate iterators to them. Inserting may rehash and
+   * invalidate all iterators, as with std::unordered_map.
+   */
+  class MapType
   {
-    size_t operator()(KeyType key) const { return static_cast<size_t>(key - KeyType(nullptr)); }
+  public:
+    typedef std::pair<KeyType, DataType> value_type;
+
+    class iterator
+    {
+    public:
+      iterator() = default;
+      iterator(value_type* slot, value_type* end)
+        : Slot(slot)
+        , End(end)
+      {
+        this->SkipFreeSlots();
+      }
+      value_type& operator*() const { return *this->Slot; }
+      value_type* operator->() const { return this->Slot; }
+      iterator& operator++()
+      {
+        ++this->Slot;
+        this->SkipFreeSlots();
+        return *this;
+      }
+      bool operator==(const iterator& other) const { return this->Slot == other.Slot; }
+      bool operator!=(const iterator& other) const { return this->Slot != other.Slot; }
+
+    private:
+      void SkipFreeSlots()
+      {
+        while (this->Slot != this->End && MapType::IsFree(this->Slot->first))
+        {
+          ++this->Slot;
+        }
+      }
+
+      value_type* Slot = nullptr;
+      value_type* End = nullptr;
+    };
+    typedef iterator const_iterator;
+
+    iterator begin() { return iterator(this->Slots.data(), this->EndSlot()); }
+    iterator end() { return iterator(this->EndSlot(), this->EndSlot()); }
+    size_t size() const { return this->Used; }
+
+    iterator find(KeyType key)
+    {
+      if (this->Used == 0)
+      {
+        return this->end();
+      }
+      size_t mask = this->Slots.size() - 1;
+      for (size_t i = Hash(key) & mask;; i = (i + 1) & mask)
+      {
+        if (this->Slots[i].first == key)
+        {
+          return iterator(&this->Slots[i], this->EndSlot());
+        }
+        if (!this->Slots[i].first)
+        {
+          return this->end();
+        }
+      }
+    }
+
+    std::pair<iterator, bool> insert(const value_type& entry)
+    {
+      this->reserve(this->Used + 1);
+      size_t mask = this->Slots.size() - 1;
+      value_type* tombstone = nullptr;
+      for (size_t i = Hash(entry.first) & mask;; i = (i + 1) & mask)
+      {
+        value_type& slot = this->Slots[i];
+        if (slot.first == entry.first)
+        {
+          return std::make_pair(iterator(&slot, this->EndSlot()), false);
+        }
+        if (slot.first == Tombstone() && !tombstone)
+        {
+          tombstone = &slot;
+        }
+        else if (!slot.first)
+        {
+          value_type* free = &slot;
+          if (tombstone)
+          {
+            free = tombstone;
+            --this->Tombstones;
+          }
+          *free = entry;
+          ++this->Used;
+          return std::make_pair(iterator(free, this->EndSlot()), true);
+        }
+      }
+    }
+
+    void erase(iterator i)
+    {
+      i->first = Tombstone();
+      i->second = nullptr;
+      --this->Used;
+      ++this->Tombstones;
+    }
+
+    /**
+     * Make room for `count` entries, so that inserting them does not rehash.
+     */
+    void reserve(size_t count)
+    {
+      // Keep the slots at most 3/4 full so that probing stays short.
+      if (4 * (count + this->Tombstones) > 3 * this->Slots.size())
+      {
+        this->Rehash(count > this->Used ? count : this->Used);
+      }
+    }
+
+  private:
+    void Rehash(size_t count)
+    {
+      size_t capacity = 8;
+      while (4 * count > 3 * capacity)
+      {
+        capacity *= 2;
+      }
+      std::vector<value_type> slots(capacity, value_type(nullptr, nullptr));
+      slots.swap(this->Slots);
+      this->Tombstones = 0;
+      size_t mask = capacity - 1;
+      for (const value_type& entry : slots)
+      {
+        if (!IsFree(entry.first))
+        {
+          size_t i = Hash(entry.first) & mask;
+          while (this->Slots[i].first)
+          {
+            i = (i + 1) & mask;
+          }
+          this->Slots[i] = entry;
+        }
+      }
+    }
+
+    static size_t Hash(KeyType key)
+    {
+      // Drop the bits zeroed by the alignment of the keys, then mix.
+      size_t h = static_cast<size_t>(reinterpret_cast<std::uintptr_t>(key) >> 3);
+      h *= static_cast<size_t>(0x9E3779B1u);
+      return h ^ (h >> 16);
+    }
+    static KeyType Tombstone() { return reinterpret_cast<KeyType>(std::uintptr_t(1)); }
+    static bool IsFree(KeyType key) { return !key || key == Tombstone(); }
+    value_type* EndSlot() { return this->Slots.data() + this->Slots.size(); }
+
+    std::vector<value_type> Slots;
+    size_t Used = 0;
+    size_t Tombstones = 0;
   };
-  typedef std::unordered_map<KeyType, DataType, HashFun> MapType;
-#else
-  typedef std::map<KeyType, DataType> MapType;
-#endif
   MapType Map;
 
-#ifdef VTK_INFORMATION_USE_HASH_MAP
-  vtkInformationInternals()
-    : Map(33)
-  {
-  }
-#endif
+  vtkInformationInternals() = default;
 
   ~vtkInformationInternals()
   {
@@ -73,7 +221,5 @@ private:
   vtkInformationInternals(vtkInformationInternals const&) = delete;
 };
 
-#undef VTK_INFORMATION_USE_HASH_MAP
-
 #endif
 // VTK-HeaderTest-Exclude: vtkInformationInternals.h
@@ -15,6 +15,7 @@
 #include "vtkLogger.h"
 
 #include "vtkObjectFactory.h"
+#include "vtkPerformanceCounters.h"
 
 #if VTK_MODULE_ENABLE_VTK_loguru
 #include <vtk_loguru.h>
@@ -28,12 +29,61 @@
 #include <unordered_map>
 #include <vector>
 
+//=============================================================================
+namespace detail
+{
+// Reads the hardware performance counters over a scope and logs the counts
+// within the scope when it ends.
+class CountedScope
+{
+public:
+  CountedScope(
+    vtkLogger::Verbosity verbosity, const char* fname, unsigned int lineno, const std::string& id)
+    : Verbosity(verbosity)
+    , FileName(fname)
+    , Line(lineno)
+    , Id(id)
+    , Counters(this->Id.c_str())
+  {
+  }
+
+  ~CountedScope()
+  {
+    std::string counts = this->Counters.Stop();
+    if (!counts.empty())
+    {
+      vtkLogger::Log(this->Verbosity, this->FileName, this->Line, ("counters: " + counts).c_str());
+    }
+  }
+
+  static std::unique_ptr<CountedScope> New(
+    vtkLogger::Verbosity verbosity, const char* fname, unsigned int lineno, const std::string& id)
+  {
+    return std::unique_ptr<CountedScope>(vtkPerformanceCounters::GetEnabled()
+        ? new CountedScope(verbosity, fname, lineno, id)
+        : nullptr);
+  }
+
+private:
+  CountedScope(const CountedScope&) = delete;
+  void operator=(const CountedScope&) = delete;
+
+  vtkLogger::Verbosity Verbosity;
+  const char* FileName;
+  unsigned int Line;
+  std::string Id;
+  vtkPerformanceCounters::Scope Counters;
+};
+}
+
 //=============================================================================
 class vtkLogger::LogScopeRAII::LSInternals
 {
 public:
 #if VTK_MODULE_ENABLE_VTK_loguru
   std::unique_ptr<loguru::LogScopeRAII> Data;
+  // Destroyed first, to log the counts within the scope.
+  std::unique_ptr<detail::CountedScope> Counters;
 #endif
 };
 
@@ -57,6 +107,7 @@ vtkLogger::LogScopeRAII::LogScopeRAII(
   va_end(vlist);
   this->Internals->Data.reset(new loguru::LogScopeRAII(
     static_cast<loguru::Verbosity>(verbosity), fname, lineno, "%s", result.c_str()));
+  this->Internals->Counters = detail::CountedScope::New(verbosity, fname, lineno, result);
 #else
   (void)verbosity;
   (void)fname;
@@ -74,18 +125,25 @@ vtkLogger::LogScopeRAII::~LogScopeRAII()
 namespace detail
 {
 #if VTK_MODULE_ENABLE_VTK_loguru
-using scope_pair = std::pair<std::string, std::shared_ptr<loguru::LogScopeRAII>>;
+struct scope_entry
+{
+  std::string first;
+  std::shared_ptr<loguru::LogScopeRAII> second;
+  // Destroyed first, to log the counts within the scope.
+  std::shared_ptr<CountedScope> counters;
+};
 static std::mutex g_mutex;
-static std::unordered_map<std::thread::id, std::vector<scope_pair>> g_vectors;
-static std::vector<scope_pair>& get_vector()
+static std::unordered_map<std::thread::id, std::vector<scope_entry>> g_vectors;
+static std::vector<scope_entry>& get_vector()
 {
   std::lock_guard<std::mutex> guard(g_mutex);
   return g_vectors[std::this_thread::get_id()];
 }
 
-static void push_scope(const char* id, std::shared_ptr<loguru::LogScopeRAII> ptr)
+static void push_scope(const char* id, std::shared_ptr<loguru::LogScopeRAII> ptr,
+  std::unique_ptr<CountedScope> counters = nullptr)
 {
-  get_vector().emplace_back(std::string(id), ptr);
+  get_vector().push_back(scope_entry{ std::string(id), ptr, std::move(counters) });
 }
 
 static void pop_scope(const char* id)
@@ -341,11 +399,17 @@ void vtkLogger::StartScope(
   Verbosity verbosity, const char* id, const char* fname, unsigned int lineno)
 {
 #if VTK_MODULE_ENABLE_VTK_loguru
-  detail::push_scope(id,
-    verbosity > vtkLogger::GetCurrentVerbosityCutoff()
-      ? std::make_shared<loguru::LogScopeRAII>()
-      : std::make_shared<loguru::LogScopeRAII>(
-          static_cast<loguru::Verbosity>(verbosity), fname, lineno, "%s", id));
+  if (verbosity > vtkLogger::GetCurrentVerbosityCutoff())
+  {
+    detail::push_scope(id, std::make_shared<loguru::LogScopeRAII>());
+  }
+  else
+  {
+    detail::push_scope(id,
+      std::make_shared<loguru::LogScopeRAII>(
+        static_cast<loguru::Verbosity>(verbosity), fname, lineno, "%s", id),
+      detail::CountedScope::New(verbosity, fname, lineno, id));
+  }
 #else
   (void)verbosity;
   (void)id;
@@ -382,7 +446,8 @@ void vtkLogger::StartScopeF(Verbosity verbosity, const char* id, const char* fna
 
     detail::push_scope(id,
       std::make_shared<loguru::LogScopeRAII>(
-        static_cast<loguru::Verbosity>(verbosity), fname, lineno, "%s", result.c_str()));
+        static_cast<loguru::Verbosity>(verbosity), fname, lineno, "%s", result.c_str()),
+      detail::CountedScope::New(verbosity, fname, lineno, result));
   }
 #else
   (void)verbosity;
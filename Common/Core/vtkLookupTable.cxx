@@ -19,10 +19,19 @@
 #include "vtkMath.h"
 #include "vtkMathConfigure.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
 #include "vtkStringArray.h"
 #include "vtkVariantArray.h"
 
+#include <algorithm>
 #include <cassert>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 const vtkIdType vtkLookupTable::REPEATED_LAST_COLOR_INDEX = 0;
 const vtkIdType vtkLookupTable::BELOW_RANGE_COLOR_INDEX = 1;
@@ -577,39 +586,6 @@ inline vtkIdType vtkLinearIndexLookupMain(double v, const TableParameters& p)
   return index;
 }
 
-//------------------------------------------------------------------------------
-// integer variant
-template <class T>
-inline vtkIdType vtkLinearLookup(T v, const TableParameters& p)
-{
-  // First convert from integer to double.
-  double dv = static_cast<double>(v);
-  return vtkLinearIndexLookupMain(dv, p);
-}
-
-//------------------------------------------------------------------------------
-// double variant
-inline vtkIdType vtkLinearLookup(double v, const TableParameters& p)
-{
-  // If Nan, use the special NaN color.
-  if (vtkMath::IsNan(v))
-  {
-    vtkIdType maxIndex = p.NumColors + vtkLookupTable::NAN_COLOR_INDEX;
-    return maxIndex;
-  }
-
-  return vtkLinearIndexLookupMain(v, p);
-}
-
-//------------------------------------------------------------------------------
-// float variant
-inline vtkIdType vtkLinearLookup(float v, const TableParameters& p)
-{
-  // Convert from float to double, then call the double variant.
-  double dv = static_cast<double>(v);
-  return vtkLinearLookup(dv, p);
-}
-
 //------------------------------------------------------------------------------
 inline void vtkLookupShiftAndScale(
   const double range[2], double numColors, double& shift, double& scale)
@@ -795,266 +771,202 @@ namespace
 {
 
 //------------------------------------------------------------------------------
+// The values are mapped in blocks: the table indices of a block are
+// computed first, in a loop whose only branches are selects that the
+// compiler can vectorize, and then the colors are copied.
+const int VTK_LOOKUP_BLOCK_SIZE = 256;
+
+//------------------------------------------------------------------------------
+// Compute the table indices of a block of values, like
+// vtkLinearIndexLookupMain but with the NaN index for NaN values.
 template <class T>
-void vtkLookupTableMapData(vtkLookupTable* self, T* input, unsigned char* output, int length,
-  int inIncr, int outFormat, TableParameters& p)
+void vtkLookupTableComputeIndices(
+  const T* input, int n, int inIncr, const TableParameters& p, int* indices)
 {
-  int i = length;
-  const double* range = self->GetTableRange();
-  const unsigned char* cptr;
-
-  // Resize the internal table to hold the special colors at the
-  // end. When this function is called repeatedly with the same size
-  // lookup table, memory reallocation will be done only one the first
-  // call if at all.
-
-  vtkUnsignedCharArray* lookupTable = self->GetTable();
-
-  const unsigned char* table = lookupTable->GetPointer(0);
-
-  double alpha = self->GetAlpha();
-  if (alpha >= 1.0) // no blending required
+  const double below = static_cast<double>(p.NumColors + vtkLookupTable::BELOW_RANGE_COLOR_INDEX);
+  const double above = static_cast<double>(p.NumColors + vtkLookupTable::ABOVE_RANGE_COLOR_INDEX);
+  const double nan = static_cast<double>(p.NumColors + vtkLookupTable::NAN_COLOR_INDEX);
+  const double range0 = p.Range[0];
+  const double range1 = p.Range[1];
+  const double shift = p.Shift;
+  const double scale = p.Scale;
+
+  for (int j = 0; j < n; ++j)
   {
-    if (self->GetScale() == VTK_SCALE_LOG10)
+    double v = static_cast<double>(input[j * inIncr]);
+    double dIndex = (v + shift) * scale;
+    dIndex = (v < range0 ? below : dIndex);
+    dIndex = (v > range1 ? above : dIndex);
+    if (!std::numeric_limits<T>::is_integer)
     {
-      double val;
-      double logRange[2];
-      vtkLookupTableLogRange(range, logRange);
-      vtkLookupShiftAndScale(logRange, p.NumColors, p.Shift, p.Scale);
-      p.Range[0] = logRange[0];
-      p.Range[1] = logRange[1];
-
-      if (outFormat == VTK_RGBA)
-      {
-        while (--i >= 0)
-        {
-          val = vtkApplyLogScale(*input, range, logRange);
-          vtkIdType idx = vtkLinearLookup(val, p);
-          cptr = table + 4 * idx;
-          memcpy(output, cptr, 4);
-          input += inIncr;
-          output += 4;
-        }
-      }
-      else if (outFormat == VTK_RGB)
-      {
-        while (--i >= 0)
-        {
-          val = vtkApplyLogScale(*input, range, logRange);
-          vtkIdType idx = vtkLinearLookup(val, p);
-          cptr = table + 4 * idx;
-          memcpy(output, cptr, 3);
-          input += inIncr;
-          output += 3;
-        }
-      }
-      else if (outFormat == VTK_LUMINANCE_ALPHA)
-      {
-        while (--i >= 0)
-        {
-          val = vtkApplyLogScale(*input, range, logRange);
-          vtkIdType idx = vtkLinearLookup(val, p);
-          cptr = table + 4 * idx;
-          output[0] =
-            static_cast<unsigned char>(cptr[0] * 0.30 + cptr[1] * 0.59 + cptr[2] * 0.11 + 0.5);
-          output[1] = cptr[3];
-          input += inIncr;
-          output += 2;
-        }
-      }
-      else // outFormat == VTK_LUMINANCE
-      {
-        while (--i >= 0)
-        {
-          val = vtkApplyLogScale(*input, range, logRange);
-          vtkIdType idx = vtkLinearLookup(val, p);
-          cptr = table + 4 * idx;
-          *output++ =
-            static_cast<unsigned char>(cptr[0] * 0.30 + cptr[1] * 0.59 + cptr[2] * 0.11 + 0.5);
-          input += inIncr;
-        }
-      }
-    } // if log scale
+      dIndex = (v != v ? nan : dIndex);
+    }
+    indices[j] = static_cast<int>(dIndex);
+  }
+}
 
-    else // not log scale
+//------------------------------------------------------------------------------
+// Copy the colors of a block of table indices to the output.
+void vtkLookupTableCopyColors(const unsigned char* table, const int* indices, int n,
+  int outFormat, double alpha, unsigned char* output)
+{
+  const unsigned char* cptr;
+  if (outFormat == VTK_RGBA)
+  {
+    if (alpha >= 1.0) // no blending required
     {
-      vtkLookupShiftAndScale(range, p.NumColors, p.Shift, p.Scale);
-      p.Range[0] = range[0];
-      p.Range[1] = range[1];
-      if (outFormat == VTK_RGBA)
-      {
-        while (--i >= 0)
-        {
-          vtkIdType idx = vtkLinearLookup(*input, p);
-          cptr = table + 4 * idx;
-          memcpy(output, cptr, 4);
-          input += inIncr;
-          output += 4;
-        }
-      }
-      else if (outFormat == VTK_RGB)
-      {
-        while (--i >= 0)
-        {
-          vtkIdType idx = vtkLinearLookup(*input, p);
-          cptr = table + 4 * idx;
-          memcpy(output, cptr, 3);
-          input += inIncr;
-          output += 3;
-        }
-      }
-      else if (outFormat == VTK_LUMINANCE_ALPHA)
+      for (int j = 0; j < n; ++j)
       {
-        while (--i >= 0)
-        {
-          vtkIdType idx = vtkLinearLookup(*input, p);
-          cptr = table + 4 * idx;
-          output[0] =
-            static_cast<unsigned char>(cptr[0] * 0.30 + cptr[1] * 0.59 + cptr[2] * 0.11 + 0.5);
-          output[1] = cptr[3];
-          input += inIncr;
-          output += 2;
-        }
+        memcpy(output, table + 4 * indices[j], 4);
+        output += 4;
       }
-      else // outFormat == VTK_LUMINANCE
+    }
+    else
+    {
+      for (int j = 0; j < n; ++j)
       {
-        while (--i >= 0)
-        {
-          vtkIdType idx = vtkLinearLookup(*input, p);
-          cptr = table + 4 * idx;
-          *output++ =
-            static_cast<unsigned char>(cptr[0] * 0.30 + cptr[1] * 0.59 + cptr[2] * 0.11 + 0.5);
-          input += inIncr;
-        }
+        cptr = table + 4 * indices[j];
+        memcpy(output, cptr, 3);
+        output[3] = static_cast<unsigned char>(cptr[3] * alpha + 0.5);
+        output += 4;
       }
-    } // if not log lookup
-  }   // if blending not needed
+    }
+  }
+  else if (outFormat == VTK_RGB)
+  {
+    for (int j = 0; j < n; ++j)
+    {
+      memcpy(output, table + 4 * indices[j], 3);
+      output += 3;
+    }
+  }
+  else if (outFormat == VTK_LUMINANCE_ALPHA)
+  {
+    for (int j = 0; j < n; ++j)
+    {
+      cptr = table + 4 * indices[j];
+      output[0] =
+        static_cast<unsigned char>(cptr[0] * 0.30 + cptr[1] * 0.59 + cptr[2] * 0.11 + 0.5);
+      output[1] = (alpha >= 1.0 ? cptr[3] : static_cast<unsigned char>(cptr[3] * alpha + 0.5));
+      output += 2;
+    }
+  }
+  else // outFormat == VTK_LUMINANCE
+  {
+    for (int j = 0; j < n; ++j)
+    {
+      cptr = table + 4 * indices[j];
+      *output++ =
+        static_cast<unsigned char>(cptr[0] * 0.30 + cptr[1] * 0.59 + cptr[2] * 0.11 + 0.5);
+    }
+  }
+}
 
-  else // blend with the specified alpha
+//------------------------------------------------------------------------------
+template <class T>
+void vtkLookupTableMapData(vtkLookupTable* self, T* input, unsigned char* output, int length,
+  int inIncr, int outFormat, TableParameters& p)
+{
+  const double* range = self->GetTableRange();
+  const unsigned char* table = self->GetTable()->GetPointer(0);
+  double alpha = self->GetAlpha();
+  bool logScale = (self->GetScale() == VTK_SCALE_LOG10);
+
+  double logRange[2];
+  if (logScale)
   {
-    if (self->GetScale() == VTK_SCALE_LOG10)
+    vtkLookupTableLogRange(range, logRange);
+    vtkLookupShiftAndScale(logRange, p.NumColors, p.Shift, p.Scale);
+    p.Range[0] = logRange[0];
+    p.Range[1] = logRange[1];
+  }
+  else
+  {
+    vtkLookupShiftAndScale(range, p.NumColors, p.Shift, p.Scale);
+    p.Range[0] = range[0];
+    p.Range[1] = range[1];
+  }
+
+  int indices[VTK_LOOKUP_BLOCK_SIZE];
+  double values[VTK_LOOKUP_BLOCK_SIZE];
+  for (int i = 0; i < length; i += VTK_LOOKUP_BLOCK_SIZE)
+  {
+    int n = std::min(VTK_LOOKUP_BLOCK_SIZE, length - i);
+    if (logScale)
     {
-      double val;
-      double logRange[2];
-      vtkLookupTableLogRange(range, logRange);
-      vtkLookupShiftAndScale(logRange, p.NumColors, p.Shift, p.Scale);
-      p.Range[0] = logRange[0];
-      p.Range[1] = logRange[1];
-
-      if (outFormat == VTK_RGBA)
-      {
-        while (--i >= 0)
-        {
-          val = vtkApplyLogScale(*input, range, logRange);
-          vtkIdType idx = vtkLinearLookup(val, p);
-          cptr = table + 4 * idx;
-          output[0] = cptr[0];
-          output[1] = cptr[1];
-          output[2] = cptr[2];
-          output[3] = static_cast<unsigned char>(cptr[3] * alpha + 0.5);
-          input += inIncr;
-          output += 4;
-        }
-      }
-      else if (outFormat == VTK_RGB)
-      {
-        while (--i >= 0)
-        {
-          val = vtkApplyLogScale(*input, range, logRange);
-          vtkIdType idx = vtkLinearLookup(val, p);
-          cptr = table + 4 * idx;
-          memcpy(output, cptr, 3);
-          input += inIncr;
-          output += 3;
-        }
-      }
-      else if (outFormat == VTK_LUMINANCE_ALPHA)
+      for (int j = 0; j < n; ++j)
       {
-        while (--i >= 0)
-        {
-          val = vtkApplyLogScale(*input, range, logRange);
-          vtkIdType idx = vtkLinearLookup(val, p);
-          cptr = table + 4 * idx;
-          output[0] =
-            static_cast<unsigned char>(cptr[0] * 0.30 + cptr[1] * 0.59 + cptr[2] * 0.11 + 0.5);
-          output[1] = static_cast<unsigned char>(alpha * cptr[3] + 0.5);
-          input += inIncr;
-          output += 2;
-        }
+        values[j] = vtkApplyLogScale(input[j * inIncr], range, logRange);
       }
-      else // outFormat == VTK_LUMINANCE
-      {
-        while (--i >= 0)
-        {
-          val = vtkApplyLogScale(*input, range, logRange);
-          vtkIdType idx = vtkLinearLookup(val, p);
-          cptr = table + 4 * idx;
-          *output++ =
-            static_cast<unsigned char>(cptr[0] * 0.30 + cptr[1] * 0.59 + cptr[2] * 0.11 + 0.5);
-          input += inIncr;
-        }
-      }
-    } // log scale with blending
-
-    else // no log scale with blending
+      vtkLookupTableComputeIndices(values, n, 1, p, indices);
+    }
+    else
     {
-      vtkLookupShiftAndScale(range, p.NumColors, p.Shift, p.Scale);
-      p.Range[0] = range[0];
-      p.Range[1] = range[1];
+      vtkLookupTableComputeIndices(input, n, inIncr, p, indices);
+    }
+    vtkLookupTableCopyColors(table, indices, n, outFormat, alpha, output);
+    input += n * inIncr;
+    output += n * outFormat;
+  }
+}
 
-      if (outFormat == VTK_RGBA)
-      {
-        while (--i >= 0)
-        {
-          vtkIdType idx = vtkLinearLookup(*input, p);
-          cptr = table + 4 * idx;
-          output[0] = cptr[0];
-          output[1] = cptr[1];
-          output[2] = cptr[2];
-          output[3] = static_cast<unsigned char>(cptr[3] * alpha + 0.5);
-          input += inIncr;
-          output += 4;
-        }
-      }
-      else if (outFormat == VTK_RGB)
-      {
-        while (--i >= 0)
-        {
-          vtkIdType idx = vtkLinearLookup(*input, p);
-          cptr = table + 4 * idx;
-          memcpy(output, cptr, 3);
-          input += inIncr;
-          output += 3;
-        }
-      }
-      else if (outFormat == VTK_LUMINANCE_ALPHA)
-      {
-        while (--i >= 0)
-        {
-          vtkIdType idx = vtkLinearLookup(*input, p);
-          cptr = table + 4 * idx;
-          output[0] =
-            static_cast<unsigned char>(cptr[0] * 0.30 + cptr[1] * 0.59 + cptr[2] * 0.11 + 0.5);
-          output[1] = static_cast<unsigned char>(cptr[3] * alpha + 0.5);
-          input += inIncr;
-          output += 2;
-        }
-      }
-      else // outFormat == VTK_LUMINANCE
-      {
-        while (--i >= 0)
-        {
-          vtkIdType idx = vtkLinearLookup(*input, p);
-          cptr = table + 4 * idx;
-          *output++ =
-            static_cast<unsigned char>(cptr[0] * 0.30 + cptr[1] * 0.59 + cptr[2] * 0.11 + 0.5);
-          input += inIncr;
-        }
-      }
-    } // no log scale
-  }   // alpha blending
+//------------------------------------------------------------------------------
+// The keys of the index cache: the values themselves, except for floating
+// point values which are keyed by their bits, so that NaN can be a key.
+template <class T>
+inline T vtkLookupTableCacheKey(T v)
+{
+  return v;
+}
+
+inline vtkTypeUInt32 vtkLookupTableCacheKey(float v)
+{
+  vtkTypeUInt32 bits;
+  memcpy(&bits, &v, sizeof(bits));
+  return bits;
+}
+
+inline vtkTypeUInt64 vtkLookupTableCacheKey(double v)
+{
+  vtkTypeUInt64 bits;
+  memcpy(&bits, &v, sizeof(bits));
+  return bits;
+}
+
+inline std::string vtkLookupTableCacheKey(const vtkStdString& v)
+{
+  return v;
 }
 
+//------------------------------------------------------------------------------
+// Remembers the annotated value index of each distinct input value, since
+// finding it requires a search through the annotated values.  Categorical
+// data has few distinct values, so the size of the cache is limited.
+template <class T>
+class vtkLookupTableIndexCache
+{
+public:
+  vtkIdType GetIndex(vtkLookupTable* self, const T& value)
+  {
+    KeyType key = vtkLookupTableCacheKey(value);
+    auto it = this->Indices.find(key);
+    if (it != this->Indices.end())
+    {
+      return it->second;
+    }
+    vtkIdType index = self->GetAnnotatedValueIndexInternal(vtkVariant(value));
+    if (this->Indices.size() < 65536)
+    {
+      this->Indices.emplace(std::move(key), index);
+    }
+    return index;
+  }
+
+private:
+  using KeyType = typename std::decay<decltype(vtkLookupTableCacheKey(std::declval<T>()))>::type;
+  std::unordered_map<KeyType, vtkIdType> Indices;
+};
+
 //------------------------------------------------------------------------------
 template <class T>
 void vtkLookupTableIndexedMapData(vtkLookupTable* self, const T* input, unsigned char* output,
@@ -1066,7 +978,7 @@ void vtkLookupTableIndexedMapData(vtkLookupTable* self, const T* input, unsigned
   unsigned char nanColor[4];
   vtkLookupTable::GetColorAsUnsignedChars(self->GetNanColor(), nanColor);
 
-  vtkVariant vin;
+  vtkLookupTableIndexCache<T> cache;
   double alpha = self->GetAlpha();
   if (alpha >= 1.0) // no blending required
   {
@@ -1074,8 +986,7 @@ void vtkLookupTableIndexedMapData(vtkLookupTable* self, const T* input, unsigned
     {
       while (--i >= 0)
       {
-        vin = *input;
-        vtkIdType idx = self->GetAnnotatedValueIndexInternal(vin);
+        vtkIdType idx = cache.GetIndex(self, *input);
         cptr = idx < 0 ? nanColor : self->GetPointer(idx);
 
         memcpy(output, cptr, 4);
@@ -1087,8 +998,7 @@ void vtkLookupTableIndexedMapData(vtkLookupTable* self, const T* input, unsigned
     {
       while (--i >= 0)
       {
-        vin = *input;
-        vtkIdType idx = self->GetAnnotatedValueIndexInternal(vin);
+        vtkIdType idx = cache.GetIndex(self, *input);
         cptr = idx < 0 ? nanColor : self->GetPointer(idx);
 
         memcpy(output, cptr, 3);
@@ -1100,8 +1010,7 @@ void vtkLookupTableIndexedMapData(vtkLookupTable* self, const T* input, unsigned
     {
       while (--i >= 0)
       {
-        vin = *input;
-        vtkIdType idx = self->GetAnnotatedValueIndexInternal(vin);
+        vtkIdType idx = cache.GetIndex(self, *input);
         cptr = idx < 0 ? nanColor : self->GetPointer(idx);
         output[0] =
           static_cast<unsigned char>(cptr[0] * 0.30 + cptr[1] * 0.59 + cptr[2] * 0.11 + 0.5);
@@ -1114,8 +1023,7 @@ void vtkLookupTableIndexedMapData(vtkLookupTable* self, const T* input, unsigned
     {
       while (--i >= 0)
       {
-        vin = *input;
-        vtkIdType idx = self->GetAnnotatedValueIndexInternal(vin);
+        vtkIdType idx = cache.GetIndex(self, *input);
         cptr = idx < 0 ? nanColor : self->GetPointer(idx);
         *output++ =
           static_cast<unsigned char>(cptr[0] * 0.30 + cptr[1] * 0.59 + cptr[2] * 0.11 + 0.5);
@@ -1130,8 +1038,7 @@ void vtkLookupTableIndexedMapData(vtkLookupTable* self, const T* input, unsigned
     {
       while (--i >= 0)
       {
-        vin = *input;
-        vtkIdType idx = self->GetAnnotatedValueIndexInternal(vin);
+        vtkIdType idx = cache.GetIndex(self, *input);
         cptr = idx < 0 ? nanColor : self->GetPointer(idx);
         memcpy(output, cptr, 3);
         output[3] = static_cast<unsigned char>(cptr[3] * alpha + 0.5);
@@ -1143,8 +1050,7 @@ void vtkLookupTableIndexedMapData(vtkLookupTable* self, const T* input, unsigned
     {
       while (--i >= 0)
       {
-        vin = *input;
-        vtkIdType idx = self->GetAnnotatedValueIndexInternal(vin);
+        vtkIdType idx = cache.GetIndex(self, *input);
         cptr = idx < 0 ? nanColor : self->GetPointer(idx);
         memcpy(output, cptr, 3);
         input += inIncr;
@@ -1155,8 +1061,7 @@ void vtkLookupTableIndexedMapData(vtkLookupTable* self, const T* input, unsigned
     {
       while (--i >= 0)
       {
-        vin = *input;
-        vtkIdType idx = self->GetAnnotatedValueIndexInternal(vin);
+        vtkIdType idx = cache.GetIndex(self, *input);
         cptr = idx < 0 ? nanColor : self->GetPointer(idx);
         output[0] =
           static_cast<unsigned char>(cptr[0] * 0.30 + cptr[1] * 0.59 + cptr[2] * 0.11 + 0.5);
@@ -1169,8 +1074,7 @@ void vtkLookupTableIndexedMapData(vtkLookupTable* self, const T* input, unsigned
     {
       while (--i >= 0)
       {
-        vin = *input;
-        vtkIdType idx = self->GetAnnotatedValueIndexInternal(vin);
+        vtkIdType idx = cache.GetIndex(self, *input);
         cptr = idx < 0 ? nanColor : self->GetPointer(idx);
         *output++ =
           static_cast<unsigned char>(cptr[0] * 0.30 + cptr[1] * 0.59 + cptr[2] * 0.11 + 0.5);
@@ -1180,6 +1084,144 @@ void vtkLookupTableIndexedMapData(vtkLookupTable* self, const T* input, unsigned
   } // alpha blending
 }
 
+//------------------------------------------------------------------------------
+// Values are mapped in parallel, in chunks of this size, when there are at
+// least twice as many and when the mapping is not already called from
+// within a parallel section (e.g. by a threaded image filter).
+const int VTK_LOOKUP_PARALLEL_GRAIN = 32768;
+
+template <class TFunctor>
+void vtkLookupTableMapChunks(int length, TFunctor& map)
+{
+  if (length >= 2 * VTK_LOOKUP_PARALLEL_GRAIN && !vtkSMPTools::IsParallelScope())
+  {
+    vtkSMPTools::For(0, length, VTK_LOOKUP_PARALLEL_GRAIN, map);
+  }
+  else
+  {
+    map(0, length);
+  }
+}
+
+//------------------------------------------------------------------------------
+// The number of values of the 8 and 16 bit integer types, whose colors can
+// be computed once for all the values and then copied.
+template <class T>
+struct vtkLookupTableNumberOfIntegers
+{
+  static const int Value = 0;
+};
+
+template <>
+struct vtkLookupTableNumberOfIntegers<char>
+{
+  static const int Value = 256;
+};
+
+template <>
+struct vtkLookupTableNumberOfIntegers<signed char>
+{
+  static const int Value = 256;
+};
+
+template <>
+struct vtkLookupTableNumberOfIntegers<unsigned char>
+{
+  static const int Value = 256;
+};
+
+template <>
+struct vtkLookupTableNumberOfIntegers<short>
+{
+  static const int Value = 65536;
+};
+
+template <>
+struct vtkLookupTableNumberOfIntegers<unsigned short>
+{
+  static const int Value = 65536;
+};
+
+//------------------------------------------------------------------------------
+// Copy the precomputed colors of 8 or 16 bit integers to the output.
+template <int N, class T>
+void vtkLookupTableCopyIntegerColors(
+  const unsigned char* colors, const T* input, int length, int inIncr, unsigned char* output)
+{
+  const int offset = -static_cast<int>(std::numeric_limits<T>::min());
+  for (int i = 0; i < length; ++i)
+  {
+    memcpy(output, colors + N * (static_cast<int>(*input) + offset), N);
+    input += inIncr;
+    output += N;
+  }
+}
+
+//------------------------------------------------------------------------------
+template <class T>
+void vtkLookupTableMapScalars(vtkLookupTable* self, T* input, unsigned char* output, int length,
+  int inIncr, int outFormat)
+{
+  // For 8 and 16 bit integers, if there are more values than possible
+  // values, compute the colors of all the possible values first.
+  const int numberOfIntegers = vtkLookupTableNumberOfIntegers<T>::Value;
+  std::vector<unsigned char> colors;
+  if (numberOfIntegers > 0 && length >= numberOfIntegers)
+  {
+    std::vector<T> values(numberOfIntegers);
+    for (int i = 0; i < numberOfIntegers; ++i)
+    {
+      values[i] = static_cast<T>(std::numeric_limits<T>::min() + i);
+    }
+    colors.resize(static_cast<size_t>(numberOfIntegers) * outFormat);
+    TableParameters p;
+    p.NumColors = self->GetNumberOfColors();
+    vtkLookupTableMapData(self, values.data(), colors.data(), numberOfIntegers, 1, outFormat, p);
+  }
+
+  auto map = [&](vtkIdType begin, vtkIdType end) {
+    T* in = input + begin * inIncr;
+    unsigned char* out = output + begin * outFormat;
+    int n = static_cast<int>(end - begin);
+    if (colors.empty())
+    {
+      TableParameters p;
+      p.NumColors = self->GetNumberOfColors();
+      vtkLookupTableMapData(self, in, out, n, inIncr, outFormat, p);
+    }
+    else if (outFormat == VTK_RGBA)
+    {
+      vtkLookupTableCopyIntegerColors<4>(colors.data(), in, n, inIncr, out);
+    }
+    else if (outFormat == VTK_RGB)
+    {
+      vtkLookupTableCopyIntegerColors<3>(colors.data(), in, n, inIncr, out);
+    }
+    else if (outFormat == VTK_LUMINANCE_ALPHA)
+    {
+      vtkLookupTableCopyIntegerColors<2>(colors.data(), in, n, inIncr, out);
+    }
+    else // outFormat == VTK_LUMINANCE
+    {
+      vtkLookupTableCopyIntegerColors<1>(colors.data(), in, n, inIncr, out);
+    }
+  };
+  vtkLookupTableMapChunks(length, map);
+}
+
+//------------------------------------------------------------------------------
+template <class T>
+void vtkLookupTableIndexedMapScalars(vtkLookupTable* self, const T* input, unsigned char* output,
+  int length, int inIncr, int outFormat)
+{
+  // each chunk has its own cache of the indices
+  auto map = [&](vtkIdType begin, vtkIdType end) {
+    vtkLookupTableIndexedMapData(self, input + begin * inIncr, output + begin * outFormat,
+      static_cast<int>(end - begin), inIncr, outFormat);
+  };
+  vtkLookupTableMapChunks(length, map);
+}
+
 } // end anonymous namespace
 
 //------------------------------------------------------------------------------
@@ -1201,18 +1243,18 @@ void vtkLookupTable::MapScalarsThroughTable2(void* input, unsigned char* output,
         {
           newInput->SetValue(i, bitArray->GetValue(id));
         }
-        vtkLookupTableIndexedMapData(
-          this, newInput->GetPointer(0), output, numberOfValues, inputIncrement, outputFormat);
+        vtkLookupTableIndexedMapScalars(
+          this, newInput->GetPointer(0), output, numberOfValues, 1, outputFormat);
         newInput->Delete();
         bitArray->Delete();
       }
       break;
 
-        vtkTemplateMacro(vtkLookupTableIndexedMapData(
+        vtkTemplateMacro(vtkLookupTableIndexedMapScalars(
           this, static_cast<VTK_TT*>(input), output, numberOfValues, inputIncrement, outputFormat));
 
       case VTK_STRING:
-        vtkLookupTableIndexedMapData(this, static_cast<vtkStdString*>(input), output,
+        vtkLookupTableIndexedMapScalars(this, static_cast<vtkStdString*>(input), output,
           numberOfValues, inputIncrement, outputFormat);
         break;
 
@@ -1223,9 +1265,6 @@ void vtkLookupTable::MapScalarsThroughTable2(void* input, unsigned char* output,
   }
   else
   {
-    TableParameters p;
-    p.NumColors = this->GetNumberOfColors();
-
     switch (inputDataType)
     {
       case VTK_BIT:
@@ -1239,15 +1278,15 @@ void vtkLookupTable::MapScalarsThroughTable2(void* input, unsigned char* output,
         {
           newInput->SetValue(i, bitArray->GetValue(id));
         }
-        vtkLookupTableMapData(
-          this, newInput->GetPointer(0), output, numberOfValues, inputIncrement, outputFormat, p);
+        vtkLookupTableMapScalars(
+          this, newInput->GetPointer(0), output, numberOfValues, 1, outputFormat);
         newInput->Delete();
         bitArray->Delete();
       }
       break;
 
-        vtkTemplateMacro(vtkLookupTableMapData(this, static_cast<VTK_TT*>(input), output,
-          numberOfValues, inputIncrement, outputFormat, p));
+        vtkTemplateMacro(vtkLookupTableMapScalars(this, static_cast<VTK_TT*>(input), output,
+          numberOfValues, inputIncrement, outputFormat));
       default:
         vtkErrorMacro(<< "MapScalarsThroughTable2: Unknown input ScalarType");
         return;
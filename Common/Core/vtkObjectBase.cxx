@@ -14,6 +14,7 @@
 =========================================================================*/
 
 #include "vtkObjectBase.h"
+#include "vtkAllocationTracker.h"
 #include "vtkDebug.h"
 #include "vtkDebugLeaks.h"
 #include "vtkGarbageCollector.h"
@@ -146,6 +147,7 @@ vtkObjectBase::vtkObjectBase()
 #else
   this->IsInMemkind = false;
 #endif
+  vtkAllocationTracker::ObjectCreated();
 }
 
 //------------------------------------------------------------------------------
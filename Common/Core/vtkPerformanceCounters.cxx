@@ -0,0 +1,515 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkPerformanceCounters.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkPerformanceCounters.h"
+
+#include "SMP/Common/vtkSMPToolsInstrumentation.h"
+#include "vtkObjectFactory.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <vector>
+
+#if defined(VTK_HAS_PERF_EVENT)
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+vtkStandardNewMacro(vtkPerformanceCounters);
+
+namespace
+{
+// Bytes transferred from memory per cache miss.
+const double CacheLineSize = 64.0;
+
+// As SetEnabled(), the counters are only enabled if they are available.
+bool InitializeFromEnvironment()
+{
+  bool enabled = std::getenv("VTK_PERFORMANCE_COUNTERS") != nullptr &&
+    vtkPerformanceCounters::IsAvailable();
+  vtk::detail::smp::vtkSMPToolsInstrumentation::SetFeatureEnabled(
+    vtk::detail::smp::vtkSMPToolsInstrumentation::PERFORMANCE_COUNTERS, enabled);
+  return enabled;
+}
+
+std::atomic<bool> Enabled(InitializeFromEnvironment());
+
+struct Totals
+{
+  vtkIdType Calls = 0;
+  double Time = 0.0;
+  double Values[vtkPerformanceCounters::NUMBER_OF_COUNTERS] = {};
+  bool Has[vtkPerformanceCounters::NUMBER_OF_COUNTERS] = {};
+
+  void Add(const Totals& other)
+  {
+    this->Calls += other.Calls;
+    this->Time += other.Time;
+    for (int i = 0; i < vtkPerformanceCounters::NUMBER_OF_COUNTERS; ++i)
+    {
+      this->Values[i] += other.Values[i];
+      this->Has[i] = this->Has[i] || other.Has[i];
+    }
+  }
+
+  double Get(int counter) const { return this->Values[counter]; }
+
+  double Ratio(int numerator, int denominator) const
+  {
+    return this->Has[numerator] && this->Has[denominator] && this->Values[denominator] > 0
+      ? this->Values[numerator] / this->Values[denominator]
+      : -1.0;
+  }
+};
+
+// State shared by all threads, never destroyed so that threads exiting
+// after the end of main() can still use it.
+struct Global
+{
+  std::mutex Mutex;
+  // Counts per region and per thread number.
+  std::map<std::string, std::map<int, Totals>> Regions;
+  // Thread numbers in use.
+  std::vector<bool> Numbers;
+
+  static Global& Get()
+  {
+    static Global* global = new Global;
+    return *global;
+  }
+};
+
+// The counters of a thread, opened on first use and closed when the thread
+// exits.
+class ThreadCounters
+{
+public:
+  int Number;
+  int Leader = -1;
+  // Position of each counter in the group read, or -1 if not available.
+  int Positions[vtkPerformanceCounters::NUMBER_OF_COUNTERS];
+  int NumberOfOpened = 0;
+  std::vector<int> Descriptors;
+  // Regions being counted, innermost last.
+  std::vector<const char*> Regions;
+
+  ThreadCounters()
+  {
+    Global& global = Global::Get();
+    {
+      std::lock_guard<std::mutex> lock(global.Mutex);
+      auto it = std::find(global.Numbers.begin(), global.Numbers.end(), false);
+      this->Number = static_cast<int>(it - global.Numbers.begin());
+      if (it == global.Numbers.end())
+      {
+        global.Numbers.push_back(true);
+      }
+      else
+      {
+        *it = true;
+      }
+    }
+    std::fill(this->Positions, this->Positions + vtkPerformanceCounters::NUMBER_OF_COUNTERS, -1);
+    this->Open();
+  }
+
+  ~ThreadCounters()
+  {
+#if defined(VTK_HAS_PERF_EVENT)
+    for (int descriptor : this->Descriptors)
+    {
+      close(descriptor);
+    }
+#endif
+    Global& global = Global::Get();
+    std::lock_guard<std::mutex> lock(global.Mutex);
+    global.Numbers[this->Number] = false;
+  }
+
+  bool IsOpened() const { return this->Leader >= 0; }
+
+  void Open()
+  {
+#if defined(VTK_HAS_PERF_EVENT)
+    static const std::uint64_t configs[vtkPerformanceCounters::NUMBER_OF_COUNTERS] = {
+      PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_REFERENCES,
+      PERF_COUNT_HW_CACHE_MISSES
+    };
+    for (int i = 0; i < vtkPerformanceCounters::NUMBER_OF_COUNTERS; ++i)
+    {
+      perf_event_attr attr = {};
+      attr.type = PERF_TYPE_HARDWARE;
+      attr.size = sizeof(attr);
+      attr.config = configs[i];
+      attr.read_format =
+        PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+      // Only count the user space of this thread, which unprivileged
+      // processes are allowed to.
+      attr.exclude_kernel = 1;
+      attr.exclude_hv = 1;
+      int descriptor = static_cast<int>(
+        syscall(SYS_perf_event_open, &attr, 0, -1, this->Leader, PERF_FLAG_FD_CLOEXEC));
+      if (descriptor < 0)
+      {
+        if (i == vtkPerformanceCounters::CYCLES)
+        {
+          // Without cycles there is no group to read.
+          return;
+        }
+        continue;
+      }
+      if (this->Leader < 0)
+      {
+        this->Leader = descriptor;
+      }
+      this->Descriptors.push_back(descriptor);
+      this->Positions[i] = this->NumberOfOpened++;
+    }
+#endif
+  }
+
+  bool Read(vtkPerformanceCounters::Sample& sample)
+  {
+    std::fill(sample.Values, sample.Values + vtkPerformanceCounters::NUMBER_OF_COUNTERS, -1);
+#if defined(VTK_HAS_PERF_EVENT)
+    if (!this->IsOpened())
+    {
+      return false;
+    }
+    // Number of counters, time enabled, time running, then the values.
+    std::uint64_t buffer[3 + vtkPerformanceCounters::NUMBER_OF_COUNTERS];
+    ssize_t size = read(this->Leader, buffer, sizeof(buffer));
+    if (size < static_cast<ssize_t>(3 * sizeof(std::uint64_t)) ||
+      buffer[0] != static_cast<std::uint64_t>(this->NumberOfOpened))
+    {
+      return false;
+    }
+    // Scale the values if the counters had to share the hardware.
+    double scale =
+      buffer[2] > 0 && buffer[2] < buffer[1] ? static_cast<double>(buffer[1]) / buffer[2] : 1.0;
+    for (int i = 0; i < vtkPerformanceCounters::NUMBER_OF_COUNTERS; ++i)
+    {
+      if (this->Positions[i] >= 0)
+      {
+        sample.Values[i] = static_cast<long long>(buffer[3 + this->Positions[i]] * scale);
+      }
+    }
+    return true;
+#else
+    return false;
+#endif
+  }
+};
+
+ThreadCounters& GetThreadCounters()
+{
+  static thread_local ThreadCounters counters;
+  return counters;
+}
+
+double Now()
+{
+  return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch())
+    .count();
+}
+
+Totals Difference(const vtkPerformanceCounters::Sample& start,
+  const vtkPerformanceCounters::Sample& end)
+{
+  Totals totals;
+  totals.Calls = 1;
+  totals.Time = end.Time - start.Time;
+  for (int i = 0; i < vtkPerformanceCounters::NUMBER_OF_COUNTERS; ++i)
+  {
+    if (start.Values[i] >= 0 && end.Values[i] >= 0)
+    {
+      totals.Values[i] = static_cast<double>(end.Values[i] - start.Values[i]);
+      totals.Has[i] = true;
+    }
+  }
+  return totals;
+}
+
+void PrintJSON(std::ostream& os, const Totals& totals)
+{
+  os << "\"calls\": " << totals.Calls << ", \"wall_time\": " << totals.Time;
+  for (int i = 0; i < vtkPerformanceCounters::NUMBER_OF_COUNTERS; ++i)
+  {
+    if (totals.Has[i])
+    {
+      os << ", \"" << vtkPerformanceCounters::GetCounterName(i) << "\": " << totals.Values[i];
+    }
+  }
+  double ipc = totals.Ratio(vtkPerformanceCounters::INSTRUCTIONS, vtkPerformanceCounters::CYCLES);
+  if (ipc >= 0)
+  {
+    os << ", \"ipc\": " << ipc;
+  }
+  double missRate =
+    totals.Ratio(vtkPerformanceCounters::CACHE_MISSES, vtkPerformanceCounters::CACHE_REFERENCES);
+  if (missRate >= 0)
+  {
+    os << ", \"cache_miss_rate\": " << missRate;
+  }
+  if (totals.Has[vtkPerformanceCounters::CACHE_MISSES])
+  {
+    double bytes = totals.Get(vtkPerformanceCounters::CACHE_MISSES) * CacheLineSize;
+    os << ", \"memory_bytes\": " << bytes;
+    if (totals.Time > 0)
+    {
+      os << ", \"bandwidth\": " << bytes / totals.Time;
+    }
+  }
+}
+
+std::string FormatTotals(const Totals& totals)
+{
+  char buffer[256];
+  std::string text;
+  if (totals.Has[vtkPerformanceCounters::CYCLES])
+  {
+    std::snprintf(
+      buffer, sizeof(buffer), "%.3g cycles", totals.Get(vtkPerformanceCounters::CYCLES));
+    text += buffer;
+  }
+  if (totals.Has[vtkPerformanceCounters::INSTRUCTIONS])
+  {
+    std::snprintf(buffer, sizeof(buffer), ", %.3g instructions (%.2f IPC)",
+      totals.Get(vtkPerformanceCounters::INSTRUCTIONS),
+      totals.Ratio(vtkPerformanceCounters::INSTRUCTIONS, vtkPerformanceCounters::CYCLES));
+    text += buffer;
+  }
+  if (totals.Has[vtkPerformanceCounters::CACHE_MISSES])
+  {
+    double bytes = totals.Get(vtkPerformanceCounters::CACHE_MISSES) * CacheLineSize;
+    std::snprintf(buffer, sizeof(buffer), ", %.3g cache misses",
+      totals.Get(vtkPerformanceCounters::CACHE_MISSES));
+    text += buffer;
+    double missRate =
+      totals.Ratio(vtkPerformanceCounters::CACHE_MISSES, vtkPerformanceCounters::CACHE_REFERENCES);
+    if (missRate >= 0)
+    {
+      std::snprintf(buffer, sizeof(buffer), " (%.1f%% of references)", 100.0 * missRate);
+      text += buffer;
+    }
+    if (totals.Time > 0)
+    {
+      std::snprintf(buffer, sizeof(buffer), ", ~%.3g MB/s", bytes / totals.Time * 1e-6);
+      text += buffer;
+    }
+  }
+  return text;
+}
+}
+
+//------------------------------------------------------------------------------
+const char* vtkPerformanceCounters::GetCounterName(int counter)
+{
+  static const char* names[NUMBER_OF_COUNTERS] = { "cycles", "instructions", "cache_references",
+    "cache_misses" };
+  return counter >= 0 && counter < NUMBER_OF_COUNTERS ? names[counter] : "";
+}
+
+//------------------------------------------------------------------------------
+bool vtkPerformanceCounters::IsAvailable()
+{
+  return GetThreadCounters().IsOpened();
+}
+
+//------------------------------------------------------------------------------
+void vtkPerformanceCounters::SetEnabled(bool enabled)
+{
+  if (enabled && !vtkPerformanceCounters::IsAvailable())
+  {
+    vtkLogF(TRACE, "Hardware performance counters are not available.");
+    enabled = false;
+  }
+  Enabled = enabled;
+  vtk::detail::smp::vtkSMPToolsInstrumentation::SetFeatureEnabled(
+    vtk::detail::smp::vtkSMPToolsInstrumentation::PERFORMANCE_COUNTERS, enabled);
+}
+
+//------------------------------------------------------------------------------
+bool vtkPerformanceCounters::GetEnabled()
+{
+  return Enabled.load(std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+bool vtkPerformanceCounters::Read(Sample& sample)
+{
+  sample.Time = Now();
+  return GetThreadCounters().Read(sample);
+}
+
+//------------------------------------------------------------------------------
+void vtkPerformanceCounters::Accumulate(
+  const std::string& region, const Sample& start, const Sample& end)
+{
+  int number = GetThreadCounters().Number;
+  Totals totals = Difference(start, end);
+  Global& global = Global::Get();
+  std::lock_guard<std::mutex> lock(global.Mutex);
+  global.Regions[region][number].Add(totals);
+}
+
+//------------------------------------------------------------------------------
+std::string vtkPerformanceCounters::Format(const Sample& start, const Sample& end)
+{
+  return FormatTotals(Difference(start, end));
+}
+
+//------------------------------------------------------------------------------
+std::string vtkPerformanceCounters::GetCurrentRegion()
+{
+  if (!vtkPerformanceCounters::GetEnabled())
+  {
+    return std::string();
+  }
+  const std::vector<const char*>& regions = GetThreadCounters().Regions;
+  return regions.empty() ? std::string() : std::string(regions.back());
+}
+
+//------------------------------------------------------------------------------
+std::string vtkPerformanceCounters::GetSummary()
+{
+  std::ostringstream os;
+  os << "{ \"available\": " << (vtkPerformanceCounters::IsAvailable() ? "true" : "false")
+     << ", \"regions\": [";
+  Global& global = Global::Get();
+  std::lock_guard<std::mutex> lock(global.Mutex);
+  const char* regionSeparator = "\n";
+  for (const auto& region : global.Regions)
+  {
+    Totals totals;
+    for (const auto& thread : region.second)
+    {
+      totals.Add(thread.second);
+    }
+    std::string name;
+    for (char c : region.first)
+    {
+      if (c == '"' || c == '\\')
+      {
+        name += '\\';
+      }
+      name += static_cast<unsigned char>(c) < 0x20 ? ' ' : c;
+    }
+    os << regionSeparator << "  { \"name\": \"" << name << "\", ";
+    PrintJSON(os, totals);
+    os << ", \"threads\": [";
+    const char* threadSeparator = "\n";
+    for (const auto& thread : region.second)
+    {
+      os << threadSeparator << "    { \"thread\": " << thread.first << ", ";
+      PrintJSON(os, thread.second);
+      os << " }";
+      threadSeparator = ",\n";
+    }
+    os << " ] }";
+    regionSeparator = ",\n";
+  }
+  os << " ] }\n";
+  return os.str();
+}
+
+//------------------------------------------------------------------------------
+bool vtkPerformanceCounters::WriteSummary(const char* fileName)
+{
+  std::ofstream file(fileName);
+  if (!file)
+  {
+    vtkLogF(ERROR, "Cannot open '%s' for writing.", fileName);
+    return false;
+  }
+  file << vtkPerformanceCounters::GetSummary();
+  return static_cast<bool>(file);
+}
+
+//------------------------------------------------------------------------------
+void vtkPerformanceCounters::LogSummary(vtkLogger::Verbosity verbosity)
+{
+  Global& global = Global::Get();
+  std::lock_guard<std::mutex> lock(global.Mutex);
+  for (const auto& region : global.Regions)
+  {
+    Totals totals;
+    for (const auto& thread : region.second)
+    {
+      totals.Add(thread.second);
+    }
+    vtkVLogF(verbosity, "%s: %lld calls, %g s, %s", region.first.c_str(),
+      static_cast<long long>(totals.Calls), totals.Time, FormatTotals(totals).c_str());
+    if (region.second.size() > 1)
+    {
+      for (const auto& thread : region.second)
+      {
+        vtkVLogF(verbosity, "  thread %d: %lld calls, %g s, %s", thread.first,
+          static_cast<long long>(thread.second.Calls), thread.second.Time,
+          FormatTotals(thread.second).c_str());
+      }
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkPerformanceCounters::ClearSummary()
+{
+  Global& global = Global::Get();
+  std::lock_guard<std::mutex> lock(global.Mutex);
+  global.Regions.clear();
+}
+
+//------------------------------------------------------------------------------
+bool vtkPerformanceCounters::Scope::Begin()
+{
+  if (!vtkPerformanceCounters::GetEnabled() || !vtkPerformanceCounters::Read(this->Start))
+  {
+    return false;
+  }
+  GetThreadCounters().Regions.push_back(this->Region);
+  return true;
+}
+
+//------------------------------------------------------------------------------
+std::string vtkPerformanceCounters::Scope::Stop()
+{
+  if (!this->Active)
+  {
+    return std::string();
+  }
+  this->Active = false;
+  Sample end;
+  vtkPerformanceCounters::Read(end);
+  GetThreadCounters().Regions.pop_back();
+  vtkPerformanceCounters::Accumulate(this->Region, this->Start, end);
+  return vtkPerformanceCounters::Format(this->Start, end);
+}
+
+//------------------------------------------------------------------------------
+void vtkPerformanceCounters::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Available: " << vtkPerformanceCounters::IsAvailable() << "\n";
+  os << indent << "Enabled: " << vtkPerformanceCounters::GetEnabled() << "\n";
+}
@@ -0,0 +1,217 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkPerformanceCounters.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkPerformanceCounters
+ * @brief   hardware performance counters for log scopes and SMP regions
+ *
+ * vtkPerformanceCounters reads the hardware performance counters of the
+ * processor, through `perf_event_open` on Linux, for regions of code: the
+ * cycles, the instructions retired and the cache references and misses of
+ * the thread executing the region. From these it derives the instructions
+ * per cycle, the cache miss rate and the memory bandwidth, estimated from
+ * the cache misses assuming 64 byte cache lines.
+ *
+ * Once enabled, with SetEnabled() or by setting the
+ * `VTK_PERFORMANCE_COUNTERS` environment variable, counters are read for:
+ *
+ * * the vtkLogger scopes that are logged (vtkLogScopeF(), vtkLogStartScope()
+ *   and the like): the counts of the thread are logged within the scope just
+ *   before it ends.
+ * * the parallel regions of vtkSMPTools::For(), on every thread executing
+ *   part of the loop. A region is named after the innermost region of the
+ *   thread calling vtkSMPTools::For(), e.g. "vtkSMPTools::For in <scope>".
+ * * the regions delimited by a vtkPerformanceCounters::Scope.
+ *
+ * The counts are aggregated per region and per thread, threads being
+ * numbered in the order they first read counters, the numbers of threads
+ * that exit being reused. GetSummary() returns the aggregates as JSON and
+ * LogSummary() logs them.
+ *
+ * When the counters are not available, because the platform is not Linux or
+ * the system forbids their use (see `/proc/sys/kernel/perf_event_paranoid`),
+ * SetEnabled() has no effect and everything is a no-op. Counters that the
+ * processor does not provide are left out of the results.
+ *
+ * @code
+ * vtkPerformanceCounters::SetEnabled(true);
+ * filter->Update(); // with vtkLogger verbosity high enough for its scopes
+ * vtkPerformanceCounters::WriteSummary("counters.json");
+ * @endcode
+ *
+ * @sa
+ * vtkLogger vtkSMPTools
+ */
+
+#ifndef vtkPerformanceCounters_h
+#define vtkPerformanceCounters_h
+
+#include "vtkCommonCoreModule.h" // For export macro
+#include "vtkLogger.h"           // For vtkLogger::Verbosity
+#include "vtkObject.h"
+
+#include <string> // For std::string
+
+class VTKCOMMONCORE_EXPORT vtkPerformanceCounters : public vtkObject
+{
+public:
+  static vtkPerformanceCounters* New();
+  vtkTypeMacro(vtkPerformanceCounters, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  /**
+   * The counters read.
+   */
+  enum Counter
+  {
+    CYCLES = 0,
+    INSTRUCTIONS,
+    CACHE_REFERENCES,
+    CACHE_MISSES,
+    NUMBER_OF_COUNTERS
+  };
+
+  /**
+   * Name of a counter, as used in the summary.
+   */
+  static const char* GetCounterName(int counter);
+
+  /**
+   * Whether the counters can be read on this system.
+   */
+  static bool IsAvailable();
+
+  ///@{
+  /**
+   * Enable or disable reading the counters. Enabling has no effect when the
+   * counters are not available. Disabled by default, unless the
+   * `VTK_PERFORMANCE_COUNTERS` environment variable is set.
+   */
+  static void SetEnabled(bool enabled);
+  static bool GetEnabled();
+  ///@}
+
+  /**
+   * The aggregated counts of every region and thread, as JSON:
+   *
+   * @code{json}
+   * { "available": true, "regions": [ { "name": "...", "calls": 12,
+   *   "wall_time": 0.5, "cycles": 1.2e9, ..., "ipc": 1.8,
+   *   "cache_miss_rate": 0.1, "memory_bytes": 2.4e8, "bandwidth": 4.8e8,
+   *   "threads": [ { "thread": 0, "calls": 3, ... } ] } ] }
+   * @endcode
+   *
+   * Times are in seconds and bandwidths in bytes per second. The times of
+   * the totals of a region are summed over its threads, so the bandwidth of
+   * the totals is the average bandwidth of a thread.
+   */
+  static std::string GetSummary();
+
+  /**
+   * Write the summary to a file. Returns false on error.
+   */
+  static bool WriteSummary(const char* fileName);
+
+  /**
+   * Log the aggregated counts, a line per region and per thread.
+   */
+  static void LogSummary(vtkLogger::Verbosity verbosity = vtkLogger::VERBOSITY_INFO);
+
+  /**
+   * Clear the aggregated counts.
+   */
+  static void ClearSummary();
+
+#if !defined(__WRAP__)
+  /**
+   * Values of the counters of the calling thread at some point, with the
+   * time. Counters that are not available are negative.
+   */
+  struct Sample
+  {
+    double Time;
+    long long Values[NUMBER_OF_COUNTERS];
+  };
+
+  /**
+   * Read the counters of the calling thread. Returns false if none is
+   * available.
+   */
+  static bool Read(Sample& sample);
+
+  /**
+   * Add the counts between two samples of the calling thread to a region.
+   */
+  static void Accumulate(const std::string& region, const Sample& start, const Sample& end);
+
+  /**
+   * Human readable counts between two samples, as logged.
+   */
+  static std::string Format(const Sample& start, const Sample& end);
+
+  /**
+   * The innermost region being counted on the calling thread, or an empty
+   * string.
+   */
+  static std::string GetCurrentRegion();
+
+  /**
+   * Counts a region of code executed by the calling thread, from its
+   * construction to Stop() or its destruction, when the counters are
+   * enabled. The name of the region must outlive the scope. Nothing is
+   * counted for an empty name.
+   */
+  class VTKCOMMONCORE_EXPORT Scope
+  {
+  public:
+    explicit Scope(const char* region)
+      : Region(region)
+      , Active(region && *region && this->Begin())
+    {
+    }
+    ~Scope()
+    {
+      if (this->Active)
+      {
+        this->Stop();
+      }
+    }
+
+    /**
+     * Stop counting and add the counts to the region. Returns the counts as
+     * formatted by Format(), or an empty string if nothing was counted.
+     */
+    std::string Stop();
+
+  private:
+    Scope(const Scope&) = delete;
+    void operator=(const Scope&) = delete;
+    bool Begin();
+
+    const char* Region;
+    Sample Start;
+    bool Active;
+  };
+#endif
+
+protected:
+  vtkPerformanceCounters() = default;
+  ~vtkPerformanceCounters() override = default;
+
+private:
+  vtkPerformanceCounters(const vtkPerformanceCounters&) = delete;
+  void operator=(const vtkPerformanceCounters&) = delete;
+};
+
+#endif
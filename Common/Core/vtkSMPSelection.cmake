@@ -125,12 +125,14 @@ endif()
 
 set(vtk_smp_common_dir SMP/Common)
 list(APPEND vtk_smp_sources
-  "${vtk_smp_common_dir}/vtkSMPToolsAPI.cxx")
+  "${vtk_smp_common_dir}/vtkSMPToolsAPI.cxx"
+  "${vtk_smp_common_dir}/vtkSMPToolsInstrumentation.cxx")
 list(APPEND vtk_smp_nowrap_headers
   "${vtk_smp_common_dir}/vtkSMPThreadLocalAPI.h"
   "${vtk_smp_common_dir}/vtkSMPThreadLocalImplAbstract.h"
   "${vtk_smp_common_dir}/vtkSMPToolsAPI.h"
   "${vtk_smp_common_dir}/vtkSMPToolsImpl.h"
+  "${vtk_smp_common_dir}/vtkSMPToolsInstrumentation.h"
   "${vtk_smp_common_dir}/vtkSMPToolsInternal.h")
 
 list(APPEND vtk_smp_sources
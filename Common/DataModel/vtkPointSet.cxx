@@ -371,5 +371,8 @@ void vtkPointSet::Register(vtkObjectBase* o)
 //------------------------------------------------------------------------------
 void vtkPointSet::UnRegister(vtkObjectBase* o)
 {
-  this->UnRegisterInternal(o, 1);
+  // Only the locators can make a reference loop back to this data set, see
+  // ReportReferences(), so the garbage collector need not check it without
+  // them. This avoids a collection each time a shared data set is released.
+  this->UnRegisterInternal(o, this->PointLocator != nullptr || this->CellLocator != nullptr);
 }
@@ -0,0 +1,148 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestAllocationTracker.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Tracks the allocations of a filter, made by the calling thread and by
+// the threads of vtkSMPTools::For, and checks the counts reported in its
+// output information and in the summary.
+
+#include "vtkAllocationTracker.h"
+#include "vtkDoubleArray.h"
+#include "vtkExecutive.h"
+#include "vtkInformation.h"
+#include "vtkInformationIdTypeKey.h"
+#include "vtkInformationVector.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkFieldData.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataAlgorithm.h"
+#include "vtkSMPTools.h"
+
+#include <string>
+
+namespace
+{
+const vtkIdType TransientValues = 1 << 20;
+const vtkIdType OutputValues = 1 << 16;
+const vtkIdType Chunks = 4;
+
+// Allocates a transient array, arrays within a parallel loop, all freed,
+// and an array kept in the output.
+class AllocatingFilter : public vtkPolyDataAlgorithm
+{
+public:
+  static AllocatingFilter* New();
+  vtkTypeMacro(AllocatingFilter, vtkPolyDataAlgorithm);
+
+protected:
+  AllocatingFilter() { this->SetNumberOfInputPorts(0); }
+
+  int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector* outInfo) override
+  {
+    {
+      vtkNew<vtkDoubleArray> transient;
+      transient->SetNumberOfValues(TransientValues);
+      transient->FillValue(1.0);
+    }
+    vtkSMPTools::For(0, Chunks, 1, [](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        vtkNew<vtkDoubleArray> chunk;
+        chunk->SetNumberOfValues(TransientValues / Chunks);
+      }
+    });
+    vtkNew<vtkDoubleArray> kept;
+    kept->SetName("kept");
+    kept->SetNumberOfValues(OutputValues);
+    vtkPolyData::GetData(outInfo)->GetFieldData()->AddArray(kept);
+    return 1;
+  }
+};
+vtkStandardNewMacro(AllocatingFilter);
+}
+
+int TestAllocationTracker(int, char*[])
+{
+  const vtkTypeInt64 transientBytes = TransientValues * sizeof(double);
+  const vtkTypeInt64 outputBytes = OutputValues * sizeof(double);
+
+  vtkNew<AllocatingFilter> filter;
+  vtkInformation* outInfo = filter->GetOutputInformation(0);
+
+  vtkAllocationTracker::SetEnabled(false);
+  filter->Update();
+  if (outInfo->Has(vtkExecutive::ALLOCATED_BYTES()))
+  {
+    cerr << "Allocations reported while the tracking is disabled\n";
+    return EXIT_FAILURE;
+  }
+
+  vtkAllocationTracker::SetEnabled(true);
+  vtkAllocationTracker::ClearSummary();
+  filter->Modified();
+  filter->Update();
+
+  vtkIdType allocated = outInfo->Get(vtkExecutive::ALLOCATED_BYTES());
+  vtkIdType peak = outInfo->Get(vtkExecutive::PEAK_ALLOCATED_BYTES());
+  vtkIdType allocations = outInfo->Get(vtkExecutive::NUMBER_OF_ALLOCATIONS());
+  cout << "allocated " << allocated << " bytes in " << allocations << " allocations, peak "
+       << peak << " bytes\n";
+  if (allocated < 2 * transientBytes + outputBytes)
+  {
+    cerr << "Expected at least " << 2 * transientBytes + outputBytes << " bytes allocated\n";
+    return EXIT_FAILURE;
+  }
+  if (peak < transientBytes || peak >= allocated)
+  {
+    cerr << "Expected a peak between " << transientBytes << " and " << allocated << " bytes\n";
+    return EXIT_FAILURE;
+  }
+  if (allocations < 2 + Chunks)
+  {
+    cerr << "Expected at least " << 2 + Chunks << " allocations\n";
+    return EXIT_FAILURE;
+  }
+
+  std::string summary = vtkAllocationTracker::GetSummary();
+  cout << summary;
+  vtkAllocationTracker::LogSummary();
+  if (summary.find("\"name\": \"AllocatingFilter") == std::string::npos ||
+    summary.find("\"executions\": 1,") == std::string::npos)
+  {
+    cerr << "Execution missing from the summary\n";
+    return EXIT_FAILURE;
+  }
+
+  // Releasing the output frees the kept array.
+  vtkTypeInt64 current = vtkAllocationTracker::GetCurrentBytes();
+  filter->GetOutput()->Initialize();
+  if (vtkAllocationTracker::GetCurrentBytes() > current - outputBytes)
+  {
+    cerr << "The output array was not reported freed\n";
+    return EXIT_FAILURE;
+  }
+
+  // Executions are not tracked once the tracking is disabled again.
+  vtkAllocationTracker::SetEnabled(false);
+  vtkAllocationTracker::ClearSummary();
+  filter->Modified();
+  filter->Update();
+  if (outInfo->Get(vtkExecutive::ALLOCATED_BYTES()) != allocated ||
+    vtkAllocationTracker::GetSummary().find("AllocatingFilter") != std::string::npos)
+  {
+    cerr << "Execution tracked once the tracking is disabled\n";
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,174 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestCachedCompositeDataPipeline.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Goes back and forth over the time steps of a source through a filter
+// using vtkCachedCompositeDataPipeline and checks that cached outputs are
+// reused, evicted when over the memory limit and dropped on modification.
+
+#include "vtkCachedCompositeDataPipeline.h"
+#include "vtkElevationFilter.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataAlgorithm.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+
+#include <vector>
+
+namespace
+{
+const int NumberOfTimeSteps = 5;
+
+// Produces 1000 * (t + 1) points for time step t.
+class TimeSource : public vtkPolyDataAlgorithm
+{
+public:
+  static TimeSource* New();
+  vtkTypeMacro(TimeSource, vtkPolyDataAlgorithm);
+
+  int Executions = 0;
+
+protected:
+  TimeSource() { this->SetNumberOfInputPorts(0); }
+
+  int RequestInformation(
+    vtkInformation*, vtkInformationVector**, vtkInformationVector* outputVector) override
+  {
+    vtkInformation* outInfo = outputVector->GetInformationObject(0);
+    double steps[NumberOfTimeSteps];
+    for (int i = 0; i < NumberOfTimeSteps; ++i)
+    {
+      steps[i] = i;
+    }
+    double range[2] = { 0, NumberOfTimeSteps - 1.0 };
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::TIME_STEPS(), steps, NumberOfTimeSteps);
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::TIME_RANGE(), range, 2);
+    return 1;
+  }
+
+  int RequestData(
+    vtkInformation*, vtkInformationVector**, vtkInformationVector* outputVector) override
+  {
+    ++this->Executions;
+    vtkInformation* outInfo = outputVector->GetInformationObject(0);
+    double time = outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP());
+    vtkNew<vtkPoints> points;
+    vtkIdType numberOfPoints = 1000 * (static_cast<vtkIdType>(time) + 1);
+    points->SetNumberOfPoints(numberOfPoints);
+    for (vtkIdType i = 0; i < numberOfPoints; ++i)
+    {
+      points->SetPoint(i, i, time, 0);
+    }
+    vtkPolyData* output = vtkPolyData::GetData(outInfo);
+    output->SetPoints(points);
+    output->GetInformation()->Set(vtkDataObject::DATA_TIME_STEP(), time);
+    return 1;
+  }
+};
+vtkStandardNewMacro(TimeSource);
+
+bool Check(bool condition, const char* message)
+{
+  if (!condition)
+  {
+    cerr << message << "\n";
+  }
+  return condition;
+}
+}
+
+int TestCachedCompositeDataPipeline(int, char*[])
+{
+  vtkNew<TimeSource> source;
+  vtkNew<vtkElevationFilter> elevation;
+  vtkNew<vtkCachedCompositeDataPipeline> executive;
+  elevation->SetExecutive(executive);
+  elevation->SetInputConnection(source->GetOutputPort());
+
+  // First pass executes every time step.
+  std::vector<vtkDataObject*> outputs;
+  for (int t = 0; t < NumberOfTimeSteps; ++t)
+  {
+    elevation->UpdateTimeStep(t);
+    outputs.push_back(elevation->GetOutputDataObject(0));
+  }
+  if (!Check(source->Executions == NumberOfTimeSteps, "First pass did not execute every step") ||
+    !Check(executive->GetNumberOfCachedOutputs() == NumberOfTimeSteps, "Outputs not cached") ||
+    !Check(executive->GetCacheMisses() == NumberOfTimeSteps, "Unexpected number of misses"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // Going back reuses the cached outputs themselves.
+  for (int t = NumberOfTimeSteps - 1; t >= 0; --t)
+  {
+    elevation->UpdateTimeStep(t);
+    vtkDataSet* output = elevation->GetOutput();
+    if (!Check(output == outputs[t], "Cached output not handed back") ||
+      !Check(output->GetNumberOfPoints() == 1000 * (t + 1), "Wrong cached output") ||
+      !Check(output->GetPointData()->GetScalars() != nullptr, "Cached output lost its arrays"))
+    {
+      return EXIT_FAILURE;
+    }
+  }
+  if (!Check(source->Executions == NumberOfTimeSteps, "Cached time steps executed again") ||
+    !Check(executive->GetCacheHits() == NumberOfTimeSteps - 1, "Unexpected number of hits"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // Over the memory limit, the least recently used outputs are released.
+  unsigned long largest = outputs.back()->GetActualMemorySize();
+  executive->SetCacheMemoryLimit(largest + outputs[0]->GetActualMemorySize());
+  if (!Check(executive->GetCacheMemorySize() <= executive->GetCacheMemoryLimit(),
+        "Cache above its limit") ||
+    !Check(executive->GetNumberOfCachedOutputs() == 2, "Expected 2 cached outputs"))
+  {
+    return EXIT_FAILURE;
+  }
+  executive->ResetCacheStatistics();
+  elevation->UpdateTimeStep(1);
+  elevation->UpdateTimeStep(NumberOfTimeSteps - 1);
+  if (!Check(executive->GetCacheHits() == 1 && executive->GetCacheMisses() == 1,
+        "Expected only the evicted step to execute"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // Modifications upstream drop the cache.
+  executive->SetCacheMemoryLimit(1024 * 1024);
+  source->Modified();
+  source->Executions = 0;
+  elevation->UpdateTimeStep(0);
+  elevation->UpdateTimeStep(1);
+  elevation->UpdateTimeStep(0);
+  if (!Check(source->Executions == 2, "Expected outdated outputs to be dropped") ||
+    !Check(executive->GetNumberOfCachedOutputs() == 2, "Expected 2 cached outputs"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  executive->ClearCache();
+  if (!Check(executive->GetNumberOfCachedOutputs() == 0 && executive->GetCacheMemorySize() == 0,
+        "Cache not cleared"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
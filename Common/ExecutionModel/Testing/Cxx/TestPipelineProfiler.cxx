@@ -0,0 +1,199 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestPipelineProfiler.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Profiles the updates of a small pipeline and checks the recorded passes,
+// their causes and both exports.
+
+#include "vtkElevationFilter.h"
+#include "vtkNew.h"
+#include "vtkPipelineProfiler.h"
+#include "vtkSphereSource.h"
+#include "vtkStringArray.h"
+#include "vtkTable.h"
+#include "vtkTypeInt64Array.h"
+
+#include <string>
+
+namespace
+{
+// Returns the row of the last REQUEST_DATA event of the algorithm whose
+// identifier starts with `className`, -1 if none.
+vtkIdType FindExecution(vtkTable* table, const std::string& className)
+{
+  auto algorithms = vtkStringArray::SafeDownCast(table->GetColumnByName("Algorithm"));
+  auto passes = vtkStringArray::SafeDownCast(table->GetColumnByName("Pass"));
+  vtkIdType row = -1;
+  for (vtkIdType i = 0; i < table->GetNumberOfRows(); ++i)
+  {
+    if (algorithms->GetValue(i).compare(0, className.size(), className) == 0 &&
+      passes->GetValue(i) == "REQUEST_DATA")
+    {
+      row = i;
+    }
+  }
+  return row;
+}
+
+bool CheckCause(vtkTable* table, const std::string& className, const std::string& cause)
+{
+  vtkIdType row = FindExecution(table, className);
+  if (row < 0)
+  {
+    cerr << className << " did not execute\n";
+    return false;
+  }
+  std::string actual = table->GetValueByName(row, "Cause").ToString();
+  if (actual.compare(0, cause.size(), cause) != 0)
+  {
+    cerr << "Expected " << className << " to execute because of \"" << cause << "\", got \""
+         << actual << "\"\n";
+    return false;
+  }
+  return true;
+}
+}
+
+int TestPipelineProfiler(int, char*[])
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(32);
+  sphere->SetPhiResolution(32);
+  vtkNew<vtkElevationFilter> elevation;
+  elevation->SetInputConnection(sphere->GetOutputPort());
+
+  vtkNew<vtkPipelineProfiler> profiler;
+  if (vtkPipelineProfiler::GetActiveProfiler() != nullptr)
+  {
+    cerr << "A profiler is active by default\n";
+    return EXIT_FAILURE;
+  }
+
+  // Nothing is recorded while the profiler is stopped.
+  elevation->Update();
+  if (profiler->GetNumberOfEvents() != 0)
+  {
+    cerr << "Events recorded while stopped\n";
+    return EXIT_FAILURE;
+  }
+
+  profiler->Start();
+  if (!profiler->IsActive() || vtkPipelineProfiler::GetActiveProfiler() != profiler)
+  {
+    cerr << "Profiler not active after Start()\n";
+    return EXIT_FAILURE;
+  }
+  elevation->Modified();
+  elevation->Update();
+  vtkNew<vtkTable> table;
+  profiler->GetEvents(table);
+  if (!CheckCause(table, "vtkElevationFilter", "first execution"))
+  {
+    return EXIT_FAILURE;
+  }
+  if (FindExecution(table, "vtkSphereSource") >= 0)
+  {
+    cerr << "Up to date source recorded as executed\n";
+    return EXIT_FAILURE;
+  }
+  vtkIdType row = FindExecution(table, "vtkElevationFilter");
+  auto inputSizes = vtkTypeInt64Array::SafeDownCast(table->GetColumnByName("InputSize"));
+  auto outputSizes = vtkTypeInt64Array::SafeDownCast(table->GetColumnByName("OutputSize"));
+  if (inputSizes->GetValue(row) <= 0 || outputSizes->GetValue(row) <= inputSizes->GetValue(row))
+  {
+    cerr << "Unexpected memory sizes " << inputSizes->GetValue(row) << " and "
+         << outputSizes->GetValue(row) << "\n";
+    return EXIT_FAILURE;
+  }
+  if (table->GetValueByName(row, "WallTime").ToDouble() < 0 ||
+    table->GetValueByName(row, "SMPThreads").ToInt() < 1)
+  {
+    cerr << "Unexpected wall time or thread count\n";
+    return EXIT_FAILURE;
+  }
+
+  // Re-executions are attributed to what triggered them.
+  sphere->SetRadius(2);
+  elevation->Update();
+  profiler->GetEvents(table);
+  if (!CheckCause(table, "vtkSphereSource", "first execution") ||
+    !CheckCause(table, "vtkElevationFilter", "input vtkSphereSource"))
+  {
+    return EXIT_FAILURE;
+  }
+  sphere->SetRadius(3);
+  elevation->Update();
+  profiler->GetEvents(table);
+  if (!CheckCause(table, "vtkSphereSource", "modified"))
+  {
+    return EXIT_FAILURE;
+  }
+  elevation->SetLowPoint(0, 0, -2);
+  elevation->Update();
+  profiler->GetEvents(table);
+  if (!CheckCause(table, "vtkElevationFilter", "modified"))
+  {
+    return EXIT_FAILURE;
+  }
+  elevation->UpdatePiece(1, 2, 0);
+  profiler->GetEvents(table);
+  if (!CheckCause(table, "vtkSphereSource", "request"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // Every pass is exported.
+  bool passes[3] = { false, false, false };
+  const char* passNames[3] = { "REQUEST_INFORMATION", "REQUEST_UPDATE_EXTENT", "REQUEST_DATA" };
+  for (vtkIdType i = 0; i < table->GetNumberOfRows(); ++i)
+  {
+    for (int pass = 0; pass < 3; ++pass)
+    {
+      passes[pass] |= table->GetValueByName(i, "Pass").ToString() == passNames[pass];
+    }
+  }
+  std::string trace = profiler->GetChromeTrace();
+  for (int pass = 0; pass < 3; ++pass)
+  {
+    if (!passes[pass] || trace.find(passNames[pass]) == std::string::npos)
+    {
+      cerr << passNames[pass] << " not recorded\n";
+      return EXIT_FAILURE;
+    }
+  }
+  if (trace.compare(0, 15, "{\"traceEvents\":") != 0 ||
+    trace.find("\"ph\":\"X\"") == std::string::npos)
+  {
+    cerr << "Unexpected Chrome trace:\n" << trace;
+    return EXIT_FAILURE;
+  }
+
+  profiler->Stop();
+  vtkIdType numberOfEvents = profiler->GetNumberOfEvents();
+  sphere->Modified();
+  elevation->Update();
+  if (vtkPipelineProfiler::GetActiveProfiler() != nullptr ||
+    profiler->GetNumberOfEvents() != numberOfEvents)
+  {
+    cerr << "Events recorded after Stop()\n";
+    return EXIT_FAILURE;
+  }
+  profiler->Clear();
+  if (profiler->GetNumberOfEvents() != 0)
+  {
+    cerr << "Events left after Clear()\n";
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
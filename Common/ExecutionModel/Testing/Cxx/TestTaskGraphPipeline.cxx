@@ -0,0 +1,376 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestTaskGraphPipeline.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Executes a pipeline with independent branches with vtkTaskGraphPipeline,
+// concurrently and serially, and checks that the output matches the one of
+// vtkCompositeDataPipeline and that algorithms execute only when needed.
+// Also checks that a vtkPolyData read by concurrent algorithms has its cells,
+// links and array ranges built beforehand.
+
+#include "vtkAppendPolyData.h"
+#include "vtkCallbackCommand.h"
+#include "vtkCleanPolyData.h"
+#include "vtkCollection.h"
+#include "vtkCommand.h"
+#include "vtkCompositeDataPipeline.h"
+#include "vtkContourFilter.h"
+#include "vtkDataArray.h"
+#include "vtkElevationFilter.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataAlgorithm.h"
+#include "vtkPolyDataNormals.h"
+#include "vtkSmartPointer.h"
+#include "vtkSphereSource.h"
+#include "vtkTaskGraphPipeline.h"
+#include "vtkThreshold.h"
+#include "vtkTriangleFilter.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <atomic>
+#include <map>
+#include <vector>
+
+namespace
+{
+std::map<vtkObject*, std::atomic<int>> Executions;
+
+void CountExecution(vtkObject* caller, unsigned long, void*, void*)
+{
+  ++Executions.at(caller);
+}
+
+// Two spheres, each feeding three filters, all appended together.
+struct Pipeline
+{
+  std::vector<vtkSmartPointer<vtkAlgorithm>> Algorithms;
+  vtkSmartPointer<vtkAppendPolyData> Append;
+  vtkSmartPointer<vtkSphereSource> Spheres[2];
+
+  explicit Pipeline(vtkExecutive* prototype)
+  {
+    vtkAlgorithm::SetDefaultExecutivePrototype(prototype);
+    this->Append = vtkSmartPointer<vtkAppendPolyData>::New();
+    for (int i = 0; i < 2; ++i)
+    {
+      vtkNew<vtkSphereSource> sphere;
+      sphere->SetCenter(3 * i, 0, 0);
+      sphere->SetThetaResolution(64);
+      sphere->SetPhiResolution(64);
+      this->Spheres[i] = sphere;
+
+      vtkNew<vtkElevationFilter> elevation;
+      elevation->SetInputConnection(sphere->GetOutputPort());
+      vtkNew<vtkPolyDataNormals> normals;
+      normals->SetInputConnection(sphere->GetOutputPort());
+      vtkNew<vtkTriangleFilter> triangles;
+      triangles->SetInputConnection(sphere->GetOutputPort());
+      vtkNew<vtkCleanPolyData> clean;
+      clean->SetInputConnection(triangles->GetOutputPort());
+
+      this->Algorithms.insert(this->Algorithms.end(),
+        { sphere.Get(), elevation.Get(), normals.Get(), triangles.Get(), clean.Get() });
+      this->Append->AddInputConnection(elevation->GetOutputPort());
+      this->Append->AddInputConnection(normals->GetOutputPort());
+      this->Append->AddInputConnection(clean->GetOutputPort());
+    }
+    this->Algorithms.push_back(this->Append);
+    vtkAlgorithm::SetDefaultExecutivePrototype(nullptr);
+
+    vtkNew<vtkCallbackCommand> counter;
+    counter->SetCallback(CountExecution);
+    for (vtkAlgorithm* algorithm : this->Algorithms)
+    {
+      Executions[algorithm] = 0;
+      algorithm->AddObserver(vtkCommand::StartEvent, counter);
+    }
+  }
+
+  int CountExecutions()
+  {
+    int count = 0;
+    for (vtkAlgorithm* algorithm : this->Algorithms)
+    {
+      count += Executions.at(algorithm).exchange(0);
+    }
+    return count;
+  }
+};
+
+// Counts the cells using each point of its input, which builds the cells and
+// links of the input on the first query.
+class PointValence : public vtkPolyDataAlgorithm
+{
+public:
+  static PointValence* New();
+  vtkTypeMacro(PointValence, vtkPolyDataAlgorithm);
+
+protected:
+  int RequestData(vtkInformation*, vtkInformationVector** inputVector,
+    vtkInformationVector* outputVector) override
+  {
+    vtkPolyData* input = vtkPolyData::GetData(inputVector[0]);
+    vtkPolyData* output = vtkPolyData::GetData(outputVector);
+    output->SetPoints(input->GetPoints());
+
+    vtkNew<vtkIdTypeArray> valence;
+    valence->SetName("Valence");
+    valence->SetNumberOfValues(input->GetNumberOfPoints());
+    vtkNew<vtkIdList> cellIds;
+    for (vtkIdType i = 0; i < input->GetNumberOfPoints(); ++i)
+    {
+      input->GetPointCells(i, cellIds);
+      valence->SetValue(i, cellIds->GetNumberOfIds());
+    }
+    output->GetPointData()->AddArray(valence);
+    return 1;
+  }
+};
+vtkStandardNewMacro(PointValence);
+
+bool SamePolyData(vtkPolyData* a, vtkPolyData* b)
+{
+  if (a->GetNumberOfPoints() != b->GetNumberOfPoints() ||
+    a->GetNumberOfCells() != b->GetNumberOfCells() ||
+    a->GetPointData()->GetNumberOfArrays() != b->GetPointData()->GetNumberOfArrays())
+  {
+    return false;
+  }
+  for (vtkIdType i = 0; i < a->GetNumberOfPoints(); ++i)
+  {
+    double x[3], y[3];
+    a->GetPoint(i, x);
+    b->GetPoint(i, y);
+    if (x[0] != y[0] || x[1] != y[1] || x[2] != y[2])
+    {
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int TestTaskGraphPipeline(int, char*[])
+{
+  vtkNew<vtkCompositeDataPipeline> serialPrototype;
+  Pipeline reference(serialPrototype);
+  reference.Append->Update();
+
+  vtkNew<vtkTaskGraphPipeline> prototype;
+  Pipeline pipeline(prototype);
+  auto executive = vtkTaskGraphPipeline::SafeDownCast(pipeline.Append->GetExecutive());
+
+  for (bool serial : { false, true })
+  {
+    vtkTaskGraphPipeline::SetSerialExecution(serial);
+    pipeline.Spheres[0]->Modified();
+    pipeline.Spheres[1]->Modified();
+    pipeline.Append->Update();
+    if (!SamePolyData(reference.Append->GetOutput(), pipeline.Append->GetOutput()))
+    {
+      cerr << "Output differs from vtkCompositeDataPipeline, serial " << serial << "\n";
+      return EXIT_FAILURE;
+    }
+    int executions = pipeline.CountExecutions();
+    if (executions != static_cast<int>(pipeline.Algorithms.size()))
+    {
+      cerr << "Expected every algorithm to execute once, got " << executions
+           << " executions, serial " << serial << "\n";
+      return EXIT_FAILURE;
+    }
+    if (executive->GetLastTaskGraphWidth() != 6)
+    {
+      cerr << "Expected 6 concurrent filters, got " << executive->GetLastTaskGraphWidth() << "\n";
+      return EXIT_FAILURE;
+    }
+  }
+  vtkTaskGraphPipeline::SetSerialExecution(false);
+
+  // Nothing executes again when nothing changed, and only what depends on a
+  // modified algorithm does otherwise.
+  pipeline.Append->Update();
+  if (pipeline.CountExecutions() != 0)
+  {
+    cerr << "Up to date pipeline executed again\n";
+    return EXIT_FAILURE;
+  }
+  pipeline.Spheres[1]->SetRadius(0.75);
+  reference.Spheres[1]->SetRadius(0.75);
+  pipeline.Append->Update();
+  reference.Append->Update();
+  int executions = pipeline.CountExecutions();
+  if (executions != 6)
+  {
+    cerr << "Expected 6 executions after modifying one sphere, got " << executions << "\n";
+    return EXIT_FAILURE;
+  }
+  if (!SamePolyData(reference.Append->GetOutput(), pipeline.Append->GetOutput()))
+  {
+    cerr << "Output differs from vtkCompositeDataPipeline after modification\n";
+    return EXIT_FAILURE;
+  }
+
+  // Sibling consumers updated together.
+  vtkNew<vtkCollection> sinks;
+  for (vtkAlgorithm* algorithm : pipeline.Algorithms)
+  {
+    if (algorithm != pipeline.Append && !vtkSphereSource::SafeDownCast(algorithm))
+    {
+      sinks->AddItem(algorithm);
+    }
+  }
+  pipeline.Spheres[0]->Modified();
+  pipeline.Spheres[1]->Modified();
+  if (!vtkTaskGraphPipeline::UpdateAlgorithms(sinks))
+  {
+    cerr << "UpdateAlgorithms failed\n";
+    return EXIT_FAILURE;
+  }
+  executions = pipeline.CountExecutions();
+  if (executions != static_cast<int>(pipeline.Algorithms.size()) - 1)
+  {
+    cerr << "Expected every algorithm but the append filter to execute once, got " << executions
+         << " executions\n";
+    return EXIT_FAILURE;
+  }
+  auto cleanExecutive = vtkTaskGraphPipeline::SafeDownCast(pipeline.Algorithms[4]->GetExecutive());
+  if (cleanExecutive->GetLastTaskGraphWidth() != 6)
+  {
+    cerr << "Expected the sibling filters to run concurrently, width "
+         << cleanExecutive->GetLastTaskGraphWidth() << "\n";
+    return EXIT_FAILURE;
+  }
+  pipeline.Append->Update();
+  if (pipeline.CountExecutions() != 1 ||
+    !SamePolyData(reference.Append->GetOutput(), pipeline.Append->GetOutput()))
+  {
+    cerr << "Append filter did not reuse the outputs of UpdateAlgorithms\n";
+    return EXIT_FAILURE;
+  }
+
+  // Two consumers of one vtkPolyData that query its links.
+  vtkAlgorithm::SetDefaultExecutivePrototype(prototype);
+  vtkNew<vtkSphereSource> shared;
+  shared->SetThetaResolution(64);
+  shared->SetPhiResolution(64);
+  vtkNew<PointValence> valences[2];
+  vtkNew<vtkCollection> consumers;
+  for (auto& valence : valences)
+  {
+    valence->SetInputConnection(shared->GetOutputPort());
+    consumers->AddItem(valence);
+  }
+  vtkAlgorithm::SetDefaultExecutivePrototype(nullptr);
+  if (!vtkTaskGraphPipeline::UpdateAlgorithms(consumers))
+  {
+    cerr << "UpdateAlgorithms failed for the consumers of one vtkPolyData\n";
+    return EXIT_FAILURE;
+  }
+  auto valenceExecutive = vtkTaskGraphPipeline::SafeDownCast(valences[0]->GetExecutive());
+  if (valenceExecutive->GetLastTaskGraphWidth() != 2)
+  {
+    cerr << "Expected the consumers of one vtkPolyData to run concurrently, width "
+         << valenceExecutive->GetLastTaskGraphWidth() << "\n";
+    return EXIT_FAILURE;
+  }
+  if (shared->GetOutput()->NeedToBuildCells())
+  {
+    cerr << "The cells of the shared vtkPolyData were not built\n";
+    return EXIT_FAILURE;
+  }
+  vtkNew<vtkPolyData> sphere;
+  sphere->DeepCopy(shared->GetOutput());
+  vtkNew<vtkIdList> cellIds;
+  for (auto& valence : valences)
+  {
+    vtkIdTypeArray* counts =
+      vtkIdTypeArray::SafeDownCast(valence->GetOutput()->GetPointData()->GetArray("Valence"));
+    for (vtkIdType i = 0; i < sphere->GetNumberOfPoints(); ++i)
+    {
+      sphere->GetPointCells(i, cellIds);
+      if (counts->GetValue(i) != cellIds->GetNumberOfIds())
+      {
+        cerr << "Point " << i << " is used by " << cellIds->GetNumberOfIds() << " cells, not "
+             << counts->GetValue(i) << "\n";
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  // A contour and a threshold filter reading the scalars of one vtkPolyData,
+  // whose ranges are computed on the first GetRange() call.
+  vtkAlgorithm::SetDefaultExecutivePrototype(prototype);
+  vtkNew<vtkElevationFilter> elevation;
+  elevation->SetInputConnection(shared->GetOutputPort());
+  vtkNew<vtkContourFilter> contour;
+  contour->SetInputConnection(elevation->GetOutputPort());
+  contour->GenerateValues(5, 0.1, 0.9);
+  vtkNew<vtkThreshold> threshold;
+  threshold->SetInputConnection(elevation->GetOutputPort());
+  threshold->SetLowerThreshold(0.25);
+  threshold->SetUpperThreshold(0.75);
+  threshold->SetThresholdFunction(vtkThreshold::THRESHOLD_BETWEEN);
+  vtkAlgorithm::SetDefaultExecutivePrototype(nullptr);
+  vtkNew<vtkCollection> scalarConsumers;
+  scalarConsumers->AddItem(contour);
+  scalarConsumers->AddItem(threshold);
+  if (!vtkTaskGraphPipeline::UpdateAlgorithms(scalarConsumers))
+  {
+    cerr << "UpdateAlgorithms failed for the contour and threshold filters\n";
+    return EXIT_FAILURE;
+  }
+  // Neither filter reads the normals, their ranges were computed beforehand.
+  vtkDataArray* normals = elevation->GetOutput()->GetPointData()->GetArray("Normals");
+  if (!normals->GetInformation()->Has(vtkDataArray::L2_NORM_RANGE()) ||
+    !normals->GetInformation()->Has(vtkDataArray::PER_COMPONENT()))
+  {
+    cerr << "The ranges of the shared arrays were not computed\n";
+    return EXIT_FAILURE;
+  }
+  vtkNew<vtkPolyData> elevated;
+  elevated->DeepCopy(elevation->GetOutput());
+  vtkNew<vtkContourFilter> serialContour;
+  serialContour->SetInputData(elevated);
+  serialContour->GenerateValues(5, 0.1, 0.9);
+  serialContour->Update();
+  vtkNew<vtkThreshold> serialThreshold;
+  serialThreshold->SetInputData(elevated);
+  serialThreshold->SetLowerThreshold(0.25);
+  serialThreshold->SetUpperThreshold(0.75);
+  serialThreshold->SetThresholdFunction(vtkThreshold::THRESHOLD_BETWEEN);
+  serialThreshold->Update();
+  if (!SamePolyData(serialContour->GetOutput(), contour->GetOutput()) ||
+    contour->GetOutput()->GetNumberOfCells() == 0)
+  {
+    cerr << "Concurrent contour differs from the serial one\n";
+    return EXIT_FAILURE;
+  }
+  if (threshold->GetOutput()->GetNumberOfCells() == 0 ||
+    threshold->GetOutput()->GetNumberOfCells() !=
+      serialThreshold->GetOutput()->GetNumberOfCells() ||
+    threshold->GetOutput()->GetNumberOfPoints() !=
+      serialThreshold->GetOutput()->GetNumberOfPoints())
+  {
+    cerr << "Concurrent threshold differs from the serial one\n";
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
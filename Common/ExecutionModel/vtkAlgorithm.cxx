@@ -45,6 +45,7 @@
 #include "vtkTable.h"
 #include "vtkTrivialProducer.h"
 
+#include <cstring>
 #include <set>
 #include <vector>
 #include <vtksys/SystemTools.hxx>
@@ -728,6 +729,25 @@ int vtkAlgorithm::ModifyRequest(vtkInformation* /*request*/, int /*when*/)
   return 1;
 }
 
+//------------------------------------------------------------------------------
+vtkAlgorithm* vtkAlgorithm::NewConcurrentInstance()
+{
+  return nullptr;
+}
+
+//------------------------------------------------------------------------------
+vtkAlgorithm* vtkAlgorithm::NewConcurrentInstanceOf(const char* className)
+{
+  // A subclass may have parameters that the implementation does not copy.
+  if (strcmp(this->GetClassName(), className) != 0)
+  {
+    return nullptr;
+  }
+  vtkAlgorithm* instance = this->NewInstance();
+  instance->Information->Copy(this->Information, 1);
+  return instance;
+}
+
 //------------------------------------------------------------------------------
 int vtkAlgorithm::GetNumberOfInputPorts()
 {
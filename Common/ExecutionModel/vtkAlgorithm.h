@@ -154,6 +154,17 @@ public:
    */
   virtual int ModifyRequest(vtkInformation* request, int when);
 
+  /**
+   * Return a new instance of this algorithm with the same parameters, which
+   * can execute concurrently with it, or nullptr if the algorithm does not
+   * support it, the default. vtkThreadedCompositeDataPipeline executes the
+   * blocks of a composite input with an instance per thread when the
+   * algorithm supports it. Implementations must copy every parameter that
+   * affects the output, and use NewConcurrentInstanceOf() so that subclasses
+   * with parameters of their own are not supported by inheritance.
+   */
+  virtual vtkAlgorithm* NewConcurrentInstance();
+
   /**
    * Get the information object associated with an input port.  There
    * is one input port per kind of input to the algorithm.  Each input
@@ -750,6 +761,14 @@ protected:
    */
   int GetInputArrayAssociation(int idx, vtkInformationVector** inputVector);
 
+  /**
+   * For NewConcurrentInstance() implementations: return a new instance of
+   * the class of this algorithm with the settings common to all algorithms,
+   * such as the arrays to process, copied, or nullptr if this algorithm is
+   * not exactly of class `className`.
+   */
+  vtkAlgorithm* NewConcurrentInstanceOf(const char* className);
+
   ///@{
   /**
    * Filters that have multiple connections on one port can use
@@ -0,0 +1,341 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkCachedCompositeDataPipeline.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkCachedCompositeDataPipeline.h"
+
+#include "vtkAlgorithm.h"
+#include "vtkDataObject.h"
+#include "vtkInformation.h"
+#include "vtkInformationDoubleKey.h"
+#include "vtkInformationDoubleVectorKey.h"
+#include "vtkInformationIntegerKey.h"
+#include "vtkInformationIntegerVectorKey.h"
+#include "vtkInformationVector.h"
+#include "vtkLogger.h"
+#include "vtkObjectFactory.h"
+#include "vtkSmartPointer.h"
+
+#include <algorithm>
+#include <list>
+#include <vector>
+
+namespace
+{
+// The part of a request that selects what an algorithm produces.
+struct RequestKey
+{
+  bool HasTime = false;
+  double Time = 0.0;
+  int Piece = 0;
+  int NumberOfPieces = 1;
+  int GhostLevels = 0;
+  bool HasExtent = false;
+  int Extent[6] = { 0, -1, 0, -1, 0, -1 };
+  bool HasCompositeIndices = false;
+  std::vector<int> CompositeIndices;
+
+  explicit RequestKey(vtkInformation* outInfo)
+  {
+    using SDDP = vtkStreamingDemandDrivenPipeline;
+    // Like the superclass, ignore time requests if nothing provides time.
+    if (outInfo->Has(SDDP::UPDATE_TIME_STEP()) && outInfo->Has(SDDP::TIME_RANGE()))
+    {
+      this->HasTime = true;
+      this->Time = outInfo->Get(SDDP::UPDATE_TIME_STEP());
+    }
+    this->Piece = outInfo->Get(SDDP::UPDATE_PIECE_NUMBER());
+    this->NumberOfPieces = outInfo->Get(SDDP::UPDATE_NUMBER_OF_PIECES());
+    this->GhostLevels = outInfo->Get(SDDP::UPDATE_NUMBER_OF_GHOST_LEVELS());
+    if (outInfo->Has(SDDP::UPDATE_EXTENT()))
+    {
+      this->HasExtent = true;
+      outInfo->Get(SDDP::UPDATE_EXTENT(), this->Extent);
+    }
+    vtkInformationIntegerVectorKey* indicesKey =
+      vtkCompositeDataPipeline::UPDATE_COMPOSITE_INDICES();
+    if (outInfo->Has(indicesKey))
+    {
+      this->HasCompositeIndices = true;
+      int* indices = outInfo->Get(indicesKey);
+      this->CompositeIndices.assign(indices, indices + outInfo->Length(indicesKey));
+    }
+  }
+
+  bool IsEmptyExtent() const
+  {
+    return this->Extent[0] > this->Extent[1] || this->Extent[2] > this->Extent[3] ||
+      this->Extent[4] > this->Extent[5];
+  }
+
+  // Whether the output produced for this key satisfies `request`.
+  bool Satisfies(const RequestKey& request) const
+  {
+    if (this->HasTime != request.HasTime || (this->HasTime && this->Time != request.Time) ||
+      this->NumberOfPieces != request.NumberOfPieces ||
+      (this->NumberOfPieces != 1 && this->Piece != request.Piece) ||
+      this->GhostLevels < request.GhostLevels ||
+      this->HasCompositeIndices != request.HasCompositeIndices ||
+      this->CompositeIndices != request.CompositeIndices)
+    {
+      return false;
+    }
+    if (request.HasExtent && !request.IsEmptyExtent())
+    {
+      if (!this->HasExtent)
+      {
+        return false;
+      }
+      for (int i = 0; i < 6; i += 2)
+      {
+        if (request.Extent[i] < this->Extent[i] || request.Extent[i + 1] > this->Extent[i + 1])
+        {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+};
+
+struct CacheEntry
+{
+  int Port;
+  RequestKey Key;
+  vtkSmartPointer<vtkDataObject> Data;
+  unsigned long Size;
+};
+}
+
+//------------------------------------------------------------------------------
+class vtkCachedCompositeDataPipeline::vtkInternals
+{
+public:
+  // Most recently used first.
+  std::list<CacheEntry> Entries;
+  unsigned long Size = 0;
+
+  bool Contains(vtkDataObject* data) const
+  {
+    return std::any_of(this->Entries.begin(), this->Entries.end(),
+      [data](const CacheEntry& entry) { return entry.Data == data; });
+  }
+
+  // Drop the outputs produced before the last modification of the pipeline.
+  void RemoveOutdated(vtkMTimeType pipelineMTime)
+  {
+    for (auto it = this->Entries.begin(); it != this->Entries.end();)
+    {
+      if (it->Data->GetUpdateTime() < pipelineMTime)
+      {
+        this->Size -= it->Size;
+        it = this->Entries.erase(it);
+      }
+      else
+      {
+        ++it;
+      }
+    }
+  }
+
+  void Shrink(unsigned long limit)
+  {
+    while (!this->Entries.empty() && this->Size > limit)
+    {
+      this->Size -= this->Entries.back().Size;
+      this->Entries.pop_back();
+    }
+  }
+
+  void Clear()
+  {
+    this->Entries.clear();
+    this->Size = 0;
+  }
+};
+
+vtkStandardNewMacro(vtkCachedCompositeDataPipeline);
+
+//------------------------------------------------------------------------------
+vtkCachedCompositeDataPipeline::vtkCachedCompositeDataPipeline()
+  : CacheMemoryLimit(1024 * 1024)
+  , CacheHits(0)
+  , CacheMisses(0)
+  , Internals(new vtkInternals)
+{
+}
+
+//------------------------------------------------------------------------------
+vtkCachedCompositeDataPipeline::~vtkCachedCompositeDataPipeline()
+{
+  delete this->Internals;
+}
+
+//------------------------------------------------------------------------------
+void vtkCachedCompositeDataPipeline::SetCacheMemoryLimit(unsigned long limit)
+{
+  if (limit != this->CacheMemoryLimit)
+  {
+    this->CacheMemoryLimit = limit;
+    this->Internals->Shrink(limit);
+    this->Modified();
+  }
+}
+
+//------------------------------------------------------------------------------
+unsigned long vtkCachedCompositeDataPipeline::GetCacheMemorySize()
+{
+  return this->Internals->Size;
+}
+
+//------------------------------------------------------------------------------
+int vtkCachedCompositeDataPipeline::GetNumberOfCachedOutputs()
+{
+  return static_cast<int>(this->Internals->Entries.size());
+}
+
+//------------------------------------------------------------------------------
+void vtkCachedCompositeDataPipeline::ClearCache()
+{
+  this->Internals->Clear();
+}
+
+//------------------------------------------------------------------------------
+void vtkCachedCompositeDataPipeline::ResetCacheStatistics()
+{
+  this->CacheHits = 0;
+  this->CacheMisses = 0;
+}
+
+//------------------------------------------------------------------------------
+int vtkCachedCompositeDataPipeline::NeedToExecuteData(
+  int outputPort, vtkInformationVector** inInfoVec, vtkInformationVector* outInfoVec)
+{
+  if (!this->Superclass::NeedToExecuteData(outputPort, inInfoVec, outInfoVec))
+  {
+    return 0;
+  }
+
+  // Ports are looked up one at a time by the superclass when none is given.
+  if (outputPort < 0 || this->ContinueExecuting || this->Internals->Entries.empty())
+  {
+    return 1;
+  }
+
+  this->Internals->RemoveOutdated(this->PipelineMTime);
+  vtkInformation* outInfo = outInfoVec->GetInformationObject(outputPort);
+  RequestKey request(outInfo);
+  auto& entries = this->Internals->Entries;
+  auto entry = std::find_if(entries.begin(), entries.end(), [&](const CacheEntry& candidate) {
+    return candidate.Port == outputPort && candidate.Key.Satisfies(request);
+  });
+  if (entry == entries.end())
+  {
+    return 1;
+  }
+
+  // Hand the cached output to the consumers and mark it as the most recently
+  // used. The superclass then compares it with the request as usual.
+  entries.splice(entries.begin(), entries, entry);
+  vtkDataObject* data = entry->Data;
+  if (outInfo->Get(vtkDataObject::DATA_OBJECT()) == data)
+  {
+    return 1;
+  }
+  outInfo->Set(vtkDataObject::DATA_OBJECT(), data);
+  // As when the algorithm executes, remember the time request it answers.
+  if (outInfo->Has(UPDATE_TIME_STEP()))
+  {
+    outInfo->Set(PREVIOUS_UPDATE_TIME_STEP(), outInfo->Get(UPDATE_TIME_STEP()));
+  }
+  if (this->Superclass::NeedToExecuteData(outputPort, inInfoVec, outInfoVec))
+  {
+    return 1;
+  }
+  vtkLogF(TRACE, "%s output served from cache", vtkLogIdentifier(this->Algorithm));
+  ++this->CacheHits;
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+int vtkCachedCompositeDataPipeline::ExecuteData(
+  vtkInformation* request, vtkInformationVector** inInfoVec, vtkInformationVector* outInfoVec)
+{
+  int numberOfPorts = outInfoVec->GetNumberOfInformationObjects();
+
+  // Never execute into a cached output: give the algorithm new ones.
+  for (int i = 0; i < numberOfPorts; ++i)
+  {
+    vtkInformation* outInfo = outInfoVec->GetInformationObject(i);
+    vtkDataObject* data = outInfo->Get(vtkDataObject::DATA_OBJECT());
+    if (data && this->Internals->Contains(data))
+    {
+      vtkSmartPointer<vtkDataObject> newData;
+      newData.TakeReference(data->NewInstance());
+      outInfo->Set(vtkDataObject::DATA_OBJECT(), newData);
+    }
+  }
+
+  int result = this->Superclass::ExecuteData(request, inInfoVec, outInfoVec);
+  ++this->CacheMisses;
+  if (!result || this->ContinueExecuting || this->CacheMemoryLimit == 0)
+  {
+    return result;
+  }
+
+  // Cache the new outputs, replacing those produced for the same request.
+  this->Internals->RemoveOutdated(this->PipelineMTime);
+  auto& entries = this->Internals->Entries;
+  for (int i = 0; i < numberOfPorts; ++i)
+  {
+    vtkInformation* outInfo = outInfoVec->GetInformationObject(i);
+    vtkDataObject* data = outInfo->Get(vtkDataObject::DATA_OBJECT());
+    if (!data)
+    {
+      continue;
+    }
+    RequestKey key(outInfo);
+    for (auto it = entries.begin(); it != entries.end();)
+    {
+      if (it->Port == i && it->Key.Satisfies(key) && key.Satisfies(it->Key))
+      {
+        this->Internals->Size -= it->Size;
+        it = entries.erase(it);
+      }
+      else
+      {
+        ++it;
+      }
+    }
+    unsigned long size = data->GetActualMemorySize();
+    if (size <= this->CacheMemoryLimit)
+    {
+      entries.push_front(CacheEntry{ i, key, data, size });
+      this->Internals->Size += size;
+    }
+  }
+  this->Internals->Shrink(this->CacheMemoryLimit);
+
+  return result;
+}
+
+//------------------------------------------------------------------------------
+void vtkCachedCompositeDataPipeline::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "CacheMemoryLimit: " << this->CacheMemoryLimit << "\n";
+  os << indent << "CacheMemorySize: " << this->Internals->Size << "\n";
+  os << indent << "NumberOfCachedOutputs: " << this->Internals->Entries.size() << "\n";
+  os << indent << "CacheHits: " << this->CacheHits << "\n";
+  os << indent << "CacheMisses: " << this->CacheMisses << "\n";
+}
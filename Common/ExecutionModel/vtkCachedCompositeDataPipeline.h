@@ -0,0 +1,123 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkCachedCompositeDataPipeline.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkCachedCompositeDataPipeline
+ * @brief   Executive keeping the outputs of its algorithm for several requests
+ *
+ * vtkCachedCompositeDataPipeline behaves like vtkCompositeDataPipeline but
+ * keeps the outputs its algorithm produced for previous requests, by
+ * reference, in a least recently used cache bounded in memory. When a
+ * request matches a cached output, the output is handed back to the
+ * consumers instead of executing the algorithm and everything upstream of
+ * it. This makes going back and forth over the time steps of an animation
+ * cheap after the first pass, for any algorithm:
+ *
+ * @code
+ * vtkNew<vtkCachedCompositeDataPipeline> executive;
+ * executive->SetCacheMemoryLimit(4 * 1024 * 1024); // 4 GiB
+ * expensiveFilter->SetExecutive(executive);
+ * @endcode
+ *
+ * Outputs are cached per output port and keyed by the request they were
+ * produced for: the update time step, the piece, number of pieces and
+ * ghost levels, the update extent of structured data (a cached output
+ * covering the requested extent is reused) and the blocks requested with
+ * UPDATE_COMPOSITE_INDICES. Cached outputs are dropped when the algorithm or
+ * anything upstream of it is modified, including a change of the arrays
+ * selected on a reader, since such changes modify the algorithm.
+ *
+ * Outputs are never copied: the algorithm executes into a new data object
+ * when its current output is cached, and the output data object of a port
+ * changes when a cached one is handed back. Consumers should therefore get
+ * the output from the port (e.g. with vtkAlgorithm::GetOutputDataObject())
+ * after each update rather than keep a pointer to it, and must not modify
+ * it in place.
+ *
+ * @sa
+ * vtkCompositeDataPipeline vtkCachedStreamingDemandDrivenPipeline
+ */
+
+#ifndef vtkCachedCompositeDataPipeline_h
+#define vtkCachedCompositeDataPipeline_h
+
+#include "vtkCommonExecutionModelModule.h" // For export macro
+#include "vtkCompositeDataPipeline.h"
+
+class VTKCOMMONEXECUTIONMODEL_EXPORT vtkCachedCompositeDataPipeline
+  : public vtkCompositeDataPipeline
+{
+public:
+  static vtkCachedCompositeDataPipeline* New();
+  vtkTypeMacro(vtkCachedCompositeDataPipeline, vtkCompositeDataPipeline);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  ///@{
+  /**
+   * Maximum memory used by the cached outputs, in kibibytes as reported by
+   * vtkDataObject::GetActualMemorySize(). The least recently used outputs
+   * are released when it is exceeded, and outputs larger than the limit are
+   * not cached. 0 disables the cache. Defaults to 1 GiB.
+   */
+  void SetCacheMemoryLimit(unsigned long limit);
+  vtkGetMacro(CacheMemoryLimit, unsigned long);
+  ///@}
+
+  /**
+   * Memory currently used by the cached outputs, in kibibytes.
+   */
+  unsigned long GetCacheMemorySize();
+
+  /**
+   * Number of outputs currently cached.
+   */
+  int GetNumberOfCachedOutputs();
+
+  /**
+   * Release all the cached outputs. The current outputs are kept.
+   */
+  void ClearCache();
+
+  ///@{
+  /**
+   * Number of requests served from the cache and number of requests that
+   * executed the algorithm since the last call to ResetCacheStatistics().
+   */
+  vtkGetMacro(CacheHits, int);
+  vtkGetMacro(CacheMisses, int);
+  void ResetCacheStatistics();
+  ///@}
+
+protected:
+  vtkCachedCompositeDataPipeline();
+  ~vtkCachedCompositeDataPipeline() override;
+
+  int NeedToExecuteData(
+    int outputPort, vtkInformationVector** inInfoVec, vtkInformationVector* outInfoVec) override;
+  int ExecuteData(vtkInformation* request, vtkInformationVector** inInfoVec,
+    vtkInformationVector* outInfoVec) override;
+
+  unsigned long CacheMemoryLimit;
+  int CacheHits;
+  int CacheMisses;
+
+private:
+  vtkCachedCompositeDataPipeline(const vtkCachedCompositeDataPipeline&) = delete;
+  void operator=(const vtkCachedCompositeDataPipeline&) = delete;
+
+  class vtkInternals;
+  vtkInternals* Internals;
+};
+
+#endif
@@ -16,16 +16,19 @@
 
 #include "vtkAlgorithm.h"
 #include "vtkAlgorithmOutput.h"
+#include "vtkAllocationTracker.h"
 #include "vtkDataObject.h"
 #include "vtkGarbageCollector.h"
 #include "vtkInformation.h"
 #include "vtkInformationExecutivePortKey.h"
 #include "vtkInformationExecutivePortVectorKey.h"
+#include "vtkInformationIdTypeKey.h"
 #include "vtkInformationIntegerKey.h"
 #include "vtkInformationIterator.h"
 #include "vtkInformationKeyVectorKey.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
+#include "vtkPipelineProfiler.h"
 #include "vtkSmartPointer.h"
 
 #include <sstream>
@@ -36,10 +39,13 @@
 vtkInformationKeyMacro(vtkExecutive, ALGORITHM_AFTER_FORWARD, Integer);
 vtkInformationKeyMacro(vtkExecutive, ALGORITHM_BEFORE_FORWARD, Integer);
 vtkInformationKeyMacro(vtkExecutive, ALGORITHM_DIRECTION, Integer);
+vtkInformationKeyMacro(vtkExecutive, ALLOCATED_BYTES, IdType);
 vtkInformationKeyMacro(vtkExecutive, CONSUMERS, ExecutivePortVector);
 vtkInformationKeyMacro(vtkExecutive, FORWARD_DIRECTION, Integer);
 vtkInformationKeyMacro(vtkExecutive, FROM_OUTPUT_PORT, Integer);
 vtkInformationKeyMacro(vtkExecutive, KEYS_TO_COPY, KeyVector);
+vtkInformationKeyMacro(vtkExecutive, NUMBER_OF_ALLOCATIONS, IdType);
+vtkInformationKeyMacro(vtkExecutive, PEAK_ALLOCATED_BYTES, IdType);
 vtkInformationKeyMacro(vtkExecutive, PRODUCER, ExecutivePort);
 
 //------------------------------------------------------------------------------
@@ -743,7 +749,7 @@ int vtkExecutive::CallAlgorithm(vtkInformation* request, int direction,
 
   // Invoke the request on the algorithm.
   this->InAlgorithm = 1;
-  int result = this->Algorithm->ProcessRequest(request, inInfo, outInfo);
+  int result = this->InvokeAlgorithmRequest(this->Algorithm, request, inInfo, outInfo);
   this->InAlgorithm = 0;
 
   // If the algorithm failed report it now.
@@ -756,6 +762,41 @@ int vtkExecutive::CallAlgorithm(vtkInformation* request, int direction,
   return result;
 }
 
+//------------------------------------------------------------------------------
+int vtkExecutive::InvokeAlgorithmRequest(vtkAlgorithm* algorithm, vtkInformation* request,
+  vtkInformationVector** inInfo, vtkInformationVector* outInfo)
+{
+  // Go through the profiler when one is active.
+  vtkPipelineProfiler* profiler = vtkPipelineProfiler::GetActiveProfiler();
+  if (!vtkAllocationTracker::GetEnabled() ||
+    !request->Has(vtkDemandDrivenPipeline::REQUEST_DATA()))
+  {
+    return profiler ? profiler->ProcessRequest(algorithm, request, inInfo, outInfo)
+                    : algorithm->ProcessRequest(request, inInfo, outInfo);
+  }
+
+  // Attribute the allocations made while producing the data to the algorithm.
+  int result;
+  bool tracked;
+  vtkAllocationTracker::Statistics allocations;
+  {
+    vtkAllocationTracker::Scope tracking(vtkLogger::GetIdentifier(this->Algorithm));
+    result = profiler ? profiler->ProcessRequest(algorithm, request, inInfo, outInfo)
+                      : algorithm->ProcessRequest(request, inInfo, outInfo);
+    tracked = tracking.IsActive();
+    allocations = tracking.GetStatistics();
+  }
+
+  for (int i = 0; tracked && i < outInfo->GetNumberOfInformationObjects(); ++i)
+  {
+    vtkInformation* info = outInfo->GetInformationObject(i);
+    info->Set(ALLOCATED_BYTES(), static_cast<vtkIdType>(allocations.AllocatedBytes));
+    info->Set(PEAK_ALLOCATED_BYTES(), static_cast<vtkIdType>(allocations.PeakBytes));
+    info->Set(NUMBER_OF_ALLOCATIONS(), static_cast<vtkIdType>(allocations.Allocations));
+  }
+  return result;
+}
+
 //------------------------------------------------------------------------------
 int vtkExecutive::CheckAlgorithm(const char* method, vtkInformation* request)
 {
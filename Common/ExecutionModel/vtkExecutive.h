@@ -38,6 +38,7 @@ class vtkExecutiveInternals;
 class vtkInformation;
 class vtkInformationExecutivePortKey;
 class vtkInformationExecutivePortVectorKey;
+class vtkInformationIdTypeKey;
 class vtkInformationIntegerKey;
 class vtkInformationRequestKey;
 class vtkInformationKeyVectorKey;
@@ -209,6 +210,21 @@ public:
   static vtkInformationKeyVectorKey* KEYS_TO_COPY();
   ///@}
 
+  ///@{
+  /**
+   * Keys set in the output information of an algorithm after each execution
+   * of its REQUEST_DATA pass while vtkAllocationTracker is enabled: the
+   * bytes allocated by the execution, the largest number of bytes it held at
+   * once, and its number of allocations. Their counts include those of the
+   * upstream algorithms updated during the execution, see
+   * vtkAllocationTracker. Executions while the tracking is disabled leave
+   * them unchanged, so that they cost nothing.
+   */
+  static vtkInformationIdTypeKey* ALLOCATED_BYTES();
+  static vtkInformationIdTypeKey* PEAK_ALLOCATED_BYTES();
+  static vtkInformationIdTypeKey* NUMBER_OF_ALLOCATIONS();
+  ///@}
+
   enum
   {
     RequestUpstream,
@@ -251,6 +267,13 @@ protected:
   virtual void CopyDefaultInformation(vtkInformation* request, int direction,
     vtkInformationVector** inInfo, vtkInformationVector* outInfo);
 
+  // Invoke a request on the algorithm, or on an instance executing in its
+  // place, through the active vtkPipelineProfiler if any, and track the
+  // allocations of REQUEST_DATA passes when vtkAllocationTracker is enabled.
+  // Used by CallAlgorithm.
+  int InvokeAlgorithmRequest(vtkAlgorithm* algorithm, vtkInformation* request,
+    vtkInformationVector** inInfo, vtkInformationVector* outInfo);
+
   // Reset the pipeline update values in the given output information object.
   virtual void ResetPipelineInformation(int port, vtkInformation*) = 0;
 
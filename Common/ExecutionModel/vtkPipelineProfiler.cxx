@@ -0,0 +1,434 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkPipelineProfiler.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkPipelineProfiler.h"
+
+#include "vtkAlgorithm.h"
+#include "vtkDataObject.h"
+#include "vtkDoubleArray.h"
+#include "vtkExecutive.h"
+#include "vtkInformation.h"
+#include "vtkInformationExecutivePortKey.h"
+#include "vtkInformationVector.h"
+#include "vtkIntArray.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkStringArray.h"
+#include "vtkTable.h"
+#include "vtkTimeStamp.h"
+#include "vtkTimerLog.h"
+#include "vtkTypeInt64Array.h"
+#include "vtkWeakPointer.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+namespace
+{
+std::atomic<vtkPipelineProfiler*> ActiveProfiler(nullptr);
+
+enum Pass
+{
+  RequestInformation,
+  RequestUpdateExtent,
+  RequestData,
+  NumberOfPasses
+};
+
+const char* PassNames[NumberOfPasses] = { "REQUEST_INFORMATION", "REQUEST_UPDATE_EXTENT",
+  "REQUEST_DATA" };
+
+struct Event
+{
+  std::string Algorithm;
+  Pass RequestPass;
+  std::string Cause;
+  int Thread;
+  int SMPThreads;
+  double Start;
+  double WallTime;
+  double CPUTime;
+  vtkTypeInt64 InputSize;
+  vtkTypeInt64 OutputSize;
+};
+
+vtkTypeInt64 GetMemorySize(vtkInformationVector* infoVector)
+{
+  vtkTypeInt64 size = 0;
+  for (int i = 0; infoVector && i < infoVector->GetNumberOfInformationObjects(); ++i)
+  {
+    vtkDataObject* data = infoVector->GetInformationObject(i)->Get(vtkDataObject::DATA_OBJECT());
+    if (data)
+    {
+      size += static_cast<vtkTypeInt64>(data->GetActualMemorySize());
+    }
+  }
+  return size;
+}
+
+void WriteJSONString(std::ostream& os, const std::string& str)
+{
+  os << '"';
+  for (char c : str)
+  {
+    switch (c)
+    {
+      case '"':
+        os << "\\\"";
+        break;
+      case '\\':
+        os << "\\\\";
+        break;
+      case '\n':
+        os << "\\n";
+        break;
+      case '\t':
+        os << "\\t";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20)
+        {
+          char escaped[8];
+          std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned int>(c));
+          os << escaped;
+        }
+        else
+        {
+          os << c;
+        }
+    }
+  }
+  os << '"';
+}
+}
+
+//------------------------------------------------------------------------------
+class vtkPipelineProfiler::vtkInternals
+{
+public:
+  struct Execution
+  {
+    vtkWeakPointer<vtkAlgorithm> Algorithm;
+    vtkMTimeType Time;
+  };
+
+  std::mutex Mutex;
+  std::vector<Event> Events;
+  std::map<std::thread::id, int> Threads;
+  // Last execution of the algorithms, to find out why they execute again.
+  std::map<vtkAlgorithm*, Execution> Executions;
+  std::chrono::steady_clock::time_point Origin = std::chrono::steady_clock::now();
+
+  double Now() const
+  {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - this->Origin).count();
+  }
+
+  std::string GetCause(vtkAlgorithm* algorithm, vtkInformationVector** inInfo)
+  {
+    vtkMTimeType lastExecution;
+    {
+      std::lock_guard<std::mutex> lock(this->Mutex);
+      auto it = this->Executions.find(algorithm);
+      if (it == this->Executions.end() || it->second.Algorithm != algorithm)
+      {
+        return "first execution";
+      }
+      lastExecution = it->second.Time;
+    }
+    if (algorithm->GetMTime() > lastExecution)
+    {
+      return "modified";
+    }
+    for (int port = 0; port < algorithm->GetNumberOfInputPorts(); ++port)
+    {
+      for (int i = 0; i < inInfo[port]->GetNumberOfInformationObjects(); ++i)
+      {
+        vtkInformation* info = inInfo[port]->GetInformationObject(i);
+        vtkDataObject* input = info->Get(vtkDataObject::DATA_OBJECT());
+        if (input && input->GetMTime() > lastExecution)
+        {
+          vtkExecutive* producer;
+          int producerPort;
+          vtkExecutive::PRODUCER()->Get(info, producer, producerPort);
+          return producer && producer->GetAlgorithm()
+            ? "input " + vtkLogger::GetIdentifier(producer->GetAlgorithm())
+            : std::string("input");
+        }
+      }
+    }
+    return "request";
+  }
+
+  void Record(vtkAlgorithm* algorithm, Event&& event)
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    auto thread = this->Threads
+                    .insert(std::make_pair(std::this_thread::get_id(),
+                      static_cast<int>(this->Threads.size())))
+                    .first;
+    event.Thread = thread->second;
+    if (event.RequestPass == RequestData)
+    {
+      vtkTimeStamp executed;
+      executed.Modified();
+      this->Executions[algorithm] = Execution{ algorithm, executed.GetMTime() };
+    }
+    this->Events.push_back(std::move(event));
+  }
+};
+
+vtkStandardNewMacro(vtkPipelineProfiler);
+
+//------------------------------------------------------------------------------
+vtkPipelineProfiler::vtkPipelineProfiler()
+  : Internals(new vtkInternals)
+{
+}
+
+//------------------------------------------------------------------------------
+vtkPipelineProfiler::~vtkPipelineProfiler()
+{
+  this->Stop();
+  delete this->Internals;
+}
+
+//------------------------------------------------------------------------------
+void vtkPipelineProfiler::Start()
+{
+  ActiveProfiler.store(this);
+}
+
+//------------------------------------------------------------------------------
+void vtkPipelineProfiler::Stop()
+{
+  vtkPipelineProfiler* self = this;
+  ActiveProfiler.compare_exchange_strong(self, nullptr);
+}
+
+//------------------------------------------------------------------------------
+bool vtkPipelineProfiler::IsActive()
+{
+  return ActiveProfiler.load() == this;
+}
+
+//------------------------------------------------------------------------------
+vtkPipelineProfiler* vtkPipelineProfiler::GetActiveProfiler()
+{
+  return ActiveProfiler.load(std::memory_order_acquire);
+}
+
+//------------------------------------------------------------------------------
+void vtkPipelineProfiler::Clear()
+{
+  std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+  this->Internals->Events.clear();
+  this->Internals->Threads.clear();
+  this->Internals->Executions.clear();
+  this->Internals->Origin = std::chrono::steady_clock::now();
+}
+
+//------------------------------------------------------------------------------
+vtkIdType vtkPipelineProfiler::GetNumberOfEvents()
+{
+  std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+  return static_cast<vtkIdType>(this->Internals->Events.size());
+}
+
+//------------------------------------------------------------------------------
+int vtkPipelineProfiler::ProcessRequest(vtkAlgorithm* algorithm, vtkInformation* request,
+  vtkInformationVector** inInfo, vtkInformationVector* outInfo)
+{
+  Pass pass;
+  if (request->Has(vtkDemandDrivenPipeline::REQUEST_DATA()))
+  {
+    pass = RequestData;
+  }
+  else if (request->Has(vtkStreamingDemandDrivenPipeline::REQUEST_UPDATE_EXTENT()))
+  {
+    pass = RequestUpdateExtent;
+  }
+  else if (request->Has(vtkDemandDrivenPipeline::REQUEST_INFORMATION()))
+  {
+    pass = RequestInformation;
+  }
+  else
+  {
+    return algorithm->ProcessRequest(request, inInfo, outInfo);
+  }
+
+  Event event;
+  event.Algorithm = vtkLogger::GetIdentifier(algorithm);
+  event.RequestPass = pass;
+  event.SMPThreads = vtkSMPTools::GetEstimatedNumberOfThreads();
+  event.InputSize = 0;
+  event.OutputSize = 0;
+  if (pass == RequestData)
+  {
+    event.Cause = this->Internals->GetCause(algorithm, inInfo);
+    for (int port = 0; port < algorithm->GetNumberOfInputPorts(); ++port)
+    {
+      event.InputSize += ::GetMemorySize(inInfo[port]);
+    }
+  }
+
+  double cpuStart = vtkTimerLog::GetCPUTime();
+  event.Start = this->Internals->Now();
+  int result = algorithm->ProcessRequest(request, inInfo, outInfo);
+  event.WallTime = this->Internals->Now() - event.Start;
+  event.CPUTime = vtkTimerLog::GetCPUTime() - cpuStart;
+
+  if (pass == RequestData)
+  {
+    event.OutputSize = ::GetMemorySize(outInfo);
+  }
+  this->Internals->Record(algorithm, std::move(event));
+  return result;
+}
+
+//------------------------------------------------------------------------------
+std::string vtkPipelineProfiler::GetChromeTrace()
+{
+  std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+  std::ostringstream os;
+  os.precision(17);
+  os << "{\"traceEvents\":[";
+  const char* separator = "\n";
+  for (const Event& event : this->Internals->Events)
+  {
+    os << separator << "{\"name\":";
+    ::WriteJSONString(os, event.Algorithm);
+    os << ",\"cat\":\"" << PassNames[event.RequestPass] << "\",\"ph\":\"X\""
+       << ",\"ts\":" << event.Start * 1e6 << ",\"dur\":" << event.WallTime * 1e6
+       << ",\"pid\":0,\"tid\":" << event.Thread << ",\"args\":{\"pass\":\""
+       << PassNames[event.RequestPass] << "\",\"cpu_time_us\":" << event.CPUTime * 1e6
+       << ",\"smp_threads\":" << event.SMPThreads;
+    if (event.RequestPass == RequestData)
+    {
+      os << ",\"input_kib\":" << event.InputSize << ",\"output_kib\":" << event.OutputSize
+         << ",\"cause\":";
+      ::WriteJSONString(os, event.Cause);
+    }
+    os << "}}";
+    separator = ",\n";
+  }
+  os << "\n],\"displayTimeUnit\":\"ms\"}\n";
+  return os.str();
+}
+
+//------------------------------------------------------------------------------
+bool vtkPipelineProfiler::WriteChromeTrace(const char* fileName)
+{
+  if (!fileName)
+  {
+    vtkErrorMacro("No file name given.");
+    return false;
+  }
+  std::ofstream file(fileName);
+  if (!file)
+  {
+    vtkErrorMacro("Could not open " << fileName << " for writing.");
+    return false;
+  }
+  file << this->GetChromeTrace();
+  return static_cast<bool>(file);
+}
+
+//------------------------------------------------------------------------------
+void vtkPipelineProfiler::GetEvents(vtkTable* table)
+{
+  if (!table)
+  {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+  vtkIdType numberOfEvents = static_cast<vtkIdType>(this->Internals->Events.size());
+
+  vtkNew<vtkStringArray> algorithms;
+  algorithms->SetName("Algorithm");
+  vtkNew<vtkStringArray> passes;
+  passes->SetName("Pass");
+  vtkNew<vtkStringArray> causes;
+  causes->SetName("Cause");
+  vtkNew<vtkIntArray> threads;
+  threads->SetName("Thread");
+  vtkNew<vtkIntArray> smpThreads;
+  smpThreads->SetName("SMPThreads");
+  vtkNew<vtkDoubleArray> starts;
+  starts->SetName("Start");
+  vtkNew<vtkDoubleArray> wallTimes;
+  wallTimes->SetName("WallTime");
+  vtkNew<vtkDoubleArray> cpuTimes;
+  cpuTimes->SetName("CPUTime");
+  vtkNew<vtkTypeInt64Array> inputSizes;
+  inputSizes->SetName("InputSize");
+  vtkNew<vtkTypeInt64Array> outputSizes;
+  outputSizes->SetName("OutputSize");
+
+  algorithms->SetNumberOfValues(numberOfEvents);
+  passes->SetNumberOfValues(numberOfEvents);
+  causes->SetNumberOfValues(numberOfEvents);
+  threads->SetNumberOfValues(numberOfEvents);
+  smpThreads->SetNumberOfValues(numberOfEvents);
+  starts->SetNumberOfValues(numberOfEvents);
+  wallTimes->SetNumberOfValues(numberOfEvents);
+  cpuTimes->SetNumberOfValues(numberOfEvents);
+  inputSizes->SetNumberOfValues(numberOfEvents);
+  outputSizes->SetNumberOfValues(numberOfEvents);
+
+  for (vtkIdType i = 0; i < numberOfEvents; ++i)
+  {
+    const Event& event = this->Internals->Events[i];
+    algorithms->SetValue(i, event.Algorithm);
+    passes->SetValue(i, PassNames[event.RequestPass]);
+    causes->SetValue(i, event.Cause);
+    threads->SetValue(i, event.Thread);
+    smpThreads->SetValue(i, event.SMPThreads);
+    starts->SetValue(i, event.Start);
+    wallTimes->SetValue(i, event.WallTime);
+    cpuTimes->SetValue(i, event.CPUTime);
+    inputSizes->SetValue(i, event.InputSize);
+    outputSizes->SetValue(i, event.OutputSize);
+  }
+
+  table->Initialize();
+  table->AddColumn(algorithms);
+  table->AddColumn(passes);
+  table->AddColumn(causes);
+  table->AddColumn(threads);
+  table->AddColumn(smpThreads);
+  table->AddColumn(starts);
+  table->AddColumn(wallTimes);
+  table->AddColumn(cpuTimes);
+  table->AddColumn(inputSizes);
+  table->AddColumn(outputSizes);
+}
+
+//------------------------------------------------------------------------------
+void vtkPipelineProfiler::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Active: " << this->IsActive() << endl;
+  os << indent << "NumberOfEvents: " << this->GetNumberOfEvents() << endl;
+}
@@ -0,0 +1,149 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkPipelineProfiler.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkPipelineProfiler
+ * @brief   Record where the passes of pipeline updates spend their time
+ *
+ * While a vtkPipelineProfiler is started, every executive records the
+ * REQUEST_INFORMATION, REQUEST_UPDATE_EXTENT and REQUEST_DATA passes it
+ * invokes on its algorithm, for all the pipelines of the process. Each event
+ * holds:
+ *
+ * - the algorithm, as given by vtkLogIdentifier, and the pass;
+ * - the thread that invoked it and its start time, relative to Start();
+ * - the wall clock time and the CPU time of the process spent in the pass,
+ *   which includes the CPU time of other threads of the process, e.g. those
+ *   of vtkSMPTools;
+ * - the number of threads vtkSMPTools could use at that time;
+ * - for REQUEST_DATA, the memory used by the inputs before and by the
+ *   outputs after the pass, in kibibytes, as reported by
+ *   vtkDataObject::GetActualMemorySize();
+ * - for REQUEST_DATA, the cause of the execution: "first execution" the
+ *   first time the profiler sees the algorithm, "modified" if the algorithm
+ *   was modified since it last executed, "input" followed by the identifier
+ *   of the upstream algorithm if an input was produced again since then, or
+ *   "request" if only the request changed (e.g. the update extent or time).
+ *
+ * The events can be exported in the trace event format of Chrome, to be
+ * loaded in chrome://tracing or https://ui.perfetto.dev, or as a vtkTable.
+ *
+ * Only one profiler is active at a time. When none is, the executives only
+ * test a pointer before invoking their algorithm.
+ *
+ * @code
+ * vtkNew<vtkPipelineProfiler> profiler;
+ * profiler->Start();
+ * writer->Update();
+ * profiler->Stop();
+ * profiler->WriteChromeTrace("update.json");
+ * @endcode
+ *
+ * @sa
+ * vtkExecutionTimer vtkLogger vtkExecutive
+ */
+
+#ifndef vtkPipelineProfiler_h
+#define vtkPipelineProfiler_h
+
+#include "vtkCommonExecutionModelModule.h" // For export macro
+#include "vtkObject.h"
+
+#include <string> // For GetChromeTrace()
+
+class vtkAlgorithm;
+class vtkInformation;
+class vtkInformationVector;
+class vtkTable;
+
+class VTKCOMMONEXECUTIONMODEL_EXPORT vtkPipelineProfiler : public vtkObject
+{
+public:
+  static vtkPipelineProfiler* New();
+  vtkTypeMacro(vtkPipelineProfiler, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  /**
+   * Make this profiler the active one, stopping the one that was active if
+   * any, and start recording. Events already recorded are kept: call
+   * Clear() first to start a new profile.
+   */
+  void Start();
+
+  /**
+   * Stop recording if this profiler is the active one.
+   */
+  void Stop();
+
+  /**
+   * Whether this profiler is the active one.
+   */
+  bool IsActive();
+
+  /**
+   * Discard the recorded events and reset the origin of the start times.
+   * The algorithms seen so far are forgotten, so their next execution is
+   * recorded with "first execution" as cause.
+   */
+  void Clear();
+
+  /**
+   * Number of recorded events.
+   */
+  vtkIdType GetNumberOfEvents();
+
+  /**
+   * The recorded events in the JSON trace event format of Chrome, as
+   * complete ("X") events with the other measures in their arguments.
+   */
+  std::string GetChromeTrace();
+
+  /**
+   * Write GetChromeTrace() to \a fileName. Returns false on failure.
+   */
+  bool WriteChromeTrace(VTK_FILEPATH const char* fileName);
+
+  /**
+   * Fill \a table with one row per recorded event, with the columns
+   * Algorithm, Pass, Cause (strings), Thread, SMPThreads (integers), Start,
+   * WallTime, CPUTime (seconds), InputSize and OutputSize (kibibytes).
+   */
+  void GetEvents(vtkTable* table);
+
+  /**
+   * The active profiler, nullptr if none.
+   */
+  static vtkPipelineProfiler* GetActiveProfiler();
+
+  /**
+   * Invoke \a request on \a algorithm and record it if it is one of the
+   * profiled passes. Called by vtkExecutive::CallAlgorithm() while this
+   * profiler is active. Returns the result of ProcessRequest().
+   */
+  int ProcessRequest(vtkAlgorithm* algorithm, vtkInformation* request,
+    vtkInformationVector** inInfo, vtkInformationVector* outInfo);
+
+protected:
+  vtkPipelineProfiler();
+  ~vtkPipelineProfiler() override;
+
+private:
+  vtkPipelineProfiler(const vtkPipelineProfiler&) = delete;
+  void operator=(const vtkPipelineProfiler&) = delete;
+
+  class vtkInternals;
+  vtkInternals* Internals;
+};
+
+#endif
@@ -0,0 +1,551 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkTaskGraphPipeline.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkTaskGraphPipeline.h"
+
+#include "vtkAlgorithm.h"
+#include "vtkCollection.h"
+#include "vtkCollectionIterator.h"
+#include "vtkCellData.h"
+#include "vtkCompositeDataSet.h"
+#include "vtkDataArray.h"
+#include "vtkDataObject.h"
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkInformation.h"
+#include "vtkInformationExecutivePortKey.h"
+#include "vtkInformationVector.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkPointSet.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <memory>
+#include <vector>
+
+vtkStandardNewMacro(vtkTaskGraphPipeline);
+
+namespace
+{
+std::atomic<bool> SerialExecution(false);
+
+// Compute the ranges that the arrays cache in their information on the first
+// GetRange() call: the L2 norm range and the range of each component.
+void PrepareRanges(vtkFieldData* fieldData)
+{
+  for (int i = 0; i < fieldData->GetNumberOfArrays(); ++i)
+  {
+    vtkDataArray* array = fieldData->GetArray(i);
+    if (!array)
+    {
+      continue;
+    }
+    double range[2];
+    array->GetRange(range, -1);
+    for (int component = 0; component < array->GetNumberOfComponents(); ++component)
+    {
+      array->GetRange(range, component);
+    }
+  }
+}
+
+// Build the structures that a data set otherwise builds lazily, on the first
+// query, so that several algorithms can query it concurrently afterwards.
+void PrepareForConcurrentReads(vtkDataObject* dataObject)
+{
+  vtkDataSet* dataSet = vtkDataSet::SafeDownCast(dataObject);
+  if (!dataSet)
+  {
+    return;
+  }
+  double bounds[6];
+  dataSet->GetBounds(bounds);
+  PrepareRanges(dataSet->GetPointData());
+  PrepareRanges(dataSet->GetCellData());
+
+  if (vtkPolyData* polyData = vtkPolyData::SafeDownCast(dataSet))
+  {
+    if (polyData->NeedToBuildCells())
+    {
+      polyData->BuildCells();
+    }
+    if (polyData->GetNumberOfPoints() > 0)
+    {
+      // builds the links unless they already are
+      vtkNew<vtkIdList> cellIds;
+      polyData->GetPointCells(0, cellIds);
+    }
+  }
+  else if (vtkUnstructuredGrid* grid = vtkUnstructuredGrid::SafeDownCast(dataSet))
+  {
+    if (!grid->GetCellLinks())
+    {
+      grid->BuildLinks();
+    }
+  }
+  if (dataSet->GetNumberOfCells() > 0)
+  {
+    vtkNew<vtkGenericCell> cell;
+    dataSet->GetCell(0, cell);
+  }
+
+  // The locators are only brought up to date if they exist.
+  if (vtkPointSet* pointSet = vtkPointSet::SafeDownCast(dataSet))
+  {
+    if (pointSet->GetPointLocator())
+    {
+      pointSet->BuildPointLocator();
+    }
+    if (pointSet->GetCellLocator())
+    {
+      pointSet->BuildCellLocator();
+    }
+  }
+}
+}
+
+//------------------------------------------------------------------------------
+// The algorithms that need to execute for a REQUEST_DATA pass, with the
+// dependencies between them.
+class vtkTaskGraphPipeline::vtkTaskGraph
+{
+public:
+  struct Node
+  {
+    vtkDemandDrivenPipeline* Executive;
+    std::vector<int> Ports;
+    std::vector<Node*> Inputs;
+    int Level = -1;
+    bool Concurrent = false;
+  };
+
+  /**
+   * Add the producers of the inputs of \a executive that need to execute,
+   * and everything they depend on. Returns false if the graph cannot be
+   * built, in which case the pipeline must be executed serially.
+   */
+  bool AddInputs(vtkTaskGraphPipeline* executive, Node* node)
+  {
+    for (int i = 0; i < executive->GetNumberOfInputPorts(); ++i)
+    {
+      vtkInformationVector* inVector = executive->GetInputInformation()[i];
+      for (int j = 0; j < inVector->GetNumberOfInformationObjects(); ++j)
+      {
+        vtkExecutive* producer;
+        int producerPort;
+        vtkExecutive::PRODUCER()->Get(inVector->GetInformationObject(j), producer, producerPort);
+        if (!producer)
+        {
+          continue;
+        }
+        Node* input = nullptr;
+        if (!this->AddNode(producer, producerPort, input))
+        {
+          return false;
+        }
+        if (node && input &&
+          std::find(node->Inputs.begin(), node->Inputs.end(), input) == node->Inputs.end())
+        {
+          node->Inputs.push_back(input);
+        }
+      }
+    }
+    return true;
+  }
+
+  /**
+   * Add \a executive, to be updated on \a port, if it needs to execute.
+   * \a node is set to the node of the executive, or nullptr if it does not
+   * need to execute.
+   */
+  bool AddNode(vtkExecutive* executive, int port, Node*& node)
+  {
+    node = nullptr;
+    vtkTaskGraphPipeline* taskGraphExecutive = vtkTaskGraphPipeline::SafeDownCast(executive);
+    if (taskGraphExecutive &&
+      !taskGraphExecutive->NeedToExecuteData(port, taskGraphExecutive->GetInputInformation(),
+        taskGraphExecutive->GetOutputInformation()))
+    {
+      return true;
+    }
+
+    auto found = this->Nodes.find(executive);
+    if (found != this->Nodes.end())
+    {
+      node = found->second.get();
+      if (std::find(node->Ports.begin(), node->Ports.end(), port) == node->Ports.end())
+      {
+        node->Ports.push_back(port);
+      }
+      return true;
+    }
+
+    // Other executives are updated as a whole, with their own upstream
+    // pipeline, so their inputs are not part of the graph.
+    vtkDemandDrivenPipeline* ddp = vtkDemandDrivenPipeline::SafeDownCast(executive);
+    if (!ddp)
+    {
+      return false;
+    }
+    std::unique_ptr<Node> newNode(new Node);
+    newNode->Executive = ddp;
+    newNode->Ports.push_back(port);
+    newNode->Concurrent = taskGraphExecutive && taskGraphExecutive->CanExecuteConcurrently();
+    node = newNode.get();
+    this->Order.push_back(node);
+    this->Nodes[executive] = std::move(newNode);
+    return !taskGraphExecutive || this->AddInputs(taskGraphExecutive, node);
+  }
+
+  /**
+   * Assign levels to the nodes and return the largest number of nodes of a
+   * level that can execute concurrently.
+   */
+  int ComputeLevels()
+  {
+    this->Levels.clear();
+    for (Node* node : this->Order)
+    {
+      this->ComputeLevel(node);
+    }
+    for (Node* node : this->Order)
+    {
+      this->Levels[node->Level].push_back(node);
+    }
+    int width = this->Order.empty() ? 0 : 1;
+    for (const auto& level : this->Levels)
+    {
+      width = std::max(width,
+        static_cast<int>(std::count_if(level.second.begin(), level.second.end(),
+          [](Node* node) { return node->Concurrent; })));
+    }
+    return width;
+  }
+
+  /**
+   * Execute the nodes level by level. Returns 1 if all of them succeeded.
+   */
+  int Execute()
+  {
+    int result = 1;
+    for (const auto& level : this->Levels)
+    {
+      std::vector<Node*> concurrent;
+      for (Node* node : level.second)
+      {
+        if (node->Concurrent)
+        {
+          concurrent.push_back(node);
+        }
+      }
+
+      std::vector<int> results(concurrent.size(), 1);
+      if (concurrent.size() > 1 && !SerialExecution)
+      {
+        this->PrepareSharedInputs(concurrent);
+        auto executeNodes = [&](vtkIdType begin, vtkIdType end) {
+          for (vtkIdType i = begin; i < end; ++i)
+          {
+            results[i] = this->ExecuteNode(concurrent[i]);
+          }
+        };
+        vtkSMPTools::For(0, static_cast<vtkIdType>(concurrent.size()), 1, executeNodes);
+      }
+      else
+      {
+        for (size_t i = 0; i < concurrent.size(); ++i)
+        {
+          results[i] = this->ExecuteNode(concurrent[i]);
+        }
+      }
+      if (std::find(results.begin(), results.end(), 0) != results.end())
+      {
+        result = 0;
+      }
+
+      for (Node* node : level.second)
+      {
+        if (!node->Concurrent && !this->ExecuteNode(node))
+        {
+          result = 0;
+        }
+      }
+    }
+    return result;
+  }
+
+private:
+  /**
+   * Prepare the inputs that several of \a nodes read, which the nodes of
+   * lower levels have produced, to be read concurrently.
+   */
+  void PrepareSharedInputs(const std::vector<Node*>& nodes)
+  {
+    std::map<vtkDataObject*, int> readers;
+    for (Node* node : nodes)
+    {
+      std::vector<vtkDataObject*> inputs;
+      for (int i = 0; i < node->Executive->GetNumberOfInputPorts(); ++i)
+      {
+        vtkInformationVector* inVector = node->Executive->GetInputInformation()[i];
+        for (int j = 0; j < inVector->GetNumberOfInformationObjects(); ++j)
+        {
+          vtkDataObject* input =
+            inVector->GetInformationObject(j)->Get(vtkDataObject::DATA_OBJECT());
+          if (input && std::find(inputs.begin(), inputs.end(), input) == inputs.end())
+          {
+            inputs.push_back(input);
+          }
+        }
+      }
+      for (vtkDataObject* input : inputs)
+      {
+        readers[input]++;
+      }
+    }
+    for (const auto& input : readers)
+    {
+      if (input.second > 1)
+      {
+        PrepareForConcurrentReads(input.first);
+      }
+    }
+  }
+
+  int ComputeLevel(Node* node)
+  {
+    if (node->Level < 0)
+    {
+      int level = 0;
+      for (Node* input : node->Inputs)
+      {
+        level = std::max(level, this->ComputeLevel(input) + 1);
+      }
+      node->Level = level;
+    }
+    return node->Level;
+  }
+
+  int ExecuteNode(Node* node)
+  {
+    vtkTaskGraphPipeline* taskGraphExecutive =
+      vtkTaskGraphPipeline::SafeDownCast(node->Executive);
+    if (taskGraphExecutive)
+    {
+      taskGraphExecutive->InputsUpToDate = true;
+    }
+    int result = 1;
+    for (int port : node->Ports)
+    {
+      if (!node->Executive->UpdateData(port))
+      {
+        result = 0;
+      }
+    }
+    if (taskGraphExecutive)
+    {
+      taskGraphExecutive->InputsUpToDate = false;
+    }
+    return result;
+  }
+
+  std::map<vtkExecutive*, std::unique_ptr<Node>> Nodes;
+  std::vector<Node*> Order;
+  std::map<int, std::vector<Node*>> Levels;
+};
+
+//------------------------------------------------------------------------------
+vtkTaskGraphPipeline::vtkTaskGraphPipeline()
+{
+  this->InputsUpToDate = false;
+  this->LastTaskGraphWidth = 0;
+}
+
+//------------------------------------------------------------------------------
+vtkTaskGraphPipeline::~vtkTaskGraphPipeline() = default;
+
+//------------------------------------------------------------------------------
+void vtkTaskGraphPipeline::SetSerialExecution(bool serial)
+{
+  SerialExecution = serial;
+}
+
+//------------------------------------------------------------------------------
+bool vtkTaskGraphPipeline::GetSerialExecution()
+{
+  return SerialExecution;
+}
+
+//------------------------------------------------------------------------------
+bool vtkTaskGraphPipeline::CanExecuteConcurrently()
+{
+  if (vtkDataObject::GetGlobalReleaseDataFlag())
+  {
+    return false;
+  }
+  for (int i = 0; i < this->GetNumberOfInputPorts(); ++i)
+  {
+    vtkInformationVector* inVector = this->GetInputInformation()[i];
+    for (int j = 0; j < inVector->GetNumberOfInformationObjects(); ++j)
+    {
+      // Composite inputs may be iterated over by changing the data object of
+      // the input information, which is shared with the other consumers.
+      vtkInformation* inInfo = inVector->GetInformationObject(j);
+      if (inInfo->Get(RELEASE_DATA()) ||
+        vtkCompositeDataSet::SafeDownCast(inInfo->Get(vtkDataObject::DATA_OBJECT())))
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+int vtkTaskGraphPipeline::ForwardUpstream(vtkInformation* request)
+{
+  if (!request->Has(REQUEST_DATA()) || this->SharedInputInformation)
+  {
+    return this->Superclass::ForwardUpstream(request);
+  }
+
+  if (this->InputsUpToDate)
+  {
+    // The task graph has already executed the inputs.
+    return this->Algorithm->ModifyRequest(request, BeforeForward) &&
+      this->Algorithm->ModifyRequest(request, AfterForward);
+  }
+
+  vtkTaskGraph graph;
+  if (!graph.AddInputs(this, nullptr))
+  {
+    this->LastTaskGraphWidth = 0;
+    return this->Superclass::ForwardUpstream(request);
+  }
+  // Without independent branches, the graph simply executes on this thread.
+  // It is still used then, since the executives it executes do not have to
+  // look at their inputs again.
+  this->LastTaskGraphWidth = graph.ComputeLevels();
+  vtkLogF(TRACE, "%s execute-task-graph of width %d", vtkLogIdentifier(this->Algorithm),
+    this->LastTaskGraphWidth);
+  if (!this->Algorithm->ModifyRequest(request, BeforeForward))
+  {
+    return 0;
+  }
+  int result = graph.Execute();
+  if (!this->Algorithm->ModifyRequest(request, AfterForward))
+  {
+    return 0;
+  }
+  return result;
+}
+
+//------------------------------------------------------------------------------
+int vtkTaskGraphPipeline::UpdateAlgorithms(vtkCollection* algorithms)
+{
+  if (!algorithms)
+  {
+    return 0;
+  }
+
+  int result = 1;
+  vtkTaskGraph graph;
+  bool graphValid = true;
+  std::vector<vtkTaskGraphPipeline*> executives;
+  std::vector<vtkAlgorithm*> others;
+  vtkSmartPointer<vtkCollectionIterator> iter;
+  iter.TakeReference(algorithms->NewIterator());
+  for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+  {
+    vtkAlgorithm* algorithm = vtkAlgorithm::SafeDownCast(iter->GetCurrentObject());
+    if (!algorithm)
+    {
+      continue;
+    }
+    vtkTaskGraphPipeline* executive = vtkTaskGraphPipeline::SafeDownCast(algorithm->GetExecutive());
+    if (!executive)
+    {
+      others.push_back(algorithm);
+      continue;
+    }
+
+    // Same passes as vtkStreamingDemandDrivenPipeline::Update(), with the
+    // data pass deferred to the task graph.
+    int port = algorithm->GetNumberOfOutputPorts() > 0 ? 0 : -1;
+    if (!executive->UpdateInformation())
+    {
+      result = 0;
+      continue;
+    }
+    executive->PropagateTime(port);
+    executive->UpdateTimeDependentInformation(port);
+    if (!executive->PropagateUpdateExtent(port))
+    {
+      result = 0;
+      continue;
+    }
+    executives.push_back(executive);
+    if (!executive->LastPropogateUpdateExtentShortCircuited)
+    {
+      vtkTaskGraph::Node* node;
+      graphValid = graphValid && graph.AddNode(executive, port, node);
+    }
+  }
+
+  if (graphValid)
+  {
+    int width = graph.ComputeLevels();
+    for (vtkTaskGraphPipeline* executive : executives)
+    {
+      executive->LastTaskGraphWidth = width;
+    }
+    if (!graph.Execute())
+    {
+      result = 0;
+    }
+  }
+  else
+  {
+    for (vtkTaskGraphPipeline* executive : executives)
+    {
+      executive->LastTaskGraphWidth = 0;
+      others.push_back(executive->GetAlgorithm());
+    }
+  }
+
+  for (vtkAlgorithm* algorithm : others)
+  {
+    if (!algorithm->GetExecutive()->Update())
+    {
+      result = 0;
+    }
+  }
+  return result;
+}
+
+//------------------------------------------------------------------------------
+void vtkTaskGraphPipeline::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "LastTaskGraphWidth: " << this->LastTaskGraphWidth << endl;
+  os << indent << "SerialExecution: " << vtkTaskGraphPipeline::GetSerialExecution() << endl;
+}
@@ -0,0 +1,125 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkTaskGraphPipeline.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkTaskGraphPipeline
+ * @brief   Executive that executes independent branches of a pipeline concurrently
+ *
+ * vtkTaskGraphPipeline behaves like vtkCompositeDataPipeline, except for the
+ * REQUEST_DATA pass. Instead of updating its inputs one after the other,
+ * depth first, it collects the upstream algorithms that need to execute into
+ * a dependency graph and executes it level by level: the algorithms of a
+ * level only depend on algorithms of lower levels, so they are executed
+ * concurrently as tasks of vtkSMPTools. UpdateAlgorithms() does the same for
+ * several algorithms sharing inputs, e.g. the filters consuming one reader.
+ *
+ * Whether an algorithm executes is decided exactly as with the serial
+ * executives, so modification times and cached outputs are handled the same
+ * way. An algorithm only executes concurrently with others if its executive
+ * is a vtkTaskGraphPipeline, none of its inputs are composite data sets and
+ * none of them have their release data flag set; other algorithms execute
+ * one at a time, with their own upstream pipeline, on the calling thread.
+ * Pipelines without independent branches execute entirely on the calling
+ * thread.
+ *
+ * Before algorithms reading the same data set execute concurrently, the
+ * structures that the data set would otherwise build on the first query are
+ * built: its bounds, the ranges of its point and cell data arrays, the cells
+ * and links of a vtkPolyData, the links of a vtkUnstructuredGrid and whatever
+ * GetCell() initializes on its first call, as the thread safety notes of
+ * vtkDataSet require. Point and cell
+ * locators of a vtkPointSet are brought up to date if they exist, but are
+ * not created. Algorithms executing concurrently must otherwise not modify
+ * their inputs (e.g. rebuild their links or set a locator) nor share state
+ * with one another; subclasses can override CanExecuteConcurrently() for
+ * algorithms that do. Observers of their events (e.g. progress) are invoked
+ * from the threads executing them. Algorithms that ask to be executed again
+ * with CONTINUE_EXECUTING are not supported.
+ *
+ * To use this executive for all algorithms, set it as the default executive
+ * prototype with vtkAlgorithm::SetDefaultExecutivePrototype().
+ *
+ * @sa
+ * vtkCompositeDataPipeline vtkThreadedCompositeDataPipeline vtkSMPTools
+ */
+
+#ifndef vtkTaskGraphPipeline_h
+#define vtkTaskGraphPipeline_h
+
+#include "vtkCommonExecutionModelModule.h" // For export macro
+#include "vtkCompositeDataPipeline.h"
+
+class vtkCollection;
+
+class VTKCOMMONEXECUTIONMODEL_EXPORT vtkTaskGraphPipeline : public vtkCompositeDataPipeline
+{
+public:
+  static vtkTaskGraphPipeline* New();
+  vtkTypeMacro(vtkTaskGraphPipeline, vtkCompositeDataPipeline);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  /**
+   * Update all the algorithms in \a algorithms, executing the algorithms
+   * they depend on only once and concurrently where possible. The update
+   * requests of all algorithms are propagated before any data is produced,
+   * as for the inputs of an algorithm with several input connections.
+   * Algorithms that do not use a vtkTaskGraphPipeline are updated one after
+   * the other afterwards. Returns 1 on success, 0 if any update failed.
+   */
+  static int UpdateAlgorithms(vtkCollection* algorithms);
+
+  ///@{
+  /**
+   * When on, the dependency graph is built and traversed level by level as
+   * usual but every algorithm executes on the calling thread. This is meant
+   * for checking that a pipeline produces the same result with and without
+   * concurrency. Off by default.
+   */
+  static void SetSerialExecution(bool serial);
+  static bool GetSerialExecution();
+  ///@}
+
+  /**
+   * The largest number of algorithms that could execute concurrently in the
+   * last dependency graph executed by this executive, 0 if none was.
+   */
+  vtkGetMacro(LastTaskGraphWidth, int);
+
+protected:
+  vtkTaskGraphPipeline();
+  ~vtkTaskGraphPipeline() override;
+
+  int ForwardUpstream(vtkInformation* request) override;
+
+  /**
+   * Whether the algorithm may execute concurrently with others, given the
+   * current state of its inputs.
+   */
+  virtual bool CanExecuteConcurrently();
+
+  // Set while the inputs of this executive are known to be up to date
+  // because the task graph has executed them.
+  bool InputsUpToDate;
+
+  int LastTaskGraphWidth;
+
+private:
+  vtkTaskGraphPipeline(const vtkTaskGraphPipeline&) = delete;
+  void operator=(const vtkTaskGraphPipeline&) = delete;
+
+  class vtkTaskGraph;
+  friend class vtkTaskGraph;
+};
+
+#endif
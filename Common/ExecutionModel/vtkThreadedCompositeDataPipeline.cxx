@@ -67,6 +67,15 @@ void DeleteAll(vtkInformationVector** dst, int n)
   }
   delete[] dst;
 }
+
+// The block execution of the calling thread: the executive executing the
+// block and the instance of its algorithm executing in its place, if any.
+struct BlockExecution
+{
+  vtkThreadedCompositeDataPipeline* Executive;
+  vtkAlgorithm* Instance;
+};
+thread_local BlockExecution CurrentBlockExecution = { nullptr, nullptr };
 };
 
 //------------------------------------------------------------------------------
@@ -159,6 +168,16 @@ public:
 
     vtkInformation*& request = this->Requests.Local();
     request->Copy(this->Request, 1);
+
+    // Algorithms that support it execute the blocks of a thread with their
+    // own instance rather than re-entrantly.
+    vtkAlgorithm* algorithm = this->Exec->Algorithm;
+    vtkSmartPointer<vtkAlgorithm>& instance = this->Instances.Local();
+    instance.TakeReference(algorithm->NewConcurrentInstance());
+    if (instance)
+    {
+      instance->SetProgressObserver(algorithm->GetProgressObserver());
+    }
   }
 
   void operator()(vtkIdType begin, vtkIdType end)
@@ -169,6 +188,8 @@ public:
 
     vtkInformation* inInfo = inInfoVec[this->CompositePort]->GetInformationObject(this->Connection);
 
+    BlockExecution previous = CurrentBlockExecution;
+    CurrentBlockExecution = { this->Exec, this->Instances.Local() };
     for (vtkIdType i = begin; i < end; ++i)
     {
       std::vector<vtkDataObject*> outObjList = this->Exec->ExecuteSimpleAlgorithmForBlock(
@@ -178,6 +199,7 @@ public:
         this->OutObjs[i * outInfoVec->GetNumberOfInformationObjects() + j] = outObjList[j];
       }
     }
+    CurrentBlockExecution = previous;
   }
 
   void Reduce() {}
@@ -196,6 +218,7 @@ protected:
   vtkSMPThreadLocal<vtkInformationVector**> InInfoVecs;
   vtkSMPThreadLocal<vtkInformationVector*> OutInfoVecs;
   vtkSMPThreadLocalObject<vtkInformation> Requests;
+  vtkSMPThreadLocal<vtkSmartPointer<vtkAlgorithm>> Instances;
 };
 
 //------------------------------------------------------------------------------
@@ -275,8 +298,14 @@ int vtkThreadedCompositeDataPipeline::CallAlgorithm(vtkInformation* request, int
   // Copy default information in the direction of information flow.
   this->CopyDefaultInformation(request, direction, inInfo, outInfo);
 
-  // Invoke the request on the algorithm.
-  int result = this->Algorithm->ProcessRequest(request, inInfo, outInfo);
+  // Invoke the request on the algorithm, or on the instance of the thread
+  // when executing a block with one.
+  vtkAlgorithm* algorithm = this->Algorithm;
+  if (CurrentBlockExecution.Executive == this && CurrentBlockExecution.Instance)
+  {
+    algorithm = CurrentBlockExecution.Instance;
+  }
+  int result = this->InvokeAlgorithmRequest(algorithm, request, inInfo, outInfo);
 
   // If the algorithm failed report it now.
   if (!result)
@@ -19,8 +19,23 @@
  * vtkThreadedCompositeDataPipeline processes a composite data object in
  * parallel using the SMP framework. It does this by creating a vector of
  * data objects (the pieces of the composite data) and processing them
- * using vtkSMPTools::For. Note that this requires that the
- * algorithm implement all pipeline passes in a re-entrant way. It should
+ * using vtkSMPTools::For.
+ *
+ * Algorithms that return an instance from vtkAlgorithm::NewConcurrentInstance()
+ * execute the blocks of each thread with their own instance, a copy of the
+ * algorithm made when the thread starts processing blocks. These include
+ * vtkCutter, vtkContourFilter, vtkThreshold, vtkTableBasedClipDataSet,
+ * vtkDataSetSurfaceFilter and vtkGradientFilter, so that setting this
+ * executive on them processes the leaves of a vtkMultiBlockDataSet or of a
+ * vtkPartitionedDataSetCollection in parallel:
+ *
+ * @code
+ * vtkNew<vtkThreadedCompositeDataPipeline> executive;
+ * cutter->SetExecutive(executive);
+ * @endcode
+ *
+ * Other algorithms are executed concurrently by the threads, which requires
+ * that they implement all pipeline passes in a re-entrant way. They should
  * store/retrieve all state changes using input and output information
  * objects, which are unique to each thread.
  */
@@ -19,6 +19,7 @@
 
 #include <algorithm>
 #include <array>
+#include <cmath>
 #include <memory>
 #include <numeric>
 
@@ -36,6 +37,8 @@ static int Test_complex_module();
 static int Test_fftfreq();
 static int Test_rfftfreq();
 static int Test_fft_direct_inverse();
+static int Test_fft_batch();
+static int Test_rfft_batch();
 
 int UnitTestFFT(int, char*[])
 {
@@ -49,6 +52,8 @@ int UnitTestFFT(int, char*[])
   status += Test_fftfreq();
   status += Test_rfftfreq();
   status += Test_fft_direct_inverse();
+  status += Test_fft_batch();
+  status += Test_rfft_batch();
 
   if (status != 0)
   {
@@ -424,3 +429,148 @@ int Test_fft_direct_inverse()
   }
   return status;
 }
+
+// The DFT computed from its definition, in O(n^2).
+static std::vector<vtkFFT::ComplexNumber> NaiveDft(
+  const vtkFFT::ComplexNumber* in, std::size_t n, bool inverse)
+{
+  std::vector<vtkFFT::ComplexNumber> result(n);
+  const double sign = inverse ? 1.0 : -1.0;
+  for (std::size_t k = 0; k < n; ++k)
+  {
+    double real = 0.0;
+    double imag = 0.0;
+    for (std::size_t j = 0; j < n; ++j)
+    {
+      const double angle = sign * 2.0 * vtkMath::Pi() * static_cast<double>((j * k) % n) / n;
+      real += in[j].r * std::cos(angle) - in[j].i * std::sin(angle);
+      imag += in[j].r * std::sin(angle) + in[j].i * std::cos(angle);
+    }
+    result[k] = inverse ? vtkFFT::ComplexNumber{ real / n, imag / n }
+                        : vtkFFT::ComplexNumber{ real, imag };
+  }
+  return result;
+}
+
+static bool CompareDft(
+  const vtkFFT::ComplexNumber& expected, const vtkFFT::ComplexNumber& result, double tolerance)
+{
+  return std::abs(expected.r - result.r) < tolerance && std::abs(expected.i - result.i) < tolerance;
+}
+
+// Lengths with small factors, handled by kissfft, and with large prime
+// factors, handled with Bluestein's algorithm.
+static const std::size_t BatchLengths[] = { 1, 2, 3, 7, 12, 17, 64, 67, 97, 100, 134, 210, 331,
+  1009 };
+
+int Test_fft_batch()
+{
+  int status = 0;
+  std::cout << "Test_fft_batch..";
+
+  static constexpr std::size_t count = 3;
+  for (std::size_t n : BatchLengths)
+  {
+    std::vector<vtkFFT::ComplexNumber> input(n * count);
+    for (std::size_t j = 0; j < input.size(); ++j)
+    {
+      input[j] = vtkFFT::ComplexNumber{ std::sin(0.7 * j), std::cos(1.3 * j) - 0.5 };
+    }
+    for (bool inverse : { false, true })
+    {
+      std::vector<vtkFFT::ComplexNumber> result(input);
+      vtkFFT::FftBatch(result.data(), n, count, inverse);
+      for (std::size_t line = 0; line < count; ++line)
+      {
+        const auto expected = NaiveDft(input.data() + line * n, n, inverse);
+        for (std::size_t k = 0; k < n; ++k)
+        {
+          if (!CompareDft(expected[k], result[line * n + k], 1e-9 * n))
+          {
+            std::cout << "Length " << n << (inverse ? " inverse" : "") << ", term " << k
+                      << " of line " << line << " differs" << std::endl;
+            status++;
+            break;
+          }
+        }
+      }
+    }
+  }
+
+  // The inverse of the transform of a large prime length is the input.
+  static constexpr std::size_t prime = 10007;
+  std::vector<vtkFFT::ComplexNumber> input(prime);
+  for (std::size_t j = 0; j < prime; ++j)
+  {
+    input[j] = vtkFFT::ComplexNumber{ std::sin(0.1 * j), 0.25 * std::cos(0.3 * j) };
+  }
+  auto result = vtkFFT::IFft(vtkFFT::Fft(input));
+  for (std::size_t j = 0; j < prime; ++j)
+  {
+    if (!CompareDft(input[j], result[j], 1e-9))
+    {
+      std::cout << "Inverse of length " << prime << " differs at " << j << std::endl;
+      status++;
+      break;
+    }
+  }
+
+  if (status)
+  {
+    std::cout << "..FAILED" << std::endl;
+  }
+  else
+  {
+    std::cout << ".PASSED" << std::endl;
+  }
+  return status;
+}
+
+int Test_rfft_batch()
+{
+  int status = 0;
+  std::cout << "Test_rfft_batch..";
+
+  // An odd count, so that the last sequence is transformed alone.
+  static constexpr std::size_t count = 5;
+  for (std::size_t n : BatchLengths)
+  {
+    const std::size_t outSize = (n / 2) + 1;
+    std::vector<vtkFFT::ScalarNumber> input(n * count);
+    for (std::size_t j = 0; j < input.size(); ++j)
+    {
+      input[j] = std::sin(0.7 * j) + 0.1 * (j % 5);
+    }
+    std::vector<vtkFFT::ComplexNumber> result(outSize * count);
+    vtkFFT::RFftBatch(input.data(), result.data(), n, count);
+    for (std::size_t line = 0; line < count; ++line)
+    {
+      std::vector<vtkFFT::ComplexNumber> complexLine(n);
+      for (std::size_t j = 0; j < n; ++j)
+      {
+        complexLine[j] = vtkFFT::ComplexNumber{ input[line * n + j], 0.0 };
+      }
+      const auto expected = NaiveDft(complexLine.data(), n, false);
+      for (std::size_t k = 0; k < outSize; ++k)
+      {
+        if (!CompareDft(expected[k], result[line * outSize + k], 1e-9 * n))
+        {
+          std::cout << "Length " << n << ", term " << k << " of line " << line << " differs"
+                    << std::endl;
+          status++;
+          break;
+        }
+      }
+    }
+  }
+
+  if (status)
+  {
+    std::cout << "..FAILED" << std::endl;
+  }
+  else
+  {
+    std::cout << ".PASSED" << std::endl;
+  }
+  return status;
+}
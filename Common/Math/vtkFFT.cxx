@@ -16,29 +16,165 @@
 
 #include "vtkObjectFactory.h"
 
-//------------------------------------------------------------------------------
-vtkStandardNewMacro(vtkFFT);
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+namespace
+{
+using ComplexNumber = vtkFFT::ComplexNumber;
+
+// Lengths with a prime factor larger than this use Bluestein's algorithm:
+// kissfft handles such a factor p with a generic butterfly in O(n p).
+constexpr std::size_t BluesteinMinimumFactor = 64;
+
+std::size_t LargestPrimeFactor(std::size_t n)
+{
+  std::size_t largest = 1;
+  for (std::size_t p = 2; p * p <= n; ++p)
+  {
+    for (; n % p == 0; n /= p)
+    {
+      largest = p;
+    }
+  }
+  return std::max(largest, n);
+}
+
+ComplexNumber Multiply(const ComplexNumber& a, const ComplexNumber& b)
+{
+  return ComplexNumber{ a.r * b.r - a.i * b.i, a.r * b.i + a.i * b.r };
+}
 
 //------------------------------------------------------------------------------
-std::vector<vtkFFT::ComplexNumber> vtkFFT::Fft(const std::vector<ComplexNumber>& in)
+// The plan of the DFTs of a length and direction. It is read only once
+// created, so that threads can share it, each with its own work buffer.
+class FftPlan
 {
-  if (in.empty())
+public:
+  FftPlan(std::size_t n, bool inverse)
+    : Size(n)
+    , Scale(inverse ? 1.0 / n : 1.0)
   {
-    return {};
+    if (LargestPrimeFactor(n) < BluesteinMinimumFactor)
+    {
+      this->Config = kiss_fft_alloc(static_cast<int>(n), inverse, nullptr, nullptr);
+      return;
+    }
+
+    // Bluestein's algorithm writes the DFT as the convolution of the input
+    // multiplied by the chirp w[j] = exp(-+ i pi j^2 / n) with the conjugate
+    // chirp, computed with DFTs of a power of two length m >= 2n - 1.
+    std::size_t m = 1;
+    while (m < 2 * n - 1)
+    {
+      m *= 2;
+    }
+    this->Config = kiss_fft_alloc(static_cast<int>(m), 0, nullptr, nullptr);
+    this->InverseConfig = kiss_fft_alloc(static_cast<int>(m), 1, nullptr, nullptr);
+    this->Chirp.resize(n);
+    const double sign = inverse ? 1.0 : -1.0;
+    for (std::size_t j = 0; j < n; ++j)
+    {
+      // j^2 modulo 2n keeps the angle small and accurate for large j.
+      const double angle = sign * vtkMath::Pi() * static_cast<double>((j * j) % (2 * n)) / n;
+      this->Chirp[j] = ComplexNumber{ std::cos(angle), std::sin(angle) };
+    }
+    std::vector<ComplexNumber> kernel(m, ComplexNumber{ 0.0, 0.0 });
+    for (std::size_t j = 0; j < n; ++j)
+    {
+      kernel[j] = ComplexNumber{ this->Chirp[j].r / m, -this->Chirp[j].i / m };
+      kernel[(m - j) % m] = kernel[j];
+    }
+    this->ChirpFft.resize(m);
+    kiss_fft(this->Config, kernel.data(), this->ChirpFft.data());
   }
 
-  kiss_fft_cfg cfg =
-    kiss_fft_alloc(static_cast<int>(in.size()), 0 /*is_inverse_fft*/, nullptr, nullptr);
-  if (cfg != nullptr)
+  ~FftPlan()
   {
-    std::vector<vtkFFT::ComplexNumber> result(in.size());
+    kiss_fft_free(this->Config);
+    kiss_fft_free(this->InverseConfig);
+  }
 
-    kiss_fft(cfg, in.data(), &result[0]);
-    kiss_fft_free(cfg);
+  FftPlan(const FftPlan&) = delete;
+  FftPlan& operator=(const FftPlan&) = delete;
 
-    return result;
+  std::size_t GetWorkSize() const
+  {
+    return this->ChirpFft.empty() ? this->Size : 2 * this->ChirpFft.size();
   }
-  return {};
+
+  // Transforms data in place, work has GetWorkSize() points.
+  void Execute(ComplexNumber* data, ComplexNumber* work) const
+  {
+    const std::size_t n = this->Size;
+    if (this->ChirpFft.empty())
+    {
+      kiss_fft(this->Config, data, work);
+      for (std::size_t k = 0; k < n; ++k)
+      {
+        data[k] = ComplexNumber{ work[k].r * this->Scale, work[k].i * this->Scale };
+      }
+      return;
+    }
+
+    const std::size_t m = this->ChirpFft.size();
+    ComplexNumber* padded = work;
+    ComplexNumber* spectrum = work + m;
+    for (std::size_t j = 0; j < n; ++j)
+    {
+      padded[j] = Multiply(data[j], this->Chirp[j]);
+    }
+    std::fill(padded + n, padded + m, ComplexNumber{ 0.0, 0.0 });
+    kiss_fft(this->Config, padded, spectrum);
+    for (std::size_t k = 0; k < m; ++k)
+    {
+      spectrum[k] = Multiply(spectrum[k], this->ChirpFft[k]);
+    }
+    kiss_fft(this->InverseConfig, spectrum, padded);
+    for (std::size_t k = 0; k < n; ++k)
+    {
+      const ComplexNumber value = Multiply(padded[k], this->Chirp[k]);
+      data[k] = ComplexNumber{ value.r * this->Scale, value.i * this->Scale };
+    }
+  }
+
+private:
+  std::size_t Size;
+  double Scale;
+  kiss_fft_cfg Config = nullptr;
+  kiss_fft_cfg InverseConfig = nullptr;
+  // Bluestein's algorithm only.
+  std::vector<ComplexNumber> Chirp;
+  std::vector<ComplexNumber> ChirpFft;
+};
+
+// Returns the cached plan of a length and direction, creating it if needed.
+std::shared_ptr<const FftPlan> GetFftPlan(std::size_t n, bool inverse)
+{
+  static std::mutex mutex;
+  static std::map<std::pair<std::size_t, bool>, std::shared_ptr<const FftPlan>> plans;
+  std::lock_guard<std::mutex> lock(mutex);
+  std::shared_ptr<const FftPlan>& plan = plans[std::make_pair(n, inverse)];
+  if (!plan)
+  {
+    plan = std::make_shared<const FftPlan>(n, inverse);
+  }
+  return plan;
+}
+}
+
+//------------------------------------------------------------------------------
+vtkStandardNewMacro(vtkFFT);
+
+//------------------------------------------------------------------------------
+std::vector<vtkFFT::ComplexNumber> vtkFFT::Fft(const std::vector<ComplexNumber>& in)
+{
+  std::vector<vtkFFT::ComplexNumber> result(in);
+  vtkFFT::FftBatch(result.data(), result.size(), 1);
+  return result;
 }
 
 //------------------------------------------------------------------------------
@@ -86,27 +222,9 @@ std::vector<vtkFFT::ComplexNumber> vtkFFT::RFft(const std::vector<ScalarNumber>&
 //------------------------------------------------------------------------------
 std::vector<vtkFFT::ComplexNumber> vtkFFT::IFft(const std::vector<vtkFFT::ComplexNumber>& in)
 {
-  if (in.empty())
-  {
-    return {};
-  }
-
-  std::size_t outSize = in.size();
-  kiss_fft_cfg cfg =
-    kiss_fft_alloc(static_cast<int>(outSize), 1 /*is_inverse_fft*/, nullptr, nullptr);
-  if (cfg != nullptr)
-  {
-    std::vector<vtkFFT::ComplexNumber> result(outSize);
-
-    kiss_fft(cfg, in.data(), &result[0]);
-    std::for_each(result.begin(), result.end(), [outSize](vtkFFT::ComplexNumber& x) {
-      x = vtkFFT::ComplexNumber{ x.r / outSize, x.i / outSize };
-    });
-    kiss_fft_free(cfg);
-
-    return result;
-  }
-  return {};
+  std::vector<vtkFFT::ComplexNumber> result(in);
+  vtkFFT::FftBatch(result.data(), result.size(), 1, true);
+  return result;
 }
 
 //------------------------------------------------------------------------------
@@ -134,6 +252,77 @@ std::vector<vtkFFT::ScalarNumber> vtkFFT::IRFft(const std::vector<vtkFFT::Comple
   return {};
 }
 
+//------------------------------------------------------------------------------
+void vtkFFT::FftBatch(ComplexNumber* data, std::size_t n, std::size_t count, bool inverse)
+{
+  // The DFT of a single point is itself.
+  if (n < 2 || count == 0)
+  {
+    return;
+  }
+
+  std::shared_ptr<const FftPlan> plan = GetFftPlan(n, inverse);
+  std::vector<ComplexNumber> work(plan->GetWorkSize());
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    plan->Execute(data + i * n, work.data());
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkFFT::RFftBatch(const ScalarNumber* in, ComplexNumber* out, std::size_t n, std::size_t count)
+{
+  if (n == 0 || count == 0)
+  {
+    return;
+  }
+  const std::size_t outSize = (n / 2) + 1;
+  if (n == 1)
+  {
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      out[i] = ComplexNumber{ in[i], 0.0 };
+    }
+    return;
+  }
+
+  // The DFT Z of z = x + i y gives those of the real x and y:
+  // X[k] = (Z[k] + conj(Z[n - k])) / 2 and Y[k] = (Z[k] - conj(Z[n - k])) / 2i.
+  std::shared_ptr<const FftPlan> plan = GetFftPlan(n, false);
+  std::vector<ComplexNumber> work(plan->GetWorkSize());
+  std::vector<ComplexNumber> pair(n);
+  for (std::size_t i = 0; i < count; i += 2)
+  {
+    const ScalarNumber* x = in + i * n;
+    ComplexNumber* xOut = out + i * outSize;
+    if (i + 1 == count)
+    {
+      for (std::size_t j = 0; j < n; ++j)
+      {
+        pair[j] = ComplexNumber{ x[j], 0.0 };
+      }
+      plan->Execute(pair.data(), work.data());
+      std::copy(pair.begin(), pair.begin() + outSize, xOut);
+      break;
+    }
+
+    const ScalarNumber* y = x + n;
+    ComplexNumber* yOut = xOut + outSize;
+    for (std::size_t j = 0; j < n; ++j)
+    {
+      pair[j] = ComplexNumber{ x[j], y[j] };
+    }
+    plan->Execute(pair.data(), work.data());
+    for (std::size_t k = 0; k < outSize; ++k)
+    {
+      const ComplexNumber& z = pair[k];
+      const ComplexNumber& mirror = pair[(n - k) % n];
+      xOut[k] = ComplexNumber{ 0.5 * (z.r + mirror.r), 0.5 * (z.i - mirror.i) };
+      yOut[k] = ComplexNumber{ 0.5 * (z.i + mirror.i), 0.5 * (mirror.r - z.r) };
+    }
+  }
+}
+
 //------------------------------------------------------------------------------
 std::vector<double> vtkFFT::FftFreq(int windowLength, double sampleSpacing)
 {
@@ -94,6 +94,32 @@ public:
    */
   static std::vector<ScalarNumber> IRFft(const std::vector<ComplexNumber>& in);
 
+  /**
+   * Compute in place the one-dimensional DFTs of @c count complex sequences of
+   * @c n points each, stored one after the other in @c data. With @c inverse,
+   * compute the inverse DFTs, scaled by 1 / n like @c IFft.
+   *
+   * The plans of the transforms are computed once per length and direction and
+   * cached, so that the many transforms of the same length of an image or of a
+   * batch share them. Lengths with large prime factors are computed with
+   * Bluestein's algorithm, so that every length is O(n log n).
+   *
+   * This method, like @c Fft and @c IFft that use it, is thread safe.
+   */
+  static void FftBatch(ComplexNumber* data, std::size_t n, std::size_t count, bool inverse = false);
+
+  /**
+   * Compute the one-dimensional DFTs of @c count real sequences of @c n points
+   * each, stored one after the other in @c in. Like @c RFft, the (n/2) + 1 first
+   * terms of each DFT are written one after the other in @c out.
+   *
+   * The sequences are transformed two at a time, as the real and imaginary
+   * parts of one complex DFT, which halves the work of @c FftBatch for any n.
+   * This method is thread safe.
+   */
+  static void RFftBatch(
+    const ScalarNumber* in, ComplexNumber* out, std::size_t n, std::size_t count);
+
   /**
    * Return the absolute value (also known as norm, modulus, or magnitude) of complex number
    */
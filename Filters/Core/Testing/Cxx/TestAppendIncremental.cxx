@@ -0,0 +1,220 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestAppendIncremental.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Changes some inputs of vtkAppendPolyData and vtkAppendFilter with
+// IncrementalUpdate on, keeping or changing their sizes, and checks that the
+// outputs match those of filters appending all the inputs, and that the
+// output points are overwritten in place when the sizes are kept.
+
+#include "vtkAppendFilter.h"
+#include "vtkAppendPolyData.h"
+#include "vtkCellData.h"
+#include "vtkDataArray.h"
+#include "vtkElevationFilter.h"
+#include "vtkIdList.h"
+#include "vtkLineSource.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkRTAnalyticSource.h"
+#include "vtkSmartPointer.h"
+#include "vtkSphereSource.h"
+#include "vtkStripper.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <functional>
+#include <vector>
+
+namespace
+{
+bool CompareAttributes(vtkDataSetAttributes* expected, vtkDataSetAttributes* actual)
+{
+  if (expected->GetNumberOfArrays() != actual->GetNumberOfArrays())
+  {
+    cerr << actual->GetNumberOfArrays() << " arrays instead of " << expected->GetNumberOfArrays()
+         << "\n";
+    return false;
+  }
+  for (int i = 0; i < expected->GetNumberOfArrays(); ++i)
+  {
+    vtkDataArray* expectedArray = expected->GetArray(i);
+    vtkDataArray* actualArray = actual->GetArray(i);
+    if (!expectedArray || !actualArray ||
+      expectedArray->GetNumberOfValues() != actualArray->GetNumberOfValues())
+    {
+      cerr << "Array " << i << " differs\n";
+      return false;
+    }
+    int numberOfComponents = expectedArray->GetNumberOfComponents();
+    for (vtkIdType j = 0; j < expectedArray->GetNumberOfValues(); ++j)
+    {
+      if (expectedArray->GetComponent(j / numberOfComponents, j % numberOfComponents) !=
+        actualArray->GetComponent(j / numberOfComponents, j % numberOfComponents))
+      {
+        cerr << "Value " << j << " of array " << expectedArray->GetName() << " differs\n";
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool CompareDataSets(vtkDataSet* expected, vtkDataSet* actual)
+{
+  if (expected->GetNumberOfPoints() != actual->GetNumberOfPoints() ||
+    expected->GetNumberOfCells() != actual->GetNumberOfCells())
+  {
+    cerr << actual->GetNumberOfPoints() << " points and " << actual->GetNumberOfCells()
+         << " cells instead of " << expected->GetNumberOfPoints() << " and "
+         << expected->GetNumberOfCells() << "\n";
+    return false;
+  }
+  for (vtkIdType i = 0; i < expected->GetNumberOfPoints(); ++i)
+  {
+    double expectedPoint[3], actualPoint[3];
+    expected->GetPoint(i, expectedPoint);
+    actual->GetPoint(i, actualPoint);
+    if (expectedPoint[0] != actualPoint[0] || expectedPoint[1] != actualPoint[1] ||
+      expectedPoint[2] != actualPoint[2])
+    {
+      cerr << "Point " << i << " differs\n";
+      return false;
+    }
+  }
+  vtkNew<vtkIdList> expectedIds;
+  vtkNew<vtkIdList> actualIds;
+  for (vtkIdType i = 0; i < expected->GetNumberOfCells(); ++i)
+  {
+    expected->GetCellPoints(i, expectedIds);
+    actual->GetCellPoints(i, actualIds);
+    bool same = expected->GetCellType(i) == actual->GetCellType(i) &&
+      expectedIds->GetNumberOfIds() == actualIds->GetNumberOfIds();
+    for (vtkIdType j = 0; same && j < expectedIds->GetNumberOfIds(); ++j)
+    {
+      same = expectedIds->GetId(j) == actualIds->GetId(j);
+    }
+    if (!same)
+    {
+      cerr << "Cell " << i << " differs\n";
+      return false;
+    }
+  }
+  return CompareAttributes(expected->GetPointData(), actual->GetPointData()) &&
+    CompareAttributes(expected->GetCellData(), actual->GetCellData());
+}
+
+vtkSmartPointer<vtkElevationFilter> AddElevation(vtkAlgorithm* source)
+{
+  auto elevation = vtkSmartPointer<vtkElevationFilter>::New();
+  elevation->SetInputConnection(source->GetOutputPort());
+  elevation->SetLowPoint(-1.0, -1.0, -1.0);
+  elevation->SetHighPoint(1.0, 1.0, 1.0);
+  return elevation;
+}
+}
+
+int TestAppendIncremental(int, char*[])
+{
+  vtkNew<vtkSphereSource> sphere;
+  vtkNew<vtkLineSource> line;
+  line->SetResolution(8);
+  vtkNew<vtkSphereSource> strippedSphere;
+  strippedSphere->SetCenter(0.0, 2.0, 0.0);
+  vtkNew<vtkStripper> stripper;
+  stripper->SetInputConnection(strippedSphere->GetOutputPort());
+  vtkNew<vtkSphereSource> otherSphere;
+  otherSphere->SetCenter(0.0, 0.0, 2.0);
+  vtkNew<vtkRTAnalyticSource> image;
+  image->SetWholeExtent(0, 3, 0, 3, 0, 3);
+
+  std::vector<vtkSmartPointer<vtkElevationFilter>> polyDataInputs = { AddElevation(sphere),
+    AddElevation(line), AddElevation(stripper), AddElevation(otherSphere) };
+  vtkSmartPointer<vtkElevationFilter> imageInput = AddElevation(image);
+
+  vtkNew<vtkAppendPolyData> appendPolyData;
+  vtkNew<vtkAppendPolyData> expectedPolyData;
+  vtkNew<vtkAppendFilter> appendGrid;
+  vtkNew<vtkAppendFilter> expectedGrid;
+  appendPolyData->IncrementalUpdateOn();
+  appendGrid->IncrementalUpdateOn();
+  for (const auto& input : polyDataInputs)
+  {
+    appendPolyData->AddInputConnection(input->GetOutputPort());
+    expectedPolyData->AddInputConnection(input->GetOutputPort());
+    appendGrid->AddInputConnection(input->GetOutputPort());
+    expectedGrid->AddInputConnection(input->GetOutputPort());
+  }
+  appendGrid->AddInputConnection(imageInput->GetOutputPort());
+  expectedGrid->AddInputConnection(imageInput->GetOutputPort());
+
+  struct Step
+  {
+    const char* Name;
+    std::function<void()> Change;
+    // Whether the sizes of the inputs are kept, so that the outputs are
+    // overwritten in place.
+    bool InPlace;
+  };
+  std::vector<Step> steps = {
+    { "initial", []() {}, false },
+    { "moved sphere", [&]() { otherSphere->SetCenter(2.0, 0.0, 2.0); }, true },
+    { "moved line", [&]() { line->SetPoint2(1.0, 1.0, 0.0); }, true },
+    { "refined sphere", [&]() { sphere->SetThetaResolution(12); }, false },
+    { "new elevation of the strips",
+      [&]() { polyDataInputs[2]->SetLowPoint(0.0, 0.0, -2.0); }, true },
+    { "new image values", [&]() { image->SetMaximum(100.0); }, true },
+    { "moved and refined sphere",
+      [&]() {
+        otherSphere->SetCenter(2.0, 2.0, 2.0);
+        otherSphere->SetPhiResolution(6);
+      },
+      false },
+    { "unchanged", []() {}, true },
+  };
+
+  for (const Step& step : steps)
+  {
+    vtkPolyData* polyData = appendPolyData->GetOutput();
+    vtkUnstructuredGrid* grid = appendGrid->GetOutput();
+    vtkDataArray* polyDataPoints =
+      polyData->GetPoints() ? polyData->GetPoints()->GetData() : nullptr;
+    vtkDataArray* gridPoints = grid->GetPoints() ? grid->GetPoints()->GetData() : nullptr;
+
+    step.Change();
+    appendPolyData->Update();
+    expectedPolyData->Update();
+    appendGrid->Update();
+    expectedGrid->Update();
+
+    if (!CompareDataSets(expectedPolyData->GetOutput(), polyData))
+    {
+      cerr << "vtkAppendPolyData differs after the step " << step.Name << "\n";
+      return EXIT_FAILURE;
+    }
+    if (!CompareDataSets(expectedGrid->GetOutput(), grid))
+    {
+      cerr << "vtkAppendFilter differs after the step " << step.Name << "\n";
+      return EXIT_FAILURE;
+    }
+    if (step.InPlace &&
+      (polyData->GetPoints()->GetData() != polyDataPoints ||
+        grid->GetPoints()->GetData() != gridPoints))
+    {
+      cerr << "The points were not overwritten in place after the step " << step.Name << "\n";
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
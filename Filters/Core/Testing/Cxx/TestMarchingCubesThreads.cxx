@@ -0,0 +1,177 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestMarchingCubesThreads.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that vtkMarchingCubes, which marches the layers of cubes in
+// parallel with its default locator, gives the same output as the serial
+// march that a vtkMergePoints subclass gets. Contour values that hit the
+// samples of an integer image make points of different edges merge and
+// triangles degenerate.
+
+#include "vtkCellArray.h"
+#include "vtkCellArrayIterator.h"
+#include "vtkDataArray.h"
+#include "vtkImageData.h"
+#include "vtkMarchingCubes.h"
+#include "vtkMergePoints.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkRTAnalyticSource.h"
+#include "vtkSMPTools.h"
+#include "vtkShortArray.h"
+
+#include <algorithm>
+
+namespace
+{
+// Same merging as vtkMergePoints, but not the default locator.
+class SerialMergePoints : public vtkMergePoints
+{
+public:
+  static SerialMergePoints* New();
+  vtkTypeMacro(SerialMergePoints, vtkMergePoints);
+};
+vtkStandardNewMacro(SerialMergePoints);
+
+bool SameArray(vtkDataArray* a, vtkDataArray* b)
+{
+  if (!a || !b)
+  {
+    return a == b;
+  }
+  if (a->GetNumberOfValues() != b->GetNumberOfValues())
+  {
+    return false;
+  }
+  for (vtkIdType i = 0; i < a->GetNumberOfValues(); ++i)
+  {
+    if (a->GetComponent(i / a->GetNumberOfComponents(), i % a->GetNumberOfComponents()) !=
+      b->GetComponent(i / b->GetNumberOfComponents(), i % b->GetNumberOfComponents()))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool SameOutput(vtkPolyData* a, vtkPolyData* b)
+{
+  if (a->GetNumberOfPoints() != b->GetNumberOfPoints() ||
+    a->GetNumberOfPolys() != b->GetNumberOfPolys())
+  {
+    cerr << "Size mismatch: " << a->GetNumberOfPoints() << "/" << b->GetNumberOfPoints()
+         << " points, " << a->GetNumberOfPolys() << "/" << b->GetNumberOfPolys() << " polys\n";
+    return false;
+  }
+  if (!SameArray(a->GetPoints()->GetData(), b->GetPoints()->GetData()))
+  {
+    cerr << "Points differ\n";
+    return false;
+  }
+  vtkIdType nptsA, nptsB;
+  const vtkIdType *ptsA, *ptsB;
+  auto iterA = vtk::TakeSmartPointer(a->GetPolys()->NewIterator());
+  auto iterB = vtk::TakeSmartPointer(b->GetPolys()->NewIterator());
+  for (iterA->GoToFirstCell(), iterB->GoToFirstCell(); !iterA->IsDoneWithTraversal();
+       iterA->GoToNextCell(), iterB->GoToNextCell())
+  {
+    iterA->GetCurrentCell(nptsA, ptsA);
+    iterB->GetCurrentCell(nptsB, ptsB);
+    if (nptsA != nptsB || !std::equal(ptsA, ptsA + nptsA, ptsB))
+    {
+      cerr << "Triangle " << iterA->GetCurrentCellId() << " differs\n";
+      return false;
+    }
+  }
+  vtkPointData* pdA = a->GetPointData();
+  vtkPointData* pdB = b->GetPointData();
+  if (!pdA->GetScalars() || !SameArray(pdA->GetScalars(), pdB->GetScalars()) ||
+    !pdA->GetNormals() || !SameArray(pdA->GetNormals(), pdB->GetNormals()) ||
+    !SameArray(pdA->GetVectors(), pdB->GetVectors()))
+  {
+    cerr << "Point data differ\n";
+    return false;
+  }
+  return true;
+}
+
+bool CompareMarches(vtkImageData* image, const double* values, int numValues, bool gradients)
+{
+  vtkNew<vtkMarchingCubes> threaded;
+  vtkNew<vtkMarchingCubes> serial;
+  vtkNew<SerialMergePoints> locator;
+  serial->SetLocator(locator);
+  for (vtkMarchingCubes* contour : { threaded.Get(), serial.Get() })
+  {
+    contour->SetInputData(image);
+    for (int i = 0; i < numValues; ++i)
+    {
+      contour->SetValue(i, values[i]);
+    }
+    contour->SetComputeGradients(gradients);
+    contour->Update();
+  }
+  if (threaded->GetOutput()->GetNumberOfPolys() == 0)
+  {
+    cerr << "Empty contour\n";
+    return false;
+  }
+  return SameOutput(threaded->GetOutput(), serial->GetOutput());
+}
+}
+
+int TestMarchingCubesThreads(int, char*[])
+{
+  vtkSMPTools::Initialize(4);
+
+  vtkNew<vtkRTAnalyticSource> wavelet;
+  wavelet->SetWholeExtent(-20, 20, -16, 16, -12, 12);
+  wavelet->Update();
+  const double waveletValues[] = { 120., 160., 200. };
+  if (!CompareMarches(wavelet->GetOutput(), waveletValues, 3, true) ||
+    !CompareMarches(wavelet->GetOutput(), waveletValues, 1, false))
+  {
+    cerr << "Threaded march of the wavelet differs from the serial one\n";
+    return EXIT_FAILURE;
+  }
+
+  // integer samples equal to the contour values
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(24, 20, 16);
+  image->SetOrigin(-1., 2., 0.5);
+  vtkNew<vtkShortArray> samples;
+  samples->SetName("Samples");
+  samples->SetNumberOfTuples(image->GetNumberOfPoints());
+  vtkIdType id = 0;
+  for (int k = 0; k < 16; ++k)
+  {
+    for (int j = 0; j < 20; ++j)
+    {
+      for (int i = 0; i < 24; ++i)
+      {
+        samples->SetValue(id++, static_cast<short>((i * 7 + j * 3 + k * 5) % 9));
+      }
+    }
+  }
+  image->GetPointData()->SetScalars(samples);
+  const double sampleValues[] = { 2., 4., 6. };
+  if (!CompareMarches(image, sampleValues, 3, true))
+  {
+    cerr << "Threaded march of the integer image differs from the serial one\n";
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
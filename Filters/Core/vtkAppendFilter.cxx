@@ -16,6 +16,7 @@
 
 #include "vtkBoundingBox.h"
 #include "vtkCell.h"
+#include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkDataArrayRange.h"
 #include "vtkDataSetCollection.h"
@@ -27,6 +28,7 @@
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkPolyData.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkUnsignedCharArray.h"
@@ -34,17 +36,177 @@
 
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 vtkStandardNewMacro(vtkAppendFilter);
 
+namespace
+{
+vtkIdType GetConnectivitySize(vtkDataSet* input)
+{
+  if (vtkUnstructuredGrid* grid = vtkUnstructuredGrid::SafeDownCast(input))
+  {
+    return grid->GetCells() ? grid->GetCells()->GetNumberOfConnectivityIds() : 0;
+  }
+  if (vtkPolyData* polyData = vtkPolyData::SafeDownCast(input))
+  {
+    return polyData->GetVerts()->GetNumberOfConnectivityIds() +
+      polyData->GetLines()->GetNumberOfConnectivityIds() +
+      polyData->GetPolys()->GetNumberOfConnectivityIds() +
+      polyData->GetStrips()->GetNumberOfConnectivityIds();
+  }
+  vtkNew<vtkIdList> ptIds;
+  vtkIdType size = 0;
+  for (vtkIdType cellId = 0; cellId < input->GetNumberOfCells(); ++cellId)
+  {
+    input->GetCellPoints(cellId, ptIds);
+    size += ptIds->GetNumberOfIds();
+  }
+  return size;
+}
+
+// Names, types and numbers of components of the arrays, which decide the
+// arrays of the output and where their data is copied from.
+std::string GetArraysSignature(vtkDataSetAttributes* data)
+{
+  std::string signature;
+  for (int i = 0; i < data->GetNumberOfArrays(); ++i)
+  {
+    vtkAbstractArray* array = data->GetAbstractArray(i);
+    signature += array->GetName() ? array->GetName() : "";
+    signature += ':' + std::to_string(array->GetDataType()) + ':' +
+      std::to_string(array->GetNumberOfComponents()) + ':' +
+      std::to_string(data->IsArrayAnAttribute(i)) + ';';
+  }
+  return signature;
+}
+
+void MarkArraysModified(vtkDataSetAttributes* data)
+{
+  for (int i = 0; i < data->GetNumberOfArrays(); ++i)
+  {
+    data->GetAbstractArray(i)->Modified();
+  }
+}
+
+// The part of the output taken by an input.
+struct InputRange
+{
+  // Only compared, never dereferenced.
+  vtkDataSet* Input = nullptr;
+  vtkMTimeType MTime = 0;
+
+  vtkIdType NumberOfPoints = 0;
+  int PointsType = VTK_VOID;
+  vtkIdType NumberOfCells = 0;
+  vtkIdType ConnectivitySize = 0;
+  std::string PointArrays;
+  std::string CellArrays;
+
+  vtkIdType PointOffset = 0;
+  vtkIdType CellOffset = 0;
+  vtkIdType ConnectivityOffset = 0;
+  // Index of the input in the field lists, -1 for an empty input.
+  int List = -1;
+
+  explicit InputRange(vtkDataSet* input)
+    : Input(input)
+    , MTime(input ? input->GetMTime() : 0)
+  {
+    if (!input || (input->GetNumberOfPoints() <= 0 && input->GetNumberOfCells() <= 0))
+    {
+      return;
+    }
+    this->NumberOfPoints = input->GetNumberOfPoints();
+    vtkPointSet* pointSet = vtkPointSet::SafeDownCast(input);
+    if (pointSet && pointSet->GetPoints())
+    {
+      this->PointsType = pointSet->GetPoints()->GetDataType();
+    }
+    this->NumberOfCells = input->GetNumberOfCells();
+    this->ConnectivitySize = GetConnectivitySize(input);
+    this->PointArrays = GetArraysSignature(input->GetPointData());
+    this->CellArrays = GetArraysSignature(input->GetCellData());
+  }
+
+  // Whether the input can be copied over the range of this one.
+  bool HasSameLayout(const InputRange& other) const
+  {
+    return this->NumberOfPoints == other.NumberOfPoints && this->PointsType == other.PointsType &&
+      this->NumberOfCells == other.NumberOfCells &&
+      this->ConnectivitySize == other.ConnectivitySize &&
+      this->PointArrays == other.PointArrays && this->CellArrays == other.CellArrays;
+  }
+};
+
+// Copies the cells of an input over its range of the output cells.
+struct OverwriteCellsImpl
+{
+  template <typename CellStateT>
+  void operator()(CellStateT& state, vtkDataSet* input, const InputRange& range,
+    vtkUnsignedCharArray* types, vtkIdList* ptIds)
+  {
+    using ValueType = typename CellStateT::ValueType;
+    auto offsets = vtk::DataArrayValueRange<1>(state.GetOffsets());
+    auto connectivity = vtk::DataArrayValueRange<1>(state.GetConnectivity());
+    vtkIdType position = range.ConnectivityOffset;
+    for (vtkIdType cellId = 0; cellId < range.NumberOfCells; ++cellId)
+    {
+      input->GetCellPoints(cellId, ptIds);
+      offsets[range.CellOffset + cellId] = static_cast<ValueType>(position);
+      for (vtkIdType i = 0; i < ptIds->GetNumberOfIds(); ++i)
+      {
+        connectivity[position++] = static_cast<ValueType>(ptIds->GetId(i) + range.PointOffset);
+      }
+      types->SetValue(
+        range.CellOffset + cellId, static_cast<unsigned char>(input->GetCellType(cellId)));
+    }
+  }
+};
+}
+
+// The output of the last execution and the ranges of the inputs in it.
+class vtkAppendFilter::vtkInternals
+{
+public:
+  bool Valid = false;
+  vtkMTimeType FilterMTime = 0;
+  std::vector<InputRange> Ranges;
+
+  vtkSmartPointer<vtkPoints> Points;
+  vtkSmartPointer<vtkCellArray> Cells;
+  vtkSmartPointer<vtkUnsignedCharArray> CellTypes;
+  vtkNew<vtkPointData> PointData;
+  vtkNew<vtkCellData> CellData;
+  // The field lists that allocated the arrays above, to copy to them.
+  std::unique_ptr<vtkDataSetAttributes::FieldList> PointList;
+  std::unique_ptr<vtkDataSetAttributes::FieldList> CellList;
+
+  void Reset()
+  {
+    this->Valid = false;
+    this->Ranges.clear();
+    this->Points = nullptr;
+    this->Cells = nullptr;
+    this->CellTypes = nullptr;
+    this->PointData->Initialize();
+    this->CellData->Initialize();
+    this->PointList.reset(new vtkDataSetAttributes::FieldList);
+    this->CellList.reset(new vtkDataSetAttributes::FieldList);
+  }
+};
+
 //------------------------------------------------------------------------------
 vtkAppendFilter::vtkAppendFilter()
+  : Internals(new vtkInternals)
 {
   this->InputList = nullptr;
   this->MergePoints = 0;
   this->OutputPointsPrecision = DEFAULT_PRECISION;
   this->Tolerance = 0.0;
   this->ToleranceIsAbsolute = true;
+  this->IncrementalUpdate = false;
+  this->Internals->Reset();
 }
 
 //------------------------------------------------------------------------------
@@ -120,6 +282,12 @@ int vtkAppendFilter::RequestData(vtkInformation* vtkNotUsed(request),
 
   vtkDebugMacro(<< "Appending data together");
 
+  if (this->IncrementalUpdate && this->ExecuteIncrementalAppend(inputVector, output))
+  {
+    return 1;
+  }
+  this->Internals->Reset();
+
   // Loop over all data sets, checking to see what data is common to
   // all inputs. Note that data is common if 1) it is the same attribute
   // type (scalar, vector, etc.), 2) it is the same native type (int,
@@ -390,10 +558,11 @@ int vtkAppendFilter::RequestData(vtkInformation* vtkNotUsed(request),
   output->GetCellData()->CopyAllOn(vtkDataSetAttributes::COPYTUPLE);
 
   // Now copy the array data
-  this->AppendArrays(
-    vtkDataObject::POINT, inputVector, globalIndices, output, newPts->GetNumberOfPoints());
+  this->AppendArrays(vtkDataObject::POINT, inputVector, globalIndices, output,
+    newPts->GetNumberOfPoints(), *this->Internals->PointList);
   this->UpdateProgress(0.75);
-  this->AppendArrays(vtkDataObject::CELL, inputVector, nullptr, output, output->GetNumberOfCells());
+  this->AppendArrays(vtkDataObject::CELL, inputVector, nullptr, output, output->GetNumberOfCells(),
+    *this->Internals->CellList);
   this->UpdateProgress(1.0);
 
   // Update ourselves and release memory
@@ -402,9 +571,135 @@ int vtkAppendFilter::RequestData(vtkInformation* vtkNotUsed(request),
 
   delete[] globalIndices;
 
+  // Merged points and polyhedra do not take a range of the output per input.
+  if (this->IncrementalUpdate && !abort && !reallyMergePoints && !output->GetFaces())
+  {
+    this->RecordInputRanges(inputVector, output);
+  }
+
   return 1;
 }
 
+//------------------------------------------------------------------------------
+void vtkAppendFilter::RecordInputRanges(
+  vtkInformationVector** inputVector, vtkUnstructuredGrid* output)
+{
+  vtkInternals& internals = *this->Internals;
+  const int numInputs = inputVector[0]->GetNumberOfInformationObjects();
+  internals.Ranges.clear();
+  internals.Ranges.reserve(numInputs);
+
+  // The same offsets as RequestData and AppendArrays: the points and cells of
+  // the non empty inputs one after the other.
+  vtkIdType pointOffset = 0;
+  vtkIdType cellOffset = 0;
+  vtkIdType connectivityOffset = 0;
+  int list = 0;
+  for (int inputIndex = 0; inputIndex < numInputs; ++inputIndex)
+  {
+    InputRange range(vtkDataSet::GetData(inputVector[0], inputIndex));
+    if (range.NumberOfPoints > 0 || range.NumberOfCells > 0)
+    {
+      range.List = list++;
+    }
+    range.PointOffset = pointOffset;
+    range.CellOffset = cellOffset;
+    range.ConnectivityOffset = connectivityOffset;
+    pointOffset += range.NumberOfPoints;
+    cellOffset += range.NumberOfCells;
+    connectivityOffset += range.ConnectivitySize;
+    internals.Ranges.push_back(std::move(range));
+  }
+
+  internals.Points = output->GetPoints();
+  internals.Cells = output->GetCells();
+  internals.CellTypes = output->GetCellTypesArray();
+  internals.PointData->ShallowCopy(output->GetPointData());
+  internals.CellData->ShallowCopy(output->GetCellData());
+  internals.FilterMTime = this->GetMTime();
+  internals.Valid = true;
+}
+
+//------------------------------------------------------------------------------
+bool vtkAppendFilter::ExecuteIncrementalAppend(
+  vtkInformationVector** inputVector, vtkUnstructuredGrid* output)
+{
+  vtkInternals& internals = *this->Internals;
+  const int numInputs = inputVector[0]->GetNumberOfInformationObjects();
+  if (!internals.Valid || internals.FilterMTime != this->GetMTime() ||
+    static_cast<int>(internals.Ranges.size()) != numInputs)
+  {
+    return false;
+  }
+
+  std::vector<int> changed;
+  for (int inputIndex = 0; inputIndex < numInputs; ++inputIndex)
+  {
+    const InputRange& range = internals.Ranges[inputIndex];
+    vtkDataSet* input = vtkDataSet::GetData(inputVector[0], inputIndex);
+    if (input == range.Input && (!input || input->GetMTime() == range.MTime))
+    {
+      continue;
+    }
+    vtkUnstructuredGrid* grid = vtkUnstructuredGrid::SafeDownCast(input);
+    if (!input || !range.Input || (grid && grid->GetFaces()) ||
+      !range.HasSameLayout(InputRange(input)))
+    {
+      return false;
+    }
+    changed.push_back(inputIndex);
+  }
+  vtkDebugMacro(<< "Overwriting " << changed.size() << " of " << numInputs << " inputs");
+
+  vtkNew<vtkIdList> ptIds;
+  for (size_t i = 0; i < changed.size(); ++i)
+  {
+    this->UpdateProgress(static_cast<double>(i) / changed.size());
+    vtkDataSet* input = vtkDataSet::GetData(inputVector[0], changed[i]);
+    InputRange& range = internals.Ranges[changed[i]];
+    vtkPointSet* pointSet = vtkPointSet::SafeDownCast(input);
+    if (pointSet && pointSet->GetPoints())
+    {
+      internals.Points->InsertPoints(
+        range.PointOffset, range.NumberOfPoints, 0, pointSet->GetPoints());
+    }
+    else
+    {
+      for (vtkIdType ptId = 0; ptId < range.NumberOfPoints; ++ptId)
+      {
+        internals.Points->SetPoint(range.PointOffset + ptId, input->GetPoint(ptId));
+      }
+    }
+    internals.Cells->Visit(
+      OverwriteCellsImpl{}, input, range, internals.CellTypes.Get(), ptIds.Get());
+    if (range.List >= 0)
+    {
+      internals.PointList->CopyData(range.List, input->GetPointData(), 0, range.NumberOfPoints,
+        internals.PointData, range.PointOffset);
+      internals.CellList->CopyData(range.List, input->GetCellData(), 0, range.NumberOfCells,
+        internals.CellData, range.CellOffset);
+    }
+    range.Input = input;
+    range.MTime = input->GetMTime();
+  }
+
+  // Tell the consumers of the arrays, e.g. mappers, that they changed.
+  if (!changed.empty())
+  {
+    internals.Points->Modified();
+    internals.Cells->Modified();
+    internals.CellTypes->Modified();
+    MarkArraysModified(internals.PointData);
+    MarkArraysModified(internals.CellData);
+  }
+
+  output->SetPoints(internals.Points);
+  output->SetCells(internals.CellTypes, internals.Cells, nullptr, nullptr);
+  output->GetPointData()->ShallowCopy(internals.PointData);
+  output->GetCellData()->ShallowCopy(internals.CellData);
+  return true;
+}
+
 //------------------------------------------------------------------------------
 vtkDataSetCollection* vtkAppendFilter::GetNonEmptyInputs(vtkInformationVector** inputVector)
 {
@@ -433,7 +728,8 @@ vtkDataSetCollection* vtkAppendFilter::GetNonEmptyInputs(vtkInformationVector**
 
 //------------------------------------------------------------------------------
 void vtkAppendFilter::AppendArrays(int attributesType, vtkInformationVector** inputVector,
-  vtkIdType* globalIds, vtkUnstructuredGrid* output, vtkIdType totalNumberOfElements)
+  vtkIdType* globalIds, vtkUnstructuredGrid* output, vtkIdType totalNumberOfElements,
+  vtkDataSetAttributes::FieldList& fieldList)
 {
   // Check if attributesType is supported
   if (attributesType != vtkDataObject::POINT && attributesType != vtkDataObject::CELL)
@@ -443,7 +739,6 @@ void vtkAppendFilter::AppendArrays(int attributesType, vtkInformationVector** in
     return;
   }
 
-  vtkDataSetAttributes::FieldList fieldList;
   auto inputs = vtkSmartPointer<vtkDataSetCollection>::Take(this->GetNonEmptyInputs(inputVector));
   vtkCollectionSimpleIterator iter;
   vtkDataSet* dataSet = nullptr;
@@ -521,4 +816,5 @@ void vtkAppendFilter::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "MergePoints:" << (this->MergePoints ? "On" : "Off") << "\n";
   os << indent << "OutputPointsPrecision: " << this->OutputPointsPrecision << "\n";
   os << indent << "Tolerance: " << this->Tolerance << "\n";
+  os << indent << "IncrementalUpdate: " << (this->IncrementalUpdate ? "On" : "Off") << "\n";
 }
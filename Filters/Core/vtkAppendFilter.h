@@ -39,7 +39,10 @@
 #include "vtkFiltersCoreModule.h" // For export macro
 #include "vtkUnstructuredGridAlgorithm.h"
 
+#include <memory> // for std::unique_ptr
+
 class vtkDataSetAttributes;
+class vtkDataSetAttributesFieldList;
 class vtkDataSetCollection;
 
 class VTKFILTERSCORE_EXPORT vtkAppendFilter : public vtkUnstructuredGridAlgorithm
@@ -112,6 +115,23 @@ public:
   vtkGetMacro(OutputPointsPrecision, int);
   ///@}
 
+  ///@{
+  /**
+   * When IncrementalUpdate is on, the filter remembers the range of the
+   * output points, cells and connectivity taken by each input. If, when the
+   * filter executes again, the inputs that changed have the same numbers of
+   * points, of cells and of connectivity entries, and the same arrays, as
+   * before, only their ranges are overwritten, in place. Any other change,
+   * such as a change of the filter, of the number of inputs or of the size of
+   * an input, appends all the inputs again, as do inputs with polyhedra and
+   * merging points. The arrays of the output are kept between executions, so
+   * releasing the output does not free them. Defaults to Off.
+   */
+  vtkSetMacro(IncrementalUpdate, bool);
+  vtkGetMacro(IncrementalUpdate, bool);
+  vtkBooleanMacro(IncrementalUpdate, bool);
+  ///@}
+
 protected:
   vtkAppendFilter();
   ~vtkAppendFilter() override;
@@ -136,6 +156,8 @@ protected:
   // the diagonal of the bounding box of the input.
   bool ToleranceIsAbsolute;
 
+  bool IncrementalUpdate;
+
 private:
   vtkAppendFilter(const vtkAppendFilter&) = delete;
   void operator=(const vtkAppendFilter&) = delete;
@@ -145,7 +167,19 @@ private:
   vtkDataSetCollection* GetNonEmptyInputs(vtkInformationVector** inputVector);
 
   void AppendArrays(int attributesType, vtkInformationVector** inputVector, vtkIdType* globalIds,
-    vtkUnstructuredGrid* output, vtkIdType totalNumberOfElements);
+    vtkUnstructuredGrid* output, vtkIdType totalNumberOfElements,
+    vtkDataSetAttributesFieldList& fieldList);
+
+  // Overwrites the ranges of the changed inputs in the output of the last
+  // execution. Returns false, leaving the output untouched, when all the
+  // inputs have to be appended again.
+  bool ExecuteIncrementalAppend(vtkInformationVector** inputVector, vtkUnstructuredGrid* output);
+
+  // Remembers the output and the range taken by each input.
+  void RecordInputRanges(vtkInformationVector** inputVector, vtkUnstructuredGrid* output);
+
+  class vtkInternals;
+  std::unique_ptr<vtkInternals> Internals;
 };
 
 #endif
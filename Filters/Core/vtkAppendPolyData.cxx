@@ -23,23 +23,200 @@
 #include "vtkDataSetAttributes.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkPoints.h"
 #include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTrivialProducer.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cstdlib>
+#include <string>
+#include <vector>
 
 vtkStandardNewMacro(vtkAppendPolyData);
 
+namespace
+{
+// Verts, lines, polys and strips, in the order of the output cells.
+const int NumberOfCellTypes = 4;
+
+vtkCellArray* GetCells(vtkPolyData* polyData, int type)
+{
+  switch (type)
+  {
+    case 0:
+      return polyData->GetVerts();
+    case 1:
+      return polyData->GetLines();
+    case 2:
+      return polyData->GetPolys();
+    default:
+      return polyData->GetStrips();
+  }
+}
+
+// Names, types and numbers of components of the arrays, which decide the
+// arrays of the output.
+std::string GetArraysSignature(vtkDataSetAttributes* data)
+{
+  std::string signature;
+  for (int i = 0; i < data->GetNumberOfArrays(); ++i)
+  {
+    vtkAbstractArray* array = data->GetAbstractArray(i);
+    signature += array->GetName() ? array->GetName() : "";
+    signature += ':' + std::to_string(array->GetDataType()) + ':' +
+      std::to_string(array->GetNumberOfComponents()) + ':' +
+      std::to_string(data->IsArrayAnAttribute(i)) + ';';
+  }
+  return signature;
+}
+
+void MarkArraysModified(vtkDataSetAttributes* data)
+{
+  for (int i = 0; i < data->GetNumberOfArrays(); ++i)
+  {
+    data->GetAbstractArray(i)->Modified();
+  }
+}
+
+// The part of the output taken by an input.
+struct InputRange
+{
+  // Only compared, never dereferenced.
+  vtkPolyData* Input = nullptr;
+  vtkMTimeType MTime = 0;
+
+  vtkIdType NumberOfPoints = 0;
+  int PointsType = VTK_VOID;
+  vtkIdType NumberOfCells[NumberOfCellTypes] = { 0, 0, 0, 0 };
+  vtkIdType ConnectivitySize[NumberOfCellTypes] = { 0, 0, 0, 0 };
+  std::string PointArrays;
+  std::string CellArrays;
+
+  vtkIdType PointOffset = 0;
+  vtkIdType CellOffset[NumberOfCellTypes] = { 0, 0, 0, 0 };
+  vtkIdType ConnectivityOffset[NumberOfCellTypes] = { 0, 0, 0, 0 };
+  // Index of the input in the field lists of the point and cell data.
+  int PointList = -1;
+  int CellList = -1;
+
+  explicit InputRange(vtkPolyData* input)
+    : Input(input)
+    , MTime(input ? input->GetMTime() : 0)
+  {
+    if (!input || (input->GetNumberOfPoints() <= 0 && input->GetNumberOfCells() <= 0))
+    {
+      return;
+    }
+    this->NumberOfPoints = input->GetNumberOfPoints();
+    if (this->NumberOfPoints > 0)
+    {
+      this->PointsType = input->GetPoints()->GetDataType();
+      this->PointArrays = GetArraysSignature(input->GetPointData());
+    }
+    if (input->GetNumberOfCells() > 0)
+    {
+      for (int type = 0; type < NumberOfCellTypes; ++type)
+      {
+        vtkCellArray* cells = GetCells(input, type);
+        this->NumberOfCells[type] = cells->GetNumberOfCells();
+        this->ConnectivitySize[type] = cells->GetNumberOfConnectivityIds();
+      }
+      this->CellArrays = GetArraysSignature(input->GetCellData());
+    }
+  }
+
+  // Whether the input can be copied over the range of this one.
+  bool HasSameLayout(const InputRange& other) const
+  {
+    return this->NumberOfPoints == other.NumberOfPoints &&
+      this->PointsType == other.PointsType &&
+      std::equal(this->NumberOfCells, this->NumberOfCells + NumberOfCellTypes,
+        other.NumberOfCells) &&
+      std::equal(this->ConnectivitySize, this->ConnectivitySize + NumberOfCellTypes,
+        other.ConnectivitySize) &&
+      this->PointArrays == other.PointArrays && this->CellArrays == other.CellArrays;
+  }
+};
+
+// Copies the cells of an input over the range of the output cells starting
+// at a cell and a connectivity entry, offsetting the point ids.
+struct OverwriteCellsImpl
+{
+  template <typename OutputState, typename InputState>
+  void operator()(OutputState& output, InputState& input, vtkIdType cellOffset,
+    vtkIdType connectivityOffset, vtkIdType pointOffset)
+  {
+    using ValueType = typename OutputState::ValueType;
+    const auto inOffsets = vtk::DataArrayValueRange<1>(input.GetOffsets());
+    const auto inConnectivity = vtk::DataArrayValueRange<1>(input.GetConnectivity());
+    auto outOffsets = vtk::DataArrayValueRange<1>(
+      output.GetOffsets(), cellOffset, cellOffset + inOffsets.size());
+    auto outConnectivity = vtk::DataArrayValueRange<1>(output.GetConnectivity(),
+      connectivityOffset, connectivityOffset + inConnectivity.size());
+    std::transform(inOffsets.cbegin(), inOffsets.cend(), outOffsets.begin(),
+      [&](vtkIdType offset) { return static_cast<ValueType>(offset + connectivityOffset); });
+    std::transform(inConnectivity.cbegin(), inConnectivity.cend(), outConnectivity.begin(),
+      [&](vtkIdType id) { return static_cast<ValueType>(id + pointOffset); });
+  }
+};
+
+struct OverwriteCellsWorker
+{
+  template <typename InputState>
+  void operator()(InputState& input, vtkCellArray* output, vtkIdType cellOffset,
+    vtkIdType connectivityOffset, vtkIdType pointOffset)
+  {
+    output->Visit(OverwriteCellsImpl{}, input, cellOffset, connectivityOffset, pointOffset);
+  }
+};
+}
+
+// The output of the last execution and the ranges of the inputs in it.
+class vtkAppendPolyData::vtkInternals
+{
+public:
+  bool Valid = false;
+  vtkMTimeType FilterMTime = 0;
+  std::vector<InputRange> Ranges;
+  // First output cell of each cell type.
+  vtkIdType CellTypeOffset[NumberOfCellTypes] = { 0, 0, 0, 0 };
+
+  vtkSmartPointer<vtkPoints> Points;
+  vtkSmartPointer<vtkCellArray> Cells[NumberOfCellTypes];
+  vtkNew<vtkPointData> PointData;
+  vtkNew<vtkCellData> CellData;
+  // The field lists that allocated the arrays above, to copy to them.
+  std::unique_ptr<vtkDataSetAttributes::FieldList> PointList;
+  std::unique_ptr<vtkDataSetAttributes::FieldList> CellList;
+
+  void Reset()
+  {
+    this->Valid = false;
+    this->Ranges.clear();
+    this->Points = nullptr;
+    for (auto& cells : this->Cells)
+    {
+      cells = nullptr;
+    }
+    this->PointData->Initialize();
+    this->CellData->Initialize();
+  }
+};
+
 //------------------------------------------------------------------------------
 vtkAppendPolyData::vtkAppendPolyData()
+  : Internals(new vtkInternals)
 {
   this->ParallelStreaming = 0;
   this->UserManagedInputs = 0;
   this->OutputPointsPrecision = vtkAlgorithm::DEFAULT_PRECISION;
+  this->IncrementalUpdate = false;
 }
 
 //------------------------------------------------------------------------------
@@ -168,9 +345,13 @@ int vtkAppendPolyData::ExecuteAppend(vtkPolyData* output, vtkPolyData* inputs[],
     }   // for a non nullptr input
   }     // for each input
 
-  // These are used to determine which fields are available for appending
-  vtkDataSetAttributes::FieldList ptList(countPD);
-  vtkDataSetAttributes::FieldList cellList(countCD);
+  // These are used to determine which fields are available for appending.
+  // They are kept to copy the data of the inputs again with IncrementalUpdate.
+  this->Internals->Reset();
+  this->Internals->PointList.reset(new vtkDataSetAttributes::FieldList(countPD));
+  this->Internals->CellList.reset(new vtkDataSetAttributes::FieldList(countCD));
+  vtkDataSetAttributes::FieldList& ptList = *this->Internals->PointList;
+  vtkDataSetAttributes::FieldList& cellList = *this->Internals->CellList;
 
   countPD = countCD = 0;
   for (idx = 0; idx < numInputs; ++idx)
@@ -451,6 +632,7 @@ int vtkAppendPolyData::RequestData(vtkInformation* vtkNotUsed(request),
   int numInputs = inputVector[0]->GetNumberOfInformationObjects();
   if (numInputs == 1)
   {
+    this->Internals->Reset();
     output->ShallowCopy(vtkPolyData::GetData(inputVector[0], 0));
     return 1;
   }
@@ -460,11 +642,162 @@ int vtkAppendPolyData::RequestData(vtkInformation* vtkNotUsed(request),
   {
     inputs[idx] = vtkPolyData::GetData(inputVector[0], idx);
   }
-  int retVal = this->ExecuteAppend(output, inputs, numInputs);
+  int retVal = 1;
+  if (!this->IncrementalUpdate)
+  {
+    this->Internals->Reset();
+    retVal = this->ExecuteAppend(output, inputs, numInputs);
+  }
+  else if (!this->ExecuteIncrementalAppend(output, inputs, numInputs))
+  {
+    this->Internals->Reset();
+    retVal = this->ExecuteAppend(output, inputs, numInputs);
+    if (retVal)
+    {
+      this->RecordInputRanges(output, inputs, numInputs);
+    }
+  }
   delete[] inputs;
   return retVal;
 }
 
+//------------------------------------------------------------------------------
+void vtkAppendPolyData::RecordInputRanges(
+  vtkPolyData* output, vtkPolyData* inputs[], int numInputs)
+{
+  vtkInternals& internals = *this->Internals;
+  internals.Ranges.clear();
+  internals.Ranges.reserve(numInputs);
+
+  // The same offsets as ExecuteAppend: the points of the inputs one after the
+  // other, the cells of each type one after the other.
+  vtkIdType pointOffset = 0;
+  vtkIdType cellOffset[NumberOfCellTypes] = { 0, 0, 0, 0 };
+  vtkIdType connectivityOffset[NumberOfCellTypes] = { 0, 0, 0, 0 };
+  int pointList = 0;
+  int cellList = 0;
+  for (int idx = 0; idx < numInputs; ++idx)
+  {
+    InputRange range(inputs[idx]);
+    range.PointOffset = pointOffset;
+    pointOffset += range.NumberOfPoints;
+    if (range.NumberOfPoints > 0)
+    {
+      range.PointList = pointList++;
+    }
+    if (inputs[idx] && inputs[idx]->GetNumberOfCells() > 0)
+    {
+      range.CellList = cellList++;
+    }
+    for (int type = 0; type < NumberOfCellTypes; ++type)
+    {
+      range.CellOffset[type] = cellOffset[type];
+      range.ConnectivityOffset[type] = connectivityOffset[type];
+      cellOffset[type] += range.NumberOfCells[type];
+      connectivityOffset[type] += range.ConnectivitySize[type];
+    }
+    internals.Ranges.push_back(std::move(range));
+  }
+  vtkIdType cellTypeOffset = 0;
+  for (int type = 0; type < NumberOfCellTypes; ++type)
+  {
+    internals.CellTypeOffset[type] = cellTypeOffset;
+    cellTypeOffset += cellOffset[type];
+    internals.Cells[type] = cellOffset[type] > 0 ? GetCells(output, type) : nullptr;
+  }
+
+  internals.Points = output->GetPoints();
+  internals.PointData->ShallowCopy(output->GetPointData());
+  internals.CellData->ShallowCopy(output->GetCellData());
+  internals.FilterMTime = this->GetMTime();
+  internals.Valid = true;
+}
+
+//------------------------------------------------------------------------------
+bool vtkAppendPolyData::ExecuteIncrementalAppend(
+  vtkPolyData* output, vtkPolyData* inputs[], int numInputs)
+{
+  vtkInternals& internals = *this->Internals;
+  if (!internals.Valid || internals.FilterMTime != this->GetMTime() ||
+    static_cast<int>(internals.Ranges.size()) != numInputs)
+  {
+    return false;
+  }
+
+  std::vector<int> changed;
+  for (int idx = 0; idx < numInputs; ++idx)
+  {
+    const InputRange& range = internals.Ranges[idx];
+    vtkPolyData* input = inputs[idx];
+    if (input == range.Input && (!input || input->GetMTime() == range.MTime))
+    {
+      continue;
+    }
+    if (!input || !range.Input || !range.HasSameLayout(InputRange(input)))
+    {
+      return false;
+    }
+    changed.push_back(idx);
+  }
+
+  vtkDebugMacro(<< "Overwriting " << changed.size() << " of " << numInputs << " inputs");
+  for (size_t i = 0; i < changed.size(); ++i)
+  {
+    this->UpdateProgress(static_cast<double>(i) / changed.size());
+    vtkPolyData* input = inputs[changed[i]];
+    InputRange& range = internals.Ranges[changed[i]];
+    if (range.NumberOfPoints > 0)
+    {
+      this->AppendData(
+        internals.Points->GetData(), input->GetPoints()->GetData(), range.PointOffset);
+      internals.PointData->CopyData(*internals.PointList, input->GetPointData(), range.PointList,
+        range.PointOffset, range.NumberOfPoints, 0);
+    }
+    vtkIdType inputCellOffset = 0;
+    for (int type = 0; type < NumberOfCellTypes; ++type)
+    {
+      if (range.NumberOfCells[type] > 0)
+      {
+        GetCells(input, type)->Visit(OverwriteCellsWorker{}, internals.Cells[type],
+          range.CellOffset[type], range.ConnectivityOffset[type], range.PointOffset);
+        internals.CellData->CopyData(*internals.CellList, input->GetCellData(), range.CellList,
+          internals.CellTypeOffset[type] + range.CellOffset[type], range.NumberOfCells[type],
+          inputCellOffset);
+        inputCellOffset += range.NumberOfCells[type];
+      }
+    }
+    range.Input = input;
+    range.MTime = input->GetMTime();
+  }
+
+  // Tell the consumers of the arrays, e.g. mappers, that they changed.
+  if (!changed.empty())
+  {
+    if (internals.Points)
+    {
+      internals.Points->Modified();
+    }
+    for (auto& cells : internals.Cells)
+    {
+      if (cells)
+      {
+        cells->Modified();
+      }
+    }
+    MarkArraysModified(internals.PointData);
+    MarkArraysModified(internals.CellData);
+  }
+
+  output->SetPoints(internals.Points);
+  output->SetVerts(internals.Cells[0]);
+  output->SetLines(internals.Cells[1]);
+  output->SetPolys(internals.Cells[2]);
+  output->SetStrips(internals.Cells[3]);
+  output->GetPointData()->ShallowCopy(internals.PointData);
+  output->GetCellData()->ShallowCopy(internals.CellData);
+  return true;
+}
+
 //------------------------------------------------------------------------------
 int vtkAppendPolyData::RequestUpdateExtent(vtkInformation* vtkNotUsed(request),
   vtkInformationVector** inputVector, vtkInformationVector* outputVector)
@@ -543,6 +876,7 @@ void vtkAppendPolyData::PrintSelf(ostream& os, vtkIndent indent)
   os << "ParallelStreaming:" << (this->ParallelStreaming ? "On" : "Off") << endl;
   os << "UserManagedInputs:" << (this->UserManagedInputs ? "On" : "Off") << endl;
   os << indent << "Output Points Precision: " << this->OutputPointsPrecision << endl;
+  os << indent << "Incremental Update: " << (this->IncrementalUpdate ? "On" : "Off") << endl;
 }
 
 //------------------------------------------------------------------------------
@@ -39,6 +39,8 @@
 #include "vtkFiltersCoreModule.h" // For export macro
 #include "vtkPolyDataAlgorithm.h"
 
+#include <memory> // for std::unique_ptr
+
 class vtkCellArray;
 class vtkDataArray;
 class vtkPoints;
@@ -120,6 +122,23 @@ public:
   vtkGetMacro(OutputPointsPrecision, int);
   ///@}
 
+  ///@{
+  /**
+   * When IncrementalUpdate is on, the filter remembers the range of the
+   * output points and cells taken by each input. If, when the filter executes
+   * again, the inputs that changed have the same numbers of points, of cells
+   * and of connectivity entries of each cell type, and the same arrays, as
+   * before, only their ranges are overwritten, in place. Any other change,
+   * such as a change of the filter, of the number of inputs or of the size of
+   * an input, appends all the inputs again. The arrays of the output are kept
+   * between executions, so releasing the output does not free them. By
+   * default, IncrementalUpdate is false.
+   */
+  vtkSetMacro(IncrementalUpdate, bool);
+  vtkGetMacro(IncrementalUpdate, bool);
+  vtkBooleanMacro(IncrementalUpdate, bool);
+  ///@}
+
   int ExecuteAppend(vtkPolyData* output, vtkPolyData* inputs[], int numInputs)
     VTK_SIZEHINT(inputs, numInputs);
 
@@ -131,6 +150,8 @@ protected:
   vtkTypeBool ParallelStreaming;
   int OutputPointsPrecision;
 
+  bool IncrementalUpdate;
+
   // Usual data generation method
   int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
   int RequestUpdateExtent(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
@@ -151,6 +172,17 @@ private:
 
   vtkTypeBool UserManagedInputs;
 
+  // Overwrites the ranges of the changed inputs in the output of the last
+  // execution. Returns false, leaving the output untouched, when all the
+  // inputs have to be appended again.
+  bool ExecuteIncrementalAppend(vtkPolyData* output, vtkPolyData* inputs[], int numInputs);
+
+  // Remembers the output and the range taken by each input.
+  void RecordInputRanges(vtkPolyData* output, vtkPolyData* inputs[], int numInputs);
+
+  class vtkInternals;
+  std::unique_ptr<vtkInternals> Internals;
+
 private:
   vtkAppendPolyData(const vtkAppendPolyData&) = delete;
   void operator=(const vtkAppendPolyData&) = delete;
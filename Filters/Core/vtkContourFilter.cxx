@@ -37,6 +37,7 @@
 #include "vtkPolyDataNormals.h"
 #include "vtkRectilinearGrid.h"
 #include "vtkRectilinearSynchronizedTemplates.h"
+#include "vtkSmartPointer.h"
 #include "vtkSpanSpace.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStructuredGrid.h"
@@ -730,6 +731,35 @@ int vtkContourFilter::FillInputPortInformation(int, vtkInformation* info)
   return 1;
 }
 
+//------------------------------------------------------------------------------
+vtkAlgorithm* vtkContourFilter::NewConcurrentInstance()
+{
+  auto instance =
+    static_cast<vtkContourFilter*>(this->NewConcurrentInstanceOf("vtkContourFilter"));
+  if (instance)
+  {
+    instance->ContourValues->DeepCopy(this->ContourValues);
+    instance->ComputeNormals = this->ComputeNormals;
+    instance->ComputeGradients = this->ComputeGradients;
+    instance->ComputeScalars = this->ComputeScalars;
+    instance->UseScalarTree = this->UseScalarTree;
+    instance->OutputPointsPrecision = this->OutputPointsPrecision;
+    instance->GenerateTriangles = this->GenerateTriangles;
+    instance->SetArrayComponent(this->GetArrayComponent());
+    if (this->Locator)
+    {
+      auto locator = vtk::TakeSmartPointer(this->Locator->NewInstance());
+      locator->SetTolerance(this->Locator->GetTolerance());
+      instance->SetLocator(locator);
+    }
+    if (this->ScalarTree)
+    {
+      instance->SetScalarTree(vtk::TakeSmartPointer(this->ScalarTree->NewInstance()));
+    }
+  }
+  return instance;
+}
+
 void vtkContourFilter::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
@@ -202,6 +202,13 @@ public:
   int GetOutputPointsPrecision() const;
   ///@}
 
+  /**
+   * Return an instance with the same values and settings, see
+   * vtkAlgorithm::NewConcurrentInstance(). The instance gets its own point
+   * locator and scalar tree, of the classes of those of this filter.
+   */
+  vtkAlgorithm* NewConcurrentInstance() override;
+
 protected:
   vtkContourFilter();
   ~vtkContourFilter() override;
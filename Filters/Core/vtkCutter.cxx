@@ -1064,6 +1064,28 @@ int vtkCutter::FillInputPortInformation(int, vtkInformation* info)
   return 1;
 }
 
+//------------------------------------------------------------------------------
+vtkAlgorithm* vtkCutter::NewConcurrentInstance()
+{
+  auto instance = static_cast<vtkCutter*>(this->NewConcurrentInstanceOf("vtkCutter"));
+  if (instance)
+  {
+    instance->SetCutFunction(this->CutFunction);
+    instance->ContourValues->DeepCopy(this->ContourValues);
+    instance->SortBy = this->SortBy;
+    instance->GenerateCutScalars = this->GenerateCutScalars;
+    instance->GenerateTriangles = this->GenerateTriangles;
+    instance->OutputPointsPrecision = this->OutputPointsPrecision;
+    if (this->Locator)
+    {
+      auto locator = vtk::TakeSmartPointer(this->Locator->NewInstance());
+      locator->SetTolerance(this->Locator->GetTolerance());
+      instance->SetLocator(locator);
+    }
+  }
+  return instance;
+}
+
 //------------------------------------------------------------------------------
 void vtkCutter::PrintSelf(ostream& os, vtkIndent indent)
 {
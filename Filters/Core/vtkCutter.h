@@ -219,6 +219,13 @@ public:
   vtkGetMacro(OutputPointsPrecision, int);
   ///@}
 
+  /**
+   * Return an instance with the same cut function, values and settings, see
+   * vtkAlgorithm::NewConcurrentInstance(). The instance gets its own point
+   * locator, of the class of this one and with the same tolerance.
+   */
+  vtkAlgorithm* NewConcurrentInstance() override;
+
 protected:
   vtkCutter(vtkImplicitFunction* cf = nullptr);
   ~vtkCutter() override;
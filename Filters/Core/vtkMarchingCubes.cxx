@@ -32,6 +32,8 @@
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkShortArray.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStructuredPoints.h"
@@ -40,6 +42,10 @@
 #include "vtkUnsignedLongArray.h"
 #include "vtkUnsignedShortArray.h"
 
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
 vtkStandardNewMacro(vtkMarchingCubes);
 
 // Description:
@@ -372,6 +378,207 @@ struct ComputeGradientWorker
   }
 };
 
+// The points and triangles of one layer of cubes, between two slices. A point
+// is computed once for each edge and contour value, in the order in which the
+// serial march first uses it; the triangles refer to these points.
+struct MarchingCubesLayer
+{
+  std::vector<double> Points;
+  std::vector<double> Gradients;
+  std::vector<double> Values;
+  std::vector<int> Triangles;
+};
+
+//
+// Same march as ComputeGradientWorker, with the layers of cubes marched in
+// parallel. Inserting the points of the layers into the locator in order then
+// gives the same point ids as the serial march, which inserts every triangle
+// vertex, as long as the locator only merges identical points.
+//
+struct ThreadedComputeGradientWorker
+{
+  template <class ScalarArrayT>
+  void operator()(ScalarArrayT* scalarsArray, vtkMarchingCubes* self, int dims[3],
+    vtkIncrementalPointLocator* locator, vtkDataArray* newScalars, vtkDataArray* newGradients,
+    vtkDataArray* newNormals, vtkCellArray* newPolys, double* values, vtkIdType numValues) const
+  {
+    const auto scalars = vtk::DataArrayValueRange<1>(scalarsArray);
+    static const int edges[12][2] = { { 0, 1 }, { 1, 2 }, { 3, 2 }, { 0, 3 }, { 4, 5 }, { 5, 6 },
+      { 7, 6 }, { 4, 7 }, { 0, 4 }, { 1, 5 }, { 3, 7 }, { 2, 6 } };
+    // the offsets of the cube vertices
+    static const int vertices[8][3] = { { 0, 0, 0 }, { 1, 0, 0 }, { 1, 1, 0 }, { 0, 1, 0 },
+      { 0, 0, 1 }, { 1, 0, 1 }, { 1, 1, 1 }, { 0, 1, 1 } };
+    // the first vertex of each edge and its direction: x and y on the bottom
+    // face (0, 1), x and y on the top face (2, 3), and z (4)
+    static const int edgeSlots[12][3] = { { 0, 0, 0 }, { 1, 0, 1 }, { 0, 1, 0 }, { 0, 0, 1 },
+      { 0, 0, 2 }, { 1, 0, 3 }, { 0, 1, 2 }, { 0, 0, 3 }, { 0, 0, 4 }, { 1, 0, 4 }, { 0, 1, 4 },
+      { 1, 1, 4 } };
+    const bool needGradients = newGradients != nullptr || newNormals != nullptr;
+    int extent[6];
+    vtkInformation* inInfo = self->GetExecutive()->GetInputInformation(0, 0);
+    inInfo->Get(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(), extent);
+    vtkMarchingCubesTriangleCases* triCases = vtkMarchingCubesTriangleCases::GetCases();
+
+    if (numValues < 1)
+    {
+      return;
+    }
+    double min = values[0];
+    double max = values[0];
+    for (vtkIdType i = 1; i < numValues; i++)
+    {
+      min = std::min(min, values[i]);
+      max = std::max(max, values[i]);
+    }
+
+    const vtkIdType sliceSize = static_cast<vtkIdType>(dims[0]) * dims[1];
+    const int numLayers = dims[2] - 1;
+    std::vector<MarchingCubesLayer> layers(numLayers);
+    vtkSMPThreadLocal<std::vector<int>> localSlots;
+    vtkSMPTools::For(0, numLayers, 1, [&](int begin, int end) {
+      // the point of each edge and contour value, -1 until it is computed
+      std::vector<int>& slots = localSlots.Local();
+      slots.resize(5 * sliceSize * numValues, -1);
+      std::vector<vtkIdType> used;
+      double s[8], x[3], n[3], g[2][3];
+      for (int k = begin; k < end; k++)
+      {
+        MarchingCubesLayer& layer = layers[k];
+        for (int j = 0; j < dims[1] - 1 && !self->GetAbortExecute(); j++)
+        {
+          for (int i = 0; i < dims[0] - 1; i++)
+          {
+            const vtkIdType idx = i + j * dims[0] + k * sliceSize;
+            s[0] = scalars[idx];
+            s[1] = scalars[idx + 1];
+            s[2] = scalars[idx + 1 + dims[0]];
+            s[3] = scalars[idx + dims[0]];
+            s[4] = scalars[idx + sliceSize];
+            s[5] = scalars[idx + 1 + sliceSize];
+            s[6] = scalars[idx + 1 + dims[0] + sliceSize];
+            s[7] = scalars[idx + dims[0] + sliceSize];
+            if (std::all_of(s, s + 8, [min](double v) { return v < min; }) ||
+              std::all_of(s, s + 8, [max](double v) { return v > max; }))
+            {
+              continue; // no contours possible
+            }
+
+            for (vtkIdType contNum = 0; contNum < numValues; contNum++)
+            {
+              const double value = values[contNum];
+              int index = 0;
+              for (int ii = 0; ii < 8; ii++)
+              {
+                if (s[ii] >= value)
+                {
+                  index |= 1 << ii;
+                }
+              }
+              if (index == 0 || index == 255) // no surface
+              {
+                continue;
+              }
+              for (EDGE_LIST* edge = triCases[index].edges; *edge > -1; ++edge)
+              {
+                const int* slot = edgeSlots[*edge];
+                const vtkIdType slotId =
+                  ((static_cast<vtkIdType>(j + slot[1]) * dims[0] + i + slot[0]) * 5 + slot[2]) *
+                    numValues +
+                  contNum;
+                if (slots[slotId] < 0)
+                {
+                  slots[slotId] = static_cast<int>(layer.Values.size());
+                  used.push_back(slotId);
+
+                  // the same computation as in the serial march
+                  const int* vert = edges[*edge];
+                  const int* v0 = vertices[vert[0]];
+                  const int* v1 = vertices[vert[1]];
+                  const double t = (value - s[vert[0]]) / (s[vert[1]] - s[vert[0]]);
+                  const double x1[3] = { static_cast<double>(i + v0[0] + extent[0]),
+                    static_cast<double>(j + v0[1] + extent[2]),
+                    static_cast<double>(k + v0[2] + extent[4]) };
+                  const double x2[3] = { static_cast<double>(i + v1[0] + extent[0]),
+                    static_cast<double>(j + v1[1] + extent[2]),
+                    static_cast<double>(k + v1[2] + extent[4]) };
+                  x[0] = x1[0] + t * (x2[0] - x1[0]);
+                  x[1] = x1[1] + t * (x2[1] - x1[1]);
+                  x[2] = x1[2] + t * (x2[2] - x1[2]);
+                  layer.Points.insert(layer.Points.end(), x, x + 3);
+                  layer.Values.push_back(value);
+                  if (needGradients)
+                  {
+                    vtkMarchingCubesComputePointGradient(
+                      i + v0[0], j + v0[1], k + v0[2], scalars, dims, sliceSize, g[0]);
+                    vtkMarchingCubesComputePointGradient(
+                      i + v1[0], j + v1[1], k + v1[2], scalars, dims, sliceSize, g[1]);
+                    n[0] = g[0][0] + t * (g[1][0] - g[0][0]);
+                    n[1] = g[0][1] + t * (g[1][1] - g[0][1]);
+                    n[2] = g[0][2] + t * (g[1][2] - g[0][2]);
+                    layer.Gradients.insert(layer.Gradients.end(), n, n + 3);
+                  }
+                }
+                layer.Triangles.push_back(slots[slotId]);
+              }
+            } // for all contours
+          }   // for i
+        }     // for j
+        for (vtkIdType slotId : used)
+        {
+          slots[slotId] = -1;
+        }
+        used.clear();
+      } // for k
+    });
+
+    // Merge the points of the layers through the locator, and drop the
+    // triangles that become degenerate.
+    std::vector<vtkIdType> pointIds;
+    for (int k = 0; k < numLayers; k++)
+    {
+      self->UpdateProgress(k / static_cast<double>(numLayers));
+      if (self->GetAbortExecute())
+      {
+        break;
+      }
+      MarchingCubesLayer& layer = layers[k];
+      pointIds.resize(layer.Values.size());
+      for (size_t p = 0; p < layer.Values.size(); p++)
+      {
+        if (locator->InsertUniquePoint(&layer.Points[3 * p], pointIds[p]))
+        {
+          double* value = &layer.Values[p];
+          double* n = needGradients ? &layer.Gradients[3 * p] : nullptr;
+          if (newScalars)
+          {
+            newScalars->InsertTuple(pointIds[p], value);
+          }
+          if (newGradients)
+          {
+            newGradients->InsertTuple(pointIds[p], n);
+          }
+          if (newNormals)
+          {
+            vtkMath::Normalize(n);
+            newNormals->InsertTuple(pointIds[p], n);
+          }
+        }
+      }
+      for (size_t tri = 0; tri < layer.Triangles.size(); tri += 3)
+      {
+        const vtkIdType ptIds[3] = { pointIds[layer.Triangles[tri]],
+          pointIds[layer.Triangles[tri + 1]], pointIds[layer.Triangles[tri + 2]] };
+        // check for degenerate triangle
+        if (ptIds[0] != ptIds[1] && ptIds[0] != ptIds[2] && ptIds[1] != ptIds[2])
+        {
+          newPolys->InsertNextCell(3, ptIds);
+        }
+      }
+      layer = MarchingCubesLayer();
+    }
+  }
+};
+
 } // end anon namespace
 
 //
@@ -499,13 +706,28 @@ int vtkMarchingCubes::RequestData(vtkInformation* vtkNotUsed(request),
     newScalars = nullptr;
   }
 
+  // The layers of cubes are marched in parallel unless a custom locator
+  // decides how the points merge, then they are inserted in order.
   using Dispatcher = vtkArrayDispatch::Dispatch;
-  ComputeGradientWorker worker;
-  if (!Dispatcher::Execute(inScalars, worker, this, dims, this->Locator, newScalars, newGradients,
-        newNormals, newPolys, values, numContours))
-  { // Fallback to slow path for unknown arrays:
-    worker(inScalars, this, dims, this->Locator, newScalars, newGradients, newNormals, newPolys,
-      values, numContours);
+  if (strcmp(this->Locator->GetClassName(), "vtkMergePoints") == 0)
+  {
+    ThreadedComputeGradientWorker worker;
+    if (!Dispatcher::Execute(inScalars, worker, this, dims, this->Locator, newScalars,
+          newGradients, newNormals, newPolys, values, numContours))
+    { // Fallback to slow path for unknown arrays:
+      worker(inScalars, this, dims, this->Locator, newScalars, newGradients, newNormals, newPolys,
+        values, numContours);
+    }
+  }
+  else
+  {
+    ComputeGradientWorker worker;
+    if (!Dispatcher::Execute(inScalars, worker, this, dims, this->Locator, newScalars,
+          newGradients, newNormals, newPolys, values, numContours))
+    { // Fallback to slow path for unknown arrays:
+      worker(inScalars, this, dims, this->Locator, newScalars, newGradients, newNormals, newPolys,
+        values, numContours);
+    }
   }
 
   vtkDebugMacro(<< "Created: " << newPts->GetNumberOfPoints() << " points, "
@@ -22,6 +22,12 @@
  * Alternatively, you can specify a min/max scalar range and the number of
  * contours to generate a series of evenly spaced contour values.
  *
+ * With the default vtkMergePoints locator, the layers of cubes between
+ * consecutive slices are marched in parallel with vtkSMPTools, and their
+ * points are then merged through the locator in the order of a serial march,
+ * so the output is the same whatever the number of threads. Other locators,
+ * including subclasses of vtkMergePoints, get the serial march.
+ *
  * @warning
  * This filter is specialized to volumes. If you are interested in
  * contouring other types of data, use the general vtkContourFilter. If you
@@ -112,7 +118,8 @@ public:
   ///@{
   /**
    * override the default locator.  Useful for changing the number of
-   * bins for performance or specifying a more aggressive locator.
+   * bins for performance or specifying a more aggressive locator. Only a
+   * vtkMergePoints keeps the march parallel.
    */
   void SetLocator(vtkIncrementalPointLocator* locator);
   vtkGetObjectMacro(Locator, vtkIncrementalPointLocator);
@@ -473,6 +473,26 @@ int vtkThreshold::FillInputPortInformation(int, vtkInformation* info)
   return 1;
 }
 
+//------------------------------------------------------------------------------
+vtkAlgorithm* vtkThreshold::NewConcurrentInstance()
+{
+  auto instance = static_cast<vtkThreshold*>(this->NewConcurrentInstanceOf("vtkThreshold"));
+  if (instance)
+  {
+    instance->LowerThreshold = this->LowerThreshold;
+    instance->UpperThreshold = this->UpperThreshold;
+    instance->ThresholdFunction = this->ThresholdFunction;
+    instance->AllScalars = this->AllScalars;
+    instance->UseContinuousCellRange = this->UseContinuousCellRange;
+    instance->Invert = this->Invert;
+    instance->AttributeMode = this->AttributeMode;
+    instance->ComponentMode = this->ComponentMode;
+    instance->SelectedComponent = this->SelectedComponent;
+    instance->OutputPointsPrecision = this->OutputPointsPrecision;
+  }
+  return instance;
+}
+
 void vtkThreshold::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
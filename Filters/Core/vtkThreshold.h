@@ -237,6 +237,13 @@ public:
   int Upper(double s) const;
   int Between(double s) const;
   ///@}
+
+  /**
+   * Return an instance with the same thresholds and settings, see
+   * vtkAlgorithm::NewConcurrentInstance().
+   */
+  vtkAlgorithm* NewConcurrentInstance() override;
+
 protected:
   vtkThreshold();
   ~vtkThreshold() override;
@@ -0,0 +1,183 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestImageMarchingCubesThreads.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Contours two nested ellipsoids with vtkImageMarchingCubes on several threads
+// and with several input memory limits, and checks that the output does not
+// depend on the number of chunks, that no point is duplicated, and that the
+// surfaces are closed.
+
+#include "vtkCellArray.h"
+#include "vtkDataArray.h"
+#include "vtkIdList.h"
+#include "vtkImageMarchingCubes.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkRTAnalyticSource.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <map>
+#include <set>
+#include <utility>
+
+namespace
+{
+// Compare the points, triangles and point data of two outputs.
+bool SameOutput(vtkPolyData* a, vtkPolyData* b)
+{
+  if (a->GetNumberOfPoints() != b->GetNumberOfPoints() ||
+    a->GetNumberOfPolys() != b->GetNumberOfPolys())
+  {
+    return false;
+  }
+  for (vtkIdType i = 0; i < a->GetNumberOfPoints(); ++i)
+  {
+    double p[3], q[3];
+    a->GetPoint(i, p);
+    b->GetPoint(i, q);
+    if (p[0] != q[0] || p[1] != q[1] || p[2] != q[2])
+    {
+      return false;
+    }
+  }
+  vtkNew<vtkIdList> cellA;
+  vtkNew<vtkIdList> cellB;
+  for (vtkIdType i = 0; i < a->GetNumberOfPolys(); ++i)
+  {
+    a->GetPolys()->GetCellAtId(i, cellA);
+    b->GetPolys()->GetCellAtId(i, cellB);
+    for (vtkIdType j = 0; j < 3; ++j)
+    {
+      if (cellA->GetId(j) != cellB->GetId(j))
+      {
+        return false;
+      }
+    }
+  }
+  for (int i = 0; i < a->GetPointData()->GetNumberOfArrays(); ++i)
+  {
+    vtkDataArray* arrayA = a->GetPointData()->GetArray(i);
+    vtkDataArray* arrayB = b->GetPointData()->GetArray(i);
+    for (vtkIdType j = 0; j < arrayA->GetNumberOfValues(); ++j)
+    {
+      int c = arrayA->GetNumberOfComponents();
+      if (arrayA->GetComponent(j / c, j % c) != arrayB->GetComponent(j / c, j % c))
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+}
+
+int TestImageMarchingCubesThreads(int, char*[])
+{
+  vtkSMPTools::Initialize(4);
+
+  // a gaussian, contoured at two levels that give nested closed surfaces
+  vtkNew<vtkRTAnalyticSource> source;
+  source->SetWholeExtent(-12, 14, -10, 13, -11, 12);
+  source->SetCenter(1.3, 0.6, -0.4);
+  source->SetStandardDeviation(0.25);
+  source->SetXMag(0.0);
+  source->SetYMag(0.0);
+  source->SetZMag(0.0);
+
+  vtkNew<vtkImageMarchingCubes> reference;
+  reference->SetInputConnection(source->GetOutputPort());
+  reference->SetValue(0, 60.0);
+  reference->SetValue(1, 180.0);
+  reference->ComputeGradientsOn();
+  reference->Update();
+  vtkPolyData* output = reference->GetOutput();
+
+  // the gradients are stored as vectors, and the normals have unit length
+  vtkDataArray* gradients = output->GetPointData()->GetVectors();
+  vtkDataArray* normals = output->GetPointData()->GetNormals();
+  if (!gradients || gradients->GetNumberOfTuples() != output->GetNumberOfPoints() || !normals)
+  {
+    cerr << "The gradients are missing\n";
+    return EXIT_FAILURE;
+  }
+  for (vtkIdType i = 0; i < output->GetNumberOfPoints(); ++i)
+  {
+    double n[3];
+    normals->GetTuple(i, n);
+    if (std::fabs(n[0] * n[0] + n[1] * n[1] + n[2] * n[2] - 1.0) > 1e-5)
+    {
+      cerr << "Normal " << i << " does not have unit length\n";
+      return EXIT_FAILURE;
+    }
+  }
+
+  // no point is duplicated
+  std::set<std::array<double, 3>> points;
+  for (vtkIdType i = 0; i < output->GetNumberOfPoints(); ++i)
+  {
+    std::array<double, 3> p;
+    output->GetPoint(i, p.data());
+    if (!points.insert(p).second)
+    {
+      cerr << "Point " << i << " is duplicated\n";
+      return EXIT_FAILURE;
+    }
+  }
+
+  // every edge is shared by exactly two triangles
+  std::map<std::pair<vtkIdType, vtkIdType>, int> edges;
+  vtkNew<vtkIdList> cell;
+  for (vtkIdType i = 0; i < output->GetNumberOfPolys(); ++i)
+  {
+    output->GetPolys()->GetCellAtId(i, cell);
+    for (vtkIdType j = 0; j < 3; ++j)
+    {
+      vtkIdType a = cell->GetId(j);
+      vtkIdType b = cell->GetId((j + 1) % 3);
+      ++edges[std::make_pair(std::min(a, b), std::max(a, b))];
+    }
+  }
+  for (const auto& edge : edges)
+  {
+    if (edge.second != 2)
+    {
+      cerr << "Edge (" << edge.first.first << ", " << edge.first.second << ") is used by "
+           << edge.second << " triangles\n";
+      return EXIT_FAILURE;
+    }
+  }
+
+  // the output does not depend on the size of the chunks
+  for (vtkIdType limit : { 1, 5, 20 })
+  {
+    vtkNew<vtkImageMarchingCubes> streamed;
+    streamed->SetInputConnection(source->GetOutputPort());
+    streamed->SetValue(0, 60.0);
+    streamed->SetValue(1, 180.0);
+    streamed->ComputeGradientsOn();
+    streamed->SetInputMemoryLimit(limit);
+    streamed->Update();
+    if (!SameOutput(output, streamed->GetOutput()))
+    {
+      cerr << "The output with an InputMemoryLimit of " << limit << " is different\n";
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,310 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestThreadedCompositeDataPipelineFilters.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Executes the filters that support vtkThreadedCompositeDataPipeline on the
+// leaves of a vtkMultiBlockDataSet and of a vtkPartitionedDataSetCollection,
+// and checks that the outputs match those of vtkCompositeDataPipeline.
+
+#include "vtkCompositeDataPipeline.h"
+#include "vtkContourFilter.h"
+#include "vtkCutter.h"
+#include "vtkDataArray.h"
+#include "vtkDataObjectTreeIterator.h"
+#include "vtkDataSet.h"
+#include "vtkDataSetSurfaceFilter.h"
+#include "vtkDataSetTriangleFilter.h"
+#include "vtkGradientFilter.h"
+#include "vtkImageData.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPartitionedDataSet.h"
+#include "vtkPartitionedDataSetCollection.h"
+#include "vtkPlane.h"
+#include "vtkPointData.h"
+#include "vtkRTAnalyticSource.h"
+#include "vtkSmartPointer.h"
+#include "vtkTableBasedClipDataSet.h"
+#include "vtkThreadedCompositeDataPipeline.h"
+#include "vtkThreshold.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace
+{
+const int NumberOfLeaves = 24;
+
+// A subclass may have parameters of its own, so it is not supported.
+class DerivedCutter : public vtkCutter
+{
+public:
+  static DerivedCutter* New();
+  vtkTypeMacro(DerivedCutter, vtkCutter);
+};
+vtkStandardNewMacro(DerivedCutter);
+
+// Small image and unstructured leaves, each from a different region of the
+// analytic source.
+vtkSmartPointer<vtkDataSet> MakeLeaf(int index)
+{
+  vtkNew<vtkRTAnalyticSource> source;
+  int x = 4 * (index % 4) - 8;
+  int y = 4 * ((index / 4) % 4) - 8;
+  source->SetWholeExtent(x, x + 5, y, y + 5, -3, 3);
+  if (index % 2)
+  {
+    vtkNew<vtkDataSetTriangleFilter> tetrahedralize;
+    tetrahedralize->SetInputConnection(source->GetOutputPort());
+    tetrahedralize->Update();
+    return tetrahedralize->GetOutput();
+  }
+  source->Update();
+  return source->GetOutput();
+}
+
+vtkSmartPointer<vtkDataObject> MakeMultiBlock()
+{
+  vtkNew<vtkMultiBlockDataSet> leaves;
+  vtkNew<vtkMultiBlockDataSet> input;
+  for (int i = 0; i < NumberOfLeaves; ++i)
+  {
+    leaves->SetBlock(i, MakeLeaf(i));
+  }
+  input->SetBlock(0, leaves);
+  input->SetBlock(1, MakeLeaf(NumberOfLeaves));
+  return input;
+}
+
+vtkSmartPointer<vtkDataObject> MakePartitionedCollection()
+{
+  vtkNew<vtkPartitionedDataSetCollection> input;
+  for (int i = 0; i < NumberOfLeaves / 4; ++i)
+  {
+    vtkNew<vtkPartitionedDataSet> partitioned;
+    for (int j = 0; j < 4; ++j)
+    {
+      partitioned->SetPartition(j, MakeLeaf(4 * i + j));
+    }
+    input->SetPartitionedDataSet(i, partitioned);
+  }
+  return input;
+}
+
+bool CompareArrays(vtkDataArray* expected, vtkDataArray* actual)
+{
+  if (!actual || expected->GetNumberOfTuples() != actual->GetNumberOfTuples() ||
+    expected->GetNumberOfComponents() != actual->GetNumberOfComponents())
+  {
+    return false;
+  }
+  for (vtkIdType i = 0; i < expected->GetNumberOfValues(); ++i)
+  {
+    int numberOfComponents = expected->GetNumberOfComponents();
+    if (expected->GetComponent(i / numberOfComponents, i % numberOfComponents) !=
+      actual->GetComponent(i / numberOfComponents, i % numberOfComponents))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool CompareLeaves(vtkDataObject* expected, vtkDataObject* actual)
+{
+  if (!expected || !actual)
+  {
+    return expected == actual;
+  }
+  if (strcmp(expected->GetClassName(), actual->GetClassName()) != 0)
+  {
+    cerr << "Leaf of type " << actual->GetClassName() << " instead of "
+         << expected->GetClassName() << "\n";
+    return false;
+  }
+  vtkDataSet* expectedSet = vtkDataSet::SafeDownCast(expected);
+  vtkDataSet* actualSet = vtkDataSet::SafeDownCast(actual);
+  if (expectedSet->GetNumberOfPoints() != actualSet->GetNumberOfPoints() ||
+    expectedSet->GetNumberOfCells() != actualSet->GetNumberOfCells())
+  {
+    cerr << "Leaf with " << actualSet->GetNumberOfPoints() << " points and "
+         << actualSet->GetNumberOfCells() << " cells instead of "
+         << expectedSet->GetNumberOfPoints() << " and " << expectedSet->GetNumberOfCells() << "\n";
+    return false;
+  }
+  for (vtkIdType i = 0; i < expectedSet->GetNumberOfPoints(); ++i)
+  {
+    double expectedPoint[3], actualPoint[3];
+    expectedSet->GetPoint(i, expectedPoint);
+    actualSet->GetPoint(i, actualPoint);
+    if (expectedPoint[0] != actualPoint[0] || expectedPoint[1] != actualPoint[1] ||
+      expectedPoint[2] != actualPoint[2])
+    {
+      cerr << "Point " << i << " differs\n";
+      return false;
+    }
+  }
+  vtkPointData* expectedData = expectedSet->GetPointData();
+  for (int i = 0; i < expectedData->GetNumberOfArrays(); ++i)
+  {
+    vtkDataArray* array = expectedData->GetArray(i);
+    if (array && !CompareArrays(array, actualSet->GetPointData()->GetArray(array->GetName())))
+    {
+      cerr << "Point array " << array->GetName() << " differs\n";
+      return false;
+    }
+  }
+  return true;
+}
+
+bool CompareOutputs(vtkDataObject* expected, vtkDataObject* actual)
+{
+  if (!expected || !actual || strcmp(expected->GetClassName(), actual->GetClassName()) != 0)
+  {
+    cerr << "Composite output missing or of the wrong type\n";
+    return false;
+  }
+  auto expectedIter =
+    vtk::TakeSmartPointer(vtkDataObjectTree::SafeDownCast(expected)->NewTreeIterator());
+  auto actualIter =
+    vtk::TakeSmartPointer(vtkDataObjectTree::SafeDownCast(actual)->NewTreeIterator());
+  expectedIter->SkipEmptyNodesOff();
+  actualIter->SkipEmptyNodesOff();
+  int leaves = 0;
+  for (expectedIter->InitTraversal(), actualIter->InitTraversal();
+       !expectedIter->IsDoneWithTraversal();
+       expectedIter->GoToNextItem(), actualIter->GoToNextItem(), ++leaves)
+  {
+    if (actualIter->IsDoneWithTraversal() ||
+      !CompareLeaves(expectedIter->GetCurrentDataObject(), actualIter->GetCurrentDataObject()))
+    {
+      cerr << "Leaf " << leaves << " differs\n";
+      return false;
+    }
+  }
+  if (!actualIter->IsDoneWithTraversal() || leaves == 0)
+  {
+    cerr << "Unexpected number of leaves\n";
+    return false;
+  }
+  return true;
+}
+
+using FilterFactory = std::function<vtkSmartPointer<vtkAlgorithm>()>;
+
+bool TestFilter(const std::string& name, const FilterFactory& factory, vtkDataObject* input)
+{
+  vtkSmartPointer<vtkAlgorithm> serial = factory();
+  vtkSmartPointer<vtkAlgorithm> threaded = factory();
+  vtkSmartPointer<vtkAlgorithm> instance = vtk::TakeSmartPointer(threaded->NewConcurrentInstance());
+  if (!instance)
+  {
+    cerr << name << " does not support concurrent instances\n";
+    return false;
+  }
+
+  vtkNew<vtkCompositeDataPipeline> serialExecutive;
+  vtkNew<vtkThreadedCompositeDataPipeline> threadedExecutive;
+  serial->SetExecutive(serialExecutive);
+  threaded->SetExecutive(threadedExecutive);
+  serial->SetInputDataObject(input);
+  threaded->SetInputDataObject(input);
+  serial->Update();
+  threaded->Update();
+
+  for (int port = 0; port < serial->GetNumberOfOutputPorts(); ++port)
+  {
+    if (!CompareOutputs(serial->GetOutputDataObject(port), threaded->GetOutputDataObject(port)))
+    {
+      cerr << name << ": output " << port << " of " << input->GetClassName() << " differs\n";
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int TestThreadedCompositeDataPipelineFilters(int, char*[])
+{
+  vtkNew<vtkPlane> plane;
+  plane->SetOrigin(0.5, -0.5, 0.25);
+  plane->SetNormal(1.0, 1.0, 0.5);
+
+  std::vector<std::pair<std::string, FilterFactory>> filters;
+  filters.emplace_back("vtkCutter", [&]() {
+    vtkNew<vtkCutter> cutter;
+    cutter->SetCutFunction(plane);
+    cutter->SetValue(0, 0.0);
+    cutter->SetValue(1, 2.0);
+    return vtkSmartPointer<vtkAlgorithm>(cutter);
+  });
+  filters.emplace_back("vtkContourFilter", []() {
+    vtkNew<vtkContourFilter> contour;
+    contour->SetInputArrayToProcess(0, 0, 0, vtkDataObject::FIELD_ASSOCIATION_POINTS, "RTData");
+    contour->SetValue(0, 120.0);
+    contour->SetValue(1, 180.0);
+    contour->ComputeScalarsOn();
+    return vtkSmartPointer<vtkAlgorithm>(contour);
+  });
+  filters.emplace_back("vtkThreshold", []() {
+    vtkNew<vtkThreshold> threshold;
+    threshold->SetInputArrayToProcess(0, 0, 0, vtkDataObject::FIELD_ASSOCIATION_POINTS, "RTData");
+    threshold->SetLowerThreshold(100.0);
+    threshold->SetUpperThreshold(200.0);
+    threshold->SetThresholdFunction(vtkThreshold::THRESHOLD_BETWEEN);
+    return vtkSmartPointer<vtkAlgorithm>(threshold);
+  });
+  filters.emplace_back("vtkTableBasedClipDataSet", [&]() {
+    vtkNew<vtkTableBasedClipDataSet> clip;
+    clip->SetClipFunction(plane);
+    clip->GenerateClippedOutputOn();
+    return vtkSmartPointer<vtkAlgorithm>(clip);
+  });
+  filters.emplace_back("vtkDataSetSurfaceFilter", []() {
+    vtkNew<vtkDataSetSurfaceFilter> surface;
+    surface->PassThroughPointIdsOn();
+    return vtkSmartPointer<vtkAlgorithm>(surface);
+  });
+  filters.emplace_back("vtkGradientFilter", []() {
+    vtkNew<vtkGradientFilter> gradient;
+    gradient->SetInputArrayToProcess(0, 0, 0, vtkDataObject::FIELD_ASSOCIATION_POINTS, "RTData");
+    return vtkSmartPointer<vtkAlgorithm>(gradient);
+  });
+
+  vtkNew<DerivedCutter> derived;
+  vtkSmartPointer<vtkAlgorithm> derivedInstance =
+    vtk::TakeSmartPointer(derived->NewConcurrentInstance());
+  if (derivedInstance)
+  {
+    cerr << "A subclass of vtkCutter returned a concurrent instance\n";
+    return EXIT_FAILURE;
+  }
+
+  std::vector<vtkSmartPointer<vtkDataObject>> inputs = { MakeMultiBlock(),
+    MakePartitionedCollection() };
+  for (const auto& input : inputs)
+  {
+    for (const auto& filter : filters)
+    {
+      if (!TestFilter(filter.first, filter.second, input))
+      {
+        return EXIT_FAILURE;
+      }
+    }
+  }
+  return EXIT_SUCCESS;
+}
@@ -186,6 +186,28 @@ vtkGradientFilter::~vtkGradientFilter()
   this->SetQCriterionArrayName(nullptr);
 }
 
+//------------------------------------------------------------------------------
+vtkAlgorithm* vtkGradientFilter::NewConcurrentInstance()
+{
+  auto instance =
+    static_cast<vtkGradientFilter*>(this->NewConcurrentInstanceOf("vtkGradientFilter"));
+  if (instance)
+  {
+    instance->SetResultArrayName(this->ResultArrayName);
+    instance->SetDivergenceArrayName(this->DivergenceArrayName);
+    instance->SetVorticityArrayName(this->VorticityArrayName);
+    instance->SetQCriterionArrayName(this->QCriterionArrayName);
+    instance->FasterApproximation = this->FasterApproximation;
+    instance->ComputeGradient = this->ComputeGradient;
+    instance->ComputeDivergence = this->ComputeDivergence;
+    instance->ComputeQCriterion = this->ComputeQCriterion;
+    instance->ComputeVorticity = this->ComputeVorticity;
+    instance->ContributingCellOption = this->ContributingCellOption;
+    instance->ReplacementValueOption = this->ReplacementValueOption;
+  }
+  return instance;
+}
+
 //------------------------------------------------------------------------------
 void vtkGradientFilter::PrintSelf(ostream& os, vtkIndent indent)
 {
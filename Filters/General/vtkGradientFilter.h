@@ -212,6 +212,12 @@ public:
   vtkGetMacro(ReplacementValueOption, int);
   ///@}
 
+  /**
+   * Return an instance computing the same quantities with the same settings,
+   * see vtkAlgorithm::NewConcurrentInstance().
+   */
+  vtkAlgorithm* NewConcurrentInstance() override;
+
 protected:
   vtkGradientFilter();
   ~vtkGradientFilter() override;
@@ -17,6 +17,7 @@
 #include "vtkCellArray.h"
 #include "vtkCommand.h"
 #include "vtkFloatArray.h"
+#include "vtkIdTypeArray.h"
 #include "vtkImageData.h"
 #include "vtkImageTransform.h"
 #include "vtkInformation.h"
@@ -26,11 +27,61 @@
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
+
+#include <algorithm>
 #include <cmath>
+#include <utility>
+#include <vector>
 
 vtkStandardNewMacro(vtkImageMarchingCubes);
 
+//------------------------------------------------------------------------------
+namespace
+{
+// The points and triangles of one layer of cubes, between two slices.
+// The points are numbered in the order in which they are first used, as
+// in a serial march, and those on the bottom face are then matched with
+// the points on the top face of the layer below.
+struct vtkImageMarchingCubesLayer
+{
+  std::vector<float> Points;
+  std::vector<float> Scalars;
+  std::vector<float> Gradients;
+  std::vector<float> Normals;
+  std::vector<vtkIdType> Triangles;
+
+  // the face keys and local ids of the points on the bottom and top faces
+  std::vector<std::pair<vtkIdType, vtkIdType>> Bottom;
+  std::vector<std::pair<vtkIdType, vtkIdType>> Top;
+
+  // the rank of each point among the new points of the layer, or -2 - the
+  // local id in the layer below for the points that come from there
+  std::vector<vtkIdType> Rank;
+  vtkIdType NumberOfNewPoints = 0;
+  vtkIdType PointOffset = 0;
+  vtkIdType TriangleOffset = 0;
+
+  vtkIdType GetNumberOfPoints() const { return static_cast<vtkIdType>(this->Scalars.size()); }
+};
+}
+
+//------------------------------------------------------------------------------
+// The state that is kept from one chunk to the next.
+class vtkImageMarchingCubes::vtkInternals
+{
+public:
+  // the top layer of the previous chunk
+  vtkImageMarchingCubesLayer Previous;
+  bool HasPrevious = false;
+
+  vtkSmartPointer<vtkIdTypeArray> Connectivity;
+  vtkSMPThreadLocal<std::vector<vtkIdType>> Locators;
+};
+
 //------------------------------------------------------------------------------
 // Description:
 // Construct object with initial range (0,1) and single contour value
@@ -44,6 +95,8 @@ vtkImageMarchingCubes::vtkImageMarchingCubes()
 
   this->LocatorPointIds = nullptr;
   this->InputMemoryLimit = 10240; // 10 mega Bytes
+
+  this->Internals = nullptr;
 }
 
 vtkImageMarchingCubes::~vtkImageMarchingCubes()
@@ -161,7 +214,6 @@ int vtkImageMarchingCubes::RequestData(vtkInformation* vtkNotUsed(request),
   this->Points = vtkPoints::New();
   this->Points->Allocate(estimatedSize, estimatedSize / 2);
   this->Triangles = vtkCellArray::New();
-  this->Triangles->AllocateEstimate(estimatedSize, 1);
   if (this->ComputeScalars)
   {
     this->Scalars = vtkFloatArray::New();
@@ -180,8 +232,11 @@ int vtkImageMarchingCubes::RequestData(vtkInformation* vtkNotUsed(request),
     this->Gradients->Allocate(3 * estimatedSize, 3 * estimatedSize / 2);
   }
 
-  // Initialize the internal point locator (edge table for one image of cubes).
-  this->InitializeLocator(extent[0], extent[1], extent[2], extent[3]);
+  // The point ids of the triangles, and the layer of cubes that each chunk
+  // shares with the next one.
+  this->Internals = new vtkInternals;
+  this->Internals->Connectivity = vtkSmartPointer<vtkIdTypeArray>::New();
+  this->Internals->Connectivity->Allocate(3 * estimatedSize);
 
   // Loop through the chunks running marching cubes on each one
   int zMin = extent[4];
@@ -229,6 +284,9 @@ int vtkImageMarchingCubes::RequestData(vtkInformation* vtkNotUsed(request),
   }
 
   // Put results in our output
+  this->Triangles->SetData(3, this->Internals->Connectivity);
+  delete this->Internals;
+  this->Internals = nullptr;
   vtkDebugMacro(<< "Created: " << this->Points->GetNumberOfPoints() << " points, "
                 << this->Triangles->GetNumberOfCells() << " triangles");
   output->SetPoints(this->Points);
@@ -250,15 +308,18 @@ int vtkImageMarchingCubes::RequestData(vtkInformation* vtkNotUsed(request),
     this->Normals->Delete();
     this->Normals = nullptr;
   }
+  if (this->ComputeGradients)
+  {
+    output->GetPointData()->SetVectors(this->Gradients);
+    this->Gradients->Delete();
+    this->Gradients = nullptr;
+  }
 
   // Recover extra space.
   output->Squeeze();
 
   vtkImageTransform::TransformPointSet(inData, output);
 
-  // release the locators memory
-  this->DeleteLocator();
-
   return 1;
 }
 
@@ -315,11 +376,86 @@ void vtkImageMarchingCubesComputePointGradient(
 }
 
 //------------------------------------------------------------------------------
-// This method interpolates vertices to make a new point.
+namespace
+{
+// The index of the locator entry for an edge of a cube, relative to the
+// locator minimum.  Cubes own the edges on their min faces, and the five
+// entries of a cube are for the bottom x edge (0), the top y edge (1), the
+// z edge (2), the bottom y edge (3), and the top x edge (4).
+inline vtkIdType vtkImageMarchingCubesLocatorIndex(int cellX, int cellY, int edge, int dimX)
+{
+  // Remove redundant edges (shared by more than one cube).
+  switch (edge)
+  {
+    case 9:
+      ++cellX;
+      edge = 8;
+      break;
+    case 10:
+      ++cellY;
+      edge = 8;
+      break;
+    case 11:
+      ++cellX;
+      ++cellY;
+      edge = 8;
+      break;
+    case 5:
+      ++cellX;
+      edge = 7;
+      break;
+    case 6:
+      ++cellY;
+      edge = 4;
+      break;
+    case 1:
+      ++cellX;
+      edge = 3;
+      break;
+    case 2:
+      ++cellY;
+      edge = 0;
+      break;
+  }
+
+  // compute new indexes for edges (0 to 4)
+  // must be compatible with IncrementLocatorZ.
+  if (edge == 7)
+  {
+    edge = 1;
+  }
+  if (edge == 8)
+  {
+    edge = 2;
+  }
+
+  return edge + (cellX + cellY * static_cast<vtkIdType>(dimX)) * 5;
+}
+
+// The settings that are shared by all the layers of cubes.
+struct vtkImageMarchingCubesParameters
+{
+  vtkImageMarchingCubes* Self;
+  int NumberOfContours;
+  const double* Values;
+  int WholeExtent[6];
+  int Extent[6];
+  vtkIdType Increments[3];
+  int LocatorDimX;
+  int LocatorDimY;
+};
+
+// This method interpolates vertices to make a new point, which is added
+// to the layer.
 template <class T>
-int vtkImageMarchingCubesMakeNewPoint(vtkImageMarchingCubes* self, int idx0, int idx1, int idx2,
-  int inc0, int inc1, int inc2, T* ptr, int edge, int* imageExtent, double value)
+void vtkImageMarchingCubesMakeNewPoint(const vtkImageMarchingCubesParameters& params,
+  vtkImageMarchingCubesLayer& layer, int idx0, int idx1, int idx2, T* ptr, int edge, double value)
 {
+  vtkImageMarchingCubes* self = params.Self;
+  const int* imageExtent = params.WholeExtent;
+  vtkIdType inc0 = params.Increments[0];
+  vtkIdType inc1 = params.Increments[1];
+  vtkIdType inc2 = params.Increments[2];
   int edgeAxis = 0;
   T* ptrB = nullptr;
   double temp, pt[3];
@@ -402,30 +538,15 @@ int vtkImageMarchingCubesMakeNewPoint(vtkImageMarchingCubes* self, int idx0, int
   temp = (value - *ptr) / (*ptrB - *ptr);
 
   // interpolate the point position
-  switch (edgeAxis)
-  {
-    case 0:
-      pt[0] = (double)idx0 + temp;
-      pt[1] = (double)idx1;
-      pt[2] = (double)idx2;
-      break;
-    case 1:
-      pt[0] = (double)idx0;
-      pt[1] = (double)idx1 + temp;
-      pt[2] = (double)idx2;
-      break;
-    case 2:
-      pt[0] = (double)idx0;
-      pt[1] = (double)idx1;
-      pt[2] = (double)idx2 + temp;
-      break;
-  }
+  pt[0] = idx0;
+  pt[1] = idx1;
+  pt[2] = idx2;
+  pt[edgeAxis] += temp;
+  layer.Points.insert(layer.Points.end(),
+    { static_cast<float>(pt[0]), static_cast<float>(pt[1]), static_cast<float>(pt[2]) });
 
-  // Save the scale if we are generating scalars
-  if (self->ComputeScalars)
-  {
-    self->Scalars->InsertNextValue(value);
-  }
+  // Save the value, even if we are not generating scalars, to count points
+  layer.Scalars.push_back(static_cast<float>(value));
 
   // Interpolate to find normal from vectors.
   if (self->NeedGradients)
@@ -472,157 +593,265 @@ int vtkImageMarchingCubesMakeNewPoint(vtkImageMarchingCubes* self, int idx0, int
     g[2] = g[2] + temp * (gB[2] - g[2]);
     if (self->ComputeGradients)
     {
-      self->Gradients->InsertNextTuple(g);
+      layer.Gradients.insert(layer.Gradients.end(),
+        { static_cast<float>(g[0]), static_cast<float>(g[1]), static_cast<float>(g[2]) });
     }
     if (self->ComputeNormals)
     {
       temp = -1.0 / sqrt(g[0] * g[0] + g[1] * g[1] + g[2] * g[2]);
-      g[0] *= temp;
-      g[1] *= temp;
-      g[2] *= temp;
-      self->Normals->InsertNextTuple(g);
+      layer.Normals.insert(layer.Normals.end(),
+        { static_cast<float>(g[0] * temp), static_cast<float>(g[1] * temp),
+          static_cast<float>(g[2] * temp) });
     }
   }
-
-  return self->Points->InsertNextPoint(pt);
 }
 
-//------------------------------------------------------------------------------
-// This method runs marching cubes on one cube.
+// This method runs marching cubes on one layer of cubes, with a locator
+// that is filled with -1 and that is left that way.
 template <class T>
-void vtkImageMarchingCubesHandleCube(vtkImageMarchingCubes* self, int cellX, int cellY, int cellZ,
-  vtkImageData* inData, T* ptr, int numContours, double* values)
+void vtkImageMarchingCubesMarchLayer(const vtkImageMarchingCubesParameters& params, T* ptr2,
+  int idx2, vtkImageMarchingCubesLayer& layer, std::vector<vtkIdType>& locator)
 {
-  vtkIdType inc0, inc1, inc2;
-  int valueIdx;
-  double value;
-  int cubeIndex, ii;
-  vtkIdType pointIds[3];
-  vtkMarchingCubesTriangleCases *triCase, *triCases;
-
-  vtkInformation* inInfo = self->GetExecutive()->GetInputInformation(0, 0);
+  int min0 = params.Extent[0];
+  int max0 = params.Extent[1];
+  int min1 = params.Extent[2];
+  int max1 = params.Extent[3];
+  vtkIdType inc0 = params.Increments[0];
+  vtkIdType inc1 = params.Increments[1];
+  vtkIdType inc2 = params.Increments[2];
+  vtkMarchingCubesTriangleCases* triCases = vtkMarchingCubesTriangleCases::GetCases();
+  std::vector<vtkIdType> used;
+
+  T* ptr1 = ptr2;
+  for (int idx1 = min1; idx1 < max1 && !params.Self->GetAbortExecute(); ++idx1)
+  {
+    T* ptr = ptr1;
+    for (int idx0 = min0; idx0 < max0; ++idx0)
+    {
+      for (int valueIdx = 0; valueIdx < params.NumberOfContours; ++valueIdx)
+      {
+        double value = params.Values[valueIdx];
+        // compute the case index
+        int cubeIndex = ((double)(ptr[0]) > value);
+        cubeIndex |= ((double)(ptr[inc0]) > value) << 1;
+        cubeIndex |= ((double)(ptr[inc0 + inc1]) > value) << 2;
+        cubeIndex |= ((double)(ptr[inc1]) > value) << 3;
+        cubeIndex |= ((double)(ptr[inc2]) > value) << 4;
+        cubeIndex |= ((double)(ptr[inc0 + inc2]) > value) << 5;
+        cubeIndex |= ((double)(ptr[inc0 + inc1 + inc2]) > value) << 6;
+        cubeIndex |= ((double)(ptr[inc1 + inc2]) > value) << 7;
+        // Make sure we have triangles
+        if (cubeIndex == 0 || cubeIndex == 255)
+        {
+          continue;
+        }
+        // loop over triangles
+        for (EDGE_LIST* edge = triCases[cubeIndex].edges; *edge > -1; ++edge)
+        {
+          vtkIdType slot =
+            vtkImageMarchingCubesLocatorIndex(idx0 - min0, idx1 - min1, *edge, params.LocatorDimX);
+          vtkIdType ptId = locator[slot];
+          // If the point has not been created yet
+          if (ptId == -1)
+          {
+            ptId = layer.GetNumberOfPoints();
+            vtkImageMarchingCubesMakeNewPoint(params, layer, idx0, idx1, idx2, ptr, *edge, value);
+            locator[slot] = ptId;
+            used.push_back(slot);
+
+            // remember the points on the faces shared with other layers
+            vtkIdType key = (slot / 5) * 2;
+            switch (slot % 5)
+            {
+              case 0:
+                layer.Bottom.emplace_back(key, ptId);
+                break;
+              case 3:
+                layer.Bottom.emplace_back(key + 1, ptId);
+                break;
+              case 4:
+                layer.Top.emplace_back(key, ptId);
+                break;
+              case 1:
+                layer.Top.emplace_back(key + 1, ptId);
+                break;
+            }
+          }
+          layer.Triangles.push_back(ptId);
+        }
+      }
+      ptr += inc0;
+    }
+    ptr1 += inc1;
+  }
 
-  triCases = vtkMarchingCubesTriangleCases::GetCases();
+  for (vtkIdType slot : used)
+  {
+    locator[slot] = -1;
+  }
+  std::sort(layer.Top.begin(), layer.Top.end());
+}
+}
 
-  inData->GetIncrements(inc0, inc1, inc2);
-  for (valueIdx = 0; valueIdx < numContours; ++valueIdx)
+//------------------------------------------------------------------------------
+namespace
+{
+// Make room for the tuples, keeping the array contents (which
+// SetNumberOfTuples alone does not do when it has to allocate).
+void vtkImageMarchingCubesResize(vtkDataArray* array, vtkIdType numTuples)
+{
+  if (numTuples * array->GetNumberOfComponents() > array->GetSize())
   {
-    value = values[valueIdx];
-    // compute the case index
-    cubeIndex = 0;
-    if ((double)(ptr[0]) > value)
-    {
-      cubeIndex += 1;
-    }
-    if ((double)(ptr[inc0]) > value)
-    {
-      cubeIndex += 2;
-    }
-    if ((double)(ptr[inc0 + inc1]) > value)
-    {
-      cubeIndex += 4;
-    }
-    if ((double)(ptr[inc1]) > value)
-    {
-      cubeIndex += 8;
-    }
-    if ((double)(ptr[inc2]) > value)
-    {
-      cubeIndex += 16;
-    }
-    if ((double)(ptr[inc0 + inc2]) > value)
-    {
-      cubeIndex += 32;
-    }
-    if ((double)(ptr[inc0 + inc1 + inc2]) > value)
+    array->Resize(std::max(numTuples, 2 * array->GetNumberOfTuples()));
+  }
+  array->SetNumberOfTuples(numTuples);
+}
+}
+
+//------------------------------------------------------------------------------
+// This templated function marches the layers of cubes of a chunk in
+// parallel, and then appends their points and triangles in the order in
+// which a serial march would have created them.
+template <class T>
+void vtkImageMarchingCubesMarch(vtkImageMarchingCubes* self,
+  vtkImageMarchingCubes::vtkInternals* internals, vtkImageData* inData, T* ptr, int chunkMin,
+  int chunkMax, int numContours, double* values)
+{
+  vtkImageMarchingCubesParameters params;
+  params.Self = self;
+  params.NumberOfContours = numContours;
+  params.Values = values;
+  vtkInformation* inInfo = self->GetExecutive()->GetInputInformation(0, 0);
+  inInfo->Get(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(), params.WholeExtent);
+  inData->GetExtent(params.Extent);
+  inData->GetIncrements(params.Increments);
+  params.LocatorDimX = params.Extent[1] - params.Extent[0] + 2;
+  params.LocatorDimY = params.Extent[3] - params.Extent[2] + 2;
+
+  // march the layers
+  int numLayers = chunkMax - chunkMin;
+  std::vector<vtkImageMarchingCubesLayer> layers(numLayers);
+  vtkIdType locatorSize = 5 * static_cast<vtkIdType>(params.LocatorDimX) * params.LocatorDimY;
+  vtkSMPTools::For(0, numLayers, 1, [&](int begin, int end) {
+    std::vector<vtkIdType>& locator = internals->Locators.Local();
+    if (static_cast<vtkIdType>(locator.size()) != locatorSize)
     {
-      cubeIndex += 64;
+      locator.assign(locatorSize, -1);
     }
-    if ((double)(ptr[inc1 + inc2]) > value)
+    for (int i = begin; i < end; ++i)
     {
-      cubeIndex += 128;
+      int idx2 = chunkMin + i;
+      vtkImageMarchingCubesMarchLayer(params,
+        ptr + (idx2 - params.Extent[4]) * params.Increments[2], idx2, layers[i], locator);
     }
-    // Make sure we have trianlges
-    if (cubeIndex != 0 && cubeIndex != 255)
+  });
+  if (self->GetAbortExecute())
+  {
+    return;
+  }
+
+  // match the points on the bottom faces with those of the layers below
+  vtkImageMarchingCubesLayer* previous = (internals->HasPrevious ? &internals->Previous : nullptr);
+  vtkSMPTools::For(0, numLayers, 1, [&](int begin, int end) {
+    for (int i = begin; i < end; ++i)
     {
-      // Get edges.
-      triCase = triCases + cubeIndex;
-      EDGE_LIST* edge = triCase->edges;
-      // loop over triangles
-      while (*edge > -1)
+      vtkImageMarchingCubesLayer& layer = layers[i];
+      const vtkImageMarchingCubesLayer* below = (i > 0 ? &layers[i - 1] : previous);
+      layer.Rank.assign(layer.GetNumberOfPoints(), 0);
+      for (const auto& point : layer.Bottom)
       {
-        for (ii = 0; ii < 3; ++ii, ++edge) // insert triangle
+        if (below)
         {
-          // Get the index of the point
-          pointIds[ii] = self->GetLocatorPoint(cellX, cellY, *edge);
-          // If the point has not been created yet
-          if (pointIds[ii] == -1)
+          auto match = std::lower_bound(
+            below->Top.begin(), below->Top.end(), std::make_pair(point.first, vtkIdType(0)));
+          if (match != below->Top.end() && match->first == point.first)
           {
-            int* extent = inInfo->Get(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT());
-
-            pointIds[ii] = vtkImageMarchingCubesMakeNewPoint(
-              self, cellX, cellY, cellZ, inc0, inc1, inc2, ptr, *edge, extent, value);
-            self->AddLocatorPoint(cellX, cellY, *edge, pointIds[ii]);
+            layer.Rank[point.second] = -2 - match->second;
           }
         }
-        self->Triangles->InsertNextCell(3, pointIds);
-      } // for each triangle
+      }
+      vtkIdType rank = 0;
+      for (vtkIdType& r : layer.Rank)
+      {
+        r = (r < 0 ? r : rank++);
+      }
+      layer.NumberOfNewPoints = rank;
     }
+  });
+
+  // the offsets of the layers in the output
+  vtkIdType numPoints = self->Points->GetNumberOfPoints();
+  vtkIdType numIds = internals->Connectivity->GetNumberOfValues();
+  for (vtkImageMarchingCubesLayer& layer : layers)
+  {
+    layer.PointOffset = numPoints;
+    layer.TriangleOffset = numIds;
+    numPoints += layer.NumberOfNewPoints;
+    numIds += static_cast<vtkIdType>(layer.Triangles.size());
+  }
+  vtkImageMarchingCubesResize(self->Points->GetData(), numPoints);
+  vtkImageMarchingCubesResize(internals->Connectivity, numIds);
+  float* points = static_cast<float*>(self->Points->GetVoidPointer(0));
+  float* scalars = nullptr;
+  float* gradients = nullptr;
+  float* normals = nullptr;
+  if (self->ComputeScalars)
+  {
+    vtkImageMarchingCubesResize(self->Scalars, numPoints);
+    scalars = self->Scalars->GetPointer(0);
   }
-}
+  if (self->NeedGradients && self->ComputeGradients)
+  {
+    vtkImageMarchingCubesResize(self->Gradients, numPoints);
+    gradients = self->Gradients->GetPointer(0);
+  }
+  if (self->NeedGradients && self->ComputeNormals)
+  {
+    vtkImageMarchingCubesResize(self->Normals, numPoints);
+    normals = self->Normals->GetPointer(0);
+  }
+  vtkIdType* connectivity = internals->Connectivity->GetPointer(0);
 
-//------------------------------------------------------------------------------
-template <class T>
-void vtkImageMarchingCubesMarch(vtkImageMarchingCubes* self, vtkImageData* inData, T* ptr,
-  int chunkMin, int chunkMax, int numContours, double* values)
-{
-  int idx0, idx1, idx2;
-  int min0, max0, min1, max1, min2, max2;
-  vtkIdType inc0, inc1, inc2;
-  T *ptr0, *ptr1, *ptr2;
-  unsigned long target, count;
-
-  // avoid warnings
-  (void)ptr;
-
-  // Get information to loop through images.
-  inData->GetExtent(min0, max0, min1, max1, min2, max2);
-  ptr2 = (T*)(inData->GetScalarPointer(min0, min1, chunkMin));
-  inData->GetIncrements(inc0, inc1, inc2);
-
-  // Setup the abort interval
-  target = (unsigned long)((max0 - min0 + 1) * (max1 - min1 + 1) / 50.0);
-  ++target;
-  count = 0;
-
-  // Loop over all the cubes
-  for (idx2 = chunkMin; idx2 < chunkMax; ++idx2)
-  {
-    ptr1 = ptr2;
-    for (idx1 = min1; idx1 < max1; ++idx1)
+  // copy the new points and the triangles
+  vtkSMPTools::For(0, numLayers, 1, [&](int begin, int end) {
+    for (int i = begin; i < end; ++i)
     {
-      if (!(count % target))
+      const vtkImageMarchingCubesLayer& layer = layers[i];
+      const vtkImageMarchingCubesLayer* below = (i > 0 ? &layers[i - 1] : previous);
+      for (vtkIdType j = 0; j < layer.GetNumberOfPoints(); ++j)
       {
-        if (self->GetAbortExecute())
+        vtkIdType r = layer.Rank[j];
+        if (r < 0)
+        {
+          continue;
+        }
+        vtkIdType id = layer.PointOffset + r;
+        std::copy_n(&layer.Points[3 * j], 3, points + 3 * id);
+        if (scalars)
+        {
+          scalars[id] = layer.Scalars[j];
+        }
+        if (gradients)
         {
-          return;
+          std::copy_n(&layer.Gradients[3 * j], 3, gradients + 3 * id);
+        }
+        if (normals)
+        {
+          std::copy_n(&layer.Normals[3 * j], 3, normals + 3 * id);
         }
       }
-      count++;
-      // continue with last loop
-      ptr0 = ptr1;
-      for (idx0 = min0; idx0 < max0; ++idx0)
+      vtkIdType* cellIds = connectivity + layer.TriangleOffset;
+      for (vtkIdType j : layer.Triangles)
       {
-        // put magnitudes into the cube structure.
-        vtkImageMarchingCubesHandleCube(self, idx0, idx1, idx2, inData, ptr0, numContours, values);
-
-        ptr0 += inc0;
+        vtkIdType r = layer.Rank[j];
+        *cellIds++ = (r >= 0 ? layer.PointOffset + r : below->PointOffset + below->Rank[-2 - r]);
       }
-      ptr1 += inc1;
     }
-    ptr2 += inc2;
-    self->IncrementLocatorZ();
-  }
+  });
+
+  // keep the top layer for the next chunk
+  internals->Previous = std::move(layers.back());
+  internals->HasPrevious = true;
 }
 
 //------------------------------------------------------------------------------
@@ -634,8 +863,8 @@ void vtkImageMarchingCubes::March(
 
   switch (inData->GetScalarType())
   {
-    vtkTemplateMacro(vtkImageMarchingCubesMarch(
-      this, inData, static_cast<VTK_TT*>(ptr), chunkMin, chunkMax, numContours, values));
+    vtkTemplateMacro(vtkImageMarchingCubesMarch(this, this->Internals, inData,
+      static_cast<VTK_TT*>(ptr), chunkMin, chunkMax, numContours, values));
     default:
       vtkErrorMacro(<< "Unknown output ScalarType");
       return;
@@ -731,59 +960,9 @@ vtkIdType vtkImageMarchingCubes::GetLocatorPoint(int cellX, int cellY, int edge)
 // This method returns a pointer to an ID from a cube and an edge.
 vtkIdType* vtkImageMarchingCubes::GetLocatorPointer(int cellX, int cellY, int edge)
 {
-  // Remove redundant edges (shared by more than one cube).
-  // Take care of shared edges
-  switch (edge)
-  {
-    case 9:
-      ++cellX;
-      edge = 8;
-      break;
-    case 10:
-      ++cellY;
-      edge = 8;
-      break;
-    case 11:
-      ++cellX;
-      ++cellY;
-      edge = 8;
-      break;
-    case 5:
-      ++cellX;
-      edge = 7;
-      break;
-    case 6:
-      ++cellY;
-      edge = 4;
-      break;
-    case 1:
-      ++cellX;
-      edge = 3;
-      break;
-    case 2:
-      ++cellY;
-      edge = 0;
-      break;
-  }
-
-  // relative to min and max.
-  cellX -= this->LocatorMinX;
-  cellY -= this->LocatorMinY;
-
-  // compute new indexes for edges (0 to 4)
-  // must be compatible with LocatorIncrementZ.
-  if (edge == 7)
-  {
-    edge = 1;
-  }
-  if (edge == 8)
-  {
-    edge = 2;
-  }
-
-  // return correct pointer
-  return this->LocatorPointIds + edge +
-    (cellX + cellY * static_cast<vtkIdType>(this->LocatorDimX)) * 5;
+  return this->LocatorPointIds +
+    vtkImageMarchingCubesLocatorIndex(
+      cellX - this->LocatorMinX, cellY - this->LocatorMinY, edge, this->LocatorDimX);
 }
 
 //------------------------------------------------------------------------------
@@ -25,6 +25,12 @@
  * once.  Streaming is controlled using the instance variable
  * InputMemoryLimit, which has units KBytes.
  *
+ * The layers of cubes within each chunk are contoured in parallel with
+ * vtkSMPTools, and the results are merged so that the output points and
+ * triangles are the same, and in the same order, as those of a serial
+ * march, whatever the InputMemoryLimit and the number of threads.  If
+ * ComputeGradients is on, the gradients are stored as the point vectors.
+ *
  * @warning
  * This filter is specialized to volumes. If you are interested in
  * contouring other types of data, use the general vtkContourFilter. If you
@@ -117,6 +123,8 @@ public:
   vtkFloatArray* Normals;
   vtkFloatArray* Gradients;
 
+  class vtkInternals;
+
   vtkIdType GetLocatorPoint(int cellX, int cellY, int edge);
   void AddLocatorPoint(int cellX, int cellY, int edge, vtkIdType ptId);
   void IncrementLocatorZ();
@@ -145,6 +153,7 @@ protected:
   int LocatorDimY;
   int LocatorMinX;
   int LocatorMinY;
+  vtkInternals* Internals;
 
   int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
   int RequestUpdateExtent(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
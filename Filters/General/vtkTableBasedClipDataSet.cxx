@@ -1706,7 +1706,8 @@ int vtkTableBasedClipDataSet::RequestData(vtkInformation* vtkNotUsed(request),
   // get the output (the remaining and the clipped parts)
   vtkUnstructuredGrid* outputUG =
     vtkUnstructuredGrid::SafeDownCast(outInfor->Get(vtkDataObject::DATA_OBJECT()));
-  vtkUnstructuredGrid* clippedOutputUG = this->GetClippedOutput();
+  vtkUnstructuredGrid* clippedOutputUG =
+    this->GenerateClippedOutput ? vtkUnstructuredGrid::GetData(outputVector, 1) : nullptr;
 
   inputInf = nullptr;
   outInfor = nullptr;
@@ -3281,6 +3282,31 @@ void vtkTableBasedClipDataSet::ClipUnstructuredGridData(
   unstruct = nullptr;
 }
 
+//------------------------------------------------------------------------------
+vtkAlgorithm* vtkTableBasedClipDataSet::NewConcurrentInstance()
+{
+  auto instance = static_cast<vtkTableBasedClipDataSet*>(
+    this->NewConcurrentInstanceOf("vtkTableBasedClipDataSet"));
+  if (instance)
+  {
+    instance->SetClipFunction(this->ClipFunction);
+    instance->InsideOut = this->InsideOut;
+    instance->GenerateClipScalars = this->GenerateClipScalars;
+    instance->GenerateClippedOutput = this->GenerateClippedOutput;
+    instance->UseValueAsOffset = this->UseValueAsOffset;
+    instance->Value = this->Value;
+    instance->MergeTolerance = this->MergeTolerance;
+    instance->OutputPointsPrecision = this->OutputPointsPrecision;
+    if (this->Locator)
+    {
+      auto locator = vtk::TakeSmartPointer(this->Locator->NewInstance());
+      locator->SetTolerance(this->Locator->GetTolerance());
+      instance->SetLocator(locator);
+    }
+  }
+  return instance;
+}
+
 //------------------------------------------------------------------------------
 void vtkTableBasedClipDataSet::PrintSelf(ostream& os, vtkIndent indent)
 {
@@ -226,6 +226,13 @@ public:
   vtkGetMacro(OutputPointsPrecision, int);
   ///@}
 
+  /**
+   * Return an instance with the same clip function, value and settings, see
+   * vtkAlgorithm::NewConcurrentInstance(). The instance gets its own point
+   * locator, of the class of this one and with the same tolerance.
+   */
+  vtkAlgorithm* NewConcurrentInstance() override;
+
 protected:
   vtkTableBasedClipDataSet(vtkImplicitFunction* cf = nullptr);
   ~vtkTableBasedClipDataSet() override;
@@ -1264,6 +1264,25 @@ int vtkDataSetSurfaceFilter::FillInputPortInformation(int, vtkInformation* info)
   return 1;
 }
 
+//------------------------------------------------------------------------------
+vtkAlgorithm* vtkDataSetSurfaceFilter::NewConcurrentInstance()
+{
+  auto instance = static_cast<vtkDataSetSurfaceFilter*>(
+    this->NewConcurrentInstanceOf("vtkDataSetSurfaceFilter"));
+  if (instance)
+  {
+    instance->PieceInvariant = this->PieceInvariant;
+    instance->PassThroughCellIds = this->PassThroughCellIds;
+    instance->SetOriginalCellIdsName(this->OriginalCellIdsName);
+    instance->PassThroughPointIds = this->PassThroughPointIds;
+    instance->SetOriginalPointIdsName(this->OriginalPointIdsName);
+    instance->NonlinearSubdivisionLevel = this->NonlinearSubdivisionLevel;
+    instance->Delegation = this->Delegation;
+    instance->FastMode = this->FastMode;
+  }
+  return instance;
+}
+
 //------------------------------------------------------------------------------
 void vtkDataSetSurfaceFilter::PrintSelf(ostream& os, vtkIndent indent)
 {
@@ -289,6 +289,12 @@ public:
 #endif
   ///@}
 
+  /**
+   * Return an instance with the same settings, see
+   * vtkAlgorithm::NewConcurrentInstance().
+   */
+  vtkAlgorithm* NewConcurrentInstance() override;
+
 protected:
   vtkDataSetSurfaceFilter();
   ~vtkDataSetSurfaceFilter() override;
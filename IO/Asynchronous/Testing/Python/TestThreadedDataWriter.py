@@ -0,0 +1,51 @@
+#!/usr/bin/env python
+import os
+
+import vtk
+from vtk.util.misc import vtkGetTempDir
+
+VTK_TEMP_DIR = vtkGetTempDir()
+
+source = vtk.vtkSphereSource()
+source.SetThetaResolution(64)
+source.SetPhiResolution(64)
+
+writer = vtk.vtkThreadedDataWriter()
+writer.SetMaxThreads(2)
+writer.SetMaxPendingWrites(3)
+
+# Re-executing the source while earlier outputs are written must not affect
+# the files: each write works on a snapshot.
+fileNames = []
+for i in range(10):
+    source.SetRadius(1 + i)
+    source.Update()
+    fileName = os.path.join(VTK_TEMP_DIR, 'threaded-data-writer-%d.%s' %
+                            (i, 'vtk' if i % 2 else 'vtp'))
+    fileNames.append(fileName)
+    writer.Write(source.GetOutput(), fileName)
+    assert writer.GetNumberOfPendingWrites() <= 3
+
+assert writer.Flush()
+assert writer.GetNumberOfPendingWrites() == 0
+
+for i, fileName in enumerate(fileNames):
+    reader = vtk.vtkPolyDataReader() if fileName.endswith('.vtk') else vtk.vtkXMLPolyDataReader()
+    reader.SetFileName(fileName)
+    reader.Update()
+    output = reader.GetOutput()
+    assert output.GetNumberOfPoints() == source.GetOutput().GetNumberOfPoints()
+    bounds = output.GetBounds()
+    assert abs(bounds[1] - (1 + i)) < 1e-5, (fileName, bounds)
+
+# A write that fails is reported by the next Flush().
+log = vtk.vtkFileOutputWindow()
+log.SetFileName(os.path.join(VTK_TEMP_DIR, 'threaded-data-writer.log'))
+vtk.vtkOutputWindow.SetInstance(log)
+writer.Write(source.GetOutput(),
+             os.path.join(VTK_TEMP_DIR, 'no-such-directory', 'threaded-data-writer.vtp'))
+assert not writer.Flush()
+assert writer.GetNumberOfFailedWrites() == 1
+assert writer.Flush()
+
+writer.Finalize()
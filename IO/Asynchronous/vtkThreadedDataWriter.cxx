@@ -0,0 +1,316 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkThreadedDataWriter.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkThreadedDataWriter.h"
+
+#include "vtkCompositeDataSet.h"
+#include "vtkDataObject.h"
+#include "vtkErrorCode.h"
+#include "vtkGenericDataObjectWriter.h"
+#include "vtkLogger.h"
+#include "vtkMultiThreader.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkSmartPointer.h"
+#include "vtkThreadedTaskQueue.h"
+#include "vtkXMLDataObjectWriter.h"
+#include "vtkXMLMultiBlockDataWriter.h"
+#include "vtkXMLWriter.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#define MAX_NUMBER_OF_THREADS_IN_POOL 32
+//****************************************************************************
+namespace
+{
+struct WriteSettings
+{
+  int CompressorType;
+  int CompressionLevel;
+  int DataMode;
+};
+
+// Returns the error code of the writer, or a description of the problem in
+// `error` if no writer could be created.
+unsigned long EncodeAndWrite(const vtkSmartPointer<vtkDataObject>& data,
+  const std::string& fileName, const WriteSettings& settings, std::string& error)
+{
+  vtkLogF(TRACE, "encoding: %s", fileName.c_str());
+
+  std::size_t pos = fileName.rfind('.');
+  std::string extension = pos == std::string::npos ? "" : fileName.substr(pos + 1);
+
+  if (extension == "vtk")
+  {
+    vtkNew<vtkGenericDataObjectWriter> writer;
+    writer->SetFileName(fileName.c_str());
+    writer->SetFileTypeToBinary();
+    writer->SetInputData(data);
+    writer->Write();
+    return writer->GetErrorCode();
+  }
+
+  vtkSmartPointer<vtkXMLWriter> writer;
+  if (vtkCompositeDataSet::SafeDownCast(data))
+  {
+    writer = vtkSmartPointer<vtkXMLMultiBlockDataWriter>::New();
+  }
+  else
+  {
+    writer.TakeReference(vtkXMLDataObjectWriter::NewWriter(data->GetDataObjectType()));
+  }
+  if (!writer)
+  {
+    error = std::string("no XML writer for ") + data->GetClassName();
+    return vtkErrorCode::UnknownError;
+  }
+  writer->SetFileName(fileName.c_str());
+  writer->SetCompressorType(settings.CompressorType);
+  writer->SetCompressionLevel(settings.CompressionLevel);
+  writer->SetDataMode(settings.DataMode);
+  writer->SetInputData(data);
+  writer->Write();
+  return writer->GetErrorCode();
+}
+}
+
+//****************************************************************************
+class vtkThreadedDataWriter::vtkInternals
+{
+private:
+  using TaskQueueType =
+    vtkThreadedTaskQueue<void, vtkSmartPointer<vtkDataObject>, std::string, WriteSettings>;
+  std::unique_ptr<TaskQueueType> Queue;
+
+  // Number of writes pushed and not yet completed, for back-pressure.
+  std::mutex PendingMutex;
+  std::condition_variable PendingCV;
+  int Pending = 0;
+
+  // Failures recorded by the workers, reported by the caller's thread.
+  std::mutex FailuresMutex;
+  std::vector<std::string> Failures;
+
+  void Run(const vtkSmartPointer<vtkDataObject>& data, const std::string& fileName,
+    const WriteSettings& settings)
+  {
+    std::string error;
+    unsigned long errorCode = ::EncodeAndWrite(data, fileName, settings, error);
+    if (errorCode != vtkErrorCode::NoError)
+    {
+      if (error.empty())
+      {
+        error = vtkErrorCode::GetStringFromErrorCode(errorCode);
+      }
+      std::lock_guard<std::mutex> lock(this->FailuresMutex);
+      this->Failures.push_back("Failed to write " + fileName + ": " + error);
+    }
+
+    std::lock_guard<std::mutex> lock(this->PendingMutex);
+    --this->Pending;
+    this->PendingCV.notify_all();
+  }
+
+public:
+  vtkInternals()
+    : Queue(nullptr)
+  {
+  }
+
+  ~vtkInternals() { this->TerminateAllWorkers(); }
+
+  bool HasWorkers() const { return this->Queue != nullptr; }
+
+  void TerminateAllWorkers()
+  {
+    this->FlushQueue();
+    this->Queue.reset(nullptr);
+  }
+
+  void SpawnWorkers(vtkTypeUInt32 numberOfThreads)
+  {
+    this->Queue.reset(new TaskQueueType(
+      [this](vtkSmartPointer<vtkDataObject> data, std::string fileName, WriteSettings settings) {
+        this->Run(data, fileName, settings);
+      },
+      /*strict_ordering=*/true,
+      /*buffer_size=*/-1,
+      /*max_concurrent_tasks=*/static_cast<int>(numberOfThreads)));
+  }
+
+  void FlushQueue()
+  {
+    if (this->Queue)
+    {
+      this->Queue->Flush();
+    }
+  }
+
+  void PushDataToQueue(vtkSmartPointer<vtkDataObject>&& data, std::string&& fileName,
+    WriteSettings&& settings, int maxPending)
+  {
+    {
+      std::unique_lock<std::mutex> lock(this->PendingMutex);
+      this->PendingCV.wait(
+        lock, [&]() { return maxPending <= 0 || this->Pending < maxPending; });
+      ++this->Pending;
+    }
+    this->Queue->Push(std::move(data), std::move(fileName), std::move(settings));
+  }
+
+  int GetPending()
+  {
+    std::lock_guard<std::mutex> lock(this->PendingMutex);
+    return this->Pending;
+  }
+
+  std::vector<std::string> TakeFailures()
+  {
+    std::lock_guard<std::mutex> lock(this->FailuresMutex);
+    std::vector<std::string> failures;
+    failures.swap(this->Failures);
+    return failures;
+  }
+};
+
+vtkStandardNewMacro(vtkThreadedDataWriter);
+//------------------------------------------------------------------------------
+vtkThreadedDataWriter::vtkThreadedDataWriter()
+  : Internals(new vtkInternals())
+{
+  this->MaxThreads = static_cast<vtkTypeUInt32>(
+    std::min(vtkMultiThreader::GetGlobalDefaultNumberOfThreads(), MAX_NUMBER_OF_THREADS_IN_POOL));
+  this->MaxPendingWrites = 2 * static_cast<int>(this->MaxThreads);
+  this->DeepCopyInput = false;
+  this->CompressorType = vtkXMLWriterBase::ZLIB;
+  this->CompressionLevel = 5;
+  this->DataMode = vtkXMLWriterBase::Appended;
+  this->NumberOfFailedWrites = 0;
+  this->NumberOfFailedWritesAtFlush = 0;
+}
+
+//------------------------------------------------------------------------------
+vtkThreadedDataWriter::~vtkThreadedDataWriter()
+{
+  delete this->Internals;
+  this->Internals = nullptr;
+}
+
+//------------------------------------------------------------------------------
+void vtkThreadedDataWriter::SetMaxThreads(vtkTypeUInt32 maxThreads)
+{
+  if (maxThreads < MAX_NUMBER_OF_THREADS_IN_POOL && maxThreads > 0 &&
+    maxThreads != this->MaxThreads)
+  {
+    this->MaxThreads = maxThreads;
+    this->Modified();
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkThreadedDataWriter::Initialize()
+{
+  // Stop any started thread first
+  this->Internals->TerminateAllWorkers();
+  this->ReportFailedWrites();
+  this->Internals->SpawnWorkers(this->MaxThreads);
+}
+
+//------------------------------------------------------------------------------
+void vtkThreadedDataWriter::Write(vtkDataObject* data, const char* fileName)
+{
+  // Error checking
+  if (data == nullptr || fileName == nullptr)
+  {
+    vtkErrorMacro(<< "Write:Please specify an input and a file name!");
+    return;
+  }
+
+  if (!this->Internals->HasWorkers())
+  {
+    this->Initialize();
+  }
+  this->ReportFailedWrites();
+
+  // Take a snapshot so that the caller is free to release or re-execute the
+  // data while it is being written.
+  vtkSmartPointer<vtkDataObject> snapshot;
+  snapshot.TakeReference(data->NewInstance());
+  if (this->DeepCopyInput)
+  {
+    snapshot->DeepCopy(data);
+  }
+  else
+  {
+    snapshot->ShallowCopy(data);
+  }
+
+  WriteSettings settings{ this->CompressorType, this->CompressionLevel, this->DataMode };
+  this->Internals->PushDataToQueue(
+    std::move(snapshot), std::string(fileName), std::move(settings), this->MaxPendingWrites);
+}
+
+//------------------------------------------------------------------------------
+bool vtkThreadedDataWriter::Flush()
+{
+  this->Internals->FlushQueue();
+  this->ReportFailedWrites();
+  bool success = this->NumberOfFailedWrites == this->NumberOfFailedWritesAtFlush;
+  this->NumberOfFailedWritesAtFlush = this->NumberOfFailedWrites;
+  return success;
+}
+
+//------------------------------------------------------------------------------
+void vtkThreadedDataWriter::Finalize()
+{
+  this->Internals->TerminateAllWorkers();
+  this->ReportFailedWrites();
+}
+
+//------------------------------------------------------------------------------
+int vtkThreadedDataWriter::GetNumberOfPendingWrites()
+{
+  return this->Internals->GetPending();
+}
+
+//------------------------------------------------------------------------------
+int vtkThreadedDataWriter::ReportFailedWrites()
+{
+  std::vector<std::string> failures = this->Internals->TakeFailures();
+  for (const std::string& failure : failures)
+  {
+    vtkErrorMacro(<< failure);
+  }
+  this->NumberOfFailedWrites += static_cast<int>(failures.size());
+  return static_cast<int>(failures.size());
+}
+
+//------------------------------------------------------------------------------
+void vtkThreadedDataWriter::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "MaxThreads: " << this->MaxThreads << endl;
+  os << indent << "MaxPendingWrites: " << this->MaxPendingWrites << endl;
+  os << indent << "DeepCopyInput: " << this->DeepCopyInput << endl;
+  os << indent << "CompressorType: " << this->CompressorType << endl;
+  os << indent << "CompressionLevel: " << this->CompressionLevel << endl;
+  os << indent << "DataMode: " << this->DataMode << endl;
+  os << indent << "NumberOfFailedWrites: " << this->NumberOfFailedWrites << endl;
+}
@@ -0,0 +1,162 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkThreadedDataWriter.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class    vtkThreadedDataWriter
+ * @brief    class used to encode, compress and write datasets using threads
+ *           to prevent blocking the caller while writing.
+ *
+ * @details  vtkThreadedDataWriter generalizes vtkThreadedImageWriter to any
+ *           data object. Write() takes a snapshot of the data object and
+ *           returns immediately, while a pool of worker threads encodes,
+ *           compresses and writes the snapshots. The file format is chosen
+ *           from the file extension: legacy VTK files for "vtk" and the VTK
+ *           XML format matching the data object type for anything else
+ *           (e.g. vtu, vtp, vti, vtm).
+ *
+ *           At most MaxPendingWrites snapshots are held at a time: Write()
+ *           blocks until a worker is done with an older one when that limit is
+ *           reached, which bounds the memory used when data is produced faster
+ *           than it can be written. Flush() waits for all writes to complete.
+ *
+ *           Writes that fail are reported with vtkErrorMacro from the thread
+ *           calling Write() or Flush(), and counted in NumberOfFailedWrites.
+ *
+ * @sa vtkThreadedImageWriter
+ */
+
+#ifndef vtkThreadedDataWriter_h
+#define vtkThreadedDataWriter_h
+
+#include "vtkIOAsynchronousModule.h" // For export macro
+#include "vtkObject.h"
+
+class vtkDataObject;
+
+class VTKIOASYNCHRONOUS_EXPORT vtkThreadedDataWriter : public vtkObject
+{
+public:
+  static vtkThreadedDataWriter* New();
+  vtkTypeMacro(vtkThreadedDataWriter, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  /**
+   * Start a pool of MaxThreads worker threads, waiting first for any
+   * previous pool to finish its writes. Write() calls this if needed, so it
+   * only has to be called again after a change of MaxThreads.
+   */
+  void Initialize();
+
+  /**
+   * Queue a write of \a data to \a fileName and return without waiting for
+   * it, unless MaxPendingWrites writes are already pending.
+   *
+   * Unless DeepCopyInput is on, only a shallow copy of \a data is taken: the
+   * caller may release or replace the data and its arrays, e.g. by
+   * re-executing the pipeline producing it, but must not modify the values
+   * of its arrays in place until the write completed.
+   */
+  void Write(vtkDataObject* data, VTK_FILEPATH const char* fileName);
+
+  /**
+   * Wait for all queued writes to complete. Returns false if any write
+   * failed since the previous call to Flush().
+   */
+  bool Flush();
+
+  /**
+   * Wait for all queued writes to complete and stop the worker threads.
+   */
+  void Finalize();
+
+  /**
+   * Number of writes queued or in progress.
+   */
+  int GetNumberOfPendingWrites();
+
+  ///@{
+  /**
+   * Define the number of worker threads to use.
+   * Initialize() needs to be called after any thread count change.
+   */
+  void SetMaxThreads(vtkTypeUInt32);
+  vtkGetMacro(MaxThreads, vtkTypeUInt32);
+  ///@}
+
+  ///@{
+  /**
+   * Maximum number of writes queued or in progress before Write() blocks.
+   * 0 means unbounded. Default is twice the default MaxThreads.
+   */
+  vtkSetClampMacro(MaxPendingWrites, int, 0, VTK_INT_MAX);
+  vtkGetMacro(MaxPendingWrites, int);
+  ///@}
+
+  ///@{
+  /**
+   * When on, Write() takes a deep copy of the data so that the caller may
+   * modify it in place right away, at the cost of the copy. Off by default.
+   */
+  vtkSetMacro(DeepCopyInput, bool);
+  vtkGetMacro(DeepCopyInput, bool);
+  vtkBooleanMacro(DeepCopyInput, bool);
+  ///@}
+
+  ///@{
+  /**
+   * Settings forwarded to the XML writers: the compressor (one of
+   * vtkXMLWriterBase::NONE, ZLIB, LZ4 or LZMA), its level and the data mode
+   * (vtkXMLWriterBase::Ascii, Binary or Appended). They apply to the writes
+   * queued after they are changed. Defaults are those of vtkXMLWriterBase.
+   */
+  vtkSetMacro(CompressorType, int);
+  vtkGetMacro(CompressorType, int);
+  vtkSetClampMacro(CompressionLevel, int, 1, 9);
+  vtkGetMacro(CompressionLevel, int);
+  vtkSetMacro(DataMode, int);
+  vtkGetMacro(DataMode, int);
+  ///@}
+
+  /**
+   * Number of writes that failed since this writer was created.
+   */
+  vtkGetMacro(NumberOfFailedWrites, int);
+
+protected:
+  vtkThreadedDataWriter();
+  ~vtkThreadedDataWriter() override;
+
+  /**
+   * Report, from the calling thread, the writes that failed since the last
+   * call. Returns the number of such writes.
+   */
+  int ReportFailedWrites();
+
+private:
+  vtkThreadedDataWriter(const vtkThreadedDataWriter&) = delete;
+  void operator=(const vtkThreadedDataWriter&) = delete;
+
+  class vtkInternals;
+  vtkInternals* Internals;
+  vtkTypeUInt32 MaxThreads;
+  int MaxPendingWrites;
+  bool DeepCopyInput;
+  int CompressorType;
+  int CompressionLevel;
+  int DataMode;
+  int NumberOfFailedWrites;
+  int NumberOfFailedWritesAtFlush;
+};
+
+#endif
@@ -0,0 +1,360 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestEnSightGoldBinaryTimeSteps.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Writes a transient EnSight Gold binary case whose geometry and variables
+// are all in single files holding every time step, with two parts and two
+// element blocks in the first one. A reader moves back and forth between
+// the time steps, reading each of them more than once from the offsets it
+// indexed, and must give the same output as a fresh reader every time.
+
+#include "vtkCellData.h"
+#include "vtkDataArray.h"
+#include "vtkDataSet.h"
+#include "vtkGenericEnSightReader.h"
+#include "vtkIdList.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkSMPTools.h"
+#include "vtkTestUtilities.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+const int NumberOfSteps = 3;
+
+class BinaryFile
+{
+public:
+  BinaryFile(const std::string& fileName)
+    : Stream(fileName.c_str(), std::ios::out | std::ios::binary)
+  {
+  }
+
+  bool Good() const { return this->Stream.good(); }
+
+  void String(const char* text)
+  {
+    char buffer[80] = {};
+    strncpy(buffer, text, sizeof(buffer) - 1);
+    this->Stream.write(buffer, sizeof(buffer));
+  }
+
+  void Ints(const std::vector<int>& values)
+  {
+    this->Stream.write(reinterpret_cast<const char*>(values.data()),
+      static_cast<std::streamsize>(values.size() * sizeof(int)));
+  }
+
+  void Floats(const std::vector<float>& values)
+  {
+    this->Stream.write(reinterpret_cast<const char*>(values.data()),
+      static_cast<std::streamsize>(values.size() * sizeof(float)));
+  }
+
+private:
+  std::ofstream Stream;
+};
+
+bool WriteCase(const std::string& dir)
+{
+  BinaryFile geo(dir + "/steps_bin.geo");
+  BinaryFile temperature(dir + "/steps_bin_pd_temperature");
+  BinaryFile pressure(dir + "/steps_bin_cd_pressure");
+  BinaryFile velocity(dir + "/steps_bin_pd_velocity");
+
+  geo.String("C Binary");
+  for (int t = 0; t < NumberOfSteps; ++t)
+  {
+    const float ft = static_cast<float>(t);
+    geo.String("BEGIN TIME STEP");
+    geo.String("time steps");
+    geo.String("in a single file");
+    geo.String("node id off");
+    geo.String("element id off");
+
+    // part 1: a 3x3 grid of nodes split into triangles and quads
+    std::vector<float> x, y, z;
+    for (int i = 0; i < 9; ++i)
+    {
+      x.push_back(static_cast<float>(i % 3) + 0.1f * ft);
+      y.push_back(static_cast<float>(i / 3));
+      z.push_back(0.05f * ft * static_cast<float>(i));
+    }
+    geo.String("part");
+    geo.Ints({ 1 });
+    geo.String("plate");
+    geo.String("coordinates");
+    geo.Ints({ 9 });
+    geo.Floats(x);
+    geo.Floats(y);
+    geo.Floats(z);
+    geo.String("tria3");
+    geo.Ints({ 2 });
+    geo.Ints({ 1, 2, 4, 2, 5, 4 });
+    geo.String("quad4");
+    geo.Ints({ 3 });
+    geo.Ints({ 2, 3, 6, 5, 4, 5, 8, 7, 5, 6, 9, 8 });
+
+    // part 2: two tetrahedra, one of them growing
+    geo.String("part");
+    geo.Ints({ 2 });
+    geo.String("solid");
+    geo.String("coordinates");
+    geo.Ints({ 5 });
+    geo.Floats({ 0.f, 1.f, 0.f, 0.f, 1.f + ft });
+    geo.Floats({ 0.f, 0.f, 1.f, 0.f, 1.f });
+    geo.Floats({ 0.f, 0.f, 0.f, 1.f, 1.f + 0.5f * ft });
+    geo.String("tetra4");
+    geo.Ints({ 2 });
+    geo.Ints({ 1, 2, 3, 4, 2, 3, 4, 5 });
+    geo.String("END TIME STEP");
+
+    temperature.String("BEGIN TIME STEP");
+    temperature.String("temperature");
+    temperature.String("part");
+    temperature.Ints({ 1 });
+    temperature.String("coordinates");
+    std::vector<float> values;
+    for (int i = 0; i < 9; ++i)
+    {
+      values.push_back(static_cast<float>(i) + 10.f * ft);
+    }
+    temperature.Floats(values);
+    temperature.String("part");
+    temperature.Ints({ 2 });
+    temperature.String("coordinates");
+    values.resize(5);
+    for (int i = 0; i < 5; ++i)
+    {
+      values[i] = -static_cast<float>(i) - 10.f * ft;
+    }
+    temperature.Floats(values);
+    temperature.String("END TIME STEP");
+
+    pressure.String("BEGIN TIME STEP");
+    pressure.String("pressure");
+    pressure.String("part");
+    pressure.Ints({ 1 });
+    pressure.String("tria3");
+    pressure.Floats({ 1.f + ft, 2.f + ft });
+    pressure.String("quad4");
+    pressure.Floats({ 3.f + ft, 4.f + ft, 5.f + ft });
+    pressure.String("part");
+    pressure.Ints({ 2 });
+    pressure.String("tetra4");
+    pressure.Floats({ 6.f * ft, 7.f * ft });
+    pressure.String("END TIME STEP");
+
+    velocity.String("BEGIN TIME STEP");
+    velocity.String("velocity");
+    velocity.String("part");
+    velocity.Ints({ 1 });
+    velocity.String("coordinates");
+    velocity.Floats(std::vector<float>(9, ft));
+    velocity.Floats(x);
+    velocity.Floats(std::vector<float>(9, -ft));
+    velocity.String("part");
+    velocity.Ints({ 2 });
+    velocity.String("coordinates");
+    velocity.Floats(std::vector<float>(5, 1.f));
+    velocity.Floats(std::vector<float>(5, ft));
+    velocity.Floats({ 0.f, ft, 2.f * ft, 3.f * ft, 4.f * ft });
+    velocity.String("END TIME STEP");
+  }
+  if (!geo.Good() || !temperature.Good() || !pressure.Good() || !velocity.Good())
+  {
+    return false;
+  }
+
+  std::ofstream caseFile((dir + "/steps_bin.case").c_str());
+  caseFile << "FORMAT\n"
+              "type: ensight gold\n"
+              "\n"
+              "GEOMETRY\n"
+              "model: 1 1 steps_bin.geo\n"
+              "\n"
+              "VARIABLE\n"
+              "scalar per node: 1 1 temperature steps_bin_pd_temperature\n"
+              "scalar per element: 1 1 pressure steps_bin_cd_pressure\n"
+              "vector per node: 1 1 velocity steps_bin_pd_velocity\n"
+              "\n"
+              "TIME\n"
+              "time set: 1\n"
+              "number of steps: 3\n"
+              "time values: 0.0 1.0 2.0\n"
+              "\n"
+              "FILE\n"
+              "file set: 1\n"
+              "number of steps: 3\n";
+  return caseFile.good();
+}
+
+bool SameArrays(vtkFieldData* a, vtkFieldData* b)
+{
+  if (a->GetNumberOfArrays() != b->GetNumberOfArrays())
+  {
+    return false;
+  }
+  for (int i = 0; i < a->GetNumberOfArrays(); ++i)
+  {
+    vtkDataArray* arrayA = a->GetArray(i);
+    vtkDataArray* arrayB = b->GetArray(i);
+    if (!arrayA || !arrayB || strcmp(arrayA->GetName(), arrayB->GetName()) != 0 ||
+      arrayA->GetNumberOfComponents() != arrayB->GetNumberOfComponents() ||
+      arrayA->GetNumberOfTuples() != arrayB->GetNumberOfTuples())
+    {
+      return false;
+    }
+    for (vtkIdType t = 0; t < arrayA->GetNumberOfTuples(); ++t)
+    {
+      for (int c = 0; c < arrayA->GetNumberOfComponents(); ++c)
+      {
+        if (arrayA->GetComponent(t, c) != arrayB->GetComponent(t, c))
+        {
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+bool SameDataSet(vtkDataSet* a, vtkDataSet* b)
+{
+  if (strcmp(a->GetClassName(), b->GetClassName()) != 0 ||
+    a->GetNumberOfPoints() != b->GetNumberOfPoints() ||
+    a->GetNumberOfCells() != b->GetNumberOfCells())
+  {
+    return false;
+  }
+  double pA[3], pB[3];
+  for (vtkIdType i = 0; i < a->GetNumberOfPoints(); ++i)
+  {
+    a->GetPoint(i, pA);
+    b->GetPoint(i, pB);
+    if (pA[0] != pB[0] || pA[1] != pB[1] || pA[2] != pB[2])
+    {
+      return false;
+    }
+  }
+  vtkNew<vtkIdList> idsA;
+  vtkNew<vtkIdList> idsB;
+  for (vtkIdType i = 0; i < a->GetNumberOfCells(); ++i)
+  {
+    a->GetCellPoints(i, idsA);
+    b->GetCellPoints(i, idsB);
+    if (a->GetCellType(i) != b->GetCellType(i) ||
+      idsA->GetNumberOfIds() != idsB->GetNumberOfIds() ||
+      !std::equal(idsA->begin(), idsA->end(), idsB->begin()))
+    {
+      return false;
+    }
+  }
+  return SameArrays(a->GetPointData(), b->GetPointData()) &&
+    SameArrays(a->GetCellData(), b->GetCellData());
+}
+
+bool SameOutput(vtkMultiBlockDataSet* a, vtkMultiBlockDataSet* b)
+{
+  if (a->GetNumberOfBlocks() != b->GetNumberOfBlocks())
+  {
+    return false;
+  }
+  for (unsigned int i = 0; i < a->GetNumberOfBlocks(); ++i)
+  {
+    vtkDataObject* blockA = a->GetBlock(i);
+    vtkDataObject* blockB = b->GetBlock(i);
+    if (!blockA || !blockB)
+    {
+      if (blockA != blockB)
+      {
+        return false;
+      }
+      continue;
+    }
+    vtkMultiBlockDataSet* mbA = vtkMultiBlockDataSet::SafeDownCast(blockA);
+    vtkMultiBlockDataSet* mbB = vtkMultiBlockDataSet::SafeDownCast(blockB);
+    vtkDataSet* dsA = vtkDataSet::SafeDownCast(blockA);
+    vtkDataSet* dsB = vtkDataSet::SafeDownCast(blockB);
+    if (mbA && mbB ? !SameOutput(mbA, mbB) : !dsA || !dsB || !SameDataSet(dsA, dsB))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int TestEnSightGoldBinaryTimeSteps(int argc, char* argv[])
+{
+  char* tempDir =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  if (!tempDir)
+  {
+    std::cerr << "Could not determine temporary directory.\n";
+    return EXIT_FAILURE;
+  }
+  std::string testDirectory = tempDir;
+  delete[] tempDir;
+
+  if (!WriteCase(testDirectory))
+  {
+    std::cerr << "Could not write the case to " << testDirectory << "\n";
+    return EXIT_FAILURE;
+  }
+  const std::string caseFileName = testDirectory + "/steps_bin.case";
+
+  // the parts are read concurrently
+  vtkSMPTools::Initialize(2);
+
+  vtkNew<vtkGenericEnSightReader> reader;
+  reader->SetCaseFileName(caseFileName.c_str());
+
+  // every step is read twice, the first one being indexed on the way back
+  const int steps[] = { 2, 0, 1, 2, 0, 1 };
+  for (int step : steps)
+  {
+    reader->SetTimeValue(step);
+    reader->Update();
+
+    vtkNew<vtkGenericEnSightReader> fresh;
+    fresh->SetCaseFileName(caseFileName.c_str());
+    fresh->SetTimeValue(step);
+    fresh->Update();
+
+    vtkMultiBlockDataSet* output = reader->GetOutput();
+    vtkDataSet* solid = vtkDataSet::SafeDownCast(output->GetBlock(1));
+    if (output->GetNumberOfBlocks() != 2 || !solid || solid->GetNumberOfPoints() != 5 ||
+      solid->GetPoint(4)[0] != 1. + step || !solid->GetPointData()->GetArray("temperature") ||
+      solid->GetPointData()->GetArray("temperature")->GetComponent(0, 0) != -10. * step)
+    {
+      std::cerr << "Unexpected output for time step " << step << "\n";
+      return EXIT_FAILURE;
+    }
+    if (!SameOutput(output, fresh->GetOutput()))
+    {
+      std::cerr << "Rereading time step " << step << " differs from a fresh reader\n";
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -20,11 +20,14 @@
 #include "vtkFloatArray.h"
 #include "vtkIdList.h"
 #include "vtkImageData.h"
+#include "vtkInformation.h"
 #include "vtkMultiBlockDataSet.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkRectilinearGrid.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkStructuredGrid.h"
 #include "vtkUnstructuredGrid.h"
 #include "vtksys/Encoding.hxx"
@@ -38,6 +41,7 @@
 #include <numeric>
 #include <string>
 #include <sys/stat.h>
+#include <utility>
 #include <vector>
 
 #if defined(_WIN32)
@@ -191,6 +195,54 @@ public:
   }
 };
 
+namespace
+{
+enum class PartType : char
+{
+  Unstructured,
+  Structured,
+  Rectilinear,
+  Uniform
+};
+
+// Classifies a part from the line following its description.
+PartType GetPartType(const char* line)
+{
+  char subLine[80];
+  if (strncmp(line, "block", 5) != 0)
+  {
+    return PartType::Unstructured;
+  }
+  if (sscanf(line, " %*s %s", subLine) == 1)
+  {
+    if (strncmp(subLine, "rectilinear", 11) == 0)
+    {
+      return PartType::Rectilinear;
+    }
+    if (strncmp(subLine, "uniform", 7) == 0)
+    {
+      return PartType::Uniform;
+    }
+  }
+  // block or block iblanked
+  return PartType::Structured;
+}
+
+std::string GetFullPath(const char* filePath, const char* fileName)
+{
+  if (!filePath)
+  {
+    return fileName;
+  }
+  std::string sfilename = filePath;
+  if (sfilename.at(sfilename.length() - 1) != '/')
+  {
+    sfilename += "/";
+  }
+  return sfilename + fileName;
+}
+}
+
 vtkStandardNewMacro(vtkEnSightGoldBinaryReader);
 class vtkEnSightGoldBinaryReader::FileOffsetMapInternal
 {
@@ -202,6 +254,31 @@ public:
   typedef std::map<MapKey, MapValue>::value_type value_type;
 
   std::map<MapKey, MapValue> Map;
+
+  // Location of a part in a geometry file, pointing at the part number
+  // that follows the "part" keyword.
+  struct PartOffset
+  {
+    vtkTypeInt64 Offset;
+    int Id;
+    PartType Type;
+  };
+
+  // The file size is kept with each entry so that a file rewritten in
+  // place is scanned again instead of being read at stale offsets.
+  struct TimeStepCount
+  {
+    vtkTypeUInt64 FileSize;
+    int Count;
+  };
+  struct PartIndex
+  {
+    vtkTypeUInt64 FileSize;
+    std::vector<PartOffset> Parts;
+  };
+
+  std::map<MapKey, TimeStepCount> NumberOfTimeSteps;
+  std::map<std::pair<MapKey, int>, PartIndex> PartIndices;
 };
 
 // This is half the precision of an int.
@@ -344,21 +421,8 @@ int vtkEnSightGoldBinaryReader::InitializeFile(const char* fileName)
     vtkErrorMacro("A GeometryFileName must be specified in the case file.");
     return 0;
   }
-  std::string sfilename;
-  if (this->FilePath)
-  {
-    sfilename = this->FilePath;
-    if (sfilename.at(sfilename.length() - 1) != '/')
-    {
-      sfilename += "/";
-    }
-    sfilename += fileName;
-    vtkDebugMacro("full path to geometry file: " << sfilename.c_str());
-  }
-  else
-  {
-    sfilename = fileName;
-  }
+  std::string sfilename = GetFullPath(this->FilePath, fileName);
+  vtkDebugMacro("full path to geometry file: " << sfilename.c_str());
 
   if (this->OpenFile(sfilename.c_str()) == 0)
   {
@@ -393,8 +457,7 @@ int vtkEnSightGoldBinaryReader::InitializeFile(const char* fileName)
 int vtkEnSightGoldBinaryReader::ReadGeometryFile(
   const char* fileName, int timeStep, vtkMultiBlockDataSet* output)
 {
-  char line[80], subLine[80], nameline[80];
-  int partId, realId;
+  char line[80], subLine[80];
   int lineRead, i;
 
   if (!this->InitializeFile(fileName))
@@ -402,16 +465,13 @@ int vtkEnSightGoldBinaryReader::ReadGeometryFile(
     return 0;
   }
 
-  // this will close the file, so we need to reinitialize it
-  int numberOfTimeStepsInFile = this->CountTimeSteps();
-
-  if (!this->InitializeFile(fileName))
-  {
-    return 0;
-  }
-
   if (this->UseFileSets)
   {
+    int numberOfTimeStepsInFile = this->GetNumberOfTimeStepsInFile(fileName);
+    if (numberOfTimeStepsInFile < 0)
+    {
+      return 0;
+    }
     if (numberOfTimeStepsInFile > 1)
     {
       this->AddFileIndexToCache(fileName);
@@ -481,94 +541,265 @@ int vtkEnSightGoldBinaryReader::ReadGeometryFile(
     lineRead = this->ReadLine(line); // "part"
   }
 
-  while (lineRead > 0 && strncmp(line, "part", 4) == 0)
+  // The parts of a time step are located once, skipping over their data.
+  // Reading the same step again, e.g. for static geometry, seeks straight to
+  // them and the parts are then read independently of each other.
+  const int indexTimeStep = this->UseFileSets ? timeStep : 0;
+  FileOffsetMapInternal::PartIndex& index =
+    this->FileOffsets->PartIndices[std::make_pair(std::string(fileName), indexTimeStep)];
+  if (index.Parts.empty() || index.FileSize != this->FileSize)
   {
-    this->ReadPartId(&partId);
-    partId--; // EnSight starts #ing at 1.
-    if (partId < 0 || partId >= MAXIMUM_PART_ID)
+    index.FileSize = this->FileSize;
+    index.Parts.clear();
+    while (lineRead > 0 && strncmp(line, "part", 4) == 0)
     {
-      vtkErrorMacro("Invalid part id; check that ByteOrder is set correctly.");
+      FileOffsetMapInternal::PartOffset part;
+      part.Offset = this->GoldIFile->tellg();
+      this->ReadPartId(&part.Id);
+      part.Id--; // EnSight starts #ing at 1.
+      if (part.Id < 0 || part.Id >= MAXIMUM_PART_ID)
+      {
+        vtkErrorMacro("Invalid part id; check that ByteOrder is set correctly.");
+        index.Parts.clear();
+        return 0;
+      }
+
+      this->ReadLine(line); // part description line
+      this->ReadLine(line);
+      part.Type = GetPartType(line);
+      switch (part.Type)
+      {
+        case PartType::Rectilinear:
+          lineRead = this->SkipRectilinearGrid(line);
+          break;
+        case PartType::Uniform:
+          lineRead = this->SkipImageData(line);
+          break;
+        case PartType::Structured:
+          lineRead = this->SkipStructuredGrid(line);
+          break;
+        default:
+          lineRead = this->SkipUnstructuredGrid(line);
+          break;
+      }
+      index.Parts.push_back(part);
+    }
+
+    if (lineRead < 0)
+    {
+      index.Parts.clear();
+      delete this->GoldIFile;
+      this->GoldIFile = nullptr;
       return 0;
     }
-    realId = this->InsertNewPartId(partId);
+  }
+
+  return this->ReadParts(fileName, indexTimeStep, output);
+}
+
+//------------------------------------------------------------------------------
+int vtkEnSightGoldBinaryReader::GetNumberOfTimeStepsInFile(const char* fileName)
+{
+  auto& counts = this->FileOffsets->NumberOfTimeSteps;
+  auto iter = counts.find(fileName);
+  if (iter != counts.end() && iter->second.FileSize == this->FileSize)
+  {
+    return iter->second.Count;
+  }
+
+  // A file index lists the time steps without reading the whole file. Without
+  // one they are counted, which also caches where each of them begins.
+  const vtkTypeUInt64 fileSize = this->FileSize;
+  this->FileOffsets->Map.erase(fileName);
+  this->AddFileIndexToCache(fileName);
+  int count = static_cast<int>(this->FileOffsets->Map[fileName].size());
+  if (count == 0)
+  {
+    this->GoldIFile->clear();
+    this->GoldIFile->seekg(0l, ios::beg);
+    count = this->CountTimeSteps(fileName);
+  }
+  counts[fileName] = { fileSize, count };
+
+  // this will close the file, so we need to reinitialize it
+  return this->InitializeFile(fileName) ? count : -1;
+}
+
+//------------------------------------------------------------------------------
+int vtkEnSightGoldBinaryReader::ReadParts(
+  const char* fileName, int timeStep, vtkMultiBlockDataSet* output)
+{
+  const std::vector<FileOffsetMapInternal::PartOffset>& parts =
+    this->FileOffsets->PartIndices[std::make_pair(std::string(fileName), timeStep)].Parts;
+  const int numParts = static_cast<int>(parts.size());
+
+  std::vector<int> realIds(numParts);
+  for (int i = 0; i < numParts; i++)
+  {
+    realIds[i] = this->InsertNewPartId(parts[i].Id);
 
     // Increment the number of geometry parts such that the measured geometry,
     // if any, can be properly combined into a vtkMultiBlockDataSet object.
     // --- fix to bug #7453
     this->NumberOfGeometryParts++;
+  }
 
-    this->ReadLine(line); // part description line
+  if (numParts < 2 || vtkSMPTools::GetEstimatedNumberOfThreads() < 2)
+  {
+    int lineRead = 1;
+    for (int i = 0; i < numParts && lineRead >= 0; i++)
+    {
+      lineRead = this->ReadPart(parts[i].Offset, realIds[i], output);
+    }
+    delete this->GoldIFile;
+    this->GoldIFile = nullptr;
+    return lineRead < 0 ? 0 : 1;
+  }
+  delete this->GoldIFile;
+  this->GoldIFile = nullptr;
 
-    strncpy(nameline, line, 80); // 80 characters in line are allowed
-    nameline[79] = '\0';         // Ensure nullptr character at end of part name
-    char* name = strdup(nameline);
+  // The cell id lists of the unstructured parts are created up front, so that
+  // the threads below only fill lists they own.
+  typedef std::array<vtkIdList*, vtkEnSightReader::NUMBER_OF_ELEMENT_TYPES> PartCellIds;
+  std::vector<PartCellIds> cellIds(numParts);
+  for (int i = 0; i < numParts; i++)
+  {
+    if (parts[i].Type == PartType::Unstructured)
+    {
+      if (this->UnstructuredPartIds->IsId(realIds[i]) == -1)
+      {
+        this->UnstructuredPartIds->InsertNextId(realIds[i]);
+      }
+      const int idx = this->UnstructuredPartIds->IsId(realIds[i]);
+      for (int type = 0; type < vtkEnSightReader::NUMBER_OF_ELEMENT_TYPES; type++)
+      {
+        cellIds[i][type] = this->GetCellIds(idx, type);
+      }
+    }
+  }
 
-    // fix to bug #0008237
-    // The original "return 1" operation upon "strncmp(line, "interface", 9) == 0"
-    // was removed here as 'interface' is NOT a keyword of an EnSight Gold file.
+  // Each thread reads its parts through a reader of its own, with a separate
+  // stream on the file, into a single block output. The parts are then moved
+  // into the real output in file order.
+  struct PartResult
+  {
+    vtkSmartPointer<vtkDataSet> DataSet;
+    std::string Name;
+    int Status;
+  };
+  struct Worker
+  {
+    vtkSmartPointer<vtkEnSightGoldBinaryReader> Reader;
+    vtkSmartPointer<vtkMultiBlockDataSet> Output;
+  };
+  std::vector<PartResult> results(numParts);
+  vtkSMPThreadLocal<Worker> workers;
+  const std::string path = GetFullPath(this->FilePath, fileName);
 
-    this->ReadLine(line);
+  vtkSMPTools::For(0, numParts, 1, [&](int begin, int end) {
+    Worker& worker = workers.Local();
+    if (!worker.Reader)
+    {
+      worker.Reader = vtkSmartPointer<vtkEnSightGoldBinaryReader>::New();
+      worker.Output = vtkSmartPointer<vtkMultiBlockDataSet>::New();
+      worker.Reader->ByteOrder = this->ByteOrder;
+      if (!worker.Reader->OpenFile(path.c_str()))
+      {
+        delete worker.Reader->GoldIFile;
+        worker.Reader->GoldIFile = nullptr;
+      }
+      worker.Reader->NodeIdsListed = this->NodeIdsListed;
+      worker.Reader->ElementIdsListed = this->ElementIdsListed;
+    }
+    vtkEnSightGoldBinaryReader* reader = worker.Reader;
 
-    if (strncmp(line, "block", 5) == 0)
+    for (int i = begin; i < end; i++)
     {
-      if (sscanf(line, " %*s %s", subLine) == 1)
+      if (!reader->GoldIFile)
       {
-        if (strncmp(subLine, "rectilinear", 11) == 0)
-        {
-          // block rectilinear
-          lineRead = this->CreateRectilinearGridOutput(realId, line, name, output);
-        }
-        else if (strncmp(subLine, "uniform", 7) == 0)
-        {
-          // block uniform
-          lineRead = this->CreateImageDataOutput(realId, line, name, output);
-        }
-        else
-        {
-          // block iblanked
-          lineRead = this->CreateStructuredGridOutput(realId, line, name, output);
-        }
+        results[i].Status = -1;
+        continue;
       }
-      else
+
+      // With a single part per read, the cell ids of the worker are at index 0.
+      worker.Output->SetBlock(0, nullptr);
+      reader->UnstructuredPartIds->Reset();
+      results[i].Status = reader->ReadPart(parts[i].Offset, 0, worker.Output);
+      results[i].DataSet = reader->GetDataSetFromBlock(worker.Output, 0);
+      const char* name = worker.Output->GetMetaData(0u)->Get(vtkCompositeDataSet::NAME());
+      results[i].Name = name ? name : "";
+      if (parts[i].Type == PartType::Unstructured && results[i].Status >= 0)
       {
-        // block
-        lineRead = this->CreateStructuredGridOutput(realId, line, name, output);
+        for (int type = 0; type < vtkEnSightReader::NUMBER_OF_ELEMENT_TYPES; type++)
+        {
+          cellIds[i][type]->DeepCopy(reader->GetCellIds(0, type));
+        }
       }
     }
-    else
+  });
+
+  for (int i = 0; i < numParts; i++)
+  {
+    if (results[i].Status < 0)
     {
-      lineRead = this->CreateUnstructuredGridOutput(realId, line, name, output);
-      if (lineRead < 0)
-      {
-        free(name);
-        delete this->GoldIFile;
-        this->GoldIFile = nullptr;
-        return 0;
-      }
+      return 0;
     }
-    free(name);
+    output->SetBlock(realIds[i], results[i].DataSet);
+    this->SetBlockName(output, realIds[i], results[i].Name.c_str());
+    this->NumberOfNewOutputs++;
   }
+  return 1;
+}
 
-  delete this->GoldIFile;
-  this->GoldIFile = nullptr;
+//------------------------------------------------------------------------------
+int vtkEnSightGoldBinaryReader::ReadPart(
+  vtkTypeInt64 offset, int partId, vtkMultiBlockDataSet* output)
+{
+  char line[80], nameline[80];
+  int filePartId;
 
-  if (lineRead < 0)
+  // A previous part may have been read up to the end of the file.
+  this->GoldIFile->clear();
+  this->GoldIFile->seekg(offset, ios::beg);
+  this->ReadPartId(&filePartId);
+
+  this->ReadLine(line); // part description line
+  strncpy(nameline, line, 80); // 80 characters in line are allowed
+  nameline[79] = '\0';         // Ensure nullptr character at end of part name
+
+  // fix to bug #0008237
+  // The original "return 1" operation upon "strncmp(line, "interface", 9) == 0"
+  // was removed here as 'interface' is NOT a keyword of an EnSight Gold file.
+
+  this->ReadLine(line);
+
+  switch (GetPartType(line))
   {
-    return 0;
+    case PartType::Rectilinear:
+      return this->CreateRectilinearGridOutput(partId, line, nameline, output);
+    case PartType::Uniform:
+      return this->CreateImageDataOutput(partId, line, nameline, output);
+    case PartType::Structured:
+      return this->CreateStructuredGridOutput(partId, line, nameline, output);
+    default:
+      return this->CreateUnstructuredGridOutput(partId, line, nameline, output);
   }
-
-  return 1;
 }
 
 //------------------------------------------------------------------------------
-int vtkEnSightGoldBinaryReader::CountTimeSteps()
+int vtkEnSightGoldBinaryReader::CountTimeSteps(const char* fileName)
 {
   int count = 0;
+  vtkTypeInt64 offset;
   while (true)
   {
-    int result = this->SkipTimeStep();
+    int result = this->SkipTimeStep(&offset);
     if (result)
     {
+      if (fileName)
+      {
+        this->AddTimeStepToCache(fileName, count, offset);
+      }
       count++;
     }
     else
@@ -580,7 +811,7 @@ int vtkEnSightGoldBinaryReader::CountTimeSteps()
 }
 
 //------------------------------------------------------------------------------
-int vtkEnSightGoldBinaryReader::SkipTimeStep()
+int vtkEnSightGoldBinaryReader::SkipTimeStep(vtkTypeInt64* beginOffset)
 {
   char line[80], subLine[80];
   int lineRead;
@@ -593,6 +824,10 @@ int vtkEnSightGoldBinaryReader::SkipTimeStep()
       return 0;
     }
   }
+  if (beginOffset)
+  {
+    *beginOffset = this->GoldIFile->tellg();
+  }
 
   // Skip the 2 description lines.
   this->ReadLine(line);
@@ -645,35 +880,20 @@ int vtkEnSightGoldBinaryReader::SkipTimeStep()
     this->ReadLine(line); // part description line
     this->ReadLine(line);
 
-    if (strncmp(line, "block", 5) == 0)
+    switch (GetPartType(line))
     {
-      if (sscanf(line, " %*s %s", subLine) == 1)
-      {
-        if (strncmp(subLine, "rectilinear", 11) == 0)
-        {
-          // block rectilinear
-          lineRead = this->SkipRectilinearGrid(line);
-        }
-        else if (strncmp(subLine, "uniform,", 7) == 0)
-        {
-          // block uniform
-          lineRead = this->SkipImageData(line);
-        }
-        else
-        {
-          // block iblanked
-          lineRead = this->SkipStructuredGrid(line);
-        }
-      }
-      else
-      {
-        // block
+      case PartType::Rectilinear:
+        lineRead = this->SkipRectilinearGrid(line);
+        break;
+      case PartType::Uniform:
+        lineRead = this->SkipImageData(line);
+        break;
+      case PartType::Structured:
         lineRead = this->SkipStructuredGrid(line);
-      }
-    }
-    else
-    {
-      lineRead = this->SkipUnstructuredGrid(line);
+        break;
+      default:
+        lineRead = this->SkipUnstructuredGrid(line);
+        break;
     }
   }
 
@@ -1927,7 +2147,7 @@ int vtkEnSightGoldBinaryReader::CreateUnstructuredGridOutput(
       vtkPoints* points = vtkPoints::New();
       vtkDebugMacro("num. points: " << numPts);
 
-      points->Allocate(numPts);
+      points->SetNumberOfPoints(numPts);
 
       if (this->NodeIdsListed)
       {
@@ -1941,10 +2161,16 @@ int vtkEnSightGoldBinaryReader::CreateUnstructuredGridOutput(
       this->ReadFloatArray(yCoords, numPts);
       this->ReadFloatArray(zCoords, numPts);
 
-      for (i = 0; i < numPts; i++)
-      {
-        points->InsertNextPoint(xCoords[i], yCoords[i], zCoords[i]);
-      }
+      // Interleave the coordinates straight into the float point array.
+      float* xyz = vtkFloatArray::SafeDownCast(points->GetData())->GetPointer(0);
+      vtkSMPTools::For(0, static_cast<vtkIdType>(numPts), [&](vtkIdType begin, vtkIdType end) {
+        for (vtkIdType pt = begin; pt < end; pt++)
+        {
+          xyz[3 * pt] = xCoords[pt];
+          xyz[3 * pt + 1] = yCoords[pt];
+          xyz[3 * pt + 2] = zCoords[pt];
+        }
+      });
 
       output->SetPoints(points);
       points->Delete();
@@ -33,6 +33,11 @@
  * what types they will be.
  * This reader can only handle static EnSight datasets (both static geometry
  * and variables).
+ * @par Performance:
+ * The offsets of the time steps and of the parts of each time step in a
+ * geometry file are cached the first time they are read, so that changing
+ * the time step seeks straight to the data. The parts of a time step are
+ * read and converted concurrently using vtkSMPTools.
  * @par Thanks:
  * Thanks to Yvan Fournier for providing the code to support nfaced elements.
  */
@@ -207,14 +212,17 @@ protected:
    * This function assumes the file is already open and returns the
    * number of timesteps remaining in the file
    * The file will be closed after calling this method
+   * If a file name is given, the offset of each time step is cached for it.
    */
-  int CountTimeSteps();
+  int CountTimeSteps(const char* fileName = nullptr);
 
   ///@{
   /**
    * Read to the next time step in the geometry file.
+   * SkipTimeStep optionally returns the offset just past the
+   * BEGIN TIME STEP line of the skipped step.
    */
-  int SkipTimeStep();
+  int SkipTimeStep(vtkTypeInt64* beginOffset = nullptr);
   int SkipStructuredGrid(char line[256]);
   int SkipUnstructuredGrid(char line[256]);
   int SkipRectilinearGrid(char line[256]);
@@ -253,6 +261,25 @@ private:
   vtkEnSightGoldBinaryReader(const vtkEnSightGoldBinaryReader&) = delete;
   void operator=(const vtkEnSightGoldBinaryReader&) = delete;
 
+  /**
+   * Returns the number of time steps in the open geometry file, which is only
+   * counted the first time the file is read. The file is reopened afterwards.
+   * Returns -1 if that fails.
+   */
+  int GetNumberOfTimeStepsInFile(const char* fileName);
+
+  /**
+   * Reads the parts indexed for a time step of a geometry file, concurrently
+   * when there is more than one part and more than one thread.
+   */
+  int ReadParts(const char* fileName, int timeStep, vtkMultiBlockDataSet* output);
+
+  /**
+   * Reads the part found at the given file offset into block partId of the
+   * output. Returns the result of the matching Create*Output method.
+   */
+  int ReadPart(vtkTypeInt64 offset, int partId, vtkMultiBlockDataSet* output);
+
   /**
    * Opens a variable file name. This will compute the full path and then open
    * it. `variableType` is simply used to report helpful error messages.
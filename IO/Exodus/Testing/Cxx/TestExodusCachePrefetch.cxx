@@ -0,0 +1,233 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestExodusCachePrefetch.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Steps through the time steps of can.ex2 with a reader that prefetches the
+// next time step into a cache shared with a second reader, and checks that
+// the output matches a reader with neither feature and that the prefetched
+// arrays are found in the cache, unlike with a reader that does not prefetch.
+
+#include "vtkCompositeDataIterator.h"
+#include "vtkDataArray.h"
+#include "vtkDataSet.h"
+#include "vtkExecutive.h"
+#include "vtkExodusIIReader.h"
+#include "vtkInformation.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkSmartPointer.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkTestUtilities.h"
+
+#include <vector>
+
+namespace
+{
+void SetUpReader(vtkExodusIIReader* reader, const char* fname)
+{
+  reader->SetFileName(fname);
+  reader->UpdateInformation();
+  reader->SetAllArrayStatus(vtkExodusIIReader::NODAL, 1);
+  reader->SetAllArrayStatus(vtkExodusIIReader::ELEM_BLOCK, 1);
+  reader->GenerateGlobalNodeIdArrayOn();
+  reader->GenerateImplicitNodeIdArrayOn();
+}
+
+bool SameOutput(vtkMultiBlockDataSet* a, vtkMultiBlockDataSet* b)
+{
+  auto iterA = vtk::TakeSmartPointer(a->NewIterator());
+  auto iterB = vtk::TakeSmartPointer(b->NewIterator());
+  for (iterA->InitTraversal(), iterB->InitTraversal(); !iterA->IsDoneWithTraversal();
+       iterA->GoToNextItem(), iterB->GoToNextItem())
+  {
+    if (iterB->IsDoneWithTraversal())
+    {
+      cerr << "Different number of blocks\n";
+      return false;
+    }
+    vtkDataSet* dsA = vtkDataSet::SafeDownCast(iterA->GetCurrentDataObject());
+    vtkDataSet* dsB = vtkDataSet::SafeDownCast(iterB->GetCurrentDataObject());
+    if (!dsA || !dsB || dsA->GetNumberOfPoints() != dsB->GetNumberOfPoints() ||
+      dsA->GetPointData()->GetNumberOfArrays() != dsB->GetPointData()->GetNumberOfArrays())
+    {
+      cerr << "Blocks differ\n";
+      return false;
+    }
+    for (int i = 0; i < dsA->GetPointData()->GetNumberOfArrays(); ++i)
+    {
+      vtkDataArray* arrA = dsA->GetPointData()->GetArray(i);
+      vtkDataArray* arrB = dsB->GetPointData()->GetArray(i);
+      if (arrA->GetNumberOfValues() != arrB->GetNumberOfValues())
+      {
+        cerr << "Array " << i << " differs\n";
+        return false;
+      }
+      for (vtkIdType j = 0; j < arrA->GetNumberOfValues(); ++j)
+      {
+        if (arrA->GetVariantValue(j) != arrB->GetVariantValue(j))
+        {
+          cerr << "Value " << j << " of array " << i << " differs\n";
+          return false;
+        }
+      }
+    }
+    for (vtkIdType j = 0; j < dsA->GetNumberOfPoints(); ++j)
+    {
+      double x[3], y[3];
+      dsA->GetPoint(j, x);
+      dsB->GetPoint(j, y);
+      if (x[0] != y[0] || x[1] != y[1] || x[2] != y[2])
+      {
+        cerr << "Point " << j << " differs\n";
+        return false;
+      }
+    }
+  }
+  return true;
+}
+}
+
+int TestExodusCachePrefetch(int argc, char* argv[])
+{
+  char* fname = vtkTestUtilities::ExpandDataFileName(argc, argv, "Data/can.ex2");
+  if (!fname)
+  {
+    cout << "Could not obtain filename for test data.\n";
+    return EXIT_FAILURE;
+  }
+
+  vtkNew<vtkExodusIIReader> plain;
+  SetUpReader(plain, fname);
+
+  vtkNew<vtkExodusIIReader> prefetching;
+  SetUpReader(prefetching, fname);
+  prefetching->SetCacheSize(64.);
+  prefetching->ShareCacheOn();
+  prefetching->PrefetchTimeStepsOn();
+
+  vtkNew<vtkExodusIIReader> caching;
+  SetUpReader(caching, fname);
+  caching->SetCacheSize(64.);
+
+  vtkNew<vtkExodusIIReader> sharing;
+  SetUpReader(sharing, fname);
+  sharing->SetCacheSize(64.);
+  sharing->ShareCacheOn();
+  delete[] fname;
+
+  vtkInformation* outInfo = plain->GetExecutive()->GetOutputInformation(0);
+  int numSteps = outInfo->Length(vtkStreamingDemandDrivenPipeline::TIME_STEPS());
+  std::vector<double> times(numSteps);
+  outInfo->Get(vtkStreamingDemandDrivenPipeline::TIME_STEPS(), times.data());
+  if (numSteps < 3)
+  {
+    cerr << "Expected several time steps, got " << numSteps << "\n";
+    return EXIT_FAILURE;
+  }
+
+  // Every step after the first one has been prefetched, so it misses the
+  // cache no more than executing again a step already in the cache, which
+  // only misses the arrays absent from the file: the time independent arrays
+  // were read by the first step and the time dependent ones by the prefetch.
+  // A reader that does not prefetch misses the time dependent ones instead.
+  vtkIdType cachedStepMisses = 0;
+  for (int step = 0; step < numSteps; ++step)
+  {
+    plain->UpdateTimeStep(times[step]);
+    prefetching->UpdateTimeStep(times[step]);
+    caching->UpdateTimeStep(times[step]);
+    if (!SameOutput(plain->GetOutput(), prefetching->GetOutput()))
+    {
+      cerr << "Prefetching output differs at time step " << step << "\n";
+      return EXIT_FAILURE;
+    }
+    if (step == 0)
+    {
+      prefetching->ResetCacheStatistics();
+      prefetching->Modified();
+      prefetching->UpdateTimeStep(times[step]);
+      cachedStepMisses = prefetching->GetCacheMisses();
+      prefetching->ResetCacheStatistics();
+      caching->ResetCacheStatistics();
+    }
+  }
+  vtkIdType expectedMisses = cachedStepMisses * (numSteps - 1);
+  if (prefetching->GetCacheMisses() != expectedMisses || prefetching->GetCacheHits() == 0)
+  {
+    cerr << "Prefetching reader missed the cache " << prefetching->GetCacheMisses()
+         << " times, expected " << expectedMisses << "\n";
+    return EXIT_FAILURE;
+  }
+  if (caching->GetCacheMisses() <= expectedMisses)
+  {
+    cerr << "Reader without prefetch missed the cache only " << caching->GetCacheMisses()
+         << " times\n";
+    return EXIT_FAILURE;
+  }
+
+  // The second reader finds in the shared cache what the first one read.
+  // The statistics are kept per reader.
+  vtkIdType prefetchingHits = prefetching->GetCacheHits();
+  sharing->UpdateTimeStep(times[1]);
+  sharing->ResetCacheStatistics();
+  sharing->UpdateTimeStep(times[2]);
+  plain->UpdateTimeStep(times[2]);
+  if (!SameOutput(plain->GetOutput(), sharing->GetOutput()))
+  {
+    cerr << "Sharing output differs\n";
+    return EXIT_FAILURE;
+  }
+  if (sharing->GetCacheHits() == 0)
+  {
+    cerr << "Sharing reader never hit the shared cache\n";
+    return EXIT_FAILURE;
+  }
+  if (prefetching->GetCacheHits() != prefetchingHits)
+  {
+    cerr << "The statistics of a reader count the lookups of another one\n";
+    return EXIT_FAILURE;
+  }
+
+  // The node ids are squeezed through the point map of each reader, they are
+  // not shared and are read again once the points are no longer squeezed.
+  sharing->SetSqueezePoints(false);
+  plain->SetSqueezePoints(false);
+  sharing->UpdateTimeStep(times[2]);
+  plain->UpdateTimeStep(times[2]);
+  if (!SameOutput(plain->GetOutput(), sharing->GetOutput()))
+  {
+    cerr << "Sharing output differs without squeezing the points\n";
+    return EXIT_FAILURE;
+  }
+  plain->SetSqueezePoints(true);
+
+  // Stepping backwards prefetches the preceding step.
+  prefetching->UpdateTimeStep(times[numSteps - 2]);
+  prefetching->ResetCacheStatistics();
+  prefetching->UpdateTimeStep(times[numSteps - 3]);
+  plain->UpdateTimeStep(times[numSteps - 3]);
+  if (!SameOutput(plain->GetOutput(), prefetching->GetOutput()))
+  {
+    cerr << "Prefetching output differs when stepping backwards\n";
+    return EXIT_FAILURE;
+  }
+  if (prefetching->GetCacheMisses() != cachedStepMisses)
+  {
+    cerr << "Preceding step was not prefetched, " << prefetching->GetCacheMisses()
+         << " cache misses instead of " << cachedStepMisses << "\n";
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -73,6 +73,8 @@ vtkExodusIICache::vtkExodusIICache()
 {
   this->Size = 0.;
   this->Capacity = 2.;
+  this->Hits = 0;
+  this->Misses = 0;
 }
 
 vtkExodusIICache::~vtkExodusIICache()
@@ -82,21 +84,26 @@ vtkExodusIICache::~vtkExodusIICache()
 
 void vtkExodusIICache::PrintSelf(ostream& os, vtkIndent indent)
 {
+  std::lock_guard<std::recursive_mutex> lock(this->Mutex);
   this->Superclass::PrintSelf(os, indent);
   os << indent << "Capacity: " << this->Capacity << " MiB\n";
   os << indent << "Size: " << this->Size << " MiB\n";
   os << indent << "Cache: " << &this->Cache << " (" << this->Cache.size() << ")\n";
   os << indent << "LRU: " << &this->LRU << "\n";
+  os << indent << "Hits: " << this->Hits << "\n";
+  os << indent << "Misses: " << this->Misses << "\n";
 }
 
 void vtkExodusIICache::Clear()
 {
   // printCache( this->Cache, this->LRU );
+  std::lock_guard<std::recursive_mutex> lock(this->Mutex);
   this->ReduceToSize(0.);
 }
 
 void vtkExodusIICache::SetCacheCapacity(double sizeInMiB)
 {
+  std::lock_guard<std::recursive_mutex> lock(this->Mutex);
   if (sizeInMiB == this->Capacity)
     return;
 
@@ -108,8 +115,15 @@ void vtkExodusIICache::SetCacheCapacity(double sizeInMiB)
   this->Capacity = sizeInMiB < 0 ? 0 : sizeInMiB;
 }
 
+double vtkExodusIICache::GetCacheCapacity()
+{
+  std::lock_guard<std::recursive_mutex> lock(this->Mutex);
+  return this->Capacity;
+}
+
 int vtkExodusIICache::ReduceToSize(double newSize)
 {
+  std::lock_guard<std::recursive_mutex> lock(this->Mutex);
   int deletedSomething = 0;
   while (this->Size > newSize && !this->LRU.empty())
   {
@@ -153,6 +167,7 @@ int vtkExodusIICache::ReduceToSize(double newSize)
 
 void vtkExodusIICache::Insert(vtkExodusIICacheKey& key, vtkDataArray* value)
 {
+  std::lock_guard<std::recursive_mutex> lock(this->Mutex);
   double vsize = value ? value->GetActualMemorySize() / 1024. : 0.;
 
   vtkExodusIICacheRef it = this->Cache.find(key);
@@ -194,24 +209,47 @@ void vtkExodusIICache::Insert(vtkExodusIICacheKey& key, vtkDataArray* value)
   // printCache( this->Cache, this->LRU );
 }
 
-vtkDataArray*& vtkExodusIICache::Find(const vtkExodusIICacheKey& key)
+vtkDataArray*& vtkExodusIICache::Find(const vtkExodusIICacheKey& key, bool countLookup)
 {
-  static vtkDataArray* dummy = nullptr;
+  static thread_local vtkDataArray* dummy = nullptr;
 
+  std::lock_guard<std::recursive_mutex> lock(this->Mutex);
   vtkExodusIICacheRef it = this->Cache.find(key);
   if (it != this->Cache.end())
   {
+    this->Hits += countLookup ? 1 : 0;
     this->LRU.erase(it->second->LRUEntry);
     it->second->LRUEntry = this->LRU.insert(this->LRU.begin(), it);
     return it->second->Value;
   }
 
+  this->Misses += countLookup ? 1 : 0;
   dummy = nullptr;
   return dummy;
 }
 
+vtkIdType vtkExodusIICache::GetHits()
+{
+  std::lock_guard<std::recursive_mutex> lock(this->Mutex);
+  return this->Hits;
+}
+
+vtkIdType vtkExodusIICache::GetMisses()
+{
+  std::lock_guard<std::recursive_mutex> lock(this->Mutex);
+  return this->Misses;
+}
+
+void vtkExodusIICache::ResetStatistics()
+{
+  std::lock_guard<std::recursive_mutex> lock(this->Mutex);
+  this->Hits = 0;
+  this->Misses = 0;
+}
+
 int vtkExodusIICache::Invalidate(const vtkExodusIICacheKey& key)
 {
+  std::lock_guard<std::recursive_mutex> lock(this->Mutex);
   vtkExodusIICacheRef it = this->Cache.find(key);
   if (it != this->Cache.end())
   {
@@ -241,6 +279,7 @@ int vtkExodusIICache::Invalidate(const vtkExodusIICacheKey& key)
 
 int vtkExodusIICache::Invalidate(const vtkExodusIICacheKey& key, const vtkExodusIICacheKey& pattern)
 {
+  std::lock_guard<std::recursive_mutex> lock(this->Mutex);
   vtkExodusIICacheRef it;
   int nDropped = 0;
   it = this->Cache.begin();
@@ -22,12 +22,19 @@
 // entries O(1). Each cache entry stores an iterator into
 // the list of references so that it can be located quickly for
 // removal.
+//
+// All members of vtkExodusIICache lock an internal mutex so that a cache may
+// be filled by a prefetching thread and shared between readers of the same
+// file. Arrays returned by Find() are only guaranteed to stay alive for as long
+// as no other thread inserts into the cache; the reader serializes its file
+// access to make sure of that.
 
 #include "vtkIOExodusModule.h" // For export macro
 #include "vtkObject.h"
 
-#include <list> // use for LRU ordering
-#include <map>  // used for cache storage
+#include <list>  // use for LRU ordering
+#include <map>   // used for cache storage
+#include <mutex> // for std::recursive_mutex
 
 class VTKIOEXODUS_EXPORT vtkExodusIICacheKey
 {
@@ -145,10 +152,23 @@ public:
   /// Insert an entry into the cache (this can remove other cache entries to make space).
   void Insert(vtkExodusIICacheKey& key, vtkDataArray* value);
 
+  /// Get the maximum allowable cache size in MiB.
+  double GetCacheCapacity();
+
   /** Determine whether a cache entry exists. If it does, return it -- otherwise return nullptr.
    * If a cache entry exists, it is marked as most recently used.
+   * Unless \a countLookup is false, the lookup is counted as a hit or a miss.
+   */
+  vtkDataArray*& Find(const vtkExodusIICacheKey&, bool countLookup = true);
+
+  ///@{
+  /** Number of lookups with Find() that did or did not find an entry since the
+   * cache was created or ResetStatistics() was called.
    */
-  vtkDataArray*& Find(const vtkExodusIICacheKey&);
+  vtkIdType GetHits();
+  vtkIdType GetMisses();
+  void ResetStatistics();
+  ///@}
 
   /** Invalidate a cache entry (drop it from the cache) if the key exists.
    * This does nothing if the cache entry does not exist.
@@ -195,6 +215,13 @@ protected:
   /// The actual LRU list (indices into the cache ordered least to most recently used).
   vtkExodusIICacheLRU LRU;
 
+  /// Lookup statistics.
+  vtkIdType Hits;
+  vtkIdType Misses;
+
+  /// Guards all of the above.
+  std::recursive_mutex Mutex;
+
 private:
   vtkExodusIICache(const vtkExodusIICache&) = delete;
   void operator=(const vtkExodusIICache&) = delete;
@@ -49,12 +49,15 @@
 #include "vtkUnsignedCharArray.h"
 #include "vtkUnstructuredGrid.h"
 #include "vtkVariantArray.h"
+#include "vtkWeakPointer.h"
 #include "vtkXMLParser.h"
 
 #include "vtksys/SystemTools.hxx"
 #include <algorithm>
 #include <deque>
+#include <iterator>
 #include <map>
+#include <mutex>
 #include <set>
 #include <string>
 #include <vector>
@@ -314,6 +317,12 @@ vtkExodusIIReaderPrivate::vtkExodusIIReaderPrivate()
 
   this->Cache = vtkExodusIICache::New();
   this->CacheSize = 0;
+  this->SharedCache = nullptr;
+  this->CancelPrefetch = false;
+  this->Prefetching = false;
+  this->PrefetchTimeStep = -1;
+  this->CacheHits = 0;
+  this->CacheMisses = 0;
 
   this->HasModeShapes = 0;
   this->ModeShapeTime = -1.;
@@ -345,7 +354,9 @@ vtkExodusIIReaderPrivate::vtkExodusIIReaderPrivate()
 //------------------------------------------------------------------------------
 vtkExodusIIReaderPrivate::~vtkExodusIIReaderPrivate()
 {
+  this->WaitForPrefetch(true);
   this->CloseFile();
+  this->SetSharedCache(nullptr);
   this->Cache->Delete();
   this->CacheSize = 0;
   this->ClearConnectivityCaches();
@@ -1588,7 +1599,25 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead(vtkExodusIICacheKey key)
   }
   else
   {
-    arr = this->Cache->Find(key);
+    // Lookups made while prefetching are not counted, so that the statistics
+    // reflect what RequestData() found in the cache.
+    arr = this->GetCacheForKey(key)->Find(key, !this->Prefetching);
+    if (!this->Prefetching)
+    {
+      if (arr)
+      {
+        this->CacheHits++;
+      }
+      else
+      {
+        this->CacheMisses++;
+      }
+    }
+  }
+
+  if (key.Time >= 0 && !this->Prefetching)
+  {
+    this->TimeStepKeys.insert(key);
   }
 
   if (arr)
@@ -2091,8 +2120,11 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead(vtkExodusIICacheKey key)
       }
       arr = iarr;
     }
-    else
+    else if (src)
     {
+      // FastDelete will be called below, but src belongs to the cache entry
+      // of NODE_ID, so reference it one extra time.
+      src->Register(this);
       arr = src;
     }
   }
@@ -2138,12 +2170,12 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead(vtkExodusIICacheKey key)
         gloIds[it->second] = srcIds[it->first];
       }
       arr = iarr;
+      src->Delete();
     }
     else
     {
       arr = src;
     }
-    src->Delete();
   }
   else if (key.ObjectType == vtkExodusIIReader::ELEMENT_ID ||
     key.ObjectType == vtkExodusIIReader::EDGE_ID || key.ObjectType == vtkExodusIIReader::FACE_ID ||
@@ -2896,12 +2928,26 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead(vtkExodusIICacheKey key)
   // GetCacheOrRead(), you better start running!
   if (arr)
   {
-    this->Cache->Insert(key, arr);
+    this->GetCacheForKey(key)->Insert(key, arr);
     arr->FastDelete();
   }
   return arr;
 }
 
+//------------------------------------------------------------------------------
+vtkExodusIICache* vtkExodusIIReaderPrivate::GetCacheForKey(const vtkExodusIICacheKey& key)
+{
+  // Coordinates depend on the displacement settings of each reader, and they
+  // and the node ids are squeezed through the point maps of each reader.
+  if (this->SharedCache && key.ObjectType != vtkExodusIIReader::NODAL_COORDS &&
+    key.ObjectType != vtkExodusIIReader::GLOBAL_NODE_ID &&
+    key.ObjectType != vtkExodusIIReader::IMPLICIT_NODE_ID)
+  {
+    return this->SharedCache;
+  }
+  return this->Cache;
+}
+
 //------------------------------------------------------------------------------
 int vtkExodusIIReaderPrivate::GetConnTypeIndexFromConnType(int ctyp)
 {
@@ -3721,6 +3767,8 @@ void vtkExodusIIReader::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "IgnoreFileTime: " << this->GetIgnoreFileTime() << "\n";
   os << indent << "SILUpdateStamp: " << this->SILUpdateStamp << "\n";
   os << indent << "UseLegacyBlockNames: " << this->UseLegacyBlockNames << "\n";
+  os << indent << "ShareCache: " << this->ShareCache << "\n";
+  os << indent << "PrefetchTimeSteps: " << this->PrefetchTimeSteps << "\n";
   if (this->Metadata)
   {
     os << indent << "Metadata:\n";
@@ -4529,6 +4577,10 @@ int vtkExodusIIReaderPrivate::RequestData(vtkIdType timeStep, vtkMultiBlockDataS
     vtkErrorMacro("You must specify an output mesh");
   }
 
+  // Remember the time dependent arrays read for this step so that
+  // StartPrefetch() can read the same ones for another step.
+  this->TimeStepKeys.clear();
+
   // Iterate over all block and set types, creating a
   // multiblock dataset to hold objects of each type.
   int conntypidx;
@@ -4759,7 +4811,9 @@ int vtkExodusIIReaderPrivate::SetUpEmptyGrid(vtkMultiBlockDataSet* output)
 void vtkExodusIIReaderPrivate::Reset()
 {
   vtkLogF(TRACE, "vtkExodusIIReaderPrivate(%p)::Reset", this);
+  this->WaitForPrefetch(true);
   this->CloseFile();
+  this->SetSharedCache(nullptr);
   this->ResetCache(); // must come before BlockInfo and SetInfo are cleared.
   this->BlockInfo.clear();
   this->SetInfo.clear();
@@ -4783,6 +4837,7 @@ void vtkExodusIIReaderPrivate::Reset()
 
 void vtkExodusIIReaderPrivate::ResetSettings()
 {
+  this->WaitForPrefetch(true);
   this->GenerateGlobalElementIdArray = 0;
   this->GenerateGlobalNodeIdArray = 0;
   this->GenerateImplicitElementIdArray = 0;
@@ -4806,6 +4861,7 @@ void vtkExodusIIReaderPrivate::ResetSettings()
 
 void vtkExodusIIReaderPrivate::ResetCache()
 {
+  this->WaitForPrefetch(true);
   this->Cache->Clear();
   this->Cache->SetCacheCapacity(
     this->CacheSize); // FIXME: Perhaps Cache should have a Reset and a Clear method?
@@ -4816,12 +4872,112 @@ void vtkExodusIIReaderPrivate::SetCacheSize(double size)
 {
   if (this->CacheSize != size)
   {
+    this->WaitForPrefetch(true);
     this->CacheSize = size;
     this->Cache->SetCacheCapacity(this->CacheSize);
     this->Modified();
   }
 }
 
+void vtkExodusIIReaderPrivate::SetSharedCache(vtkExodusIICache* cache)
+{
+  if (this->SharedCache == cache)
+  {
+    return;
+  }
+  this->WaitForPrefetch(true);
+  if (this->SharedCache)
+  {
+    this->SharedCache->UnRegister(this);
+  }
+  this->SharedCache = cache;
+  if (this->SharedCache)
+  {
+    this->SharedCache->Register(this);
+  }
+}
+
+vtkIdType vtkExodusIIReaderPrivate::GetCacheHits()
+{
+  return this->CacheHits;
+}
+
+vtkIdType vtkExodusIIReaderPrivate::GetCacheMisses()
+{
+  return this->CacheMisses;
+}
+
+void vtkExodusIIReaderPrivate::ResetCacheStatistics()
+{
+  this->CacheHits = 0;
+  this->CacheMisses = 0;
+}
+
+std::mutex& vtkExodusIIReaderPrivate::GetIOMutex()
+{
+  static std::mutex ioMutex;
+  return ioMutex;
+}
+
+void vtkExodusIIReaderPrivate::StartPrefetch(const char* filename, int timeStep)
+{
+  this->WaitForPrefetch(true);
+  if (!filename || this->TimeStepKeys.empty())
+  {
+    return;
+  }
+
+  std::vector<vtkExodusIICacheKey> keys;
+  keys.reserve(this->TimeStepKeys.size());
+  for (vtkExodusIICacheKey key : this->TimeStepKeys)
+  {
+    key.Time = timeStep;
+    keys.push_back(key);
+  }
+  this->PrefetchTimeStep = timeStep;
+  this->PrefetchThread = std::thread(
+    &vtkExodusIIReaderPrivate::Prefetch, this, std::string(filename), std::move(keys));
+}
+
+void vtkExodusIIReaderPrivate::WaitForPrefetch(bool cancel)
+{
+  if (this->PrefetchThread.joinable())
+  {
+    this->CancelPrefetch = cancel;
+    this->PrefetchThread.join();
+    this->CancelPrefetch = false;
+  }
+}
+
+void vtkExodusIIReaderPrivate::Prefetch(std::string filename, std::vector<vtkExodusIICacheKey> keys)
+{
+  std::lock_guard<std::mutex> lock(vtkExodusIIReaderPrivate::GetIOMutex());
+  if (this->CancelPrefetch || !this->OpenFile(filename.c_str()))
+  {
+    return;
+  }
+
+  this->Prefetching = true;
+  for (const vtkExodusIICacheKey& key : keys)
+  {
+    if (this->CancelPrefetch)
+    {
+      break;
+    }
+    try
+    {
+      this->GetCacheOrRead(key);
+    }
+    catch (const std::exception&)
+    {
+      // Whatever failed here is reported when the time step is requested.
+      break;
+    }
+  }
+  this->Prefetching = false;
+  this->CloseFile();
+}
+
 bool vtkExodusIIReaderPrivate::IsXMLMetadataValid()
 {
   // Make sure that each block id referred to in the metadata arrays exist
@@ -4858,9 +5014,18 @@ void vtkExodusIIReaderPrivate::SetSqueezePoints(int sp)
   if (this->SqueezePoints == sp)
     return;
 
+  this->WaitForPrefetch(true);
   this->SqueezePoints = sp;
   this->Modified();
 
+  // The coordinates and node ids are squeezed or not when read:
+  this->Cache->Invalidate(
+    vtkExodusIICacheKey(0, vtkExodusIIReader::NODAL_COORDS, 0, 0), vtkExodusIICacheKey(0, 1, 0, 0));
+  this->Cache->Invalidate(vtkExodusIICacheKey(0, vtkExodusIIReader::GLOBAL_NODE_ID, 0, 0),
+    vtkExodusIICacheKey(0, 1, 0, 0));
+  this->Cache->Invalidate(vtkExodusIICacheKey(0, vtkExodusIIReader::IMPLICIT_NODE_ID, 0, 0),
+    vtkExodusIICacheKey(0, 1, 0, 0));
+
   // Invalidate global "topology" cache
   // The point maps should be invalidated
   // FIXME: bsinfop->NextSqueezePoint = 0 for all bsinfop
@@ -4960,6 +5125,7 @@ void vtkExodusIIReaderPrivate::SetObjectStatus(int otyp, int k, int stat)
   { // no change => do nothing
     return;
   }
+  this->WaitForPrefetch(true);
   oinfop->Status = stat;
   this->Modified();
 }
@@ -4981,6 +5147,7 @@ void vtkExodusIIReaderPrivate::SetUnsortedObjectStatus(int otyp, int k, int stat
   { // no change => do nothing
     return;
   }
+  this->WaitForPrefetch(true);
   oinfop->Status = stat;
 
   this->Modified();
@@ -5099,6 +5266,7 @@ void vtkExodusIIReaderPrivate::SetObjectArrayStatus(int otyp, int i, int stat)
       // no change => do nothing
       return;
     }
+    this->WaitForPrefetch(true);
     it->second[i].Status = stat;
     this->Modified();
     // FIXME: Mark something so we know what's changed since the last RequestData?!
@@ -5108,8 +5276,8 @@ void vtkExodusIIReaderPrivate::SetObjectArrayStatus(int otyp, int i, int stat)
     // it was any faster before.
     // vtkExodusIICacheKey key( 0, GLOBAL, 0, i );
     // vtkExodusIICacheKey pattern( 0, 1, 0, 1 );
-    this->Cache->Invalidate(
-      vtkExodusIICacheKey(0, vtkExodusIIReader::GLOBAL, otyp, i), vtkExodusIICacheKey(0, 1, 1, 1));
+    vtkExodusIICacheKey key(0, vtkExodusIIReader::GLOBAL, otyp, i);
+    this->GetCacheForKey(key)->Invalidate(key, vtkExodusIICacheKey(0, 1, 1, 1));
   }
   else
   {
@@ -5265,6 +5433,7 @@ void vtkExodusIIReaderPrivate::SetObjectAttributeStatus(int otyp, int oi, int ai
       {
         return;
       }
+      this->WaitForPrefetch(true);
       it->second[oi].AttributeStatus[ai] = status;
       this->Modified();
     }
@@ -5278,6 +5447,7 @@ void vtkExodusIIReaderPrivate::SetApplyDisplacements(vtkTypeBool d)
   if (this->ApplyDisplacements == d)
     return;
 
+  this->WaitForPrefetch(true);
   this->ApplyDisplacements = d;
   this->Modified();
 
@@ -5286,11 +5456,42 @@ void vtkExodusIIReaderPrivate::SetApplyDisplacements(vtkTypeBool d)
     vtkExodusIICacheKey(0, vtkExodusIIReader::NODAL_COORDS, 0, 0), vtkExodusIICacheKey(0, 1, 0, 0));
 }
 
+void vtkExodusIIReaderPrivate::SetHasModeShapes(int ms)
+{
+  if (this->HasModeShapes == ms)
+    return;
+
+  this->WaitForPrefetch(true);
+  this->HasModeShapes = ms;
+  this->Modified();
+}
+
+void vtkExodusIIReaderPrivate::SetModeShapeTime(double phase)
+{
+  if (this->ModeShapeTime == phase)
+    return;
+
+  this->WaitForPrefetch(true);
+  this->ModeShapeTime = phase;
+  this->Modified();
+}
+
+void vtkExodusIIReaderPrivate::SetAnimateModeShapes(int flag)
+{
+  if (this->AnimateModeShapes == flag)
+    return;
+
+  this->WaitForPrefetch(true);
+  this->AnimateModeShapes = flag;
+  this->Modified();
+}
+
 void vtkExodusIIReaderPrivate::SetDisplacementMagnitude(double s)
 {
   if (this->DisplacementMagnitude == s)
     return;
 
+  this->WaitForPrefetch(true);
   this->DisplacementMagnitude = s;
   this->Modified();
 
@@ -5340,11 +5541,18 @@ vtkExodusIIReader::vtkExodusIIReader()
   this->DisplayType = 0;
   this->SILUpdateStamp = -1;
   this->UseLegacyBlockNames = false;
+  this->ShareCache = 0;
+  this->PrefetchTimeSteps = 0;
+  this->PreviousTimeStep = -1;
   this->SetNumberOfInputPorts(0);
 }
 
 vtkExodusIIReader::~vtkExodusIIReader()
 {
+  if (this->Metadata)
+  {
+    this->Metadata->WaitForPrefetch(true);
+  }
   this->SetXMLFileName(nullptr);
   this->SetFileName(nullptr);
 
@@ -5363,6 +5571,7 @@ int vtkExodusIIReader::CanReadFile(const char* fname)
   int diskWordSize = 8;
   float version;
 
+  std::lock_guard<std::mutex> lock(vtkExodusIIReaderPrivate::GetIOMutex());
   if ((exoid = ex_open(fname, EX_READ, &appWordSize, &diskWordSize, &version)) < 0)
   {
     return 0;
@@ -5478,6 +5687,8 @@ int vtkExodusIIReader::RequestInformation(vtkInformation* vtkNotUsed(request),
   // If the metadata is older than the filename
   if (this->GetMetadataMTime() < this->FileNameMTime)
   {
+    this->Metadata->WaitForPrefetch(true);
+    std::lock_guard<std::mutex> lock(vtkExodusIIReaderPrivate::GetIOMutex());
     if (this->Metadata->OpenFile(this->FileName))
     {
       // We need to initialize the XML parser before calling RequestInformation
@@ -5541,13 +5752,6 @@ int vtkExodusIIReader::RequestInformation(vtkInformation* vtkNotUsed(request),
 int vtkExodusIIReader::RequestData(vtkInformation* vtkNotUsed(request),
   vtkInformationVector** vtkNotUsed(inputVector), vtkInformationVector* outputVector)
 {
-  if (!this->FileName || !this->Metadata->OpenFile(this->FileName))
-  {
-    vtkErrorMacro("Unable to open file \"" << (this->FileName ? this->FileName : "(null)")
-                                           << "\" to read data");
-    return 0;
-  }
-
   vtkInformation* outInfo = outputVector->GetInformationObject(0);
   vtkMultiBlockDataSet* output =
     vtkMultiBlockDataSet::SafeDownCast(outInfo->Get(vtkDataObject::DATA_OBJECT()));
@@ -5595,17 +5799,71 @@ int vtkExodusIIReader::RequestData(vtkInformation* vtkNotUsed(request),
     {
       // Let the metadata know the time value so that the Metadata->RequestData call below will
       // generate the animated mode shape properly.
+      this->Metadata->WaitForPrefetch(true);
       this->Metadata->ModeShapeTime = requestedTimeStep;
       output->GetInformation()->Set(vtkDataObject::DATA_TIME_STEP(), this->Metadata->ModeShapeTime);
       // output->GetInformation()->Remove( vtkDataObject::DATA_TIME_STEP() );
     }
   }
 
-  this->Metadata->RequestData(this->TimeStep, output);
+  // A prefetch of the requested step is completed, any other one is abandoned.
+  this->Metadata->WaitForPrefetch(this->TimeStep != this->Metadata->GetPrefetchTimeStep());
+
+  {
+    std::lock_guard<std::mutex> lock(vtkExodusIIReaderPrivate::GetIOMutex());
+    if (!this->FileName || !this->Metadata->OpenFile(this->FileName))
+    {
+      vtkErrorMacro("Unable to open file \"" << (this->FileName ? this->FileName : "(null)")
+                                             << "\" to read data");
+      return 0;
+    }
+    this->Metadata->SetSharedCache(this->ShareCache ? this->GetSharedCache() : nullptr);
+    this->Metadata->RequestData(this->TimeStep, output);
+  }
+
+  if (this->PrefetchTimeSteps && !this->GetHasModeShapes() && this->GetCacheSize() > 0)
+  {
+    int nextStep =
+      this->TimeStep < this->PreviousTimeStep ? this->TimeStep - 1 : this->TimeStep + 1;
+    if (nextStep >= 0 && nextStep < this->GetNumberOfTimeSteps())
+    {
+      this->Metadata->StartPrefetch(this->FileName, nextStep);
+    }
+  }
+  this->PreviousTimeStep = this->TimeStep;
 
   return 1;
 }
 
+vtkExodusIICache* vtkExodusIIReader::GetSharedCache()
+{
+  // Caches shared by the readers of each file. The registry only holds weak
+  // references, so a cache goes away with the last reader using it.
+  static std::mutex registryMutex;
+  static std::map<std::string, vtkWeakPointer<vtkExodusIICache>> registry;
+
+  std::lock_guard<std::mutex> lock(registryMutex);
+  for (auto it = registry.begin(); it != registry.end();)
+  {
+    it = it->second ? std::next(it) : registry.erase(it);
+  }
+  vtkExodusIICache* cache = registry[this->FileName];
+  if (!cache)
+  {
+    cache = vtkExodusIICache::New();
+    cache->SetCacheCapacity(0.);
+    registry[this->FileName] = cache;
+    // The reader's metadata holds the only reference once registered.
+    this->Metadata->SetSharedCache(cache);
+    cache->Delete();
+  }
+  if (cache->GetCacheCapacity() < this->GetCacheSize())
+  {
+    cache->SetCacheCapacity(this->GetCacheSize());
+  }
+  return cache;
+}
+
 int vtkExodusIIReader::GetMaxNameLength()
 {
   return ex_inquire_int(this->Metadata->Exoid, EX_INQ_DB_MAX_USED_NAME_LENGTH);
@@ -6747,6 +7005,21 @@ double vtkExodusIIReader::GetCacheSize()
   return this->Metadata->GetCacheSize();
 }
 
+vtkIdType vtkExodusIIReader::GetCacheHits()
+{
+  return this->Metadata->GetCacheHits();
+}
+
+vtkIdType vtkExodusIIReader::GetCacheMisses()
+{
+  return this->Metadata->GetCacheMisses();
+}
+
+void vtkExodusIIReader::ResetCacheStatistics()
+{
+  this->Metadata->ResetCacheStatistics();
+}
+
 void vtkExodusIIReader::SetSqueezePoints(bool sp)
 {
   this->Metadata->SetSqueezePoints(sp ? 1 : 0);
@@ -790,6 +790,49 @@ public:
    */
   double GetCacheSize();
 
+  ///@{
+  /**
+   * Should readers of the same file share one cache? When on, every reader
+   * with ShareCache enabled and the same FileName stores arrays in a single
+   * cache whose capacity is the largest CacheSize among them, so that
+   * arrays read by one reader are not read again by another. Point
+   * coordinates always stay in the cache of each reader since they depend
+   * on its displacement settings. Off by default.
+   */
+  vtkSetMacro(ShareCache, vtkTypeBool);
+  vtkGetMacro(ShareCache, vtkTypeBool);
+  vtkBooleanMacro(ShareCache, vtkTypeBool);
+  ///@}
+
+  ///@{
+  /**
+   * Should the arrays of the next time step be read in the background?
+   * When on, once a time step has been produced the reader starts a thread
+   * that reads the time dependent arrays just requested for the following
+   * time step (or the preceding one when stepping backwards) into the cache.
+   * Requesting that time step next then only copies the arrays out of the
+   * cache. This requires a CacheSize large enough to hold two time steps.
+   * Access to Exodus files is serialized across all readers, so the
+   * prefetch only overlaps with the work done downstream of the reader.
+   * Off by default.
+   */
+  vtkSetMacro(PrefetchTimeSteps, vtkTypeBool);
+  vtkGetMacro(PrefetchTimeSteps, vtkTypeBool);
+  vtkBooleanMacro(PrefetchTimeSteps, vtkTypeBool);
+  ///@}
+
+  ///@{
+  /**
+   * Number of cache lookups that found, respectively missed, the requested
+   * array since the statistics were last reset. Only the lookups of this
+   * reader are counted, also when the cache is shared with other readers
+   * (see ShareCache), and not those made by the prefetch thread.
+   */
+  vtkIdType GetCacheHits();
+  vtkIdType GetCacheMisses();
+  void ResetCacheStatistics();
+  ///@}
+
   ///@{
   /**
    * Should the reader output only points used by elements in the output mesh,
@@ -916,7 +959,16 @@ private:
   void AddDisplacements(vtkUnstructuredGrid* output);
   int ModeShapesRange[2];
 
+  /**
+   * Return the cache shared by all readers of FileName, creating it if needed.
+   */
+  vtkExodusIICache* GetSharedCache();
+
   bool UseLegacyBlockNames;
+
+  vtkTypeBool ShareCache;
+  vtkTypeBool PrefetchTimeSteps;
+  int PreviousTimeStep;
 };
 
 #endif
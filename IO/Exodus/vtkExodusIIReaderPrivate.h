@@ -13,7 +13,12 @@
 #include "vtkStdString.h"               // for vtkStdString
 #include "vtksys/RegularExpression.hxx" // for vtksys::RegularExpression
 
+#include <atomic> // for std::atomic
 #include <map>    // for std::map
+#include <mutex>  // for std::mutex
+#include <set>    // for std::set
+#include <string> // for std::string
+#include <thread> // for std::thread
 #include <vector> // for std::vector
 
 #include "vtkIOExodusModule.h" // For export macro
@@ -88,6 +93,40 @@ public:
   /// Get the size of the cache in MiB.
   vtkGetMacro(CacheSize, double);
 
+  /** Use \a cache, shared with other readers of the same file, for every array
+   * that does not depend on the settings of this reader. Pass nullptr to go
+   * back to using only this reader's own cache.
+   */
+  void SetSharedCache(vtkExodusIICache* cache);
+
+  ///@{
+  /// Lookup statistics of this reader, whether the arrays are in its own
+  /// cache or in the shared one.
+  vtkIdType GetCacheHits();
+  vtkIdType GetCacheMisses();
+  void ResetCacheStatistics();
+  ///@}
+
+  /** Start reading, on a background thread and into the cache, the arrays
+   * that the last RequestData() read, but for \a timeStep.
+   * Any prefetch still running is waited for first.
+   */
+  void StartPrefetch(const char* filename, int timeStep);
+
+  /** Wait for a prefetch started by StartPrefetch() to finish. If \a cancel
+   * is true, the prefetch stops after the array it is currently reading.
+   */
+  void WaitForPrefetch(bool cancel);
+
+  /// The time step being (or last) prefetched, -1 if none.
+  int GetPrefetchTimeStep() { return this->PrefetchTimeStep; }
+
+  /** All access to Exodus files by readers and their prefetch threads is
+   * serialized through this mutex, since the underlying I/O libraries may
+   * not be thread safe.
+   */
+  static std::mutex& GetIOMutex();
+
   /** Return the number of time steps in the open file.
    * You must have called RequestInformation() before
    * invoking this member function.
@@ -250,13 +289,13 @@ public:
   virtual void SetDisplacementMagnitude(double s);
   vtkGetMacro(DisplacementMagnitude, double);
 
-  vtkSetMacro(HasModeShapes, int);
+  virtual void SetHasModeShapes(int ms);
   vtkGetMacro(HasModeShapes, int);
 
-  vtkSetMacro(ModeShapeTime, double);
+  virtual void SetModeShapeTime(double phase);
   vtkGetMacro(ModeShapeTime, double);
 
-  vtkSetMacro(AnimateModeShapes, int);
+  virtual void SetAnimateModeShapes(int flag);
   vtkGetMacro(AnimateModeShapes, int);
 
   vtkSetMacro(IgnoreFileTime, bool);
@@ -429,6 +468,7 @@ public:
   // the files.
   void SetTimesOverrides(const std::vector<double>& times)
   {
+    this->WaitForPrefetch(true);
     this->Times = times;
     this->SkipUpdateTimeInformation = true;
   }
@@ -632,6 +672,12 @@ protected:
    */
   vtkDataArray* GetCacheOrRead(vtkExodusIICacheKey);
 
+  /// Return the cache holding arrays for \a key.
+  vtkExodusIICache* GetCacheForKey(const vtkExodusIICacheKey& key);
+
+  /// Body of the prefetch thread.
+  void Prefetch(std::string filename, std::vector<vtkExodusIICacheKey> keys);
+
   /** Return the index of an object type (in a private list of all object types).
    * This returns a 0-based index if the object type was found and -1 if it
    * was not.
@@ -818,6 +864,21 @@ protected:
   /// The size of the cache in MiB.
   double CacheSize;
 
+  /// A cache shared with other readers of the same file, or nullptr.
+  vtkExodusIICache* SharedCache;
+
+  /// Time dependent keys looked up by the last RequestData(), to be prefetched.
+  std::set<vtkExodusIICacheKey> TimeStepKeys;
+
+  std::thread PrefetchThread;
+  std::atomic<bool> CancelPrefetch;
+  bool Prefetching;
+  int PrefetchTimeStep;
+
+  /// Lookups in the caches by RequestData() since the statistics were reset.
+  vtkIdType CacheHits;
+  vtkIdType CacheMisses;
+
   vtkTypeBool ApplyDisplacements;
   float DisplacementMagnitude;
   vtkTypeBool HasModeShapes;
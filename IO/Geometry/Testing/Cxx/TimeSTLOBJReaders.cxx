@@ -0,0 +1,239 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TimeSTLOBJReaders.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Throughput of the STL and OBJ readers on a synthetic sphere. The sort based
+// point merging of vtkSTLReader is also checked against merging through a
+// vtkMergePoints locator, which must give exactly the same output, and on
+// signed zeros and NaNs. Also checks that malformed OBJ vertices are reported.
+
+#include "vtkCellArray.h"
+#include "vtkCellArrayIterator.h"
+#include "vtkMath.h"
+#include "vtkMergePoints.h"
+#include "vtkNew.h"
+#include "vtkOBJReader.h"
+#include "vtkOBJWriter.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+#include "vtkSTLReader.h"
+#include "vtkSTLWriter.h"
+#include "vtkSphereSource.h"
+#include "vtkTestErrorObserver.h"
+#include "vtkTestUtilities.h"
+#include "vtkTimerLog.h"
+
+#include <vtksys/SystemTools.hxx>
+
+#include <algorithm>
+#include <fstream>
+#include <string>
+
+namespace
+{
+bool SamePolyData(vtkPolyData* a, vtkPolyData* b)
+{
+  if (a->GetNumberOfPoints() != b->GetNumberOfPoints() ||
+    a->GetNumberOfPolys() != b->GetNumberOfPolys())
+  {
+    cerr << "Size mismatch: " << a->GetNumberOfPoints() << "/" << b->GetNumberOfPoints()
+         << " points, " << a->GetNumberOfPolys() << "/" << b->GetNumberOfPolys() << " polys\n";
+    return false;
+  }
+  for (vtkIdType i = 0; i < a->GetNumberOfPoints(); ++i)
+  {
+    double x[3], y[3];
+    a->GetPoint(i, x);
+    b->GetPoint(i, y);
+    if (x[0] != y[0] || x[1] != y[1] || x[2] != y[2])
+    {
+      cerr << "Point " << i << " differs\n";
+      return false;
+    }
+  }
+  vtkIdType nptsA, nptsB;
+  const vtkIdType *ptsA, *ptsB;
+  auto iterA = vtk::TakeSmartPointer(a->GetPolys()->NewIterator());
+  auto iterB = vtk::TakeSmartPointer(b->GetPolys()->NewIterator());
+  for (iterA->GoToFirstCell(), iterB->GoToFirstCell(); !iterA->IsDoneWithTraversal();
+       iterA->GoToNextCell(), iterB->GoToNextCell())
+  {
+    iterA->GetCurrentCell(nptsA, ptsA);
+    iterB->GetCurrentCell(nptsB, ptsB);
+    if (nptsA != nptsB || !std::equal(ptsA, ptsA + nptsA, ptsB))
+    {
+      cerr << "Cell " << iterA->GetCurrentCellId() << " differs\n";
+      return false;
+    }
+  }
+  return true;
+}
+
+double Throughput(const std::string& fileName, double seconds)
+{
+  return vtksys::SystemTools::FileLength(fileName) / (1024.0 * 1024.0) / seconds;
+}
+}
+
+int TimeSTLOBJReaders(int argc, char* argv[])
+{
+  char* tempDir =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  std::string testDirectory = tempDir;
+  delete[] tempDir;
+
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(500);
+  sphere->SetPhiResolution(500);
+
+  const std::string binarySTL = testDirectory + "/TimeSTLOBJReadersBinary.stl";
+  const std::string asciiSTL = testDirectory + "/TimeSTLOBJReadersASCII.stl";
+  const std::string obj = testDirectory + "/TimeSTLOBJReaders.obj";
+
+  vtkNew<vtkSTLWriter> stlWriter;
+  stlWriter->SetInputConnection(sphere->GetOutputPort());
+  stlWriter->SetFileName(binarySTL.c_str());
+  stlWriter->SetFileTypeToBinary();
+  stlWriter->Write();
+  stlWriter->SetFileName(asciiSTL.c_str());
+  stlWriter->SetFileTypeToASCII();
+  stlWriter->Write();
+
+  vtkNew<vtkOBJWriter> objWriter;
+  objWriter->SetInputConnection(sphere->GetOutputPort());
+  objWriter->SetFileName(obj.c_str());
+  objWriter->Write();
+
+  cout << "SMP backend " << vtkSMPTools::GetBackend() << ", "
+       << vtkSMPTools::GetEstimatedNumberOfThreads() << " threads\n";
+
+  vtkNew<vtkTimerLog> timer;
+  int status = EXIT_SUCCESS;
+  for (const std::string& fileName : { binarySTL, asciiSTL })
+  {
+    vtkNew<vtkSTLReader> reader;
+    reader->SetFileName(fileName.c_str());
+    reader->MergingOff();
+    timer->StartTimer();
+    reader->Update();
+    timer->StopTimer();
+    cout << fileName << ": " << Throughput(fileName, timer->GetElapsedTime())
+         << " MB/s without merging\n";
+
+    reader->MergingOn();
+    timer->StartTimer();
+    reader->Update();
+    timer->StopTimer();
+    cout << fileName << ": " << Throughput(fileName, timer->GetElapsedTime())
+         << " MB/s with sort based merging\n";
+
+    vtkNew<vtkSTLReader> locatorReader;
+    vtkNew<vtkMergePoints> locator;
+    locatorReader->SetFileName(fileName.c_str());
+    locatorReader->SetLocator(locator);
+    timer->StartTimer();
+    locatorReader->Update();
+    timer->StopTimer();
+    cout << fileName << ": " << Throughput(fileName, timer->GetElapsedTime())
+         << " MB/s with locator merging\n";
+
+    if (!SamePolyData(reader->GetOutput(), locatorReader->GetOutput()))
+    {
+      cerr << "Sort and locator merging differ for " << fileName << "\n";
+      status = EXIT_FAILURE;
+    }
+    if (reader->GetOutput()->GetNumberOfPoints() != sphere->GetOutput()->GetNumberOfPoints())
+    {
+      cerr << "Expected " << sphere->GetOutput()->GetNumberOfPoints() << " merged points, got "
+           << reader->GetOutput()->GetNumberOfPoints() << "\n";
+      status = EXIT_FAILURE;
+    }
+  }
+
+  vtkNew<vtkOBJReader> objReader;
+  objReader->SetFileName(obj.c_str());
+  timer->StartTimer();
+  objReader->Update();
+  timer->StopTimer();
+  cout << obj << ": " << Throughput(obj, timer->GetElapsedTime()) << " MB/s\n";
+
+  vtkPolyData* input = sphere->GetOutput();
+  vtkPolyData* output = objReader->GetOutput();
+  if (output->GetNumberOfPoints() != input->GetNumberOfPoints() ||
+    output->GetNumberOfPolys() != input->GetNumberOfPolys())
+  {
+    cerr << "OBJ round trip changed the mesh\n";
+    status = EXIT_FAILURE;
+  }
+  else
+  {
+    for (vtkIdType i = 0; i < input->GetNumberOfPoints(); ++i)
+    {
+      double x[3], y[3];
+      input->GetPoint(i, x);
+      output->GetPoint(i, y);
+      if (vtkMath::Distance2BetweenPoints(x, y) > 1e-10)
+      {
+        cerr << "OBJ point " << i << " differs\n";
+        status = EXIT_FAILURE;
+        break;
+      }
+    }
+  }
+
+  // -0 and +0 are merged, NaNs are never merged.
+  const std::string specialSTL = testDirectory + "/TimeSTLOBJReadersSpecial.stl";
+  {
+    std::ofstream file(specialSTL.c_str());
+    file << "solid special\n";
+    const char* facets[2][3] = { { "0 0 0", "1 nan 0", "0 1 0" },
+      { "-0 0 -0", "1 nan 0", "0 -1 0" } };
+    for (const auto& facet : facets)
+    {
+      file << " facet normal 0 0 1\n  outer loop\n";
+      for (const char* vertex : facet)
+      {
+        file << "   vertex " << vertex << "\n";
+      }
+      file << "  endloop\n endfacet\n";
+    }
+    file << "endsolid special\n";
+  }
+  vtkNew<vtkSTLReader> specialReader;
+  specialReader->SetFileName(specialSTL.c_str());
+  specialReader->Update();
+  if (specialReader->GetOutput()->GetNumberOfPoints() != 5)
+  {
+    cerr << "Expected signed zeros to merge and NaNs not to, got "
+         << specialReader->GetOutput()->GetNumberOfPoints() << " points instead of 5\n";
+    status = EXIT_FAILURE;
+  }
+
+  const std::string badOBJ = testDirectory + "/TimeSTLOBJReadersBad.obj";
+  {
+    std::ofstream file(badOBJ.c_str());
+    file << "v 0 0 0\nv 1 0\nv 0 1 0\nf 1 2 3\n";
+  }
+  vtkNew<vtkTest::ErrorObserver> errorObserver;
+  vtkNew<vtkOBJReader> badReader;
+  badReader->AddObserver(vtkCommand::ErrorEvent, errorObserver);
+  badReader->SetFileName(badOBJ.c_str());
+  badReader->Update();
+  if (errorObserver->CheckErrorMessage("Error reading 'v' at line 2"))
+  {
+    status = EXIT_FAILURE;
+  }
+
+  return status;
+}
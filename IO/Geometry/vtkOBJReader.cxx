@@ -18,19 +18,138 @@
 #include "vtkFloatArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include <algorithm>
+#include <atomic>
 #include <cctype>
+#include <locale>
 #include <sstream>
+#include <string>
 #include <unordered_map>
+#include <vector>
 #include <vtksys/SystemTools.hxx>
 
 #include "vtkCellData.h"
+#include "vtkSMPTools.h"
 #include "vtkStringArray.h"
 
 vtkStandardNewMacro(vtkOBJReader);
 
+namespace
+{
+//------------------------------------------------------------------------------
+// The text of "v", "vn" and "vt" records is gathered while the file is
+// scanned, and converted to floats in parallel batches appended to the
+// destination array. Converting the numbers is what dominates the time spent
+// reading large files; the rest of the scan has to stay sequential since
+// faces refer to the records read so far. Records with fewer than the
+// required number of values are remembered to be reported, the missing
+// values are set to 0.
+class OBJTupleParser
+{
+public:
+  OBJTupleParser(vtkFloatArray* array, int requiredComponents)
+    : Array(array)
+    , RequiredComponents(requiredComponents)
+  {
+  }
+
+  ~OBJTupleParser() { this->Flush(); }
+
+  void Add(const char* text, int lineNr)
+  {
+    this->Offsets.push_back(this->Text.size());
+    this->Text.append(text);
+    this->Text.push_back('\0');
+    this->LineNumbers.push_back(lineNr);
+    if (this->Offsets.size() >= BatchSize)
+    {
+      this->Flush();
+    }
+  }
+
+  // Convert the remaining records and release the memory reserved for the
+  // growth of the array. Returns false and sets lineNr to the line of the
+  // first invalid record if there was one.
+  bool Finish(int& lineNr)
+  {
+    this->Flush();
+    this->Array->Squeeze();
+    if (this->FirstBadLine >= 0)
+    {
+      lineNr = this->FirstBadLine;
+      return false;
+    }
+    return true;
+  }
+
+private:
+  void Flush()
+  {
+    const vtkIdType numTuples = static_cast<vtkIdType>(this->Offsets.size());
+    if (numTuples == 0)
+    {
+      return;
+    }
+    // Grow geometrically, appending a batch at a time would copy the array
+    // once per batch.
+    const int numComps = this->Array->GetNumberOfComponents();
+    const vtkIdType offset = this->Array->GetNumberOfTuples();
+    if (numComps * (offset + numTuples) > this->Array->GetSize())
+    {
+      this->Array->Resize(std::max(offset + numTuples, 2 * offset));
+    }
+    this->Array->SetNumberOfTuples(offset + numTuples);
+    float* values = this->Array->GetPointer(numComps * offset);
+
+    std::atomic<vtkIdType> firstBad(numTuples);
+    vtkSMPTools::For(0, numTuples, [&](vtkIdType begin, vtkIdType end) {
+      std::istringstream dataStream;
+      dataStream.imbue(std::locale::classic());
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        dataStream.clear();
+        dataStream.str(this->Text.c_str() + this->Offsets[i]);
+        float* tuple = values + numComps * i;
+        std::fill(tuple, tuple + numComps, 0.0f);
+        int c = 0;
+        while (c < numComps && dataStream >> tuple[c])
+        {
+          ++c;
+        }
+        if (c < this->RequiredComponents)
+        {
+          vtkIdType bad = firstBad;
+          while (i < bad && !firstBad.compare_exchange_weak(bad, i))
+          {
+          }
+        }
+      }
+    });
+
+    if (firstBad < numTuples && this->FirstBadLine < 0)
+    {
+      this->FirstBadLine = this->LineNumbers[firstBad];
+    }
+    this->Text.clear();
+    this->Offsets.clear();
+    this->LineNumbers.clear();
+  }
+
+  static constexpr size_t BatchSize = 1 << 16;
+
+  vtkFloatArray* Array;
+  int RequiredComponents;
+  int FirstBadLine = -1;
+  std::string Text;
+  std::vector<size_t> Offsets;
+  std::vector<int> LineNumbers;
+};
+}
+
 //------------------------------------------------------------------------------
 vtkOBJReader::vtkOBJReader()
 {
@@ -135,7 +254,8 @@ int vtkOBJReader::RequestData(vtkInformation* vtkNotUsed(request),
   // initialize some structures to store the file contents in
   vtkPoints* points = vtkPoints::New();
   std::unordered_map<std::string, vtkFloatArray*> tcoords_map;
-  std::vector<std::pair<float, float>> verticesTextureList;
+  vtkNew<vtkFloatArray> verticesTextureList;
+  verticesTextureList->SetNumberOfComponents(2);
   vtkFloatArray* normals = vtkFloatArray::New();
   normals->SetNumberOfComponents(3);
   normals->SetName("Normals");
@@ -183,7 +303,6 @@ int vtkOBJReader::RequestData(vtkInformation* vtkNotUsed(request),
     const int MAX_LINE = 1024 * 256;
     char rawLine[MAX_LINE];
     char tcoordsName[100];
-    float xyz[3];
     int numPoints = 0;
     int numTCoords = 0;
     int numNormals = 0;
@@ -192,6 +311,8 @@ int vtkOBJReader::RequestData(vtkInformation* vtkNotUsed(request),
     bool readingFirstComment = true;
     std::string firstComment;
     int lineNr = 0;
+    // "vt u [v [w]]", only u is required
+    OBJTupleParser tcoordParser(verticesTextureList, 1);
     while (everything_ok && fgets(rawLine, MAX_LINE, in) != nullptr)
     {
       ++lineNr;
@@ -268,21 +389,14 @@ int vtkOBJReader::RequestData(vtkInformation* vtkNotUsed(request),
       else if (strcmp(cmd, "vt") == 0)
       {
         // this is a tcoord, expect two floats, separated by whitespace:
-        std::stringstream dataStream;
-        dataStream.imbue(std::locale::classic());
-        dataStream << pLine;
-
-        try
-        {
-          dataStream >> xyz[0] >> xyz[1];
-          verticesTextureList.emplace_back(xyz[0], xyz[1]);
-        }
-        catch (const std::exception&)
-        {
-          vtkErrorMacro(<< "Error reading 'vt' at line " << lineNr);
-        }
+        tcoordParser.Add(pLine, lineNr);
       }
     } // (end of first while loop)
+    int badLine;
+    if (!tcoordParser.Finish(badLine))
+    {
+      vtkErrorMacro(<< "Error reading 'vt' at line " << badLine);
+    }
 
     // Comment lines include newline characters.
     // Keep newlines between lines of multi-line comment, but
@@ -305,7 +419,7 @@ int vtkOBJReader::RequestData(vtkInformation* vtkNotUsed(request),
 
     // Initialize every texture array with (-1, -1)
     {
-      const vtkIdType nTuples = static_cast<vtkIdType>(verticesTextureList.size());
+      const vtkIdType nTuples = verticesTextureList->GetNumberOfTuples();
 
       for (const auto& iter : tcoords_map)
       {
@@ -321,6 +435,8 @@ int vtkOBJReader::RequestData(vtkInformation* vtkNotUsed(request),
 
     // Second loop to parse points, faces, texture coordinates, normals...
     lineNr = 0;
+    OBJTupleParser pointParser(vtkArrayDownCast<vtkFloatArray>(points->GetData()), 3);
+    OBJTupleParser normalParser(normals, 3);
     fseek(in, 0, SEEK_SET);
     while (everything_ok && fgets(rawLine, MAX_LINE, in) != nullptr)
     {
@@ -359,21 +475,8 @@ int vtkOBJReader::RequestData(vtkInformation* vtkNotUsed(request),
       else if (strcmp(cmd, "v") == 0)
       {
         // vertex definition, expect three floats, separated by whitespace:
-        std::stringstream dataStream;
-        dataStream.imbue(std::locale::classic());
-        dataStream << pLine;
-
-        try
-        {
-          dataStream >> xyz[0] >> xyz[1] >> xyz[2];
-          points->InsertNextPoint(xyz);
-          numPoints++;
-        }
-        catch (const std::exception&)
-        {
-          vtkErrorMacro(<< "Error reading 'v' at line " << lineNr);
-          everything_ok = false;
-        }
+        pointParser.Add(pLine, lineNr);
+        numPoints++;
       }
       else if (strcmp(cmd, "usemtl") == 0)
       {
@@ -413,22 +516,9 @@ int vtkOBJReader::RequestData(vtkInformation* vtkNotUsed(request),
       else if (strcmp(cmd, "vn") == 0)
       {
         // vertex normal, expect three floats, separated by whitespace:
-        std::stringstream dataStream;
-        dataStream.imbue(std::locale::classic());
-        dataStream << pLine;
-
-        try
-        {
-          dataStream >> xyz[0] >> xyz[1] >> xyz[2];
-          normals->InsertNextTuple(xyz);
-          hasNormals = true;
-          numNormals++;
-        }
-        catch (const std::exception&)
-        {
-          vtkErrorMacro(<< "Error reading 'vn' at line " << lineNr);
-          everything_ok = false;
-        }
+        normalParser.Add(pLine, lineNr);
+        hasNormals = true;
+        numNormals++;
       }
       else if (strcmp(cmd, "p") == 0)
       {
@@ -622,10 +712,10 @@ int vtkOBJReader::RequestData(vtkInformation* vtkNotUsed(request),
 
               // Set the current texture array with the value corresponding to the
               // iTcoords read
-              const auto& currentTCoord = verticesTextureList[iTCoordAbs];
+              const float* currentTCoord = verticesTextureList->GetPointer(2 * iTCoordAbs);
               auto iter = tcoords_map.find(tcoordsName);
               vtkFloatArray* tcArray = iter->second;
-              tcArray->SetTuple2(iTCoordAbs, currentTCoord.first, currentTCoord.second);
+              tcArray->SetTuple2(iTCoordAbs, currentTCoord[0], currentTCoord[1]);
 
               nTCoords++;
 
@@ -691,9 +781,8 @@ int vtkOBJReader::RequestData(vtkInformation* vtkNotUsed(request),
 
               // Set the current texture array with the value corresponding to the
               // iTcoords read
-              const auto& currentTCoord = verticesTextureList[iTCoordAbs];
-              tcoords_map[tcoordsName]->SetTuple2(
-                iTCoordAbs, currentTCoord.first, currentTCoord.second);
+              const float* currentTCoord = verticesTextureList->GetPointer(2 * iTCoordAbs);
+              tcoords_map[tcoordsName]->SetTuple2(iTCoordAbs, currentTCoord[0], currentTCoord[1]);
 
               nTCoords++;
               if (iTCoord != iVert)
@@ -795,6 +884,16 @@ int vtkOBJReader::RequestData(vtkInformation* vtkNotUsed(request),
       }
 
     } // (end of while loop)
+    if (!pointParser.Finish(badLine))
+    {
+      vtkErrorMacro(<< "Error reading 'v' at line " << badLine);
+      everything_ok = false;
+    }
+    if (!normalParser.Finish(badLine))
+    {
+      vtkErrorMacro(<< "Error reading 'vn' at line " << badLine);
+      everything_ok = false;
+    }
 
   } // (end of local scope section)
 
@@ -18,6 +18,10 @@
  *
  * vtkOBJReader is a source object that reads Wavefront .obj
  * files. The output of this source object is polygonal data.
+ *
+ * The coordinates of vertices, normals and texture coordinates are
+ * converted to numbers in batches that are processed in parallel with
+ * vtkSMPTools.
  * @sa
  * vtkOBJImporter
  */
@@ -120,6 +120,9 @@
 #define VTK_FOAMFILE_OUTBUFSIZE (131072)
 #define VTK_FOAMFILE_INCLUDE_STACK_SIZE (10)
 
+// The number of tuples of a binary vector list converted per read
+#define VTK_FOAMFILE_BLOCKSIZE (65536)
+
 #if defined(_MSC_VER)
 #define _CRT_SECURE_NO_WARNINGS 1
 // No strtoll on msvc:
@@ -194,6 +197,7 @@
 #include "vtkPolyhedron.h"
 #include "vtkPyramid.h"
 #include "vtkQuad.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkSortDataArray.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
@@ -221,6 +225,7 @@
 #include <cmath>  // For abs()
 #include <map>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <sstream>
 #include <typeinfo>
@@ -1261,16 +1266,19 @@ private:
   // Convert OpenFOAM dimension array to string
   std::string ConstructDimensions(const vtkFoamDict& dict) const;
 
-  // read and create cell/point fields
+  // read and create cell/point fields.
+  // ReadFieldFile() only parses the file and leaves reporting errors to the
+  // caller, so that several field files can be parsed concurrently
   bool ReadFieldFile(vtkFoamIOobject& io, vtkFoamDict& dict, const std::string& varName,
-    const vtkDataArraySelection* selection);
+    const vtkDataArraySelection* selection, std::string& errorMessage);
+  void ReadFieldFiles();
   vtkSmartPointer<vtkFloatArray> FillField(vtkFoamEntry& entry, vtkIdType nElements,
     const vtkFoamIOobject& io, vtkFoamTypes::dataType fieldDataType);
-  void GetVolFieldAtTimeStep(const std::string& varName, bool isInternalField = false);
-  void GetPointFieldAtTimeStep(const std::string& varName);
+  void GetVolFieldAtTimeStep(vtkFoamIOobject& io, vtkFoamDict& dict, bool isInternalField = false);
+  void GetPointFieldAtTimeStep(vtkFoamIOobject& io, vtkFoamDict& dict);
 
 #if VTK_FOAMFILE_FINITE_AREA
-  void GetAreaFieldAtTimeStep(const std::string& varName);
+  void GetAreaFieldAtTimeStep(vtkFoamIOobject& io, vtkFoamDict& dict);
 #endif
 
   // Create lagrangian mesh/fields
@@ -2853,6 +2861,69 @@ public:
 
   // ASCII read of longest floating-point
   double ReadDoubleValue();
+
+private:
+  // Fast paths of ReadIntegerValue() and ReadDoubleValue() for the bulk of
+  // numeric lists: parse a number lying entirely within the current buffer
+  // without the refill check of Getc() for every character. Return false,
+  // leaving the stream untouched, for anything else (comments, a number
+  // that may continue in the next buffer, malformed input).
+  bool ReadBufferedIntegerValue(vtkTypeInt64& value);
+  bool ReadBufferedDoubleValue(double& value);
+
+  // Skip whitespace within the buffer, counting newlines
+  unsigned char* SkipBufferedSpace(unsigned char* ptr, int& nNewlines) const
+  {
+    for (; ptr != this->Superclass::BufEndPtr && isspace(*ptr); ++ptr)
+    {
+      if (*ptr == '\n')
+      {
+        ++nNewlines;
+      }
+    }
+    return ptr;
+  }
+
+  // Commit a successful fast-path parse
+  void AdvanceBuffer(unsigned char* ptr, int nNewlines)
+  {
+    this->Superclass::BufPtr = ptr;
+    if (nNewlines)
+    {
+      this->Superclass::LineNumber += nNewlines;
+#if VTK_FOAMFILE_RECOGNIZE_LINEHEAD
+      this->Superclass::WasNewline = true;
+#endif
+    }
+  }
+
+  // Scale factor 10^eval of a decimal exponent
+  static double ExponentScale(int eval)
+  {
+    // fast exponent multiplication!
+    double scale = 1.0;
+    while (eval >= 64)
+    {
+      scale *= 1.0e+64;
+      eval -= 64;
+    }
+    while (eval >= 16)
+    {
+      scale *= 1.0e+16;
+      eval -= 16;
+    }
+    while (eval >= 4)
+    {
+      scale *= 1.0e+4;
+      eval -= 4;
+    }
+    while (eval >= 1)
+    {
+      scale *= 1.0e+1;
+      eval -= 1;
+    }
+    return scale;
+  }
 };
 
 //------------------------------------------------------------------------------
@@ -2867,10 +2938,123 @@ int vtkFoamFile::ReadNext()
   return *this->Superclass::BufPtr++;
 }
 
+bool vtkFoamFile::ReadBufferedIntegerValue(vtkTypeInt64& value)
+{
+  int nNewlines = 0;
+  unsigned char* ptr = this->SkipBufferedSpace(this->Superclass::BufPtr, nNewlines);
+  unsigned char* const endPtr = this->Superclass::BufEndPtr;
+
+  if (ptr == endPtr)
+  {
+    return false;
+  }
+  const bool negNum = (*ptr == '-');
+  if (negNum || *ptr == '+')
+  {
+    ++ptr;
+  }
+  if (ptr == endPtr || !isdigit(*ptr))
+  {
+    return false;
+  }
+
+  vtkTypeInt64 num = *ptr++ - '0';
+  while (ptr != endPtr && isdigit(*ptr))
+  {
+    num = 10 * num + *ptr++ - '0';
+  }
+  if (ptr == endPtr)
+  {
+    return false; // may continue in the next buffer
+  }
+
+  this->AdvanceBuffer(ptr, nNewlines);
+  value = negNum ? -num : num;
+  return true;
+}
+
+// Same arithmetic as ReadDoubleValue(), so that both paths give identical values
+bool vtkFoamFile::ReadBufferedDoubleValue(double& value)
+{
+  int nNewlines = 0;
+  unsigned char* ptr = this->SkipBufferedSpace(this->Superclass::BufPtr, nNewlines);
+  unsigned char* const endPtr = this->Superclass::BufEndPtr;
+
+  if (ptr == endPtr)
+  {
+    return false;
+  }
+  const bool negNum = (*ptr == '-');
+  if (negNum || *ptr == '+')
+  {
+    ++ptr;
+  }
+  if (ptr == endPtr || (!isdigit(*ptr) && *ptr != '.'))
+  {
+    return false;
+  }
+
+  double num = 0;
+  if (*ptr != '.')
+  {
+    num = *ptr++ - '0';
+    while (ptr != endPtr && isdigit(*ptr))
+    {
+      num = num * 10.0 + (*ptr++ - '0');
+    }
+  }
+  if (ptr != endPtr && *ptr == '.')
+  {
+    double divisor = 1.0;
+    while (++ptr != endPtr && isdigit(*ptr))
+    {
+      num = num * 10.0 + (*ptr - '0');
+      divisor *= 10.0;
+    }
+    num /= divisor;
+  }
+  if (ptr != endPtr && (*ptr == 'E' || *ptr == 'e'))
+  {
+    int esign = 1;
+    int eval = 0;
+    if (++ptr != endPtr && (*ptr == '-' || *ptr == '+'))
+    {
+      esign = (*ptr == '-' ? -1 : 1);
+      ++ptr;
+    }
+    while (ptr != endPtr && isdigit(*ptr))
+    {
+      eval = eval * 10 + (*ptr++ - '0');
+    }
+    if (esign < 0)
+    {
+      num /= vtkFoamFile::ExponentScale(eval);
+    }
+    else
+    {
+      num *= vtkFoamFile::ExponentScale(eval);
+    }
+  }
+  if (ptr == endPtr)
+  {
+    return false; // may continue in the next buffer
+  }
+
+  this->AdvanceBuffer(ptr, nNewlines);
+  value = negNum ? -num : num;
+  return true;
+}
+
 // specialized for reading an integer value.
 // not using the standard strtol() for speed reason.
 vtkTypeInt64 vtkFoamFile::ReadIntegerValue()
 {
+  vtkTypeInt64 value;
+  if (this->ReadBufferedIntegerValue(value))
+  {
+    return value;
+  }
+
   // skip prepending invalid chars
   // expanded the outermost loop in nextTokenHead() for performance
   int c;
@@ -2936,6 +3120,12 @@ vtkTypeInt64 vtkFoamFile::ReadIntegerValue()
 // ParaView3/VTK/Utilities/vtksqlite/vtk_sqlite3.c
 double vtkFoamFile::ReadDoubleValue()
 {
+  double value;
+  if (this->ReadBufferedDoubleValue(value))
+  {
+    return value;
+  }
+
   // skip prepending invalid chars
   // expanded the outermost loop in nextTokenHead() for performance
   int c;
@@ -3004,7 +3194,6 @@ double vtkFoamFile::ReadDoubleValue()
   {
     int esign = 1;
     int eval = 0;
-    double scale = 1.0;
 
     c = this->Getc();
     if (c == '-')
@@ -3022,28 +3211,7 @@ double vtkFoamFile::ReadDoubleValue()
       eval = eval * 10 + (c - '0');
       c = this->Getc();
     }
-
-    // fast exponent multiplication!
-    while (eval >= 64)
-    {
-      scale *= 1.0e+64;
-      eval -= 64;
-    }
-    while (eval >= 16)
-    {
-      scale *= 1.0e+16;
-      eval -= 16;
-    }
-    while (eval >= 4)
-    {
-      scale *= 1.0e+4;
-      eval -= 4;
-    }
-    while (eval >= 1)
-    {
-      scale *= 1.0e+1;
-      eval -= 1;
-    }
+    const double scale = vtkFoamFile::ExponentScale(eval);
 
     if (esign < 0)
     {
@@ -3656,21 +3824,33 @@ struct vtkFoamRead
         // Compiler hint for better unrolling:
         VTK_ASSUME(this->Ptr->GetNumberOfComponents() == nComponents);
 
-        const unsigned tupleLength = (sizeof(primitiveT) * nComponents);
-        primitiveT tuple[nComponents];
+        // Read blocks of tuples at once instead of a tuple per Read()
+        const vtkTypeInt64 tupleLength = (sizeof(primitiveT) * nComponents);
+        const vtkTypeInt64 blockSize = std::min<vtkTypeInt64>(nTuples, VTK_FOAMFILE_BLOCKSIZE);
+        std::vector<primitiveT> block(blockSize * nComponents);
 
-        for (vtkTypeInt64 i = 0; i < nTuples; ++i)
+        for (vtkTypeInt64 start = 0; start < nTuples; start += blockSize)
         {
-          const int readLength = io.Read(reinterpret_cast<unsigned char*>(tuple), tupleLength);
-          if (readLength != tupleLength)
+          const vtkTypeInt64 nRead = std::min(blockSize, nTuples - start);
+          const vtkTypeInt64 readLength =
+            io.Read(reinterpret_cast<unsigned char*>(block.data()), nRead * tupleLength);
+          if (readLength != nRead * tupleLength)
           {
-            throw vtkFoamError() << "Failed to read tuple " << i << '/' << nTuples << ": Expected "
-                                 << tupleLength << " bytes, got " << readLength << " bytes.";
+            const vtkTypeInt64 validLength = std::max<vtkTypeInt64>(readLength, 0);
+            throw vtkFoamError() << "Failed to read tuple " << (start + validLength / tupleLength)
+                                 << '/' << nTuples << ": Expected " << tupleLength
+                                 << " bytes, got " << (validLength % tupleLength) << " bytes.";
           }
-          ::remapFoamTuple<nComponents == 6>(tuple); // For symmTensor
-          for (int cmpt = 0; cmpt < nComponents; ++cmpt)
+
+          ValueType* output = this->Ptr->GetPointer(nComponents * start);
+          for (vtkTypeInt64 i = 0; i < nRead; ++i)
           {
-            this->Ptr->SetTypedComponent(i, cmpt, static_cast<ValueType>(tuple[cmpt]));
+            primitiveT* tuple = block.data() + nComponents * i;
+            ::remapFoamTuple<nComponents == 6>(tuple); // For symmTensor
+            for (int cmpt = 0; cmpt < nComponents; ++cmpt)
+            {
+              output[nComponents * i + cmpt] = static_cast<ValueType>(tuple[cmpt]);
+            }
           }
         }
       }
@@ -5943,6 +6123,8 @@ void vtkOpenFOAMReaderPrivate::LocateLagrangianClouds(const std::string& timePat
           this->LagrangianPaths->InsertNextValue(displayName);
         }
         this->GetFieldNames(cloudPath, true);
+
+        std::lock_guard<std::mutex> selectionLock(this->Parent->SelectionMutex);
         this->Parent->PatchDataArraySelection->AddArray(displayName.c_str());
       }
     }
@@ -6162,40 +6344,41 @@ int vtkOpenFOAMReaderPrivate::MakeMetaDataAtTimeStep(vtkStringArray* cellSelecti
     (this->TopologyTimeIndex != this->PolyMeshTimeIndexFaces[this->TimeStep]));
   this->TopologyTimeIndex = this->PolyMeshTimeIndexFaces[this->TimeStep];
 
-  // Change in topology or selection, may need to update boundaries
-  {
-    auto& patches = this->BoundaryDict;
-
-    // User selection changed
-    const bool selectChanged = topoChanged ||
-      (this->Parent->PatchDataArraySelection->GetMTime() != this->Parent->PatchSelectionMTimeOld);
+  auto& patches = this->BoundaryDict;
+  bool addInternalSelection = false;
 
-    bool addInternalSelection = false;
+  // Read contents of polyMesh/boundary to update patch definitions
+  if (topoChanged)
+  {
+    patches.clearAll();
+    const bool isSubRegion = !this->RegionName.empty();
+    auto boundaryEntriesPtr(this->GetPolyMeshFile("boundary", isSubRegion));
 
-    // Read contents of polyMesh/boundary to update patch definitions
-    if (topoChanged)
+    if (boundaryEntriesPtr)
     {
-      patches.clearAll();
-      const bool isSubRegion = !this->RegionName.empty();
-      auto boundaryEntriesPtr(this->GetPolyMeshFile("boundary", isSubRegion));
-
-      if (boundaryEntriesPtr)
+      if (!patches.update(*boundaryEntriesPtr))
       {
-        if (!patches.update(*boundaryEntriesPtr))
-        {
-          vtkErrorMacro(<< patches.error());
-          return 0;
-        }
-
-        // On topology change, add the internal mesh by default
-        addInternalSelection = true;
-      }
-      else if (isSubRegion)
-      {
-        // Could be missing polyMesh/boundary for sub-region
+        vtkErrorMacro(<< patches.error());
         return 0;
       }
+
+      // On topology change, add the internal mesh by default
+      addInternalSelection = true;
+    }
+    else if (isSubRegion)
+    {
+      // Could be missing polyMesh/boundary for sub-region
+      return 0;
     }
+  }
+
+  // Change in topology or selection, may need to update boundaries
+  {
+    std::lock_guard<std::mutex> selectionLock(this->Parent->SelectionMutex);
+
+    // User selection changed
+    const bool selectChanged = topoChanged ||
+      (this->Parent->PatchDataArraySelection->GetMTime() != this->Parent->PatchSelectionMTimeOld);
 
     // The internal mesh - set/check status
     if (selectChanged)
@@ -8633,40 +8816,145 @@ void vtkOpenFOAMReaderPrivate::InterpolateCellToPoint(vtkFloatArray* pData, vtkF
 
 //------------------------------------------------------------------------------
 bool vtkOpenFOAMReaderPrivate::ReadFieldFile(vtkFoamIOobject& io, vtkFoamDict& dict,
-  const std::string& varName, const vtkDataArraySelection* selection)
+  const std::string& varName, const vtkDataArraySelection* selection, std::string& errorMessage)
 {
   const std::string varPath(this->CurrentTimeRegionPath() + "/" + varName);
 
   // Open the file
   if (!io.Open(varPath))
   {
-    vtkErrorMacro(<< "Error opening " << io.GetFileName() << ": " << io.GetError());
+    errorMessage = vtkFoamError() << "Error opening " << io.GetFileName() << ": " << io.GetError();
     return false;
   }
 
   // if the variable is disabled on selection panel then skip it
-  if (selection->ArrayExists(io.GetObjectName().c_str()) &&
-    !selection->ArrayIsEnabled(io.GetObjectName().c_str()))
   {
-    return false;
+    std::lock_guard<std::mutex> selectionLock(this->Parent->SelectionMutex);
+    if (selection->ArrayExists(io.GetObjectName().c_str()) &&
+      !selection->ArrayIsEnabled(io.GetObjectName().c_str()))
+    {
+      return false;
+    }
   }
 
   // Read the field file into dictionary
   if (!dict.Read(io))
   {
-    vtkErrorMacro(<< "Error reading line " << io.GetLineNumber() << " of " << io.GetFileName()
-                  << ": " << io.GetError());
+    errorMessage = vtkFoamError() << "Error reading line " << io.GetLineNumber() << " of "
+                                  << io.GetFileName() << ": " << io.GetError();
     return false;
   }
 
   if (dict.GetType() != vtkFoamToken::DICTIONARY)
   {
-    vtkErrorMacro(<< "File " << io.GetFileName() << "is not valid as a field file");
+    errorMessage = vtkFoamError() << "File " << io.GetFileName() << "is not valid as a field file";
     return false;
   }
   return true;
 }
 
+//------------------------------------------------------------------------------
+// Read the selected volume, internal, point (and area) fields of the time step.
+// Parsing the files dominates, so a batch of files is parsed concurrently and
+// then mapped onto the meshes in the listed order. The batches keep no more
+// parsed dictionaries in memory than there are threads.
+void vtkOpenFOAMReaderPrivate::ReadFieldFiles()
+{
+  enum fieldType
+  {
+    VOL_FIELD,
+    INTERNAL_FIELD,
+    POINT_FIELD,
+    AREA_FIELD
+  };
+
+  std::vector<std::pair<fieldType, std::string>> fields;
+  for (vtkIdType i = 0; i < this->VolFieldFiles->GetNumberOfValues(); ++i)
+  {
+    fields.emplace_back(VOL_FIELD, this->VolFieldFiles->GetValue(i));
+  }
+  for (vtkIdType i = 0; i < this->DimFieldFiles->GetNumberOfValues(); ++i)
+  {
+    fields.emplace_back(INTERNAL_FIELD, this->DimFieldFiles->GetValue(i));
+  }
+  for (vtkIdType i = 0; i < this->PointFieldFiles->GetNumberOfValues(); ++i)
+  {
+    fields.emplace_back(POINT_FIELD, this->PointFieldFiles->GetValue(i));
+  }
+#if VTK_FOAMFILE_FINITE_AREA
+  for (vtkIdType i = 0; i < this->AreaFieldFiles->GetNumberOfValues(); ++i)
+  {
+    fields.emplace_back(AREA_FIELD, this->AreaFieldFiles->GetValue(i));
+  }
+#endif
+
+  struct parsedField
+  {
+    vtkFoamIOobject IO;
+    vtkFoamDict Dict;
+    std::string ErrorMessage;
+    bool Valid = false;
+
+    parsedField(const std::string& casePath, vtkOpenFOAMReader* reader)
+      : IO(casePath, reader)
+    {
+    }
+  };
+
+  const vtkIdType nFields = static_cast<vtkIdType>(fields.size());
+  const vtkIdType batchSize = std::max(1, vtkSMPTools::GetEstimatedNumberOfThreads());
+  for (vtkIdType batchStart = 0; batchStart < nFields; batchStart += batchSize)
+  {
+    const vtkIdType batchEnd = std::min(nFields, batchStart + batchSize);
+    std::vector<std::unique_ptr<parsedField>> parsed(batchEnd - batchStart);
+
+    vtkSMPTools::For(batchStart, batchEnd, 1, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        const vtkDataArraySelection* selection = (fields[i].first == POINT_FIELD
+            ? this->Parent->PointDataArraySelection
+            : this->Parent->CellDataArraySelection);
+
+        auto& field = parsed[i - batchStart];
+        field.reset(new parsedField(this->CasePath, this->Parent));
+        field->Valid = this->ReadFieldFile(
+          field->IO, field->Dict, fields[i].second, selection, field->ErrorMessage);
+      }
+    });
+
+    for (vtkIdType i = batchStart; i < batchEnd; ++i)
+    {
+      auto& field = parsed[i - batchStart];
+      if (field->Valid)
+      {
+        switch (fields[i].first)
+        {
+          case VOL_FIELD:
+            this->GetVolFieldAtTimeStep(field->IO, field->Dict);
+            break;
+          case INTERNAL_FIELD:
+            this->GetVolFieldAtTimeStep(field->IO, field->Dict, true);
+            break;
+          case POINT_FIELD:
+            this->GetPointFieldAtTimeStep(field->IO, field->Dict);
+            break;
+          case AREA_FIELD:
+#if VTK_FOAMFILE_FINITE_AREA
+            this->GetAreaFieldAtTimeStep(field->IO, field->Dict);
+#endif
+            break;
+        }
+      }
+      else if (!field->ErrorMessage.empty())
+      {
+        vtkErrorMacro(<< field->ErrorMessage);
+      }
+      field.reset(); // Release the parsed dictionary as soon as it is mapped
+      this->Parent->UpdateProgress(0.5 + (0.5 * (i + 1)) / nFields);
+    }
+  }
+}
+
 //------------------------------------------------------------------------------
 vtkSmartPointer<vtkFloatArray> vtkOpenFOAMReaderPrivate::FillField(vtkFoamEntry& entry,
   vtkIdType nElements, const vtkFoamIOobject& io, vtkFoamTypes::dataType fieldDataType)
@@ -8911,7 +9199,7 @@ std::string vtkOpenFOAMReaderPrivate::ConstructDimensions(const vtkFoamDict& dic
 //------------------------------------------------------------------------------
 // Read volume or internal field at a timestep
 void vtkOpenFOAMReaderPrivate::GetVolFieldAtTimeStep(
-  const std::string& varName, bool isInternalField)
+  vtkFoamIOobject& io, vtkFoamDict& dict, bool isInternalField)
 {
   // Where to map data
   vtkUnstructuredGrid* internalMesh = this->InternalMesh;
@@ -8921,13 +9209,6 @@ void vtkOpenFOAMReaderPrivate::GetVolFieldAtTimeStep(
   const auto& patches = this->BoundaryDict;
   const bool faceOwner64Bit = ::Is64BitArray(this->FaceOwner);
 
-  vtkFoamIOobject io(this->CasePath, this->Parent);
-  vtkFoamDict dict;
-  if (!this->ReadFieldFile(io, dict, varName, this->Parent->CellDataArraySelection))
-  {
-    return;
-  }
-
   // For internal field (eg, volScalarField::Internal)
   const bool hasColons = (io.GetClassName().find("::Internal") != std::string::npos);
 
@@ -9195,7 +9476,7 @@ void vtkOpenFOAMReaderPrivate::GetVolFieldAtTimeStep(
           if (!warnings.empty())
           {
             vtkWarningMacro(<< "boundaryField " << patch.name_ << ' ' << warnings << " in object "
-                            << varName
+                            << io.GetObjectName()
                             << " at time = " << this->TimeNames->GetValue(this->TimeStep));
           }
           return;
@@ -9416,7 +9697,7 @@ void vtkOpenFOAMReaderPrivate::GetVolFieldAtTimeStep(
 
 //------------------------------------------------------------------------------
 // Read point field at a timestep
-void vtkOpenFOAMReaderPrivate::GetPointFieldAtTimeStep(const std::string& varName)
+void vtkOpenFOAMReaderPrivate::GetPointFieldAtTimeStep(vtkFoamIOobject& io, vtkFoamDict& dict)
 {
   // Where to map data
   vtkUnstructuredGrid* internalMesh = this->InternalMesh;
@@ -9425,13 +9706,6 @@ void vtkOpenFOAMReaderPrivate::GetPointFieldAtTimeStep(const std::string& varNam
   // Boundary information
   const auto& patches = this->BoundaryDict;
 
-  vtkFoamIOobject io(this->CasePath, this->Parent);
-  vtkFoamDict dict;
-  if (!this->ReadFieldFile(io, dict, varName, this->Parent->PointDataArraySelection))
-  {
-    return;
-  }
-
   if (io.GetClassName().compare(0, 5, "point") != 0)
   {
     vtkErrorMacro(<< io.GetFileName() << " is not a pointField");
@@ -9636,7 +9910,7 @@ void vtkOpenFOAMReaderPrivate::GetPointFieldAtTimeStep(const std::string& varNam
 //------------------------------------------------------------------------------
 // Read area field at a timestep
 #if VTK_FOAMFILE_FINITE_AREA
-void vtkOpenFOAMReaderPrivate::GetAreaFieldAtTimeStep(const std::string& varName)
+void vtkOpenFOAMReaderPrivate::GetAreaFieldAtTimeStep(vtkFoamIOobject& io, vtkFoamDict& dict)
 {
   // Where to map data
   vtkPolyData* areaMesh = this->AreaMesh;
@@ -9649,13 +9923,6 @@ void vtkOpenFOAMReaderPrivate::GetAreaFieldAtTimeStep(const std::string& varName
     return;
   }
 
-  vtkFoamIOobject io(this->CasePath, this->Parent);
-  vtkFoamDict dict;
-  if (!this->ReadFieldFile(io, dict, varName, this->Parent->CellDataArraySelection))
-  {
-    return;
-  }
-
   if (io.GetClassName().compare(0, 4, "area") != 0)
   {
     vtkErrorMacro(<< io.GetFileName() << " is not a areaField");
@@ -9726,17 +9993,25 @@ vtkMultiBlockDataSet* vtkOpenFOAMReaderPrivate::MakeLagrangianMesh()
 
   const std::string regionCloudPrefix(this->RegionPrefix() + "lagrangian/");
 
-  vtkDataArraySelection* selection = this->Parent->PatchDataArraySelection;
-
-  const vtkIdType nItems = selection->GetNumberOfArrays();
-  for (vtkIdType itemi = 0; itemi < nItems; ++itemi)
+  // The selected items, listed first so that the clouds are not read while
+  // holding the lock on the selections
+  std::vector<std::string> displayNames;
   {
-    if (!selection->GetArraySetting(itemi))
+    std::lock_guard<std::mutex> selectionLock(this->Parent->SelectionMutex);
+    vtkDataArraySelection* selection = this->Parent->PatchDataArraySelection;
+
+    const vtkIdType nItems = selection->GetNumberOfArrays();
+    for (vtkIdType itemi = 0; itemi < nItems; ++itemi)
     {
-      continue;
+      if (selection->GetArraySetting(itemi))
+      {
+        displayNames.emplace_back(selection->GetArrayName(itemi));
+      }
     }
-    const std::string displayName(selection->GetArrayName(itemi));
+  }
 
+  for (const std::string& displayName : displayNames)
+  {
     auto slash = displayName.rfind('/');
     if (slash == std::string::npos || displayName.compare(0, ++slash, regionCloudPrefix) != 0)
     {
@@ -9837,10 +10112,13 @@ vtkMultiBlockDataSet* vtkOpenFOAMReaderPrivate::MakeLagrangianMesh()
 
       // If the variable is disabled on selection panel then skip it
       const std::string varDisplayName(io.GetObjectName());
-      if (this->Parent->LagrangianDataArraySelection->ArrayExists(varDisplayName.c_str()) &&
-        !this->Parent->GetLagrangianArrayStatus(varDisplayName.c_str()))
       {
-        continue;
+        std::lock_guard<std::mutex> selectionLock(this->Parent->SelectionMutex);
+        if (this->Parent->LagrangianDataArraySelection->ArrayExists(varDisplayName.c_str()) &&
+          !this->Parent->GetLagrangianArrayStatus(varDisplayName.c_str()))
+        {
+          continue;
+        }
       }
 
       // Read the field file into dictionary
@@ -10455,17 +10733,30 @@ int vtkOpenFOAMReaderPrivate::RequestData(vtkMultiBlockDataSet* output)
   recreateInternalMesh |=
     (this->Parent->ReadZones && (this->Parent->ReadZones != this->Parent->ReadZonesOld));
 
+  // State of the selections, which the sub-readers of a decomposed case share
+  bool patchSelectionChanged;
+  bool fieldSelectionChanged;
+  bool hasInternalMesh;
+  {
+    std::lock_guard<std::mutex> selectionLock(this->Parent->SelectionMutex);
+    patchSelectionChanged =
+      (this->Parent->PatchDataArraySelection->GetMTime() != this->Parent->PatchSelectionMTimeOld);
+    fieldSelectionChanged =
+      (this->Parent->CellDataArraySelection->GetMTime() != this->Parent->CellSelectionMTimeOld) ||
+      (this->Parent->PointDataArraySelection->GetMTime() != this->Parent->PointSelectionMTimeOld) ||
+      (this->Parent->LagrangianDataArraySelection->GetMTime() !=
+        this->Parent->LagrangianSelectionMTimeOld);
+    hasInternalMesh = this->Parent->PatchDataArraySelection->ArrayExists(
+      (this->RegionPrefix() + NAME_INTERNALMESH).c_str());
+  }
+
   // Boundary mesh
-  bool recreateBoundaryMesh = (changedStorageType) ||
-    (this->Parent->PatchDataArraySelection->GetMTime() != this->Parent->PatchSelectionMTimeOld) ||
+  bool recreateBoundaryMesh = (changedStorageType) || (patchSelectionChanged) ||
     (this->Parent->CreateCellToPoint != this->Parent->CreateCellToPointOld);
 
   // Fields
   bool updateVariables = (changedStorageType) || (this->TimeStep != this->TimeStepOld) ||
-    (this->Parent->CellDataArraySelection->GetMTime() != this->Parent->CellSelectionMTimeOld) ||
-    (this->Parent->PointDataArraySelection->GetMTime() != this->Parent->PointSelectionMTimeOld) ||
-    (this->Parent->LagrangianDataArraySelection->GetMTime() !=
-      this->Parent->LagrangianSelectionMTimeOld) ||
+    (fieldSelectionChanged) ||
     (this->Parent->PositionsIsIn13Format != this->Parent->PositionsIsIn13FormatOld) ||
     (this->Parent->AddDimensionsToArrayNames != this->Parent->AddDimensionsToArrayNamesOld);
 
@@ -10477,8 +10768,7 @@ int vtkOpenFOAMReaderPrivate::RequestData(vtkMultiBlockDataSet* output)
   const bool moveBoundaryPoints = !recreateBoundaryMesh && pointsMoved;
 
   // Has eulerian fields if there is an internal mesh
-  const bool createEulerians = this->Parent->PatchDataArraySelection->ArrayExists(
-    (this->RegionPrefix() + NAME_INTERNALMESH).c_str());
+  const bool createEulerians = hasInternalMesh;
 
   vtkFoamDebug(<< "RequestData (" << this->RegionName << "/" << this->ProcessorName << ")\n"
                << " internal=" << recreateInternalMesh      //
@@ -10564,8 +10854,10 @@ int vtkOpenFOAMReaderPrivate::RequestData(vtkMultiBlockDataSet* output)
   if (createEulerians && recreateInternalMesh)
   {
     const std::string displayName(this->RegionPrefix() + NAME_INTERNALMESH);
-    if (this->Parent->PatchDataArraySelection->ArrayExists(displayName.c_str()) &&
-      this->Parent->GetPatchArrayStatus(displayName.c_str()))
+    std::unique_lock<std::mutex> selectionLock(this->Parent->SelectionMutex);
+    const bool selected = this->Parent->GetPatchArrayStatus(displayName.c_str()) != 0;
+    selectionLock.unlock();
+    if (selected)
     {
       this->InternalMesh = this->MakeInternalMesh(meshCells, *meshFaces, pointArray);
     }
@@ -10783,36 +11075,7 @@ int vtkOpenFOAMReaderPrivate::RequestData(vtkMultiBlockDataSet* output)
     }
 
     // read field data variables into Internal/Boundary meshes
-    vtkIdType nFieldsRead = 0;
-    vtkIdType nFieldsToRead = (this->VolFieldFiles->GetNumberOfValues() +
-      this->DimFieldFiles->GetNumberOfValues() + this->PointFieldFiles->GetNumberOfValues());
-
-#if VTK_FOAMFILE_FINITE_AREA
-    nFieldsToRead += this->AreaFieldFiles->GetNumberOfValues();
-#endif
-
-    for (vtkIdType i = 0; i < this->VolFieldFiles->GetNumberOfValues(); ++i)
-    {
-      this->GetVolFieldAtTimeStep(this->VolFieldFiles->GetValue(i));
-      this->Parent->UpdateProgress(0.5 + (0.5 * ++nFieldsRead) / nFieldsToRead);
-    }
-    for (vtkIdType i = 0; i < this->DimFieldFiles->GetNumberOfValues(); ++i)
-    {
-      this->GetVolFieldAtTimeStep(this->DimFieldFiles->GetValue(i), true); // Internal field
-      this->Parent->UpdateProgress(0.5 + (0.5 * ++nFieldsRead) / nFieldsToRead);
-    }
-    for (vtkIdType i = 0; i < this->PointFieldFiles->GetNumberOfValues(); ++i)
-    {
-      this->GetPointFieldAtTimeStep(this->PointFieldFiles->GetValue(i));
-      this->Parent->UpdateProgress(0.5 + (0.5 * ++nFieldsRead) / nFieldsToRead);
-    }
-#if VTK_FOAMFILE_FINITE_AREA
-    for (vtkIdType i = 0; i < this->AreaFieldFiles->GetNumberOfValues(); ++i)
-    {
-      this->GetAreaFieldAtTimeStep(this->AreaFieldFiles->GetValue(i));
-      this->Parent->UpdateProgress(0.5 + (0.5 * ++nFieldsRead) / nFieldsToRead);
-    }
-#endif
+    this->ReadFieldFiles();
   }
 
   // Read lagrangian mesh and fields
@@ -11604,9 +11867,12 @@ int vtkOpenFOAMReader::MakeMetaDataAtTimeStep(const bool listNextTimeStep)
 
     appendUniq(lagrangianPaths, reader->GetLagrangianPaths());
   }
+
+  std::unique_lock<std::mutex> selectionLock(this->Parent->SelectionMutex);
   this->AddSelectionNames(this->Parent->CellDataArraySelection, cellDataNames);
   this->AddSelectionNames(this->Parent->PointDataArraySelection, pointDataNames);
   this->AddSelectionNames(this->Parent->LagrangianDataArraySelection, lagrangianDataNames);
+  selectionLock.unlock();
 
   lagrangianPaths->Squeeze();
   vtkSortDataArray::Sort(lagrangianPaths);
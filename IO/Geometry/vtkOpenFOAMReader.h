@@ -21,6 +21,9 @@
  * mesh information. The time folders contain transient data for the
  * cells. Each folder can contain any number of data files.
  *
+ * The field files of a time step are parsed concurrently with vtkSMPTools,
+ * a few at a time, and then added to the output in their listed order.
+ *
  * @par Thanks:
  * Thanks to Terry Jordan (terry.jordan@sa.netl.doe.gov) of SAIC
  * at the National Energy Technology Laboratory who originally
@@ -50,6 +53,9 @@
 #include "vtkIOGeometryModule.h" // For export macro
 #include "vtkMultiBlockDataSetAlgorithm.h"
 
+#include <atomic> // For std::atomic
+#include <mutex>  // For std::mutex
+
 class vtkCollection;
 class vtkCharArray;
 class vtkDataArraySelection;
@@ -428,9 +434,14 @@ protected:
   vtkStringArray* LagrangianPaths;
 
   // number of reader instances
-  int NumberOfReaders;
+  // (atomic since sub-readers may be set up and executed concurrently)
+  std::atomic<int> NumberOfReaders;
   // index of the active reader
-  int CurrentReaderIndex;
+  std::atomic<int> CurrentReaderIndex;
+
+  // guards the array selections, which the sub-readers of a decomposed case
+  // read and extend concurrently
+  std::mutex SelectionMutex;
 
   vtkOpenFOAMReader();
   ~vtkOpenFOAMReader() override;
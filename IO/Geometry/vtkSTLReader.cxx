@@ -19,6 +19,7 @@
 #include "vtkCellData.h"
 #include "vtkErrorCode.h"
 #include "vtkFloatArray.h"
+#include "vtkIdTypeArray.h"
 #include "vtkIncrementalPointLocator.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
@@ -26,14 +27,20 @@
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkUnsignedCharArray.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cctype>
+#include <cmath>
 #include <cstdlib>
+#include <cstring>
+#include <numeric>
 #include <string>
+#include <vector>
 #include <vtksys/SystemTools.hxx>
 
 vtkStandardNewMacro(vtkSTLReader);
@@ -44,6 +51,168 @@ vtkStandardNewMacro(vtkSTLReader);
 vtkCxxSetObjectMacro(vtkSTLReader, Locator, vtkIncrementalPointLocator);
 vtkCxxSetObjectMacro(vtkSTLReader, BinaryHeader, vtkUnsignedCharArray);
 
+namespace
+{
+//------------------------------------------------------------------------------
+// Number of binary facets read from disk and decoded per block.
+constexpr vtkIdType STLBinaryBlockSize = 1 << 18;
+
+// Number of ASCII vertex records converted per batch.
+constexpr vtkIdType STLASCIIBatchSize = 1 << 16;
+
+//------------------------------------------------------------------------------
+// Points are read as soup: every triangle owns three consecutive points.
+void STLSetTriangleSoup(vtkCellArray* polys, vtkIdType numTris)
+{
+  vtkNew<vtkIdTypeArray> conn;
+  conn->SetNumberOfValues(3 * numTris);
+  vtkIdType* ids = conn->GetPointer(0);
+  vtkSMPTools::For(0, 3 * numTris, [ids](vtkIdType begin, vtkIdType end) {
+    std::iota(ids + begin, ids + end, begin);
+  });
+  polys->SetData(3, conn);
+}
+
+//------------------------------------------------------------------------------
+// Orders point ids on their coordinates. Coordinates are compared by value,
+// as vtkMergePoints does, so -0 and +0 are coincident. A NaN is ordered after
+// every number to keep a strict weak ordering, but is never coincident with
+// anything, as it never compares equal in vtkMergePoints either: points with
+// a NaN coordinate are never merged. Ties are broken on the id so that the
+// first point of every run of coincident points is the one that appears
+// first in the file.
+class STLCoordinateLess
+{
+public:
+  explicit STLCoordinateLess(const float* coords)
+    : Coords(coords)
+  {
+  }
+
+  bool operator()(vtkIdType a, vtkIdType b) const
+  {
+    for (int i = 0; i < 3; ++i)
+    {
+      const float va = this->Coords[3 * a + i];
+      const float vb = this->Coords[3 * b + i];
+      if (va < vb || (!std::isnan(va) && std::isnan(vb)))
+      {
+        return true;
+      }
+      if (vb < va || (std::isnan(va) && !std::isnan(vb)))
+      {
+        return false;
+      }
+    }
+    return a < b;
+  }
+
+  bool Coincident(vtkIdType a, vtkIdType b) const
+  {
+    return this->Coords[3 * a] == this->Coords[3 * b] &&
+      this->Coords[3 * a + 1] == this->Coords[3 * b + 1] &&
+      this->Coords[3 * a + 2] == this->Coords[3 * b + 2];
+  }
+
+private:
+  const float* Coords;
+};
+
+//------------------------------------------------------------------------------
+// Merge coincident points of a triangle soup with a parallel sort instead of
+// incremental insertion into a locator, then drop the triangles that became
+// degenerate. Merged point ids are assigned in order of first occurrence so
+// the output is identical to the one produced through vtkMergePoints.
+void STLMergeTriangleSoup(vtkPoints* inPts, vtkFloatArray* inScalars, vtkPoints* outPts,
+  vtkCellArray* outPolys, vtkFloatArray* outScalars)
+{
+  const vtkIdType numPts = inPts->GetNumberOfPoints();
+  const vtkIdType numTris = numPts / 3;
+  const float* x = vtkArrayDownCast<vtkFloatArray>(inPts->GetData())->GetPointer(0);
+  STLCoordinateLess less(x);
+
+  std::vector<vtkIdType> order(numPts);
+  std::iota(order.begin(), order.end(), 0);
+  vtkSMPTools::Sort(order.begin(), order.end(), less);
+
+  // Make every point refer to the first point of its run of coincident points.
+  std::vector<vtkIdType> pointMap(numPts);
+  vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+    vtkIdType first = begin;
+    while (first > 0 && less.Coincident(order[first - 1], order[begin]))
+    {
+      --first;
+    }
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      if (i > begin && !less.Coincident(order[i - 1], order[i]))
+      {
+        first = i;
+      }
+      pointMap[order[i]] = order[first];
+    }
+  });
+  std::vector<vtkIdType>().swap(order);
+
+  // Number the representatives; a representative always precedes the points
+  // that refer to it, so the map can be rewritten in place.
+  vtkIdType numMerged = 0;
+  for (vtkIdType i = 0; i < numPts; ++i)
+  {
+    pointMap[i] = (pointMap[i] == i ? numMerged++ : pointMap[pointMap[i]]);
+  }
+
+  outPts->SetDataTypeToFloat();
+  outPts->SetNumberOfPoints(numMerged);
+  float* y = vtkArrayDownCast<vtkFloatArray>(outPts->GetData())->GetPointer(0);
+  for (vtkIdType i = 0, next = 0; i < numPts; ++i)
+  {
+    if (pointMap[i] == next)
+    {
+      std::copy(x + 3 * i, x + 3 * i + 3, y + 3 * next++);
+    }
+  }
+
+  // Drop the triangles collapsed by the merge.
+  std::vector<vtkIdType> cellMap(numTris);
+  vtkSMPTools::For(0, numTris, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType t = begin; t < end; ++t)
+    {
+      const vtkIdType* nodes = pointMap.data() + 3 * t;
+      cellMap[t] = (nodes[0] != nodes[1] && nodes[0] != nodes[2] && nodes[1] != nodes[2]);
+    }
+  });
+  vtkIdType numKept = 0;
+  for (vtkIdType t = 0; t < numTris; ++t)
+  {
+    cellMap[t] = (cellMap[t] ? numKept++ : -1);
+  }
+
+  vtkNew<vtkIdTypeArray> conn;
+  conn->SetNumberOfValues(3 * numKept);
+  vtkIdType* ids = conn->GetPointer(0);
+  if (outScalars)
+  {
+    outScalars->SetNumberOfValues(numKept);
+  }
+  vtkSMPTools::For(0, numTris, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType t = begin; t < end; ++t)
+    {
+      const vtkIdType cellId = cellMap[t];
+      if (cellId >= 0)
+      {
+        std::copy(pointMap.data() + 3 * t, pointMap.data() + 3 * t + 3, ids + 3 * cellId);
+        if (outScalars)
+        {
+          outScalars->SetValue(cellId, inScalars->GetValue(t));
+        }
+      }
+    }
+  });
+  outPolys->SetData(3, conn);
+}
+}
+
 //------------------------------------------------------------------------------
 // Construct object with merging set to true.
 vtkSTLReader::vtkSTLReader()
@@ -116,7 +285,6 @@ int vtkSTLReader::RequestData(vtkInformation* vtkNotUsed(request),
   if (this->GetSTLFileType(this->FileName) == VTK_ASCII)
   {
     newPts->Allocate(5000);
-    newPolys->AllocateEstimate(10000, 1);
     if (this->ScalarTags)
     {
       newScalars = vtkSmartPointer<vtkFloatArray>::New();
@@ -152,51 +320,58 @@ int vtkSTLReader::RequestData(vtkInformation* vtkNotUsed(request),
 
   fclose(fp);
 
-  // If merging is on, create hash table and merge points/triangles.
+  // If merging is on, merge coincident points and drop collapsed triangles.
+  // Unless a locator was provided this is done by sorting the points, which
+  // runs in parallel; a user-supplied locator gets the points one at a time.
   vtkSmartPointer<vtkPoints> mergedPts = newPts;
   vtkSmartPointer<vtkCellArray> mergedPolys = newPolys;
   vtkSmartPointer<vtkFloatArray> mergedScalars = newScalars;
   if (this->Merging)
   {
     mergedPts = vtkSmartPointer<vtkPoints>::New();
-    mergedPts->Allocate(newPts->GetNumberOfPoints() / 2);
     mergedPolys = vtkSmartPointer<vtkCellArray>::New();
-    mergedPolys->AllocateCopy(newPolys);
     if (newScalars)
     {
       mergedScalars = vtkSmartPointer<vtkFloatArray>::New();
-      mergedScalars->Allocate(newPolys->GetNumberOfCells());
     }
 
-    vtkSmartPointer<vtkIncrementalPointLocator> locator = this->Locator;
     if (this->Locator == nullptr)
     {
-      locator.TakeReference(this->NewDefaultLocator());
+      STLMergeTriangleSoup(newPts, newScalars, mergedPts, mergedPolys, mergedScalars);
     }
-    locator->InitPointInsertion(mergedPts, newPts->GetBounds());
-
-    int nextCell = 0;
-    const vtkIdType* pts = nullptr;
-    vtkIdType npts;
-    for (newPolys->InitTraversal(); newPolys->GetNextCell(npts, pts);)
+    else
     {
-      vtkIdType nodes[3];
-      for (int i = 0; i < 3; i++)
+      mergedPts->Allocate(newPts->GetNumberOfPoints() / 2);
+      mergedPolys->AllocateCopy(newPolys);
+      if (newScalars)
       {
-        double x[3];
-        newPts->GetPoint(pts[i], x);
-        locator->InsertUniquePoint(x, nodes[i]);
+        mergedScalars->Allocate(newPolys->GetNumberOfCells());
       }
+      this->Locator->InitPointInsertion(mergedPts, newPts->GetBounds());
 
-      if (nodes[0] != nodes[1] && nodes[0] != nodes[2] && nodes[1] != nodes[2])
+      int nextCell = 0;
+      const vtkIdType* pts = nullptr;
+      vtkIdType npts;
+      for (newPolys->InitTraversal(); newPolys->GetNextCell(npts, pts);)
       {
-        mergedPolys->InsertNextCell(3, nodes);
-        if (newScalars)
+        vtkIdType nodes[3];
+        for (int i = 0; i < 3; i++)
+        {
+          double x[3];
+          newPts->GetPoint(pts[i], x);
+          this->Locator->InsertUniquePoint(x, nodes[i]);
+        }
+
+        if (nodes[0] != nodes[1] && nodes[0] != nodes[2] && nodes[1] != nodes[2])
         {
-          mergedScalars->InsertNextValue(newScalars->GetValue(nextCell));
+          mergedPolys->InsertNextCell(3, nodes);
+          if (newScalars)
+          {
+            mergedScalars->InsertNextValue(newScalars->GetValue(nextCell));
+          }
         }
+        nextCell++;
       }
-      nextCell++;
     }
 
     vtkDebugMacro(<< "Merged to: " << mergedPts->GetNumberOfPoints() << " points, "
@@ -225,13 +400,6 @@ int vtkSTLReader::RequestData(vtkInformation* vtkNotUsed(request),
 //------------------------------------------------------------------------------
 bool vtkSTLReader::ReadBinarySTL(FILE* fp, vtkPoints* newPts, vtkCellArray* newPolys)
 {
-  struct facet_t_t
-  {
-    float n[3], v1[3], v2[3], v3[3];
-    unsigned short junk;
-  };
-  using facet_t = struct facet_t_t;
-
   vtkDebugMacro(<< "Reading BINARY STL file");
 
   //  File is read to obtain raw information as well as bounding box
@@ -263,63 +431,54 @@ bool vtkSTLReader::ReadBinarySTL(FILE* fp, vtkPoints* newPts, vtkCellArray* newP
   }
   vtkByteSwap::Swap4LE(&ulint);
 
-  // Many .stl files contain bogus count.  Hence we will ignore and read
-  //   until end of file.
-  //
-  int numTris = static_cast<int>(ulint);
-  if (numTris <= 0)
-  {
-    vtkDebugMacro(<< "Bad binary count: attempting to correct(" << numTris << ")");
-  }
-
-  // Verify the numTris with the length of the file
-  unsigned long ulFileLength = vtksys::SystemTools::FileLength(this->FileName);
-  ulFileLength -= (80 + 4); // 80 byte - header, 4 byte - tringle count
-  ulFileLength /=
-    50; // 50 byte - twelve 32-bit-floating point numbers + 2 byte for attribute byte count
-
-  if (numTris < static_cast<int>(ulFileLength))
+  // Many .stl files contain bogus count.  Hence we will ignore it and take
+  // the number of facets from the length of the file: 80 byte header, 4 byte
+  // triangle count, then 50 bytes (twelve 32-bit floats + 2 byte attribute
+  // byte count) per facet.
+  if (static_cast<int>(ulint) <= 0)
   {
-    numTris = static_cast<int>(ulFileLength);
+    vtkDebugMacro(<< "Bad binary count: attempting to correct(" << static_cast<int>(ulint) << ")");
   }
+  vtkIdType fileLength = static_cast<vtkIdType>(vtksys::SystemTools::FileLength(this->FileName));
+  vtkIdType numTris = std::max<vtkIdType>(fileLength - (80 + 4), 0) / 50;
 
   // now we can allocate the memory we need for this STL file
-  newPts->Allocate(numTris * 3);
-  newPolys->AllocateEstimate(numTris, 3);
-
-  facet_t facet;
-  for (int i = 0; fread(&facet, 50, 1, fp) > 0; i++)
+  newPts->SetDataTypeToFloat();
+  newPts->SetNumberOfPoints(3 * numTris);
+  float* coords = vtkArrayDownCast<vtkFloatArray>(newPts->GetData())->GetPointer(0);
+
+  // Read the facets in large blocks and decode each block in parallel
+  // straight into the point coordinates.
+  std::vector<unsigned char> block(50 * std::min(numTris, STLBinaryBlockSize));
+  vtkIdType numRead = 0;
+  while (numRead < numTris)
   {
-    vtkByteSwap::Swap4LE(facet.n);
-    vtkByteSwap::Swap4LE(facet.n + 1);
-    vtkByteSwap::Swap4LE(facet.n + 2);
-
-    vtkByteSwap::Swap4LE(facet.v1);
-    vtkByteSwap::Swap4LE(facet.v1 + 1);
-    vtkByteSwap::Swap4LE(facet.v1 + 2);
-
-    vtkByteSwap::Swap4LE(facet.v2);
-    vtkByteSwap::Swap4LE(facet.v2 + 1);
-    vtkByteSwap::Swap4LE(facet.v2 + 2);
-
-    vtkByteSwap::Swap4LE(facet.v3);
-    vtkByteSwap::Swap4LE(facet.v3 + 1);
-    vtkByteSwap::Swap4LE(facet.v3 + 2);
-
-    vtkIdType pts[3];
-    pts[0] = newPts->InsertNextPoint(facet.v1);
-    pts[1] = newPts->InsertNextPoint(facet.v2);
-    pts[2] = newPts->InsertNextPoint(facet.v3);
-
-    newPolys->InsertNextCell(3, pts);
+    const size_t numWanted = static_cast<size_t>(std::min(numTris - numRead, STLBinaryBlockSize));
+    const vtkIdType numInBlock = static_cast<vtkIdType>(fread(block.data(), 50, numWanted, fp));
+    const unsigned char* facets = block.data();
+    float* blockCoords = coords + 9 * numRead;
+    vtkSMPTools::For(0, numInBlock, [facets, blockCoords](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        // skip the normal, keep the three vertices
+        float* v = blockCoords + 9 * i;
+        std::memcpy(v, facets + 50 * i + 12, 9 * sizeof(float));
+        vtkByteSwap::Swap4LERange(v, 9);
+      }
+    });
+    numRead += numInBlock;
 
-    if ((i % 100000) == 0 && i != 0)
+    vtkDebugMacro(<< "triangle# " << numRead);
+    this->UpdateProgress(static_cast<double>(numRead) / numTris);
+    if (static_cast<size_t>(numInBlock) < numWanted)
     {
-      vtkDebugMacro(<< "triangle# " << i);
-      this->UpdateProgress(static_cast<double>(i) / numTris);
+      break;
     }
   }
 
+  newPts->SetNumberOfPoints(3 * numRead);
+  STLSetTriangleSoup(newPolys, numRead);
+
   return true;
 }
 
@@ -361,6 +520,68 @@ bool stlReadVertex(char* buf, float vertCoord[3])
   return true;
 }
 
+// Vertex records are collected while the grammar of the file is checked and
+// are converted to floats one batch at a time, in parallel, straight into the
+// point coordinates.
+class stlVertexBatch
+{
+public:
+  void Add(const char* text, int lineNum)
+  {
+    this->Offsets.push_back(this->Text.size());
+    this->Text.insert(this->Text.end(), text, text + strlen(text) + 1);
+    this->LineNumbers.push_back(lineNum);
+  }
+
+  vtkIdType GetNumberOfVertices() const { return static_cast<vtkIdType>(this->Offsets.size()); }
+
+  // Append the batch to the points and clear it. Returns false and sets
+  // lineNum to the line of the first invalid record on failure.
+  bool Flush(vtkPoints* pts, int& lineNum)
+  {
+    const vtkIdType numVerts = this->GetNumberOfVertices();
+    const vtkIdType offset = pts->GetNumberOfPoints();
+    vtkFloatArray* coords = vtkArrayDownCast<vtkFloatArray>(pts->GetData());
+    if (3 * (offset + numVerts) > coords->GetSize())
+    {
+      // grow geometrically, the caller squeezes the points once done
+      coords->Resize(std::max(offset + numVerts, 2 * offset));
+    }
+    coords->SetNumberOfTuples(offset + numVerts);
+    float* x = coords->GetPointer(3 * offset);
+
+    std::atomic<vtkIdType> firstBad(numVerts);
+    vtkSMPTools::For(0, numVerts, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        if (!stlReadVertex(&this->Text[this->Offsets[i]], x + 3 * i))
+        {
+          vtkIdType bad = firstBad;
+          while (i < bad && !firstBad.compare_exchange_weak(bad, i))
+          {
+          }
+          break;
+        }
+      }
+    });
+
+    const bool ok = (firstBad == numVerts);
+    if (!ok)
+    {
+      lineNum = this->LineNumbers[firstBad];
+    }
+    this->Text.clear();
+    this->Offsets.clear();
+    this->LineNumbers.clear();
+    return ok;
+  }
+
+private:
+  std::vector<char> Text;
+  std::vector<size_t> Offsets;
+  std::vector<int> LineNumbers;
+};
+
 } // end of anonymous namespace
 
 // https://en.wikipedia.org/wiki/STL_%28file_format%29#ASCII_STL
@@ -396,9 +617,9 @@ bool vtkSTLReader::ReadASCIISTL(
   this->SetBinaryHeader(nullptr);
   std::string header;
 
-  char line[256];     // line buffer
-  float vertCoord[3]; // scratch space when parsing "vertex %f %f %f"
-  vtkIdType pts[3];   // point ids for building triangles
+  char line[256];        // line buffer
+  stlVertexBatch vertices; // "vertex %f %f %f" records awaiting conversion
+  vtkIdType numTris = 0;
   int vertOff = 0;
 
   int solidId = -1;
@@ -576,34 +797,32 @@ bool vtkSTLReader::ReadASCIISTL(
       {
         if (!strcmp(cmd, "vertex"))
         {
-          if (stlReadVertex(arg, vertCoord))
+          vertices.Add(arg, lineNum);
+          ++vertOff; // Next vertex
+
+          if (vertOff >= 3)
           {
-            pts[vertOff] = newPts->InsertNextPoint(vertCoord);
-            ++vertOff; // Next vertex
+            // Finished this triangle.
+            vertOff = 0;
+            state = scanEndLoop; // Next state
 
-            if (vertOff >= 3)
+            ++numTris;
+            if (scalars)
             {
-              // Finished this triangle.
-              vertOff = 0;
-              state = scanEndLoop; // Next state
-
-              // Save as cell
-              newPolys->InsertNextCell(3, pts);
-              if (scalars)
-              {
-                scalars->InsertNextValue(solidId);
-              }
+              scalars->InsertNextValue(solidId);
+            }
 
-              if ((newPolys->GetNumberOfCells() % 5000) == 0)
+            if (vertices.GetNumberOfVertices() >= STLASCIIBatchSize)
+            {
+              int badLine;
+              if (!vertices.Flush(newPts, badLine))
               {
-                this->UpdateProgress((newPolys->GetNumberOfCells() % 50000) / 50000.0);
+                lineNum = badLine;
+                errorMessage = "Parse error reading STL vertex";
               }
+              this->UpdateProgress((numTris % 50000) / 50000.0);
             }
           }
-          else
-          {
-            errorMessage = "Parse error reading STL vertex";
-          }
         }
         else
         {
@@ -650,6 +869,17 @@ bool vtkSTLReader::ReadASCIISTL(
     }
   }
 
+  // Convert the remaining vertices. A bad vertex takes precedence over any
+  // error found further down the file.
+  int badLine;
+  if (vertices.GetNumberOfVertices() > 0 && !vertices.Flush(newPts, badLine))
+  {
+    lineNum = badLine;
+    errorMessage = "Parse error reading STL vertex";
+  }
+  newPts->Squeeze();
+  STLSetTriangleSoup(newPolys, numTris);
+
   this->SetHeader(header.c_str());
 
   if (!errorMessage.empty())
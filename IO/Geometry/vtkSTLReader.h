@@ -24,8 +24,13 @@
  * .stl files are quite inefficient since they duplicate vertex
  * definitions. By setting the Merging boolean you can control whether the
  * point data is merged after reading. Merging is performed by default,
- * however, merging requires a large amount of temporary storage since a
- * 3D hash table must be constructed.
+ * however, merging requires a large amount of temporary storage since the
+ * points have to be sorted (or, if a locator is set, a 3D hash table must
+ * be constructed).
+ *
+ * Binary files are read in large blocks that are decoded in parallel
+ * directly into the output points, and the vertices of ASCII files are
+ * converted in parallel batches; both use vtkSMPTools.
  *
  * @warning
  * Binary files written on one system may not be readable on other systems.
@@ -80,8 +85,10 @@ public:
 
   ///@{
   /**
-   * Specify a spatial locator for merging points. By
-   * default an instance of vtkMergePoints is used.
+   * Specify a spatial locator for merging points. By default no locator is
+   * set and coincident points are merged by sorting them in parallel, which
+   * gives the same result as inserting them into a vtkMergePoints. When a
+   * locator is set, points are inserted into it one at a time instead.
    */
   void SetLocator(vtkIncrementalPointLocator* locator);
   vtkGetObjectMacro(Locator, vtkIncrementalPointLocator);
@@ -111,7 +118,7 @@ protected:
   ~vtkSTLReader() override;
 
   /**
-   * Create default locator. Used to create one when none is specified.
+   * Create default locator, an instance of vtkMergePoints.
    */
   vtkIncrementalPointLocator* NewDefaultLocator();
 
@@ -0,0 +1,95 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TimePLYReader.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Throughput of vtkPLYReader on binary and ASCII files written from a
+// synthetic sphere, checking that the mesh survives the round trip.
+
+#include "vtkCellArray.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPLYReader.h"
+#include "vtkPLYWriter.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+#include "vtkSphereSource.h"
+#include "vtkTestUtilities.h"
+#include "vtkTimerLog.h"
+
+#include <vtksys/SystemTools.hxx>
+
+#include <string>
+
+int TimePLYReader(int argc, char* argv[])
+{
+  char* tempDir =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  std::string testDirectory = tempDir;
+  delete[] tempDir;
+
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(500);
+  sphere->SetPhiResolution(500);
+  sphere->Update();
+  vtkPolyData* input = sphere->GetOutput();
+
+  cout << "SMP backend " << vtkSMPTools::GetBackend() << ", "
+       << vtkSMPTools::GetEstimatedNumberOfThreads() << " threads\n";
+
+  vtkNew<vtkTimerLog> timer;
+  int status = EXIT_SUCCESS;
+  for (int fileType : { VTK_BINARY, VTK_ASCII })
+  {
+    const std::string fileName = testDirectory +
+      (fileType == VTK_BINARY ? "/TimePLYReaderBinary.ply" : "/TimePLYReaderASCII.ply");
+
+    vtkNew<vtkPLYWriter> writer;
+    writer->SetInputData(input);
+    writer->SetFileName(fileName.c_str());
+    writer->SetFileType(fileType);
+    writer->Write();
+
+    vtkNew<vtkPLYReader> reader;
+    reader->SetFileName(fileName.c_str());
+    timer->StartTimer();
+    reader->Update();
+    timer->StopTimer();
+    cout << fileName << ": "
+         << vtksys::SystemTools::FileLength(fileName) / (1024.0 * 1024.0) /
+        timer->GetElapsedTime()
+         << " MB/s\n";
+
+    vtkPolyData* output = reader->GetOutput();
+    if (output->GetNumberOfPoints() != input->GetNumberOfPoints() ||
+      output->GetNumberOfPolys() != input->GetNumberOfPolys())
+    {
+      cerr << "Round trip through " << fileName << " changed the mesh\n";
+      status = EXIT_FAILURE;
+      continue;
+    }
+    for (vtkIdType i = 0; i < input->GetNumberOfPoints(); ++i)
+    {
+      double x[3], y[3];
+      input->GetPoint(i, x);
+      output->GetPoint(i, y);
+      if (vtkMath::Distance2BetweenPoints(x, y) > 1e-10)
+      {
+        cerr << "Point " << i << " of " << fileName << " differs\n";
+        status = EXIT_FAILURE;
+        break;
+      }
+    }
+  }
+
+  return status;
+}
@@ -50,10 +50,14 @@ WARRANTY OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE.
 #include "vtkByteSwap.h"
 #include "vtkHeap.h"
 #include "vtkMath.h"
+#include "vtkSMPTools.h"
 #include <vtksys/FStream.hxx>
 #include <vtksys/SystemTools.hxx>
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <cctype>
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
@@ -92,7 +96,7 @@ void* plyAllocateMemory(size_t n)
 const char* type_names[] = { "invalid", "char", "short", "int", "int8", "int16", "int32", "uchar",
   "ushort", "uint", "uint8", "uint16", "uint32", "float", "float32", "double", "float64" };
 
-const int ply_type_size[] = { 0, 1, 2, 4, 1, 2, 4, 1, 2, 4, 1, 2, 4, 4, 4, 8 };
+const int ply_type_size[] = { 0, 1, 2, 4, 1, 2, 4, 1, 2, 4, 1, 2, 4, 4, 4, 8, 8 };
 }
 
 #define NO_OTHER_PROPS (-1)
@@ -1519,22 +1523,9 @@ Entry:
 
 bool vtkPLY::ascii_get_element(PlyFile* plyfile, char* elem_ptr)
 {
-  int j, k;
   PlyElement* elem;
-  PlyProperty* prop;
   std::vector<char*> words;
-  int which_word;
-  char *elem_data, *item = nullptr;
-  char* item_ptr;
-  int item_size;
-  int int_val = 0;
-  unsigned int uint_val = 0;
-  double double_val = 0.0;
-  int list_count;
-  int store_it;
-  char** store_array;
   char* other_data = nullptr;
-  int other_flag;
 
   char line_words[LINE_LENGTH];
   char orig_line[LINE_LENGTH];
@@ -1547,15 +1538,12 @@ bool vtkPLY::ascii_get_element(PlyFile* plyfile, char* elem_ptr)
   if (elem->other_offset != NO_OTHER_PROPS)
   {
     char** ptr;
-    other_flag = 1;
     /* make room for other_props */
     other_data = (char*)plyAllocateMemory(elem->other_size);
     /* store pointer in user's structure to the other_props */
     ptr = (char**)(elem_ptr + elem->other_offset);
     *ptr = other_data;
   }
-  else
-    other_flag = 0;
 
   /* read in the element */
 
@@ -1567,6 +1555,39 @@ bool vtkPLY::ascii_get_element(PlyFile* plyfile, char* elem_ptr)
     return false;
   }
 
+  return ascii_store_words(elem, words, elem_ptr, other_data);
+}
+
+/******************************************************************************
+Store the words of one line of an ascii file into an element.
+
+Entry:
+  elem       - the element being read
+  words      - the words of the line
+  elem_ptr   - pointer to element
+  other_data - storage for the properties not asked for, or nullptr if none
+
+Exit:
+  returns false if the line has too few words
+******************************************************************************/
+
+bool vtkPLY::ascii_store_words(
+  PlyElement* elem, const std::vector<char*>& words, char* elem_ptr, char* other_data)
+{
+  int j, k;
+  PlyProperty* prop;
+  size_t which_word;
+  char *elem_data, *item = nullptr;
+  char* item_ptr;
+  int item_size;
+  int int_val = 0;
+  unsigned int uint_val = 0;
+  double double_val = 0.0;
+  int list_count;
+  int store_it;
+  char** store_array;
+  int other_flag = (other_data != nullptr);
+
   which_word = 0;
 
   for (j = 0; j < elem->nprops; j++)
@@ -1581,6 +1602,9 @@ bool vtkPLY::ascii_get_element(PlyFile* plyfile, char* elem_ptr)
     else
       elem_data = other_data;
 
+    if (which_word >= words.size())
+      return false;
+
     if (prop->is_list)
     { /* a list */
 
@@ -1597,13 +1621,20 @@ bool vtkPLY::ascii_get_element(PlyFile* plyfile, char* elem_ptr)
       item_size = ply_type_size[prop->internal_type];
       store_array = (char**)(elem_data + prop->offset);
 
-      if (list_count == 0)
+      if (list_count <= 0)
       {
         if (store_it)
           *store_array = nullptr;
       }
       else
       {
+        if (which_word + list_count > words.size())
+        {
+          if (store_it)
+            *store_array = nullptr;
+          return false;
+        }
+
         if (store_it)
         {
           item_ptr = (char*)myalloc(sizeof(char) * item_size * list_count);
@@ -1638,6 +1669,156 @@ bool vtkPLY::ascii_get_element(PlyFile* plyfile, char* elem_ptr)
   return true;
 }
 
+/******************************************************************************
+Read a run of elements from a file. This is equivalent to calling
+ply_get_element() once per element, but the work is organized so that it
+can be done in parallel:
+
+  - ascii files are read in batches of lines, whose words are then converted
+    concurrently (each line holds exactly one element);
+  - in binary files, elements made of scalar properties only have a fixed
+    size, so a batch of them is read with a single read and the records are
+    decoded concurrently.
+
+Elements with list properties in binary files, and elements for which
+"other" properties are kept, are read one at a time.
+
+Entry:
+  plyfile   - file identifier
+  elem_ptr  - pointer to an array of num_elems elements
+  elem_size - size in bytes of one element of the array
+  num_elems - number of elements to read
+
+Exit:
+  returns false if the file ended prematurely or is malformed
+******************************************************************************/
+
+bool vtkPLY::ply_get_elements(PlyFile* plyfile, void* elem_ptr, int elem_size, int num_elems)
+{
+  PlyElement* elem = plyfile->which_elem;
+  char* elems = static_cast<char*>(elem_ptr);
+  const size_t stride = static_cast<size_t>(elem_size);
+
+  // Determine the record size of fixed-size binary elements.
+  int record_size = 0;
+  for (int j = 0; j < elem->nprops && record_size >= 0; j++)
+  {
+    const PlyProperty* prop = elem->props[j];
+    record_size = prop->is_list ? -1 : record_size + ply_type_size[prop->external_type];
+  }
+
+  if (elem->other_offset != NO_OTHER_PROPS ||
+    (plyfile->file_type != PLY_ASCII && record_size < 0))
+  {
+    bool ok = true;
+    for (int i = 0; i < num_elems && ok; i++)
+    {
+      ok = plyfile->file_type == PLY_ASCII ? ascii_get_element(plyfile, elems + i * stride)
+                                           : binary_get_element(plyfile, elems + i * stride);
+    }
+    return ok;
+  }
+
+  const int batch_size = 1 << 16;
+  std::atomic<bool> ok(true);
+  if (plyfile->file_type == PLY_ASCII)
+  {
+    std::string lines;
+    std::vector<size_t> starts;
+    for (int first = 0; first < num_elems && ok; first += batch_size)
+    {
+      const int count = std::min(batch_size, num_elems - first);
+      lines.clear();
+      starts.clear();
+      std::string line;
+      for (int i = 0; i < count; i++)
+      {
+        if (!std::getline(*plyfile->is, line))
+        {
+          fprintf(stderr, "ply_get_elements: unexpected end of file\n");
+          return false;
+        }
+        starts.push_back(lines.size());
+        lines.append(line);
+        lines.push_back('\0');
+      }
+
+      char* text = &lines[0];
+      char* first_elem = elems + first * stride;
+      vtkSMPTools::For(0, count, [&](vtkIdType begin, vtkIdType end) {
+        std::vector<char*> words;
+        for (vtkIdType i = begin; i < end; i++)
+        {
+          /* split the line in place into its words */
+          words.clear();
+          for (char* ptr = text + starts[i]; *ptr != '\0';)
+          {
+            if (isspace(static_cast<unsigned char>(*ptr)))
+            {
+              *ptr++ = '\0';
+              continue;
+            }
+            words.push_back(ptr);
+            while (*ptr != '\0' && !isspace(static_cast<unsigned char>(*ptr)))
+              ptr++;
+          }
+          if (!ascii_store_words(elem, words, first_elem + i * stride, nullptr))
+          {
+            ok = false;
+          }
+        }
+      });
+    }
+    return ok;
+  }
+
+  /* locate the stored properties inside of a record */
+  std::vector<std::pair<int, PlyProperty*>> stored;
+  for (int j = 0, pos = 0; j < elem->nprops; j++)
+  {
+    if (elem->store_prop[j])
+    {
+      stored.emplace_back(pos, elem->props[j]);
+    }
+    pos += ply_type_size[elem->props[j]->external_type];
+  }
+
+  std::vector<char> records;
+  const int file_type = plyfile->file_type;
+  for (int first = 0; first < num_elems; first += batch_size)
+  {
+    const int count = std::min(batch_size, num_elems - first);
+    records.resize(static_cast<size_t>(count) * record_size);
+    plyfile->is->read(records.data(), records.size());
+    if (!plyfile->is->good())
+    {
+      vtkGenericWarningMacro("PLY error reading file."
+        << " Premature EOF while reading element '" << elem->name << "'.");
+      return false;
+    }
+
+    const char* data = records.data();
+    char* first_elem = elems + first * stride;
+    vtkSMPTools::For(0, count, [&](vtkIdType begin, vtkIdType end) {
+      int int_val;
+      unsigned int uint_val;
+      double double_val;
+      for (vtkIdType i = begin; i < end; i++)
+      {
+        const char* record = data + i * record_size;
+        for (const auto& prop : stored)
+        {
+          decode_binary_item(record + prop.first, prop.second->external_type, file_type, &int_val,
+            &uint_val, &double_val);
+          store_item(first_elem + i * stride + prop.second->offset, prop.second->internal_type,
+            int_val, uint_val, double_val);
+        }
+      }
+    });
+  }
+  return true;
+}
+
 /******************************************************************************
 Read an element from a binary file.
 
@@ -2288,20 +2469,52 @@ Exit:
 
 bool vtkPLY::get_binary_item(
   PlyFile* plyfile, int type, int* int_val, unsigned int* uint_val, double* double_val)
+{
+  if (type <= PLY_START_TYPE || type >= PLY_END_TYPE)
+  {
+    fprintf(stderr, "get_binary_item: bad type = %d\n", type);
+    assert(0);
+    return false;
+  }
+
+  char value[8];
+  plyfile->is->read(value, ply_type_size[type]);
+  if (!plyfile->is->good())
+  {
+    vtkGenericWarningMacro("PLY error reading file."
+      << " Premature EOF while reading " << type_names[type] << ".");
+    return false;
+  }
+
+  decode_binary_item(value, type, plyfile->file_type, int_val, uint_val, double_val);
+  return true;
+}
+
+/******************************************************************************
+Decode an item of a binary file that was already read into memory, and place
+the result into an integer, an unsigned integer and a double.
+
+Entry:
+  ptr       - the bytes of the item, as found in the file
+  type      - data type of the item
+  file_type - byte order of the file (PLY_BINARY_BE or PLY_BINARY_LE)
+
+Exit:
+  int_val    - integer value
+  uint_val   - unsigned integer value
+  double_val - double-precision floating point value
+******************************************************************************/
+
+void vtkPLY::decode_binary_item(const char* ptr, int type, int file_type, int* int_val,
+  unsigned int* uint_val, double* double_val)
 {
   switch (type)
   {
     case PLY_CHAR:
     case PLY_INT8:
     {
-      vtkTypeInt8 value = 0;
-      plyfile->is->read(reinterpret_cast<char*>(&value), sizeof(value));
-      if (!plyfile->is->good())
-      {
-        vtkGenericWarningMacro("PLY error reading file."
-          << " Premature EOF while reading char.");
-        return false;
-      }
+      vtkTypeInt8 value;
+      memcpy(&value, ptr, sizeof(value));
 
       // Here value can always fit in int, unsigned int, and double.
       *int_val = static_cast<int>(value);
@@ -2312,14 +2525,8 @@ bool vtkPLY::get_binary_item(
     case PLY_UCHAR:
     case PLY_UINT8:
     {
-      vtkTypeUInt8 value = 0;
-      plyfile->is->read(reinterpret_cast<char*>(&value), sizeof(value));
-      if (!plyfile->is->good())
-      {
-        vtkGenericWarningMacro("PLY error reading file."
-          << " Premature EOF while reading uchar or uint8.");
-        return false;
-      }
+      vtkTypeUInt8 value;
+      memcpy(&value, ptr, sizeof(value));
 
       // Here value can always fit in int, unsigned int, and double.
       *int_val = static_cast<int>(value);
@@ -2330,16 +2537,9 @@ bool vtkPLY::get_binary_item(
     case PLY_SHORT:
     case PLY_INT16:
     {
-      vtkTypeInt16 value = 0;
-      plyfile->is->read(reinterpret_cast<char*>(&value), sizeof(value));
-      if (!plyfile->is->good())
-      {
-        vtkGenericWarningMacro("PLY error reading file."
-          << " Premature EOF while reading short.");
-        return false;
-      }
-      plyfile->file_type == PLY_BINARY_BE ? vtkByteSwap::Swap2BE(&value)
-                                          : vtkByteSwap::Swap2LE(&value);
+      vtkTypeInt16 value;
+      memcpy(&value, ptr, sizeof(value));
+      file_type == PLY_BINARY_BE ? vtkByteSwap::Swap2BE(&value) : vtkByteSwap::Swap2LE(&value);
 
       // Here value can always fit in int, unsigned int, and double.
       *int_val = static_cast<int>(value);
@@ -2350,16 +2550,9 @@ bool vtkPLY::get_binary_item(
     case PLY_USHORT:
     case PLY_UINT16:
     {
-      vtkTypeUInt16 value = 0;
-      plyfile->is->read(reinterpret_cast<char*>(&value), sizeof(value));
-      if (!plyfile->is->good())
-      {
-        vtkGenericWarningMacro("PLY error reading file."
-          << " Premature EOF while reading ushort.");
-        return false;
-      }
-      plyfile->file_type == PLY_BINARY_BE ? vtkByteSwap::Swap2BE(&value)
-                                          : vtkByteSwap::Swap2LE(&value);
+      vtkTypeUInt16 value;
+      memcpy(&value, ptr, sizeof(value));
+      file_type == PLY_BINARY_BE ? vtkByteSwap::Swap2BE(&value) : vtkByteSwap::Swap2LE(&value);
 
       // Here value can always fit in int, unsigned int, and double.
       *int_val = static_cast<int>(value);
@@ -2370,16 +2563,9 @@ bool vtkPLY::get_binary_item(
     case PLY_INT:
     case PLY_INT32:
     {
-      vtkTypeInt32 value = 0;
-      plyfile->is->read(reinterpret_cast<char*>(&value), sizeof(value));
-      if (!plyfile->is->good())
-      {
-        vtkGenericWarningMacro("PLY error reading file."
-          << " Premature EOF while reading int or int32.");
-        return false;
-      }
-      plyfile->file_type == PLY_BINARY_BE ? vtkByteSwap::Swap4BE(&value)
-                                          : vtkByteSwap::Swap4LE(&value);
+      vtkTypeInt32 value;
+      memcpy(&value, ptr, sizeof(value));
+      file_type == PLY_BINARY_BE ? vtkByteSwap::Swap4BE(&value) : vtkByteSwap::Swap4LE(&value);
 
       // Here value can always fit in int, unsigned int, and double.
       *int_val = static_cast<int>(value);
@@ -2390,16 +2576,9 @@ bool vtkPLY::get_binary_item(
     case PLY_UINT:
     case PLY_UINT32:
     {
-      vtkTypeUInt32 value = 0;
-      plyfile->is->read(reinterpret_cast<char*>(&value), sizeof(value));
-      if (!plyfile->is->good())
-      {
-        vtkGenericWarningMacro("PLY error reading file."
-          << " Premature EOF while reading uint");
-        return false;
-      }
-      plyfile->file_type == PLY_BINARY_BE ? vtkByteSwap::Swap4BE(&value)
-                                          : vtkByteSwap::Swap4LE(&value);
+      vtkTypeUInt32 value;
+      memcpy(&value, ptr, sizeof(value));
+      file_type == PLY_BINARY_BE ? vtkByteSwap::Swap4BE(&value) : vtkByteSwap::Swap4LE(&value);
 
       // Here value can always fit in int, unsigned int, and double.
       *int_val = static_cast<int>(value);
@@ -2410,16 +2589,9 @@ bool vtkPLY::get_binary_item(
     case PLY_FLOAT:
     case PLY_FLOAT32:
     {
-      vtkTypeFloat32 value = 0.0;
-      plyfile->is->read(reinterpret_cast<char*>(&value), sizeof(value));
-      if (!plyfile->is->good())
-      {
-        vtkGenericWarningMacro("PLY error reading file."
-          << " Premature EOF while reading float of float32.");
-        return false;
-      }
-      plyfile->file_type == PLY_BINARY_BE ? vtkByteSwap::Swap4BE(&value)
-                                          : vtkByteSwap::Swap4LE(&value);
+      vtkTypeFloat32 value;
+      memcpy(&value, ptr, sizeof(value));
+      file_type == PLY_BINARY_BE ? vtkByteSwap::Swap4BE(&value) : vtkByteSwap::Swap4LE(&value);
 
       // INT32_MIN (-2^31) is a power of 2 and thus exactly representable as float.
       // INT32_MAX (2^31 - 1) is not exactly representable as float; closest smaller integer is 2^31
@@ -2433,16 +2605,9 @@ bool vtkPLY::get_binary_item(
     case PLY_DOUBLE:
     case PLY_FLOAT64:
     {
-      vtkTypeFloat64 value = 0.0;
-      plyfile->is->read(reinterpret_cast<char*>(&value), sizeof(value));
-      if (!plyfile->is->good())
-      {
-        vtkGenericWarningMacro("PLY error reading file."
-          << " Premature EOF while reading double.");
-        return false;
-      }
-      plyfile->file_type == PLY_BINARY_BE ? vtkByteSwap::Swap8BE(&value)
-                                          : vtkByteSwap::Swap8LE(&value);
+      vtkTypeFloat64 value;
+      memcpy(&value, ptr, sizeof(value));
+      file_type == PLY_BINARY_BE ? vtkByteSwap::Swap8BE(&value) : vtkByteSwap::Swap8LE(&value);
 
       // Here we can just clamp and cast, all int32s can be exactly represented as doubles.
       *int_val =
@@ -2453,11 +2618,9 @@ bool vtkPLY::get_binary_item(
     }
     break;
     default:
-      fprintf(stderr, "get_binary_item: bad type = %d\n", type);
+      fprintf(stderr, "decode_binary_item: bad type = %d\n", type);
       assert(0);
-      return false;
   }
-  return true;
 }
 
 /******************************************************************************
@@ -29,6 +29,7 @@
 #include "vtkPoints.h"
 #include "vtkPolyData.h"
 #include "vtkPolygon.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStringArray.h"
 #include "vtkUnsignedCharArray.h"
@@ -132,6 +133,9 @@ typedef struct _plyFace
   unsigned char ntexcoord; // number of texcoord in list
   float* texcoord;         // texcoord list
 } plyFace;
+
+// Number of elements decoded at once by vtkPLY::ply_get_elements.
+const int plyBatchSize = 1 << 16;
 }
 
 int vtkPLYReader::RequestData(vtkInformation* vtkNotUsed(request),
@@ -395,30 +399,48 @@ int vtkPLYReader::RequestData(vtkInformation* vtkNotUsed(request),
         rgbPoints->SetNumberOfTuples(numPts);
       }
 
-      plyVertex vertex;
-      for (int j = 0; j < numPts; j++)
+      // Read the vertices in batches; each batch is decoded in parallel and
+      // then scattered in parallel into the point arrays.
+      float* x = vtkArrayDownCast<vtkFloatArray>(pts->GetData())->GetPointer(0);
+      float* tc = texCoordsPointsAvailable ? texCoordsPoints->GetPointer(0) : nullptr;
+      float* n = normalPointsAvailable ? normals->GetPointer(0) : nullptr;
+      unsigned char* rgb = rgbPointsAvailable ? rgbPoints->GetPointer(0) : nullptr;
+      const int rgbComps = rgbPointsHaveAlpha ? 4 : 3;
+      std::vector<plyVertex> vertices(std::min(numPts, plyBatchSize));
+      for (int first = 0; first < numPts; first += plyBatchSize)
       {
-        vtkPLY::ply_get_element(ply, (void*)&vertex);
-        pts->SetPoint(j, vertex.x);
-        if (texCoordsPointsAvailable)
-        {
-          texCoordsPoints->SetTuple2(j, vertex.tex[0], vertex.tex[1]);
-        }
-        if (normalPointsAvailable)
+        const int count = std::min(plyBatchSize, numPts - first);
+        if (!vtkPLY::ply_get_elements(ply, vertices.data(), sizeof(plyVertex), count))
         {
-          normals->SetTuple3(j, vertex.normal[0], vertex.normal[1], vertex.normal[2]);
+          vtkWarningMacro(<< "Premature end of vertex data");
         }
-        if (rgbPointsAvailable)
-        {
-          if (rgbPointsHaveAlpha)
-          {
-            rgbPoints->SetTuple4(j, vertex.red, vertex.green, vertex.blue, vertex.alpha);
-          }
-          else
+        vtkSMPTools::For(0, count, [&](vtkIdType begin, vtkIdType end) {
+          for (vtkIdType k = begin; k < end; k++)
           {
-            rgbPoints->SetTuple3(j, vertex.red, vertex.green, vertex.blue);
+            const plyVertex& vertex = vertices[k];
+            const vtkIdType j = first + k;
+            std::copy(vertex.x, vertex.x + 3, x + 3 * j);
+            if (tc)
+            {
+              std::copy(vertex.tex, vertex.tex + 2, tc + 2 * j);
+            }
+            if (n)
+            {
+              std::copy(vertex.normal, vertex.normal + 3, n + 3 * j);
+            }
+            if (rgb)
+            {
+              unsigned char* c = rgb + rgbComps * j;
+              c[0] = vertex.red;
+              c[1] = vertex.green;
+              c[2] = vertex.blue;
+              if (rgbPointsHaveAlpha)
+              {
+                c[3] = vertex.alpha;
+              }
+            }
           }
-        }
+        });
       }
       output->SetPoints(pts);
       pts->Delete();
@@ -442,7 +464,6 @@ int vtkPLYReader::RequestData(vtkInformation* vtkNotUsed(request),
       numPolys = numElems;
       vtkSmartPointer<vtkCellArray> polys = vtkSmartPointer<vtkCellArray>::New();
       polys->AllocateEstimate(numPolys, 3);
-      plyFace face;
       vtkIdType vtkVerts[256];
 
       // Get the face properties
@@ -479,12 +500,22 @@ int vtkPLYReader::RequestData(vtkInformation* vtkNotUsed(request),
         }
       }
 
-      // grab all the face elements
+      // grab all the face elements, decoding them in batches
       vtkNew<vtkPolygon> cell;
+      std::vector<plyFace> faces(std::min(numPolys, plyBatchSize));
       for (int j = 0; j < numPolys; j++)
       {
-        // grab and element from the file
-        vtkPLY::ply_get_element(ply, (void*)&face);
+        // grab a batch of elements from the file
+        if (j % plyBatchSize == 0)
+        {
+          const int count = std::min(plyBatchSize, numPolys - j);
+          std::fill(faces.begin(), faces.begin() + count, plyFace());
+          if (!vtkPLY::ply_get_elements(ply, faces.data(), sizeof(plyFace), count))
+          {
+            vtkWarningMacro(<< "Premature end of face data");
+          }
+        }
+        plyFace& face = faces[j % plyBatchSize];
         for (int k = 0; k < face.nverts; k++)
         {
           vtkVerts[k] = face.verts[k];
@@ -0,0 +1,490 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestPOpenFOAMReaderThreads
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Writes a decomposed ASCII case and reads it with several threads and with
+// a single one: the processor directories and the field files are then read
+// concurrently or one after the other, and the outputs and array selections
+// must be identical. The case holds copies of a scalar field whose values are
+// shifted by one more character in every copy, so that the read buffer ends
+// at each position of a number in one copy or another. Numbers lying entirely
+// in the buffer are parsed by a fast path and those crossing its end by the
+// regular one, and all copies must hold bit-identical values once stored in
+// the float arrays of the output.
+
+#include "vtkCellData.h"
+#include "vtkCompositeDataSet.h"
+#include "vtkDataArray.h"
+#include "vtkDataSet.h"
+#include "vtkDummyController.h"
+#include "vtkIdList.h"
+#include "vtkInformation.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPOpenFOAMReader.h"
+#include "vtkPointData.h"
+#include "vtkSMPTools.h"
+#include "vtkTestUtilities.h"
+
+#include <vtksys/SystemTools.hxx>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+
+namespace
+{
+// Enough cells for a field file to be larger than the read buffer
+const int NumberOfCells = 10000;
+const int NumberOfProcessors = 2;
+// Longer than any number written, so that the buffer ends at every position
+const int NumberOfShifts = 24;
+
+void WriteHeader(std::ofstream& os, const char* className, const char* object)
+{
+  os << "FoamFile\n"
+        "{\n"
+        "    version     2.0;\n"
+        "    format      ascii;\n"
+        "    class       "
+     << className
+     << ";\n"
+        "    object      "
+     << object
+     << ";\n"
+        "}\n\n";
+}
+
+// Point (i, j, k) of a row of hexahedra along x
+int PointId(int i, int j, int k)
+{
+  return 4 * i + 2 * k + j;
+}
+
+void WriteFace(std::ofstream& os, int a, int b, int c, int d)
+{
+  os << "4(" << a << ' ' << b << ' ' << c << ' ' << d << ")\n";
+}
+
+bool WriteMesh(const std::string& dir, int processor)
+{
+  const int n = NumberOfCells;
+  {
+    std::ofstream os((dir + "/points").c_str());
+    WriteHeader(os, "vectorField", "points");
+    os << 4 * (n + 1) << "\n(\n";
+    for (int i = 0; i <= n; ++i)
+    {
+      for (int k = 0; k < 2; ++k)
+      {
+        for (int j = 0; j < 2; ++j)
+        {
+          os << '(' << 0.5 * i << ' ' << j + 2 * processor << ' ' << k << ")\n";
+        }
+      }
+    }
+    os << ")\n";
+    if (!os.good())
+    {
+      return false;
+    }
+  }
+
+  // internal faces, then the inlet, outlet and walls patches
+  std::ofstream faces((dir + "/faces").c_str());
+  std::ofstream owner((dir + "/owner").c_str());
+  std::ofstream neighbour((dir + "/neighbour").c_str());
+  WriteHeader(faces, "faceList", "faces");
+  WriteHeader(owner, "labelList", "owner");
+  WriteHeader(neighbour, "labelList", "neighbour");
+  const int numberOfFaces = (n - 1) + 2 + 4 * n;
+  faces << numberOfFaces << "\n(\n";
+  owner << numberOfFaces << "\n(\n";
+  neighbour << n - 1 << "\n(\n";
+  for (int i = 1; i < n; ++i)
+  {
+    WriteFace(faces, PointId(i, 0, 0), PointId(i, 1, 0), PointId(i, 1, 1), PointId(i, 0, 1));
+    owner << i - 1 << "\n";
+    neighbour << i << "\n";
+  }
+  WriteFace(faces, PointId(0, 0, 0), PointId(0, 0, 1), PointId(0, 1, 1), PointId(0, 1, 0));
+  owner << 0 << "\n";
+  WriteFace(faces, PointId(n, 0, 0), PointId(n, 1, 0), PointId(n, 1, 1), PointId(n, 0, 1));
+  owner << n - 1 << "\n";
+  for (int i = 0; i < n; ++i)
+  {
+    WriteFace(
+      faces, PointId(i, 0, 0), PointId(i + 1, 0, 0), PointId(i + 1, 0, 1), PointId(i, 0, 1));
+    WriteFace(
+      faces, PointId(i, 1, 0), PointId(i, 1, 1), PointId(i + 1, 1, 1), PointId(i + 1, 1, 0));
+    WriteFace(
+      faces, PointId(i, 0, 0), PointId(i, 1, 0), PointId(i + 1, 1, 0), PointId(i + 1, 0, 0));
+    WriteFace(
+      faces, PointId(i, 0, 1), PointId(i + 1, 0, 1), PointId(i + 1, 1, 1), PointId(i, 1, 1));
+    owner << i << "\n" << i << "\n" << i << "\n" << i << "\n";
+  }
+  faces << ")\n";
+  owner << ")\n";
+  neighbour << ")\n";
+
+  std::ofstream boundary((dir + "/boundary").c_str());
+  WriteHeader(boundary, "polyBoundaryMesh", "boundary");
+  boundary << "3\n(\n"
+           << "inlet\n{\n    type patch;\n    nFaces 1;\n    startFace " << n - 1 << ";\n}\n"
+           << "outlet\n{\n    type patch;\n    nFaces 1;\n    startFace " << n << ";\n}\n"
+           << "walls\n{\n    type wall;\n    nFaces " << 4 * n << ";\n    startFace " << n + 1
+           << ";\n}\n"
+           << ")\n";
+  return faces.good() && owner.good() && neighbour.good() && boundary.good();
+}
+
+double FieldValue(int processor, int i)
+{
+  const double value = (1. + std::sin(i + 0.25 * processor)) * std::pow(10., i % 13 - 6);
+  return i % 7 == 0 ? -value : value;
+}
+
+void WriteBoundaryField(std::ofstream& os, const char* value)
+{
+  os << "boundaryField\n{\n";
+  for (const char* patch : { "inlet", "outlet", "walls" })
+  {
+    os << "    " << patch << "\n    {\n        type calculated;\n        value uniform " << value
+       << ";\n    }\n";
+  }
+  os << "}\n";
+}
+
+bool WriteFields(const std::string& dir, int processor)
+{
+  for (int shift = 0; shift < NumberOfShifts; ++shift)
+  {
+    const std::string name = "T" + std::to_string(shift);
+    std::ofstream os((dir + "/" + name).c_str());
+    WriteHeader(os, "volScalarField", name.c_str());
+    os << "dimensions [0 0 0 1 0 0 0];\n\n"
+       << "internalField nonuniform List<scalar>" << std::string(shift + 1, ' ') << NumberOfCells
+       << "\n(\n";
+    char text[32];
+    for (int i = 0; i < NumberOfCells; ++i)
+    {
+      if (i % 11 == 0)
+      {
+        os << i << "\n";
+        continue;
+      }
+      snprintf(text, sizeof(text), "%.17g", FieldValue(processor, i));
+      os << text << "\n";
+    }
+    os << ");\n\n";
+    WriteBoundaryField(os, "0");
+    if (!os.good())
+    {
+      return false;
+    }
+  }
+
+  std::ofstream os((dir + "/U").c_str());
+  WriteHeader(os, "volVectorField", "U");
+  os << "dimensions [0 1 -1 0 0 0 0];\n\n"
+     << "internalField nonuniform List<vector> " << NumberOfCells << "\n(\n";
+  for (int i = 0; i < NumberOfCells; ++i)
+  {
+    os << '(' << i << ' ' << -0.5 * i << ' ' << processor << ")\n";
+  }
+  os << ");\n\n";
+  WriteBoundaryField(os, "(0 0 0)");
+  return os.good();
+}
+
+bool WriteCase(const std::string& caseDir)
+{
+  if (!vtksys::SystemTools::MakeDirectory(caseDir + "/system"))
+  {
+    return false;
+  }
+  {
+    std::ofstream os((caseDir + "/system/controlDict").c_str());
+    WriteHeader(os, "dictionary", "controlDict");
+    os << "startTime 0;\nendTime 1;\ndeltaT 1;\nwriteControl timeStep;\nwriteInterval 1;\n";
+  }
+  std::ofstream((caseDir + "/threads.foam").c_str());
+  for (int processor = 0; processor < NumberOfProcessors; ++processor)
+  {
+    const std::string processorDir = caseDir + "/processor" + std::to_string(processor);
+    if (!vtksys::SystemTools::MakeDirectory(processorDir + "/constant/polyMesh") ||
+      !vtksys::SystemTools::MakeDirectory(processorDir + "/0") ||
+      !WriteMesh(processorDir + "/constant/polyMesh", processor) ||
+      !WriteFields(processorDir + "/0", processor))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool SameArrays(vtkFieldData* a, vtkFieldData* b)
+{
+  if (a->GetNumberOfArrays() != b->GetNumberOfArrays())
+  {
+    return false;
+  }
+  for (int i = 0; i < a->GetNumberOfArrays(); ++i)
+  {
+    vtkDataArray* arrayA = a->GetArray(i);
+    vtkDataArray* arrayB = b->GetArray(i);
+    if (!arrayA || !arrayB || strcmp(arrayA->GetName(), arrayB->GetName()) != 0 ||
+      arrayA->GetDataType() != arrayB->GetDataType() ||
+      arrayA->GetNumberOfComponents() != arrayB->GetNumberOfComponents() ||
+      arrayA->GetNumberOfTuples() != arrayB->GetNumberOfTuples())
+    {
+      return false;
+    }
+    for (vtkIdType t = 0; t < arrayA->GetNumberOfTuples(); ++t)
+    {
+      for (int c = 0; c < arrayA->GetNumberOfComponents(); ++c)
+      {
+        if (arrayA->GetComponent(t, c) != arrayB->GetComponent(t, c))
+        {
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+bool SameDataSet(vtkDataSet* a, vtkDataSet* b)
+{
+  if (strcmp(a->GetClassName(), b->GetClassName()) != 0 ||
+    a->GetNumberOfPoints() != b->GetNumberOfPoints() ||
+    a->GetNumberOfCells() != b->GetNumberOfCells())
+  {
+    return false;
+  }
+  double pA[3], pB[3];
+  for (vtkIdType i = 0; i < a->GetNumberOfPoints(); ++i)
+  {
+    a->GetPoint(i, pA);
+    b->GetPoint(i, pB);
+    if (pA[0] != pB[0] || pA[1] != pB[1] || pA[2] != pB[2])
+    {
+      return false;
+    }
+  }
+  vtkNew<vtkIdList> idsA;
+  vtkNew<vtkIdList> idsB;
+  for (vtkIdType i = 0; i < a->GetNumberOfCells(); ++i)
+  {
+    a->GetCellPoints(i, idsA);
+    b->GetCellPoints(i, idsB);
+    if (a->GetCellType(i) != b->GetCellType(i) ||
+      idsA->GetNumberOfIds() != idsB->GetNumberOfIds() ||
+      !std::equal(idsA->begin(), idsA->end(), idsB->begin()))
+    {
+      return false;
+    }
+  }
+  return SameArrays(a->GetPointData(), b->GetPointData()) &&
+    SameArrays(a->GetCellData(), b->GetCellData());
+}
+
+bool SameOutput(vtkMultiBlockDataSet* a, vtkMultiBlockDataSet* b)
+{
+  if (a->GetNumberOfBlocks() != b->GetNumberOfBlocks())
+  {
+    return false;
+  }
+  for (unsigned int i = 0; i < a->GetNumberOfBlocks(); ++i)
+  {
+    const char* nameA =
+      a->HasMetaData(i) ? a->GetMetaData(i)->Get(vtkCompositeDataSet::NAME()) : nullptr;
+    const char* nameB =
+      b->HasMetaData(i) ? b->GetMetaData(i)->Get(vtkCompositeDataSet::NAME()) : nullptr;
+    if ((nameA || nameB) && (!nameA || !nameB || strcmp(nameA, nameB) != 0))
+    {
+      return false;
+    }
+    vtkDataObject* blockA = a->GetBlock(i);
+    vtkDataObject* blockB = b->GetBlock(i);
+    if (!blockA || !blockB)
+    {
+      if (blockA != blockB)
+      {
+        return false;
+      }
+      continue;
+    }
+    vtkMultiBlockDataSet* mbA = vtkMultiBlockDataSet::SafeDownCast(blockA);
+    vtkMultiBlockDataSet* mbB = vtkMultiBlockDataSet::SafeDownCast(blockB);
+    vtkDataSet* dsA = vtkDataSet::SafeDownCast(blockA);
+    vtkDataSet* dsB = vtkDataSet::SafeDownCast(blockB);
+    if (mbA && mbB ? !SameOutput(mbA, mbB) : !dsA || !dsB || !SameDataSet(dsA, dsB))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool SameSelections(vtkPOpenFOAMReader* a, vtkPOpenFOAMReader* b)
+{
+  if (a->GetNumberOfCellArrays() != b->GetNumberOfCellArrays() ||
+    a->GetNumberOfPatchArrays() != b->GetNumberOfPatchArrays())
+  {
+    return false;
+  }
+  for (int i = 0; i < a->GetNumberOfCellArrays(); ++i)
+  {
+    if (strcmp(a->GetCellArrayName(i), b->GetCellArrayName(i)) != 0 ||
+      a->GetCellArrayStatus(a->GetCellArrayName(i)) !=
+        b->GetCellArrayStatus(b->GetCellArrayName(i)))
+    {
+      return false;
+    }
+  }
+  for (int i = 0; i < a->GetNumberOfPatchArrays(); ++i)
+  {
+    if (strcmp(a->GetPatchArrayName(i), b->GetPatchArrayName(i)) != 0 ||
+      a->GetPatchArrayStatus(a->GetPatchArrayName(i)) !=
+        b->GetPatchArrayStatus(b->GetPatchArrayName(i)))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+// The processors are appended, in processor order
+vtkDataSet* InternalMesh(vtkMultiBlockDataSet* output)
+{
+  for (unsigned int i = 0; i < output->GetNumberOfBlocks(); ++i)
+  {
+    const char* name =
+      output->HasMetaData(i) ? output->GetMetaData(i)->Get(vtkCompositeDataSet::NAME()) : nullptr;
+    if (name && strcmp(name, "internalMesh") == 0)
+    {
+      return vtkDataSet::SafeDownCast(output->GetBlock(i));
+    }
+  }
+  return nullptr;
+}
+}
+
+int TestPOpenFOAMReaderThreads(int argc, char* argv[])
+{
+  vtkNew<vtkDummyController> controller;
+  controller->Initialize(&argc, &argv);
+  vtkMultiProcessController::SetGlobalController(controller);
+
+  char* tempDir =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  if (!tempDir)
+  {
+    std::cerr << "Could not determine temporary directory.\n";
+    return EXIT_FAILURE;
+  }
+  const std::string caseDir = std::string(tempDir) + "/TestPOpenFOAMReaderThreads";
+  delete[] tempDir;
+  vtksys::SystemTools::RemoveADirectory(caseDir);
+  if (!WriteCase(caseDir))
+  {
+    std::cerr << "Could not write the case to " << caseDir << "\n";
+    return EXIT_FAILURE;
+  }
+
+  vtkNew<vtkPOpenFOAMReader> serial;
+  vtkNew<vtkPOpenFOAMReader> threaded;
+  for (vtkPOpenFOAMReader* reader : { serial.Get(), threaded.Get() })
+  {
+    reader->SetFileName((caseDir + "/threads.foam").c_str());
+    reader->SetCaseType(vtkPOpenFOAMReader::DECOMPOSED_CASE);
+  }
+  vtkSMPTools::LocalScope(vtkSMPTools::Config{ 1 }, [&]() { serial->UpdateInformation(); });
+  vtkSMPTools::LocalScope(vtkSMPTools::Config{ 4 }, [&]() { threaded->UpdateInformation(); });
+  if (serial->GetNumberOfCellArrays() != NumberOfShifts + 1 ||
+    !SameSelections(serial, threaded))
+  {
+    std::cerr << "The array selections of the threaded reader differ from the serial one\n";
+    return EXIT_FAILURE;
+  }
+
+  // all patches, and one field left out
+  for (vtkPOpenFOAMReader* reader : { serial.Get(), threaded.Get() })
+  {
+    reader->EnableAllPatchArrays();
+    reader->SetCellArrayStatus("T1", 0);
+  }
+  vtkSMPTools::LocalScope(vtkSMPTools::Config{ 1 }, [&]() { serial->Update(); });
+  vtkSMPTools::LocalScope(vtkSMPTools::Config{ 4 }, [&]() { threaded->Update(); });
+  if (!SameSelections(serial, threaded))
+  {
+    std::cerr << "The array selections of the threaded reader differ from the serial one\n";
+    return EXIT_FAILURE;
+  }
+  if (!SameOutput(serial->GetOutput(), threaded->GetOutput()))
+  {
+    std::cerr << "The threaded read of the decomposed case differs from the serial one\n";
+    return EXIT_FAILURE;
+  }
+
+  vtkDataSet* mesh = InternalMesh(threaded->GetOutput());
+  vtkCellData* cd = mesh ? mesh->GetCellData() : nullptr;
+  vtkDataArray* t0 = cd ? cd->GetArray("T0") : nullptr;
+  if (!t0 || t0->GetNumberOfTuples() != NumberOfProcessors * NumberOfCells || cd->GetArray("T1") ||
+    !cd->GetArray("U"))
+  {
+    std::cerr << "Unexpected cell arrays in the internal mesh\n";
+    return EXIT_FAILURE;
+  }
+  for (int processor = 0; processor < NumberOfProcessors; ++processor)
+  {
+    for (int i = 0; i < NumberOfCells; ++i)
+    {
+      const double expected = i % 11 == 0 ? i : FieldValue(processor, i);
+      const double value = t0->GetComponent(processor * NumberOfCells + i, 0);
+      if (std::abs(value - expected) > 1e-6 * std::abs(expected))
+      {
+        std::cerr << "Processor " << processor << ": T0[" << i << "] = " << value << ", expected "
+                  << expected << "\n";
+        return EXIT_FAILURE;
+      }
+    }
+  }
+  for (int shift = 2; shift < NumberOfShifts; ++shift)
+  {
+    const std::string name = "T" + std::to_string(shift);
+    vtkDataArray* copy = cd->GetArray(name.c_str());
+    if (!copy || copy->GetNumberOfTuples() != t0->GetNumberOfTuples())
+    {
+      std::cerr << "Missing " << name << "\n";
+      return EXIT_FAILURE;
+    }
+    for (vtkIdType i = 0; i < t0->GetNumberOfTuples(); ++i)
+    {
+      if (copy->GetComponent(i, 0) != t0->GetComponent(i, 0))
+      {
+        std::cerr << name << "[" << i << "] differs from T0[" << i << "]\n";
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  vtkMultiProcessController::SetGlobalController(nullptr);
+  controller->Finalize();
+  return EXIT_SUCCESS;
+}
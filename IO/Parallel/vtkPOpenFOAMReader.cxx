@@ -73,6 +73,7 @@
 #include "vtkMultiBlockDataSet.h"
 #include "vtkMultiProcessController.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
 #include "vtkSortDataArray.h"
 #include "vtkStdString.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
@@ -80,6 +81,7 @@
 
 #include <cctype>
 #include <cstring>
+#include <vector>
 
 //------------------------------------------------------------------------------
 
@@ -542,25 +544,46 @@ int vtkPOpenFOAMReader::RequestInformation(
     }
 
     // Create reader instances for processor subdirectories,
-    // skip first one since it has already been created above
+    // skip first one since it has already been created above.
+    // The subdirectories are scanned concurrently, the readers are
+    // kept in processor order.
 
+    std::vector<int> dirIndices;
     for (int dirIndex = (this->ProcessId ? this->ProcessId : this->NumProcesses);
          dirIndex < nProcessorDirs; dirIndex += this->NumProcesses)
     {
-      const std::string procDirName = ::ProcessorDirName(processorDirs, dirIndex);
-      vtkFoamDebug(<< "Additional processor dir: " << procDirName << "\n");
+      dirIndices.push_back(dirIndex);
+    }
+
+    const vtkIdType nSubReaders = static_cast<vtkIdType>(dirIndices.size());
+    std::vector<vtkSmartPointer<vtkOpenFOAMReader>> subReaders(nSubReaders);
+    vtkSMPTools::For(0, nSubReaders, 1, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        const std::string procDirName = ::ProcessorDirName(processorDirs, dirIndices[i]);
+        vtkFoamDebug(<< "Additional processor dir: " << procDirName << "\n");
 
-      auto subReader = ::NewFoamReader(this);
+        auto subReader = ::NewFoamReader(this);
 
-      // If getting metadata failed, simply skip the reader instance
-      if (subReader->MakeInformationVector(nullptr, procDirName, timeNames, timeValues) &&
-        subReader->MakeMetaDataAtTimeStep(true))
+        // If getting metadata failed, simply skip the reader instance
+        if (subReader->MakeInformationVector(nullptr, procDirName, timeNames, timeValues) &&
+          subReader->MakeMetaDataAtTimeStep(true))
+        {
+          subReaders[i] = subReader;
+        }
+      }
+    });
+
+    for (vtkIdType i = 0; i < nSubReaders; ++i)
+    {
+      if (subReaders[i])
       {
-        this->Superclass::Readers->AddItem(subReader);
+        this->Superclass::Readers->AddItem(subReaders[i]);
       }
       else
       {
-        vtkWarningMacro(<< "Removing reader for processor subdirectory " << procDirName);
+        vtkWarningMacro(<< "Removing reader for processor subdirectory "
+                        << ::ProcessorDirName(processorDirs, dirIndices[i]));
       }
     }
 
@@ -641,23 +664,40 @@ int vtkPOpenFOAMReader::RequestData(
     vtkAppendCompositeDataLeaves* append = vtkAppendCompositeDataLeaves::New();
     // append->AppendFieldDataOn();
 
-    vtkOpenFOAMReader* reader;
-    this->Superclass::CurrentReaderIndex = 0;
-    this->Superclass::Readers->InitTraversal();
-    while ((reader = vtkOpenFOAMReader::SafeDownCast(
-              this->Superclass::Readers->GetNextItemAsObject())) != nullptr)
+    // The sub-readers are independent of each other (apart from the
+    // selections of "this", which they guard), so update them concurrently
+    // and append their outputs afterwards in processor order.
+    const int nReaders = this->Superclass::Readers->GetNumberOfItems();
+    std::vector<vtkOpenFOAMReader*> readers(nReaders);
+    std::vector<char> hasMetaData(nReaders, 0);
+    for (int readerI = 0; readerI < nReaders; ++readerI)
     {
-      // even if the child readers themselves are not modified, mark
-      // them as modified if "this" has been modified, since they
-      // refer to the property of "this"
-      if ((nTimes && reader->SetTimeValue(requestedTimeValue)) ||
-        (this->MTimeOld != this->GetMTime()))
+      readers[readerI] =
+        vtkOpenFOAMReader::SafeDownCast(this->Superclass::Readers->GetItemAsObject(readerI));
+    }
+
+    const bool modified = (this->MTimeOld != this->GetMTime());
+    this->Superclass::CurrentReaderIndex = 0;
+    vtkSMPTools::For(0, nReaders, 1, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType readerI = begin; readerI < end; ++readerI)
       {
-        reader->Modified();
+        vtkOpenFOAMReader* reader = readers[readerI];
+        // even if the child readers themselves are not modified, mark
+        // them as modified if "this" has been modified, since they
+        // refer to the property of "this"
+        if ((nTimes && reader->SetTimeValue(requestedTimeValue)) || modified)
+        {
+          reader->Modified();
+        }
+        hasMetaData[readerI] = reader->MakeMetaDataAtTimeStep(false) ? 1 : 0;
       }
-      if (reader->MakeMetaDataAtTimeStep(false))
+    });
+
+    for (int readerI = 0; readerI < nReaders; ++readerI)
+    {
+      if (hasMetaData[readerI])
       {
-        append->AddInputConnection(reader->GetOutputPort());
+        append->AddInputConnection(readers[readerI]->GetOutputPort());
       }
     }
 
@@ -672,6 +712,15 @@ int vtkPOpenFOAMReader::RequestData(
     {
       // reader->RequestInformation() and RequestData() are called
       // for all reader instances without setting UPDATE_TIME_STEPS
+      vtkSMPTools::For(0, nReaders, 1, [&](vtkIdType begin, vtkIdType end) {
+        for (vtkIdType readerI = begin; readerI < end; ++readerI)
+        {
+          if (hasMetaData[readerI])
+          {
+            readers[readerI]->Update();
+          }
+        }
+      });
       append->Update();
       output->ShallowCopy(append->GetOutput());
     }
@@ -22,6 +22,10 @@
  * transient data for the cells. Each folder can contain any number of
  * data files.
  *
+ * The processor directories assigned to a process are read concurrently
+ * with vtkSMPTools, one sub-reader per directory. The output blocks are
+ * appended in processor order regardless of the SMP backend.
+ *
  * @par Thanks:
  * This class was developed by Takuya Oshima at Niigata University,
  * Japan (oshima@eng.niigata-u.ac.jp).
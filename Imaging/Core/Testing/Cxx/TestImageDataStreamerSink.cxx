@@ -0,0 +1,229 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestImageDataStreamerSink.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Streams a smoothed image through vtkImageDataStreamer into a
+// vtkImageHistogramSink, with the number of pieces chosen from a memory
+// limit, and checks that the histogram matches that of the whole image
+// while the pipeline never produces more than a piece. Also checks that the
+// pieces of an input larger than requested, without active scalars, are
+// cropped to their extent.
+
+#include "vtkCallbackCommand.h"
+#include "vtkCommand.h"
+#include "vtkDataArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkImageCast.h"
+#include "vtkImageData.h"
+#include "vtkImageDataStreamer.h"
+#include "vtkImageGaussianSmooth.h"
+#include "vtkImageHistogramSink.h"
+#include "vtkImageHistogramStatistics.h"
+#include "vtkImageStreamingSink.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkRTAnalyticSource.h"
+#include "vtkSmartPointer.h"
+#include "vtkUnsignedCharArray.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+// Record the largest number of voxels that the smoothing filter produced.
+void RecordSize(vtkObject* caller, unsigned long, void* clientData, void*)
+{
+  vtkIdType* maxPoints = static_cast<vtkIdType*>(clientData);
+  vtkImageGaussianSmooth* smooth = static_cast<vtkImageGaussianSmooth*>(caller);
+  *maxPoints = std::max(*maxPoints, smooth->GetOutput()->GetNumberOfPoints());
+}
+
+
+// Count the voxels and the values of the "Values" array of the pieces.
+class CountingSink : public vtkImageStreamingSink
+{
+public:
+  static CountingSink* New();
+  vtkTypeMacro(CountingSink, vtkImageStreamingSink);
+
+  vtkIdType Points = 0;
+  vtkIdType Values = 0;
+
+  int ConsumePiece(vtkImageData* piece) override
+  {
+    this->Points += piece->GetNumberOfPoints();
+    this->Values += piece->GetPointData()->GetArray("Values")->GetNumberOfTuples();
+    return 1;
+  }
+};
+vtkStandardNewMacro(CountingSink);
+
+// A pipeline with a kernel filter, which needs a halo around each piece.
+vtkSmartPointer<vtkImageCast> MakePipeline(vtkImageGaussianSmooth* smooth)
+{
+  vtkNew<vtkRTAnalyticSource> source;
+  source->SetWholeExtent(-40, 40, -40, 40, -20, 20);
+  smooth->SetInputConnection(source->GetOutputPort());
+  smooth->SetStandardDeviations(2.0, 2.0, 2.0);
+  smooth->SetRadiusFactors(2.0, 2.0, 2.0);
+  auto cast = vtkSmartPointer<vtkImageCast>::New();
+  cast->SetInputConnection(smooth->GetOutputPort());
+  cast->SetOutputScalarTypeToShort();
+  return cast;
+}
+}
+
+int TestImageDataStreamerSink(int, char*[])
+{
+  // the statistics of the whole image
+  vtkNew<vtkImageGaussianSmooth> wholeSmooth;
+  vtkSmartPointer<vtkImageCast> wholeCast = MakePipeline(wholeSmooth);
+  vtkNew<vtkImageHistogramStatistics> statistics;
+  statistics->SetInputConnection(wholeCast->GetOutputPort());
+  statistics->AutomaticBinningOff();
+  statistics->SetNumberOfBins(300);
+  statistics->SetBinOrigin(0.0);
+  statistics->SetBinSpacing(1.0);
+  statistics->Update();
+  vtkIdType wholePoints = wholeCast->GetOutput()->GetNumberOfPoints();
+
+  // the same pipeline, streamed
+  vtkNew<vtkImageGaussianSmooth> smooth;
+  vtkSmartPointer<vtkImageCast> cast = MakePipeline(smooth);
+  vtkIdType maxPoints = 0;
+  vtkNew<vtkCallbackCommand> callback;
+  callback->SetCallback(RecordSize);
+  callback->SetClientData(&maxPoints);
+  smooth->AddObserver(vtkCommand::EndEvent, callback);
+
+  vtkNew<vtkImageHistogramSink> sink;
+  sink->SetNumberOfBins(300);
+  sink->SetBinOrigin(0.0);
+  sink->SetBinSpacing(1.0);
+
+  vtkNew<vtkImageDataStreamer> streamer;
+  streamer->SetInputConnection(cast->GetOutputPort());
+  streamer->SetSink(sink);
+  streamer->SetPieceMemoryLimit(256);
+
+  for (int prefetch = 1; prefetch >= 0; --prefetch)
+  {
+    maxPoints = 0;
+    streamer->SetPrefetch(prefetch);
+    streamer->Modified();
+    streamer->Update();
+
+    if (streamer->GetComputedNumberOfStreamDivisions() < 4 || maxPoints >= wholePoints / 2)
+    {
+      cerr << "Streamed " << streamer->GetComputedNumberOfStreamDivisions()
+           << " pieces of up to " << maxPoints << " voxels for an image of " << wholePoints
+           << " voxels\n";
+      return EXIT_FAILURE;
+    }
+    if (streamer->GetNumberOfStreamDivisions() != 10)
+    {
+      cerr << "The memory limit changed NumberOfStreamDivisions\n";
+      return EXIT_FAILURE;
+    }
+    if (streamer->GetOutput()->GetNumberOfPoints() != 0)
+    {
+      cerr << "The output of the streamer is not empty\n";
+      return EXIT_FAILURE;
+    }
+
+    vtkIdTypeArray* expected = statistics->GetHistogram();
+    vtkIdTypeArray* histogram = sink->GetHistogram();
+    if (sink->GetTotal() != statistics->GetTotal())
+    {
+      cerr << "The total is " << sink->GetTotal() << " instead of " << statistics->GetTotal()
+           << "\n";
+      return EXIT_FAILURE;
+    }
+    for (vtkIdType i = 0; i < expected->GetNumberOfTuples(); ++i)
+    {
+      if (histogram->GetValue(i) != expected->GetValue(i))
+      {
+        cerr << "Bin " << i << " is " << histogram->GetValue(i) << " instead of "
+             << expected->GetValue(i) << "\n";
+        return EXIT_FAILURE;
+      }
+    }
+    if (sink->GetMinimum() != statistics->GetMinimum() ||
+      sink->GetMaximum() != statistics->GetMaximum() ||
+      sink->GetMedian() != statistics->GetMedian() ||
+      std::fabs(sink->GetMean() - statistics->GetMean()) > 1e-6 ||
+      std::fabs(sink->GetStandardDeviation() - statistics->GetStandardDeviation()) > 1e-6)
+    {
+      cerr << "The statistics do not match those of vtkImageHistogramStatistics\n";
+      return EXIT_FAILURE;
+    }
+  }
+
+  // without a sink, the pieces are assembled into the whole image
+  streamer->SetSink(nullptr);
+  streamer->SetPieceMemoryLimit(0);
+  streamer->SetNumberOfStreamDivisions(5);
+  streamer->Update();
+  if (streamer->GetComputedNumberOfStreamDivisions() != 5)
+  {
+    cerr << "Streamed " << streamer->GetComputedNumberOfStreamDivisions()
+         << " pieces instead of 5\n";
+    return EXIT_FAILURE;
+  }
+  vtkDataArray* assembled = streamer->GetOutput()->GetPointData()->GetScalars();
+  vtkDataArray* whole = wholeCast->GetOutput()->GetPointData()->GetScalars();
+  for (vtkIdType i = 0; i < whole->GetNumberOfTuples(); ++i)
+  {
+    if (assembled->GetTuple1(i) != whole->GetTuple1(i))
+    {
+      cerr << "Voxel " << i << " of the assembled image is wrong\n";
+      return EXIT_FAILURE;
+    }
+  }
+
+  // an input that is produced whole, whatever the piece requested, and has
+  // an array that is not the active scalars
+  vtkNew<vtkImageData> image;
+  image->SetExtent(0, 19, 0, 19, 0, 9);
+  vtkNew<vtkUnsignedCharArray> values;
+  values->SetName("Values");
+  values->SetNumberOfValues(image->GetNumberOfPoints());
+  values->FillValue(1);
+  image->GetPointData()->AddArray(values);
+
+  vtkNew<CountingSink> counter;
+  vtkNew<vtkImageDataStreamer> wholeStreamer;
+  wholeStreamer->SetInputData(image);
+  wholeStreamer->SetSink(counter);
+  wholeStreamer->SetNumberOfStreamDivisions(4);
+  for (int prefetch = 1; prefetch >= 0; --prefetch)
+  {
+    counter->Points = 0;
+    counter->Values = 0;
+    wholeStreamer->SetPrefetch(prefetch);
+    wholeStreamer->Modified();
+    wholeStreamer->Update();
+    if (counter->Points != image->GetNumberOfPoints() ||
+      counter->Values != image->GetNumberOfPoints())
+    {
+      cerr << "The pieces have " << counter->Points << " voxels and " << counter->Values
+           << " values instead of " << image->GetNumberOfPoints() << ", prefetch " << prefetch
+           << "\n";
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
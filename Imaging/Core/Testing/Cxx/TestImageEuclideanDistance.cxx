@@ -0,0 +1,173 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestImageEuclideanDistance.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Computes the distance map of a sparse mask with each of the
+// vtkImageEuclideanDistance algorithms, and checks the distances, and the
+// anisotropic signed distances and closest feature ids of the Felzenszwalb
+// algorithm, against a brute force search.
+
+#include "vtkDataArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkImageData.h"
+#include "vtkImageEuclideanDistance.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+
+#include <cmath>
+#include <vector>
+
+namespace
+{
+const int Size[3] = { 23, 17, 11 };
+const double Spacing[3] = { 0.7, 1.3, 2.1 };
+const double UnitSpacing[3] = { 1.0, 1.0, 1.0 };
+
+double SquaredDistance(vtkIdType i, vtkIdType j, const double spacing[3])
+{
+  vtkIdType a[3] = { i % Size[0], (i / Size[0]) % Size[1], i / (Size[0] * Size[1]) };
+  vtkIdType b[3] = { j % Size[0], (j / Size[0]) % Size[1], j / (Size[0] * Size[1]) };
+  double d2 = 0.0;
+  for (int k = 0; k < 3; ++k)
+  {
+    double d = (a[k] - b[k]) * spacing[k];
+    d2 += d * d;
+  }
+  return d2;
+}
+
+// The squared distance of each voxel to the closest voxel with the value
+// "feature", capped by maxDist.
+std::vector<double> BruteForce(
+  vtkDataArray* mask, bool feature, const double spacing[3], double maxDist)
+{
+  vtkIdType n = mask->GetNumberOfTuples();
+  std::vector<vtkIdType> features;
+  for (vtkIdType i = 0; i < n; ++i)
+  {
+    if ((mask->GetTuple1(i) != 0) == feature)
+    {
+      features.push_back(i);
+    }
+  }
+  std::vector<double> result(n, maxDist);
+  for (vtkIdType i = 0; i < n; ++i)
+  {
+    for (vtkIdType j : features)
+    {
+      double d2 = SquaredDistance(i, j, spacing);
+      result[i] = (d2 < result[i] ? d2 : result[i]);
+    }
+  }
+  return result;
+}
+
+bool Close(double a, double b)
+{
+  return std::fabs(a - b) <= 1e-5 * (std::fabs(a) + 1.0);
+}
+}
+
+int TestImageEuclideanDistance(int, char*[])
+{
+  // a mask with a few zero voxels
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(Size[0], Size[1], Size[2]);
+  image->SetSpacing(Spacing[0], Spacing[1], Spacing[2]);
+  image->AllocateScalars(VTK_UNSIGNED_CHAR, 1);
+  vtkDataArray* mask = image->GetPointData()->GetScalars();
+  unsigned int state = 4321;
+  for (vtkIdType i = 0; i < mask->GetNumberOfTuples(); ++i)
+  {
+    state = state * 1103515245u + 12345u;
+    mask->SetTuple1(i, ((state >> 16) % 100) < 3 ? 0 : 1);
+  }
+
+  const double maxDist = 20.0;
+  std::vector<double> isotropic = BruteForce(mask, false, UnitSpacing, maxDist);
+  std::vector<double> outside = BruteForce(mask, false, Spacing, maxDist);
+  std::vector<double> inside = BruteForce(mask, true, Spacing, maxDist);
+
+  // the unsigned isotropic distance map, with every algorithm
+  for (int algorithm : { VTK_EDT_SAITO_CACHED, VTK_EDT_SAITO, VTK_EDT_FELZENSZWALB })
+  {
+    vtkNew<vtkImageEuclideanDistance> filter;
+    filter->SetInputData(image);
+    filter->SetAlgorithm(algorithm);
+    filter->SetMaximumDistance(maxDist);
+    filter->ConsiderAnisotropyOff();
+    filter->Update();
+    vtkDataArray* output = filter->GetOutput()->GetPointData()->GetScalars();
+    for (vtkIdType i = 0; i < output->GetNumberOfTuples(); ++i)
+    {
+      if (!Close(output->GetTuple1(i), isotropic[i]))
+      {
+        cerr << "Algorithm " << algorithm << ": voxel " << i << " has squared distance "
+             << output->GetTuple1(i) << " instead of " << isotropic[i] << "\n";
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  // the signed anisotropic distance map and the closest feature ids, as floats
+  vtkNew<vtkImageEuclideanDistance> filter;
+  filter->SetInputData(image);
+  filter->SetAlgorithmToFelzenszwalb();
+  filter->SetMaximumDistance(maxDist);
+  filter->SetOutputScalarTypeToFloat();
+  filter->SignedDistanceOn();
+  filter->GenerateClosestFeatureIdsOn();
+  filter->Update();
+  vtkImageData* output = filter->GetOutput();
+  if (output->GetScalarType() != VTK_FLOAT)
+  {
+    cerr << "The output is " << output->GetScalarTypeAsString() << " instead of float\n";
+    return EXIT_FAILURE;
+  }
+  vtkDataArray* distances = output->GetPointData()->GetScalars();
+  vtkIdTypeArray* ids =
+    vtkIdTypeArray::SafeDownCast(output->GetPointData()->GetArray("ClosestFeatureIds"));
+  if (!ids)
+  {
+    cerr << "No ClosestFeatureIds array\n";
+    return EXIT_FAILURE;
+  }
+  for (vtkIdType i = 0; i < distances->GetNumberOfTuples(); ++i)
+  {
+    bool isInside = (mask->GetTuple1(i) != 0);
+    double expected = (isInside ? outside[i] : -inside[i]);
+    if (!Close(distances->GetTuple1(i), expected))
+    {
+      cerr << "Voxel " << i << " has signed squared distance " << distances->GetTuple1(i)
+           << " instead of " << expected << "\n";
+      return EXIT_FAILURE;
+    }
+    vtkIdType id = ids->GetValue(i);
+    if (std::fabs(expected) >= maxDist)
+    {
+      if (id != -1)
+      {
+        cerr << "Voxel " << i << " has closest feature " << id << " instead of none\n";
+        return EXIT_FAILURE;
+      }
+    }
+    else if (id < 0 || (mask->GetTuple1(id) != 0) == isInside ||
+      !Close(SquaredDistance(i, id, Spacing), std::fabs(expected)))
+    {
+      cerr << "Voxel " << i << " has wrong closest feature " << id << "\n";
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,150 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestImageMedian3D.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Filters noisy images with vtkImageMedian3D, with kernels of odd and even
+// sizes and for several percentiles, and checks the output against the
+// sorted values of each neighborhood.  The small-range integer images use
+// the sliding histograms, and the others use the sorting method.
+
+#include "vtkDataArray.h"
+#include "vtkImageData.h"
+#include "vtkImageMedian3D.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace
+{
+const int Size[3] = { 19, 13, 8 };
+
+// The percentile of the clipped neighborhood of voxel (i, j, k), computed
+// as documented by vtkImageMedian3D.
+double BruteForce(vtkDataArray* scalars, int c, const int kernel[3], int i, int j, int k,
+  double percentile, bool isInteger)
+{
+  int ijk[3] = { i, j, k };
+  int hoodMin[3], hoodMax[3];
+  for (int a = 0; a < 3; ++a)
+  {
+    hoodMin[a] = std::max(ijk[a] - kernel[a] / 2, 0);
+    hoodMax[a] = std::min(ijk[a] - kernel[a] / 2 + kernel[a] - 1, Size[a] - 1);
+  }
+  std::vector<double> values;
+  for (int z = hoodMin[2]; z <= hoodMax[2]; ++z)
+  {
+    for (int y = hoodMin[1]; y <= hoodMax[1]; ++y)
+    {
+      for (int x = hoodMin[0]; x <= hoodMax[0]; ++x)
+      {
+        values.push_back(scalars->GetComponent(x + Size[0] * (y + Size[1] * z), c));
+      }
+    }
+  }
+  std::sort(values.begin(), values.end());
+  size_t n = values.size();
+  if (percentile == 50.0 && n % 2 == 0)
+  {
+    double a = values[n / 2 - 1];
+    double b = values[n / 2];
+    return a + (isInteger ? std::floor((b - a) / 2) : (b - a) / 2);
+  }
+  return values[static_cast<size_t>(percentile * 0.01 * (n - 1) + 0.5)];
+}
+
+bool CheckFilter(vtkImageData* image, const int kernel[3], double percentile, bool isInteger)
+{
+  vtkNew<vtkImageMedian3D> filter;
+  filter->SetInputData(image);
+  filter->SetKernelSize(kernel[0], kernel[1], kernel[2]);
+  filter->SetPercentile(percentile);
+  filter->Update();
+  vtkDataArray* input = image->GetPointData()->GetScalars();
+  vtkDataArray* output = filter->GetOutput()->GetPointData()->GetScalars();
+  for (int k = 0; k < Size[2]; ++k)
+  {
+    for (int j = 0; j < Size[1]; ++j)
+    {
+      for (int i = 0; i < Size[0]; ++i)
+      {
+        for (int c = 0; c < input->GetNumberOfComponents(); ++c)
+        {
+          double expected = BruteForce(input, c, kernel, i, j, k, percentile, isInteger);
+          double value = output->GetComponent(i + Size[0] * (j + Size[1] * k), c);
+          if (std::fabs(value - expected) > 1e-6 * (std::fabs(expected) + 1.0))
+          {
+            cerr << input->GetDataTypeAsString() << " kernel " << kernel[0] << "x" << kernel[1]
+                 << "x" << kernel[2] << " percentile " << percentile << ": voxel (" << i << ", "
+                 << j << ", " << k << ") component " << c << " is " << value << " instead of "
+                 << expected << "\n";
+            return false;
+          }
+        }
+      }
+    }
+  }
+  return true;
+}
+}
+
+int TestImageMedian3D(int, char*[])
+{
+  // value ranges that use the histograms (the first three) or sorting
+  struct ImageType
+  {
+    int ScalarType;
+    int NumberOfComponents;
+    double Minimum;
+    double Range;
+  };
+  const ImageType types[] = { { VTK_UNSIGNED_CHAR, 1, 0.0, 256.0 }, { VTK_SHORT, 2, -300.0, 700.0 },
+    { VTK_UNSIGNED_SHORT, 1, 1000.0, 4096.0 }, { VTK_INT, 1, -50000.0, 100000.0 },
+    { VTK_FLOAT, 1, -1.0, 2.0 } };
+  const int kernels[][3] = { { 3, 3, 3 }, { 5, 1, 3 }, { 4, 3, 2 }, { 25, 7, 1 }, { 1, 1, 1 } };
+  const double percentiles[] = { 50.0, 0.0, 100.0, 30.0 };
+
+  unsigned int state = 2468;
+  for (const ImageType& type : types)
+  {
+    vtkNew<vtkImageData> image;
+    image->SetDimensions(Size[0], Size[1], Size[2]);
+    image->AllocateScalars(type.ScalarType, type.NumberOfComponents);
+    vtkDataArray* scalars = image->GetPointData()->GetScalars();
+    bool isInteger = (type.ScalarType != VTK_FLOAT);
+    for (vtkIdType i = 0; i < scalars->GetNumberOfTuples(); ++i)
+    {
+      for (int c = 0; c < type.NumberOfComponents; ++c)
+      {
+        state = state * 1103515245u + 12345u;
+        double r = ((state >> 8) % 65536) / 65536.0 * type.Range;
+        scalars->SetComponent(i, c, type.Minimum + (isInteger ? std::floor(r) : r));
+      }
+    }
+
+    for (const int* kernel : kernels)
+    {
+      for (double percentile : percentiles)
+      {
+        if (!CheckFilter(image, kernel, percentile, isInteger))
+        {
+          return EXIT_FAILURE;
+        }
+      }
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
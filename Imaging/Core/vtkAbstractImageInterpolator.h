@@ -256,6 +256,13 @@ public:
   vtkGetVector6Macro(Extent, int);
   ///@}
 
+  /**
+   * Get the bounds, in structured coords, that CheckBoundsIJK() checks
+   * points against.  These are the Extent expanded by the Tolerance, and
+   * they are only valid after Update() has been called.
+   */
+  const double* GetStructuredBounds() { return this->StructuredBoundsDouble; }
+
 protected:
   vtkAbstractImageInterpolator();
   ~vtkAbstractImageInterpolator() override;
@@ -15,22 +15,73 @@
 #include "vtkImageDataStreamer.h"
 
 #include "vtkCommand.h"
+#include "vtkDataArray.h"
+#include "vtkExecutive.h"
 #include "vtkExtentTranslator.h"
 #include "vtkImageData.h"
+#include "vtkImageStreamingSink.h"
 #include "vtkInformation.h"
+#include "vtkInformationExecutivePortKey.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
+#include "vtkPointData.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
+#include <algorithm>
+#include <set>
+#include <thread>
+
+//------------------------------------------------------------------------------
+// The thread that consumes the previous piece while the next one is computed.
+class vtkImageDataStreamer::vtkInternals
+{
+public:
+  std::thread SinkThread;
+  int SinkResult = 1;
+
+  // Wait for the previous piece, and return the result of the sink.
+  int Wait()
+  {
+    if (this->SinkThread.joinable())
+    {
+      this->SinkThread.join();
+    }
+    return this->SinkResult;
+  }
+
+  // Consume the piece, in a thread if requested, and release it.
+  void Consume(vtkImageStreamingSink* sink, vtkImageData* piece, bool thread)
+  {
+    auto consume = [this, sink, piece]() {
+      this->SinkResult = sink->ConsumePiece(piece);
+      piece->Delete();
+    };
+    if (thread)
+    {
+      this->SinkThread = std::thread(consume);
+    }
+    else
+    {
+      consume();
+    }
+  }
+};
+
 vtkStandardNewMacro(vtkImageDataStreamer);
 vtkCxxSetObjectMacro(vtkImageDataStreamer, ExtentTranslator, vtkExtentTranslator);
+vtkCxxSetObjectMacro(vtkImageDataStreamer, Sink, vtkImageStreamingSink);
 
 //------------------------------------------------------------------------------
 vtkImageDataStreamer::vtkImageDataStreamer()
 {
   // default to 10 divisions
   this->NumberOfStreamDivisions = 10;
+  this->ComputedNumberOfStreamDivisions = 10;
   this->CurrentDivision = 0;
+  this->PieceMemoryLimit = 0;
+  this->Sink = nullptr;
+  this->Prefetch = 1;
+  this->Internals = new vtkInternals;
 
   // create default translator
   this->ExtentTranslator = vtkExtentTranslator::New();
@@ -41,10 +92,13 @@ vtkImageDataStreamer::vtkImageDataStreamer()
 
 vtkImageDataStreamer::~vtkImageDataStreamer()
 {
+  this->Internals->Wait();
+  delete this->Internals;
   if (this->ExtentTranslator)
   {
     this->ExtentTranslator->Delete();
   }
+  this->SetSink(nullptr);
 }
 
 //------------------------------------------------------------------------------
@@ -53,6 +107,11 @@ void vtkImageDataStreamer::PrintSelf(ostream& os, vtkIndent indent)
   this->Superclass::PrintSelf(os, indent);
 
   os << indent << "NumberOfStreamDivisions: " << this->NumberOfStreamDivisions << endl;
+  os << indent << "ComputedNumberOfStreamDivisions: " << this->ComputedNumberOfStreamDivisions
+     << endl;
+  os << indent << "PieceMemoryLimit (in kibibytes): " << this->PieceMemoryLimit << endl;
+  os << indent << "Prefetch: " << (this->Prefetch ? "On" : "Off") << endl;
+  os << indent << "Sink: " << this->Sink << endl;
   if (this->ExtentTranslator)
   {
     os << indent << "ExtentTranslator:\n";
@@ -64,6 +123,123 @@ void vtkImageDataStreamer::PrintSelf(ostream& os, vtkIndent indent)
   }
 }
 
+//------------------------------------------------------------------------------
+namespace
+{
+// The size in bytes of the image data for an extent.
+double vtkImageDataStreamerExtentSize(vtkInformation* info, const int ext[6])
+{
+  double n = 1.0;
+  for (int i = 0; i < 3; i++)
+  {
+    n *= (ext[2 * i + 1] >= ext[2 * i] ? ext[2 * i + 1] - ext[2 * i] + 1 : 0);
+  }
+  return n * vtkImageData::GetNumberOfScalarComponents(info) *
+    vtkDataArray::GetDataTypeSize(vtkImageData::GetScalarType(info));
+}
+
+// Add the size of the update extents of the images that the pipeline up
+// stream of the output "info" has been asked for.  Filters with kernels ask
+// for larger extents of their input, so the halos are counted.
+void vtkImageDataStreamerPipelineSize(
+  vtkInformation* info, std::set<vtkInformation*>& visited, double& size)
+{
+  if (!info || !visited.insert(info).second)
+  {
+    return;
+  }
+  if (info->Length(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT()) == 6)
+  {
+    size += vtkImageDataStreamerExtentSize(
+      info, info->Get(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT()));
+  }
+  vtkExecutive* executive = vtkExecutive::PRODUCER()->GetExecutive(info);
+  if (!executive)
+  {
+    return;
+  }
+  for (int i = 0; i < executive->GetNumberOfInputPorts(); i++)
+  {
+    for (int j = 0; j < executive->GetNumberOfInputConnections(i); j++)
+    {
+      vtkImageDataStreamerPipelineSize(executive->GetInputInformation(i, j), visited, size);
+    }
+  }
+}
+}
+
+//------------------------------------------------------------------------------
+int vtkImageDataStreamer::ComputeNumberOfStreamDivisions(
+  vtkInformation* inInfo, const int outExt[6])
+{
+  vtkExecutive* executive = vtkExecutive::PRODUCER()->GetExecutive(inInfo);
+  vtkStreamingDemandDrivenPipeline* sddp =
+    vtkStreamingDemandDrivenPipeline::SafeDownCast(executive);
+  if (!sddp)
+  {
+    return this->NumberOfStreamDivisions;
+  }
+  int port = vtkExecutive::PRODUCER()->GetPort(inInfo);
+
+  vtkExtentTranslator* translator = this->GetExtentTranslator();
+  translator->SetWholeExtent(const_cast<int*>(outExt));
+  double limit = 1024.0 * this->PieceMemoryLimit;
+  double oldSize = 0.0;
+  int divisions = 1;
+
+  // double the number of pieces until a piece fits in memory, or until the
+  // halos needed by the filters are so large that the size does not shrink
+  for (int count = 0; count < 30; count++)
+  {
+    // use a piece from the middle, since those have halos on all sides
+    int pieceExt[6];
+    translator->SetNumberOfPieces(divisions);
+    translator->SetPiece(divisions / 2);
+    if (!translator->PieceToExtentByPoints())
+    {
+      divisions = (divisions > 1 ? divisions / 2 : 1);
+      break;
+    }
+    translator->GetExtent(pieceExt);
+
+    // ask the pipeline for the extents that it needs for the piece
+    inInfo->Set(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(), pieceExt, 6);
+    inInfo->Set(
+      vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT_INITIALIZED(), VTK_UPDATE_EXTENT_REPLACE);
+    sddp->PropagateUpdateExtent(port);
+    inInfo->Set(
+      vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT_INITIALIZED(), VTK_UPDATE_EXTENT_COMBINE);
+
+    std::set<vtkInformation*> visited;
+    double size = 0.0;
+    vtkImageDataStreamerPipelineSize(inInfo, visited, size);
+
+    // do not combine the extents of the trial pieces with each other
+    for (vtkInformation* info : visited)
+    {
+      if (info->Has(vtkStreamingDemandDrivenPipeline::COMBINED_UPDATE_EXTENT()))
+      {
+        static int emptyExt[6] = { 0, -1, 0, -1, 0, -1 };
+        info->Set(vtkStreamingDemandDrivenPipeline::COMBINED_UPDATE_EXTENT(), emptyExt, 6);
+      }
+    }
+    if (this->Sink && this->Prefetch)
+    {
+      // the copy of the previous piece that is being consumed
+      size += vtkImageDataStreamerExtentSize(inInfo, pieceExt);
+    }
+
+    if (size <= limit || (oldSize > 0.0 && size > 0.8 * oldSize))
+    {
+      break;
+    }
+    oldSize = size;
+    divisions *= 2;
+  }
+
+  return divisions;
+}
+
 //------------------------------------------------------------------------------
 vtkTypeBool vtkImageDataStreamer::ProcessRequest(
   vtkInformation* request, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
@@ -77,20 +253,28 @@ vtkTypeBool vtkImageDataStreamer::ProcessRequest(
     int outExt[6];
     outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(), outExt);
 
+    // choose the number of pieces before the first one
+    vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
+    if (this->CurrentDivision == 0)
+    {
+      this->ComputedNumberOfStreamDivisions = (this->PieceMemoryLimit > 0
+          ? this->ComputeNumberOfStreamDivisions(inInfo, outExt)
+          : this->NumberOfStreamDivisions);
+    }
+
     // setup the inputs update extent
     int inExt[6] = { 0, -1, 0, -1, 0, -1 };
     vtkExtentTranslator* translator = this->GetExtentTranslator();
 
     translator->SetWholeExtent(outExt);
-    translator->SetNumberOfPieces(this->NumberOfStreamDivisions);
+    translator->SetNumberOfPieces(this->ComputedNumberOfStreamDivisions);
     translator->SetPiece(this->CurrentDivision);
     if (translator->PieceToExtentByPoints())
     {
       translator->GetExtent(inExt);
     }
 
-    inputVector[0]->GetInformationObject(0)->Set(
-      vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(), inExt, 6);
+    inInfo->Set(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(), inExt, 6);
 
     return 1;
   }
@@ -102,33 +286,79 @@ vtkTypeBool vtkImageDataStreamer::ProcessRequest(
     vtkInformation* outInfo = outputVector->GetInformationObject(0);
     vtkImageData* output = vtkImageData::SafeDownCast(outInfo->Get(vtkDataObject::DATA_OBJECT()));
 
+    vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
+    vtkImageData* input = vtkImageData::SafeDownCast(inInfo->Get(vtkDataObject::DATA_OBJECT()));
+
+    int inExt[6];
+    inInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(), inExt);
+
     // is this the first request
+    int success = 1;
     if (!this->CurrentDivision)
     {
       // Tell the pipeline to start looping.
       request->Set(vtkStreamingDemandDrivenPipeline::CONTINUE_EXECUTING(), 1);
-      this->AllocateOutputData(output, outInfo);
+      if (this->Sink)
+      {
+        this->Internals->Wait();
+        this->Internals->SinkResult = 1;
+        output->Initialize();
+        success = this->Sink->BeginStreaming(
+          inInfo, outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT()));
+      }
+      else
+      {
+        this->AllocateOutputData(output, outInfo);
+      }
     }
 
-    // actually copy the data
-    vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
-    vtkImageData* input = vtkImageData::SafeDownCast(inInfo->Get(vtkDataObject::DATA_OBJECT()));
-
-    int inExt[6];
-    inInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(), inExt);
-
-    output->CopyAndCastFrom(input, inExt);
+    if (this->Sink)
+    {
+      // the piece must have the exact extent, and must not share its
+      // arrays with the pipeline if it is consumed while the pipeline runs
+      success = (this->Internals->Wait() && success);
+      if (success)
+      {
+        vtkImageData* piece = vtkImageData::New();
+        piece->ShallowCopy(input);
+        piece->Crop(inExt);
+        // Crop() keeps the arrays of the input if it already has the extent
+        int inputExt[6];
+        input->GetExtent(inputExt);
+        if (this->Prefetch && std::equal(inExt, inExt + 6, inputExt))
+        {
+          piece->DeepCopy(input);
+        }
+        this->Internals->Consume(this->Sink, piece, this->Prefetch != 0);
+      }
+    }
+    else
+    {
+      // actually copy the data
+      output->CopyAndCastFrom(input, inExt);
+    }
 
     // update the progress
     this->UpdateProgress(static_cast<float>(this->CurrentDivision + 1.0) /
-      static_cast<float>(this->NumberOfStreamDivisions));
+      static_cast<float>(this->ComputedNumberOfStreamDivisions));
 
     this->CurrentDivision++;
-    if (this->CurrentDivision == this->NumberOfStreamDivisions)
+    if (this->CurrentDivision == this->ComputedNumberOfStreamDivisions || !success)
     {
       // Tell the pipeline to stop looping.
       request->Remove(vtkStreamingDemandDrivenPipeline::CONTINUE_EXECUTING());
       this->CurrentDivision = 0;
+      if (this->Sink)
+      {
+        success = (this->Internals->Wait() && success);
+        success = (this->Sink->EndStreaming() && success);
+        this->Internals->SinkResult = 1;
+      }
+      if (!success)
+      {
+        vtkErrorMacro("The sink failed to consume the pieces.");
+        return 0;
+      }
     }
 
     return 1;
@@ -19,6 +19,14 @@
  * To satisfy a request, this filter calls update on its input
  * many times with smaller update extents.  All processing up stream
  * streams smaller pieces.
+ *
+ * By default the pieces are copied into an output of the full size.  For
+ * images that do not fit in memory, a vtkImageStreamingSink can be set to
+ * consume the pieces instead, and the output is then left empty.  The
+ * number of pieces can also be chosen from a memory limit, which accounts
+ * for the larger extents that filters with kernels need from up stream.
+ * @sa
+ * vtkImageStreamingSink
  */
 
 #ifndef vtkImageDataStreamer_h
@@ -28,6 +36,7 @@
 #include "vtkImagingCoreModule.h" // For export macro
 
 class vtkExtentTranslator;
+class vtkImageStreamingSink;
 
 class VTKIMAGINGCORE_EXPORT vtkImageDataStreamer : public vtkImageAlgorithm
 {
@@ -46,6 +55,45 @@ public:
   vtkGetMacro(NumberOfStreamDivisions, int);
   ///@}
 
+  ///@{
+  /**
+   * Set the memory, in kibibytes (1024 bytes), that the pipeline up stream
+   * may use for one piece.  If set, the number of stream divisions is
+   * computed from it for each update, by asking the pipeline for the
+   * extents it needs for a piece, and NumberOfStreamDivisions is ignored.
+   * The default is 0, which means that NumberOfStreamDivisions is used as
+   * it is.
+   */
+  vtkSetMacro(PieceMemoryLimit, unsigned long);
+  vtkGetMacro(PieceMemoryLimit, unsigned long);
+  ///@}
+
+  /**
+   * Get the number of pieces that the last update was divided into, either
+   * NumberOfStreamDivisions or the number computed from PieceMemoryLimit.
+   */
+  vtkGetMacro(ComputedNumberOfStreamDivisions, int);
+
+  ///@{
+  /**
+   * Set a sink to consume the pieces, instead of copying them into the
+   * output.  The default is no sink.
+   */
+  virtual void SetSink(vtkImageStreamingSink*);
+  vtkGetObjectMacro(Sink, vtkImageStreamingSink);
+  ///@}
+
+  ///@{
+  /**
+   * When a sink is set, consume each piece in a separate thread while the
+   * pipeline computes the next piece.  This requires memory for a copy of
+   * one piece.  The default is on.
+   */
+  vtkSetMacro(Prefetch, vtkTypeBool);
+  vtkBooleanMacro(Prefetch, vtkTypeBool);
+  vtkGetMacro(Prefetch, vtkTypeBool);
+  ///@}
+
   ///@{
   /**
    * Get the extent translator that will be used to split the requests
@@ -62,11 +110,23 @@ protected:
   vtkImageDataStreamer();
   ~vtkImageDataStreamer() override;
 
+  /**
+   * Compute the number of stream divisions from the PieceMemoryLimit.
+   */
+  virtual int ComputeNumberOfStreamDivisions(vtkInformation* inInfo, const int outExt[6]);
+
   vtkExtentTranslator* ExtentTranslator;
   int NumberOfStreamDivisions;
+  int ComputedNumberOfStreamDivisions;
   int CurrentDivision;
+  unsigned long PieceMemoryLimit;
+  vtkImageStreamingSink* Sink;
+  vtkTypeBool Prefetch;
 
 private:
+  class vtkInternals;
+  vtkInternals* Internals;
+
   vtkImageDataStreamer(const vtkImageDataStreamer&) = delete;
   void operator=(const vtkImageDataStreamer&) = delete;
 };
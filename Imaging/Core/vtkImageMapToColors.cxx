@@ -23,6 +23,11 @@
 #include "vtkPointData.h"
 #include "vtkScalarsToColors.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkUnsignedCharArray.h"
+
+#include <cstring>
+#include <limits>
+#include <vector>
 
 vtkStandardNewMacro(vtkImageMapToColors);
 vtkCxxSetObjectMacro(vtkImageMapToColors, LookupTable, vtkScalarsToColors);
@@ -36,6 +41,7 @@ vtkImageMapToColors::vtkImageMapToColors()
   this->PassAlphaToOutput = 0;
   this->LookupTable = nullptr;
   this->DataWasPassed = 0;
+  this->Colors = vtkUnsignedCharArray::New();
 
   // Black color
   this->NaNColor[0] = this->NaNColor[1] = this->NaNColor[2] = this->NaNColor[3] = 0;
@@ -51,6 +57,7 @@ vtkImageMapToColors::~vtkImageMapToColors()
   {
     this->LookupTable->UnRegister(this);
   }
+  this->Colors->Delete();
 }
 
 //------------------------------------------------------------------------------
@@ -94,6 +101,7 @@ int vtkImageMapToColors::RequestData(
   else // normal behaviour
   {
     this->LookupTable->Build(); // make sure table is built
+    this->MapAllValues(this->GetInputArrayToProcess(0, inputVector));
 
     if (this->DataWasPassed)
     {
@@ -159,6 +167,102 @@ int vtkImageMapToColors::RequestInformation(vtkInformation* vtkNotUsed(request),
   return 1;
 }
 
+//------------------------------------------------------------------------------
+// Map all the values of an 8 or 16 bit integer type through the table.
+template <class T>
+void vtkImageMapToColorsMapAllValues(
+  vtkScalarsToColors* lookupTable, int dataType, int outputFormat, vtkUnsignedCharArray* colors)
+{
+  const int numberOfValues = 1 << (8 * sizeof(T));
+  std::vector<T> values(numberOfValues);
+  for (int i = 0; i < numberOfValues; ++i)
+  {
+    values[i] = static_cast<T>(std::numeric_limits<T>::min() + i);
+  }
+  colors->SetNumberOfValues(static_cast<vtkIdType>(numberOfValues) * outputFormat);
+  lookupTable->MapScalarsThroughTable2(
+    values.data(), colors->GetPointer(0), dataType, numberOfValues, 1, outputFormat);
+}
+
+//------------------------------------------------------------------------------
+// For 8 and 16 bit integer images with more voxels than possible values,
+// the colors of all the values are computed once, before the threads
+// copy them, rather than mapping each row through the lookup table.
+void vtkImageMapToColors::MapAllValues(vtkDataArray* inArray)
+{
+  this->Colors->Initialize();
+  if (!inArray)
+  {
+    return;
+  }
+  int dataType = inArray->GetDataType();
+  int size = (inArray->GetDataTypeSize() == 1 ? 256 : 65536);
+  if (inArray->GetNumberOfTuples() < size)
+  {
+    return;
+  }
+
+  switch (dataType)
+  {
+    case VTK_CHAR:
+      vtkImageMapToColorsMapAllValues<char>(
+        this->LookupTable, dataType, this->OutputFormat, this->Colors);
+      break;
+    case VTK_SIGNED_CHAR:
+      vtkImageMapToColorsMapAllValues<signed char>(
+        this->LookupTable, dataType, this->OutputFormat, this->Colors);
+      break;
+    case VTK_UNSIGNED_CHAR:
+      vtkImageMapToColorsMapAllValues<unsigned char>(
+        this->LookupTable, dataType, this->OutputFormat, this->Colors);
+      break;
+    case VTK_SHORT:
+      vtkImageMapToColorsMapAllValues<short>(
+        this->LookupTable, dataType, this->OutputFormat, this->Colors);
+      break;
+    case VTK_UNSIGNED_SHORT:
+      vtkImageMapToColorsMapAllValues<unsigned short>(
+        this->LookupTable, dataType, this->OutputFormat, this->Colors);
+      break;
+  }
+}
+
+//------------------------------------------------------------------------------
+// Copy the precomputed colors of a row of 8 or 16 bit integers.
+template <int N, class T>
+void vtkImageMapToColorsCopyColors(
+  const unsigned char* colors, const T* inPtr, int inIncr, unsigned char* outPtr, int length)
+{
+  const int offset = -static_cast<int>(std::numeric_limits<T>::min());
+  for (int i = 0; i < length; ++i)
+  {
+    memcpy(outPtr, colors + N * (static_cast<int>(*inPtr) + offset), N);
+    inPtr += inIncr;
+    outPtr += N;
+  }
+}
+
+template <class T>
+void vtkImageMapToColorsCopyColors(const unsigned char* colors, const T* inPtr, int inIncr,
+  unsigned char* outPtr, int length, int outputFormat)
+{
+  switch (outputFormat)
+  {
+    case VTK_RGBA:
+      vtkImageMapToColorsCopyColors<4>(colors, inPtr, inIncr, outPtr, length);
+      break;
+    case VTK_RGB:
+      vtkImageMapToColorsCopyColors<3>(colors, inPtr, inIncr, outPtr, length);
+      break;
+    case VTK_LUMINANCE_ALPHA:
+      vtkImageMapToColorsCopyColors<2>(colors, inPtr, inIncr, outPtr, length);
+      break;
+    case VTK_LUMINANCE:
+      vtkImageMapToColorsCopyColors<1>(colors, inPtr, inIncr, outPtr, length);
+      break;
+  }
+}
+
 //------------------------------------------------------------------------------
 // This non-templated function executes the filter for any type of data.
 // All the data to process should be achieved outside this method as
@@ -166,7 +270,7 @@ int vtkImageMapToColors::RequestInformation(vtkInformation* vtkNotUsed(request),
 
 static void vtkImageMapToColorsExecute(vtkImageMapToColors* self, vtkImageData* inData,
   vtkDataArray* inArray, vtkCharArray* maskArray, vtkImageData* outData, vtkDataArray* outArray,
-  int outExt[6], int id, unsigned char* nanColor)
+  int outExt[6], int id, unsigned char* nanColor, const unsigned char* colors)
 {
   int idxY, idxZ;
   int extX, extY, extZ;
@@ -230,8 +334,37 @@ static void vtkImageMapToColorsExecute(vtkImageMapToColors* self, vtkImageData*
         }
         count++;
       }
-      lookupTable->MapScalarsThroughTable2(
-        inPtr1, outPtr1, dataType, extX, numberOfComponents, outputFormat);
+      if (colors)
+      {
+        switch (dataType)
+        {
+          case VTK_CHAR:
+            vtkImageMapToColorsCopyColors(colors, static_cast<char*>(inPtr1),
+              numberOfComponents, outPtr1, extX, outputFormat);
+            break;
+          case VTK_SIGNED_CHAR:
+            vtkImageMapToColorsCopyColors(colors, static_cast<signed char*>(inPtr1),
+              numberOfComponents, outPtr1, extX, outputFormat);
+            break;
+          case VTK_UNSIGNED_CHAR:
+            vtkImageMapToColorsCopyColors(colors, static_cast<unsigned char*>(inPtr1),
+              numberOfComponents, outPtr1, extX, outputFormat);
+            break;
+          case VTK_SHORT:
+            vtkImageMapToColorsCopyColors(colors, static_cast<short*>(inPtr1),
+              numberOfComponents, outPtr1, extX, outputFormat);
+            break;
+          case VTK_UNSIGNED_SHORT:
+            vtkImageMapToColorsCopyColors(colors, static_cast<unsigned short*>(inPtr1),
+              numberOfComponents, outPtr1, extX, outputFormat);
+            break;
+        }
+      }
+      else
+      {
+        lookupTable->MapScalarsThroughTable2(
+          inPtr1, outPtr1, dataType, extX, numberOfComponents, outputFormat);
+      }
       // Handle NaN color when mask
       if (inMask != nullptr)
       {
@@ -297,9 +430,12 @@ void vtkImageMapToColors::ThreadedRequestData(vtkInformation* vtkNotUsed(request
     vtkArrayDownCast<vtkCharArray>(inData[0][0]->GetPointData()->GetArray("vtkValidPointMask"));
   vtkDataArray* inArray = this->GetInputArrayToProcess(0, inputVector);
 
+  const unsigned char* colors =
+    (this->Colors->GetNumberOfValues() > 0 ? this->Colors->GetPointer(0) : nullptr);
+
   // Working method
-  vtkImageMapToColorsExecute(
-    this, inData[0][0], inArray, maskArray, outData[0], outArray, outExt, id, this->NaNColor);
+  vtkImageMapToColorsExecute(this, inData[0][0], inArray, maskArray, outData[0], outArray, outExt,
+    id, this->NaNColor, colors);
 }
 
 //------------------------------------------------------------------------------
@@ -33,6 +33,7 @@
 #include "vtkThreadedImageAlgorithm.h"
 
 class vtkScalarsToColors;
+class vtkUnsignedCharArray;
 
 class VTKIMAGINGCORE_EXPORT vtkImageMapToColors : public vtkThreadedImageAlgorithm
 {
@@ -106,6 +107,12 @@ protected:
   int RequestData(vtkInformation* request, vtkInformationVector** inputVector,
     vtkInformationVector* outputVector) override;
 
+  /**
+   * Map all the values of 8 and 16 bit integer input through the lookup
+   * table, if the input has more values than the type can represent.
+   */
+  void MapAllValues(vtkDataArray* inArray);
+
   vtkScalarsToColors* LookupTable;
   int OutputFormat;
 
@@ -116,6 +123,10 @@ protected:
 
   unsigned char NaNColor[4];
 
+  // The colors of all the values of 8 and 16 bit integer input, which are
+  // mapped once for large images.
+  vtkUnsignedCharArray* Colors;
+
 private:
   vtkImageMapToColors(const vtkImageMapToColors&) = delete;
   void operator=(const vtkImageMapToColors&) = delete;
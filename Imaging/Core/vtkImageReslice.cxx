@@ -1798,6 +1798,464 @@ void vtkImageResliceClearExecute(
   vtkFreeBackgroundPixel(&background);
 }
 
+//------------------------------------------------------------------------------
+// Row kernels for affine transformations.  The position along each axis is
+// a monotonic function of the output x index, so the pixels of a row that
+// are within the input bounds form a single range, which is found with a
+// few checks.  Within that range, the indices and weights for a block of
+// pixels are computed in simple loops that can be vectorized, before the
+// input samples are gathered.  The arithmetic is the same as that of
+// vtkImageInterpolator, so the results are identical.  On x86-64, the
+// kernels are compiled for both the baseline instruction set and AVX2,
+// and the choice is made at run time.
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define VTK_RESLICE_ROW_AVX2
+#define VTK_RESLICE_ROW_INLINE inline __attribute__((always_inline))
+#else
+#define VTK_RESLICE_ROW_INLINE inline
+#endif
+
+// the number of pixels that are processed as a block
+#define VTK_RESLICE_ROW_BLOCK 64
+
+// information about the input image for the row kernels
+template <class F>
+struct vtkImageResliceRowInfo
+{
+  const void* Pointer;
+  int Extent[6];
+  vtkIdType Increments[3];
+  F Bounds[6];
+};
+
+// check whether the CPU supports AVX2, if it was compiled in
+inline bool vtkResliceRowUseAVX2()
+{
+#ifdef VTK_RESLICE_ROW_AVX2
+  __builtin_cpu_init();
+  return (__builtin_cpu_supports("avx2") != 0);
+#else
+  return false;
+#endif
+}
+
+// The check done by CheckBoundsIJK() for one side of one axis
+template <class F>
+struct vtkResliceRowBoundsCheck
+{
+  const F* Bounds;
+
+  bool operator()(int axis, int side, F x) const
+  {
+    return (side == 0 ? !(x < this->Bounds[2 * axis]) : !(x > this->Bounds[2 * axis + 1]));
+  }
+};
+
+// The check done for the nearest-neighbor pixel copy for one side of one
+// axis, where positions beyond the int range are outside of any extent
+template <class F>
+struct vtkResliceRowExtentCheck
+{
+  const int* Extent;
+
+  bool operator()(int axis, int side, F x) const
+  {
+    const F limit = F(VTK_INT_MAX / 2);
+    x = (x > -limit ? x : -limit);
+    x = (x < limit ? x : limit);
+    int idx = vtkInterpolationMath::Round(x);
+    return (side == 0 ? idx >= this->Extent[2 * axis] : idx <= this->Extent[2 * axis + 1]);
+  }
+};
+
+// Reduce [idX0, idX1] to the range of pixels that pass the checks on both
+// sides of all three axes.  Each check is monotonic along the row, so the
+// pixels that pass it are found by a binary search.  The point and the
+// axis must be finite, or the checks might not be monotonic.
+template <class F, class Check>
+void vtkResliceRowRange(
+  const F point[3], const F axis[3], const Check& check, int& idX0, int& idX1)
+{
+  for (int k = 0; k < 3 && idX0 <= idX1; k++)
+  {
+    for (int side = 0; side < 2; side++)
+    {
+      bool pass0 = check(k, side, point[k] + idX0 * axis[k]);
+      bool pass1 = check(k, side, point[k] + idX1 * axis[k]);
+      if (pass0 != pass1)
+      {
+        // search for the boundary between the passing and failing pixels
+        int a = idX0;
+        int b = idX1;
+        while (b - a > 1)
+        {
+          int c = a + (b - a) / 2;
+          if (check(k, side, point[k] + c * axis[k]) == pass0)
+          {
+            a = c;
+          }
+          else
+          {
+            b = c;
+          }
+        }
+        idX0 = (pass0 ? idX0 : b);
+        idX1 = (pass0 ? a : idX1);
+      }
+      else if (!pass0)
+      {
+        // no pixels pass
+        idX1 = idX0 - 1;
+        return;
+      }
+    }
+  }
+}
+
+// Check whether the position of every pixel along the row is finite
+template <class F>
+inline bool vtkResliceRowIsFinite(const F point[3], const F axis[3], int idX0, int idX1)
+{
+  for (int k = 0; k < 3; k++)
+  {
+    if (!std::isfinite(point[k] + idX0 * axis[k]) || !std::isfinite(point[k] + idX1 * axis[k]))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Compute the input positions for a block of pixels
+template <class F>
+VTK_RESLICE_ROW_INLINE void vtkResliceRowPositions(
+  const F point[3], const F axis[3], int idX, int n, F* x, F* y, F* z)
+{
+  F x0 = point[0];
+  F y0 = point[1];
+  F z0 = point[2];
+  F dx = axis[0];
+  F dy = axis[1];
+  F dz = axis[2];
+  for (int i = 0; i < n; i++)
+  {
+    x[i] = x0 + (idX + i) * dx;
+    y[i] = y0 + (idX + i) * dy;
+    z[i] = z0 + (idX + i) * dz;
+  }
+}
+
+// A block version of vtkInterpolationMath::Floor and Round, for positions
+// that are within the int range.  After the bias is added, the value has
+// a fixed exponent with 16 fractional bits in the mantissa, so the index
+// and the fraction are read from the bits like in the 32-bit version of
+// Floor, but with a 64-bit integer.  Unlike the conversion of a double to
+// a 64-bit integer, this can be vectorized.
+template <class F>
+VTK_RESLICE_ROW_INLINE void vtkResliceRowFloor(const F* x, int* idx, F* f, int n, double bias)
+{
+  for (int i = 0; i < n; i++)
+  {
+    double b = x[i] + bias;
+    vtkTypeUInt64 bits;
+    memcpy(&bits, &b, sizeof(bits));
+    // the low 32 bits of the integer part are the index, since the low
+    // 32 bits of the integer part of the bias are zero
+    idx[i] = static_cast<int>(static_cast<vtkTypeUInt32>(bits >> 16));
+    f[i] = static_cast<F>(static_cast<int>(bits & 0xFFFF) * 0.0000152587890625); // 2**(-16)
+  }
+}
+
+// Clamp the indices for a block of pixels, and compute the offsets
+VTK_RESLICE_ROW_INLINE void vtkResliceRowOffsets(
+  const int* idx, int low, int high, vtkIdType inc, vtkIdType* off, int n)
+{
+  for (int i = 0; i < n; i++)
+  {
+    off[i] = vtkInterpolationMath::Clamp(idx[i], low, high) * inc;
+  }
+}
+
+// The same, for the second pair of samples for linear interpolation
+template <class F>
+VTK_RESLICE_ROW_INLINE void vtkResliceRowOffsets(
+  const int* idx, const F* f, int low, int high, vtkIdType inc, vtkIdType* off, int n)
+{
+  for (int i = 0; i < n; i++)
+  {
+    off[i] = vtkInterpolationMath::Clamp(idx[i] + (f[i] != 0), low, high) * inc;
+  }
+}
+
+//------------------------------------------------------------------------------
+// Interpolate the pixels of a row that are within the input bounds
+template <class F, class T>
+struct vtkImageResliceRowKernel
+{
+  static VTK_RESLICE_ROW_INLINE void NearestRow(const vtkImageResliceRowInfo<F>* info,
+    const F point[3], const F axis[3], int idX, int n, F* outPtr);
+
+  static VTK_RESLICE_ROW_INLINE void TrilinearRow(const vtkImageResliceRowInfo<F>* info,
+    const F point[3], const F axis[3], int idX, int n, F* outPtr);
+
+  static void Nearest(const vtkImageResliceRowInfo<F>* info, const F point[3], const F axis[3],
+    int idX, int n, F* outPtr)
+  {
+    NearestRow(info, point, axis, idX, n, outPtr);
+  }
+
+  static void Trilinear(const vtkImageResliceRowInfo<F>* info, const F point[3],
+    const F axis[3], int idX, int n, F* outPtr)
+  {
+    TrilinearRow(info, point, axis, idX, n, outPtr);
+  }
+
+#ifdef VTK_RESLICE_ROW_AVX2
+  __attribute__((target("avx2"))) static void NearestAVX2(const vtkImageResliceRowInfo<F>* info,
+    const F point[3], const F axis[3], int idX, int n, F* outPtr)
+  {
+    NearestRow(info, point, axis, idX, n, outPtr);
+  }
+
+  __attribute__((target("avx2"))) static void TrilinearAVX2(
+    const vtkImageResliceRowInfo<F>* info, const F point[3], const F axis[3], int idX, int n,
+    F* outPtr)
+  {
+    TrilinearRow(info, point, axis, idX, n, outPtr);
+  }
+#endif
+
+  static void GetRowFunc(
+    void (**rowfunc)(const vtkImageResliceRowInfo<F>*, const F[3], const F[3], int, int, F*),
+    int interpolationMode, bool useAVX2)
+  {
+    (void)useAVX2;
+    if (interpolationMode == VTK_NEAREST_INTERPOLATION)
+    {
+      *rowfunc = &Nearest;
+#ifdef VTK_RESLICE_ROW_AVX2
+      *rowfunc = (useAVX2 ? &NearestAVX2 : &Nearest);
+#endif
+    }
+    else
+    {
+      *rowfunc = &Trilinear;
+#ifdef VTK_RESLICE_ROW_AVX2
+      *rowfunc = (useAVX2 ? &TrilinearAVX2 : &Trilinear);
+#endif
+    }
+  }
+};
+
+//------------------------------------------------------------------------------
+template <class F, class T>
+void vtkImageResliceRowKernel<F, T>::NearestRow(const vtkImageResliceRowInfo<F>* info,
+  const F point[3], const F axis[3], int idX, int n, F* outPtr)
+{
+  const T* inPtr = static_cast<const T*>(info->Pointer);
+  const int* inExt = info->Extent;
+  const vtkIdType* inInc = info->Increments;
+
+  for (int j = 0; j < n; j += VTK_RESLICE_ROW_BLOCK)
+  {
+    int m = n - j;
+    m = (m < VTK_RESLICE_ROW_BLOCK ? m : VTK_RESLICE_ROW_BLOCK);
+
+    F x[VTK_RESLICE_ROW_BLOCK], y[VTK_RESLICE_ROW_BLOCK], z[VTK_RESLICE_ROW_BLOCK];
+    vtkResliceRowPositions(point, axis, idX + j, m, x, y, z);
+
+    // the fractions are not needed, since the indices are rounded
+    int idx[VTK_RESLICE_ROW_BLOCK];
+    F f[VTK_RESLICE_ROW_BLOCK];
+    vtkIdType offX[VTK_RESLICE_ROW_BLOCK], offY[VTK_RESLICE_ROW_BLOCK];
+    vtkIdType offZ[VTK_RESLICE_ROW_BLOCK];
+    const double bias = 103079215104.5 + VTK_INTERPOLATE_FLOOR_TOL;
+    vtkResliceRowFloor(x, idx, f, m, bias);
+    vtkResliceRowOffsets(idx, inExt[0], inExt[1], inInc[0], offX, m);
+    vtkResliceRowFloor(y, idx, f, m, bias);
+    vtkResliceRowOffsets(idx, inExt[2], inExt[3], inInc[1], offY, m);
+    vtkResliceRowFloor(z, idx, f, m, bias);
+    vtkResliceRowOffsets(idx, inExt[4], inExt[5], inInc[2], offZ, m);
+
+    F* out = outPtr + j;
+    for (int i = 0; i < m; i++)
+    {
+      out[i] = inPtr[offX[i] + offY[i] + offZ[i]];
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+template <class F, class T>
+void vtkImageResliceRowKernel<F, T>::TrilinearRow(const vtkImageResliceRowInfo<F>* info,
+  const F point[3], const F axis[3], int idX, int n, F* outPtr)
+{
+  const T* inPtr = static_cast<const T*>(info->Pointer);
+  const int* inExt = info->Extent;
+  const vtkIdType* inInc = info->Increments;
+
+  for (int j = 0; j < n; j += VTK_RESLICE_ROW_BLOCK)
+  {
+    int m = n - j;
+    m = (m < VTK_RESLICE_ROW_BLOCK ? m : VTK_RESLICE_ROW_BLOCK);
+
+    F x[VTK_RESLICE_ROW_BLOCK], y[VTK_RESLICE_ROW_BLOCK], z[VTK_RESLICE_ROW_BLOCK];
+    vtkResliceRowPositions(point, axis, idX + j, m, x, y, z);
+
+    int idx[VTK_RESLICE_ROW_BLOCK];
+    F fx[VTK_RESLICE_ROW_BLOCK], fy[VTK_RESLICE_ROW_BLOCK], fz[VTK_RESLICE_ROW_BLOCK];
+    vtkIdType offX0[VTK_RESLICE_ROW_BLOCK], offX1[VTK_RESLICE_ROW_BLOCK];
+    vtkIdType offY0[VTK_RESLICE_ROW_BLOCK], offY1[VTK_RESLICE_ROW_BLOCK];
+    vtkIdType offZ0[VTK_RESLICE_ROW_BLOCK], offZ1[VTK_RESLICE_ROW_BLOCK];
+    const double bias = 103079215104.0 + VTK_INTERPOLATE_FLOOR_TOL;
+    vtkResliceRowFloor(x, idx, fx, m, bias);
+    vtkResliceRowOffsets(idx, inExt[0], inExt[1], inInc[0], offX0, m);
+    vtkResliceRowOffsets(idx, fx, inExt[0], inExt[1], inInc[0], offX1, m);
+    vtkResliceRowFloor(y, idx, fy, m, bias);
+    vtkResliceRowOffsets(idx, inExt[2], inExt[3], inInc[1], offY0, m);
+    vtkResliceRowOffsets(idx, fy, inExt[2], inExt[3], inInc[1], offY1, m);
+    vtkResliceRowFloor(z, idx, fz, m, bias);
+    vtkResliceRowOffsets(idx, inExt[4], inExt[5], inInc[2], offZ0, m);
+    vtkResliceRowOffsets(idx, fz, inExt[4], inExt[5], inInc[2], offZ1, m);
+
+    F* out = outPtr + j;
+    for (int i = 0; i < m; i++)
+    {
+      F rx = 1 - fx[i];
+      F ry = 1 - fy[i];
+      F rz = 1 - fz[i];
+
+      F ryrz = ry * rz;
+      F fyrz = fy[i] * rz;
+      F ryfz = ry * fz[i];
+      F fyfz = fy[i] * fz[i];
+
+      vtkIdType i00 = offY0[i] + offZ0[i];
+      vtkIdType i01 = offY0[i] + offZ1[i];
+      vtkIdType i10 = offY1[i] + offZ0[i];
+      vtkIdType i11 = offY1[i] + offZ1[i];
+
+      const T* inPtr0 = inPtr + offX0[i];
+      const T* inPtr1 = inPtr + offX1[i];
+
+      out[i] =
+        (rx * (ryrz * inPtr0[i00] + ryfz * inPtr0[i01] + fyrz * inPtr0[i10] + fyfz * inPtr0[i11]) +
+          fx[i] *
+            (ryrz * inPtr1[i00] + ryfz * inPtr1[i01] + fyrz * inPtr1[i10] + fyfz * inPtr1[i11]));
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+// Get the row kernel for the interpolation mode and the input type, or
+// nullptr if there is no row kernel that matches vtkImageInterpolator.
+template <class F>
+void vtkGetResliceRowFunc(
+  void (**rowfunc)(const vtkImageResliceRowInfo<F>*, const F[3], const F[3], int, int, F*),
+  int scalarType, int interpolationMode)
+{
+  *rowfunc = nullptr;
+#if VTK_SIZEOF_VOID_P >= 8
+  // the kernels use the 64-bit version of vtkInterpolationMath::Floor
+  if (interpolationMode == VTK_NEAREST_INTERPOLATION ||
+    interpolationMode == VTK_LINEAR_INTERPOLATION)
+  {
+    bool useAVX2 = vtkResliceRowUseAVX2();
+    switch (scalarType)
+    {
+      vtkTemplateAliasMacro((vtkImageResliceRowKernel<F, VTK_TT>::GetRowFunc(
+        rowfunc, interpolationMode, useAVX2)));
+      default:
+        break;
+    }
+  }
+#else
+  (void)scalarType;
+  (void)interpolationMode;
+#endif
+}
+
+//------------------------------------------------------------------------------
+// Compute the byte offsets of the nearest input voxels for the pixels of
+// a row that are within the input extent, for the nearest-neighbor copy.
+template <class F>
+struct vtkImageResliceNearestOffsets
+{
+  static VTK_RESLICE_ROW_INLINE void OffsetsRow(const vtkImageResliceRowInfo<F>* info,
+    const F point[3], const F axis[3], int idX, int n, vtkIdType* offsets);
+
+  static void Offsets(const vtkImageResliceRowInfo<F>* info, const F point[3], const F axis[3],
+    int idX, int n, vtkIdType* offsets)
+  {
+    OffsetsRow(info, point, axis, idX, n, offsets);
+  }
+
+#ifdef VTK_RESLICE_ROW_AVX2
+  __attribute__((target("avx2"))) static void OffsetsAVX2(const vtkImageResliceRowInfo<F>* info,
+    const F point[3], const F axis[3], int idX, int n, vtkIdType* offsets)
+  {
+    OffsetsRow(info, point, axis, idX, n, offsets);
+  }
+#endif
+};
+
+//------------------------------------------------------------------------------
+template <class F>
+void vtkImageResliceNearestOffsets<F>::OffsetsRow(const vtkImageResliceRowInfo<F>* info,
+  const F point[3], const F axis[3], int idX, int n, vtkIdType* offsets)
+{
+  const int* inExt = info->Extent;
+  const vtkIdType* inInc = info->Increments;
+
+  for (int j = 0; j < n; j += VTK_RESLICE_ROW_BLOCK)
+  {
+    int m = n - j;
+    m = (m < VTK_RESLICE_ROW_BLOCK ? m : VTK_RESLICE_ROW_BLOCK);
+
+    F x[VTK_RESLICE_ROW_BLOCK], y[VTK_RESLICE_ROW_BLOCK], z[VTK_RESLICE_ROW_BLOCK];
+    vtkResliceRowPositions(point, axis, idX + j, m, x, y, z);
+
+    // the extent has already been checked, so the offsets are not clamped
+    int idx[VTK_RESLICE_ROW_BLOCK];
+    F f[VTK_RESLICE_ROW_BLOCK];
+    vtkIdType offX[VTK_RESLICE_ROW_BLOCK], offY[VTK_RESLICE_ROW_BLOCK];
+    const double bias = 103079215104.5 + VTK_INTERPOLATE_FLOOR_TOL;
+    vtkResliceRowFloor(x, idx, f, m, bias);
+    vtkResliceRowOffsets(idx, inExt[0], inExt[1], inInc[0], offX, m);
+    vtkResliceRowFloor(y, idx, f, m, bias);
+    vtkResliceRowOffsets(idx, inExt[2], inExt[3], inInc[1], offY, m);
+    vtkResliceRowFloor(z, idx, f, m, bias);
+    vtkIdType* offZ = offsets + j;
+    vtkResliceRowOffsets(idx, inExt[4], inExt[5], inInc[2], offZ, m);
+
+    for (int i = 0; i < m; i++)
+    {
+      offZ[i] += offX[i] + offY[i];
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+// Get the function that computes the nearest-neighbor offsets for a row,
+// or nullptr if the function does not match vtkInterpolationMath::Round.
+template <class F>
+void vtkGetResliceNearestOffsetsFunc(
+  void (**offsetsfunc)(const vtkImageResliceRowInfo<F>*, const F[3], const F[3], int, int,
+    vtkIdType*))
+{
+  *offsetsfunc = nullptr;
+#if VTK_SIZEOF_VOID_P >= 8
+  *offsetsfunc = &vtkImageResliceNearestOffsets<F>::Offsets;
+#ifdef VTK_RESLICE_ROW_AVX2
+  if (vtkResliceRowUseAVX2())
+  {
+    *offsetsfunc = &vtkImageResliceNearestOffsets<F>::OffsetsAVX2;
+  }
+#endif
+#endif
+}
+
 //------------------------------------------------------------------------------
 // application of the transform has different forms for fixed-point
 // vs. floating-point
@@ -1887,6 +2345,39 @@ void vtkImageResliceExecute(vtkImageReslice* self, vtkDataArray* scalars,
     optimizeNearest = true;
   }
 
+  // the input information for the row kernels
+  vtkImageResliceRowInfo<F> rowInfo;
+  rowInfo.Pointer = inPtr;
+  const double* bounds = interpolator->GetStructuredBounds();
+  for (int i = 0; i < 6; i++)
+  {
+    rowInfo.Extent[i] = inExt[i];
+    rowInfo.Bounds[i] = F(bounds[i]);
+  }
+
+  // can whole rows be computed at once for an affine transformation?
+  void (*rowfunc)(const vtkImageResliceRowInfo<F>*, const F[3], const F[3], int, int, F*) =
+    nullptr;
+  void (*offsetsfunc)(const vtkImageResliceRowInfo<F>*, const F[3], const F[3], int, int,
+    vtkIdType*) = nullptr;
+  if (optimizeNearest)
+  {
+    vtkGetResliceNearestOffsetsFunc(&offsetsfunc);
+    for (int i = 0; i < 3; i++)
+    {
+      rowInfo.Increments[i] = inInc[i] * inputScalarSize;
+    }
+  }
+  else if (!(newtrans || perspective) && nsamples <= 1 && borderMode == VTK_IMAGE_BORDER_CLAMP &&
+    inComponents == 1 && inInc[0] == 1 && fullSize == scalars->GetNumberOfTuples())
+  {
+    vtkGetResliceRowFunc(&rowfunc, inputScalarType, interpolationMode);
+    for (int i = 0; i < 3; i++)
+    {
+      rowInfo.Increments[i] = inInc[i];
+    }
+  }
+
   // get pixel information
   int scalarType = outData->GetScalarType();
   int scalarSize = outData->GetScalarSize();
@@ -1924,6 +2415,13 @@ void vtkImageResliceExecute(vtkImageReslice* self, vtkDataArray* scalars,
     floatPtr = new F[inComponents * (outExt[1] - outExt[0] + nsamples)];
   }
 
+  // allocate the offsets for the nearest-neighbor pixel copy
+  vtkIdType* offsetsPtr = nullptr;
+  if (optimizeNearest)
+  {
+    offsetsPtr = new vtkIdType[outExt[1] - outExt[0] + 1];
+  }
+
   // set color for area outside of input volume extent
   void* background;
   vtkAllocBackgroundPixel(
@@ -1995,8 +2493,35 @@ void vtkImageResliceExecute(vtkImageReslice* self, vtkDataArray* scalars,
         int idX = idXmin;
         F* tmpPtr = floatPtr;
 
+        // for affine transformations, find the pixels that are in bounds
+        // and interpolate them all at once
+        bool useRowFunc = (rowfunc && vtkResliceRowIsFinite(inPoint1, xAxis, idXmin, idXmax));
+        int inIdXmin = idXmin;
+        int inIdXmax = idXmax;
+        if (useRowFunc)
+        {
+          vtkResliceRowBoundsCheck<F> check = { rowInfo.Bounds };
+          vtkResliceRowRange(inPoint1, xAxis, check, inIdXmin, inIdXmax);
+          if (inIdXmin <= inIdXmax)
+          {
+            rowfunc(&rowInfo, inPoint1, xAxis, inIdXmin, inIdXmax - inIdXmin + 1,
+              floatPtr + (inIdXmin - idXmin));
+          }
+        }
+
         while (startIdX <= idXmax)
         {
+          if (useRowFunc)
+          {
+            // find the end of the segment from the range that is in bounds
+            for (; idX <= idXmax && isInBounds == wasInBounds; idX++)
+            {
+              isInBounds = (idX >= inIdXmin && idX <= inIdXmax);
+              wasInBounds = ((idX > idXmin) ? wasInBounds : isInBounds);
+            }
+            tmpPtr = floatPtr + inComponents * (idX - idXmin);
+          }
+
           for (; idX <= idXmax && isInBounds == wasInBounds; idX++)
           {
             F inPoint2[4];
@@ -2070,8 +2595,8 @@ void vtkImageResliceExecute(vtkImageReslice* self, vtkDataArray* scalars,
 
             if (rescaleScalars)
             {
-              vtkImageResliceRescaleScalars(
-                floatPtr, inComponents, idXmax - idXmin + 1, scalarShift, scalarScale);
+              vtkImageResliceRescaleScalars(tmpPtr - inComponents * (idX - startIdX), inComponents,
+                numpixels, scalarShift, scalarScale);
             }
 
             if (convertScalars)
@@ -2115,19 +2640,51 @@ void vtkImageResliceExecute(vtkImageReslice* self, vtkDataArray* scalars,
         bool isInBounds = false;
         int bytesPerPixel = inputScalarSize * inComponents;
 
-        for (int iidX = idXmin; iidX <= idXmax; iidX++)
+        // compute the offsets of the nearest input voxels for the row,
+        // with an offset of -1 for the pixels outside of the input extent
+        if (offsetsfunc && vtkResliceRowIsFinite(inPoint1, xAxis, idXmin, idXmax))
         {
-          F inPoint[3];
-          inPoint[0] = inPoint1[0] + iidX * xAxis[0];
-          inPoint[1] = inPoint1[1] + iidX * xAxis[1];
-          inPoint[2] = inPoint1[2] + iidX * xAxis[2];
-
-          int inIdX = vtkInterpolationMath::Round(inPoint[0]) - inExt[0];
-          int inIdY = vtkInterpolationMath::Round(inPoint[1]) - inExt[2];
-          int inIdZ = vtkInterpolationMath::Round(inPoint[2]) - inExt[4];
+          int inIdXmin = idXmin;
+          int inIdXmax = idXmax;
+          vtkResliceRowExtentCheck<F> check = { inExt };
+          vtkResliceRowRange(inPoint1, xAxis, check, inIdXmin, inIdXmax);
+          for (int iidX = idXmin; iidX <= idXmax; iidX++)
+          {
+            offsetsPtr[iidX - idXmin] = -1;
+          }
+          if (inIdXmin <= inIdXmax)
+          {
+            offsetsfunc(&rowInfo, inPoint1, xAxis, inIdXmin, inIdXmax - inIdXmin + 1,
+              offsetsPtr + (inIdXmin - idXmin));
+          }
+        }
+        else
+        {
+          for (int iidX = idXmin; iidX <= idXmax; iidX++)
+          {
+            F inPoint[3];
+            inPoint[0] = inPoint1[0] + iidX * xAxis[0];
+            inPoint[1] = inPoint1[1] + iidX * xAxis[1];
+            inPoint[2] = inPoint1[2] + iidX * xAxis[2];
+
+            int inIdX = vtkInterpolationMath::Round(inPoint[0]) - inExt[0];
+            int inIdY = vtkInterpolationMath::Round(inPoint[1]) - inExt[2];
+            int inIdZ = vtkInterpolationMath::Round(inPoint[2]) - inExt[4];
+
+            vtkIdType offset = -1;
+            if (inIdX >= 0 && inIdX < inExtX && inIdY >= 0 && inIdY < inExtY && inIdZ >= 0 &&
+              inIdZ < inExtZ)
+            {
+              offset = inIdX * inIncX + inIdY * inIncY + inIdZ * inIncZ;
+            }
+            offsetsPtr[iidX - idXmin] = offset;
+          }
+        }
 
-          if (inIdX >= 0 && inIdX < inExtX && inIdY >= 0 && inIdY < inExtY && inIdZ >= 0 &&
-            inIdZ < inExtZ)
+        for (int iidX = idXmin; iidX <= idXmax; iidX++)
+        {
+          vtkIdType offset = offsetsPtr[iidX - idXmin];
+          if (offset >= 0)
           {
             if (!isInBounds)
             {
@@ -2141,7 +2698,7 @@ void vtkImageResliceExecute(vtkImageReslice* self, vtkDataArray* scalars,
             endIdX = iidX;
 
             // perform nearest-neighbor interpolation via pixel copy
-            const char* inPtrTmp = inPtrTmp0 + inIdX * inIncX + inIdY * inIncY + inIdZ * inIncZ;
+            const char* inPtrTmp = inPtrTmp0 + offset;
 
             // when memcpy is used with a constant size, the compiler will
             // optimize away the function call and use the minimum number
@@ -2204,6 +2761,7 @@ void vtkImageResliceExecute(vtkImageReslice* self, vtkDataArray* scalars,
   {
     delete[] floatPtr;
   }
+  delete[] offsetsPtr;
 }
 
 //------------------------------------------------------------------------------
@@ -0,0 +1,33 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkImageStreamingSink.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkImageStreamingSink.h"
+
+//------------------------------------------------------------------------------
+void vtkImageStreamingSink::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+}
+
+//------------------------------------------------------------------------------
+int vtkImageStreamingSink::BeginStreaming(vtkInformation*, const int[6])
+{
+  return 1;
+}
+
+//------------------------------------------------------------------------------
+int vtkImageStreamingSink::EndStreaming()
+{
+  return 1;
+}
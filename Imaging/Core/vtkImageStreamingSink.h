@@ -0,0 +1,76 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkImageStreamingSink.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkImageStreamingSink
+ * @brief   consumer of the pieces streamed by vtkImageDataStreamer
+ *
+ * vtkImageStreamingSink is a superclass for objects that reduce or store
+ * an image one piece at a time, so that the whole image never has to be
+ * in memory.  When a sink is set on a vtkImageDataStreamer, the streamer
+ * calls BeginStreaming() once, then ConsumePiece() for each piece in
+ * order, and finally EndStreaming().  The pieces do not overlap, and
+ * together they cover the extent that was requested from the streamer.
+ *
+ * ConsumePiece() can be called from a thread other than the one that
+ * updates the pipeline, so that the next piece is computed while the
+ * current one is consumed.  It is never called for two pieces at once.
+ * @sa
+ * vtkImageDataStreamer vtkImageHistogramSink
+ */
+
+#ifndef vtkImageStreamingSink_h
+#define vtkImageStreamingSink_h
+
+#include "vtkImagingCoreModule.h" // For export macro
+#include "vtkObject.h"
+
+class vtkImageData;
+class vtkInformation;
+
+class VTKIMAGINGCORE_EXPORT vtkImageStreamingSink : public vtkObject
+{
+public:
+  vtkTypeMacro(vtkImageStreamingSink, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  /**
+   * Called before the first piece.  The information is that of the input
+   * of the streamer, for the scalar type, spacing, and origin, and the
+   * extent is the union of all the pieces.  Return 0 on error.
+   */
+  virtual int BeginStreaming(vtkInformation* inInfo, const int extent[6]);
+
+  /**
+   * Consume one piece.  The extent of the piece is exactly that of the
+   * data, and the data is not modified by the pipeline until this method
+   * returns.  Return 0 on error, which stops the streaming.
+   */
+  virtual int ConsumePiece(vtkImageData* piece) = 0;
+
+  /**
+   * Called after the last piece.  Return 0 on error.
+   */
+  virtual int EndStreaming();
+
+protected:
+  vtkImageStreamingSink() = default;
+  ~vtkImageStreamingSink() override = default;
+
+private:
+  vtkImageStreamingSink(const vtkImageStreamingSink&) = delete;
+  void operator=(const vtkImageStreamingSink&) = delete;
+};
+
+#endif
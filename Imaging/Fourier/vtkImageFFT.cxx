@@ -14,13 +14,16 @@
 =========================================================================*/
 #include "vtkImageFFT.h"
 
+#include "vtkFFT.h"
 #include "vtkImageData.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
+#include <algorithm>
 #include <cmath>
+#include <vector>
 
 vtkStandardNewMacro(vtkImageFFT);
 
@@ -62,24 +65,33 @@ int vtkImageFFT::IterativeRequestUpdateExtent(vtkInformation* input, vtkInformat
   return 1;
 }
 
+//------------------------------------------------------------------------------
+// The number of lines transformed together: enough for the gathers from
+// the input and the scatters to the output to use whole cache lines, few
+// enough for the lines to stay in cache.
+static int vtkImageFFTBatchSize(int size)
+{
+  return std::max(8, std::min(64, 16384 / std::max(size, 1)));
+}
+
 //------------------------------------------------------------------------------
 // This templated execute method handles any type input, but the output
-// is always doubles.
+// is always doubles. The lines along the axis of the iteration are
+// transformed by batches of lines adjacent along the next axis, gathered
+// one after the other so that vtkFFT runs on contiguous memory. Real inputs
+// are transformed with real to complex DFTs, which halve the work, and the
+// other half of the spectrum is their conjugate.
 template <class T>
 void vtkImageFFTExecute(vtkImageFFT* self, vtkImageData* inData, int inExt[6], T* inPtr,
   vtkImageData* outData, int outExt[6], double* outPtr, int id)
 {
-  vtkImageComplex* inComplex;
-  vtkImageComplex* outComplex;
-  vtkImageComplex* pComplex;
-  //
   int inMin0, inMax0;
   vtkIdType inInc0, inInc1, inInc2;
-  T *inPtr0, *inPtr1, *inPtr2;
+  T *inPtr1, *inPtr2;
   //
   int outMin0, outMax0, outMin1, outMax1, outMin2, outMax2;
   vtkIdType outInc0, outInc1, outInc2;
-  double *outPtr0, *outPtr1, *outPtr2;
+  double *outPtr1, *outPtr2;
   //
   int idx0, idx1, idx2, inSize0, numberOfComponents;
   unsigned long count = 0;
@@ -104,12 +116,20 @@ void vtkImageFFTExecute(vtkImageFFT* self, vtkImageData* inData, int inExt[6], T
     return;
   }
 
-  // Allocate the arrays of complex numbers
-  inComplex = new vtkImageComplex[inSize0];
-  outComplex = new vtkImageComplex[inSize0];
+  // Allocate the batch of lines, only the first half of the spectra of real
+  // lines is computed.
+  const bool real = numberOfComponents == 1;
+  const int spectrumSize = real ? inSize0 / 2 + 1 : inSize0;
+  const int batchSize = vtkImageFFTBatchSize(inSize0);
+  std::vector<double> realLines(real ? static_cast<size_t>(batchSize) * inSize0 : 0);
+  std::vector<vtkFFT::ComplexNumber> lines(static_cast<size_t>(batchSize) * inSize0);
+
+  // Gather and scatter along the lines in the inner loop when they are
+  // contiguous, across them otherwise.
+  const bool alongLines = std::abs(inInc0) <= std::abs(inInc1);
 
-  target = static_cast<unsigned long>(
-    (outMax2 - outMin2 + 1) * (outMax1 - outMin1 + 1) * self->GetNumberOfIterations() / 50.0);
+  target = static_cast<unsigned long>((outMax2 - outMin2 + 1) *
+    ((outMax1 - outMin1) / batchSize + 1) * self->GetNumberOfIterations() / 50.0);
   target++;
 
   // loop over other axes
@@ -117,9 +137,7 @@ void vtkImageFFTExecute(vtkImageFFT* self, vtkImageData* inData, int inExt[6], T
   outPtr2 = outPtr;
   for (idx2 = outMin2; idx2 <= outMax2; ++idx2)
   {
-    inPtr1 = inPtr2;
-    outPtr1 = outPtr2;
-    for (idx1 = outMin1; !self->AbortExecute && idx1 <= outMax1; ++idx1)
+    for (idx1 = outMin1; !self->AbortExecute && idx1 <= outMax1; idx1 += batchSize)
     {
       if (!id)
       {
@@ -129,43 +147,83 @@ void vtkImageFFTExecute(vtkImageFFT* self, vtkImageData* inData, int inExt[6], T
         }
         count++;
       }
+      const int numberOfLines = std::min(batchSize, outMax1 - idx1 + 1);
+      inPtr1 = inPtr2 + (idx1 - outMin1) * inInc1;
+      outPtr1 = outPtr2 + (idx1 - outMin1) * outInc1;
+
       // copy into complex numbers
-      inPtr0 = inPtr1;
-      pComplex = inComplex;
-      for (idx0 = inMin0; idx0 <= inMax0; ++idx0)
-      {
-        pComplex->Real = static_cast<double>(*inPtr0);
-        pComplex->Imag = 0.0;
-        if (numberOfComponents > 1)
+      auto gather = [&](int line, int idx) {
+        const T* value = inPtr1 + line * inInc1 + idx * inInc0;
+        if (real)
+        {
+          realLines[line * inSize0 + idx] = static_cast<double>(*value);
+        }
+        else
         { // yes we have an imaginary input
-          pComplex->Imag = static_cast<double>(inPtr0[1]);
+          lines[line * inSize0 + idx] =
+            vtkFFT::ComplexNumber{ static_cast<double>(value[0]), static_cast<double>(value[1]) };
+        }
+      };
+      for (int line = 0; alongLines && line < numberOfLines; ++line)
+      {
+        for (idx0 = 0; idx0 < inSize0; ++idx0)
+        {
+          gather(line, idx0);
+        }
+      }
+      for (idx0 = 0; !alongLines && idx0 < inSize0; ++idx0)
+      {
+        for (int line = 0; line < numberOfLines; ++line)
+        {
+          gather(line, idx0);
         }
-        inPtr0 += inInc0;
-        ++pComplex;
       }
 
-      // Call the method that performs the fft
-      self->ExecuteFft(inComplex, outComplex, inSize0);
+      // Call the methods that perform the fft
+      if (real)
+      {
+        vtkFFT::RFftBatch(realLines.data(), lines.data(), inSize0, numberOfLines);
+      }
+      else
+      {
+        vtkFFT::FftBatch(lines.data(), inSize0, numberOfLines);
+      }
 
       // copy into output
-      outPtr0 = outPtr1;
-      pComplex = outComplex + (outMin0 - inMin0);
-      for (idx0 = outMin0; idx0 <= outMax0; ++idx0)
+      auto scatter = [&](int line, int idx) {
+        double* value = outPtr1 + line * outInc1 + (idx - outMin0) * outInc0;
+        int k = idx - inMin0;
+        if (k < spectrumSize)
+        {
+          const vtkFFT::ComplexNumber& c = lines[line * spectrumSize + k];
+          value[0] = c.r;
+          value[1] = c.i;
+        }
+        else
+        {
+          const vtkFFT::ComplexNumber& c = lines[line * spectrumSize + inSize0 - k];
+          value[0] = c.r;
+          value[1] = -c.i;
+        }
+      };
+      for (int line = 0; alongLines && line < numberOfLines; ++line)
+      {
+        for (idx0 = outMin0; idx0 <= outMax0; ++idx0)
+        {
+          scatter(line, idx0);
+        }
+      }
+      for (idx0 = outMin0; !alongLines && idx0 <= outMax0; ++idx0)
       {
-        *outPtr0 = static_cast<double>(pComplex->Real);
-        outPtr0[1] = static_cast<double>(pComplex->Imag);
-        outPtr0 += outInc0;
-        ++pComplex;
+        for (int line = 0; line < numberOfLines; ++line)
+        {
+          scatter(line, idx0);
+        }
       }
-      inPtr1 += inInc1;
-      outPtr1 += outInc1;
     }
     inPtr2 += inInc2;
     outPtr2 += outInc2;
   }
-
-  delete[] inComplex;
-  delete[] outComplex;
 }
 
 //------------------------------------------------------------------------------
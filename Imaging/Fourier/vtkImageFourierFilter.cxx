@@ -14,8 +14,11 @@
 =========================================================================*/
 #include "vtkImageFourierFilter.h"
 
+#include "vtkFFT.h"
 #include "vtkMath.h"
+
 #include <cmath>
+#include <vector>
 
 /*=========================================================================
         Vectors of complex numbers.
@@ -207,27 +210,48 @@ void vtkImageFourierFilter::ExecuteFftForwardBackward(
   }
 }
 
+//------------------------------------------------------------------------------
+namespace
+{
+// Computes the DFT, or the inverse DFT scaled by 1 / N, with vtkFFT which
+// caches the plans of each length.
+void vtkImageFourierFilterExecute(vtkImageComplex* in, vtkImageComplex* out, int N, bool inverse)
+{
+  if (N < 1)
+  {
+    return;
+  }
+  std::vector<vtkFFT::ComplexNumber> line(N);
+  for (int idx = 0; idx < N; ++idx)
+  {
+    line[idx] = vtkFFT::ComplexNumber{ in[idx].Real, in[idx].Imag };
+  }
+  vtkFFT::FftBatch(line.data(), N, 1, inverse);
+  for (int idx = 0; idx < N; ++idx)
+  {
+    out[idx].Real = line[idx].r;
+    out[idx].Imag = line[idx].i;
+  }
+}
+}
+
 //------------------------------------------------------------------------------
 // This function calculates the whole fft of an array.
-// The contents of the input array are changed.
-// (It is engineered for no decimation)
 void vtkImageFourierFilter::ExecuteFft(vtkImageComplex* in, vtkImageComplex* out, int N)
 {
-  this->ExecuteFftForwardBackward(in, out, N, 1);
+  vtkImageFourierFilterExecute(in, out, N, false);
 }
 
 //------------------------------------------------------------------------------
-// This function calculates the whole fft of an array.
-// The contents of the input array are changed.
-// (It is engineered for no decimation)
+// This function calculates the whole rfft of an array.
 void vtkImageFourierFilter::ExecuteRfft(vtkImageComplex* in, vtkImageComplex* out, int N)
 {
-  this->ExecuteFftForwardBackward(in, out, N, -1);
+  vtkImageFourierFilterExecute(in, out, N, true);
 }
 
 //------------------------------------------------------------------------------
 // Called each axis over which the filter is executed.
-int vtkImageFourierFilter::RequestData(
+int vtkImageFourierFilter::IterativeRequestData(
   vtkInformation* request, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
 {
   // ensure that iteration axis is not split during threaded execution
@@ -240,5 +264,5 @@ int vtkImageFourierFilter::RequestData(
     }
   }
 
-  return this->Superclass::RequestData(request, inputVector, outputVector);
+  return this->Superclass::IterativeRequestData(request, inputVector, outputVector);
 }
@@ -93,15 +93,14 @@ public:
 
   /**
    * This function calculates the whole fft of an array.
-   * The contents of the input array are changed.
-   * (It is engineered for no decimation)
+   * It uses vtkFFT, which caches the plans of each length and stays
+   * O(N log N) for any N, including primes.
    */
   void ExecuteFft(vtkImageComplex* in, vtkImageComplex* out, int N);
 
   /**
-   * This function calculates the whole fft of an array.
-   * The contents of the input array are changed.
-   * (It is engineered for no decimation)
+   * This function calculates the whole reverse fft of an array, scaled by 1 / N.
+   * It uses vtkFFT like ExecuteFft.
    */
   void ExecuteRfft(vtkImageComplex* in, vtkImageComplex* out, int N);
 
@@ -109,15 +108,23 @@ protected:
   vtkImageFourierFilter() = default;
   ~vtkImageFourierFilter() override = default;
 
+  ///@{
+  /**
+   * The butterfly stages of the original fft, which is O(N^2) for prime N.
+   * They are no longer used by ExecuteFft and ExecuteRfft.
+   * The contents of the input array are changed.
+   */
   void ExecuteFftStep2(vtkImageComplex* p_in, vtkImageComplex* p_out, int N, int bsize, int fb);
   void ExecuteFftStepN(
     vtkImageComplex* p_in, vtkImageComplex* p_out, int N, int bsize, int n, int fb);
   void ExecuteFftForwardBackward(vtkImageComplex* in, vtkImageComplex* out, int N, int fb);
+  ///@}
 
   /**
-   * Override to change extent splitting rules.
+   * Override to change extent splitting rules, so that the axis of each
+   * iteration is not split.
    */
-  int RequestData(vtkInformation* request, vtkInformationVector** inputVector,
+  int IterativeRequestData(vtkInformation* request, vtkInformationVector** inputVector,
     vtkInformationVector* outputVector) override;
 
 private:
@@ -19,11 +19,11 @@
  * vtkImageRFFT implements the reverse fast Fourier transform.  The input
  * can have real or complex data in any components and data types, but
  * the output is always complex doubles with real values in component0, and
- * imaginary values in component1.  The filter is fastest for images that
- * have power of two sizes.  The filter uses butterfly filters for each
- * prime factor of the dimension.  This makes images with prime number dimensions
- * (i.e. 17x17) much slower to compute.  Multi dimensional (i.e volumes)
- * FFT's are decomposed so that each axis executes in series.
+ * imaginary values in component1.  Like vtkImageFFT, the filter transforms
+ * the lines along each axis in batches with vtkFFT, so that images of any
+ * size, including prime number dimensions (i.e. 17x17), are O(N log N).
+ * Multi dimensional (i.e volumes) FFT's are decomposed so that each axis
+ * executes in series.
  * In most cases the RFFT will produce an image whose imaginary values are all
  * zero's. In this case vtkImageExtractComponents can be used to remove
  * this imaginary components leaving only the real image.
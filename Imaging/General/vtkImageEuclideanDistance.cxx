@@ -14,13 +14,21 @@
 =========================================================================*/
 #include "vtkImageEuclideanDistance.h"
 
+#include "vtkIdTypeArray.h"
 #include "vtkImageData.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
+#include <algorithm>
 #include <cmath>
+#include <limits>
+#include <vector>
 
 vtkStandardNewMacro(vtkImageEuclideanDistance);
 
@@ -32,6 +40,9 @@ vtkImageEuclideanDistance::vtkImageEuclideanDistance()
   this->Initialize = 1;
   this->ConsiderAnisotropy = 1;
   this->Algorithm = VTK_EDT_SAITO;
+  this->OutputScalarType = VTK_DOUBLE;
+  this->SignedDistance = 0;
+  this->GenerateClosestFeatureIds = 0;
 }
 
 //------------------------------------------------------------------------------
@@ -39,7 +50,13 @@ vtkImageEuclideanDistance::vtkImageEuclideanDistance()
 int vtkImageEuclideanDistance::IterativeRequestInformation(
   vtkInformation* vtkNotUsed(input), vtkInformation* output)
 {
-  vtkDataObject::SetPointDataActiveScalarInfo(output, VTK_DOUBLE, 1);
+  // only the Felzenszwalb algorithm can produce floats
+  int scalarType = VTK_DOUBLE;
+  if (this->Algorithm == VTK_EDT_FELZENSZWALB && this->OutputScalarType == VTK_FLOAT)
+  {
+    scalarType = VTK_FLOAT;
+  }
+  vtkDataObject::SetPointDataActiveScalarInfo(output, scalarType, 1);
   return 1;
 }
 
@@ -611,6 +628,373 @@ static void vtkImageEuclideanDistanceExecuteSaitoCached(
   free(temp);
   free(sq);
 }
+
+//------------------------------------------------------------------------------
+// Execute the algorithm of Felzenszwalb and Huttenlocher.
+//
+// P.F. Felzenszwalb and D.P. Huttenlocher. Distance transforms of sampled
+// functions. Theory of Computing, 8(19). pp. 415--428, 2012.
+//
+// The first pass is the two-way scan of Saito's algorithm. The next passes
+// compute, for each line, the lower envelope of the parabolas rooted at
+// its voxels, which takes a time linear in the length of the line. All of
+// the passes are done in place in the output, and the closest feature ids,
+// if requested, are carried along with the distances.
+//
+namespace
+{
+// Number of adjacent lines that are transformed together along the y and
+// z axes, so that whole cache lines are read from the image.
+const int vtkEDTLineBatchSize = 16;
+
+// Line buffers of one thread
+struct vtkEDTLineBuffers
+{
+  std::vector<double> F;
+  std::vector<double> D;
+  std::vector<double> Z;
+  std::vector<int> V;
+  std::vector<vtkIdType> FIds;
+  std::vector<vtkIdType> DIds;
+};
+
+//------------------------------------------------------------------------------
+// Copy or initialize the input into the output. With "invert", the
+// non-zero voxels are the features instead of the zero voxels.
+template <class TIn, class TOut>
+void vtkImageEuclideanDistanceFelzenszwalbInitialize(vtkImageEuclideanDistance* self,
+  vtkImageData* inData, TIn* inPtr, const int dims[3], TOut* outPtr, bool invert)
+{
+  vtkIdType inInc[3];
+  inData->GetIncrements(inInc);
+
+  bool initialize = (self->GetInitialize() != 0 || self->GetSignedDistance() != 0);
+  TOut maxDist = static_cast<TOut>(self->GetMaximumDistance());
+  TOut zeroValue = (invert ? maxDist : 0);
+  TOut nonZeroValue = (invert ? 0 : maxDist);
+
+  vtkIdType numRows = static_cast<vtkIdType>(dims[1]) * dims[2];
+  vtkSMPTools::For(0, numRows, [&](vtkIdType firstRow, vtkIdType lastRow) {
+    for (vtkIdType row = firstRow; row < lastRow; ++row)
+    {
+      const TIn* inRow = inPtr + (row % dims[1]) * inInc[1] + (row / dims[1]) * inInc[2];
+      TOut* outRow = outPtr + row * dims[0];
+      for (int i = 0; i < dims[0]; ++i)
+      {
+        TIn value = inRow[i * inInc[0]];
+        if (initialize)
+        {
+          outRow[i] = (value == 0 ? zeroValue : nonZeroValue);
+        }
+        else
+        {
+          outRow[i] = static_cast<TOut>(value);
+        }
+      }
+    }
+  });
+}
+
+//------------------------------------------------------------------------------
+// First pass, along the x axis: the squared distance to the closest zero
+// voxel of each line, as in Saito's algorithm.
+template <class T>
+void vtkImageEuclideanDistanceFelzenszwalbScan(
+  T* outPtr, vtkIdType* ids, const int dims[3], double spacing2, double maxDist)
+{
+  int n = dims[0];
+  vtkIdType numRows = static_cast<vtkIdType>(dims[1]) * dims[2];
+  vtkSMPTools::For(0, numRows, [&](vtkIdType firstRow, vtkIdType lastRow) {
+    for (vtkIdType row = firstRow; row < lastRow; ++row)
+    {
+      T* line = outPtr + row * n;
+      vtkIdType lineId = row * n;
+      vtkIdType* lineIds = (ids ? ids + lineId : nullptr);
+      if (lineIds)
+      {
+        for (int i = 0; i < n; ++i)
+        {
+          lineIds[i] = (line[i] == 0 ? lineId + i : -1);
+        }
+      }
+
+      // forward scan
+      int df = n;
+      vtkIdType feature = -1;
+      for (int i = 0; i < n; ++i)
+      {
+        if (line[i] != 0)
+        {
+          df++;
+          double sq = (df <= n ? df * df * spacing2 : maxDist);
+          if (sq < line[i])
+          {
+            line[i] = static_cast<T>(sq);
+            if (lineIds)
+            {
+              lineIds[i] = feature;
+            }
+          }
+        }
+        else
+        {
+          df = 0;
+          feature = lineId + i;
+        }
+      }
+
+      // backward scan
+      df = n;
+      feature = -1;
+      for (int i = n - 1; i >= 0; --i)
+      {
+        if (line[i] != 0)
+        {
+          df++;
+          double sq = (df <= n ? df * df * spacing2 : maxDist);
+          if (sq < line[i])
+          {
+            line[i] = static_cast<T>(sq);
+            if (lineIds)
+            {
+              lineIds[i] = feature;
+            }
+          }
+        }
+        else
+        {
+          df = 0;
+          feature = lineId + i;
+        }
+      }
+    }
+  });
+}
+
+//------------------------------------------------------------------------------
+// Compute d[q] = min(f[p] + (q - p)^2 * spacing2) over a line of length n,
+// from the lower envelope of the parabolas rooted at each p. The indices of
+// the parabolas of the envelope are stored in v, and the boundaries between
+// them in z, which must have room for n and n + 1 values.
+void vtkImageEuclideanDistanceLowerEnvelope(const double* f, const vtkIdType* fIds, int n,
+  double spacing2, int* v, double* z, double* d, vtkIdType* dIds)
+{
+  // the parabolas rooted at q and p intersect at (h[q] - h[p]) / 2(q - p),
+  // and d holds h until the distances are computed
+  double* h = d;
+  for (int q = 0; q < n; ++q)
+  {
+    h[q] = f[q] / spacing2 + static_cast<double>(q) * q;
+  }
+  auto intersect = [h](int q, int p) { return (h[q] - h[p]) / (2.0 * (q - p)); };
+
+  int k = 0;
+  v[0] = 0;
+  z[0] = -std::numeric_limits<double>::infinity();
+  z[1] = std::numeric_limits<double>::infinity();
+  for (int q = 1; q < n; ++q)
+  {
+    double s = intersect(q, v[k]);
+    while (s <= z[k] && k > 0)
+    {
+      --k;
+      s = intersect(q, v[k]);
+    }
+    ++k;
+    v[k] = q;
+    z[k] = s;
+    z[k + 1] = std::numeric_limits<double>::infinity();
+  }
+
+  k = 0;
+  for (int q = 0; q < n; ++q)
+  {
+    while (z[k + 1] < q)
+    {
+      ++k;
+    }
+    int p = v[k];
+    int dq = q - p;
+    double value = f[p] + dq * dq * spacing2;
+    // a distance never increases, not even by a rounding error
+    if (value < f[q])
+    {
+      d[q] = value;
+      if (dIds)
+      {
+        dIds[q] = fIds[p];
+      }
+    }
+    else
+    {
+      d[q] = f[q];
+      if (dIds)
+      {
+        dIds[q] = fIds[q];
+      }
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+// Next passes, along the y or z axis: the lower envelope of each line.
+template <class T>
+void vtkImageEuclideanDistanceFelzenszwalbPass(
+  T* outPtr, vtkIdType* ids, const int dims[3], int axis, double spacing2)
+{
+  const vtkIdType inc[3] = { 1, dims[0], static_cast<vtkIdType>(dims[0]) * dims[1] };
+
+  // the lines are batched along axis u, if it is the x axis, and then
+  // iterated along axis w
+  int u = (axis == 0 ? 1 : 0);
+  int w = 3 - axis - u;
+  int batchSize = (u == 0 ? vtkEDTLineBatchSize : 1);
+  int n = dims[axis];
+  vtkIdType numBatches = (dims[u] + batchSize - 1) / batchSize;
+
+  vtkSMPThreadLocal<vtkEDTLineBuffers> localBuffers;
+  vtkSMPTools::For(0, numBatches * dims[w], [&](vtkIdType first, vtkIdType last) {
+    vtkEDTLineBuffers& buffers = localBuffers.Local();
+    size_t bufferSize = static_cast<size_t>(n) * batchSize;
+    buffers.F.resize(bufferSize);
+    buffers.D.resize(bufferSize);
+    buffers.Z.resize(n + 1);
+    buffers.V.resize(n);
+    if (ids)
+    {
+      buffers.FIds.resize(bufferSize);
+      buffers.DIds.resize(bufferSize);
+    }
+
+    for (vtkIdType batch = first; batch < last; ++batch)
+    {
+      int u0 = static_cast<int>(batch % numBatches) * batchSize;
+      int count = std::min(batchSize, dims[u] - u0);
+      vtkIdType offset = u0 * inc[u] + (batch / numBatches) * inc[w];
+
+      // gather the lines into contiguous buffers
+      for (int i = 0; i < n; ++i)
+      {
+        vtkIdType idx = offset + i * inc[axis];
+        for (int b = 0; b < count; ++b)
+        {
+          buffers.F[b * n + i] = outPtr[idx + b * inc[u]];
+        }
+        if (ids)
+        {
+          for (int b = 0; b < count; ++b)
+          {
+            buffers.FIds[b * n + i] = ids[idx + b * inc[u]];
+          }
+        }
+      }
+
+      for (int b = 0; b < count; ++b)
+      {
+        vtkImageEuclideanDistanceLowerEnvelope(&buffers.F[b * n],
+          (ids ? &buffers.FIds[b * n] : nullptr), n, spacing2, buffers.V.data(), buffers.Z.data(),
+          &buffers.D[b * n], (ids ? &buffers.DIds[b * n] : nullptr));
+      }
+
+      // scatter the results back into the image
+      for (int i = 0; i < n; ++i)
+      {
+        vtkIdType idx = offset + i * inc[axis];
+        for (int b = 0; b < count; ++b)
+        {
+          outPtr[idx + b * inc[u]] = static_cast<T>(buffers.D[b * n + i]);
+        }
+        if (ids)
+        {
+          for (int b = 0; b < count; ++b)
+          {
+            ids[idx + b * inc[u]] = buffers.DIds[b * n + i];
+          }
+        }
+      }
+    }
+  });
+}
+
+//------------------------------------------------------------------------------
+// Transform the output in place, one axis per pass, and report the
+// progress from progressStart to progressEnd
+template <class T>
+void vtkImageEuclideanDistanceFelzenszwalbTransform(vtkImageEuclideanDistance* self,
+  vtkImageData* outData, T* outPtr, vtkIdType* ids, double progressStart, double progressEnd)
+{
+  int dims[3];
+  outData->GetDimensions(dims);
+  double* spacing = outData->GetSpacing();
+  double maxDist = self->GetMaximumDistance();
+
+  int numPasses = self->GetNumberOfIterations();
+  for (int axis = 0; axis < numPasses; ++axis)
+  {
+    double spacing2 = 1.0;
+    if (self->GetConsiderAnisotropy())
+    {
+      spacing2 = spacing[axis] * spacing[axis];
+    }
+
+    if (axis == 0)
+    {
+      vtkImageEuclideanDistanceFelzenszwalbScan(outPtr, ids, dims, spacing2, maxDist);
+    }
+    else
+    {
+      vtkImageEuclideanDistanceFelzenszwalbPass(outPtr, ids, dims, axis, spacing2);
+    }
+
+    self->UpdateProgress(progressStart + (progressEnd - progressStart) * (axis + 1.0) / numPasses);
+  }
+}
+
+//------------------------------------------------------------------------------
+// This templated execute method handles any type input, and float or
+// double output.
+template <class TIn, class TOut>
+void vtkImageEuclideanDistanceExecuteFelzenszwalb(vtkImageEuclideanDistance* self,
+  vtkImageData* inData, TIn* inPtr, vtkImageData* outData, TOut* outPtr, vtkIdType* ids)
+{
+  int dims[3];
+  outData->GetDimensions(dims);
+  vtkIdType numPoints = outData->GetNumberOfPoints();
+
+  bool signedDistance = (self->GetSignedDistance() != 0);
+
+  vtkImageEuclideanDistanceFelzenszwalbInitialize(self, inData, inPtr, dims, outPtr, false);
+  vtkImageEuclideanDistanceFelzenszwalbTransform(
+    self, outData, outPtr, ids, 0.0, (signedDistance ? 0.5 : 1.0));
+
+  if (signedDistance)
+  {
+    // the distances of the zero voxels to the non-zero voxels
+    std::vector<TOut> inverse(numPoints);
+    std::vector<vtkIdType> inverseIds(ids ? numPoints : 0);
+    vtkImageEuclideanDistanceFelzenszwalbInitialize(
+      self, inData, inPtr, dims, inverse.data(), true);
+    vtkImageEuclideanDistanceFelzenszwalbTransform(
+      self, outData, inverse.data(), (ids ? inverseIds.data() : nullptr), 0.5, 1.0);
+
+    // only the zero voxels have a zero distance to the zero voxels
+    vtkSMPTools::For(0, numPoints, [&](vtkIdType first, vtkIdType last) {
+      for (vtkIdType i = first; i < last; ++i)
+      {
+        if (outPtr[i] == 0)
+        {
+          outPtr[i] = -inverse[i];
+          if (ids)
+          {
+            ids[i] = inverseIds[i];
+          }
+        }
+      }
+    });
+  }
+}
+} // end anonymous namespace
+
 //------------------------------------------------------------------------------
 void vtkImageEuclideanDistance::AllocateOutputScalars(
   vtkImageData* outData, int outExt[6], vtkInformation* outInfo)
@@ -714,6 +1098,81 @@ int vtkImageEuclideanDistance::IterativeRequestData(vtkInformation* vtkNotUsed(r
   return 1;
 }
 
+//------------------------------------------------------------------------------
+// The Felzenszwalb algorithm transforms the output in place, so it skips
+// the intermediate images of the superclass.
+int vtkImageEuclideanDistance::RequestData(
+  vtkInformation* request, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
+  if (this->Algorithm != VTK_EDT_FELZENSZWALB)
+  {
+    return this->Superclass::RequestData(request, inputVector, outputVector);
+  }
+
+  vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
+  vtkImageData* inData = vtkImageData::SafeDownCast(inInfo->Get(vtkDataObject::DATA_OBJECT()));
+  vtkInformation* outInfo = outputVector->GetInformationObject(0);
+  vtkImageData* outData = vtkImageData::SafeDownCast(outInfo->Get(vtkDataObject::DATA_OBJECT()));
+
+  int outExt[6];
+  outInfo->Get(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(), outExt);
+  this->AllocateOutputScalars(outData, outExt, outInfo);
+
+  vtkDebugMacro(<< "Executing image euclidean distance");
+
+  void* inPtr = inData->GetScalarPointerForExtent(
+    inInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT()));
+  void* outPtr = outData->GetScalarPointer();
+
+  if (!inPtr)
+  {
+    vtkErrorMacro(<< "Execute: No scalars for update extent.");
+    return 1;
+  }
+
+  // this filter expects input to have 1 components
+  if (outData->GetNumberOfScalarComponents() != 1)
+  {
+    vtkErrorMacro(<< "Execute: Cannot handle more than 1 components");
+    return 1;
+  }
+
+  vtkIdType* ids = nullptr;
+  if (this->GenerateClosestFeatureIds)
+  {
+    vtkNew<vtkIdTypeArray> idArray;
+    idArray->SetName("ClosestFeatureIds");
+    idArray->SetNumberOfValues(outData->GetNumberOfPoints());
+    outData->GetPointData()->AddArray(idArray);
+    ids = idArray->GetPointer(0);
+  }
+
+  if (outData->GetScalarType() == VTK_FLOAT)
+  {
+    switch (inData->GetScalarType())
+    {
+      vtkTemplateMacro(vtkImageEuclideanDistanceExecuteFelzenszwalb(
+        this, inData, static_cast<VTK_TT*>(inPtr), outData, static_cast<float*>(outPtr), ids));
+      default:
+        vtkErrorMacro(<< "Execute: Unknown ScalarType");
+        return 1;
+    }
+  }
+  else
+  {
+    switch (inData->GetScalarType())
+    {
+      vtkTemplateMacro(vtkImageEuclideanDistanceExecuteFelzenszwalb(
+        this, inData, static_cast<VTK_TT*>(inPtr), outData, static_cast<double*>(outPtr), ids));
+      default:
+        vtkErrorMacro(<< "Execute: Unknown ScalarType");
+        return 1;
+    }
+  }
+
+  return 1;
+}
+
 //------------------------------------------------------------------------------
 void vtkImageEuclideanDistance::PrintSelf(ostream& os, vtkIndent indent)
 {
@@ -731,8 +1190,18 @@ void vtkImageEuclideanDistance::PrintSelf(ostream& os, vtkIndent indent)
   {
     os << "Saito\n";
   }
-  else
+  else if (this->Algorithm == VTK_EDT_SAITO_CACHED)
   {
     os << "Saito Cached\n";
   }
+  else
+  {
+    os << "Felzenszwalb\n";
+  }
+
+  os << indent << "Output Scalar Type: " << vtkImageScalarTypeNameMacro(this->OutputScalarType)
+     << "\n";
+  os << indent << "Signed Distance: " << (this->SignedDistance ? "On\n" : "Off\n");
+  os << indent << "Generate Closest Feature Ids: "
+     << (this->GenerateClosestFeatureIds ? "On\n" : "Off\n");
 }
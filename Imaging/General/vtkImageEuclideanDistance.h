@@ -16,14 +16,21 @@
  * @class   vtkImageEuclideanDistance
  * @brief   computes 3D Euclidean DT
  *
- * vtkImageEuclideanDistance implements the Euclidean DT using
- * Saito's algorithm. The distance map produced contains the square of the
- * Euclidean distance values.
+ * vtkImageEuclideanDistance implements the exact Euclidean DT. The distance
+ * map produced contains the square of the Euclidean distance values.
  *
- * The algorithm has a o(n^(D+1)) complexity over nxnx...xn images in D
- * dimensions. It is very efficient on relatively small images. Cuisenaire's
- * algorithms should be used instead if n >> 500. These are not implemented
- * yet.
+ * By default, Saito's algorithm is used. It has a o(n^(D+1)) complexity over
+ * nxnx...xn images in D dimensions, and is very efficient on relatively
+ * small images.
+ *
+ * The lower envelope of parabolas algorithm of Felzenszwalb and Huttenlocher
+ * is selected with SetAlgorithmToFelzenszwalb(). It has a o(n^D) complexity,
+ * i.e. it is linear in the number of voxels, and should be preferred for
+ * large images. Each pass transforms the lines along one axis in parallel
+ * with vtkSMPTools, in place in the output, so that no intermediate images
+ * are stored. This algorithm can also produce a signed distance map of a
+ * binary mask, as well as the ids of the closest feature voxels, and its
+ * output can be float or double.
  *
  * For the special case of images where the slice-size is a multiple of
  * 2^N with a large N (typically for 256x256 slices), Saito's algorithm
@@ -33,6 +40,9 @@
  *
  * References:
  *
+ * P.F. Felzenszwalb and D.P. Huttenlocher. Distance transforms of sampled
+ * functions. Theory of Computing, 8(19). pp. 415--428, 2012.
+ *
  * T. Saito and J.I. Toriwaki. New algorithms for Euclidean distance
  * transformations of an n-dimensional digitised picture with applications.
  * Pattern Recognition, 27(11). pp. 1551--1565, 1994.
@@ -50,6 +60,7 @@
 
 #define VTK_EDT_SAITO_CACHED 0
 #define VTK_EDT_SAITO 1
+#define VTK_EDT_FELZENSZWALB 2
 
 class VTKIMAGINGGENERAL_EXPORT vtkImageEuclideanDistance : public vtkImageDecomposeFilter
 {
@@ -92,14 +103,53 @@ public:
   ///@{
   /**
    * Selects a Euclidean DT algorithm.
-   * 1. Saito
+   * 1. Saito (the default)
    * 2. Saito-cached
-   * More algorithms will be added later on.
+   * 3. Felzenszwalb
    */
   vtkSetMacro(Algorithm, int);
   vtkGetMacro(Algorithm, int);
   void SetAlgorithmToSaito() { this->SetAlgorithm(VTK_EDT_SAITO); }
   void SetAlgorithmToSaitoCached() { this->SetAlgorithm(VTK_EDT_SAITO_CACHED); }
+  void SetAlgorithmToFelzenszwalb() { this->SetAlgorithm(VTK_EDT_FELZENSZWALB); }
+  ///@}
+
+  ///@{
+  /**
+   * Set the scalar type of the output, VTK_FLOAT or VTK_DOUBLE. The default
+   * is VTK_DOUBLE. Float output is only supported by the Felzenszwalb
+   * algorithm, the Saito algorithms always produce doubles.
+   */
+  vtkSetMacro(OutputScalarType, int);
+  vtkGetMacro(OutputScalarType, int);
+  void SetOutputScalarTypeToFloat() { this->SetOutputScalarType(VTK_FLOAT); }
+  void SetOutputScalarTypeToDouble() { this->SetOutputScalarType(VTK_DOUBLE); }
+  ///@}
+
+  ///@{
+  /**
+   * Compute a signed distance map, using the input as a binary mask. The
+   * non-zero voxels get the square of their distance to the closest zero
+   * voxel, and the zero voxels get the negated square of their distance to
+   * the closest non-zero voxel. Initialize is ignored when this is on.
+   * Only supported by the Felzenszwalb algorithm. Off by default.
+   */
+  vtkSetMacro(SignedDistance, vtkTypeBool);
+  vtkGetMacro(SignedDistance, vtkTypeBool);
+  vtkBooleanMacro(SignedDistance, vtkTypeBool);
+  ///@}
+
+  ///@{
+  /**
+   * Add a "ClosestFeatureIds" array to the output point data, with the id
+   * of the closest feature voxel of each voxel: the closest zero voxel, or
+   * for the zero voxels of a signed distance map, the closest non-zero
+   * voxel. The id is -1 where no feature is closer than MaximumDistance.
+   * Only supported by the Felzenszwalb algorithm. Off by default.
+   */
+  vtkSetMacro(GenerateClosestFeatureIds, vtkTypeBool);
+  vtkGetMacro(GenerateClosestFeatureIds, vtkTypeBool);
+  vtkBooleanMacro(GenerateClosestFeatureIds, vtkTypeBool);
   ///@}
 
   int IterativeRequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
@@ -112,6 +162,9 @@ protected:
   vtkTypeBool Initialize;
   vtkTypeBool ConsiderAnisotropy;
   int Algorithm;
+  int OutputScalarType;
+  vtkTypeBool SignedDistance;
+  vtkTypeBool GenerateClosestFeatureIds;
 
   // Replaces "EnlargeOutputUpdateExtent"
   virtual void AllocateOutputScalars(vtkImageData* outData, int outExt[6], vtkInformation* outInfo);
@@ -119,6 +172,9 @@ protected:
   int IterativeRequestInformation(vtkInformation* in, vtkInformation* out) override;
   int IterativeRequestUpdateExtent(vtkInformation* in, vtkInformation* out) override;
 
+  // The Felzenszwalb algorithm does all of the iterations in the output
+  int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
+
 private:
   vtkImageEuclideanDistance(const vtkImageEuclideanDistance&) = delete;
   void operator=(const vtkImageEuclideanDistance&) = delete;
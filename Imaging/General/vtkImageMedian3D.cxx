@@ -24,6 +24,8 @@
 #include "vtkStreamingDemandDrivenPipeline.h"
 
 #include <algorithm> // for std::nth_element
+#include <limits>    // for std::numeric_limits
+#include <vector>    // for std::vector
 
 vtkStandardNewMacro(vtkImageMedian3D);
 
@@ -32,6 +34,7 @@ vtkStandardNewMacro(vtkImageMedian3D);
 vtkImageMedian3D::vtkImageMedian3D()
 {
   this->NumberOfElements = 0;
+  this->Percentile = 50.0;
   this->SetKernelSize(1, 1, 1);
   this->HandleBoundaries = 1;
 }
@@ -45,6 +48,7 @@ void vtkImageMedian3D::PrintSelf(ostream& os, vtkIndent indent)
   this->Superclass::PrintSelf(os, indent);
 
   os << indent << "NumberOfElements: " << this->NumberOfElements << endl;
+  os << indent << "Percentile: " << this->Percentile << endl;
 }
 
 //------------------------------------------------------------------------------
@@ -82,17 +86,41 @@ void vtkImageMedian3D::SetKernelSize(int size0, int size1, int size2)
 namespace
 {
 
+// The largest number of histogram bins for the sliding-histogram method
+const int vtkMedian3DMaxBins = 4096;
+
+//------------------------------------------------------------------------------
+// Get the indices of the sorted values that are used to compute the given
+// percentile of n values.  For the median of an even number of values,
+// these are the two middle values, otherwise they are the same.
+void vtkComputeRanks(vtkIdType n, double percentile, vtkIdType& r0, vtkIdType& r1)
+{
+  if (percentile == 50.0)
+  {
+    r1 = n / 2;
+    r0 = ((n % 2 == 0) ? r1 - 1 : r1);
+  }
+  else
+  {
+    r1 = static_cast<vtkIdType>(percentile * 0.01 * (n - 1) + 0.5);
+    r0 = r1;
+  }
+}
+
 //------------------------------------------------------------------------------
-// Compute the median with std::nth_element
+// Compute the percentile with std::nth_element
 template <class T>
-T vtkComputeMedianOfArray(T* aBegin, T* aEnd)
+T vtkComputePercentileOfArray(T* aBegin, T* aEnd, double percentile)
 {
-  T* aMid = aBegin + (aEnd - aBegin) / 2;
+  vtkIdType r0, r1;
+  vtkComputeRanks(aEnd - aBegin, percentile, r0, r1);
+  T* aMid = aBegin + r1;
   std::nth_element(aBegin, aMid, aEnd);
   T m = *aMid;
 
-  // if even size, get max of lower part of array and compute the average
-  if (aMid - aBegin == aEnd - aMid)
+  // for the median of an even size, get max of lower part of array and
+  // compute the average
+  if (r0 != r1)
   {
     T* lowMid = std::max_element(aBegin, aMid);
     m = *lowMid + (m - *lowMid) / 2;
@@ -101,6 +129,355 @@ T vtkComputeMedianOfArray(T* aBegin, T* aEnd)
   return m;
 }
 
+//------------------------------------------------------------------------------
+// Sliding histograms for integer data with a small range of values.  Each
+// column of the neighborhood (all voxels with the same x index) has its
+// own histogram, which is updated when the neighborhood moves to the next
+// row.  Along the row, the neighborhood histogram is updated by adding the
+// column that enters it and subtracting the column that leaves it.  The
+// histograms are split into coarse and fine levels: the coarse level of
+// the neighborhood histogram is always up to date, while each group of
+// fine bins is only updated when it is searched for a percentile.
+template <class T>
+class vtkImageMedian3DHistogram
+{
+public:
+  vtkImageMedian3DHistogram(const T* inPtr, const int inExt[6], const vtkIdType inInc[3],
+    const int kernelSize[3], const int kernelMiddle[3], const int outExt[6])
+  {
+    this->InPtr = inPtr;
+    for (int i = 0; i < 3; i++)
+    {
+      this->InInc[i] = inInc[i];
+      this->InExt[2 * i] = inExt[2 * i];
+      this->InExt[2 * i + 1] = inExt[2 * i + 1];
+      this->KernelSize[i] = kernelSize[i];
+      this->KernelMiddle[i] = kernelMiddle[i];
+      // the input region that is needed for the output extent
+      this->Region[2 * i] = this->HoodMin(i, outExt[2 * i]);
+      this->Region[2 * i + 1] = this->HoodMax(i, outExt[2 * i + 1]);
+    }
+    this->NumberOfColumns = this->Region[1] - this->Region[0] + 1;
+    this->Shift = 0;
+    this->Minimum = 0;
+  }
+
+  // Check the range of the values, and allocate the histograms.  Returns
+  // false if the histograms would be too large.
+  bool Allocate()
+  {
+    // column counts must fit in 16 bits
+    if (static_cast<vtkIdType>(this->KernelSize[1]) * this->KernelSize[2] >
+      VTK_UNSIGNED_SHORT_MAX)
+    {
+      return false;
+    }
+
+    // find the range of the values in the input region
+    const int* r = this->Region;
+    T minVal = this->InPtr[this->Offset(r[0], r[2], r[4])];
+    T maxVal = minVal;
+    for (int idx2 = r[4]; idx2 <= r[5]; idx2++)
+    {
+      for (int idx1 = r[2]; idx1 <= r[3]; idx1++)
+      {
+        const T* ptr = this->InPtr + this->Offset(r[0], idx1, idx2);
+        for (int idx0 = r[0]; idx0 <= r[1]; idx0++)
+        {
+          minVal = (*ptr < minVal ? *ptr : minVal);
+          maxVal = (*ptr > maxVal ? *ptr : maxVal);
+          ptr += this->InInc[0];
+        }
+      }
+    }
+    if (static_cast<double>(maxVal) - static_cast<double>(minVal) >= vtkMedian3DMaxBins)
+    {
+      return false;
+    }
+
+    // use about the same number of coarse and fine bins
+    int numBins = static_cast<int>(maxVal - minVal) + 1;
+    this->Shift = 0;
+    while ((1 << (2 * this->Shift)) < numBins)
+    {
+      this->Shift++;
+    }
+    this->NumberOfCoarseBins = ((numBins - 1) >> this->Shift) + 1;
+    this->NumberOfFineBins = (this->NumberOfCoarseBins << this->Shift);
+    this->Minimum = minVal;
+
+    this->ColumnCoarse.resize(
+      static_cast<size_t>(this->NumberOfColumns) * this->NumberOfCoarseBins);
+    this->ColumnFine.resize(static_cast<size_t>(this->NumberOfColumns) * this->NumberOfFineBins);
+    this->Coarse.resize(this->NumberOfCoarseBins);
+    this->Fine.resize(this->NumberOfFineBins);
+    this->SyncMin.resize(this->NumberOfCoarseBins);
+    this->SyncMax.resize(this->NumberOfCoarseBins);
+
+    return true;
+  }
+
+  // Compute the percentile for the output extent
+  void Execute(vtkImageMedian3D* self, T* outPtr, const vtkIdType outInc[3], const int outExt[6],
+    int id, unsigned long& count, unsigned long target)
+  {
+    double percentile = self->GetPercentile();
+    for (int outIdx2 = outExt[4]; outIdx2 <= outExt[5]; ++outIdx2)
+    {
+      int hoodMin2 = this->HoodMin(2, outIdx2);
+      int hoodMax2 = this->HoodMax(2, outIdx2);
+      int hoodMin1 = this->HoodMin(1, outExt[2]);
+      int hoodMax1 = this->HoodMax(1, outExt[2]);
+
+      // fill the column histograms for the first row of the slice
+      std::fill(this->ColumnCoarse.begin(), this->ColumnCoarse.end(), 0);
+      std::fill(this->ColumnFine.begin(), this->ColumnFine.end(), 0);
+      for (int hoodIdx1 = hoodMin1; hoodIdx1 <= hoodMax1; ++hoodIdx1)
+      {
+        this->UpdateColumns(hoodIdx1, hoodMin2, hoodMax2, 1);
+      }
+
+      T* outPtr1 = outPtr + (outIdx2 - outExt[4]) * outInc[2];
+      for (int outIdx1 = outExt[2]; !self->AbortExecute && outIdx1 <= outExt[3]; ++outIdx1)
+      {
+        if (!id)
+        {
+          if (!(count % target))
+          {
+            self->UpdateProgress(count / (50.0 * target));
+          }
+          count++;
+        }
+
+        // move the column histograms to this row
+        int newMin1 = this->HoodMin(1, outIdx1);
+        int newMax1 = this->HoodMax(1, outIdx1);
+        for (; hoodMin1 < newMin1; ++hoodMin1)
+        {
+          this->UpdateColumns(hoodMin1, hoodMin2, hoodMax2, -1);
+        }
+        for (; hoodMax1 < newMax1; ++hoodMax1)
+        {
+          this->UpdateColumns(hoodMax1 + 1, hoodMin2, hoodMax2, 1);
+        }
+
+        vtkIdType columnSize = static_cast<vtkIdType>(hoodMax1 - hoodMin1 + 1);
+        columnSize *= (hoodMax2 - hoodMin2 + 1);
+        this->ExecuteRow(outPtr1, outInc[0], outExt, columnSize, percentile);
+        outPtr1 += outInc[1];
+      }
+    }
+  }
+
+private:
+  // The clipped neighborhood of an output index along an axis
+  int HoodMin(int axis, int idx) const
+  {
+    int hoodMin = idx - this->KernelMiddle[axis];
+    return (hoodMin > this->InExt[2 * axis] ? hoodMin : this->InExt[2 * axis]);
+  }
+
+  int HoodMax(int axis, int idx) const
+  {
+    int hoodMax = idx - this->KernelMiddle[axis] + this->KernelSize[axis] - 1;
+    return (hoodMax < this->InExt[2 * axis + 1] ? hoodMax : this->InExt[2 * axis + 1]);
+  }
+
+  vtkIdType Offset(int idx0, int idx1, int idx2) const
+  {
+    return (idx0 - this->InExt[0]) * this->InInc[0] + (idx1 - this->InExt[2]) * this->InInc[1] +
+      (idx2 - this->InExt[4]) * this->InInc[2];
+  }
+
+  // Add (or remove, if inc is -1) the voxels of row idx1 in the slices
+  // from idx2Min to idx2Max to the column histograms
+  void UpdateColumns(int idx1, int idx2Min, int idx2Max, int inc)
+  {
+    int shift = this->Shift;
+    for (int idx2 = idx2Min; idx2 <= idx2Max; idx2++)
+    {
+      const T* ptr = this->InPtr + this->Offset(this->Region[0], idx1, idx2);
+      vtkTypeUInt16* coarse = this->ColumnCoarse.data();
+      vtkTypeUInt16* fine = this->ColumnFine.data();
+      for (int c = 0; c < this->NumberOfColumns; c++)
+      {
+        int bin = static_cast<int>(*ptr - this->Minimum);
+        coarse[bin >> shift] += inc;
+        fine[bin] += inc;
+        coarse += this->NumberOfCoarseBins;
+        fine += this->NumberOfFineBins;
+        ptr += this->InInc[0];
+      }
+    }
+  }
+
+  // Add (or remove, if inc is -1) a column to the coarse neighborhood
+  // histogram
+  void UpdateCoarse(int idx0, int inc)
+  {
+    int n = this->NumberOfCoarseBins;
+    const vtkTypeUInt16* column =
+      this->ColumnCoarse.data() + static_cast<size_t>(idx0 - this->Region[0]) * n;
+    int* coarse = this->Coarse.data();
+    for (int i = 0; i < n; i++)
+    {
+      coarse[i] += inc * column[i];
+    }
+  }
+
+  // Add (or remove, if inc is -1) one group of fine bins of the columns
+  // from idx0Min to idx0Max to the neighborhood histogram
+  void UpdateFine(int group, int idx0Min, int idx0Max, int inc)
+  {
+    int n = (1 << this->Shift);
+    int* fine = this->Fine.data() + group * n;
+    const vtkTypeUInt16* column = this->ColumnFine.data() +
+      static_cast<size_t>(idx0Min - this->Region[0]) * this->NumberOfFineBins + group * n;
+    for (int idx0 = idx0Min; idx0 <= idx0Max; idx0++)
+    {
+      for (int i = 0; i < n; i++)
+      {
+        fine[i] += inc * column[i];
+      }
+      column += this->NumberOfFineBins;
+    }
+  }
+
+  // Find the value with the given index among the sorted values of the
+  // neighborhood from hoodMin0 to hoodMax0
+  T FindValue(vtkIdType rank, int hoodMin0, int hoodMax0)
+  {
+    // find the coarse bin
+    const int* coarse = this->Coarse.data();
+    int group = 0;
+    vtkIdType sum = 0;
+    while (sum + coarse[group] <= rank)
+    {
+      sum += coarse[group++];
+    }
+
+    // bring the fine bins of the group up to date, either by adding and
+    // removing the columns that have entered and left the neighborhood
+    // since it was last updated, or by summing all of the columns
+    int syncMin = this->SyncMin[group];
+    int syncMax = this->SyncMax[group];
+    if (syncMin <= syncMax && (hoodMin0 - syncMin) + (hoodMax0 - syncMax) <= hoodMax0 - hoodMin0)
+    {
+      this->UpdateFine(group, syncMin, hoodMin0 - 1, -1);
+      this->UpdateFine(group, syncMax + 1, hoodMax0, 1);
+    }
+    else
+    {
+      int n = (1 << this->Shift);
+      std::fill(this->Fine.begin() + group * n, this->Fine.begin() + (group + 1) * n, 0);
+      this->UpdateFine(group, hoodMin0, hoodMax0, 1);
+    }
+    this->SyncMin[group] = hoodMin0;
+    this->SyncMax[group] = hoodMax0;
+
+    // find the fine bin
+    const int* fine = this->Fine.data();
+    int bin = (group << this->Shift);
+    while (sum + fine[bin] <= rank)
+    {
+      sum += fine[bin++];
+    }
+
+    return static_cast<T>(this->Minimum + bin);
+  }
+
+  // Compute the percentile for one row
+  void ExecuteRow(
+    T* outPtr, vtkIdType outInc0, const int outExt[6], vtkIdType columnSize, double percentile)
+  {
+    // no groups of fine bins are up to date at the start of the row
+    std::fill(this->Coarse.begin(), this->Coarse.end(), 0);
+    std::fill(this->SyncMin.begin(), this->SyncMin.end(), 1);
+    std::fill(this->SyncMax.begin(), this->SyncMax.end(), 0);
+
+    int hoodMin0 = this->HoodMin(0, outExt[0]);
+    int hoodMax0 = this->HoodMax(0, outExt[0]);
+    for (int idx0 = hoodMin0; idx0 <= hoodMax0; idx0++)
+    {
+      this->UpdateCoarse(idx0, 1);
+    }
+
+    for (int outIdx0 = outExt[0]; outIdx0 <= outExt[1]; ++outIdx0)
+    {
+      int newMin0 = this->HoodMin(0, outIdx0);
+      int newMax0 = this->HoodMax(0, outIdx0);
+      for (; hoodMin0 < newMin0; ++hoodMin0)
+      {
+        this->UpdateCoarse(hoodMin0, -1);
+      }
+      for (; hoodMax0 < newMax0; ++hoodMax0)
+      {
+        this->UpdateCoarse(hoodMax0 + 1, 1);
+      }
+
+      vtkIdType r0, r1;
+      vtkComputeRanks(columnSize * (hoodMax0 - hoodMin0 + 1), percentile, r0, r1);
+      T m = this->FindValue(r1, hoodMin0, hoodMax0);
+      if (r0 != r1)
+      {
+        T lowMid = this->FindValue(r0, hoodMin0, hoodMax0);
+        m = lowMid + (m - lowMid) / 2;
+      }
+
+      *outPtr = m;
+      outPtr += outInc0;
+    }
+  }
+
+  const T* InPtr;
+  vtkIdType InInc[3];
+  int InExt[6];
+  int KernelSize[3];
+  int KernelMiddle[3];
+  int Region[6];
+  int NumberOfColumns;
+  int NumberOfCoarseBins;
+  int NumberOfFineBins;
+  int Shift;
+  T Minimum;
+
+  std::vector<vtkTypeUInt16> ColumnCoarse;
+  std::vector<vtkTypeUInt16> ColumnFine;
+  std::vector<int> Coarse;
+  std::vector<int> Fine;
+  std::vector<int> SyncMin;
+  std::vector<int> SyncMax;
+};
+
+//------------------------------------------------------------------------------
+// Use the sliding histograms for integer types, if the range of the values
+// is small enough.  Returns false if the histograms were not used.
+template <class T>
+bool vtkImageMedian3DHistogramExecute(vtkImageMedian3D* self, const T* inPtr, const int inExt[6],
+  const vtkIdType inInc[3], T* outPtr, const vtkIdType outInc[3], const int outExt[6],
+  int numComp, int id, unsigned long target)
+{
+  if (!std::numeric_limits<T>::is_integer)
+  {
+    return false;
+  }
+
+  unsigned long count = 0;
+  for (int c = 0; c < numComp; c++)
+  {
+    vtkImageMedian3DHistogram<T> histogram(
+      inPtr + c, inExt, inInc, self->GetKernelSize(), self->GetKernelMiddle(), outExt);
+    if (!histogram.Allocate())
+    {
+      // the components that were already done will simply be redone
+      return false;
+    }
+    histogram.Execute(self, outPtr + c, outInc, outExt, id, count, target);
+  }
+
+  return true;
+}
+
 } // end anonymous namespace
 
 //------------------------------------------------------------------------------
@@ -134,9 +511,6 @@ void vtkImageMedian3DExecute(vtkImageMedian3D* self, vtkImageData* inData, T* in
     return;
   }
 
-  // Array used to compute the median
-  T* workArray = new T[self->GetNumberOfElements()];
-
   // Get information to march through data
   inData->GetIncrements(inInc0, inInc1, inInc2);
   outData->GetContinuousIncrements(outExt, outIncX, outIncY, outIncZ);
@@ -179,6 +553,20 @@ void vtkImageMedian3DExecute(vtkImageMedian3D* self, vtkImageData* inData, T* in
     static_cast<unsigned long>((outExt[5] - outExt[4] + 1) * (outExt[3] - outExt[2] + 1) / 50.0);
   target++;
 
+  // use sliding histograms if possible
+  vtkIdType inInc[3] = { inInc0, inInc1, inInc2 };
+  vtkIdType outInc[3];
+  outData->GetIncrements(outInc);
+  if (vtkImageMedian3DHistogramExecute(self, static_cast<T*>(inArray->GetVoidPointer(0)), inExt,
+        inInc, outPtr, outInc, outExt, numComp, id, target * numComp))
+  {
+    return;
+  }
+
+  // Array used to compute the median
+  T* workArray = new T[self->GetNumberOfElements()];
+  double percentile = self->GetPercentile();
+
   // loop through pixel of output
   inPtr = static_cast<T*>(inArray->GetVoidPointer((hoodMin0 - inExt[0]) * inInc0 +
     (hoodMin1 - inExt[2]) * inInc1 + (hoodMin2 - inExt[4]) * inInc2));
@@ -227,8 +615,8 @@ void vtkImageMedian3DExecute(vtkImageMedian3D* self, vtkImageData* inData, T* in
             tmpPtr2 += inInc2;
           }
 
-          // Replace this pixel with the hood median
-          *outPtr++ = vtkComputeMedianOfArray(workArray, workEnd);
+          // Replace this pixel with the hood percentile
+          *outPtr++ = vtkComputePercentileOfArray(workArray, workEnd, percentile);
         }
 
         // shift neighborhood considering boundaries
@@ -21,6 +21,18 @@
  * Neighborhoods can be no more than 3 dimensional.  Setting one
  * axis of the neighborhood kernelSize to 1 changes the filter
  * into a 2D median.
+ *
+ * Instead of the median, any percentile of the neighborhood values can be
+ * computed, e.g. the minimum or the maximum for a grayscale erosion or
+ * dilation.
+ *
+ * For integer data whose range within the input extent spans no more
+ * than 4096 values, the filter uses sliding histograms in the style of
+ * Perreault and Hebert: a histogram is kept for each column of the
+ * neighborhood, and the neighborhood histogram is updated by adding and
+ * removing whole columns as it moves along the row, so that the cost per
+ * voxel hardly depends on the kernel size.  Otherwise, the neighborhood
+ * values are partially sorted for each voxel.
  */
 
 #ifndef vtkImageMedian3D_h
@@ -49,11 +61,25 @@ public:
   vtkGetMacro(NumberOfElements, int);
   ///@}
 
+  ///@{
+  /**
+   * Set the percentile of the neighborhood values that is output, from 0
+   * to 100.  The default of 50 gives the median, where the two middle
+   * values are averaged if the neighborhood has an even number of elements.
+   * For other percentiles, the output is the value with index
+   * round(percentile/100*(n-1)) among the n sorted values, so that 0 gives
+   * the minimum and 100 gives the maximum.
+   */
+  vtkSetClampMacro(Percentile, double, 0.0, 100.0);
+  vtkGetMacro(Percentile, double);
+  ///@}
+
 protected:
   vtkImageMedian3D();
   ~vtkImageMedian3D() override;
 
   int NumberOfElements;
+  double Percentile;
 
   void ThreadedRequestData(vtkInformation* request, vtkInformationVector** inputVector,
     vtkInformationVector* outputVector, vtkImageData*** inData, vtkImageData** outData,
@@ -0,0 +1,135 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestSurfaceReconstructionFilter.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Reconstructs a torus and a sphere from random points with
+// vtkSurfaceReconstructionFilter, and checks that the normals are
+// oriented consistently, so that the sign of the distance volume tells the
+// inside from the outside, and that the output does not depend on the
+// number of threads.
+
+#include "vtkFloatArray.h"
+#include "vtkImageData.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+#include "vtkSurfaceReconstructionFilter.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+// The signed distance to the torus (radii 1 and 0.4) or to the sphere
+// (radius 0.5, at (3, 0, 0)), whichever is closer, and which one it is.
+double Distance(const double x[3], int& piece)
+{
+  double q = std::sqrt(x[0] * x[0] + x[1] * x[1]) - 1.0;
+  double torus = std::sqrt(q * q + x[2] * x[2]) - 0.4;
+  double sphere = std::sqrt((x[0] - 3.0) * (x[0] - 3.0) + x[1] * x[1] + x[2] * x[2]) - 0.5;
+  piece = (sphere < torus ? 1 : 0);
+  return std::min(torus, sphere);
+}
+}
+
+int TestSurfaceReconstructionFilter(int, char*[])
+{
+  vtkNew<vtkPoints> points;
+  vtkMath::RandomSeed(8775070);
+  for (int i = 0; i < 6000; ++i)
+  {
+    double u = vtkMath::Random(0.0, 2.0 * vtkMath::Pi());
+    double v = vtkMath::Random(0.0, 2.0 * vtkMath::Pi());
+    double r = vtkMath::Random(0.4, 0.405);
+    double w = 1.0 + r * std::cos(v);
+    points->InsertNextPoint(w * std::cos(u), w * std::sin(u), r * std::sin(v));
+  }
+  for (int i = 0; i < 1500; ++i)
+  {
+    double x[3] = { vtkMath::Gaussian(), vtkMath::Gaussian(), vtkMath::Gaussian() };
+    vtkMath::Normalize(x);
+    points->InsertNextPoint(3.0 + 0.5 * x[0], 0.5 * x[1], 0.5 * x[2]);
+  }
+  vtkNew<vtkPolyData> cloud;
+  cloud->SetPoints(points);
+
+  vtkNew<vtkSurfaceReconstructionFilter> reconstruction;
+  reconstruction->SetInputData(cloud);
+  reconstruction->SetSampleSpacing(0.05);
+  vtkSMPTools::Initialize(1);
+  reconstruction->Update();
+  vtkNew<vtkImageData> expected;
+  expected->DeepCopy(reconstruction->GetOutput());
+
+  // the normals of each piece can point inwards or outwards, but the
+  // distance must have the same sign as the true one everywhere near that
+  // piece, or the opposite sign everywhere (far from the points, the plane
+  // of the closest one is not a good guess)
+  vtkFloatArray* scalars = vtkFloatArray::SafeDownCast(expected->GetPointData()->GetScalars());
+  int agree[2] = { 0, 0 };
+  int disagree[2] = { 0, 0 };
+  for (vtkIdType i = 0; i < expected->GetNumberOfPoints(); ++i)
+  {
+    double x[3];
+    expected->GetPoint(i, x);
+    int piece;
+    double distance = Distance(x, piece);
+    if (std::fabs(distance) < 0.1 || std::fabs(distance) > 0.3)
+    {
+      continue;
+    }
+    if ((scalars->GetValue(i) > 0.0) == (distance > 0.0))
+    {
+      agree[piece]++;
+    }
+    else
+    {
+      disagree[piece]++;
+    }
+  }
+  for (int piece = 0; piece < 2; ++piece)
+  {
+    if (agree[piece] != 0 && disagree[piece] != 0)
+    {
+      cerr << "The normals of piece " << piece << " are not oriented consistently: "
+           << agree[piece] << " voxels have the right sign, and " << disagree[piece]
+           << " the wrong one\n";
+      return EXIT_FAILURE;
+    }
+  }
+
+  vtkSMPTools::Initialize(4);
+  reconstruction->Modified();
+  reconstruction->Update();
+  vtkFloatArray* threaded =
+    vtkFloatArray::SafeDownCast(reconstruction->GetOutput()->GetPointData()->GetScalars());
+  if (threaded->GetNumberOfValues() != scalars->GetNumberOfValues())
+  {
+    cerr << "The output depends on the number of threads\n";
+    return EXIT_FAILURE;
+  }
+  for (vtkIdType i = 0; i < scalars->GetNumberOfValues(); ++i)
+  {
+    if (threaded->GetValue(i) != scalars->GetValue(i))
+    {
+      cerr << "Voxel " << i << " is " << threaded->GetValue(i) << " with 4 threads instead of "
+           << scalars->GetValue(i) << "\n";
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
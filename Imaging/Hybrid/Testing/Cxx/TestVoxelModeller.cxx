@@ -0,0 +1,106 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestVoxelModeller.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Voxelizes a sphere with vtkVoxelModeller on several threads, for several
+// maximum distances and scalar types, and checks every voxel against the
+// closest points of all the cells.
+
+#include "vtkDataArray.h"
+#include "vtkGenericCell.h"
+#include "vtkImageData.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+#include "vtkSphereSource.h"
+#include "vtkVoxelModeller.h"
+
+#include <cmath>
+#include <vector>
+
+int TestVoxelModeller(int, char*[])
+{
+  vtkSMPTools::Initialize(4);
+
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(12);
+  sphere->SetPhiResolution(9);
+  sphere->SetCenter(0.1, -0.05, 0.0);
+  sphere->Update();
+  vtkPolyData* input = sphere->GetOutput();
+
+  vtkNew<vtkVoxelModeller> modeller;
+  modeller->SetInputConnection(sphere->GetOutputPort());
+  modeller->SetSampleDimensions(25, 22, 27);
+  modeller->SetModelBounds(-0.8, 0.8, -0.7, 0.75, -0.8, 0.8);
+  modeller->SetForegroundValue(3.0);
+
+  for (int scalarType : { VTK_BIT, VTK_UNSIGNED_CHAR, VTK_FLOAT })
+  {
+    for (double maximumDistance : { 1.0, 0.2, 0.01 })
+    {
+      modeller->SetScalarType(scalarType);
+      modeller->SetMaximumDistance(maximumDistance);
+      modeller->Update();
+      vtkImageData* output = modeller->GetOutput();
+      vtkDataArray* scalars = output->GetPointData()->GetScalars();
+      double foreground = (scalarType == VTK_BIT ? 1.0 : 3.0);
+      double spacing[3];
+      output->GetSpacing(spacing);
+
+      // a voxel is occupied if the closest point of a cell lies within it,
+      // and the voxel is within the cell bounds grown by the maximum distance
+      double maxDistance = maximumDistance * 1.6;
+      double origin[3];
+      output->GetOrigin(origin);
+      vtkNew<vtkGenericCell> cell;
+      std::vector<double> weights(input->GetMaxCellSize());
+      for (vtkIdType i = 0; i < output->GetNumberOfPoints(); ++i)
+      {
+        double x[3], closestPoint[3], pcoords[3], distance2;
+        int subId;
+        output->GetPoint(i, x);
+        int ijk[3] = { static_cast<int>(i % 25), static_cast<int>(i / 25 % 22),
+          static_cast<int>(i / (25 * 22)) };
+        bool occupied = false;
+        for (vtkIdType cellId = 0; cellId < input->GetNumberOfCells() && !occupied; ++cellId)
+        {
+          input->GetCell(cellId, cell);
+          const double* bounds = cell->GetBounds();
+          bool near = true;
+          for (int j = 0; j < 3; ++j)
+          {
+            double low = (bounds[2 * j] - maxDistance - origin[j]) / spacing[j];
+            double high = (bounds[2 * j + 1] + maxDistance - origin[j]) / spacing[j];
+            near = near && ijk[j] >= static_cast<int>(low) && ijk[j] <= static_cast<int>(high);
+          }
+          occupied = near &&
+            cell->EvaluatePosition(x, closestPoint, subId, pcoords, distance2, weights.data()) !=
+              -1 &&
+            std::fabs(closestPoint[0] - x[0]) <= spacing[0] / 2.0 &&
+            std::fabs(closestPoint[1] - x[1]) <= spacing[1] / 2.0 &&
+            std::fabs(closestPoint[2] - x[2]) <= spacing[2] / 2.0;
+        }
+        if (scalars->GetComponent(i, 0) != (occupied ? foreground : 0.0))
+        {
+          cerr << scalars->GetDataTypeAsString() << " maximum distance " << maximumDistance
+               << ": voxel " << i << " is " << scalars->GetComponent(i, 0) << "\n";
+          return EXIT_FAILURE;
+        }
+      }
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -14,18 +14,27 @@
 =========================================================================*/
 #include "vtkSurfaceReconstructionFilter.h"
 
+#include "vtkDoubleArray.h"
 #include "vtkFloatArray.h"
 #include "vtkIdList.h"
 #include "vtkImageData.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMath.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
-#include "vtkPointLocator.h"
 #include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+#include "vtkStaticPointLocator.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
 vtkStandardNewMacro(vtkSurfaceReconstructionFilter);
 
 vtkSurfaceReconstructionFilter::vtkSurfaceReconstructionFilter()
@@ -36,21 +45,21 @@ vtkSurfaceReconstructionFilter::vtkSurfaceReconstructionFilter()
 }
 
 // some simple routines for vector math
-static void vtkCopyBToA(double* a, double* b)
+static void vtkCopyBToA(double* a, const double* b)
 {
   for (int i = 0; i < 3; i++)
   {
     a[i] = b[i];
   }
 }
-static void vtkSubtractBFromA(double* a, double* b)
+static void vtkSubtractBFromA(double* a, const double* b)
 {
   for (int i = 0; i < 3; i++)
   {
     a[i] -= b[i];
   }
 }
-static void vtkAddBToA(double* a, double* b)
+static void vtkAddBToA(double* a, const double* b)
 {
   for (int i = 0; i < 3; i++)
   {
@@ -72,39 +81,243 @@ static void vtkDivideBy(double* a, double f)
   }
 }
 
-// Routines for matrix creation
-static void vtkSRFreeMatrix(double** m, long nrl, long nrh, long ncl, long nch);
-static double** vtkSRMatrix(long nrl, long nrh, long ncl, long nch);
-static void vtkSRFreeVector(double* v, long nl, long nh);
-static double* vtkSRVector(long nl, long nh);
-
-// set a matrix to zero
-static void vtkSRMakeZero(double** m, long nrl, long nrh, long ncl, long nch)
+// add v*Transpose(v) to m, where v is 3x1 and m is 3x3
+static void vtkSRAddOuterProduct(double m[3][3], const double* v)
 {
-  int i, j;
-  for (i = nrl; i <= nrh; i++)
+  for (int i = 0; i < 3; i++)
   {
-    for (j = ncl; j <= nch; j++)
+    for (int j = 0; j < 3; j++)
     {
-      m[i][j] = 0.0;
+      m[i][j] += v[i] * v[j];
     }
   }
 }
 
-// add v*Transpose(v) to m, where v is 3x1 and m is 3x3
-void vtkSRAddOuterProduct(double** m, double* v);
+// whether edge e1 of point p1 costs less than edge e2 of point p2, with
+// ties broken by the point ids so that every edge has its own rank
+static bool vtkSRIsCheaper(const double* costs, const vtkIdType* graph, vtkIdType p1,
+  vtkIdType e1, vtkIdType p2, vtkIdType e2)
+{
+  if (costs[e1] != costs[e2])
+  {
+    return costs[e1] < costs[e2];
+  }
+  vtkIdType q1 = graph[e1];
+  vtkIdType q2 = graph[e2];
+  if (std::min(p1, q1) != std::min(p2, q2))
+  {
+    return std::min(p1, q1) < std::min(p2, q2);
+  }
+  return std::max(p1, q1) < std::max(p2, q2);
+}
+
+// find the root of a component, compressing the path to it
+static vtkIdType vtkSRFindRoot(std::vector<vtkIdType>& parents, vtkIdType i)
+{
+  vtkIdType root = i;
+  while (parents[root] != root)
+  {
+    root = parents[root];
+  }
+  while (parents[i] != root)
+  {
+    vtkIdType next = parents[i];
+    parents[i] = root;
+    i = next;
+  }
+  return root;
+}
+
+namespace
+{
+//------------------------------------------------------------------------------
+// 1. Find the closest points of each point, other than the point itself.
+struct vtkSRFindNeighbors
+{
+  vtkStaticPointLocator* Locator;
+  const double* Points;
+  int NeighborhoodSize;
+  vtkIdType* Neighbors; // NeighborhoodSize ids per point
+  vtkIdType* NumberOfNeighbors;
+  vtkSMPThreadLocalObject<vtkIdList> Closest;
+
+  vtkSRFindNeighbors(vtkStaticPointLocator* locator, const double* points, int neighborhoodSize,
+    vtkIdType* neighbors, vtkIdType* numberOfNeighbors)
+    : Locator(locator)
+    , Points(points)
+    , NeighborhoodSize(neighborhoodSize)
+    , Neighbors(neighbors)
+    , NumberOfNeighbors(numberOfNeighbors)
+  {
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkIdList* closest = this->Closest.Local();
+    for (vtkIdType i = begin; i < end; i++)
+    {
+      this->Locator->FindClosestNPoints(this->NeighborhoodSize, this->Points + 3 * i, closest);
+      vtkIdType* neighbors = this->Neighbors + i * this->NeighborhoodSize;
+      vtkIdType number = 0;
+      for (vtkIdType j = 0; j < closest->GetNumberOfIds() && number < this->NeighborhoodSize; j++)
+      {
+        vtkIdType iNeighbor = closest->GetId(j);
+        if (iNeighbor != i)
+        {
+          neighbors[number++] = iNeighbor;
+        }
+      }
+      this->NumberOfNeighbors[i] = number;
+    }
+  }
+};
+
+//------------------------------------------------------------------------------
+// 2. Estimate a plane at each point using its neighbors.
+struct vtkSREstimatePlanes
+{
+  const double* Points;
+  const vtkIdType* Offsets;
+  const vtkIdType* Graph;
+  double* Normals;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    double covar[3][3], eigenvectors[3][3], eigenvalues[3], o[3], v3d[3];
+    double* covarRows[3] = { covar[0], covar[1], covar[2] };
+    double* eigenvectorRows[3] = { eigenvectors[0], eigenvectors[1], eigenvectors[2] };
+    for (vtkIdType i = begin; i < end; i++)
+    {
+      const double* loc = this->Points + 3 * i;
+
+      // first find the centroid of the neighbors
+      vtkCopyBToA(o, loc);
+      int number = 1;
+      for (vtkIdType j = this->Offsets[i]; j < this->Offsets[i + 1]; j++)
+      {
+        vtkAddBToA(o, this->Points + 3 * this->Graph[j]);
+        number++;
+      }
+      vtkDivideBy(o, number);
+      // then compute the covariance matrix
+      std::fill(covar[0], covar[0] + 9, 0.0);
+      vtkCopyBToA(v3d, loc);
+      vtkSubtractBFromA(v3d, o);
+      vtkSRAddOuterProduct(covar, v3d);
+      for (vtkIdType j = this->Offsets[i]; j < this->Offsets[i + 1]; j++)
+      {
+        vtkCopyBToA(v3d, this->Points + 3 * this->Graph[j]);
+        vtkSubtractBFromA(v3d, o);
+        vtkSRAddOuterProduct(covar, v3d);
+      }
+      for (int k = 0; k < 3; k++)
+      {
+        vtkMultiplyBy(covar[k], 1.0 / number);
+      }
+      // then extract the third eigenvector
+      vtkMath::Jacobi(covarRows, eigenvalues, eigenvectorRows);
+      // third eigenvector (column 2, ordered by eigenvalue magnitude) is plane normal
+      for (int k = 0; k < 3; k++)
+      {
+        this->Normals[3 * i + k] = eigenvectors[k][2];
+      }
+    }
+  }
+};
 
-// scalar multiply a matrix
-static void vtkSRMultiply(double** m, double f, long nrl, long nrh, long ncl, long nch)
+//------------------------------------------------------------------------------
+// 3a. Compute a cost between every pair of neighbors for the MST.
+// cost = 1 - |normal1.normal2|
+// ie. cost is 0 if planes are parallel, 1 if orthogonal (least parallel)
+struct vtkSRComputeCosts
 {
-  int i, j;
-  for (i = nrl; i <= nrh; i++)
+  const vtkIdType* Offsets;
+  const vtkIdType* Graph;
+  const double* Normals;
+  double* Costs;
+
+  void operator()(vtkIdType begin, vtkIdType end)
   {
-    for (j = ncl; j <= nch; j++)
+    for (vtkIdType i = begin; i < end; i++)
+    {
+      for (vtkIdType j = this->Offsets[i]; j < this->Offsets[i + 1]; j++)
+      {
+        this->Costs[j] =
+          1.0 - fabs(vtkMath::Dot(this->Normals + 3 * i, this->Normals + 3 * this->Graph[j]));
+      }
+    }
+  }
+};
+
+//------------------------------------------------------------------------------
+// 3b. Find the cheapest edge from each active point to another component
+// of the minimum spanning forest.
+struct vtkSRFindCheapestEdges
+{
+  const vtkIdType* Offsets;
+  const vtkIdType* Graph;
+  const double* Costs;
+  const vtkIdType* Components;
+  const vtkIdType* Active;
+  vtkIdType* CheapestEdges;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType a = begin; a < end; a++)
+    {
+      vtkIdType i = this->Active[a];
+      vtkIdType cheapest = -1;
+      for (vtkIdType j = this->Offsets[i]; j < this->Offsets[i + 1]; j++)
+      {
+        if (this->Components[this->Graph[j]] != this->Components[i] &&
+          (cheapest < 0 || vtkSRIsCheaper(this->Costs, this->Graph, i, j, i, cheapest)))
+        {
+          cheapest = j;
+        }
+      }
+      this->CheapestEdges[a] = cheapest;
+    }
+  }
+};
+
+//------------------------------------------------------------------------------
+// 4. Compute the signed distance to the plane of the nearest point for
+// a range of slices of the output volume.
+struct vtkSRComputeDistances
+{
+  vtkStaticPointLocator* Locator;
+  const double* Points;
+  const double* Normals;
+  const double* Origin;
+  double Spacing;
+  const int* Dim;
+  float* Scalars;
+
+  void operator()(vtkIdType zBegin, vtkIdType zEnd)
+  {
+    double point[3], temp[3];
+    for (vtkIdType z = zBegin; z < zEnd; z++)
     {
-      m[i][j] *= f;
+      vtkIdType zOffset = z * this->Dim[1] * this->Dim[0];
+      point[2] = this->Origin[2] + z * this->Spacing;
+      for (int y = 0; y < this->Dim[1]; y++)
+      {
+        vtkIdType yOffset = y * this->Dim[0] + zOffset;
+        point[1] = this->Origin[1] + y * this->Spacing;
+        for (int x = 0; x < this->Dim[0]; x++)
+        {
+          point[0] = this->Origin[0] + x * this->Spacing;
+          // find the distance from the probe to the plane of the nearest point
+          vtkIdType iClosestPoint = this->Locator->FindClosestPoint(point);
+          vtkCopyBToA(temp, point);
+          vtkSubtractBFromA(temp, this->Points + 3 * iClosestPoint);
+          this->Scalars[x + yOffset] =
+            static_cast<float>(vtkMath::Dot(temp, this->Normals + 3 * iClosestPoint));
+        }
+      }
     }
   }
+};
 }
 
 //------------------------------------------------------------------------------
@@ -129,28 +342,6 @@ int vtkSurfaceReconstructionFilter::RequestInformation(vtkInformation* vtkNotUse
   return 1;
 }
 
-//------------------------------------------------------------------------------
-struct SurfacePoint
-{
-  double loc[3];
-  double o[3], n[3];    // plane centre and normal
-  vtkIdList* neighbors; // id's of points within LocalRadius of this point
-  double* costs;        // should have same length as neighbors, cost for corresponding points
-  char isVisited;
-
-  // simple constructor to initialise the members
-  SurfacePoint()
-    : neighbors(vtkIdList::New())
-    , isVisited(0)
-  {
-  }
-  ~SurfacePoint()
-  {
-    delete[] costs;
-    neighbors->Delete();
-  }
-};
-
 //------------------------------------------------------------------------------
 int vtkSurfaceReconstructionFilter::RequestData(vtkInformation* vtkNotUsed(request),
   vtkInformationVector** inputVector, vtkInformationVector* outputVector)
@@ -164,226 +355,233 @@ int vtkSurfaceReconstructionFilter::RequestData(vtkInformation* vtkNotUsed(reque
   vtkImageData* output = vtkImageData::SafeDownCast(outInfo->Get(vtkDataObject::DATA_OBJECT()));
 
   const vtkIdType COUNT = input->GetNumberOfPoints();
-  SurfacePoint* surfacePoints;
 
   vtkIdType i, j;
-  int k;
 
   if (COUNT < 1)
   {
     vtkErrorMacro(<< "No points to reconstruct");
     return 1;
   }
-  surfacePoints = new SurfacePoint[COUNT];
 
   vtkDebugMacro(<< "Reconstructing " << COUNT << " points");
 
-  // time_t start_time,t1,t2,t3,t4;
-  // time(&start_time);
+  // copy the points, and build a locator that can be queried from threads
+  vtkNew<vtkPoints> points;
+  points->SetDataTypeToDouble();
+  points->SetNumberOfPoints(COUNT);
+  for (i = 0; i < COUNT; i++)
+  {
+    double x[3];
+    input->GetPoint(i, x);
+    points->SetPoint(i, x);
+  }
+  const double* locs = vtkArrayDownCast<vtkDoubleArray>(points->GetData())->GetPointer(0);
+  vtkNew<vtkPolyData> cloud;
+  cloud->SetPoints(points);
+  vtkNew<vtkStaticPointLocator> locator;
+  locator->SetDataSet(cloud);
+  locator->BuildLocator();
 
   // --------------------------------------------------------------------------
   // 1. Build local connectivity graph
   // -------------------------------------------------------------------------
+  // if a pair is close, each one is a neighbor of the other, so a point is
+  // listed twice when both are among the closest points of the other
+  std::vector<vtkIdType> offsets(COUNT + 1, 0);
+  std::vector<vtkIdType> graph;
   {
-    vtkPointLocator* locator = vtkPointLocator::New();
-    locator->SetDataSet(input);
-    vtkIdList* locals = vtkIdList::New();
-    // if a pair is close, add each one as a neighbor of the other
+    const int size = std::max(this->NeighborhoodSize, 0);
+    std::vector<vtkIdType> closest(COUNT * size);
+    std::vector<vtkIdType> numberOfClosest(COUNT);
+    vtkSRFindNeighbors findNeighbors(locator, locs, size, closest.data(), numberOfClosest.data());
+    vtkSMPTools::For(0, COUNT, findNeighbors);
+
+    // store the neighbors of all the points in one array, in the order in
+    // which they are found by walking through the points
     for (i = 0; i < COUNT; i++)
     {
-      SurfacePoint* p = &surfacePoints[i];
-      vtkCopyBToA(p->loc, input->GetPoint(i));
-      locator->FindClosestNPoints(this->NeighborhoodSize, p->loc, locals);
-      int iNeighbor;
-      for (j = 0; j < locals->GetNumberOfIds(); j++)
+      offsets[i + 1] += numberOfClosest[i];
+      for (j = 0; j < numberOfClosest[i]; j++)
       {
-        iNeighbor = locals->GetId(j);
-        if (iNeighbor != i)
-        {
-          p->neighbors->InsertNextId(iNeighbor);
-          surfacePoints[iNeighbor].neighbors->InsertNextId(i);
-        }
+        offsets[closest[i * size + j] + 1]++;
+      }
+    }
+    for (i = 0; i < COUNT; i++)
+    {
+      offsets[i + 1] += offsets[i];
+    }
+    graph.resize(offsets[COUNT]);
+    std::vector<vtkIdType> ends(offsets.begin(), offsets.end() - 1);
+    for (i = 0; i < COUNT; i++)
+    {
+      for (j = 0; j < numberOfClosest[i]; j++)
+      {
+        vtkIdType iNeighbor = closest[i * size + j];
+        graph[ends[i]++] = iNeighbor;
+        graph[ends[iNeighbor]++] = i;
       }
     }
-    locator->Delete();
-    locals->Delete();
   }
 
-  // time(&t1);
   // --------------------------------------------------------------------------
   // 2. Estimate a plane at each point using local points
   // --------------------------------------------------------------------------
+  std::vector<double> normals(3 * COUNT);
+  vtkSREstimatePlanes estimatePlanes = { locs, offsets.data(), graph.data(), normals.data() };
+  vtkSMPTools::For(0, COUNT, estimatePlanes);
+
+  //--------------------------------------------------------------------------
+  // 3a. Compute a cost between every pair of neighbors for the MST
+  // --------------------------------------------------------------------------
+  std::vector<double> costs(graph.size());
+  vtkSRComputeCosts computeCosts = { offsets.data(), graph.data(), normals.data(), costs.data() };
+  vtkSMPTools::For(0, COUNT, computeCosts);
+
+  // --------------------------------------------------------------------------
+  // 3b. Ensure consistency in plane direction between neighbors
+  // --------------------------------------------------------------------------
+  // method: guess first one, then walk through the minimal spanning tree
+  // along most-parallel neighbors, flipping the new normal if inconsistent
+
+  // the tree is built in rounds: every component of the forest, starting
+  // with single points, is joined to another one by its cheapest edge.
+  // The edges from all the points are searched in parallel, and points
+  // whose neighbors are all in their component are not searched again.
+  std::vector<vtkIdType> treeEdges;
   {
-    double* pointi;
-    double **covar, *v3d, *eigenvalues, **eigenvectors;
-    covar = vtkSRMatrix(0, 2, 0, 2);
-    v3d = vtkSRVector(0, 2);
-    eigenvalues = vtkSRVector(0, 2);
-    eigenvectors = vtkSRMatrix(0, 2, 0, 2);
+    std::vector<vtkIdType> components(COUNT);
+    std::vector<vtkIdType> parents(COUNT);
+    std::vector<vtkIdType> active(COUNT);
     for (i = 0; i < COUNT; i++)
     {
-      SurfacePoint* p = &surfacePoints[i];
+      components[i] = parents[i] = active[i] = i;
+    }
+    std::vector<vtkIdType> cheapestEdges(COUNT);
+    std::vector<vtkIdType> componentEdges(COUNT, -1);
+    std::vector<vtkIdType> componentPoints(COUNT);
+    std::vector<vtkIdType> joined;
+
+    vtkSRFindCheapestEdges findCheapestEdges = { offsets.data(), graph.data(), costs.data(),
+      components.data(), active.data(), cheapestEdges.data() };
+    while (!active.empty())
+    {
+      findCheapestEdges.Active = active.data();
+      vtkSMPTools::For(0, static_cast<vtkIdType>(active.size()), findCheapestEdges);
 
-      // first find the centroid of the neighbors
-      vtkCopyBToA(p->o, p->loc);
-      int number = 1;
-      vtkIdType neighborIndex;
-      for (j = 0; j < p->neighbors->GetNumberOfIds(); j++)
+      // pick the cheapest edge of each component
+      vtkIdType numberOfActive = 0;
+      for (size_t a = 0; a < active.size(); a++)
       {
-        neighborIndex = p->neighbors->GetId(j);
-        pointi = input->GetPoint(neighborIndex);
-        vtkAddBToA(p->o, pointi);
-        number++;
+        vtkIdType cheapest = cheapestEdges[a];
+        if (cheapest < 0)
+        {
+          continue;
+        }
+        i = active[a];
+        active[numberOfActive++] = i;
+        vtkIdType component = components[i];
+        if (componentEdges[component] < 0)
+        {
+          joined.push_back(component);
+        }
+        if (componentEdges[component] < 0 ||
+          vtkSRIsCheaper(costs.data(), graph.data(), i, cheapest, componentPoints[component],
+            componentEdges[component]))
+        {
+          componentEdges[component] = cheapest;
+          componentPoints[component] = i;
+        }
       }
-      vtkDivideBy(p->o, number);
-      // then compute the covariance matrix
-      vtkSRMakeZero(covar, 0, 2, 0, 2);
-      for (k = 0; k < 3; k++)
-        v3d[k] = p->loc[k] - p->o[k];
-      vtkSRAddOuterProduct(covar, v3d);
-      for (j = 0; j < p->neighbors->GetNumberOfIds(); j++)
+      active.resize(numberOfActive);
+
+      // join the components, skipping edges that were picked from both ends
+      size_t numberOfJoined = joined.size();
+      for (size_t c = 0; c < numberOfJoined; c++)
       {
-        neighborIndex = p->neighbors->GetId(j);
-        pointi = input->GetPoint(neighborIndex);
-        for (k = 0; k < 3; k++)
+        vtkIdType component = joined[c];
+        vtkIdType iPoint = componentPoints[component];
+        vtkIdType iNeighbor = graph[componentEdges[component]];
+        componentEdges[component] = -1;
+        joined.push_back(components[iNeighbor]);
+        vtkIdType root = vtkSRFindRoot(parents, component);
+        vtkIdType neighborRoot = vtkSRFindRoot(parents, components[iNeighbor]);
+        if (root != neighborRoot)
         {
-          v3d[k] = pointi[k] - p->o[k];
+          parents[std::max(root, neighborRoot)] = std::min(root, neighborRoot);
+          treeEdges.push_back(iPoint);
+          treeEdges.push_back(iNeighbor);
         }
-        vtkSRAddOuterProduct(covar, v3d);
       }
-      vtkSRMultiply(covar, 1.0 / number, 0, 2, 0, 2);
-      // then extract the third eigenvector
-      vtkMath::Jacobi(covar, eigenvalues, eigenvectors);
-      // third eigenvector (column 2, ordered by eigenvalue magnitude) is plane normal
-      for (k = 0; k < 3; k++)
+      for (vtkIdType component : joined)
       {
-        p->n[k] = eigenvectors[k][2];
+        vtkSRFindRoot(parents, component);
       }
+      joined.clear();
+
+      // label the points with the roots of their new components
+      vtkSMPTools::For(0, COUNT, [&](vtkIdType begin, vtkIdType end) {
+        for (vtkIdType k = begin; k < end; k++)
+        {
+          components[k] = parents[components[k]];
+        }
+      });
     }
-    vtkSRFreeMatrix(covar, 0, 2, 0, 2);
-    vtkSRFreeVector(v3d, 0, 2);
-    vtkSRFreeVector(eigenvalues, 0, 2);
-    vtkSRFreeMatrix(eigenvectors, 0, 2, 0, 2);
   }
 
-  // time(&t2);
-  //--------------------------------------------------------------------------
-  // 3a. Compute a cost between every pair of neighbors for the MST
-  // --------------------------------------------------------------------------
-  // cost = 1 - |normal1.normal2|
-  // ie. cost is 0 if planes are parallel, 1 if orthogonal (least parallel)
-  for (i = 0; i < COUNT; i++)
+  // walk through the tree from the first point (and from the first point of
+  // each other piece of the surface), flipping the normals to match
   {
-    SurfacePoint* p = &surfacePoints[i];
-    p->costs = new double[p->neighbors->GetNumberOfIds()];
-
-    // compute cost between all its neighbors
-    // (bit inefficient to do this for every point, as cost is symmetric)
-    for (j = 0; j < p->neighbors->GetNumberOfIds(); j++)
+    std::vector<vtkIdType> treeOffsets(COUNT + 1, 0);
+    for (vtkIdType point : treeEdges)
     {
-      p->costs[j] = 1.0 - fabs(vtkMath::Dot(p->n, surfacePoints[p->neighbors->GetId(j)].n));
+      treeOffsets[point + 1]++;
     }
-  }
-
-  // --------------------------------------------------------------------------
-  // 3b. Ensure consistency in plane direction between neighbors
-  // --------------------------------------------------------------------------
-  // method: guess first one, then walk through tree along most-parallel
-  // neighbors MST, flipping the new normal if inconsistent
-
-  // to walk minimal spanning tree, keep record of vertices visited and list
-  // of those near to any visited point but not themselves visited. Start
-  // with just one vertex as visited.  Pick the vertex in the neighbors list
-  // that has the lowest cost connection with a visited vertex. Record this
-  // vertex as visited, add any new neighbors to the neighbors list.
-
-  // Disable if you don't want orientation propagation (for testing)
-#if 1
-  {
-    vtkIdList* nearby = vtkIdList::New(); // list of nearby, unvisited points
-
-    // start with some vertex
-    int first = 0; // index of starting vertex
-    surfacePoints[first].isVisited = 1;
-    // add all the neighbors of the starting vertex into nearby
-    for (j = 0; j < surfacePoints[first].neighbors->GetNumberOfIds(); j++)
+    for (i = 0; i < COUNT; i++)
     {
-      nearby->InsertNextId(surfacePoints[first].neighbors->GetId(j));
+      treeOffsets[i + 1] += treeOffsets[i];
     }
-
-    double cost, lowestCost;
-    int cheapestNearby = 0, connectedVisited = 0;
-
-    // repeat until nearby is empty:
-    while (nearby->GetNumberOfIds() > 0)
+    std::vector<vtkIdType> tree(treeEdges.size());
+    std::vector<vtkIdType> ends(treeOffsets.begin(), treeOffsets.end() - 1);
+    for (size_t e = 0; e < treeEdges.size(); e += 2)
     {
-      // for each nearby point:
-      vtkIdType iNearby, iNeighbor;
-      lowestCost = VTK_DOUBLE_MAX;
-      for (i = 0; i < nearby->GetNumberOfIds(); i++)
-      {
-        iNearby = nearby->GetId(i);
-        // test cost against all neighbors that are members of visited
-        for (j = 0; j < surfacePoints[iNearby].neighbors->GetNumberOfIds(); j++)
-        {
-          iNeighbor = surfacePoints[iNearby].neighbors->GetId(j);
-          if (surfacePoints[iNeighbor].isVisited)
-          {
-            cost = surfacePoints[iNearby].costs[j];
-            // pick lowest cost for this nearby point
-            if (cost < lowestCost)
-            {
-              lowestCost = cost;
-              cheapestNearby = iNearby;
-              connectedVisited = iNeighbor;
-              // optional: can break out if satisfied with parallelness
-              if (lowestCost < 0.1)
-              {
-                i = nearby->GetNumberOfIds();
-                break;
-              }
-            }
-          }
-        }
-      }
-      if (connectedVisited == cheapestNearby)
-      {
-        vtkErrorMacro(<< "Internal error in vtkSurfaceReconstructionFilter");
-        return 0;
-      }
+      tree[ends[treeEdges[e]]++] = treeEdges[e + 1];
+      tree[ends[treeEdges[e + 1]]++] = treeEdges[e];
+    }
 
-      // correct the orientation of the point if necessary
-      if (vtkMath::Dot(surfacePoints[cheapestNearby].n, surfacePoints[connectedVisited].n) < 0.0F)
-      {
-        // flip this normal
-        vtkMultiplyBy(surfacePoints[cheapestNearby].n, -1);
-      }
-      // add this nearby point to visited
-      if (surfacePoints[cheapestNearby].isVisited != 0)
+    std::vector<char> isVisited(COUNT, 0);
+    std::vector<vtkIdType> nearby; // visited points whose neighbors are not
+    for (vtkIdType first = 0; first < COUNT; first++)
+    {
+      if (isVisited[first])
       {
-        vtkErrorMacro(<< "Internal error in vtkSurfaceReconstructionFilter");
-        return 0;
+        continue;
       }
-
-      surfacePoints[cheapestNearby].isVisited = 1;
-      // remove from nearby
-      nearby->DeleteId(cheapestNearby);
-      // add all new nearby points to nearby
-      for (j = 0; j < surfacePoints[cheapestNearby].neighbors->GetNumberOfIds(); j++)
+      isVisited[first] = 1;
+      nearby.push_back(first);
+      while (!nearby.empty())
       {
-        iNeighbor = surfacePoints[cheapestNearby].neighbors->GetId(j);
-        if (surfacePoints[iNeighbor].isVisited == 0)
+        vtkIdType iVisited = nearby.back();
+        nearby.pop_back();
+        for (j = treeOffsets[iVisited]; j < treeOffsets[iVisited + 1]; j++)
         {
-          nearby->InsertUniqueId(iNeighbor);
+          vtkIdType iNeighbor = tree[j];
+          if (isVisited[iNeighbor])
+          {
+            continue;
+          }
+          // correct the orientation of the point if necessary
+          if (vtkMath::Dot(&normals[3 * iNeighbor], &normals[3 * iVisited]) < 0.0)
+          {
+            // flip this normal
+            vtkMultiplyBy(&normals[3 * iNeighbor], -1);
+          }
+          isVisited[iNeighbor] = 1;
+          nearby.push_back(iNeighbor);
         }
       }
     }
-
-    nearby->Delete();
   }
-#endif
-
-  // time(&t3);
 
   // --------------------------------------------------------------------------
   // 4. Compute signed distance to surface for every point on a 3D grid
@@ -443,57 +641,15 @@ int vtkSurfaceReconstructionFilter::RequestData(vtkInformation* vtkNotUsed(reque
       vtkDataObject::SPACING(), this->SampleSpacing, this->SampleSpacing, this->SampleSpacing);
     outInfo->Set(vtkDataObject::ORIGIN(), topleft, 3);
 
-    // initialise the point locator (have to use point insertion because we
-    // need to set our own bounds, slightly larger than the dataset to allow
-    // for sampling around the edge)
-    vtkPointLocator* locator = vtkPointLocator::New();
-    vtkPoints* newPts = vtkPoints::New();
-    locator->InitPointInsertion(newPts, bounds, static_cast<int>(COUNT));
-    for (i = 0; i < COUNT; i++)
+    // go through the array probing the values, a range of slices per thread
+    if (dim[0] > 0 && dim[1] > 0 && dim[2] > 0)
     {
-      locator->InsertPoint(i, surfacePoints[i].loc);
+      vtkSRComputeDistances computeDistances = { locator, locs, normals.data(), topleft,
+        this->SampleSpacing, dim, newScalars->GetPointer(0) };
+      vtkSMPTools::For(0, dim[2], computeDistances);
     }
-
-    // go through the array probing the values
-    int x, y, z;
-    int iClosestPoint;
-    int zOffset, yOffset, offset;
-    double probeValue;
-    double point[3], temp[3];
-    for (z = 0; z < dim[2]; z++)
-    {
-      zOffset = z * dim[1] * dim[0];
-      point[2] = topleft[2] + z * this->SampleSpacing;
-      for (y = 0; y < dim[1]; y++)
-      {
-        yOffset = y * dim[0] + zOffset;
-        point[1] = topleft[1] + y * this->SampleSpacing;
-        for (x = 0; x < dim[0]; x++)
-        {
-          offset = x + yOffset;
-          point[0] = topleft[0] + x * this->SampleSpacing;
-          // find the distance from the probe to the plane of the nearest point
-          iClosestPoint = locator->FindClosestInsertedPoint(point);
-          if (iClosestPoint == -1)
-          {
-            vtkErrorMacro(<< "Internal error");
-            return 0;
-          }
-          vtkCopyBToA(temp, point);
-          vtkSubtractBFromA(temp, surfacePoints[iClosestPoint].loc);
-          probeValue = vtkMath::Dot(temp, surfacePoints[iClosestPoint].n);
-          newScalars->SetValue(offset, probeValue);
-        }
-      }
-    }
-    locator->Delete();
-    newPts->Delete();
   }
 
-  // time(&t4);
-  // Clear up everything
-  delete[] surfacePoints;
-
   return 1;
 }
 
@@ -504,85 +660,3 @@ void vtkSurfaceReconstructionFilter::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Neighborhood Size:" << this->NeighborhoodSize << "\n";
   os << indent << "Sample Spacing:" << this->SampleSpacing << "\n";
 }
-
-void vtkSRAddOuterProduct(double** m, double* v)
-{
-  int i, j;
-  for (i = 0; i < 3; i++)
-  {
-    for (j = 0; j < 3; j++)
-    {
-      m[i][j] += v[i] * v[j];
-    }
-  }
-}
-
-#define VTK_NR_END 1
-
-// allocate a float vector with subscript range v[nl..nh]
-// must be balanced with vtkSRFreeVector.
-static double* vtkSRVector(long nl, long nh)
-{
-  double* v = new double[nh - nl + 1 + VTK_NR_END];
-  if (!v)
-  {
-    vtkGenericWarningMacro(<< "allocation failure in vector()");
-    return nullptr;
-  }
-
-  return (v - nl + VTK_NR_END);
-}
-
-// allocate a float matrix with subscript range m[nrl..nrh][ncl..nch]
-// must be balanced with vtkSRFreeMatrix.
-static double** vtkSRMatrix(long nrl, long nrh, long ncl, long nch)
-{
-  long i, nrow = nrh - nrl + 1, ncol = nch - ncl + 1;
-  double** m;
-
-  // allocate pointers to rows
-  m = new double*[nrow + VTK_NR_END];
-  if (!m)
-  {
-    vtkGenericWarningMacro(<< "allocation failure 1 in Matrix()");
-    return nullptr;
-  }
-
-  m += VTK_NR_END;
-  m -= nrl;
-
-  // allocate rows and set pointers to them
-  m[nrl] = new double[nrow * ncol + VTK_NR_END];
-  if (!m[nrl])
-  {
-    vtkGenericWarningMacro("allocation failure 2 in Matrix()");
-    return nullptr;
-  }
-
-  m[nrl] += VTK_NR_END;
-  m[nrl] -= ncl;
-  for (i = nrl + 1; i <= nrh; i++)
-  {
-    m[i] = m[i - 1] + ncol;
-  }
-
-  // return pointer to array of pointers to rows
-  return m;
-}
-
-// free a double vector allocated with SRVector()
-static void vtkSRFreeVector(double* v, long nl, long vtkNotUsed(nh))
-{
-  delete[](v + nl - VTK_NR_END);
-}
-
-// free a double matrix allocated by Matrix()
-static void vtkSRFreeMatrix(
-  double** m, long nrl, long vtkNotUsed(nrh), long ncl, long vtkNotUsed(nch))
-
-{
-  delete[](m[nrl] + ncl - VTK_NR_END);
-  delete[](m + nrl - VTK_NR_END);
-}
-
-#undef VTK_NR_END
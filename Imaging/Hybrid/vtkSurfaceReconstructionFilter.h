@@ -23,6 +23,11 @@
  * neighborhood size and sample spacing should give reasonable results for
  * most uses but can be set if desired. This procedure is based on the PhD
  * work of Hugues Hoppe: http://www.research.microsoft.com/~hoppe
+ *
+ * The neighborhoods, the tangent planes, the minimum spanning tree used to
+ * orient them, and the distance volume are computed in parallel with
+ * vtkSMPTools. The normals of each connected piece of the point cloud are
+ * oriented consistently with those of its first point.
  */
 
 #ifndef vtkSurfaceReconstructionFilter_h
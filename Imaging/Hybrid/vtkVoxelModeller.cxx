@@ -15,23 +15,28 @@
 #include "vtkVoxelModeller.h"
 
 #include "vtkBitArray.h"
-#include "vtkCell.h"
+#include "vtkGenericCell.h"
 #include "vtkImageData.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
+#include <algorithm>
 #include <cmath>
+#include <vector>
 
 vtkStandardNewMacro(vtkVoxelModeller);
 
 // Construct an instance of vtkVoxelModeller with its sample dimensions
 // set to (50,50,50), and so that the model bounds are
 // automatically computed from its input. The maximum distance is set to
-// examine the whole grid. This could be made much faster, and probably
-// will be in the future.
+// examine the whole grid.
 vtkVoxelModeller::vtkVoxelModeller()
 {
   this->MaximumDistance = 1.0;
@@ -108,6 +113,147 @@ int vtkVoxelModeller::RequestInformation(vtkInformation* vtkNotUsed(request),
   return 1;
 }
 
+namespace
+{
+// Compute the range of voxel indices that a cell, with its bounds grown by
+// a margin, can overlap.
+void vtkVoxelModellerCellRange(const double bounds[6], const double margin[3],
+  const double origin[3], const double spacing[3], const int dimensions[3], int min[3], int max[3])
+{
+  for (int i = 0; i < 3; i++)
+  {
+    min[i] = static_cast<int>((bounds[2 * i] - margin[i] - origin[i]) / spacing[i]);
+    max[i] = static_cast<int>((bounds[2 * i + 1] + margin[i] - origin[i]) / spacing[i]);
+    if (min[i] < 0)
+    {
+      min[i] = 0;
+    }
+    if (max[i] >= dimensions[i])
+    {
+      max[i] = dimensions[i] - 1;
+    }
+  }
+}
+
+// Find the range of slices that each cell overlaps.
+struct vtkVoxelModellerSliceRanges
+{
+  vtkDataSet* Input;
+  const double* Margin;
+  const double* Origin;
+  const double* Spacing;
+  const int* Dimensions;
+  int* FirstSlices;
+  int* LastSlices;
+  vtkSMPThreadLocalObject<vtkGenericCell> Cell;
+
+  vtkVoxelModellerSliceRanges(vtkDataSet* input, const double margin[3], const double origin[3],
+    const double spacing[3], const int dimensions[3], int* firstSlices, int* lastSlices)
+    : Input(input)
+    , Margin(margin)
+    , Origin(origin)
+    , Spacing(spacing)
+    , Dimensions(dimensions)
+    , FirstSlices(firstSlices)
+    , LastSlices(lastSlices)
+  {
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkGenericCell* cell = this->Cell.Local();
+    int min[3], max[3];
+    for (vtkIdType cellNum = begin; cellNum < end; cellNum++)
+    {
+      this->Input->GetCell(cellNum, cell);
+      vtkVoxelModellerCellRange(
+        cell->GetBounds(), this->Margin, this->Origin, this->Spacing, this->Dimensions, min, max);
+      this->FirstSlices[cellNum] = min[2];
+      this->LastSlices[cellNum] = max[2];
+    }
+  }
+};
+
+// Voxelize a range of slices: a voxel is occupied if the closest point of
+// one of the cells that overlap its slice lies within the voxel.
+struct vtkVoxelModellerSlices
+{
+  vtkDataSet* Input;
+  const vtkIdType* Offsets; // the cells of slice k are Cells[Offsets[k]] to Cells[Offsets[k+1]-1]
+  const vtkIdType* Cells;
+  const double* Margin;
+  const double* Origin;
+  const double* Spacing;
+  const int* Dimensions;
+  unsigned char* Occupied;
+  vtkSMPThreadLocalObject<vtkGenericCell> Cell;
+  vtkSMPThreadLocal<std::vector<double>> Weights;
+
+  vtkVoxelModellerSlices(vtkDataSet* input, const vtkIdType* offsets, const vtkIdType* cells,
+    const double margin[3], const double origin[3], const double spacing[3],
+    const int dimensions[3], unsigned char* occupied)
+    : Input(input)
+    , Offsets(offsets)
+    , Cells(cells)
+    , Margin(margin)
+    , Origin(origin)
+    , Spacing(spacing)
+    , Dimensions(dimensions)
+    , Occupied(occupied)
+  {
+  }
+
+  void operator()(vtkIdType kBegin, vtkIdType kEnd)
+  {
+    vtkGenericCell* cell = this->Cell.Local();
+    std::vector<double>& weights = this->Weights.Local();
+    weights.resize(this->Input->GetMaxCellSize());
+
+    // Voxel widths are 1/2 the height, width, length of a voxel
+    double voxelHalfWidth[3];
+    for (int i = 0; i < 3; i++)
+    {
+      voxelHalfWidth[i] = this->Spacing[i] / 2.0;
+    }
+    vtkIdType jkFactor = static_cast<vtkIdType>(this->Dimensions[0]) * this->Dimensions[1];
+    int subId, min[3], max[3];
+    double x[3], closestPoint[3], pcoords[3], distance2;
+
+    for (vtkIdType k = kBegin; k < kEnd; k++)
+    {
+      x[2] = this->Spacing[2] * k + this->Origin[2];
+      for (vtkIdType c = this->Offsets[k]; c < this->Offsets[k + 1]; c++)
+      {
+        this->Input->GetCell(this->Cells[c], cell);
+        vtkVoxelModellerCellRange(
+          cell->GetBounds(), this->Margin, this->Origin, this->Spacing, this->Dimensions, min, max);
+        for (int j = min[1]; j <= max[1]; j++)
+        {
+          x[1] = this->Spacing[1] * j + this->Origin[1];
+          for (int i = min[0]; i <= max[0]; i++)
+          {
+            vtkIdType idx = jkFactor * k + this->Dimensions[0] * j + i;
+            if (!this->Occupied[idx])
+            {
+              x[0] = this->Spacing[0] * i + this->Origin[0];
+
+              if (cell->EvaluatePosition(x, closestPoint, subId, pcoords, distance2,
+                    weights.data()) != -1 &&
+                ((fabs(closestPoint[0] - x[0]) <= voxelHalfWidth[0]) &&
+                  (fabs(closestPoint[1] - x[1]) <= voxelHalfWidth[1]) &&
+                  (fabs(closestPoint[2] - x[2]) <= voxelHalfWidth[2])))
+              {
+                this->Occupied[idx] = 1;
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+};
+}
+
 int vtkVoxelModeller::RequestData(vtkInformation* vtkNotUsed(request),
   vtkInformationVector** inputVector, vtkInformationVector* outputVector)
 {
@@ -125,19 +271,10 @@ int vtkVoxelModeller::RequestData(vtkInformation* vtkNotUsed(request),
   output->AllocateScalars(outInfo);
 
   vtkIdType cellNum, i;
-  int j, k;
-  const double* bounds;
-  double adjBounds[6];
-  vtkCell* cell;
-  double maxDistance, pcoords[3];
-  vtkIdType numPts, idx, numCells;
-  int subId;
-  int min[3], max[3];
-  double x[3], distance2;
-  int jkFactor;
-  double* weights = new double[input->GetMaxCellSize()];
-  double closestPoint[3];
-  double voxelHalfWidth[3], origin[3], spacing[3];
+  int k;
+  double maxDistance, margin[3];
+  vtkIdType numPts, numCells;
+  double origin[3], spacing[3];
   vtkDataArray* newScalars = output->GetPointData()->GetScalars();
 
   //
@@ -145,7 +282,8 @@ int vtkVoxelModeller::RequestData(vtkInformation* vtkNotUsed(request),
   //
   vtkDebugMacro(<< "Executing Voxel model");
 
-  numPts = this->SampleDimensions[0] * this->SampleDimensions[1] * this->SampleDimensions[2];
+  numPts = static_cast<vtkIdType>(this->SampleDimensions[0]) * this->SampleDimensions[1] *
+    this->SampleDimensions[2];
   for (i = 0; i < numPts; i++)
   {
     newScalars->SetComponent(i, 0, this->BackgroundValue);
@@ -155,68 +293,74 @@ int vtkVoxelModeller::RequestData(vtkInformation* vtkNotUsed(request),
   outInfo->Set(vtkDataObject::SPACING(), spacing, 3);
   outInfo->Set(vtkDataObject::ORIGIN(), origin, 3);
   //
-  // Voxel widths are 1/2 the height, width, length of a voxel
+  // A voxel can only be occupied by a cell whose bounds it overlaps, so the
+  // cell bounds are grown by a voxel at most rather than by the whole
+  // maximum distance.
   //
   for (i = 0; i < 3; i++)
   {
-    voxelHalfWidth[i] = spacing[i] / 2.0;
+    margin[i] = std::min(maxDistance, spacing[i]);
+  }
+
+  numCells = input->GetNumberOfCells();
+  if (numCells < 1)
+  {
+    return 1;
   }
+  // make GetCell() thread safe, see vtkDataSet::GetCell(vtkIdType, vtkGenericCell*)
+  {
+    vtkNew<vtkGenericCell> cell;
+    input->GetCell(0, cell);
+  }
+
   //
-  // Traverse all cells; computing distance function on volume points.
+  // Sort the cells by the slices of the volume that they overlap
   //
-  numCells = input->GetNumberOfCells();
+  std::vector<int> firstSlices(numCells);
+  std::vector<int> lastSlices(numCells);
+  vtkVoxelModellerSliceRanges sliceRanges(input, margin, origin, spacing, this->SampleDimensions,
+    firstSlices.data(), lastSlices.data());
+  vtkSMPTools::For(0, numCells, sliceRanges);
+
+  std::vector<vtkIdType> offsets(this->SampleDimensions[2] + 1, 0);
   for (cellNum = 0; cellNum < numCells; cellNum++)
   {
-    cell = input->GetCell(cellNum);
-    bounds = cell->GetBounds();
-    for (i = 0; i < 3; i++)
+    for (k = firstSlices[cellNum]; k <= lastSlices[cellNum]; k++)
     {
-      adjBounds[2 * i] = bounds[2 * i] - maxDistance;
-      adjBounds[2 * i + 1] = bounds[2 * i + 1] + maxDistance;
+      offsets[k + 1]++;
     }
-
-    // compute dimensional bounds in data set
-    for (i = 0; i < 3; i++)
+  }
+  for (k = 0; k < this->SampleDimensions[2]; k++)
+  {
+    offsets[k + 1] += offsets[k];
+  }
+  std::vector<vtkIdType> cells(offsets[this->SampleDimensions[2]]);
+  std::vector<vtkIdType> ends(offsets.begin(), offsets.end() - 1);
+  for (cellNum = 0; cellNum < numCells; cellNum++)
+  {
+    for (k = firstSlices[cellNum]; k <= lastSlices[cellNum]; k++)
     {
-      min[i] = static_cast<int>(static_cast<double>(adjBounds[2 * i] - origin[i]) / spacing[i]);
-      max[i] = static_cast<int>(static_cast<double>(adjBounds[2 * i + 1] - origin[i]) / spacing[i]);
-      if (min[i] < 0)
-      {
-        min[i] = 0;
-      }
-      if (max[i] >= this->SampleDimensions[i])
-      {
-        max[i] = this->SampleDimensions[i] - 1;
-      }
+      cells[ends[k]++] = cellNum;
     }
+  }
 
-    jkFactor = this->SampleDimensions[0] * this->SampleDimensions[1];
-    for (k = min[2]; k <= max[2]; k++)
-    {
-      x[2] = spacing[2] * k + origin[2];
-      for (j = min[1]; j <= max[1]; j++)
-      {
-        x[1] = spacing[1] * j + origin[1];
-        for (i = min[0]; i <= max[0]; i++)
-        {
-          idx = jkFactor * k + this->SampleDimensions[0] * j + i;
-          if (!(newScalars->GetComponent(idx, 0)))
-          {
-            x[0] = spacing[0] * i + origin[0];
+  //
+  // Traverse the slices in parallel, computing the distance function on
+  // the volume points near each cell.
+  //
+  std::vector<unsigned char> occupied(numPts, 0);
+  vtkVoxelModellerSlices slices(input, offsets.data(), cells.data(), margin, origin, spacing,
+    this->SampleDimensions, occupied.data());
+  vtkSMPTools::For(0, this->SampleDimensions[2], slices);
 
-            if (cell->EvaluatePosition(x, closestPoint, subId, pcoords, distance2, weights) != -1 &&
-              ((fabs(closestPoint[0] - x[0]) <= voxelHalfWidth[0]) &&
-                (fabs(closestPoint[1] - x[1]) <= voxelHalfWidth[1]) &&
-                (fabs(closestPoint[2] - x[2]) <= voxelHalfWidth[2])))
-            {
-              newScalars->SetComponent(idx, 0, this->ForegroundValue);
-            }
-          }
-        }
-      }
+  // as before, only the voxels that hold a zero value are set
+  for (i = 0; i < numPts; i++)
+  {
+    if (occupied[i] && !newScalars->GetComponent(i, 0))
+    {
+      newScalars->SetComponent(i, 0, this->ForegroundValue);
     }
   }
-  delete[] weights;
 
   return 1;
 }
@@ -24,6 +24,8 @@
  * Background values of the output can also be specified.
  * NOTE: Not all vtk filters/readers/writers support the VTK_BIT
  * scalar type. You may want to use VTK_CHAR as an alternative.
+ *
+ * The slices of the output are voxelized in parallel with vtkSMPTools.
  * @sa
  * vtkImplicitModeller
  */
@@ -66,8 +68,10 @@ public:
 
   ///@{
   /**
-   * Specify distance away from surface of input geometry to sample. Smaller
-   * values make large increases in performance. Default is 1.0.
+   * Specify distance away from surface of input geometry to sample. Since
+   * an occupied voxel contains the closest point of a cell, each cell is
+   * only tested against the voxels within this distance, or within one
+   * voxel spacing if that is smaller. Default is 1.0.
    */
   vtkSetClampMacro(MaximumDistance, double, 0.0, 1.0);
   vtkGetMacro(MaximumDistance, double);
@@ -0,0 +1,155 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestImageConnectivityFilterThreads.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Labels the regions of a noisy image with vtkImageConnectivityFilter,
+// and checks that the labels and the region sizes match those of a flood
+// fill, in raster order, for any number of threads.
+
+#include "vtkDataArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkImageConnectivityFilter.h"
+#include "vtkImageData.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkSMPTools.h"
+
+#include <vector>
+
+namespace
+{
+const int Size[3] = { 61, 47, 29 };
+
+// Label the voxels with a value of 1 by flood fill, in the order in which
+// the regions are reached by a raster scan.
+void FloodFill(vtkImageData* image, std::vector<int>& labels, std::vector<vtkIdType>& sizes)
+{
+  vtkDataArray* scalars = image->GetPointData()->GetScalars();
+  vtkIdType n = scalars->GetNumberOfTuples();
+  vtkIdType inc[3] = { 1, Size[0], static_cast<vtkIdType>(Size[0]) * Size[1] };
+  labels.assign(n, 0);
+  sizes.clear();
+  std::vector<vtkIdType> stack;
+  for (vtkIdType i = 0; i < n; ++i)
+  {
+    if (labels[i] != 0 || scalars->GetTuple1(i) != 1)
+    {
+      continue;
+    }
+    int label = static_cast<int>(sizes.size()) + 1;
+    vtkIdType size = 0;
+    labels[i] = label;
+    stack.push_back(i);
+    while (!stack.empty())
+    {
+      vtkIdType j = stack.back();
+      stack.pop_back();
+      ++size;
+      for (int k = 0; k < 3; ++k)
+      {
+        int idx = static_cast<int>((j / inc[k]) % Size[k]);
+        for (int step = -1; step <= 1; step += 2)
+        {
+          vtkIdType neighbor = j + step * inc[k];
+          if (idx + step >= 0 && idx + step < Size[k] && labels[neighbor] == 0 &&
+            scalars->GetTuple1(neighbor) == 1)
+          {
+            labels[neighbor] = label;
+            stack.push_back(neighbor);
+          }
+        }
+      }
+    }
+    sizes.push_back(size);
+  }
+}
+
+bool CheckLabels(vtkImageConnectivityFilter* filter, const std::vector<int>& labels,
+  const std::vector<vtkIdType>& sizes)
+{
+  filter->Modified();
+  filter->Update();
+  vtkDataArray* output = filter->GetOutput()->GetPointData()->GetScalars();
+  for (vtkIdType i = 0; i < output->GetNumberOfTuples(); ++i)
+  {
+    if (output->GetTuple1(i) != labels[i])
+    {
+      cerr << "Voxel " << i << " has label " << output->GetTuple1(i) << " instead of "
+           << labels[i] << "\n";
+      return false;
+    }
+  }
+  vtkIdTypeArray* regionSizes = filter->GetExtractedRegionSizes();
+  if (filter->GetNumberOfExtractedRegions() != static_cast<vtkIdType>(sizes.size()))
+  {
+    cerr << filter->GetNumberOfExtractedRegions() << " regions instead of " << sizes.size()
+         << "\n";
+    return false;
+  }
+  for (size_t i = 0; i < sizes.size(); ++i)
+  {
+    if (regionSizes->GetValue(i) != sizes[i])
+    {
+      cerr << "Region " << i << " has size " << regionSizes->GetValue(i) << " instead of "
+           << sizes[i] << "\n";
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int TestImageConnectivityFilterThreads(int, char*[])
+{
+  // blobs that span many rows and slices, plus noise
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(Size[0], Size[1], Size[2]);
+  image->AllocateScalars(VTK_UNSIGNED_CHAR, 1);
+  vtkDataArray* scalars = image->GetPointData()->GetScalars();
+  unsigned int state = 12345;
+  for (vtkIdType i = 0; i < scalars->GetNumberOfTuples(); ++i)
+  {
+    int x = static_cast<int>(i % Size[0]);
+    int y = static_cast<int>((i / Size[0]) % Size[1]);
+    int z = static_cast<int>(i / (Size[0] * Size[1]));
+    bool blob = ((x / 5 + 2 * (y / 4) + 3 * (z / 3)) % 4) < 2;
+    state = state * 1103515245u + 12345u;
+    bool noise = ((state >> 16) % 100) < 10;
+    scalars->SetTuple1(i, (blob != noise) ? 1 : 0);
+  }
+
+  std::vector<int> labels;
+  std::vector<vtkIdType> sizes;
+  FloodFill(image, labels, sizes);
+
+  vtkNew<vtkImageConnectivityFilter> filter;
+  filter->SetInputData(image);
+  filter->SetScalarRange(1, 1);
+  filter->SetLabelScalarTypeToInt();
+  filter->SetLabelModeToSeedScalar();
+  filter->SetExtractionModeToAllRegions();
+
+  for (int threads : { 1, 2, 3, 8 })
+  {
+    bool success = true;
+    vtkSMPTools::Config config;
+    config.MaxNumberOfThreads = threads;
+    vtkSMPTools::LocalScope(config, [&]() { success = CheckLabels(filter, labels, sizes); });
+    if (!success)
+    {
+      cerr << "With " << threads << " threads\n";
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
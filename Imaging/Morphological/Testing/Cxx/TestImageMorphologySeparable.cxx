@@ -0,0 +1,122 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestImageMorphologySeparable.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Runs the morphology filters with the Separable algorithm, for ellipsoid
+// and box footprints of odd and even sizes, some of them larger than the
+// image, and checks that the output matches the Neighborhood algorithm.
+
+#include "vtkDataArray.h"
+#include "vtkImageContinuousDilate3D.h"
+#include "vtkImageContinuousErode3D.h"
+#include "vtkImageData.h"
+#include "vtkImageDilateErode3D.h"
+#include "vtkImageOpenClose3D.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+
+#include <cmath>
+
+namespace
+{
+const int Size[3] = { 29, 21, 13 };
+
+// Run the filter with both algorithms and compare the outputs.
+template <class TFilter>
+bool CheckFilter(TFilter* filter, const char* name, const int kernel[3], int shape)
+{
+  filter->SetKernelSize(kernel[0], kernel[1], kernel[2]);
+  filter->SetKernelShape(shape);
+  filter->SetAlgorithm(vtkImageDilateErode3D::Neighborhood);
+  filter->Update();
+  vtkNew<vtkImageData> expected;
+  expected->DeepCopy(filter->GetOutput());
+  filter->SetAlgorithm(vtkImageDilateErode3D::Separable);
+  filter->Update();
+
+  vtkDataArray* a = expected->GetPointData()->GetScalars();
+  vtkDataArray* b = filter->GetOutput()->GetPointData()->GetScalars();
+  for (vtkIdType i = 0; i < a->GetNumberOfTuples(); ++i)
+  {
+    for (int c = 0; c < a->GetNumberOfComponents(); ++c)
+    {
+      if (a->GetComponent(i, c) != b->GetComponent(i, c))
+      {
+        cerr << name << " " << a->GetDataTypeAsString() << " kernel " << kernel[0] << "x"
+             << kernel[1] << "x" << kernel[2] << " shape " << shape << ": voxel " << i
+             << " component " << c << " is " << b->GetComponent(i, c) << " instead of "
+             << a->GetComponent(i, c) << "\n";
+        return false;
+      }
+    }
+  }
+  return true;
+}
+}
+
+int TestImageMorphologySeparable(int, char*[])
+{
+  struct ImageType
+  {
+    int ScalarType;
+    int NumberOfComponents;
+  };
+  const ImageType types[] = { { VTK_UNSIGNED_CHAR, 1 }, { VTK_SHORT, 2 }, { VTK_FLOAT, 1 },
+    { VTK_DOUBLE, 3 } };
+  const int kernels[][3] = { { 3, 3, 3 }, { 5, 1, 3 }, { 4, 6, 2 }, { 11, 9, 7 },
+    { 1, 1, 1 }, { 41, 5, 31 } };
+
+  unsigned int state = 97531;
+  for (const ImageType& type : types)
+  {
+    // values 0 and 255 with some noise, for the binary filters
+    vtkNew<vtkImageData> image;
+    image->SetDimensions(Size[0], Size[1], Size[2]);
+    image->AllocateScalars(type.ScalarType, type.NumberOfComponents);
+    vtkDataArray* scalars = image->GetPointData()->GetScalars();
+    for (vtkIdType i = 0; i < scalars->GetNumberOfTuples(); ++i)
+    {
+      for (int c = 0; c < type.NumberOfComponents; ++c)
+      {
+        state = state * 1103515245u + 12345u;
+        int r = (state >> 16) % 100;
+        scalars->SetComponent(i, c, r < 80 ? 255.0 : (r < 95 ? 0.0 : r));
+      }
+    }
+
+    vtkNew<vtkImageContinuousDilate3D> dilate;
+    dilate->SetInputData(image);
+    vtkNew<vtkImageContinuousErode3D> erode;
+    erode->SetInputData(image);
+    vtkNew<vtkImageDilateErode3D> dilateErode;
+    dilateErode->SetInputData(image);
+    vtkNew<vtkImageOpenClose3D> openClose;
+    openClose->SetInputData(image);
+
+    for (const int* kernel : kernels)
+    {
+      for (int shape : { vtkImageDilateErode3D::Ellipsoid, vtkImageDilateErode3D::Box })
+      {
+        if (!CheckFilter(dilate.GetPointer(), "Dilate", kernel, shape) ||
+          !CheckFilter(erode.GetPointer(), "Erode", kernel, shape) ||
+          !CheckFilter(dilateErode.GetPointer(), "DilateErode", kernel, shape) ||
+          !CheckFilter(openClose.GetPointer(), "OpenClose", kernel, shape))
+        {
+          return EXIT_FAILURE;
+        }
+      }
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -49,9 +49,7 @@
 #include "vtkDataSet.h"
 #include "vtkIdTypeArray.h"
 #include "vtkImageData.h"
-#include "vtkImageIterator.h"
 #include "vtkImageStencilData.h"
-#include "vtkImageStencilIterator.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkIntArray.h"
@@ -59,6 +57,7 @@
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPoints.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTemplateAliasMacro.h"
@@ -66,7 +65,9 @@
 #include "vtkVersion.h"
 
 #include <algorithm>
-#include <stack>
+#include <functional>
+#include <queue>
+#include <utility>
 #include <vector>
 
 vtkStandardNewMacro(vtkImageConnectivityFilter);
@@ -258,87 +259,65 @@ public:
   // A class that is a vector of regions.
   class RegionVector;
 
+  // The runs of voxels along the rows of the image, and their components.
+  struct RunData;
+
 protected:
-  // Simple class that holds a seed location and a scalar value.
-  class Seed;
+  // A list of regions that is pruned when the labels run out.
+  class RegionList;
 
   // A functor to assist in comparing region sizes.
   struct CompareSize;
 
-  // Remove all but the largest region from the output image.
-  template <class OT>
-  static void PruneAllButLargest(vtkImageData* outData, OT* outPtr, vtkImageStencilData* stencil,
-    int extent[6], const OT& value, vtkICF::RegionVector& regionInfo);
-
-  // Remove the smallest region from the output image.
-  // This is called when there are no labels left, i.e. when the label
-  // value reaches the maximum allowed by the output data type.
-  template <class OT>
-  static void PruneSmallestRegion(vtkImageData* outData, OT* outPtr, vtkImageStencilData* stencil,
-    int extent[6], vtkICF::RegionVector& regionInfo);
+  // Find the root of a run in the union-find forest.
+  static vtkIdType FindRoot(vtkIdType* parent, vtkIdType i);
 
-  // Remove all islands that aren't in the given range of sizes
-  template <class OT>
-  static void PruneBySize(vtkImageData* outData, OT* outPtr, vtkImageStencilData* stencil,
-    int extent[6], vtkIdType sizeRange[2], vtkICF::RegionVector& regionInfo);
-
-  // This is the function that grows a region from a seed.
-  template <class OT>
-  static vtkIdType Fill(OT* outPtr, vtkIdType outInc[3], int outLimits[6], unsigned char* maskPtr,
-    int maxIdx[3], int fillExtent[6], std::stack<vtkICF::Seed>& seedStack);
+  // Join the components of two runs.
+  static void Union(vtkIdType* parent, vtkIdType i, vtkIdType j);
 
-  // Add a region to the list of regions.
-  template <class OT>
-  static void AddRegion(vtkImageData* outData, OT* outPtr, vtkImageStencilData* stencil,
-    int extent[6], vtkIdType sizeRange[2], vtkICF::RegionVector& regionInfo, vtkIdType voxelCount,
-    vtkIdType regionId, int regionExtent[6], int extractionMode);
+  // Join the components of the overlapping runs of two adjacent rows,
+  // where the runs of the rows are [a0, a1) and [b0, b1).
+  static void ConnectRows(const int* runStart, const int* runEnd, vtkIdType* parent, vtkIdType a0,
+    vtkIdType a1, vtkIdType b0, vtkIdType b1);
 
   // Fill the ExtractedRegionSizes and ExtractedRegionLabels arrays.
   static void GenerateRegionArrays(vtkImageConnectivityFilter* self,
     vtkICF::RegionVector& regionInfo, vtkDataArray* seedScalars, int extent[6], int minLabel,
     int maxLabel);
 
-  // Relabel the image, usually the last method called.
-  template <class OT>
-  static void Relabel(vtkImageData* outData, OT* outPtr, vtkImageStencilData* stencil,
-    int extent[6], vtkIdTypeArray* labelMap);
-
   // Sort the ExtractedRegionLabels array and the other arrays.
   static void SortRegionArrays(vtkImageConnectivityFilter* self);
 
-  // Finalize the output
-  template <class OT>
-  static void Finish(vtkImageConnectivityFilter* self, vtkImageData* outData, OT* outPtr,
-    vtkImageStencilData* stencil, int extent[6], vtkDataArray* seedScalars,
-    vtkICF::RegionVector& regionInfo);
+  // Get the size and extent of each component.
+  static void GenerateComponentInfo(vtkImageConnectivityFilter* self,
+    const vtkICF::RunData& runs, std::vector<vtkICF::Region>& components);
 
-  // Subtract the lower extent limit from "limits", and return the
-  // extent size subtract 1 in maxIdx.
-  static int* ZeroBaseExtent(const int wholeExtent[6], int extent[6], int maxIdx[3]);
-
-  // Execute method for when point seeds are provided.
-  template <class OT>
+  // Add the regions of the components that contain the seeds.
   static void SeededExecute(vtkImageConnectivityFilter* self, vtkImageData* outData,
-    vtkDataSet* seedData, vtkImageStencilData* stencil, OT* outPtr, unsigned char* maskPtr,
-    int extent[6], vtkICF::RegionVector& regionInfo);
+    vtkDataSet* seedData, int extent[6], const vtkICF::RunData& runs,
+    const std::vector<vtkICF::Region>& components, std::vector<char>& claimed,
+    vtkICF::RegionList& regionList);
+
+  // Add the regions of the components that were not claimed by a seed.
+  static void SeedlessExecute(const std::vector<vtkICF::Region>& components,
+    const std::vector<char>& claimed, vtkICF::RegionList& regionList, vtkIdType maxLabel);
 
-  // Execute method for when no seeds are provided.
+  // Write the labels of the components to the output.
   template <class OT>
-  static void SeedlessExecute(vtkImageConnectivityFilter* self, vtkImageData* outData,
-    vtkImageStencilData* stencil, OT* outPtr, unsigned char* maskPtr, int extent[6],
-    vtkICF::RegionVector& regionInfo);
+  static void WriteLabels(vtkImageData* outData, OT* outPtr, int extent[6],
+    const vtkICF::RunData& runs, const std::vector<OT>& labels);
 
 public:
-  // Create a bit mask from the input
+  // Find the runs of voxels that are within the scalar range and the
+  // stencil, and label their connected components.
   template <class IT>
   static void ExecuteInput(vtkImageConnectivityFilter* self, vtkImageData* inData, IT* inPtr,
-    unsigned char* maskPtr, vtkImageStencilData* stencil, int extent[6]);
+    vtkImageStencilData* stencil, int extent[6], vtkICF::RunData& runs);
 
   // Generate the output
   template <class OT>
   static void ExecuteOutput(vtkImageConnectivityFilter* self, vtkImageData* outData,
-    vtkDataSet* seedData, vtkImageStencilData* stencil, OT* outPtr, unsigned char* maskPtr,
-    int extent[6]);
+    vtkDataSet* seedData, OT* outPtr, int extent[6], const vtkICF::RunData& runs);
 
   // Utility method to find the intersection of two extents.
   // Returns false if the extents do not intersect.
@@ -346,57 +325,13 @@ public:
 };
 
 //------------------------------------------------------------------------------
-// seed struct: structured coordinates and a value,
-// the coords can be accessed with [] and the value with *
-class vtkICF::Seed
-{
-public:
-  Seed(int i, int j, int k, int v)
-  {
-    pos[0] = i;
-    pos[1] = j;
-    pos[2] = k;
-    value = v;
-  }
-
-  Seed(const vtkICF::Seed& seed)
-  {
-    pos[0] = seed.pos[0];
-    pos[1] = seed.pos[1];
-    pos[2] = seed.pos[2];
-    value = seed.value;
-  }
-
-  int& operator[](int i) { return pos[i]; }
-
-  int& operator*() { return value; }
-
-  vtkICF::Seed& operator=(const vtkICF::Seed& seed)
-  {
-    if (this == &seed)
-    {
-      return *this;
-    }
-
-    pos[0] = seed.pos[0];
-    pos[1] = seed.pos[1];
-    pos[2] = seed.pos[2];
-    value = seed.value;
-    return *this;
-  }
-
-private:
-  int pos[3];
-  int value;
-};
-
-//------------------------------------------------------------------------------
-// region struct: size and id
+// region struct: size, id, and the connected component of the region
 struct vtkICF::Region
 {
   Region(vtkIdType s, vtkIdType i, const int e[6])
     : size(s)
     , id(i)
+    , component(-1)
   {
     extent[0] = e[0];
     extent[1] = e[1];
@@ -408,6 +343,7 @@ struct vtkICF::Region
   Region()
     : size(0)
     , id(0)
+    , component(-1)
   {
     extent[0] = extent[1] = extent[2] = 0;
     extent[3] = extent[4] = extent[5] = 0;
@@ -415,6 +351,7 @@ struct vtkICF::Region
 
   vtkIdType size;
   vtkIdType id;
+  vtkIdType component;
   int extent[6];
 };
 
@@ -461,6 +398,183 @@ public:
   }
 };
 
+//------------------------------------------------------------------------------
+// The voxels that are within the scalar range and the stencil, stored as
+// runs along x.  The rows are numbered y + z*Size[1] from the lower corner
+// of the extent, and the runs are stored in raster order, so the runs of a
+// row are [RowStart[row], RowStart[row + 1]).
+struct vtkICF::RunData
+{
+  // the number of voxels along each axis of the extent
+  int Size[3];
+  // the first run of each row, plus the total number of runs
+  std::vector<vtkIdType> RowStart;
+  // the first and last x index of each run, from the lower x of the extent
+  std::vector<int> RunStart;
+  std::vector<int> RunEnd;
+  // the connected component of each run, components are numbered in the
+  // raster order of their first voxel
+  std::vector<vtkIdType> Component;
+  vtkIdType NumberOfComponents;
+
+  // find the run that contains the voxel, or return -1
+  vtkIdType FindRun(const int idx[3]) const
+  {
+    vtkIdType row = idx[1] + static_cast<vtkIdType>(idx[2]) * this->Size[1];
+    auto first = this->RunStart.begin() + this->RowStart[row];
+    auto last = this->RunStart.begin() + this->RowStart[row + 1];
+    // the last run that starts at or before the voxel
+    auto run = std::upper_bound(first, last, idx[0]);
+    if (run == first)
+    {
+      return -1;
+    }
+    vtkIdType i = std::distance(this->RunStart.begin(), run) - 1;
+    return (this->RunEnd[i] >= idx[0] ? i : -1);
+  }
+};
+
+//------------------------------------------------------------------------------
+// The regions in the order that they were found, with the regions removed
+// that the label image would have lost when its label values ran out:
+// the regions outside of the size range first, then either the smallest
+// region or all but the largest region.
+class vtkICF::RegionList
+{
+public:
+  RegionList(vtkIdType maxLabel, const vtkIdType sizeRange[2], int extractionMode)
+    : MaxLabel(maxLabel)
+    , LargestOnly(extractionMode == vtkImageConnectivityFilter::LargestRegion)
+    , Survivor(-1)
+    , FirstUnpruned(0)
+    , NumberOfRegions(0)
+  {
+    this->SizeRange[0] = sizeRange[0];
+    this->SizeRange[1] = sizeRange[1];
+  }
+
+  // the number of regions, including the background
+  vtkIdType GetNumberOfLabels() const { return this->NumberOfRegions + 1; }
+
+  // add a region to the end of the list
+  void AddRegion(const vtkICF::Region& region)
+  {
+    vtkIdType i = static_cast<vtkIdType>(this->Regions.size());
+    this->Regions.push_back(region);
+    this->Removed.push_back(0);
+    this->NumberOfRegions++;
+    if (!this->InRange(region.size))
+    {
+      this->OutOfRange.push_back(i);
+    }
+    else if (!this->LargestOnly)
+    {
+      // ties go to the region that was found last
+      this->Smallest.push(std::make_pair(region.size, -i));
+    }
+
+    // check if the label value has reached its maximum, and if so,
+    // remove some of the regions
+    if (this->GetNumberOfLabels() > this->MaxLabel)
+    {
+      for (vtkIdType j : this->OutOfRange)
+      {
+        this->Remove(j);
+      }
+      this->OutOfRange.clear();
+
+      // if that didn't remove anything, try these:
+      if (this->GetNumberOfLabels() > this->MaxLabel)
+      {
+        if (this->LargestOnly)
+        {
+          this->PruneAllButLargest();
+        }
+        else
+        {
+          this->PruneSmallestRegion();
+        }
+      }
+    }
+  }
+
+  // append the remaining regions that are within the size range
+  void GetRegions(vtkICF::RegionVector& regionInfo) const
+  {
+    size_t n = this->Regions.size();
+    for (size_t i = 0; i < n; i++)
+    {
+      if (!this->Removed[i] && this->InRange(this->Regions[i].size))
+      {
+        regionInfo.push_back(this->Regions[i]);
+      }
+    }
+  }
+
+private:
+  bool InRange(vtkIdType s) const { return (s >= this->SizeRange[0] && s <= this->SizeRange[1]); }
+
+  void Remove(vtkIdType i)
+  {
+    this->Removed[i] = 1;
+    this->NumberOfRegions--;
+  }
+
+  void PruneSmallestRegion()
+  {
+    while (this->Removed[-this->Smallest.top().second])
+    {
+      this->Smallest.pop();
+    }
+    this->Remove(-this->Smallest.top().second);
+    this->Smallest.pop();
+  }
+
+  void PruneAllButLargest()
+  {
+    // only the survivor of the last pruning and the regions that were
+    // added since then remain, the first of the largest is kept
+    vtkIdType n = static_cast<vtkIdType>(this->Regions.size());
+    vtkIdType largest = this->Survivor;
+    for (vtkIdType i = this->FirstUnpruned; i < n; i++)
+    {
+      if (!this->Removed[i] && (largest < 0 || this->Regions[i].size > this->Regions[largest].size))
+      {
+        largest = i;
+      }
+    }
+    if (this->Survivor >= 0 && this->Survivor != largest)
+    {
+      this->Remove(this->Survivor);
+    }
+    for (vtkIdType i = this->FirstUnpruned; i < n; i++)
+    {
+      if (!this->Removed[i] && i != largest)
+      {
+        this->Remove(i);
+      }
+    }
+    this->Survivor = largest;
+    this->FirstUnpruned = n;
+  }
+
+  vtkIdType MaxLabel;
+  vtkIdType SizeRange[2];
+  bool LargestOnly;
+  std::vector<vtkICF::Region> Regions;
+  std::vector<char> Removed;
+  // the regions outside the size range that have not been removed
+  std::vector<vtkIdType> OutOfRange;
+  // the regions within the size range, by size and then by reverse order
+  std::priority_queue<std::pair<vtkIdType, vtkIdType>,
+    std::vector<std::pair<vtkIdType, vtkIdType>>, std::greater<std::pair<vtkIdType, vtkIdType>>>
+    Smallest;
+  // for LargestRegion, the region kept by the last pruning
+  vtkIdType Survivor;
+  vtkIdType FirstUnpruned;
+  vtkIdType NumberOfRegions;
+};
+
 //------------------------------------------------------------------------------
 bool vtkICF::IntersectExtents(const int extent1[6], const int extent2[6], int output[6])
 {
@@ -479,10 +593,63 @@ bool vtkICF::IntersectExtents(const int extent1[6], const int extent2[6], int ou
   return rval;
 }
 
+//------------------------------------------------------------------------------
+// Every tree of the forest has the lowest run as its root, and the parent
+// of a run is never after the run.
+vtkIdType vtkICF::FindRoot(vtkIdType* parent, vtkIdType i)
+{
+  while (parent[i] != i)
+  {
+    // path halving
+    parent[i] = parent[parent[i]];
+    i = parent[i];
+  }
+  return i;
+}
+
+//------------------------------------------------------------------------------
+void vtkICF::Union(vtkIdType* parent, vtkIdType i, vtkIdType j)
+{
+  i = vtkICF::FindRoot(parent, i);
+  j = vtkICF::FindRoot(parent, j);
+  if (i < j)
+  {
+    parent[j] = i;
+  }
+  else if (j < i)
+  {
+    parent[i] = j;
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkICF::ConnectRows(const int* runStart, const int* runEnd, vtkIdType* parent, vtkIdType a0,
+  vtkIdType a1, vtkIdType b0, vtkIdType b1)
+{
+  vtkIdType a = a0;
+  vtkIdType b = b0;
+  while (a < a1 && b < b1)
+  {
+    if (runEnd[a] >= runStart[b] && runEnd[b] >= runStart[a])
+    {
+      vtkICF::Union(parent, a, b);
+    }
+    // advance the run that ends first
+    if (runEnd[a] < runEnd[b])
+    {
+      a++;
+    }
+    else
+    {
+      b++;
+    }
+  }
+}
+
 //------------------------------------------------------------------------------
 template <class IT>
-void vtkICF::ExecuteInput(vtkImageConnectivityFilter* self, vtkImageData* inData, IT*,
-  unsigned char* maskPtr, vtkImageStencilData* stencil, int extent[6])
+void vtkICF::ExecuteInput(vtkImageConnectivityFilter* self, vtkImageData* inData, IT* inPtr,
+  vtkImageStencilData* stencil, int extent[6], vtkICF::RunData& runs)
 {
   // Get active component (only one component is thresholded)
   int nComponents = inData->GetNumberOfScalarComponents();
@@ -515,343 +682,177 @@ void vtkICF::ExecuteInput(vtkImageConnectivityFilter* self, vtkImageData* inData
     srange[1] = static_cast<IT>(drange[1]);
   }
 
-  // offset into the mask
-  unsigned char* maskPtr1 = maskPtr;
-  unsigned char bit = 1;
-  unsigned char bits = 0;
-
-  vtkImageStencilIterator<IT> iter(inData, stencil, extent);
-  for (; !iter.IsAtEnd(); iter.NextSpan())
-  {
-    IT* inPtr = iter.BeginSpan();
-    IT* inPtrEnd = iter.EndSpan();
-    if (iter.IsInStencil())
-    {
-      while (inPtr != inPtrEnd)
-      {
-        IT val = inPtr[activeComponent];
-        if (val < srange[0] || val > srange[1])
-        {
-          bits ^= bit;
-        }
-        bit <<= 1;
-        if (bit == 0)
-        {
-          *maskPtr1++ = bits;
-          bits = 0;
-          bit = 1;
-        }
-        inPtr += nComponents;
-      }
-    }
-    else
-    {
-      // set all bits that are outside the stencil region
-      while (inPtr != inPtrEnd)
-      {
-        bits ^= bit;
-        bit <<= 1;
-        if (bit == 0)
-        {
-          *maskPtr1++ = bits;
-          bits = 0;
-          bit = 1;
-        }
-        inPtr += nComponents;
-      }
-    }
-  }
-
-  // write the last byte to the bitmask
-  if (bit != 1)
-  {
-    *maskPtr1++ = bits;
-  }
-}
+  vtkIdType inInc[3];
+  inData->GetIncrements(inInc);
+  inPtr += activeComponent;
 
-//------------------------------------------------------------------------------
-template <class OT>
-void vtkICF::PruneAllButLargest(vtkImageData* outData, OT* outPtr, vtkImageStencilData* stencil,
-  int extent[6], const OT& value, vtkICF::RegionVector& regionInfo)
-{
-  // clip the extent with the output extent
-  int outExt[6];
-  outData->GetExtent(outExt);
-  if (!vtkICF::IntersectExtents(outExt, extent, outExt))
+  for (int k = 0; k < 3; k++)
   {
-    return;
+    runs.Size[k] = extent[2 * k + 1] - extent[2 * k] + 1;
   }
+  int ySize = runs.Size[1];
+  vtkIdType numRows = static_cast<vtkIdType>(ySize) * runs.Size[2];
 
-  // find the largest region
-  vtkICF::RegionVector::iterator largest = regionInfo.largest();
-  if (largest != regionInfo.end())
+  // The rows are split into blocks that are labeled concurrently, then the
+  // first rows of each block are connected to the rows of the blocks before.
+  struct Block
   {
-    // get its position, remove all other regions from the list
-    OT t = std::distance(regionInfo.begin(), largest);
-    regionInfo[1] = *largest;
-    regionInfo.erase(regionInfo.begin() + 2, regionInfo.end());
-
-    // remove all other regions from the output
-    vtkImageStencilIterator<OT> iter(outData, stencil, outExt);
-    for (; !iter.IsAtEnd(); iter.NextSpan())
+    std::vector<vtkIdType> RowStart;
+    std::vector<int> RunStart;
+    std::vector<int> RunEnd;
+    std::vector<vtkIdType> Parent;
+  };
+  vtkIdType numBlocks = 4 * static_cast<vtkIdType>(vtkSMPTools::GetEstimatedNumberOfThreads());
+  numBlocks = (numBlocks < numRows ? numBlocks : numRows);
+  std::vector<Block> blocks(numBlocks);
+
+  vtkSMPTools::For(0, numBlocks, 1, [&](vtkIdType firstBlock, vtkIdType lastBlock) {
+    for (vtkIdType b = firstBlock; b < lastBlock; b++)
     {
-      if (iter.IsInStencil())
+      Block& block = blocks[b];
+      vtkIdType rowBegin = b * numRows / numBlocks;
+      vtkIdType rowEnd = (b + 1) * numRows / numBlocks;
+      block.RowStart.reserve(rowEnd - rowBegin + 1);
+
+      for (vtkIdType row = rowBegin; row < rowEnd; row++)
       {
-        outPtr = iter.BeginSpan();
-        OT* endPtr = iter.EndSpan();
-        for (; outPtr != endPtr; ++outPtr)
+        int yIdx = static_cast<int>(row % ySize);
+        int zIdx = static_cast<int>(row / ySize);
+        const IT* rowPtr = inPtr + yIdx * inInc[1] + zIdx * inInc[2];
+        vtkIdType rowStart = static_cast<vtkIdType>(block.RunStart.size());
+        block.RowStart.push_back(rowStart);
+
+        // the run that is being grown, it is empty until a voxel is found
+        int runStart = 0;
+        int runEnd = -2;
+
+        // loop through the spans of the stencil within the row
+        int r1 = extent[0];
+        int r2 = extent[1];
+        int iter = 0;
+        bool inStencil = (stencil == nullptr ||
+          stencil->GetNextExtent(
+            r1, r2, extent[0], extent[1], yIdx + extent[2], zIdx + extent[4], iter));
+        while (inStencil)
         {
-          OT v = *outPtr;
-          if (v == t)
-          {
-            *outPtr = value;
-          }
-          else if (v != 0)
+          const IT* ptr = rowPtr + (r1 - extent[0]) * inInc[0];
+          for (int xIdx = r1 - extent[0]; xIdx <= r2 - extent[0]; xIdx++, ptr += inInc[0])
           {
-            *outPtr = 0;
+            IT val = *ptr;
+            if (val < srange[0] || val > srange[1])
+            {
+              continue;
+            }
+            if (xIdx != runEnd + 1)
+            {
+              if (runEnd >= runStart)
+              {
+                block.RunStart.push_back(runStart);
+                block.RunEnd.push_back(runEnd);
+              }
+              runStart = xIdx;
+            }
+            runEnd = xIdx;
           }
+          inStencil = (stencil != nullptr &&
+            stencil->GetNextExtent(
+              r1, r2, extent[0], extent[1], yIdx + extent[2], zIdx + extent[4], iter));
         }
-      }
-    }
-  }
-}
-
-//------------------------------------------------------------------------------
-template <class OT>
-void vtkICF::PruneSmallestRegion(vtkImageData* outData, OT* outPtr, vtkImageStencilData* stencil,
-  int extent[6], vtkICF::RegionVector& regionInfo)
-{
-  // clip the extent with the output extent
-  int outExt[6];
-  outData->GetExtent(outExt);
-  if (!vtkICF::IntersectExtents(outExt, extent, outExt))
-  {
-    return;
-  }
-
-  // find the smallest region
-  vtkICF::RegionVector::iterator smallest = regionInfo.smallest();
-  if (smallest != regionInfo.end())
-  {
-    // get the index to the smallest value and remove it
-    OT t = std::distance(regionInfo.begin(), smallest);
-    regionInfo.erase(smallest);
-
-    // remove the corresponding region from the output
-    vtkImageStencilIterator<OT> iter(outData, stencil, outExt);
-    for (; !iter.IsAtEnd(); iter.NextSpan())
-    {
-      if (iter.IsInStencil())
-      {
-        outPtr = iter.BeginSpan();
-        OT* endPtr = iter.EndSpan();
-        for (; outPtr != endPtr; ++outPtr)
+        if (runEnd >= runStart)
         {
-          OT v = *outPtr;
-          if (v == t)
-          {
-            *outPtr = 0;
-          }
-          else if (v > t)
-          {
-            *outPtr = v - 1;
-          }
+          block.RunStart.push_back(runStart);
+          block.RunEnd.push_back(runEnd);
         }
-      }
-    }
-  }
-}
-
-//------------------------------------------------------------------------------
-template <class OT>
-void vtkICF::PruneBySize(vtkImageData* outData, OT* outPtr, vtkImageStencilData* stencil,
-  int extent[6], vtkIdType sizeRange[2], vtkICF::RegionVector& regionInfo)
-{
-  // find all the regions in the allowed size range
-  size_t n = regionInfo.size();
-  std::vector<OT> newlabels(n);
-  newlabels[0] = 0;
-  size_t m = 1;
-  for (size_t i = 1; i < n; i++)
-  {
-    size_t l = 0;
-    vtkIdType s = regionInfo[i].size;
-    if (s >= sizeRange[0] && s <= sizeRange[1])
-    {
-      l = m++;
-      if (i != l)
-      {
-        regionInfo[l] = regionInfo[i];
-      }
-    }
-    newlabels[i] = static_cast<OT>(l);
-  }
-
-  // were any regions outside of the range?
-  if (m < n)
-  {
-    // resize regionInfo
-    regionInfo.resize(m);
 
-    // clip the extent with the output extent
-    int outExt[6];
-    outData->GetExtent(outExt);
-    if (!vtkICF::IntersectExtents(outExt, extent, outExt))
-    {
-      return;
-    }
-
-    // remove the corresponding regions from the output
-    vtkImageStencilIterator<OT> iter(outData, stencil, outExt);
-    for (; !iter.IsAtEnd(); iter.NextSpan())
-    {
-      if (iter.IsInStencil())
-      {
-        outPtr = iter.BeginSpan();
-        OT* endPtr = iter.EndSpan();
-        for (; outPtr != endPtr; ++outPtr)
+        // connect the runs to the runs of the previous rows of the block
+        vtkIdType rowEndRun = static_cast<vtkIdType>(block.RunStart.size());
+        for (vtkIdType i = rowStart; i < rowEndRun; i++)
         {
-          OT v = *outPtr;
-          if (v != 0)
-          {
-            *outPtr = newlabels[v];
-          }
+          block.Parent.push_back(i);
+        }
+        if (yIdx > 0 && row - 1 >= rowBegin)
+        {
+          vtkIdType j = row - 1 - rowBegin;
+          vtkICF::ConnectRows(block.RunStart.data(), block.RunEnd.data(), block.Parent.data(),
+            rowStart, rowEndRun, block.RowStart[j], block.RowStart[j + 1]);
+        }
+        if (zIdx > 0 && row - ySize >= rowBegin)
+        {
+          vtkIdType j = row - ySize - rowBegin;
+          vtkICF::ConnectRows(block.RunStart.data(), block.RunEnd.data(), block.Parent.data(),
+            rowStart, rowEndRun, block.RowStart[j], block.RowStart[j + 1]);
         }
       }
     }
-  }
-}
+  });
 
-//------------------------------------------------------------------------------
-// Perform a flood fill for each given seed.
-template <class OT>
-vtkIdType vtkICF::Fill(OT* outPtr, vtkIdType outInc[3], int outLimits[6], unsigned char* maskPtr,
-  int maxIdx[3], int fillExtent[6], std::stack<vtkICF::Seed>& seedStack)
-{
-  vtkIdType counter = 0;
-
-  while (!seedStack.empty())
+  // gather the blocks into the run data
+  std::vector<vtkIdType> blockStart(numBlocks + 1);
+  blockStart[0] = 0;
+  for (vtkIdType b = 0; b < numBlocks; b++)
   {
-    // get the seed at the top of the stack
-    vtkICF::Seed seed = seedStack.top();
-    seedStack.pop();
-
-    // get the offset into the bitmask
-    vtkIdType bitOffset = seed[2];
-    bitOffset = bitOffset * (maxIdx[1] + 1) + seed[1];
-    bitOffset = bitOffset * (maxIdx[0] + 1) + seed[0];
-    unsigned char bit = 1 << static_cast<unsigned char>(bitOffset & 0x7);
-    unsigned char* maskPtr1 = maskPtr + (bitOffset >> 3);
-
-    // if already colored, skip
-    if ((*maskPtr1 & bit) != 0)
-    {
-      continue;
-    }
-
-    // paint the mask and count the voxel
-    *maskPtr1 ^= bit;
-    counter++;
-
-    if (fillExtent != nullptr)
+    blockStart[b + 1] = blockStart[b] + static_cast<vtkIdType>(blocks[b].RunStart.size());
+  }
+  vtkIdType numRuns = blockStart[numBlocks];
+  runs.RowStart.resize(numRows + 1);
+  runs.RowStart[numRows] = numRuns;
+  runs.RunStart.resize(numRuns);
+  runs.RunEnd.resize(numRuns);
+  runs.Component.resize(numRuns);
+
+  vtkSMPTools::For(0, numBlocks, 1, [&](vtkIdType firstBlock, vtkIdType lastBlock) {
+    for (vtkIdType b = firstBlock; b < lastBlock; b++)
     {
-      if (seed[0] < fillExtent[0])
+      Block& block = blocks[b];
+      vtkIdType offset = blockStart[b];
+      vtkIdType rowBegin = b * numRows / numBlocks;
+      for (size_t j = 0; j < block.RowStart.size(); j++)
       {
-        fillExtent[0] = seed[0];
+        runs.RowStart[rowBegin + j] = block.RowStart[j] + offset;
       }
-      if (seed[0] > fillExtent[1])
+      std::copy(block.RunStart.begin(), block.RunStart.end(), runs.RunStart.begin() + offset);
+      std::copy(block.RunEnd.begin(), block.RunEnd.end(), runs.RunEnd.begin() + offset);
+      for (size_t i = 0; i < block.Parent.size(); i++)
       {
-        fillExtent[1] = seed[0];
+        runs.Component[offset + i] = block.Parent[i] + offset;
       }
-      if (seed[1] < fillExtent[2])
-      {
-        fillExtent[2] = seed[1];
-      }
-      if (seed[1] > fillExtent[3])
-      {
-        fillExtent[3] = seed[1];
-      }
-      if (seed[2] < fillExtent[4])
-      {
-        fillExtent[4] = seed[2];
-      }
-      if (seed[2] > fillExtent[5])
-      {
-        fillExtent[5] = seed[2];
-      }
-    }
-
-    if (outLimits == nullptr)
-    {
-      // get the pointer to the seed position in the mask
-      vtkIdType outOffset = (seed[0] * outInc[0] + seed[1] * outInc[1] + seed[2] * outInc[2]);
-
-      // set the output
-      outPtr[outOffset] = static_cast<OT>(*seed);
+      block = Block();
     }
-    else if (seed[0] >= outLimits[0] && seed[0] <= outLimits[1] && seed[1] >= outLimits[2] &&
-      seed[1] <= outLimits[3] && seed[2] >= outLimits[4] && seed[2] <= outLimits[5])
-    {
-      // get the pointer to the seed position in the mask
-      vtkIdType outOffset = ((seed[0] - outLimits[0]) * outInc[0] +
-        (seed[1] - outLimits[2]) * outInc[1] + (seed[2] - outLimits[4]) * outInc[2]);
-
-      // set the output if within output extent
-      outPtr[outOffset] = static_cast<OT>(*seed);
-    }
-
-    // push the new seeds for the six neighbors, make sure offsets in X are
-    // pushed last so that they will be popped first (we want to raster X,
-    // Y, and Z in that order).
-    int i = 3;
-    do
+  });
+
+  // connect the first rows of each block to the rows before the block
+  const int* runStart = runs.RunStart.data();
+  const int* runEnd = runs.RunEnd.data();
+  const vtkIdType* rowStart = runs.RowStart.data();
+  vtkIdType* parent = runs.Component.data();
+  for (vtkIdType b = 1; b < numBlocks; b++)
+  {
+    vtkIdType rowBegin = b * numRows / numBlocks;
+    vtkIdType rowEnd = (b + 1) * numRows / numBlocks;
+    rowEnd = (rowEnd < rowBegin + ySize ? rowEnd : rowBegin + ySize);
+    for (vtkIdType row = rowBegin; row < rowEnd; row++)
     {
-      i--;
-      if (seed[i] > 0)
+      if (row % ySize != 0 && row - 1 < rowBegin)
       {
-        seed[i]--;
-        seedStack.push(seed);
-        seed[i]++;
+        vtkICF::ConnectRows(runStart, runEnd, parent, rowStart[row], rowStart[row + 1],
+          rowStart[row - 1], rowStart[row]);
       }
-      if (seed[i] < maxIdx[i])
+      if (row >= ySize)
       {
-        seed[i]++;
-        seedStack.push(seed);
-        seed[i]--;
+        vtkICF::ConnectRows(runStart, runEnd, parent, rowStart[row], rowStart[row + 1],
+          rowStart[row - ySize], rowStart[row - ySize + 1]);
       }
-    } while (i != 0);
+    }
   }
 
-  return counter;
-}
-
-//------------------------------------------------------------------------------
-template <class OT>
-void vtkICF::AddRegion(vtkImageData* outData, OT* outPtr, vtkImageStencilData* stencil,
-  int extent[6], vtkIdType sizeRange[2], vtkICF::RegionVector& regionInfo, vtkIdType voxelCount,
-  vtkIdType regionId, int regionExtent[6], int extractionMode)
-{
-  regionInfo.push_back(vtkICF::Region(voxelCount, regionId, regionExtent));
-  // check if the label value has reached its maximum, and if so,
-  // remove some of the regions
-  if (regionInfo.size() > static_cast<size_t>(vtkTypeTraits<OT>::Max()))
+  // number the components, every root comes before the rest of its tree
+  vtkIdType numComponents = 0;
+  for (vtkIdType i = 0; i < numRuns; i++)
   {
-    vtkICF::PruneBySize(outData, outPtr, stencil, extent, sizeRange, regionInfo);
-
-    // if that didn't remove anything, try these:
-    if (regionInfo.size() > static_cast<size_t>(vtkTypeTraits<OT>::Max()))
-    {
-      if (extractionMode == vtkImageConnectivityFilter::LargestRegion)
-      {
-        OT label = 1;
-        vtkICF::PruneAllButLargest(outData, outPtr, stencil, extent, label, regionInfo);
-      }
-      else
-      {
-        vtkICF::PruneSmallestRegion(outData, outPtr, stencil, extent, regionInfo);
-      }
-    }
+    vtkIdType p = parent[i];
+    parent[i] = (p == i ? numComponents++ : parent[p]);
   }
+  runs.NumberOfComponents = numComponents;
 }
 
 //------------------------------------------------------------------------------
@@ -1018,43 +1019,6 @@ void vtkICF::GenerateRegionArrays(vtkImageConnectivityFilter* self,
   }
 }
 
-//------------------------------------------------------------------------------
-// generate the output image
-template <class OT>
-void vtkICF::Relabel(vtkImageData* outData, OT* outPtr, vtkImageStencilData* stencil, int extent[6],
-  vtkIdTypeArray* labelMap)
-{
-  // clip the extent with the output extent
-  int outExt[6];
-  outData->GetExtent(outExt);
-  if (!vtkICF::IntersectExtents(outExt, extent, outExt))
-  {
-    return;
-  }
-
-  vtkImageStencilIterator<OT> iter(outData, stencil, outExt);
-
-  // loop through the output voxels and change the "region id" value
-  // stored in the voxel into a "region label" value.
-  for (; !iter.IsAtEnd(); iter.NextSpan())
-  {
-    outPtr = iter.BeginSpan();
-    OT* outEnd = iter.EndSpan();
-
-    if (iter.IsInStencil())
-    {
-      for (; outPtr != outEnd; outPtr++)
-      {
-        OT v = *outPtr;
-        if (v > 0)
-        {
-          *outPtr = labelMap->GetValue(v - 1);
-        }
-      }
-    }
-  }
-}
-
 //------------------------------------------------------------------------------
 void vtkICF::SortRegionArrays(vtkImageConnectivityFilter* self)
 {
@@ -1091,104 +1055,60 @@ void vtkICF::SortRegionArrays(vtkImageConnectivityFilter* self)
 }
 
 //------------------------------------------------------------------------------
-template <class OT>
-void vtkICF::Finish(vtkImageConnectivityFilter* self, vtkImageData* outData, OT* outPtr,
-  vtkImageStencilData* stencil, int extent[6], vtkDataArray* seedScalars,
-  vtkICF::RegionVector& regionInfo)
+void vtkICF::GenerateComponentInfo(vtkImageConnectivityFilter* self,
+  const vtkICF::RunData& runs, std::vector<vtkICF::Region>& components)
 {
-  // Get the execution parameters
-  int labelMode = self->GetLabelMode();
-  int extractionMode = self->GetExtractionMode();
-  vtkIdType sizeRange[2];
-  self->GetSizeRange(sizeRange);
-
-  // get only the regions in the requested range of sizes
-  vtkICF::PruneBySize(outData, outPtr, stencil, extent, sizeRange, regionInfo);
-
-  // create the three region info arrays
-  vtkICF::GenerateRegionArrays(
-    self, regionInfo, seedScalars, extent, vtkTypeTraits<OT>::Min(), vtkTypeTraits<OT>::Max());
+  // the extent is the first voxel, unless extent generation was requested
+  bool generateExtents = (self->GetGenerateRegionExtents() != 0);
 
-  vtkIdTypeArray* labelArray = self->GetExtractedRegionLabels();
-  if (labelArray->GetNumberOfTuples() > 0)
+  components.resize(runs.NumberOfComponents);
+  int ySize = runs.Size[1];
+  vtkIdType numRows = static_cast<vtkIdType>(ySize) * runs.Size[2];
+  for (vtkIdType row = 0; row < numRows; row++)
   {
-    // do the extraction and final labeling
-    if (extractionMode == vtkImageConnectivityFilter::LargestRegion)
+    int yIdx = static_cast<int>(row % ySize);
+    int zIdx = static_cast<int>(row / ySize);
+    for (vtkIdType i = runs.RowStart[row]; i < runs.RowStart[row + 1]; i++)
     {
-      OT label = static_cast<OT>(labelArray->GetValue(0));
-      vtkICF::PruneAllButLargest(outData, outPtr, stencil, extent, label, regionInfo);
-    }
-    else if (labelMode != vtkImageConnectivityFilter::SeedScalar || seedScalars != nullptr)
-    {
-      // this is done unless labelMode == SeedScalar and seedScalars == 0
-      vtkICF::Relabel(outData, outPtr, stencil, extent, labelArray);
+      int x0 = runs.RunStart[i];
+      int x1 = runs.RunEnd[i];
+      vtkIdType c = runs.Component[i];
+      vtkICF::Region& region = components[c];
+      if (region.size == 0)
+      {
+        region.component = c;
+        region.extent[0] = x0;
+        region.extent[1] = (generateExtents ? x1 : x0);
+        region.extent[2] = region.extent[3] = yIdx;
+        region.extent[4] = region.extent[5] = zIdx;
+      }
+      else if (generateExtents)
+      {
+        // the runs are in raster order, so z never decreases
+        region.extent[0] = (x0 < region.extent[0] ? x0 : region.extent[0]);
+        region.extent[1] = (x1 > region.extent[1] ? x1 : region.extent[1]);
+        region.extent[2] = (yIdx < region.extent[2] ? yIdx : region.extent[2]);
+        region.extent[3] = (yIdx > region.extent[3] ? yIdx : region.extent[3]);
+        region.extent[5] = zIdx;
+      }
+      region.size += x1 - x0 + 1;
     }
-
-    // sort the three region info arrays (must be done after Relabel)
-    vtkICF::SortRegionArrays(self);
   }
 }
 
 //------------------------------------------------------------------------------
-int* vtkICF::ZeroBaseExtent(const int wholeExtent[6], int extent[6], int maxIdx[3])
-{
-  // Indexing goes from 0 to maxIdX
-  maxIdx[0] = wholeExtent[1] - wholeExtent[0];
-  maxIdx[1] = wholeExtent[3] - wholeExtent[2];
-  maxIdx[2] = wholeExtent[5] - wholeExtent[4];
-
-  // Get the limits for the output data
-  bool useLimits = false;
-  for (int k = 0; k < 3; k++)
-  {
-    extent[2 * k] -= wholeExtent[2 * k];
-    useLimits |= (extent[2 * k] != 0);
-    extent[2 * k + 1] -= wholeExtent[2 * k];
-    useLimits |= (extent[2 * k + 1] != maxIdx[k]);
-  }
-
-  // return limits as nullptr if we don't have to use them
-  return (useLimits ? extent : nullptr);
-}
-
-//------------------------------------------------------------------------------
-template <class OT>
 void vtkICF::SeededExecute(vtkImageConnectivityFilter* self, vtkImageData* outData,
-  vtkDataSet* seedData, vtkImageStencilData* stencil, OT* outPtr, unsigned char* maskPtr,
-  int extent[6], vtkICF::RegionVector& regionInfo)
+  vtkDataSet* seedData, int extent[6], const vtkICF::RunData& runs,
+  const std::vector<vtkICF::Region>& components, std::vector<char>& claimed,
+  vtkICF::RegionList& regionList)
 {
-  // Get execution parameters
-  int extractionMode = self->GetExtractionMode();
-  vtkIdType sizeRange[2];
-  self->GetSizeRange(sizeRange);
-
-  vtkIdType outInc[3];
-  outData->GetIncrements(outInc);
+  bool generateExtents = (self->GetGenerateRegionExtents() != 0);
 
   double spacing[3];
   double origin[3];
   outData->GetOrigin(origin);
   outData->GetSpacing(spacing);
 
-  int outExt[6];
-  outData->GetExtent(outExt);
-
-  // Indexing will go from 0 to maxIdX, and the lower limit if "extent" will
-  // be subtracted from outExt.  If outExt was the same as extent, then nullptr
-  // is returned, else outExt is returned.
-  int maxIdx[3];
-  int* outLimits = vtkICF::ZeroBaseExtent(extent, outExt, maxIdx);
-
-  // for measuring extent of fill
-  int seedExtent[6];
-  // only set to non-null if extent generation was requested
-  int* fillExtent = (self->GetGenerateRegionExtents() ? seedExtent : nullptr);
-
-  // label consecutively, starting at 1
-  OT label = 1;
-
-  std::stack<vtkICF::Seed> seedStack;
-
   vtkIdType nPoints = seedData->GetNumberOfPoints();
   vtkDataArray* scalars = seedData->GetPointData()->GetScalars();
 
@@ -1209,7 +1129,7 @@ void vtkICF::SeededExecute(vtkImageConnectivityFilter* self, vtkImageData* outDa
     {
       idx[j] = vtkMath::Floor((point[j] - origin[j]) / spacing[j] + 0.5);
       idx[j] -= extent[2 * j];
-      outOfBounds |= (idx[j] < 0 || idx[j] > maxIdx[j]);
+      outOfBounds |= (idx[j] < 0 || idx[j] >= runs.Size[j]);
     }
 
     if (outOfBounds)
@@ -1217,140 +1137,175 @@ void vtkICF::SeededExecute(vtkImageConnectivityFilter* self, vtkImageData* outDa
       continue;
     }
 
-    // initialize the region extent from the seed position
-    seedExtent[0] = seedExtent[1] = idx[0];
-    seedExtent[2] = seedExtent[3] = idx[1];
-    seedExtent[4] = seedExtent[5] = idx[2];
-
-    seedStack.push(vtkICF::Seed(idx[0], idx[1], idx[2], label));
+    // a seed in the background, or in a region that was already found
+    // by another seed, does not add a region
+    vtkIdType run = runs.FindRun(idx);
+    if (run < 0 || claimed[runs.Component[run]])
+    {
+      continue;
+    }
+    vtkIdType c = runs.Component[run];
+    claimed[c] = 1;
 
-    // find all voxels that are connected to the seed
-    vtkIdType voxelCount =
-      vtkICF::Fill(outPtr, outInc, outLimits, maskPtr, maxIdx, fillExtent, seedStack);
+    vtkICF::Region region = components[c];
+    region.id = i;
+    if (!generateExtents)
+    {
+      // the region extent is the seed position
+      region.extent[0] = region.extent[1] = idx[0];
+      region.extent[2] = region.extent[3] = idx[1];
+      region.extent[4] = region.extent[5] = idx[2];
+    }
+    regionList.AddRegion(region);
+  }
+}
 
-    if (voxelCount != 0)
+//------------------------------------------------------------------------------
+void vtkICF::SeedlessExecute(const std::vector<vtkICF::Region>& components,
+  const std::vector<char>& claimed, vtkICF::RegionList& regionList, vtkIdType maxLabel)
+{
+  // the regions are added in the raster order of their first voxel
+  size_t n = components.size();
+  for (size_t c = 0; c < n; c++)
+  {
+    if (claimed[c])
+    {
+      continue;
+    }
+    const vtkICF::Region& region = components[c];
+    if (region.size == 1 && regionList.GetNumberOfLabels() == maxLabel)
     {
-      vtkICF::AddRegion(outData, outPtr, stencil, extent, sizeRange, regionInfo, voxelCount, i,
-        seedExtent, extractionMode);
-      label = static_cast<OT>(regionInfo.size());
+      // smallest region is definitely the one we would add
+      continue;
     }
+    vtkICF::Region seedless = region;
+    seedless.id = -1;
+    regionList.AddRegion(seedless);
   }
 }
 
 //------------------------------------------------------------------------------
 template <class OT>
-void vtkICF::SeedlessExecute(vtkImageConnectivityFilter* self, vtkImageData* outData,
-  vtkImageStencilData* stencil, OT* outPtr, unsigned char* maskPtr, int extent[6],
-  vtkICF::RegionVector& regionInfo)
+void vtkICF::WriteLabels(vtkImageData* outData, OT* outPtr, int extent[6],
+  const vtkICF::RunData& runs, const std::vector<OT>& labels)
 {
-  // Get execution parameters
-  int extractionMode = self->GetExtractionMode();
-  vtkIdType sizeRange[2];
-  self->GetSizeRange(sizeRange);
-
-  vtkIdType outInc[3];
-  outData->GetIncrements(outInc);
-
+  // clip the extent with the output extent
   int outExt[6];
+  int clipExt[6];
   outData->GetExtent(outExt);
+  if (!vtkICF::IntersectExtents(outExt, extent, clipExt))
+  {
+    return;
+  }
 
-  // Indexing will go from 0 to maxIdX, and the lower limit if "extent" will
-  // be subtracted from outExt.  If outExt was the same as extent, then nullptr
-  // is returned, else outExt is returned.
-  int maxIdx[3];
-  int* outLimits = vtkICF::ZeroBaseExtent(extent, outExt, maxIdx);
-
-  // for measuring extent of fill
-  int seedExtent[6];
-  // only set to non-null if extent generation was requested
-  int* fillExtent = (self->GetGenerateRegionExtents() ? seedExtent : nullptr);
-
-  // keep track of position in bitmask
-  unsigned char* maskPtr1 = maskPtr;
-  unsigned char bit = 1;
+  vtkIdType outInc[3];
+  outData->GetIncrements(outInc);
 
-  std::stack<vtkICF::Seed> seedStack;
+  int ySize = clipExt[3] - clipExt[2] + 1;
+  vtkIdType numRows = static_cast<vtkIdType>(ySize) * (clipExt[5] - clipExt[4] + 1);
 
-  for (int zIdx = 0; zIdx <= maxIdx[2]; zIdx++)
-  {
-    for (int yIdx = 0; yIdx <= maxIdx[1]; yIdx++)
+  // the output was cleared, so only the labelled runs are written
+  vtkSMPTools::For(0, numRows, [&](vtkIdType firstRow, vtkIdType lastRow) {
+    for (vtkIdType row = firstRow; row < lastRow; row++)
     {
-      for (int xIdx = 0; xIdx <= maxIdx[0]; xIdx++)
+      int yIdx = clipExt[2] + static_cast<int>(row % ySize);
+      int zIdx = clipExt[4] + static_cast<int>(row / ySize);
+      OT* rowPtr = outPtr + (yIdx - outExt[2]) * outInc[1] + (zIdx - outExt[4]) * outInc[2];
+      vtkIdType runRow =
+        (yIdx - extent[2]) + static_cast<vtkIdType>(zIdx - extent[4]) * runs.Size[1];
+      for (vtkIdType i = runs.RowStart[runRow]; i < runs.RowStart[runRow + 1]; i++)
       {
-        // check the bitmask to see if voxel is already colored
-        unsigned char bitSet = *maskPtr1 & bit;
-        bit <<= 1;
-        if (bit == 0)
-        {
-          maskPtr1++;
-          bit = 1;
-        }
-
-        // if already colored, skip
-        if (bitSet != 0)
-        {
-          continue;
-        }
-
-        // initialize the region extent from the seed position
-        seedExtent[0] = seedExtent[1] = xIdx;
-        seedExtent[2] = seedExtent[3] = yIdx;
-        seedExtent[4] = seedExtent[5] = zIdx;
-
-        OT label = static_cast<OT>(regionInfo.size());
-        seedStack.push(vtkICF::Seed(xIdx, yIdx, zIdx, label));
-
-        // find all voxels that are connected to the seed
-        vtkIdType voxelCount =
-          vtkICF::Fill(outPtr, outInc, outLimits, maskPtr, maxIdx, fillExtent, seedStack);
-
-        if (voxelCount != 0)
+        OT label = labels[runs.Component[i]];
+        int x0 = runs.RunStart[i] + extent[0];
+        int x1 = runs.RunEnd[i] + extent[0];
+        x0 = (x0 > clipExt[0] ? x0 : clipExt[0]);
+        x1 = (x1 < clipExt[1] ? x1 : clipExt[1]);
+        if (label != 0 && x0 <= x1)
         {
-          if (voxelCount == 1 && static_cast<OT>(regionInfo.size()) == vtkTypeTraits<OT>::Max())
-          {
-            // smallest region is definitely the one we just added
-            vtkIdType outOffset = (xIdx * outInc[0] + yIdx * outInc[1] + zIdx * outInc[2]);
-            outPtr[outOffset] = 0;
-          }
-          else
-          {
-            vtkICF::AddRegion(outData, outPtr, stencil, extent, sizeRange, regionInfo, voxelCount,
-              -1, seedExtent, extractionMode);
-          }
+          std::fill(rowPtr + (x0 - outExt[0]), rowPtr + (x1 - outExt[0] + 1), label);
         }
       }
     }
-  }
+  });
 }
 
 //------------------------------------------------------------------------------
 // This templated function executes the filter for any type of data.
 template <class OT>
 void vtkICF::ExecuteOutput(vtkImageConnectivityFilter* self, vtkImageData* outData,
-  vtkDataSet* seedData, vtkImageStencilData* stencil, OT* outPtr, unsigned char* maskPtr,
-  int extent[6])
+  vtkDataSet* seedData, OT* outPtr, int extent[6], const vtkICF::RunData& runs)
 {
-  // push the "background" onto the region vector
-  vtkICF::RegionVector regionInfo;
-  regionInfo.push_back(vtkICF::Region(0, 0, extent));
+  // Get the execution parameters
+  int labelMode = self->GetLabelMode();
+  int extractionMode = self->GetExtractionMode();
+  vtkIdType sizeRange[2];
+  self->GetSizeRange(sizeRange);
+
+  // get the size and extent of every connected component
+  std::vector<vtkICF::Region> components;
+  vtkICF::GenerateComponentInfo(self, runs, components);
+
+  // the regions are pruned like the labels would be, if there are more
+  // regions than the output data type has label values
+  vtkIdType maxLabel = static_cast<vtkIdType>(vtkTypeTraits<OT>::Max());
+  vtkICF::RegionList regionList(maxLabel, sizeRange, extractionMode);
+  std::vector<char> claimed(components.size(), 0);
 
   // execution depends on how regions are seeded
   vtkDataArray* seedScalars = nullptr;
   if (seedData)
   {
     seedScalars = seedData->GetPointData()->GetScalars();
-    vtkICF::SeededExecute(self, outData, seedData, stencil, outPtr, maskPtr, extent, regionInfo);
+    vtkICF::SeededExecute(self, outData, seedData, extent, runs, components, claimed, regionList);
   }
 
   // if no seeds, or if AllRegions selected, search for all regions
-  int extractionMode = self->GetExtractionMode();
   if (!seedData || extractionMode == vtkImageConnectivityFilter::AllRegions)
   {
-    vtkICF::SeedlessExecute(self, outData, stencil, outPtr, maskPtr, extent, regionInfo);
+    vtkICF::SeedlessExecute(components, claimed, regionList, maxLabel);
+  }
+
+  // get only the regions in the requested range of sizes, after the
+  // "background" region
+  vtkICF::RegionVector regionInfo;
+  regionInfo.push_back(vtkICF::Region(0, 0, extent));
+  regionList.GetRegions(regionInfo);
+
+  // create the three region info arrays
+  vtkICF::GenerateRegionArrays(
+    self, regionInfo, seedScalars, extent, vtkTypeTraits<OT>::Min(), vtkTypeTraits<OT>::Max());
+
+  // the label of each component, zero for the components not extracted
+  std::vector<OT> labels(components.size(), 0);
+  vtkIdTypeArray* labelArray = self->GetExtractedRegionLabels();
+  if (labelArray->GetNumberOfTuples() > 0)
+  {
+    // do the extraction and final labeling
+    if (extractionMode == vtkImageConnectivityFilter::LargestRegion)
+    {
+      labels[regionInfo.largest()->component] = static_cast<OT>(labelArray->GetValue(0));
+    }
+    else if (labelMode != vtkImageConnectivityFilter::SeedScalar || seedScalars != nullptr)
+    {
+      // this is done unless labelMode == SeedScalar and seedScalars == 0
+      for (size_t i = 1; i < regionInfo.size(); i++)
+      {
+        labels[regionInfo[i].component] = static_cast<OT>(labelArray->GetValue(i - 1));
+      }
+    }
+    else
+    {
+      for (size_t i = 1; i < regionInfo.size(); i++)
+      {
+        labels[regionInfo[i].component] = static_cast<OT>(i);
+      }
+    }
+
+    // sort the three region info arrays
+    vtkICF::SortRegionArrays(self);
   }
 
-  // do final relabelling and other bookkeeping
-  vtkICF::Finish(self, outData, outPtr, stencil, extent, seedScalars, regionInfo);
+  vtkICF::WriteLabels(outData, outPtr, extent, runs, labels);
 }
 
 } // end anonymous namespace
@@ -1447,54 +1402,44 @@ int vtkImageConnectivityFilter::RequestData(vtkInformation* vtkNotUsed(request),
     return 0;
   }
 
-  // create and clear the image bitmask (each bit is a voxel)
-  size = (extent[1] - extent[0] + 1);
-  size *= (extent[3] - extent[2] + 1);
-  size *= (extent[5] - extent[4] + 1);
-  byteSize = (size + 7) / 8;
-  unsigned char* mask = new unsigned char[byteSize];
-
   // get scalar pointers
   void* inPtr = inData->GetScalarPointerForExtent(extent);
 
-  int rval = 1;
-
+  // find the voxels within the scalar range and the stencil, as runs
+  // along the rows, and label their connected components
+  vtkICF::RunData runs;
   switch (inData->GetScalarType())
   {
     vtkTemplateAliasMacro(
-      vtkICF::ExecuteInput(this, inData, static_cast<VTK_TT*>(inPtr), mask, stencil, extent));
+      vtkICF::ExecuteInput(this, inData, static_cast<VTK_TT*>(inPtr), stencil, extent, runs));
 
     default:
       vtkErrorMacro(<< "Execute: Unknown input ScalarType");
-      rval = 0;
+      return 0;
   }
 
   switch (outData->GetScalarType())
   {
     case VTK_UNSIGNED_CHAR:
       vtkICF::ExecuteOutput(
-        this, outData, seedData, stencil, static_cast<unsigned char*>(outPtr), mask, extent);
+        this, outData, seedData, static_cast<unsigned char*>(outPtr), extent, runs);
       break;
 
     case VTK_SHORT:
-      vtkICF::ExecuteOutput(
-        this, outData, seedData, stencil, static_cast<short*>(outPtr), mask, extent);
+      vtkICF::ExecuteOutput(this, outData, seedData, static_cast<short*>(outPtr), extent, runs);
       break;
 
     case VTK_UNSIGNED_SHORT:
       vtkICF::ExecuteOutput(
-        this, outData, seedData, stencil, static_cast<unsigned short*>(outPtr), mask, extent);
+        this, outData, seedData, static_cast<unsigned short*>(outPtr), extent, runs);
       break;
 
     case VTK_INT:
-      vtkICF::ExecuteOutput(
-        this, outData, seedData, stencil, static_cast<int*>(outPtr), mask, extent);
+      vtkICF::ExecuteOutput(this, outData, seedData, static_cast<int*>(outPtr), extent, runs);
       break;
   }
 
-  delete[] mask;
-
-  return rval;
+  return 1;
 }
 
 //------------------------------------------------------------------------------
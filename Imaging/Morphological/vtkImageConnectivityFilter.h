@@ -86,6 +86,12 @@
  * is called.  These extents can be useful for cropping the output
  * of the filter.
  *
+ * The regions are found by labeling runs of voxels along the rows of
+ * the image, which is done with vtkSMPTools for slabs of rows at a time,
+ * and then joining the labels across the slabs.  The results do not
+ * depend on the number of threads, and the regions are found in the same
+ * order as by a flood fill from the seeds, followed by a raster scan.
+ *
  * @sa
  * vtkConnectivityFilter, vtkPolyDataConnectivityFilter, vtkmImageConnectivity
  */
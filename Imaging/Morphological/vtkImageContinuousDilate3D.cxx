@@ -17,6 +17,7 @@
 #include "vtkDataArray.h"
 #include "vtkImageData.h"
 #include "vtkImageEllipsoidSource.h"
+#include "vtkImageMorphologyInternals.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
@@ -31,6 +32,8 @@ vtkStandardNewMacro(vtkImageContinuousDilate3D);
 vtkImageContinuousDilate3D::vtkImageContinuousDilate3D()
 {
   this->HandleBoundaries = 1;
+  this->Algorithm = Neighborhood;
+  this->KernelShape = Ellipsoid;
   this->KernelSize[0] = 0;
   this->KernelSize[1] = 0;
   this->KernelSize[2] = 0;
@@ -54,6 +57,22 @@ vtkImageContinuousDilate3D::~vtkImageContinuousDilate3D()
 void vtkImageContinuousDilate3D::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+
+  os << indent << "Algorithm: " << this->Algorithm << "\n";
+  os << indent << "KernelShape: " << this->KernelShape << "\n";
+}
+
+//------------------------------------------------------------------------------
+// A box footprint is an ellipsoid footprint with the same value outside.
+void vtkImageContinuousDilate3D::SetKernelShape(int shape)
+{
+  shape = (shape == Box ? Box : Ellipsoid);
+  if (this->KernelShape != shape)
+  {
+    this->KernelShape = shape;
+    this->Ellipse->SetOutValue(shape == Box ? this->Ellipse->GetInValue() : 0.0);
+    this->Modified();
+  }
 }
 
 //------------------------------------------------------------------------------
@@ -101,6 +120,26 @@ void vtkImageContinuousDilate3D::SetKernelSize(int size0, int size1, int size2)
   }
 }
 
+//------------------------------------------------------------------------------
+// This templated function executes the filter with the separable algorithm.
+template <class T>
+void vtkImageContinuousDilate3DSeparable(vtkImageContinuousDilate3D* self, vtkImageData* mask,
+  vtkImageData* inData, const T* inPtr, vtkImageData* outData, int* outExt, T* outPtr, int id,
+  vtkInformation* inInfo)
+{
+  vtkImageMorphologyKernel kernel;
+  kernel.Build(mask, self->GetKernelSize(), self->GetKernelMiddle());
+
+  vtkIdType inInc[3], outInc[3];
+  inData->GetIncrements(inInc);
+  outData->GetIncrements(outInc);
+  int inImageExt[6];
+  inInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(), inImageExt);
+
+  vtkImageMorphologyExecute<vtkImageMorphologyMax>(self, kernel, inPtr, inData->GetExtent(),
+    inInc, inImageExt, outPtr, outExt, outInc, outData->GetNumberOfScalarComponents(), id);
+}
+
 //------------------------------------------------------------------------------
 // This templated function executes the filter on any region,
 // whether it needs boundary checking or not.
@@ -137,6 +176,13 @@ void vtkImageContinuousDilate3DExecute(vtkImageContinuousDilate3D* self, vtkImag
   unsigned long target;
   int* inExt;
 
+  if (self->GetAlgorithm() == vtkImageContinuousDilate3D::Separable)
+  {
+    vtkImageContinuousDilate3DSeparable(
+      self, mask, inData, inPtr, outData, outExt, outPtr, id, inInfo);
+    return;
+  }
+
   inExt = inData->GetExtent();
 
   // Get information to march through data
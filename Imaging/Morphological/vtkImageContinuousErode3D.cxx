@@ -17,6 +17,7 @@
 #include "vtkDataArray.h"
 #include "vtkImageData.h"
 #include "vtkImageEllipsoidSource.h"
+#include "vtkImageMorphologyInternals.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
@@ -31,6 +32,8 @@ vtkStandardNewMacro(vtkImageContinuousErode3D);
 vtkImageContinuousErode3D::vtkImageContinuousErode3D()
 {
   this->HandleBoundaries = 1;
+  this->Algorithm = Neighborhood;
+  this->KernelShape = Ellipsoid;
   this->KernelSize[0] = 1;
   this->KernelSize[1] = 1;
   this->KernelSize[2] = 1;
@@ -54,6 +57,22 @@ vtkImageContinuousErode3D::~vtkImageContinuousErode3D()
 void vtkImageContinuousErode3D::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+
+  os << indent << "Algorithm: " << this->Algorithm << "\n";
+  os << indent << "KernelShape: " << this->KernelShape << "\n";
+}
+
+//------------------------------------------------------------------------------
+// A box footprint is an ellipsoid footprint with the same value outside.
+void vtkImageContinuousErode3D::SetKernelShape(int shape)
+{
+  shape = (shape == Box ? Box : Ellipsoid);
+  if (this->KernelShape != shape)
+  {
+    this->KernelShape = shape;
+    this->Ellipse->SetOutValue(shape == Box ? this->Ellipse->GetInValue() : 0.0);
+    this->Modified();
+  }
 }
 
 //------------------------------------------------------------------------------
@@ -100,6 +119,26 @@ void vtkImageContinuousErode3D::SetKernelSize(int size0, int size1, int size2)
   }
 }
 
+//------------------------------------------------------------------------------
+// This templated function executes the filter with the separable algorithm.
+template <class T>
+void vtkImageContinuousErode3DSeparable(vtkImageContinuousErode3D* self, vtkImageData* mask,
+  vtkImageData* inData, const T* inPtr, vtkImageData* outData, int* outExt, T* outPtr, int id,
+  vtkInformation* inInfo)
+{
+  vtkImageMorphologyKernel kernel;
+  kernel.Build(mask, self->GetKernelSize(), self->GetKernelMiddle());
+
+  vtkIdType inInc[3], outInc[3];
+  inData->GetIncrements(inInc);
+  outData->GetIncrements(outInc);
+  int inImageExt[6];
+  inInfo->Get(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(), inImageExt);
+
+  vtkImageMorphologyExecute<vtkImageMorphologyMin>(self, kernel, inPtr, inData->GetExtent(),
+    inInc, inImageExt, outPtr, outExt, outInc, outData->GetNumberOfScalarComponents(), id);
+}
+
 //------------------------------------------------------------------------------
 // This templated function executes the filter on any region,
 // whether it needs boundary checking or not.
@@ -136,6 +175,13 @@ void vtkImageContinuousErode3DExecute(vtkImageContinuousErode3D* self, vtkImageD
   unsigned long target;
   int* inExt = inData->GetExtent();
 
+  if (self->GetAlgorithm() == vtkImageContinuousErode3D::Separable)
+  {
+    vtkImageContinuousErode3DSeparable(
+      self, mask, inData, inPtr, outData, outExt, outPtr, id, inInfo);
+    return;
+  }
+
   // Get information to march through data
   inData->GetIncrements(inInc0, inInc1, inInc2);
   inInfo->Get(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(), inImageExt);
@@ -18,7 +18,8 @@
  *
  * vtkImageContinuousErode3D replaces a pixel with the minimum over
  * an ellipsoidal neighborhood.  If KernelSize of an axis is 1, no processing
- * is done on that axis.
+ * is done on that axis.  The neighborhood can also be a box, and the separable
+ * algorithm computes the minimum much faster for large kernels.
  */
 
 #ifndef vtkImageContinuousErode3D_h
@@ -48,11 +49,57 @@ public:
    */
   void SetKernelSize(int size0, int size1, int size2);
 
+  /**
+   * The algorithms that compute the minimum over the kernel footprint.
+   */
+  enum AlgorithmEnum
+  {
+    Neighborhood = 0,
+    Separable = 1
+  };
+
+  ///@{
+  /**
+   * Set the algorithm.  Neighborhood, the default, scans the whole kernel
+   * footprint for every voxel.  Separable splits the footprint into runs
+   * along x and uses the van Herk/Gil-Werman algorithm, so that its cost
+   * grows with the number of rows of the footprint rather than with its
+   * volume, and does not grow with the kernel size for a Box footprint.
+   * Both algorithms give the same result.
+   */
+  vtkSetClampMacro(Algorithm, int, Neighborhood, Separable);
+  void SetAlgorithmToNeighborhood() { this->SetAlgorithm(Neighborhood); }
+  void SetAlgorithmToSeparable() { this->SetAlgorithm(Separable); }
+  vtkGetMacro(Algorithm, int);
+  ///@}
+
+  /**
+   * The shapes of the kernel footprint.
+   */
+  enum KernelShapeEnum
+  {
+    Ellipsoid = 0,
+    Box = 1
+  };
+
+  ///@{
+  /**
+   * Set the shape of the footprint within the KernelSize.  The default is
+   * an Ellipsoid.
+   */
+  void SetKernelShape(int shape);
+  void SetKernelShapeToEllipsoid() { this->SetKernelShape(Ellipsoid); }
+  void SetKernelShapeToBox() { this->SetKernelShape(Box); }
+  vtkGetMacro(KernelShape, int);
+  ///@}
+
 protected:
   vtkImageContinuousErode3D();
   ~vtkImageContinuousErode3D() override;
 
   vtkImageEllipsoidSource* Ellipse;
+  int Algorithm;
+  int KernelShape;
 
   void ThreadedRequestData(vtkInformation* request, vtkInformationVector** inputVector,
     vtkInformationVector* outputVector, vtkImageData*** inData, vtkImageData** outData,
@@ -15,6 +15,7 @@
 #include "vtkImageDilateErode3D.h"
 #include "vtkImageData.h"
 #include "vtkImageEllipsoidSource.h"
+#include "vtkImageMorphologyInternals.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
@@ -34,6 +35,8 @@ vtkImageDilateErode3D::vtkImageDilateErode3D()
 
   this->DilateValue = 0.0;
   this->ErodeValue = 255.0;
+  this->Algorithm = Neighborhood;
+  this->KernelShape = Ellipsoid;
 
   this->Ellipse = vtkImageEllipsoidSource::New();
   // Setup the Ellipse to default size
@@ -57,6 +60,21 @@ void vtkImageDilateErode3D::PrintSelf(ostream& os, vtkIndent indent)
 
   os << indent << "DilateValue: " << this->DilateValue << "\n";
   os << indent << "ErodeValue: " << this->ErodeValue << "\n";
+  os << indent << "Algorithm: " << this->Algorithm << "\n";
+  os << indent << "KernelShape: " << this->KernelShape << "\n";
+}
+
+//------------------------------------------------------------------------------
+// A box footprint is an ellipsoid footprint with the same value outside.
+void vtkImageDilateErode3D::SetKernelShape(int shape)
+{
+  shape = (shape == Box ? Box : Ellipsoid);
+  if (this->KernelShape != shape)
+  {
+    this->KernelShape = shape;
+    this->Ellipse->SetOutValue(shape == Box ? this->Ellipse->GetInValue() : 0.0);
+    this->Modified();
+  }
 }
 
 //------------------------------------------------------------------------------
@@ -104,6 +122,81 @@ void vtkImageDilateErode3D::SetKernelSize(int size0, int size1, int size2)
   }
 }
 
+//------------------------------------------------------------------------------
+// This templated function executes the filter with the separable algorithm,
+// by computing the maximum of a mask of the dilate value.
+template <class T>
+void vtkImageDilateErode3DSeparable(vtkImageDilateErode3D* self, vtkImageData* mask,
+  vtkImageData* inData, vtkImageData* outData, int* outExt, T* outPtr, int id,
+  vtkInformation* inInfo)
+{
+  vtkImageMorphologyKernel kernel;
+  kernel.Build(mask, self->GetKernelSize(), self->GetKernelMiddle());
+
+  T erodeValue = static_cast<T>(self->GetErodeValue());
+  T dilateValue = static_cast<T>(self->GetDilateValue());
+  int numComps = outData->GetNumberOfScalarComponents();
+  int* inExt = inData->GetExtent();
+  vtkIdType inInc[3], outInc[3];
+  inData->GetIncrements(inInc);
+  outData->GetIncrements(outInc);
+
+  // the input region that is needed for the output extent
+  int inImageExt[6], region[6];
+  inInfo->Get(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(), inImageExt);
+  for (int i = 0; i < 3; i++)
+  {
+    region[2 * i] = std::max(std::max(outExt[2 * i] + kernel.HoodMin[i], inImageExt[2 * i]),
+      inExt[2 * i]);
+    region[2 * i + 1] = std::min(
+      std::min(outExt[2 * i + 1] + kernel.HoodMax[i], inImageExt[2 * i + 1]), inExt[2 * i + 1]);
+  }
+
+  // the mask of the dilate value within the region
+  vtkIdType maskInc[3];
+  maskInc[0] = numComps;
+  maskInc[1] = maskInc[0] * (region[1] - region[0] + 1);
+  maskInc[2] = maskInc[1] * (region[3] - region[2] + 1);
+  std::vector<unsigned char> dilateMask(maskInc[2] * (region[5] - region[4] + 1));
+  unsigned char* maskPtr = dilateMask.data();
+  for (int idx2 = region[4]; idx2 <= region[5]; idx2++)
+  {
+    for (int idx1 = region[2]; idx1 <= region[3]; idx1++)
+    {
+      const T* inPtr = static_cast<T*>(inData->GetScalarPointer(region[0], idx1, idx2));
+      for (vtkIdType i = 0; i < maskInc[1]; i++)
+      {
+        *maskPtr++ = (inPtr[i] == dilateValue);
+      }
+    }
+  }
+
+  // dilate the mask
+  vtkIdType dilatedInc[3];
+  dilatedInc[0] = numComps;
+  dilatedInc[1] = dilatedInc[0] * (outExt[1] - outExt[0] + 1);
+  dilatedInc[2] = dilatedInc[1] * (outExt[3] - outExt[2] + 1);
+  std::vector<unsigned char> dilated(dilatedInc[2] * (outExt[5] - outExt[4] + 1));
+  vtkImageMorphologyExecute<vtkImageMorphologyMax>(self, kernel, dilateMask.data(), region,
+    maskInc, region, dilated.data(), outExt, dilatedInc, numComps, id);
+
+  // replace the erode value where the dilated mask is set
+  const unsigned char* dilatedPtr = dilated.data();
+  for (int idx2 = outExt[4]; idx2 <= outExt[5]; idx2++)
+  {
+    for (int idx1 = outExt[2]; idx1 <= outExt[3]; idx1++)
+    {
+      const T* inPtr = static_cast<T*>(inData->GetScalarPointer(outExt[0], idx1, idx2));
+      T* outRow = outPtr + (idx1 - outExt[2]) * outInc[1] + (idx2 - outExt[4]) * outInc[2];
+      for (vtkIdType i = 0; i < dilatedInc[1]; i++)
+      {
+        outRow[i] = ((inPtr[i] == erodeValue && dilatedPtr[i]) ? dilateValue : inPtr[i]);
+      }
+      dilatedPtr += dilatedInc[1];
+    }
+  }
+}
+
 //------------------------------------------------------------------------------
 // This templated function executes the filter on any region,
 // whether it needs boundary checking or not.
@@ -139,6 +232,12 @@ void vtkImageDilateErode3DExecute(vtkImageDilateErode3D* self, vtkImageData* mas
   unsigned long count = 0;
   unsigned long target;
 
+  if (self->GetAlgorithm() == vtkImageDilateErode3D::Separable)
+  {
+    vtkImageDilateErode3DSeparable(self, mask, inData, outData, outExt, outPtr, id, inInfo);
+    return;
+  }
+
   // Get information to march through data
   inData->GetIncrements(inInc0, inInc1, inInc2);
   inInfo->Get(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(), inImageExt);
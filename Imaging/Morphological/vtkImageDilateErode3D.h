@@ -20,7 +20,9 @@
  * It uses an elliptical foot print, and only erodes/dilates on the
  * boundary of the two values.  The filter is restricted to the
  * X, Y, and Z axes for now.  It can degenerate to a 2 or 1 dimensional
- * filter by setting the kernel size to 1 for a specific axis.
+ * filter by setting the kernel size to 1 for a specific axis.  The foot print
+ * can also be a box, and the separable algorithm is much faster for large
+ * kernels.
  */
 
 #ifndef vtkImageDilateErode3D_h
@@ -50,6 +52,50 @@ public:
    */
   void SetKernelSize(int size0, int size1, int size2);
 
+  /**
+   * The algorithms that search the kernel footprint for the dilate value.
+   */
+  enum AlgorithmEnum
+  {
+    Neighborhood = 0,
+    Separable = 1
+  };
+
+  ///@{
+  /**
+   * Set the algorithm.  Neighborhood, the default, scans the whole kernel
+   * footprint around every voxel with the erode value.  Separable dilates a
+   * mask of the dilate value with the van Herk/Gil-Werman algorithm along
+   * the runs of the footprint, so that its cost does not depend on the
+   * number of voxels to erode, and does not grow with the kernel size for
+   * a Box footprint.  Both algorithms give the same result.
+   */
+  vtkSetClampMacro(Algorithm, int, Neighborhood, Separable);
+  void SetAlgorithmToNeighborhood() { this->SetAlgorithm(Neighborhood); }
+  void SetAlgorithmToSeparable() { this->SetAlgorithm(Separable); }
+  vtkGetMacro(Algorithm, int);
+  ///@}
+
+  /**
+   * The shapes of the kernel footprint.
+   */
+  enum KernelShapeEnum
+  {
+    Ellipsoid = 0,
+    Box = 1
+  };
+
+  ///@{
+  /**
+   * Set the shape of the footprint within the KernelSize.  The default is
+   * an Ellipsoid.
+   */
+  void SetKernelShape(int shape);
+  void SetKernelShapeToEllipsoid() { this->SetKernelShape(Ellipsoid); }
+  void SetKernelShapeToBox() { this->SetKernelShape(Box); }
+  vtkGetMacro(KernelShape, int);
+  ///@}
+
   ///@{
   /**
    * Set/Get the Dilate and Erode values to be used by this filter.
@@ -67,6 +113,8 @@ protected:
   vtkImageEllipsoidSource* Ellipse;
   double DilateValue;
   double ErodeValue;
+  int Algorithm;
+  int KernelShape;
 
   void ThreadedRequestData(vtkInformation* request, vtkInformationVector** inputVector,
     vtkInformationVector* outputVector, vtkImageData*** inData, vtkImageData** outData,
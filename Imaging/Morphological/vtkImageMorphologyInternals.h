@@ -0,0 +1,449 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkImageMorphologyInternals.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkImageMorphologyInternals
+ * @brief   separable minimum and maximum filters for the morphology filters
+ *
+ * This private header provides the "Separable" algorithm that is shared by
+ * vtkImageContinuousDilate3D, vtkImageContinuousErode3D and
+ * vtkImageDilateErode3D.  The kernel footprint is decomposed into runs of
+ * voxels along x, one run per row of the footprint.  The maximum (or
+ * minimum) over each distinct run is computed along the x lines of the
+ * input with the van Herk/Gil-Werman algorithm, which needs three
+ * comparisons per voxel whatever the length of the run.  The runs of the
+ * rows are then combined a whole output row at a time, so that these loops
+ * are vectorized by the compiler.  For a box footprint, the rows are
+ * combined with van Herk/Gil-Werman along y and z as well, which makes the
+ * cost per voxel independent of the kernel size.
+ *
+ * The results are identical to those of the brute-force neighborhood scan.
+ */
+
+#ifndef vtkImageMorphologyInternals_h
+#define vtkImageMorphologyInternals_h
+
+#include "vtkAlgorithm.h"
+#include "vtkImageData.h"
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+//------------------------------------------------------------------------------
+// The operations for dilation and erosion.  The second argument is the
+// neighbor, which replaces the first only if it is strictly larger (or
+// smaller), like in the neighborhood scan.
+struct vtkImageMorphologyMax
+{
+  template <class T>
+  static T Apply(T a, T b)
+  {
+    return (b > a ? b : a);
+  }
+
+  template <class T>
+  static T Identity()
+  {
+    return std::numeric_limits<T>::lowest();
+  }
+};
+
+struct vtkImageMorphologyMin
+{
+  template <class T>
+  static T Apply(T a, T b)
+  {
+    return (b < a ? b : a);
+  }
+
+  template <class T>
+  static T Identity()
+  {
+    return std::numeric_limits<T>::max();
+  }
+};
+
+//------------------------------------------------------------------------------
+// The kernel footprint, decomposed into runs along x
+class vtkImageMorphologyKernel
+{
+public:
+  // A run of the footprint, as offsets from the kernel middle
+  struct Run
+  {
+    int Y;
+    int Z;
+    int Window; // index into Windows
+  };
+
+  // A distinct range of x offsets
+  struct Window
+  {
+    int Min;
+    int Max;
+  };
+
+  std::vector<Run> Runs;
+  std::vector<Window> Windows;
+  int HoodMin[3];
+  int HoodMax[3];
+  bool IsBox;
+
+  // Build the runs from the nonzero voxels of an unsigned char mask
+  void Build(vtkImageData* mask, const int kernelSize[3], const int kernelMiddle[3])
+  {
+    this->Runs.clear();
+    this->Windows.clear();
+    for (int i = 0; i < 3; i++)
+    {
+      this->HoodMin[i] = -kernelMiddle[i];
+      this->HoodMax[i] = kernelSize[i] - 1 - kernelMiddle[i];
+    }
+
+    const unsigned char* maskPtr = static_cast<unsigned char*>(mask->GetScalarPointer());
+    vtkIdType maskInc[3];
+    mask->GetIncrements(maskInc);
+    bool fullRows = true;
+    for (int idx2 = 0; idx2 < kernelSize[2]; idx2++)
+    {
+      for (int idx1 = 0; idx1 < kernelSize[1]; idx1++)
+      {
+        const unsigned char* rowPtr = maskPtr + idx1 * maskInc[1] + idx2 * maskInc[2];
+        int runCount = 0;
+        int idx0 = 0;
+        while (idx0 < kernelSize[0])
+        {
+          if (!rowPtr[idx0 * maskInc[0]])
+          {
+            idx0++;
+            continue;
+          }
+          int runStart = idx0;
+          while (idx0 < kernelSize[0] && rowPtr[idx0 * maskInc[0]])
+          {
+            idx0++;
+          }
+          fullRows &= (runStart == 0 && idx0 == kernelSize[0]);
+          runCount++;
+
+          Window window = { runStart - kernelMiddle[0], idx0 - 1 - kernelMiddle[0] };
+          size_t w = 0;
+          while (w < this->Windows.size() &&
+            (this->Windows[w].Min != window.Min || this->Windows[w].Max != window.Max))
+          {
+            w++;
+          }
+          if (w == this->Windows.size())
+          {
+            this->Windows.push_back(window);
+          }
+          Run run = { idx1 - kernelMiddle[1], idx2 - kernelMiddle[2], static_cast<int>(w) };
+          this->Runs.push_back(run);
+        }
+        fullRows &= (runCount == 1);
+      }
+    }
+    this->IsBox = fullRows;
+  }
+};
+
+//------------------------------------------------------------------------------
+// Apply the operation to whole rows: a = op(a, b)
+template <class Op, class T>
+inline void vtkImageMorphologyRow(T* a, const T* b, int n)
+{
+  for (int i = 0; i < n; i++)
+  {
+    a[i] = Op::Apply(a[i], b[i]);
+  }
+}
+
+// The same, for c = op(a, b)
+template <class Op, class T>
+inline void vtkImageMorphologyRow(T* c, const T* a, const T* b, int n)
+{
+  for (int i = 0; i < n; i++)
+  {
+    c[i] = Op::Apply(a[i], b[i]);
+  }
+}
+
+//------------------------------------------------------------------------------
+// The van Herk/Gil-Werman algorithm along a line of vectors, each vector
+// being n contiguous values.  For each index i from o0 to o1, the output
+// vector at out + (i - o0) * outInc is the operation over the input vectors
+// with indices from i + wmin to i + wmax, where only the indices from v0 to
+// v1 are used, and the input vector with index v0 is at in.  The workspace
+// g and h must each hold (o1 - o0 + wmax - wmin + 1) * n values.
+template <class Op, class T>
+void vtkImageMorphologyLine(const T* in, vtkIdType inInc, int v0, int v1, T* out,
+  vtkIdType outInc, int o0, int o1, int wmin, int wmax, int n, T* g, T* h)
+{
+  const int length = wmax - wmin + 1;
+  const int first = o0 + wmin;
+  const int m = o1 - o0 + length;
+
+  // the inputs, with the identity outside of the valid range
+  for (int j = 0; j < m; j++)
+  {
+    int idx = first + j;
+    T* ptr = h + static_cast<vtkIdType>(j) * n;
+    if (idx >= v0 && idx <= v1)
+    {
+      const T* inRow = in + (idx - v0) * inInc;
+      for (int i = 0; i < n; i++)
+      {
+        ptr[i] = inRow[i];
+      }
+    }
+    else
+    {
+      std::fill(ptr, ptr + n, Op::template Identity<T>());
+    }
+  }
+
+  // the prefix g and the suffix h within each block of the window length
+  for (int block = 0; block < m; block += length)
+  {
+    int blockEnd = std::min(block + length, m);
+    std::copy(h + static_cast<vtkIdType>(block) * n, h + static_cast<vtkIdType>(block + 1) * n,
+      g + static_cast<vtkIdType>(block) * n);
+    for (int j = block + 1; j < blockEnd; j++)
+    {
+      vtkImageMorphologyRow<Op>(g + static_cast<vtkIdType>(j) * n,
+        g + static_cast<vtkIdType>(j - 1) * n, h + static_cast<vtkIdType>(j) * n, n);
+    }
+    for (int j = blockEnd - 2; j >= block; j--)
+    {
+      vtkImageMorphologyRow<Op>(h + static_cast<vtkIdType>(j) * n,
+        h + static_cast<vtkIdType>(j + 1) * n, n);
+    }
+  }
+
+  // each window spans the end of one block and the start of the next
+  for (int j = 0; j <= o1 - o0; j++)
+  {
+    vtkImageMorphologyRow<Op>(out + j * outInc, h + static_cast<vtkIdType>(j) * n,
+      g + static_cast<vtkIdType>(j + length - 1) * n, n);
+  }
+}
+
+// The same, for a line of single values with a stride, e.g. along x
+template <class Op, class T>
+void vtkImageMorphologyLine(const T* in, vtkIdType inInc, int v0, int v1, T* out, int o0,
+  int o1, int wmin, int wmax, T* g, T* h)
+{
+  const int length = wmax - wmin + 1;
+  const int first = o0 + wmin;
+  const int m = o1 - o0 + length;
+
+  for (int j = 0; j < m; j++)
+  {
+    int idx = first + j;
+    h[j] = ((idx >= v0 && idx <= v1) ? in[(idx - v0) * inInc] : Op::template Identity<T>());
+  }
+
+  for (int block = 0; block < m; block += length)
+  {
+    int blockEnd = std::min(block + length, m);
+    g[block] = h[block];
+    for (int j = block + 1; j < blockEnd; j++)
+    {
+      g[j] = Op::Apply(g[j - 1], h[j]);
+    }
+    for (int j = blockEnd - 2; j >= block; j--)
+    {
+      h[j] = Op::Apply(h[j + 1], h[j]);
+    }
+  }
+
+  for (int j = 0; j <= o1 - o0; j++)
+  {
+    out[j] = Op::Apply(h[j], g[j + length - 1]);
+  }
+}
+
+//------------------------------------------------------------------------------
+// Compute the operation over the kernel footprint for the output extent.
+// The input pointer is for the first voxel of the input extent, and the
+// neighbors outside of the valid extent are ignored.  The increments are
+// in values, and the components are done one after the other.
+template <class Op, class T>
+void vtkImageMorphologyExecute(vtkAlgorithm* self, const vtkImageMorphologyKernel& kernel,
+  const T* inPtr, const int inExt[6], const vtkIdType inInc[3], const int validExt[6],
+  T* outPtr, const int outExt[6], const vtkIdType outInc[3], int numComps, int id)
+{
+  // the input region that is needed, within the valid extent
+  int region[6];
+  for (int i = 0; i < 3; i++)
+  {
+    int validMin = std::max(validExt[2 * i], inExt[2 * i]);
+    int validMax = std::min(validExt[2 * i + 1], inExt[2 * i + 1]);
+    region[2 * i] = std::max(outExt[2 * i] + kernel.HoodMin[i], validMin);
+    region[2 * i + 1] = std::min(outExt[2 * i + 1] + kernel.HoodMax[i], validMax);
+  }
+
+  const int outSize0 = outExt[1] - outExt[0] + 1;
+  const int outSize1 = outExt[3] - outExt[2] + 1;
+  const int outSize2 = outExt[5] - outExt[4] + 1;
+  const int regionSize1 = region[3] - region[2] + 1;
+  const int regionSize2 = region[5] - region[4] + 1;
+  const vtkIdType planeSize = static_cast<vtkIdType>(outSize0) * regionSize1;
+
+  // workspace for the van Herk/Gil-Werman lines
+  int maxLength = 1;
+  for (const vtkImageMorphologyKernel::Window& window : kernel.Windows)
+  {
+    maxLength = std::max(maxLength, window.Max - window.Min + 1);
+  }
+  for (int i = 1; i < 3; i++)
+  {
+    maxLength = std::max(maxLength, kernel.HoodMax[i] - kernel.HoodMin[i] + 1);
+  }
+  int maxLine = std::max(outSize0, std::max(outSize1, outSize2)) + maxLength;
+  std::vector<T> g(static_cast<size_t>(maxLine) * outSize0);
+  std::vector<T> h(static_cast<size_t>(maxLine) * outSize0);
+
+  const T* inRegion = inPtr + (region[0] - inExt[0]) * inInc[0] +
+    (region[2] - inExt[2]) * inInc[1] + (region[4] - inExt[4]) * inInc[2];
+
+  if (kernel.IsBox)
+  {
+    // separable along all three axes: x lines into a plane, then y lines
+    // into a slab of planes, then z lines into the output
+    std::vector<T> plane(planeSize);
+    std::vector<T> slab(static_cast<size_t>(outSize0) * outSize1 * regionSize2);
+    std::vector<T> column(static_cast<size_t>(outSize0) * outSize2);
+    const vtkImageMorphologyKernel::Window& window = kernel.Windows[0];
+    for (int c = 0; c < numComps && !self->AbortExecute; c++)
+    {
+      for (int idx2 = region[4]; idx2 <= region[5] && !self->AbortExecute; idx2++)
+      {
+        if (id == 0)
+        {
+          self->UpdateProgress((c + 0.5 * (idx2 - region[4]) / regionSize2) / numComps);
+        }
+        for (int idx1 = region[2]; idx1 <= region[3]; idx1++)
+        {
+          const T* inRow = inRegion + c + (idx1 - region[2]) * inInc[1] +
+            (idx2 - region[4]) * inInc[2];
+          vtkImageMorphologyLine<Op>(inRow, inInc[0], region[0], region[1],
+            &plane[static_cast<size_t>(idx1 - region[2]) * outSize0], outExt[0], outExt[1],
+            window.Min, window.Max, g.data(), h.data());
+        }
+        vtkImageMorphologyLine<Op>(plane.data(), outSize0, region[2], region[3],
+          &slab[static_cast<size_t>(idx2 - region[4]) * outSize0 * outSize1], outSize0,
+          outExt[2], outExt[3], kernel.HoodMin[1], kernel.HoodMax[1], outSize0, g.data(),
+          h.data());
+      }
+
+      for (int idx1 = 0; idx1 < outSize1 && !self->AbortExecute; idx1++)
+      {
+        if (id == 0)
+        {
+          self->UpdateProgress((c + 0.5 + 0.5 * idx1 / outSize1) / numComps);
+        }
+        vtkImageMorphologyLine<Op>(&slab[static_cast<size_t>(idx1) * outSize0],
+          static_cast<vtkIdType>(outSize0) * outSize1, region[4], region[5], column.data(),
+          outSize0, outExt[4], outExt[5], kernel.HoodMin[2], kernel.HoodMax[2], outSize0,
+          g.data(), h.data());
+        for (int idx2 = 0; idx2 < outSize2; idx2++)
+        {
+          T* outRow = outPtr + c + idx1 * outInc[1] + idx2 * outInc[2];
+          const T* columnRow = &column[static_cast<size_t>(idx2) * outSize0];
+          for (int idx0 = 0; idx0 < outSize0; idx0++)
+          {
+            outRow[idx0 * outInc[0]] = columnRow[idx0];
+          }
+        }
+      }
+    }
+    return;
+  }
+
+  // for other footprints, keep the x lines for each distinct run for the
+  // planes that are within the kernel, in a ring buffer
+  const int numWindows = static_cast<int>(kernel.Windows.size());
+  const int ringSize = kernel.HoodMax[2] - kernel.HoodMin[2] + 1;
+  std::vector<T> ring(static_cast<size_t>(ringSize) * numWindows * planeSize);
+  std::vector<T> row(outSize0);
+  auto ringPlanes = [&](int idx2) {
+    return &ring[static_cast<size_t>((idx2 - region[4]) % ringSize) * numWindows * planeSize];
+  };
+  for (int c = 0; c < numComps && !self->AbortExecute; c++)
+  {
+    int nextPlane = region[4];
+    for (int outIdx2 = outExt[4]; outIdx2 <= outExt[5] && !self->AbortExecute; outIdx2++)
+    {
+      if (id == 0)
+      {
+        self->UpdateProgress((c + static_cast<double>(outIdx2 - outExt[4]) / outSize2) / numComps);
+      }
+
+      // compute the x lines for the planes that have entered the kernel
+      int lastPlane = std::min(outIdx2 + kernel.HoodMax[2], region[5]);
+      for (; nextPlane <= lastPlane; nextPlane++)
+      {
+        T* planes = ringPlanes(nextPlane);
+        for (int w = 0; w < numWindows; w++)
+        {
+          for (int idx1 = region[2]; idx1 <= region[3]; idx1++)
+          {
+            const T* inRow = inRegion + c + (idx1 - region[2]) * inInc[1] +
+              (nextPlane - region[4]) * inInc[2];
+            vtkImageMorphologyLine<Op>(inRow, inInc[0], region[0], region[1],
+              planes + w * planeSize + static_cast<vtkIdType>(idx1 - region[2]) * outSize0,
+              outExt[0], outExt[1], kernel.Windows[w].Min, kernel.Windows[w].Max, g.data(),
+              h.data());
+          }
+        }
+      }
+
+      for (int outIdx1 = outExt[2]; outIdx1 <= outExt[3]; outIdx1++)
+      {
+        // start with the center voxel, like the neighborhood scan
+        const T* inRow = inPtr + c + (outExt[0] - inExt[0]) * inInc[0] +
+          (outIdx1 - inExt[2]) * inInc[1] + (outIdx2 - inExt[4]) * inInc[2];
+        for (int idx0 = 0; idx0 < outSize0; idx0++)
+        {
+          row[idx0] = inRow[idx0 * inInc[0]];
+        }
+
+        // combine the runs of the rows of the footprint
+        for (const vtkImageMorphologyKernel::Run& run : kernel.Runs)
+        {
+          int idx1 = outIdx1 + run.Y;
+          int idx2 = outIdx2 + run.Z;
+          if (idx1 >= region[2] && idx1 <= region[3] && idx2 >= region[4] && idx2 <= region[5])
+          {
+            const T* planeRow = ringPlanes(idx2) + run.Window * planeSize +
+              static_cast<vtkIdType>(idx1 - region[2]) * outSize0;
+            vtkImageMorphologyRow<Op>(row.data(), planeRow, outSize0);
+          }
+        }
+
+        T* outRow =
+          outPtr + c + (outIdx1 - outExt[2]) * outInc[1] + (outIdx2 - outExt[4]) * outInc[2];
+        for (int idx0 = 0; idx0 < outSize0; idx0++)
+        {
+          outRow[idx0 * outInc[0]] = row[idx0];
+        }
+      }
+    }
+  }
+}
+
+#endif
+// VTK-HeaderTest-Exclude: vtkImageMorphologyInternals.h
@@ -232,6 +232,56 @@ void vtkImageOpenClose3D::SetKernelSize(int size0, int size1, int size2)
   // Sub filters take care of modified.
 }
 
+//------------------------------------------------------------------------------
+void vtkImageOpenClose3D::SetAlgorithm(int algorithm)
+{
+  if (!this->Filter0 || !this->Filter1)
+  {
+    vtkErrorMacro(<< "SetAlgorithm: Sub filter not created yet.");
+    return;
+  }
+
+  this->Filter0->SetAlgorithm(algorithm);
+  this->Filter1->SetAlgorithm(algorithm);
+}
+
+//------------------------------------------------------------------------------
+int vtkImageOpenClose3D::GetAlgorithm()
+{
+  if (!this->Filter0)
+  {
+    vtkErrorMacro(<< "GetAlgorithm: Sub filter not created yet.");
+    return vtkImageDilateErode3D::Neighborhood;
+  }
+
+  return this->Filter0->GetAlgorithm();
+}
+
+//------------------------------------------------------------------------------
+void vtkImageOpenClose3D::SetKernelShape(int shape)
+{
+  if (!this->Filter0 || !this->Filter1)
+  {
+    vtkErrorMacro(<< "SetKernelShape: Sub filter not created yet.");
+    return;
+  }
+
+  this->Filter0->SetKernelShape(shape);
+  this->Filter1->SetKernelShape(shape);
+}
+
+//------------------------------------------------------------------------------
+int vtkImageOpenClose3D::GetKernelShape()
+{
+  if (!this->Filter0)
+  {
+    vtkErrorMacro(<< "GetKernelShape: Sub filter not created yet.");
+    return vtkImageDilateErode3D::Ellipsoid;
+  }
+
+  return this->Filter0->GetKernelShape();
+}
+
 //------------------------------------------------------------------------------
 // Determines the value that will closed.
 // Close value is first dilated, and then eroded
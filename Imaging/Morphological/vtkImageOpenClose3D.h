@@ -76,6 +76,17 @@ public:
    */
   void SetKernelSize(int size0, int size1, int size2);
 
+  ///@{
+  /**
+   * The algorithm and the footprint shape of the sub filters, see
+   * vtkImageDilateErode3D.
+   */
+  void SetAlgorithm(int algorithm);
+  int GetAlgorithm();
+  void SetKernelShape(int shape);
+  int GetKernelShape();
+  ///@}
+
   ///@{
   /**
    * Determines the value that will opened.
@@ -0,0 +1,166 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkImageHistogramSink.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkImageHistogramSink.h"
+
+#include "vtkIdTypeArray.h"
+#include "vtkImageData.h"
+#include "vtkImageHistogram.h"
+#include "vtkObjectFactory.h"
+
+#include <cmath>
+
+vtkStandardNewMacro(vtkImageHistogramSink);
+
+//------------------------------------------------------------------------------
+vtkImageHistogramSink::vtkImageHistogramSink()
+{
+  this->ActiveComponent = -1;
+  this->NumberOfBins = 256;
+  this->BinOrigin = 0.0;
+  this->BinSpacing = 1.0;
+
+  this->Histogram = vtkIdTypeArray::New();
+  this->Total = 0;
+  this->Minimum = 0;
+  this->Maximum = 0;
+  this->Mean = 0;
+  this->Median = 0;
+  this->StandardDeviation = 0;
+
+  this->PieceHistogram = vtkImageHistogram::New();
+  this->PieceHistogram->AutomaticBinningOff();
+  this->PieceHistogram->GenerateHistogramImageOff();
+}
+
+//------------------------------------------------------------------------------
+vtkImageHistogramSink::~vtkImageHistogramSink()
+{
+  this->Histogram->Delete();
+  this->PieceHistogram->Delete();
+}
+
+//------------------------------------------------------------------------------
+void vtkImageHistogramSink::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+
+  os << indent << "ActiveComponent: " << this->ActiveComponent << "\n";
+  os << indent << "NumberOfBins: " << this->NumberOfBins << "\n";
+  os << indent << "BinOrigin: " << this->BinOrigin << "\n";
+  os << indent << "BinSpacing: " << this->BinSpacing << "\n";
+  os << indent << "Total: " << this->Total << "\n";
+  os << indent << "Minimum: " << this->Minimum << "\n";
+  os << indent << "Maximum: " << this->Maximum << "\n";
+  os << indent << "Mean: " << this->Mean << "\n";
+  os << indent << "Median: " << this->Median << "\n";
+  os << indent << "StandardDeviation: " << this->StandardDeviation << "\n";
+}
+
+//------------------------------------------------------------------------------
+int vtkImageHistogramSink::BeginStreaming(vtkInformation*, const int[6])
+{
+  if (this->NumberOfBins < 1 || this->BinSpacing <= 0.0)
+  {
+    vtkErrorMacro("BeginStreaming: NumberOfBins and BinSpacing must be positive.");
+    return 0;
+  }
+
+  this->Histogram->SetNumberOfComponents(1);
+  this->Histogram->SetNumberOfTuples(this->NumberOfBins);
+  this->Histogram->FillValue(0);
+  this->Total = 0;
+
+  this->PieceHistogram->SetActiveComponent(this->ActiveComponent);
+  this->PieceHistogram->SetNumberOfBins(this->NumberOfBins);
+  this->PieceHistogram->SetBinOrigin(this->BinOrigin);
+  this->PieceHistogram->SetBinSpacing(this->BinSpacing);
+
+  return 1;
+}
+
+//------------------------------------------------------------------------------
+int vtkImageHistogramSink::ConsumePiece(vtkImageData* piece)
+{
+  this->PieceHistogram->SetInputData(piece);
+  this->PieceHistogram->Update();
+  this->PieceHistogram->SetInputData(nullptr);
+
+  vtkIdTypeArray* histogram = this->PieceHistogram->GetHistogram();
+  if (histogram->GetNumberOfTuples() != this->NumberOfBins)
+  {
+    return 0;
+  }
+  vtkIdType* sum = this->Histogram->GetPointer(0);
+  const vtkIdType* counts = histogram->GetPointer(0);
+  for (int i = 0; i < this->NumberOfBins; i++)
+  {
+    sum[i] += counts[i];
+  }
+  this->Total += this->PieceHistogram->GetTotal();
+
+  return 1;
+}
+
+//------------------------------------------------------------------------------
+int vtkImageHistogramSink::EndStreaming()
+{
+  // the bins of the extremes, the median, and the moments about bin zero
+  const vtkIdType* histogram = this->Histogram->GetPointer(0);
+  vtkIdType total = this->Total;
+  vtkIdType sum = 0;
+  int minBin = -1;
+  int maxBin = 0;
+  int midBin = 0;
+  double mom1 = 0.0;
+  double mom2 = 0.0;
+  for (int i = 0; i < this->NumberOfBins; i++)
+  {
+    vtkIdType c = histogram[i];
+    sum += c;
+    mom1 += static_cast<double>(c) * i;
+    mom2 += static_cast<double>(c) * i * i;
+    midBin = (sum > total / 2 ? midBin : i);
+    minBin = (sum > 0 ? minBin : i);
+    maxBin = (c == 0 ? maxBin : i);
+  }
+  if (minBin < maxBin)
+  {
+    minBin++;
+  }
+
+  this->Minimum = minBin * this->BinSpacing + this->BinOrigin;
+  this->Maximum = maxBin * this->BinSpacing + this->BinOrigin;
+  this->Median = midBin * this->BinSpacing + this->BinOrigin;
+  this->Mean = 0.0;
+  this->StandardDeviation = 0.0;
+  if (total > 0)
+  {
+    this->Mean = mom1 / total * this->BinSpacing + this->BinOrigin;
+  }
+  if (total > 1)
+  {
+    // use the second moment about the mean, to avoid cancellation
+    double mean = mom1 / total;
+    double var = 0.0;
+    for (int i = 0; i < this->NumberOfBins; i++)
+    {
+      var += (i - mean) * (i - mean) * histogram[i];
+    }
+    this->StandardDeviation = sqrt(var / (total - 1)) * this->BinSpacing;
+  }
+  this->Modified();
+
+  return 1;
+}
@@ -0,0 +1,135 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkImageHistogramSink.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkImageHistogramSink
+ * @brief   Accumulate the histogram of a streamed image
+ *
+ * vtkImageHistogramSink is a vtkImageStreamingSink that adds up the
+ * histograms of the pieces streamed by vtkImageDataStreamer, so that the
+ * histogram and the statistics of an image can be computed without ever
+ * having the whole image in memory.  The bins must be set before the
+ * streaming starts, since the range of the data is not known in advance.
+ * The statistics are computed from the histogram, in the same way as
+ * vtkImageHistogramStatistics.
+ * @sa
+ * vtkImageDataStreamer vtkImageHistogram vtkImageHistogramStatistics
+ */
+
+#ifndef vtkImageHistogramSink_h
+#define vtkImageHistogramSink_h
+
+#include "vtkImageStreamingSink.h"
+#include "vtkImagingStatisticsModule.h" // For export macro
+
+class vtkIdTypeArray;
+class vtkImageHistogram;
+
+class VTKIMAGINGSTATISTICS_EXPORT vtkImageHistogramSink : public vtkImageStreamingSink
+{
+public:
+  static vtkImageHistogramSink* New();
+  vtkTypeMacro(vtkImageHistogramSink, vtkImageStreamingSink);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  ///@{
+  /**
+   * Set the component for which to generate a histogram.  The default
+   * value is -1, which produces a histogram that is the sum of the
+   * histograms of the individual components.
+   */
+  vtkSetMacro(ActiveComponent, int);
+  vtkGetMacro(ActiveComponent, int);
+  ///@}
+
+  ///@{
+  /**
+   * The number of bins in histogram.  The default is 256.
+   */
+  vtkSetMacro(NumberOfBins, int);
+  vtkGetMacro(NumberOfBins, int);
+  ///@}
+
+  ///@{
+  /**
+   * The value for the center of the first bin.  The default is 0.
+   */
+  vtkSetMacro(BinOrigin, double);
+  vtkGetMacro(BinOrigin, double);
+  ///@}
+
+  ///@{
+  /**
+   * The bin spacing.  The default is 1.
+   */
+  vtkSetMacro(BinSpacing, double);
+  vtkGetMacro(BinSpacing, double);
+  ///@}
+
+  /**
+   * Get the histogram of all the pieces that were consumed.
+   */
+  vtkIdTypeArray* GetHistogram() { return this->Histogram; }
+
+  /**
+   * Get the total count of the histogram.
+   */
+  vtkIdType GetTotal() { return this->Total; }
+
+  ///@{
+  /**
+   * Get the statistics of the histogram, which are computed when the
+   * streaming ends.
+   */
+  double GetMinimum() { return this->Minimum; }
+  double GetMaximum() { return this->Maximum; }
+  double GetMean() { return this->Mean; }
+  double GetMedian() { return this->Median; }
+  double GetStandardDeviation() { return this->StandardDeviation; }
+  ///@}
+
+  ///@{
+  /**
+   * See vtkImageStreamingSink.
+   */
+  int BeginStreaming(vtkInformation* inInfo, const int extent[6]) override;
+  int ConsumePiece(vtkImageData* piece) override;
+  int EndStreaming() override;
+  ///@}
+
+protected:
+  vtkImageHistogramSink();
+  ~vtkImageHistogramSink() override;
+
+  int ActiveComponent;
+  int NumberOfBins;
+  double BinOrigin;
+  double BinSpacing;
+
+  vtkIdTypeArray* Histogram;
+  vtkIdType Total;
+  double Minimum;
+  double Maximum;
+  double Mean;
+  double Median;
+  double StandardDeviation;
+
+  vtkImageHistogram* PieceHistogram;
+
+private:
+  vtkImageHistogramSink(const vtkImageHistogramSink&) = delete;
+  void operator=(const vtkImageHistogramSink&) = delete;
+};
+
+#endif
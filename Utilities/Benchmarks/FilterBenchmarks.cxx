@@ -0,0 +1,750 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    FilterBenchmarks.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+/*
+Times the data processing filters on synthetic inputs with every SMP
+backend built in VTK and an increasing number of threads, and writes the
+results as JSON so that they can be compared between VTK versions and
+machines. The inputs are an image volume, a hexahedral and a tetrahedral
+unstructured grid, a triangle soup, a triangle mesh and a point cloud,
+all generated from --size. Run with --help for the options.
+
+To add a benchmark, add an entry to the list returned by MakeBenchmarks()
+creating the algorithm set up on one of the inputs.
+*/
+
+#include "vtkAlgorithm.h"
+#include "vtkAppendFilter.h"
+#include "vtkAppendPolyData.h"
+#include "vtkCellArray.h"
+#include "vtkCellType.h"
+#include "vtkCleanPolyData.h"
+#include "vtkContourFilter.h"
+#include "vtkCutter.h"
+#include "vtkDataSet.h"
+#include "vtkDataSetSurfaceFilter.h"
+#include "vtkFlyingEdges3D.h"
+#include "vtkFloatArray.h"
+#include "vtkGradientFilter.h"
+#include "vtkIdTypeArray.h"
+#include "vtkImageCast.h"
+#include "vtkImageContinuousDilate3D.h"
+#include "vtkImageData.h"
+#include "vtkImageEuclideanDistance.h"
+#include "vtkImageMarchingCubes.h"
+#include "vtkImageMedian3D.h"
+#include "vtkImageReslice.h"
+#include "vtkImageThreshold.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkPlane.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataNormals.h"
+#include "vtkProbeFilter.h"
+#include "vtkQuadricDecimation.h"
+#include "vtkRTAnalyticSource.h"
+#include "vtkResampleToImage.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkStreamTracer.h"
+#include "vtkTableBasedClipDataSet.h"
+#include "vtkThreshold.h"
+#include "vtkUnstructuredGrid.h"
+#include "vtkVersion.h"
+#include "vtkXMLImageDataReader.h"
+#include "vtkXMLImageDataWriter.h"
+#include "vtkXMLPolyDataReader.h"
+#include "vtkXMLPolyDataWriter.h"
+#include "vtkXMLUnstructuredGridReader.h"
+#include "vtkXMLUnstructuredGridWriter.h"
+#include "vtkXMLWriterBase.h"
+
+#include <vtksys/SystemInformation.hxx>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+//------------------------------------------------------------------------------
+// Synthetic inputs
+//------------------------------------------------------------------------------
+struct Inputs
+{
+  vtkSmartPointer<vtkImageData> Image;
+  vtkSmartPointer<vtkUnstructuredGrid> Hexahedra;
+  vtkSmartPointer<vtkUnstructuredGrid> Tetrahedra;
+  vtkSmartPointer<vtkPolyData> TriangleSoup;
+  vtkSmartPointer<vtkPolyData> Mesh;
+  vtkSmartPointer<vtkPolyData> PointCloud;
+  vtkSmartPointer<vtkPolyData> Seeds;
+  // The image, hexahedra and mesh written by the XML writers, for the readers.
+  std::string ImageXML;
+  std::string HexahedraXML;
+  std::string MeshXML;
+};
+
+// Image volume of size^3 points with the "RTData" point scalars.
+vtkSmartPointer<vtkImageData> MakeImage(int size)
+{
+  vtkNew<vtkRTAnalyticSource> source;
+  int half = size / 2;
+  source->SetWholeExtent(-half, size - 1 - half, -half, size - 1 - half, -half, size - 1 - half);
+  source->Update();
+  return vtkImageData::SafeDownCast(source->GetOutputDataObject(0));
+}
+
+// Unstructured grid on a lattice of size^3 points spanning [-1, 1]^3, made
+// of hexahedra or of 6 tetrahedra per hexahedron. It has the "scalars" and
+// "velocity" (a vortex around the z axis) point arrays.
+vtkSmartPointer<vtkUnstructuredGrid> MakeGrid(int size, bool tetrahedra)
+{
+  vtkIdType n = std::max(2, size);
+  vtkNew<vtkPoints> points;
+  points->SetDataTypeToFloat();
+  points->SetNumberOfPoints(n * n * n);
+  vtkNew<vtkFloatArray> scalars;
+  scalars->SetName("scalars");
+  scalars->SetNumberOfTuples(n * n * n);
+  vtkNew<vtkFloatArray> velocity;
+  velocity->SetName("velocity");
+  velocity->SetNumberOfComponents(3);
+  velocity->SetNumberOfTuples(n * n * n);
+  double spacing = 2.0 / (n - 1);
+  vtkSMPTools::For(0, n, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType k = begin; k < end; ++k)
+    {
+      for (vtkIdType j = 0; j < n; ++j)
+      {
+        for (vtkIdType i = 0; i < n; ++i)
+        {
+          vtkIdType id = i + n * (j + n * k);
+          double x = -1 + i * spacing, y = -1 + j * spacing, z = -1 + k * spacing;
+          points->SetPoint(id, x, y, z);
+          scalars->SetValue(id, std::sin(3 * x) * std::cos(3 * y) + z * z);
+          velocity->SetTuple3(id, -y + 0.1 * x, x + 0.1 * y, 0.2 * (1 - z * z));
+        }
+      }
+    }
+  });
+
+  // Hexahedron corners in VTK order, then the tetrahedra sharing the
+  // diagonal from corner 0 to corner 6, which conform between neighbors.
+  static const int hexahedron[8] = { 0, 1, 3, 2, 4, 5, 7, 6 };
+  static const int tetrahedronCorners[6][4] = { { 0, 1, 2, 6 }, { 0, 2, 3, 6 },
+    { 0, 3, 7, 6 }, { 0, 7, 4, 6 }, { 0, 4, 5, 6 }, { 0, 5, 1, 6 } };
+  vtkIdType numberOfHexahedra = (n - 1) * (n - 1) * (n - 1);
+  int cellsPerHexahedron = tetrahedra ? 6 : 1;
+  int cellSize = tetrahedra ? 4 : 8;
+  vtkNew<vtkIdTypeArray> offsets;
+  offsets->SetNumberOfValues(numberOfHexahedra * cellsPerHexahedron + 1);
+  vtkNew<vtkIdTypeArray> connectivity;
+  connectivity->SetNumberOfValues(numberOfHexahedra * cellsPerHexahedron * cellSize);
+  vtkSMPTools::For(0, numberOfHexahedra, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType h = begin; h < end; ++h)
+    {
+      vtkIdType i = h % (n - 1), j = (h / (n - 1)) % (n - 1), k = h / ((n - 1) * (n - 1));
+      // Corners numbered by their bits: 1 for +x, 2 for +y and 4 for +z.
+      vtkIdType corners[8];
+      for (int c = 0; c < 8; ++c)
+      {
+        corners[c] = (i + (c & 1)) + n * ((j + ((c >> 1) & 1)) + n * (k + ((c >> 2) & 1)));
+      }
+      vtkIdType cell = h * cellsPerHexahedron;
+      vtkIdType* ids = connectivity->GetPointer(cell * cellSize);
+      if (tetrahedra)
+      {
+        // Tetrahedra corners in VTK hexahedron order, mapped to bits.
+        for (int t = 0; t < 6; ++t)
+        {
+          offsets->SetValue(cell + t, (cell + t) * 4);
+          for (int c = 0; c < 4; ++c)
+          {
+            *ids++ = corners[hexahedron[tetrahedronCorners[t][c]]];
+          }
+        }
+      }
+      else
+      {
+        offsets->SetValue(cell, cell * 8);
+        for (int c = 0; c < 8; ++c)
+        {
+          *ids++ = corners[hexahedron[c]];
+        }
+      }
+    }
+  });
+  offsets->SetValue(numberOfHexahedra * cellsPerHexahedron, connectivity->GetNumberOfValues());
+
+  vtkNew<vtkCellArray> cells;
+  cells->SetData(offsets, connectivity);
+  auto grid = vtkSmartPointer<vtkUnstructuredGrid>::New();
+  grid->SetPoints(points);
+  grid->SetCells(tetrahedra ? VTK_TETRA : VTK_HEXAHEDRON, cells);
+  grid->GetPointData()->SetScalars(scalars);
+  grid->GetPointData()->SetVectors(velocity);
+  return grid;
+}
+
+// Triangles not sharing their points, as read from STL files.
+vtkSmartPointer<vtkPolyData> MakeTriangleSoup(vtkPolyData* mesh)
+{
+  vtkPoints* meshPoints = mesh->GetPoints();
+  vtkCellArray* meshTriangles = mesh->GetPolys();
+  vtkIdType numberOfTriangles = meshTriangles->GetNumberOfCells();
+  vtkNew<vtkPoints> points;
+  points->SetDataType(meshPoints->GetDataType());
+  points->SetNumberOfPoints(3 * numberOfTriangles);
+  vtkNew<vtkIdTypeArray> offsets;
+  offsets->SetNumberOfValues(numberOfTriangles + 1);
+  vtkNew<vtkIdTypeArray> connectivity;
+  connectivity->SetNumberOfValues(3 * numberOfTriangles);
+  vtkIdType triangle = 0;
+  vtkIdType numberOfIds;
+  const vtkIdType* ids;
+  for (meshTriangles->InitTraversal(); meshTriangles->GetNextCell(numberOfIds, ids); ++triangle)
+  {
+    offsets->SetValue(triangle, 3 * triangle);
+    for (int c = 0; c < 3; ++c)
+    {
+      points->SetPoint(3 * triangle + c, meshPoints->GetPoint(ids[c]));
+      connectivity->SetValue(3 * triangle + c, 3 * triangle + c);
+    }
+  }
+  offsets->SetValue(numberOfTriangles, 3 * numberOfTriangles);
+
+  vtkNew<vtkCellArray> triangles;
+  triangles->SetData(offsets, connectivity);
+  auto soup = vtkSmartPointer<vtkPolyData>::New();
+  soup->SetPoints(points);
+  soup->SetPolys(triangles);
+  return soup;
+}
+
+// Points uniformly distributed in [-1, 1]^3, always the same ones.
+vtkSmartPointer<vtkPolyData> MakePointCloud(vtkIdType numberOfPoints, int seed)
+{
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(seed);
+  vtkNew<vtkPoints> points;
+  points->SetNumberOfPoints(numberOfPoints);
+  for (vtkIdType i = 0; i < numberOfPoints; ++i)
+  {
+    double x[3];
+    for (int c = 0; c < 3; ++c)
+    {
+      x[c] = random->GetNextRangeValue(-1.0, 1.0);
+    }
+    points->SetPoint(i, x);
+  }
+  auto cloud = vtkSmartPointer<vtkPolyData>::New();
+  cloud->SetPoints(points);
+  return cloud;
+}
+
+template <typename WriterT>
+std::string WriteXML(vtkDataObject* data)
+{
+  vtkNew<WriterT> writer;
+  writer->SetInputData(data);
+  writer->WriteToOutputStringOn();
+  writer->Write();
+  return writer->GetOutputString();
+}
+
+Inputs MakeInputs(int size)
+{
+  Inputs inputs;
+  inputs.Image = MakeImage(size);
+  inputs.Hexahedra = MakeGrid(size / 2, false);
+  inputs.Tetrahedra = MakeGrid(size / 3, true);
+
+  vtkNew<vtkFlyingEdges3D> contour;
+  contour->SetInputData(inputs.Image);
+  contour->SetValue(0, 150.0);
+  contour->ComputeNormalsOff();
+  contour->ComputeGradientsOff();
+  contour->ComputeScalarsOff();
+  contour->Update();
+  inputs.Mesh = contour->GetOutput();
+  inputs.TriangleSoup = MakeTriangleSoup(inputs.Mesh);
+
+  inputs.PointCloud = MakePointCloud(static_cast<vtkIdType>(size) * size * size / 8, 1);
+  inputs.Seeds = MakePointCloud(256, 2);
+
+  inputs.ImageXML = WriteXML<vtkXMLImageDataWriter>(inputs.Image);
+  inputs.HexahedraXML = WriteXML<vtkXMLUnstructuredGridWriter>(inputs.Hexahedra);
+  inputs.MeshXML = WriteXML<vtkXMLPolyDataWriter>(inputs.Mesh);
+  return inputs;
+}
+
+//------------------------------------------------------------------------------
+// Benchmarks
+//------------------------------------------------------------------------------
+struct Benchmark
+{
+  const char* Name;
+  const char* Input;
+  // Creates the algorithm set up on the inputs, executed at each run.
+  std::function<vtkSmartPointer<vtkAlgorithm>(const Inputs&)> Create;
+};
+
+vtkSmartPointer<vtkPlane> MakePlane()
+{
+  auto plane = vtkSmartPointer<vtkPlane>::New();
+  plane->SetOrigin(0.1, 0.2, 0.05);
+  plane->SetNormal(1, 1, 1);
+  return plane;
+}
+
+template <typename ReaderT>
+vtkSmartPointer<vtkAlgorithm> MakeReader(const std::string& xml)
+{
+  auto reader = vtkSmartPointer<ReaderT>::New();
+  reader->ReadFromInputStringOn();
+  reader->SetInputString(xml);
+  return reader;
+}
+
+template <typename WriterT>
+vtkSmartPointer<vtkAlgorithm> MakeWriter(vtkDataObject* data)
+{
+  auto writer = vtkSmartPointer<WriterT>::New();
+  writer->SetInputData(data);
+  writer->WriteToOutputStringOn();
+  return writer;
+}
+
+// Median filter of the image, converted to an integer type
+vtkSmartPointer<vtkAlgorithm> MakeMedian(vtkImageData* image, int kernelSize)
+{
+  vtkNew<vtkImageCast> cast;
+  cast->SetInputData(image);
+  cast->SetOutputScalarTypeToUnsignedShort();
+  cast->ClampOverflowOn();
+  cast->Update();
+  auto filter = vtkSmartPointer<vtkImageMedian3D>::New();
+  filter->SetInputData(cast->GetOutput());
+  filter->SetKernelSize(kernelSize, kernelSize, kernelSize);
+  return filter;
+}
+
+std::vector<Benchmark> MakeBenchmarks()
+{
+  std::vector<Benchmark> benchmarks;
+  benchmarks.push_back({ "ContourImage", "image", [](const Inputs& inputs) {
+                          auto filter = vtkSmartPointer<vtkContourFilter>::New();
+                          filter->SetInputData(inputs.Image);
+                          filter->SetValue(0, 150.0);
+                          return vtkSmartPointer<vtkAlgorithm>(filter);
+                        } });
+  benchmarks.push_back({ "MarchingCubesImage", "image", [](const Inputs& inputs) {
+                          auto filter = vtkSmartPointer<vtkImageMarchingCubes>::New();
+                          filter->SetInputData(inputs.Image);
+                          filter->SetValue(0, 150.0);
+                          return vtkSmartPointer<vtkAlgorithm>(filter);
+                        } });
+  benchmarks.push_back({ "ContourTetrahedra", "tetrahedra", [](const Inputs& inputs) {
+                          auto filter = vtkSmartPointer<vtkContourFilter>::New();
+                          filter->SetInputData(inputs.Tetrahedra);
+                          filter->SetValue(0, 0.5);
+                          return vtkSmartPointer<vtkAlgorithm>(filter);
+                        } });
+  benchmarks.push_back({ "Cut", "hexahedra", [](const Inputs& inputs) {
+                          auto filter = vtkSmartPointer<vtkCutter>::New();
+                          filter->SetInputData(inputs.Hexahedra);
+                          filter->SetCutFunction(MakePlane());
+                          return vtkSmartPointer<vtkAlgorithm>(filter);
+                        } });
+  benchmarks.push_back({ "Clip", "hexahedra", [](const Inputs& inputs) {
+                          auto filter = vtkSmartPointer<vtkTableBasedClipDataSet>::New();
+                          filter->SetInputData(inputs.Hexahedra);
+                          filter->SetClipFunction(MakePlane());
+                          return vtkSmartPointer<vtkAlgorithm>(filter);
+                        } });
+  benchmarks.push_back({ "Threshold", "hexahedra", [](const Inputs& inputs) {
+                          auto filter = vtkSmartPointer<vtkThreshold>::New();
+                          filter->SetInputData(inputs.Hexahedra);
+                          filter->SetInputArrayToProcess(
+                            0, 0, 0, vtkDataObject::FIELD_ASSOCIATION_POINTS, "scalars");
+                          filter->SetLowerThreshold(0.0);
+                          filter->SetUpperThreshold(1.0);
+                          filter->SetThresholdFunction(vtkThreshold::THRESHOLD_BETWEEN);
+                          return vtkSmartPointer<vtkAlgorithm>(filter);
+                        } });
+  benchmarks.push_back({ "Gradient", "tetrahedra", [](const Inputs& inputs) {
+                          auto filter = vtkSmartPointer<vtkGradientFilter>::New();
+                          filter->SetInputData(inputs.Tetrahedra);
+                          filter->SetInputScalars(
+                            vtkDataObject::FIELD_ASSOCIATION_POINTS, "velocity");
+                          filter->ComputeVorticityOn();
+                          return vtkSmartPointer<vtkAlgorithm>(filter);
+                        } });
+  benchmarks.push_back({ "Probe", "point cloud", [](const Inputs& inputs) {
+                          auto filter = vtkSmartPointer<vtkProbeFilter>::New();
+                          filter->SetInputData(inputs.PointCloud);
+                          filter->SetSourceData(inputs.Hexahedra);
+                          return vtkSmartPointer<vtkAlgorithm>(filter);
+                        } });
+  benchmarks.push_back({ "Resample", "tetrahedra", [](const Inputs& inputs) {
+                          auto filter = vtkSmartPointer<vtkResampleToImage>::New();
+                          filter->SetInputDataObject(inputs.Tetrahedra);
+                          int dimension = inputs.Image->GetDimensions()[0] / 2;
+                          filter->SetSamplingDimensions(dimension, dimension, dimension);
+                          return vtkSmartPointer<vtkAlgorithm>(filter);
+                        } });
+  benchmarks.push_back({ "EuclideanDistance", "image", [](const Inputs& inputs) {
+                          // the distance to the voxels above the contour value
+                          vtkNew<vtkImageThreshold> mask;
+                          mask->SetInputData(inputs.Image);
+                          mask->ThresholdByUpper(150.0);
+                          mask->SetInValue(0);
+                          mask->SetOutValue(1);
+                          mask->SetOutputScalarTypeToUnsignedChar();
+                          mask->Update();
+                          auto filter = vtkSmartPointer<vtkImageEuclideanDistance>::New();
+                          filter->SetInputData(mask->GetOutput());
+                          filter->SetAlgorithmToFelzenszwalb();
+                          return vtkSmartPointer<vtkAlgorithm>(filter);
+                        } });
+  // the cost of the median should hardly depend on the kernel size
+  benchmarks.push_back({ "Median3x3x3", "image", [](const Inputs& inputs) {
+                          return MakeMedian(inputs.Image, 3);
+                        } });
+  benchmarks.push_back({ "Median9x9x9", "image", [](const Inputs& inputs) {
+                          return MakeMedian(inputs.Image, 9);
+                        } });
+  benchmarks.push_back({ "ResliceOblique", "image", [](const Inputs& inputs) {
+                          // an oblique multi-planar reformat of the whole volume
+                          auto filter = vtkSmartPointer<vtkImageReslice>::New();
+                          filter->SetInputData(inputs.Image);
+                          filter->SetResliceAxesDirectionCosines(
+                            0.8, 0.6, 0.0, -0.48, 0.64, 0.6, 0.36, -0.48, 0.8);
+                          filter->SetInterpolationModeToLinear();
+                          filter->SetOutputDimensionality(3);
+                          return vtkSmartPointer<vtkAlgorithm>(filter);
+                        } });
+  benchmarks.push_back({ "DilateBox15", "image", [](const Inputs& inputs) {
+                          auto filter = vtkSmartPointer<vtkImageContinuousDilate3D>::New();
+                          filter->SetInputData(inputs.Image);
+                          filter->SetKernelSize(15, 15, 15);
+                          filter->SetKernelShapeToBox();
+                          filter->SetAlgorithmToSeparable();
+                          return vtkSmartPointer<vtkAlgorithm>(filter);
+                        } });
+  benchmarks.push_back({ "DilateEllipsoid9", "image", [](const Inputs& inputs) {
+                          auto filter = vtkSmartPointer<vtkImageContinuousDilate3D>::New();
+                          filter->SetInputData(inputs.Image);
+                          filter->SetKernelSize(9, 9, 9);
+                          filter->SetAlgorithmToSeparable();
+                          return vtkSmartPointer<vtkAlgorithm>(filter);
+                        } });
+  benchmarks.push_back({ "Surface", "hexahedra", [](const Inputs& inputs) {
+                          auto filter = vtkSmartPointer<vtkDataSetSurfaceFilter>::New();
+                          filter->SetInputData(inputs.Hexahedra);
+                          return vtkSmartPointer<vtkAlgorithm>(filter);
+                        } });
+  benchmarks.push_back({ "Clean", "triangle soup", [](const Inputs& inputs) {
+                          auto filter = vtkSmartPointer<vtkCleanPolyData>::New();
+                          filter->SetInputData(inputs.TriangleSoup);
+                          return vtkSmartPointer<vtkAlgorithm>(filter);
+                        } });
+  benchmarks.push_back({ "Normals", "mesh", [](const Inputs& inputs) {
+                          auto filter = vtkSmartPointer<vtkPolyDataNormals>::New();
+                          filter->SetInputData(inputs.Mesh);
+                          return vtkSmartPointer<vtkAlgorithm>(filter);
+                        } });
+  benchmarks.push_back({ "Decimation", "mesh", [](const Inputs& inputs) {
+                          auto filter = vtkSmartPointer<vtkQuadricDecimation>::New();
+                          filter->SetInputData(inputs.Mesh);
+                          filter->SetTargetReduction(0.75);
+                          return vtkSmartPointer<vtkAlgorithm>(filter);
+                        } });
+  benchmarks.push_back({ "Streamlines", "hexahedra", [](const Inputs& inputs) {
+                          auto filter = vtkSmartPointer<vtkStreamTracer>::New();
+                          filter->SetInputData(inputs.Hexahedra);
+                          filter->SetSourceData(inputs.Seeds);
+                          filter->SetIntegrationDirectionToBoth();
+                          filter->SetIntegratorTypeToRungeKutta45();
+                          filter->SetMaximumPropagation(20.0);
+                          return vtkSmartPointer<vtkAlgorithm>(filter);
+                        } });
+  benchmarks.push_back({ "AppendGrids", "hexahedra, tetrahedra", [](const Inputs& inputs) {
+                          auto filter = vtkSmartPointer<vtkAppendFilter>::New();
+                          filter->AddInputData(inputs.Hexahedra);
+                          filter->AddInputData(inputs.Tetrahedra);
+                          return vtkSmartPointer<vtkAlgorithm>(filter);
+                        } });
+  benchmarks.push_back({ "AppendPolyData", "mesh, triangle soup", [](const Inputs& inputs) {
+                          auto filter = vtkSmartPointer<vtkAppendPolyData>::New();
+                          filter->AddInputData(inputs.Mesh);
+                          filter->AddInputData(inputs.TriangleSoup);
+                          return vtkSmartPointer<vtkAlgorithm>(filter);
+                        } });
+  benchmarks.push_back({ "WriteImageXML", "image", [](const Inputs& inputs) {
+                          return MakeWriter<vtkXMLImageDataWriter>(inputs.Image);
+                        } });
+  benchmarks.push_back({ "WriteUnstructuredGridXML", "hexahedra", [](const Inputs& inputs) {
+                          return MakeWriter<vtkXMLUnstructuredGridWriter>(inputs.Hexahedra);
+                        } });
+  benchmarks.push_back({ "WritePolyDataXML", "mesh", [](const Inputs& inputs) {
+                          return MakeWriter<vtkXMLPolyDataWriter>(inputs.Mesh);
+                        } });
+  benchmarks.push_back({ "ReadImageXML", "image", [](const Inputs& inputs) {
+                          return MakeReader<vtkXMLImageDataReader>(inputs.ImageXML);
+                        } });
+  benchmarks.push_back({ "ReadUnstructuredGridXML", "hexahedra", [](const Inputs& inputs) {
+                          return MakeReader<vtkXMLUnstructuredGridReader>(inputs.HexahedraXML);
+                        } });
+  benchmarks.push_back({ "ReadPolyDataXML", "mesh", [](const Inputs& inputs) {
+                          return MakeReader<vtkXMLPolyDataReader>(inputs.MeshXML);
+                        } });
+  return benchmarks;
+}
+
+//------------------------------------------------------------------------------
+// JSON output
+//------------------------------------------------------------------------------
+std::string Quote(const std::string& text)
+{
+  std::string quoted = "\"";
+  for (char c : text)
+  {
+    if (c == '"' || c == '\\')
+    {
+      quoted += '\\';
+    }
+    quoted += static_cast<unsigned char>(c) < 0x20 ? ' ' : c;
+  }
+  return quoted + "\"";
+}
+
+// Size of what an algorithm produced, as JSON members.
+std::string DescribeOutput(vtkAlgorithm* algorithm)
+{
+  std::ostringstream os;
+  if (auto writer = vtkXMLWriterBase::SafeDownCast(algorithm))
+  {
+    os << "\"output_bytes\": " << writer->GetOutputString().size();
+  }
+  else if (auto data = vtkDataSet::SafeDownCast(algorithm->GetOutputDataObject(0)))
+  {
+    os << "\"output_points\": " << data->GetNumberOfPoints()
+       << ", \"output_cells\": " << data->GetNumberOfCells();
+  }
+  return os.str();
+}
+
+std::string DescribeInput(const char* name, vtkDataSet* data)
+{
+  std::ostringstream os;
+  os << "    { \"name\": " << Quote(name) << ", \"type\": " << Quote(data->GetClassName())
+     << ", \"points\": " << data->GetNumberOfPoints() << ", \"cells\": "
+     << data->GetNumberOfCells() << " }";
+  return os.str();
+}
+
+void PrintUsage(const char* program)
+{
+  std::cout << "Usage: " << program << " [options]\n"
+            << "  --size N         points per axis of the image volume (default 128); the\n"
+            << "                   grids have N/2 and N/3 points per axis\n"
+            << "  --threads N      largest number of threads (default: all cores)\n"
+            << "  --repeat N       runs of each benchmark, the best is kept (default 3)\n"
+            << "  --backend NAME   only time this SMP backend, may be repeated\n"
+            << "  --benchmark NAME only run this benchmark, may be repeated\n"
+            << "  --output FILE    write the JSON results to FILE instead of stdout\n"
+            << "  --list           list the benchmarks and exit\n";
+}
+}
+
+/*=========================================================================
+The main entry point
+=========================================================================*/
+int main(int argc, char* argv[])
+{
+  int size = 128;
+  int maxThreads = static_cast<int>(std::thread::hardware_concurrency());
+  int repeat = 3;
+  std::vector<std::string> backends;
+  std::vector<std::string> names;
+  std::string outputFile;
+  std::vector<Benchmark> benchmarks = MakeBenchmarks();
+  for (int i = 1; i < argc; ++i)
+  {
+    std::string option = argv[i];
+    if (option == "--list")
+    {
+      for (const Benchmark& benchmark : benchmarks)
+      {
+        std::cout << benchmark.Name << " (" << benchmark.Input << ")\n";
+      }
+      return EXIT_SUCCESS;
+    }
+    if (option == "--help" || i + 1 >= argc)
+    {
+      PrintUsage(argv[0]);
+      return option == "--help" ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+    const char* value = argv[++i];
+    if (option == "--size")
+    {
+      size = std::max(8, std::atoi(value));
+    }
+    else if (option == "--threads")
+    {
+      maxThreads = std::atoi(value);
+    }
+    else if (option == "--repeat")
+    {
+      repeat = std::max(1, std::atoi(value));
+    }
+    else if (option == "--backend")
+    {
+      backends.emplace_back(value);
+    }
+    else if (option == "--benchmark")
+    {
+      names.emplace_back(value);
+    }
+    else if (option == "--output")
+    {
+      outputFile = value;
+    }
+    else
+    {
+      PrintUsage(argv[0]);
+      return EXIT_FAILURE;
+    }
+  }
+  if (backends.empty())
+  {
+    backends = { "Sequential", "STDThread", "TBB", "OpenMP" };
+  }
+  maxThreads = std::max(1, maxThreads);
+
+  std::vector<int> threadCounts;
+  for (int threads = 1; threads < maxThreads; threads *= 2)
+  {
+    threadCounts.push_back(threads);
+  }
+  threadCounts.push_back(maxThreads);
+
+  std::cerr << "Generating the inputs\n";
+  Inputs inputs = MakeInputs(size);
+
+  // The full version is only known in builds from a git checkout.
+  std::string version = vtkVersion::GetVTKVersionFull();
+  if (version.empty())
+  {
+    version = vtkVersion::GetVTKVersion();
+  }
+  vtksys::SystemInformation system;
+  system.RunCPUCheck();
+  system.RunOSCheck();
+  std::ostringstream json;
+  json << "{\n"
+       << "  \"vtk_version\": " << Quote(version) << ",\n"
+       << "  \"system\": { \"os\": " << Quote(system.GetOSName())
+       << ", \"cpu\": " << Quote(system.GetExtendedProcessorName())
+       << ", \"logical_cores\": " << system.GetNumberOfLogicalCPU() << " },\n"
+       << "  \"size\": " << size << ",\n"
+       << "  \"repeat\": " << repeat << ",\n"
+       << "  \"inputs\": [\n"
+       << DescribeInput("image", inputs.Image) << ",\n"
+       << DescribeInput("hexahedra", inputs.Hexahedra) << ",\n"
+       << DescribeInput("tetrahedra", inputs.Tetrahedra) << ",\n"
+       << DescribeInput("triangle soup", inputs.TriangleSoup) << ",\n"
+       << DescribeInput("mesh", inputs.Mesh) << ",\n"
+       << DescribeInput("point cloud", inputs.PointCloud) << "\n"
+       << "  ],\n"
+       << "  \"results\": [";
+
+  const char* separator = "\n";
+  for (const std::string& backend : backends)
+  {
+    if (!vtkSMPTools::SetBackend(backend.c_str()))
+    {
+      std::cerr << backend << " backend not available, skipped\n";
+      continue;
+    }
+    for (const Benchmark& benchmark : benchmarks)
+    {
+      if (!names.empty() && std::find(names.begin(), names.end(), benchmark.Name) == names.end())
+      {
+        continue;
+      }
+      vtkSmartPointer<vtkAlgorithm> algorithm = benchmark.Create(inputs);
+      for (int threads : threadCounts)
+      {
+        double best = 0;
+        double total = 0;
+        vtkSMPTools::LocalScope(vtkSMPTools::Config{ threads, backend, false }, [&]() {
+          for (int run = 0; run < repeat; ++run)
+          {
+            algorithm->Modified();
+            auto start = std::chrono::steady_clock::now();
+            algorithm->Update();
+            auto stop = std::chrono::steady_clock::now();
+            double time = std::chrono::duration<double>(stop - start).count();
+            best = run == 0 ? time : std::min(best, time);
+            total += time;
+          }
+        });
+        std::cerr << backend << " " << benchmark.Name << " " << threads << " threads: " << best
+                  << " s\n";
+        json << separator << "    { \"benchmark\": " << Quote(benchmark.Name)
+             << ", \"input\": " << Quote(benchmark.Input) << ", \"backend\": " << Quote(backend)
+             << ", \"threads\": " << threads << ", \"best_seconds\": " << best
+             << ", \"mean_seconds\": " << total / repeat << ", "
+             << DescribeOutput(algorithm) << " }";
+        separator = ",\n";
+        // The sequential backend ignores the number of threads.
+        if (backend == "Sequential")
+        {
+          break;
+        }
+      }
+    }
+  }
+  json << "\n  ]\n}\n";
+
+  if (outputFile.empty())
+  {
+    std::cout << json.str();
+  }
+  else
+  {
+    std::ofstream file(outputFile);
+    file << json.str();
+    if (!file)
+    {
+      std::cerr << "Could not write " << outputFile << "\n";
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
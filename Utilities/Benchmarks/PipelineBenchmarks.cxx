@@ -0,0 +1,285 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    PipelineBenchmarks.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+/*
+Times the overhead of the pipeline: the update of a long chain of filters
+that do next to nothing, on a single small dataset and on a multiblock of
+small blocks executed block by block. Three updates are timed:
+
+* unmodified: nothing changed since the last update, the passes only check
+  that the outputs are up to date.
+* modified source: the source changed, every filter executes.
+* modified last: only the last filter changed and executes.
+
+The results are written as JSON, see FilterBenchmarks. Run with --help for
+the options.
+*/
+
+#include "vtkCompositeDataPipeline.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPassInputTypeAlgorithm.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkTrivialProducer.h"
+#include "vtkVersion.h"
+
+#include <vtksys/SystemInformation.hxx>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+//------------------------------------------------------------------------------
+// A filter passing its input through, so that only the pipeline is timed.
+class PassFilter : public vtkPassInputTypeAlgorithm
+{
+public:
+  static PassFilter* New();
+  vtkTypeMacro(PassFilter, vtkPassInputTypeAlgorithm);
+
+protected:
+  int RequestData(
+    vtkInformation*, vtkInformationVector** inInfo, vtkInformationVector* outInfo) override
+  {
+    vtkDataObject* input = vtkDataObject::GetData(inInfo[0]);
+    vtkDataObject* output = vtkDataObject::GetData(outInfo);
+    output->ShallowCopy(input);
+    return 1;
+  }
+};
+vtkStandardNewMacro(PassFilter);
+
+vtkSmartPointer<vtkPolyData> MakeBlock()
+{
+  vtkNew<vtkPoints> points;
+  points->InsertNextPoint(0.0, 0.0, 0.0);
+  points->InsertNextPoint(1.0, 0.0, 0.0);
+  points->InsertNextPoint(0.0, 1.0, 0.0);
+  auto block = vtkSmartPointer<vtkPolyData>::New();
+  block->SetPoints(points);
+  return block;
+}
+
+// A single small dataset for 0 blocks, a multiblock otherwise.
+vtkSmartPointer<vtkDataObject> MakeInput(int blocks)
+{
+  if (blocks == 0)
+  {
+    return MakeBlock();
+  }
+  vtkNew<vtkMultiBlockDataSet> input;
+  for (int i = 0; i < blocks; ++i)
+  {
+    input->SetBlock(i, MakeBlock());
+  }
+  return input;
+}
+
+struct Chain
+{
+  vtkSmartPointer<vtkTrivialProducer> Source;
+  std::vector<vtkSmartPointer<vtkAlgorithm>> Filters;
+};
+
+Chain MakeChain(int filters, int blocks)
+{
+  Chain chain;
+  chain.Source = vtkSmartPointer<vtkTrivialProducer>::New();
+  chain.Source->SetOutput(MakeInput(blocks));
+  vtkAlgorithm* previous = chain.Source;
+  for (int i = 0; i < filters; ++i)
+  {
+    auto filter = vtkSmartPointer<PassFilter>::New();
+    filter->SetInputConnection(previous->GetOutputPort());
+    chain.Filters.emplace_back(filter);
+    previous = filter;
+  }
+  return chain;
+}
+
+struct Benchmark
+{
+  const char* Name;
+  // Prepares the chain before each timed update.
+  std::function<void(Chain&)> Prepare;
+};
+
+std::vector<Benchmark> MakeBenchmarks()
+{
+  std::vector<Benchmark> benchmarks;
+  benchmarks.push_back({ "unmodified", [](Chain&) {} });
+  benchmarks.push_back({ "modified source", [](Chain& chain) { chain.Source->Modified(); } });
+  benchmarks.push_back(
+    { "modified last", [](Chain& chain) { chain.Filters.back()->Modified(); } });
+  return benchmarks;
+}
+
+//------------------------------------------------------------------------------
+// JSON output
+//------------------------------------------------------------------------------
+std::string Quote(const std::string& text)
+{
+  std::string quoted = "\"";
+  for (char c : text)
+  {
+    if (c == '"' || c == '\\')
+    {
+      quoted += '\\';
+    }
+    quoted += static_cast<unsigned char>(c) < 0x20 ? ' ' : c;
+  }
+  return quoted + "\"";
+}
+
+void PrintUsage(const char* program)
+{
+  std::cout << "Usage: " << program << " [options]\n"
+            << "  --filters N      length of the chain of filters (default 500)\n"
+            << "  --blocks N       blocks of the multiblock input, may be repeated; 0 is a\n"
+            << "                   single dataset (default 0 and 64)\n"
+            << "  --repeat N       runs of each benchmark, the best is kept (default 10)\n"
+            << "  --output FILE    write the JSON results to FILE instead of stdout\n";
+}
+}
+
+/*=========================================================================
+The main entry point
+=========================================================================*/
+int main(int argc, char* argv[])
+{
+  int filters = 500;
+  int repeat = 10;
+  std::vector<int> blockCounts;
+  std::string outputFile;
+  for (int i = 1; i < argc; ++i)
+  {
+    std::string option = argv[i];
+    if (option == "--help" || i + 1 >= argc)
+    {
+      PrintUsage(argv[0]);
+      return option == "--help" ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+    const char* value = argv[++i];
+    if (option == "--filters")
+    {
+      filters = std::max(1, std::atoi(value));
+    }
+    else if (option == "--blocks")
+    {
+      blockCounts.push_back(std::max(0, std::atoi(value)));
+    }
+    else if (option == "--repeat")
+    {
+      repeat = std::max(1, std::atoi(value));
+    }
+    else if (option == "--output")
+    {
+      outputFile = value;
+    }
+    else
+    {
+      PrintUsage(argv[0]);
+      return EXIT_FAILURE;
+    }
+  }
+  if (blockCounts.empty())
+  {
+    blockCounts = { 0, 64 };
+  }
+
+  // Composite inputs need the composite executive, which handles both.
+  vtkNew<vtkCompositeDataPipeline> prototype;
+  vtkAlgorithm::SetDefaultExecutivePrototype(prototype);
+
+  // The full version is only known in builds from a git checkout.
+  std::string version = vtkVersion::GetVTKVersionFull();
+  if (version.empty())
+  {
+    version = vtkVersion::GetVTKVersion();
+  }
+  vtksys::SystemInformation system;
+  system.RunCPUCheck();
+  system.RunOSCheck();
+  std::ostringstream json;
+  json << "{\n"
+       << "  \"vtk_version\": " << Quote(version) << ",\n"
+       << "  \"system\": { \"os\": " << Quote(system.GetOSName())
+       << ", \"cpu\": " << Quote(system.GetExtendedProcessorName()) << " },\n"
+       << "  \"filters\": " << filters << ",\n"
+       << "  \"repeat\": " << repeat << ",\n"
+       << "  \"results\": [";
+
+  const char* separator = "\n";
+  std::vector<Benchmark> benchmarks = MakeBenchmarks();
+  for (int blocks : blockCounts)
+  {
+    Chain chain = MakeChain(filters, blocks);
+    vtkAlgorithm* last = chain.Filters.back();
+    last->Update();
+    for (const Benchmark& benchmark : benchmarks)
+    {
+      double best = 0;
+      double total = 0;
+      for (int run = 0; run < repeat; ++run)
+      {
+        benchmark.Prepare(chain);
+        auto start = std::chrono::steady_clock::now();
+        last->Update();
+        auto stop = std::chrono::steady_clock::now();
+        double time = std::chrono::duration<double>(stop - start).count();
+        best = run == 0 ? time : std::min(best, time);
+        total += time;
+      }
+      std::cerr << benchmark.Name << ", " << blocks << " blocks: " << best << " s, "
+                << 1e6 * best / filters << " us per filter\n";
+      json << separator << "    { \"benchmark\": " << Quote(benchmark.Name)
+           << ", \"blocks\": " << blocks << ", \"best_seconds\": " << best
+           << ", \"mean_seconds\": " << total / repeat
+           << ", \"best_seconds_per_filter\": " << best / filters << " }";
+      separator = ",\n";
+    }
+  }
+  json << "\n  ]\n}\n";
+  vtkAlgorithm::SetDefaultExecutivePrototype(nullptr);
+
+  if (outputFile.empty())
+  {
+    std::cout << json.str();
+  }
+  else
+  {
+    std::ofstream file(outputFile);
+    file << json.str();
+    if (!file)
+    {
+      std::cerr << "Could not write " << outputFile << "\n";
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
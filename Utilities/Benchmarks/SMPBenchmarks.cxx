@@ -0,0 +1,248 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    SMPBenchmarks.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+/*
+Times vtkSMPTools::For on balanced and imbalanced kernels with every SMP
+backend built in VTK and an increasing number of threads, to compare the
+schedulers of the backends. Run with --help for the options. Each line of
+the output gives the best time over the repetitions and the speedup over
+one thread of the same backend.
+*/
+
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+// A few floating point operations per unit of work.
+inline double Work(vtkIdType units, double seed)
+{
+  double x = seed;
+  for (vtkIdType k = 0; k < units; ++k)
+  {
+    x = std::sqrt(x * x + 1.0);
+  }
+  return x;
+}
+
+struct Kernel
+{
+  const char* Name;
+  const char* Description;
+  // Number of iterations and units of work of iteration i.
+  vtkIdType Size;
+  std::function<vtkIdType(vtkIdType)> Units;
+  vtkIdType Grain;
+  bool Nested;
+};
+
+std::vector<Kernel> MakeKernels(vtkIdType size)
+{
+  std::vector<Kernel> kernels;
+  kernels.push_back(
+    { "Balanced", "same work for every iteration", size, [](vtkIdType) { return 64; }, 0, false });
+  kernels.push_back({ "Fine", "very little work per iteration", 16 * size,
+    [](vtkIdType) { return 1; }, 0, false });
+  kernels.push_back({ "Linear", "work growing with the iteration index", size,
+    [size](vtkIdType i) { return 1 + 128 * i / size; }, 0, false });
+  kernels.push_back({ "HeavyTail", "1% of iterations 500 times longer, at the end", size,
+    [size](vtkIdType i) { return i >= size - size / 100 ? 32000 : 64; }, 0, false });
+  kernels.push_back({ "Clustered", "a few long runs of costly iterations", size,
+    [size](vtkIdType i) { return (i / (size / 64 + 1)) % 16 == 0 ? 1024 : 16; }, 0, false });
+  kernels.push_back({ "GrainOne", "imbalanced, with a grain of 1 as for task lists", size / 64,
+    [size](vtkIdType i) { return i % 7 == 0 ? 4096 : 256; }, 1, false });
+  kernels.push_back({ "Nested", "parallel loops inside a parallel loop", 16,
+    [size](vtkIdType i) { return size / 16 * (1 + i % 4); }, 0, true });
+  return kernels;
+}
+
+double RunKernel(const Kernel& kernel)
+{
+  vtkSMPThreadLocal<double> sums(0.0);
+  auto run = [&](vtkIdType begin, vtkIdType end) {
+    double& sum = sums.Local();
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      if (kernel.Nested)
+      {
+        // The units of an iteration are spread over an inner loop.
+        vtkSMPThreadLocal<double> innerSums(0.0);
+        vtkSMPTools::For(0, kernel.Units(i), [&](vtkIdType b, vtkIdType e) {
+          innerSums.Local() += Work(16 * (e - b), static_cast<double>(b));
+        });
+        for (double inner : innerSums)
+        {
+          sum += inner;
+        }
+      }
+      else
+      {
+        sum += Work(kernel.Units(i), static_cast<double>(i));
+      }
+    }
+  };
+
+  auto start = std::chrono::steady_clock::now();
+  vtkSMPTools::For(0, kernel.Size, kernel.Grain, run);
+  auto stop = std::chrono::steady_clock::now();
+
+  // Use the results so that the work is not optimized away.
+  double total = 0;
+  for (double sum : sums)
+  {
+    total += sum;
+  }
+  if (total < 0)
+  {
+    std::cerr << total;
+  }
+  return std::chrono::duration<double>(stop - start).count();
+}
+
+void PrintUsage(const char* program)
+{
+  std::cout << "Usage: " << program << " [options]\n"
+            << "  --size N         iterations of the kernels (default 1000000)\n"
+            << "  --threads N      largest number of threads (default: all cores)\n"
+            << "  --repeat N       runs of each kernel, the best is kept (default 5)\n"
+            << "  --backend NAME   only time this backend, may be repeated\n"
+            << "  --kernel NAME    only time this kernel, may be repeated\n"
+            << "  --nested 0|1     nested parallelism setting (default 1)\n";
+}
+}
+
+/*=========================================================================
+The main entry point
+=========================================================================*/
+int main(int argc, char* argv[])
+{
+  vtkIdType size = 1000000;
+  int maxThreads = static_cast<int>(std::thread::hardware_concurrency());
+  int repeat = 5;
+  bool nested = true;
+  std::vector<std::string> backends;
+  std::vector<std::string> kernelNames;
+  for (int i = 1; i < argc; ++i)
+  {
+    std::string option = argv[i];
+    if (option == "--help" || i + 1 >= argc)
+    {
+      PrintUsage(argv[0]);
+      return option == "--help" ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+    const char* value = argv[++i];
+    if (option == "--size")
+    {
+      size = std::max<vtkIdType>(1024, std::atoll(value));
+    }
+    else if (option == "--threads")
+    {
+      maxThreads = std::atoi(value);
+    }
+    else if (option == "--repeat")
+    {
+      repeat = std::max(1, std::atoi(value));
+    }
+    else if (option == "--backend")
+    {
+      backends.emplace_back(value);
+    }
+    else if (option == "--kernel")
+    {
+      kernelNames.emplace_back(value);
+    }
+    else if (option == "--nested")
+    {
+      nested = std::atoi(value) != 0;
+    }
+    else
+    {
+      PrintUsage(argv[0]);
+      return EXIT_FAILURE;
+    }
+  }
+  if (backends.empty())
+  {
+    backends = { "Sequential", "STDThread", "TBB", "OpenMP" };
+  }
+  maxThreads = std::max(1, maxThreads);
+
+  std::vector<int> threadCounts;
+  for (int threads = 1; threads < maxThreads; threads *= 2)
+  {
+    threadCounts.push_back(threads);
+  }
+  threadCounts.push_back(maxThreads);
+
+  std::vector<Kernel> kernels = MakeKernels(size);
+  std::cout << std::left << std::setw(12) << "Backend" << std::setw(12) << "Kernel"
+            << std::right << std::setw(8) << "Threads" << std::setw(14) << "Time (s)"
+            << std::setw(10) << "Speedup"
+            << "\n";
+  for (const std::string& backend : backends)
+  {
+    if (!vtkSMPTools::SetBackend(backend.c_str()))
+    {
+      std::cout << backend << " backend not available, skipped\n";
+      continue;
+    }
+    for (const Kernel& kernel : kernels)
+    {
+      if (!kernelNames.empty() &&
+        std::find(kernelNames.begin(), kernelNames.end(), kernel.Name) == kernelNames.end())
+      {
+        continue;
+      }
+      double serialTime = 0;
+      for (int threads : threadCounts)
+      {
+        double best = 0;
+        vtkSMPTools::LocalScope(vtkSMPTools::Config{ threads, backend, nested }, [&]() {
+          for (int run = 0; run < repeat; ++run)
+          {
+            double time = RunKernel(kernel);
+            best = run == 0 ? time : std::min(best, time);
+          }
+        });
+        if (threads == threadCounts.front())
+        {
+          serialTime = best;
+        }
+        std::cout << std::left << std::setw(12) << backend << std::setw(12) << kernel.Name
+                  << std::right << std::setw(8) << threads << std::setw(14) << std::fixed
+                  << std::setprecision(6) << best << std::setw(10) << std::setprecision(2)
+                  << (best > 0 ? serialTime / best : 0.0) << "\n";
+        // The sequential backend ignores the number of threads.
+        if (backend == "Sequential")
+        {
+          break;
+        }
+      }
+    }
+  }
+  return EXIT_SUCCESS;
+}